@@ -0,0 +1,10 @@
+/** \defgroup int_vector int_vector */
+#ifndef SDSL_INCLUDED_VECTORS
+#define SDSL_INCLUDED_VECTORS
+
+#include "int_vector.hpp"
+#include "enc_vector.hpp"
+#include "vlc_vector.hpp"
+#include "dac_vector.hpp"
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Builds every configured bit-vector x rank x select combination for one
+ * input bit vector and reports space and query times, marking the
+ * combinations on the (space, rank, select) Pareto frontier. The input
+ * is either a serialized sdsl::bit_vector or a synthetic specification.
+ *
+ * Usage: bv_matrix bit_vector_file
+ *        bv_matrix --rnd length_bits density_percent [cluster_size]
+ *
+ * With cluster_size > 1 the ones are placed in runs of geometrically
+ * distributed length with mean cluster_size, which models the clustered
+ * inputs (e.g. wavelet tree levels of web text) where hyb_vector and
+ * bit_vector_il behave very differently than on uniform inputs.
+ *
+ * Output, one line per combination:
+ *   name;bits_per_input_bit;rank_ns;select_ns;pareto
+ */
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sdsl/bit_vectors.hpp>
+
+using namespace std;
+using namespace sdsl;
+
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+uint64_t g_checksum = 0; // keeps the measured loops from being optimized away
+
+struct result {
+    string name;
+    double bits_per_bit; // vector + rank + select, per input bit
+    double rank_ns;
+    double select_ns;
+    bool   pareto;
+};
+
+template<class t_fun>
+double measure_ns(const int_vector<64>& pos, uint64_t times, t_fun f)
+{
+    const uint64_t mask = pos.size()-1;
+    for (uint64_t i=0; i < (times>>4); ++i) { // warm up
+        g_checksum += f(pos[i&mask]);
+    }
+    auto start = timer::now();
+    for (uint64_t i=0; i < times; ++i) {
+        g_checksum += f(pos[i&mask]);
+    }
+    auto stop = timer::now();
+    return duration_cast<nanoseconds>(stop-start).count()/(double)times;
+}
+
+template<class t_bv, class t_rank, class t_sel>
+void bench(const string& name, const bit_vector& bv, uint64_t times,
+           std::mt19937_64& rng, vector<result>& results)
+{
+    t_bv v(bv);
+    t_rank rank;
+    util::init_support(rank, &v);
+    t_sel sel;
+    util::init_support(sel, &v);
+    uint64_t n = v.size();
+    uint64_t m = rank(n);
+
+    result res;
+    res.name = name;
+    res.bits_per_bit = 8.0*(size_in_bytes(v)+size_in_bytes(rank)
+                            +size_in_bytes(sel))/n;
+    int_vector<64> pos(1ULL<<20);
+    for (uint64_t i=0; i < pos.size(); ++i) {
+        pos[i] = rng() % n;
+    }
+    res.rank_ns = measure_ns(pos, times,
+                             [&](uint64_t i) { return rank(i); });
+    if (m > 0) {
+        for (uint64_t i=0; i < pos.size(); ++i) {
+            pos[i] = 1 + rng() % m;
+        }
+        res.select_ns = measure_ns(pos, times,
+                                   [&](uint64_t i) { return sel(i); });
+    } else {
+        res.select_ns = 0;
+    }
+    res.pareto = false;
+    results.push_back(res);
+    cerr << "done: " << name << endl;
+}
+
+// native rank/select types of self-contained vectors
+template<class t_bv>
+void bench(const string& name, const bit_vector& bv, uint64_t times,
+           std::mt19937_64& rng, vector<result>& results)
+{
+    bench<t_bv, typename t_bv::rank_1_type, typename t_bv::select_1_type>(
+        name, bv, times, rng, results);
+}
+
+//! Marks every result which no other result dominates in all of
+//! space, rank time and select time.
+void mark_pareto(vector<result>& results)
+{
+    for (auto& r : results) {
+        r.pareto = true;
+        for (const auto& o : results) {
+            if (o.bits_per_bit <= r.bits_per_bit
+                and o.rank_ns <= r.rank_ns
+                and o.select_ns <= r.select_ns
+                and (o.bits_per_bit < r.bits_per_bit
+                     or o.rank_ns < r.rank_ns
+                     or o.select_ns < r.select_ns)) {
+                r.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " bit_vector_file" << endl;
+        cout << "       " << argv[0]
+             << " --rnd length_bits density_percent [cluster_size]" << endl;
+        return 1;
+    }
+    std::mt19937_64 rng(4711);
+    bit_vector bv;
+    if (string("--rnd") == argv[1]) {
+        if (argc < 4) {
+            cout << "--rnd needs length_bits and density_percent" << endl;
+            return 1;
+        }
+        uint64_t n = stoull(argv[2]);
+        double density = stod(argv[3])/100.0;
+        uint64_t cluster = (argc > 4) ? stoull(argv[4]) : 1;
+        bv = bit_vector(n, 0);
+        if (cluster <= 1) {
+            for (uint64_t i=0; i < n; ++i) {
+                bv[i] = (rng() % 1000000) < density*1000000;
+            }
+        } else {
+            // runs of mean length `cluster`, spaced to match the density
+            std::geometric_distribution<uint64_t> run_len(1.0/cluster);
+            std::geometric_distribution<uint64_t> gap_len(
+                density/(cluster*(1.0-density)));
+            uint64_t i = 0;
+            while (i < n) {
+                i += gap_len(rng);
+                uint64_t run = 1 + run_len(rng);
+                while (run-- and i < n) {
+                    bv[i++] = 1;
+                }
+            }
+        }
+    } else if (!load_from_file(bv, argv[1])) {
+        cout << "could not load bit vector from " << argv[1] << endl;
+        return 1;
+    }
+    uint64_t times = 1ULL<<21;
+    // the scan supports answer one query in O(n), so they get far
+    // fewer repetitions; their result lines are comparable anyway
+    // since times are reported per operation
+    uint64_t scan_times = 1ULL<<8;
+
+    vector<result> results;
+    bench<bit_vector, rank_support_v<1>, select_support_mcl<1>>(
+        "bit_vector,rank_v,sel_mcl", bv, times, rng, results);
+    bench<bit_vector, rank_support_v5<1>, select_support_mcl<1>>(
+        "bit_vector,rank_v5,sel_mcl", bv, times, rng, results);
+    bench<bit_vector, rank_support_v5<1>, select_support_scan<1>>(
+        "bit_vector,rank_v5,sel_scan", bv, scan_times, rng, results);
+    bench<bit_vector, rank_support_scan<1>, select_support_scan<1>>(
+        "bit_vector,rank_scan,sel_scan", bv, scan_times, rng, results);
+    bench<bit_vector_il<512>>("bit_vector_il<512>", bv, times, rng, results);
+    bench<rrr_vector<15>>("rrr_vector<15>", bv, times, rng, results);
+    bench<rrr_vector<63>>("rrr_vector<63>", bv, times, rng, results);
+    bench<rrr_vector<127>>("rrr_vector<127>", bv, times, rng, results);
+    bench<sd_vector<>>("sd_vector", bv, times, rng, results);
+    bench<hyb_vector<>>("hyb_vector", bv, times, rng, results);
+
+    mark_pareto(results);
+    cout << "# name;bits_per_input_bit;rank_ns;select_ns;pareto" << endl;
+    for (const auto& r : results) {
+        cout << r.name << ";" << r.bits_per_bit << ";" << r.rank_ns << ";"
+             << r.select_ns << ";" << (r.pareto ? 1 : 0) << endl;
+    }
+    cerr << "# checksum = " << g_checksum << endl;
+    return 0;
+}
@@ -0,0 +1,282 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file corpus_generator.hpp
+    \brief corpus_generator.hpp contains the parameterized corpus and query
+           generators shared by the gen_corpus and gen_patterns tools.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_BENCHMARK_CORPUS_GENERATOR
+#define INCLUDED_BENCHMARK_CORPUS_GENERATOR
+
+#include <sdsl/int_vector.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Parse a `key=value,key=value,...` specification string.
+/*! Unknown keys raise a std::invalid_argument so that typos in
+ *  test_case.config entries do not silently fall back to defaults.
+ */
+inline std::map<std::string, std::string>
+parse_spec(const std::string& spec, const std::vector<std::string>& known_keys)
+{
+    std::map<std::string, std::string> kv;
+    std::istringstream in(spec);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (item.empty())
+            continue;
+        size_t eq = item.find('=');
+        if (eq == std::string::npos)
+            throw std::invalid_argument("spec item `"+item+"` is not of the form key=value");
+        std::string key = item.substr(0, eq);
+        if (std::find(known_keys.begin(), known_keys.end(), key) == known_keys.end())
+            throw std::invalid_argument("unknown spec key `"+key+"`");
+        kv[key] = item.substr(eq+1);
+    }
+    return kv;
+}
+
+//! Parameters of a synthetic corpus.
+struct corpus_spec {
+    uint64_t n      = 1ULL<<20; //!< corpus length in symbols
+    uint64_t sigma  = 26;       //!< alphabet size (symbol values 1..sigma)
+    double   skew   = 0.0;      //!< Zipf parameter of the symbol distribution; 0 = uniform
+    double   repeat = 0.0;      //!< probability that the corpus grows by an LZ copy
+    double   flen   = 16.0;     //!< mean length of an LZ copy (geometric)
+    uint64_t doclen = 0;        //!< mean document length; 0 = no document structure
+    double   docdev = 0.0;      //!< lognormal spread of the document lengths; 0 = fixed
+    uint64_t seed   = 4711;     //!< random seed
+
+    //! Construct from a `key=value,...` specification string.
+    corpus_spec(const std::string& spec="")
+    {
+        auto kv = parse_spec(spec, {"n","sigma","skew","repeat","flen",
+                                    "doclen","docdev","seed"
+                                   });
+        if (kv.count("n")) n = std::stoull(kv["n"]);
+        if (kv.count("sigma")) sigma = std::stoull(kv["sigma"]);
+        if (kv.count("skew")) skew = std::stod(kv["skew"]);
+        if (kv.count("repeat")) repeat = std::stod(kv["repeat"]);
+        if (kv.count("flen")) flen = std::stod(kv["flen"]);
+        if (kv.count("doclen")) doclen = std::stoull(kv["doclen"]);
+        if (kv.count("docdev")) docdev = std::stod(kv["docdev"]);
+        if (kv.count("seed")) seed = std::stoull(kv["seed"]);
+        if (sigma < 1)
+            throw std::invalid_argument("sigma has to be at least 1");
+        if (repeat < 0.0 or repeat >= 1.0)
+            throw std::invalid_argument("repeat has to be in [0,1)");
+        if (flen < 1.0)
+            throw std::invalid_argument("flen has to be at least 1");
+    }
+};
+
+//! Generator for synthetic corpora with controllable characteristics.
+/*! The corpus is built left to right. Each step either appends a fresh
+ *  symbol drawn from a Zipf(skew) distribution over 1..sigma (uniform for
+ *  skew=0), or, with probability `repeat`, copies a factor of geometric
+ *  mean length `flen` from a uniform earlier position, as an LZ77 parser
+ *  would emit it. `skew` therefore dials the zero-order entropy and
+ *  `repeat`/`flen` the LZ factor density independently. With `doclen` > 0
+ *  the sequence is additionally divided into documents of (lognormal or
+ *  fixed) length by the reserved separator symbol 0; copies never cross a
+ *  separator, so the document length distribution stays exact.
+ */
+class corpus_generator
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+
+    private:
+        corpus_spec          m_spec;
+        std::mt19937_64      m_rng;
+        std::vector<double>  m_cdf;      // symbol distribution; empty = uniform
+        size_type            m_factors = 0;
+        size_type            m_copied  = 0;
+        size_type            m_docs    = 0;
+
+        uint64_t draw_symbol()
+        {
+            if (m_cdf.empty())
+                return 1 + m_rng()%m_spec.sigma;
+            double u = std::generate_canonical<double, 53>(m_rng);
+            return 1 + (std::lower_bound(m_cdf.begin(), m_cdf.end(), u)
+                        - m_cdf.begin());
+        }
+
+        size_type draw_doc_len()
+        {
+            if (m_spec.docdev <= 0.0)
+                return std::max<size_type>(1, m_spec.doclen);
+            std::lognormal_distribution<double> len_dist(
+                std::log((double)m_spec.doclen), m_spec.docdev);
+            return std::max<size_type>(1, (size_type)len_dist(m_rng));
+        }
+
+    public:
+        corpus_generator(const corpus_spec& spec) : m_spec(spec), m_rng(spec.seed)
+        {
+            if (m_spec.skew > 0.0) {
+                m_cdf.resize(m_spec.sigma);
+                double sum = 0.0;
+                for (size_type i=0; i < m_spec.sigma; ++i) {
+                    sum += 1.0/std::pow((double)(i+1), m_spec.skew);
+                    m_cdf[i] = sum;
+                }
+                for (size_type i=0; i < m_spec.sigma; ++i)
+                    m_cdf[i] /= sum;
+            }
+        }
+
+        //! Generate the corpus; values are 1..sigma, 0 separates documents.
+        int_vector<> generate()
+        {
+            const size_type n = m_spec.n;
+            int_vector<> seq(n, 0, bits::hi(m_spec.sigma)+1);
+            std::geometric_distribution<size_type> copy_len(1.0/m_spec.flen);
+            size_type pos      = 0;
+            size_type next_sep = m_spec.doclen ? draw_doc_len() : n;
+            while (pos < n) {
+                if (pos == next_sep) {
+                    seq[pos++] = 0;
+                    ++m_docs;
+                    next_sep = pos + draw_doc_len();
+                    continue;
+                }
+                bool copy = m_spec.repeat > 0.0 and pos > 16
+                            and std::generate_canonical<double, 53>(m_rng) < m_spec.repeat;
+                if (copy) {
+                    size_type len = 1 + copy_len(m_rng);
+                    len = std::min(len, n-pos);
+                    len = std::min(len, next_sep-pos);  // keep documents exact
+                    size_type src = m_rng()%pos;
+                    for (size_type k=0; k < len; ++k)  // overlaps are allowed
+                        seq[pos+k] = seq[src+k];
+                    pos += len;
+                    ++m_factors;
+                    m_copied += len;
+                } else {
+                    seq[pos++] = draw_symbol();
+                }
+            }
+            return seq;
+        }
+
+        //! Number of LZ copies emitted by the last generate() call.
+        size_type factors()const { return m_factors; }
+        //! Number of symbols covered by LZ copies.
+        size_type copied()const { return m_copied; }
+        //! Number of document separators.
+        size_type docs()const { return m_docs; }
+
+        //! Empirical zero-order entropy of a sequence in bits per symbol.
+        static double entropy(const int_vector<>& seq)
+        {
+            std::map<uint64_t, size_type> cnt;
+            for (size_type i=0; i < seq.size(); ++i)
+                ++cnt[seq[i]];
+            double h0 = 0.0;
+            for (const auto& c : cnt) {
+                double p = (double)c.second/seq.size();
+                h0 -= p*std::log2(p);
+            }
+            return h0;
+        }
+};
+
+//! Parameters of a query set.
+struct pattern_spec {
+    uint64_t m       = 1000;  //!< number of queries
+    uint64_t len     = 20;    //!< pattern length
+    double   skew    = 0.0;   //!< Zipf parameter over the anchor set; 0 = all uniform
+    uint64_t anchors = 0;     //!< distinct positions the skewed queries draw from
+    uint64_t seed    = 4711;  //!< random seed
+
+    //! Construct from a `key=value,...` specification string.
+    pattern_spec(const std::string& spec="")
+    {
+        auto kv = parse_spec(spec, {"m","len","skew","anchors","seed"});
+        if (kv.count("m")) m = std::stoull(kv["m"]);
+        if (kv.count("len")) len = std::stoull(kv["len"]);
+        if (kv.count("skew")) skew = std::stod(kv["skew"]);
+        if (kv.count("anchors")) anchors = std::stoull(kv["anchors"]);
+        if (kv.count("seed")) seed = std::stoull(kv["seed"]);
+        if (skew > 0.0 and 0 == anchors)
+            anchors = 1024;
+    }
+};
+
+//! Sample pattern start positions from a corpus.
+/*! With anchors=0 every query position is an independent uniform draw.
+ *  Otherwise `anchors` distinct positions are sampled first and each query
+ *  picks one of them Zipf(skew)-distributed, which models production query
+ *  logs where few patterns account for most of the volume. A predicate
+ *  rejects windows containing forbidden symbols (e.g. the terminator or
+ *  the pattern file record separator).
+ */
+template<class t_valid>
+std::vector<uint64_t>
+sample_pattern_positions(uint64_t corpus_size, const pattern_spec& spec,
+                         t_valid valid_window)
+{
+    if (corpus_size < spec.len)
+        throw std::invalid_argument("corpus shorter than the pattern length");
+    std::mt19937_64 rng(spec.seed);
+    auto draw_valid = [&]() -> uint64_t {
+        for (size_t tries=0; tries < 10000; ++tries) {
+            uint64_t pos = rng()%(corpus_size-spec.len+1);
+            if (valid_window(pos))
+                return pos;
+        }
+        throw std::runtime_error("no valid pattern window found; "
+                                 "check the forbidden symbols");
+    };
+    std::vector<uint64_t> res(spec.m);
+    if (0 == spec.anchors) {
+        for (uint64_t i=0; i < spec.m; ++i)
+            res[i] = draw_valid();
+        return res;
+    }
+    std::vector<uint64_t> anchor(spec.anchors);
+    for (uint64_t i=0; i < spec.anchors; ++i)
+        anchor[i] = draw_valid();
+    std::vector<double> cdf(spec.anchors);
+    double sum = 0.0;
+    for (uint64_t i=0; i < spec.anchors; ++i) {
+        sum += spec.skew > 0.0 ? 1.0/std::pow((double)(i+1), spec.skew) : 1.0;
+        cdf[i] = sum;
+    }
+    for (uint64_t i=0; i < spec.anchors; ++i)
+        cdf[i] /= sum;
+    for (uint64_t i=0; i < spec.m; ++i) {
+        double u = std::generate_canonical<double, 53>(rng);
+        res[i] = anchor[std::lower_bound(cdf.begin(), cdf.end(), u)-cdf.begin()];
+    }
+    return res;
+}
+
+}// end namespace sdsl
+
+#endif
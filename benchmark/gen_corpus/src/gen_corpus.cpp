@@ -0,0 +1,111 @@
+#include "corpus_generator.hpp"
+#include <sdsl/sfstream.hpp>
+#include <sdsl/util.hpp>
+#include <iostream>
+#include <string>
+
+using namespace sdsl;
+using namespace std;
+
+// Generates a synthetic corpus with controllable entropy, repetitiveness,
+// alphabet size and document structure. Output formats follow the type
+// column of the test_case.config files: f=1 writes a byte sequence, f=0 a
+// serialized int_vector<>.
+
+void print_usage(const char* prog)
+{
+    cout << "Usage: " << prog << " output_file [spec]" << endl;
+    cout << "  spec is a comma separated list of key=value pairs:" << endl;
+    cout << "    f=1|0        output format: 1 byte sequence (default)," << endl;
+    cout << "                 0 serialized int_vector<>" << endl;
+    cout << "    n=NUM        corpus length in symbols (default 2^20)" << endl;
+    cout << "    sigma=NUM    alphabet size; at most 254 for f=1 (default 26)" << endl;
+    cout << "    skew=S       Zipf parameter of the symbol distribution;" << endl;
+    cout << "                 0=uniform (default 0)" << endl;
+    cout << "    repeat=P     probability of an LZ copy step in [0,1) (default 0)" << endl;
+    cout << "    flen=L       mean LZ copy length (default 16)" << endl;
+    cout << "    doclen=NUM   mean document length; 0=no documents (default 0)" << endl;
+    cout << "    docdev=S     lognormal spread of the document lengths (default 0)" << endl;
+    cout << "    seed=NUM     random seed (default 4711)" << endl;
+    cout << "  In byte output documents are separated by newline, in" << endl;
+    cout << "  int_vector<> output by the symbol 0. Bytes 0 and newline are" << endl;
+    cout << "  never used for regular symbols, so the output is safe for the" << endl;
+    cout << "  indexing_* pattern tools." << endl;
+    cout << "Example:" << endl;
+    cout << "  " << prog << " ../data/synth.50MB f=1,n=52428800,sigma=96,skew=1.1,repeat=0.4,flen=32" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    string out_file = argv[1];
+    string spec_str = argc > 2 ? argv[2] : "";
+    bool byte_format = true;
+    try {
+        // strip the format key; the rest is the corpus specification
+        auto kv = parse_spec(spec_str, {"f","n","sigma","skew","repeat","flen",
+                                        "doclen","docdev","seed"
+                                       });
+        if (kv.count("f"))
+            byte_format = "0" != kv["f"];
+        string corpus_str;
+        for (const auto& item : kv) {
+            if ("f" == item.first)
+                continue;
+            if (!corpus_str.empty())
+                corpus_str += ",";
+            corpus_str += item.first + "=" + item.second;
+        }
+        corpus_spec spec(corpus_str);
+        if (byte_format and spec.sigma > 254) {
+            cerr << "sigma has to be at most 254 for byte output" << endl;
+            return 1;
+        }
+        corpus_generator gen(spec);
+        int_vector<> seq = gen.generate();
+        if (byte_format) {
+            // map 1..sigma to bytes, skipping 0 and the newline separator
+            std::vector<char> byte_of(spec.sigma+1);
+            for (uint64_t v=1, b=1; v <= spec.sigma; ++v, ++b) {
+                if ('\n' == b)
+                    ++b;
+                byte_of[v] = b;
+            }
+            osfstream out(out_file, std::ios::binary|std::ios::trunc|std::ios::out);
+            std::vector<char> buf(1ULL<<20);
+            uint64_t filled = 0;
+            for (uint64_t i=0; i < seq.size(); ++i) {
+                buf[filled++] = 0 == seq[i] ? '\n' : byte_of[seq[i]];
+                if (filled == buf.size()) {
+                    out.write(buf.data(), filled);
+                    filled = 0;
+                }
+            }
+            out.write(buf.data(), filled);
+            out.close();
+            if (!out.good()) {
+                cerr << "error while writing " << out_file << endl;
+                return 1;
+            }
+        } else {
+            if (!store_to_file(seq, out_file)) {
+                cerr << "error while writing " << out_file << endl;
+                return 1;
+            }
+        }
+        cerr << "wrote " << out_file << ": n=" << seq.size()
+             << " sigma=" << spec.sigma
+             << " H0=" << corpus_generator::entropy(seq)
+             << " lz_factors=" << gen.factors()
+             << " copied_frac=" << (double)gen.copied()/seq.size()
+             << " docs=" << gen.docs() << endl;
+    } catch (const std::exception& e) {
+        cerr << "error: " << e.what() << endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
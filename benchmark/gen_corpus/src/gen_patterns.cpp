@@ -0,0 +1,134 @@
+#include "corpus_generator.hpp"
+#include <sdsl/int_vector.hpp>
+#include <sdsl/sfstream.hpp>
+#include <sdsl/util.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+// Samples query sets from a (synthetic or downloaded) corpus. The pattern
+// mode writes the Pizza&Chili pattern format consumed by the indexing_count
+// and indexing_locate run_queries tools; the interval mode writes the
+// genintervals format consumed by indexing_extract. With skew/anchors the
+// query positions follow a Zipf distribution over a fixed anchor set, so
+// the skewed repetition of production query logs can be reproduced.
+
+void print_usage(const char* prog)
+{
+    cout << "Usage: " << prog << " corpus_file output_file [spec]" << endl;
+    cout << "  spec is a comma separated list of key=value pairs:" << endl;
+    cout << "    mode=pattern|interval  output type (default pattern)" << endl;
+    cout << "    f=1|0        corpus format: 1 byte sequence (default)," << endl;
+    cout << "                 0 serialized int_vector<>" << endl;
+    cout << "    m=NUM        number of queries (default 1000)" << endl;
+    cout << "    len=NUM      pattern/interval length (default 20)" << endl;
+    cout << "    skew=S       Zipf parameter over the anchor set; 0=uniform" << endl;
+    cout << "    anchors=NUM  distinct positions skewed queries draw from" << endl;
+    cout << "                 (default 1024 when skew>0)" << endl;
+    cout << "    seed=NUM     random seed (default 4711)" << endl;
+    cout << "  Pattern mode requires a byte corpus; windows containing the" << endl;
+    cout << "  forbidden characters \\0 and \\n are rejected." << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    string corpus_file = argv[1];
+    string out_file    = argv[2];
+    string spec_str    = argc > 3 ? argv[3] : "";
+    try {
+        auto kv = parse_spec(spec_str, {"mode","f","m","len","skew",
+                                        "anchors","seed"
+                                       });
+        string mode = kv.count("mode") ? kv["mode"] : "pattern";
+        bool byte_format = !kv.count("f") or "0" != kv["f"];
+        string pat_str;
+        for (const auto& item : kv) {
+            if ("mode" == item.first or "f" == item.first)
+                continue;
+            if (!pat_str.empty())
+                pat_str += ",";
+            pat_str += item.first + "=" + item.second;
+        }
+        pattern_spec spec(pat_str);
+
+        uint64_t corpus_size = 0;
+        std::vector<char> corpus;
+        if (byte_format) {
+            isfstream in(corpus_file, std::ios::binary|std::ios::in);
+            if (!in.is_open()) {
+                cerr << "cannot open corpus " << corpus_file << endl;
+                return 1;
+            }
+            in.seekg(0, std::ios::end);
+            corpus_size = in.tellg();
+            corpus.resize(corpus_size);
+            in.seekg(0);
+            in.read(corpus.data(), corpus_size);
+        } else {
+            int_vector<> seq;
+            if (!load_from_file(seq, corpus_file)) {
+                cerr << "cannot open corpus " << corpus_file << endl;
+                return 1;
+            }
+            corpus_size = seq.size();
+        }
+
+        if ("interval" == mode) {
+            std::vector<uint64_t> pos = sample_pattern_positions(
+                                            corpus_size, spec,
+            [](uint64_t) { return true; });
+            osfstream out(out_file, std::ios::trunc|std::ios::out);
+            out << "# number=" << spec.m << " length=" << spec.len
+                << " file=" << corpus_file << "\n";
+            for (uint64_t p : pos)
+                out << p << "," << (p+spec.len-1) << "\n";
+            out.close();
+            if (!out.good()) {
+                cerr << "error while writing " << out_file << endl;
+                return 1;
+            }
+        } else if ("pattern" == mode) {
+            if (!byte_format) {
+                cerr << "pattern mode requires a byte corpus (f=1)" << endl;
+                return 1;
+            }
+            auto valid = [&](uint64_t p) {
+                for (uint64_t k=0; k < spec.len; ++k) {
+                    if ('\0' == corpus[p+k] or '\n' == corpus[p+k])
+                        return false;
+                }
+                return true;
+            };
+            std::vector<uint64_t> pos = sample_pattern_positions(
+                                            corpus_size, spec, valid);
+            osfstream out(out_file, std::ios::binary|std::ios::trunc|std::ios::out);
+            out << "# number=" << spec.m << " length=" << spec.len
+                << " file=" << corpus_file << " forbidden=\n";
+            for (uint64_t p : pos)
+                out.write(corpus.data()+p, spec.len);
+            out.close();
+            if (!out.good()) {
+                cerr << "error while writing " << out_file << endl;
+                return 1;
+            }
+        } else {
+            cerr << "unknown mode `" << mode << "`" << endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+        cerr << "wrote " << out_file << ": m=" << spec.m
+             << " len=" << spec.len << " mode=" << mode << endl;
+    } catch (const std::exception& e) {
+        cerr << "error: " << e.what() << endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sdsl/bit_vectors.hpp>
+#include <sdsl/rank_support_int.hpp>
+
+using namespace std;
+using namespace sdsl;
+
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//! Counter for hardware cache misses via perf_event_open.
+/*! Degrades gracefully (reports -1) when the perf interface is not
+ *  available, e.g. in containers or with perf_event_paranoid > 2.
+ */
+class cache_miss_counter
+{
+    private:
+        int m_fd = -1;
+    public:
+        cache_miss_counter()
+        {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof(attr);
+            attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled       = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            m_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+        ~cache_miss_counter()
+        {
+            if (m_fd >= 0) close(m_fd);
+        }
+        void start()
+        {
+            if (m_fd >= 0) {
+                ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+        long long stop()
+        {
+            if (m_fd < 0) return -1;
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long count = -1;
+            if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+                return -1;
+            return count;
+        }
+};
+#else
+class cache_miss_counter
+{
+    public:
+        void start() {}
+        long long stop() { return -1; }
+};
+#endif
+
+uint64_t g_checksum = 0; // keeps the measured loops from being optimized away
+
+//! Generates 2^log_s positions in [0..universe-1] for a distribution.
+/*! \param dist     "uniform", "clustered" or "sequential".
+ *  \param log_s    Base two logarithm of the number of positions.
+ *  \param universe Positions are drawn from [0..universe-1].
+ *
+ *  uniform:    independent uniform positions.
+ *  clustered:  jumps to a random 1024-position cluster every 64 queries,
+ *              uniform inside the cluster.
+ *  sequential: consecutive positions (wrapping around).
+ */
+int_vector<64> gen_positions(const string& dist, uint64_t log_s,
+                             uint64_t universe, std::mt19937_64& rng)
+{
+    int_vector<64> pos(1ULL<<log_s, 0);
+    if ("uniform" == dist) {
+        for (uint64_t i=0; i < pos.size(); ++i)
+            pos[i] = rng() % universe;
+    } else if ("clustered" == dist) {
+        uint64_t start = 0;
+        for (uint64_t i=0; i < pos.size(); ++i) {
+            if (0 == (i & 0x3F))
+                start = rng() % universe;
+            pos[i] = (start + rng() % 1024) % universe;
+        }
+    } else { // sequential
+        uint64_t start = rng() % universe;
+        for (uint64_t i=0; i < pos.size(); ++i)
+            pos[i] = (start + i) % universe;
+    }
+    return pos;
+}
+
+//! Measures f over the positions and prints one result line.
+/*! Output format:
+ *  structure;operation;distribution;universe;ns_per_op;cache_misses_per_op
+ */
+template<class t_fun>
+void measure(const string& structure, const string& op, const string& dist,
+             uint64_t universe, const int_vector<64>& pos, uint64_t times,
+             t_fun f)
+{
+    const uint64_t mask = pos.size()-1;
+    // warm up caches and branch predictors
+    for (uint64_t i=0; i < (times>>4); ++i)
+        g_checksum += f(pos[i&mask]);
+    cache_miss_counter cm;
+    cm.start();
+    auto start = timer::now();
+    for (uint64_t i=0; i < times; ++i)
+        g_checksum += f(pos[i&mask]);
+    auto stop = timer::now();
+    long long misses = cm.stop();
+    double ns = duration_cast<nanoseconds>(stop-start).count()/(double)times;
+    cout << structure << ";" << op << ";" << dist << ";" << universe << ";"
+         << ns << ";";
+    if (misses < 0)
+        cout << "-";
+    else
+        cout << ((double)misses)/times;
+    cout << endl;
+}
+
+template<class t_bv>
+void bench_bv(const string& name, const bit_vector& bv, const string& dist,
+              uint64_t times, std::mt19937_64& rng)
+{
+    using rank_type   = typename t_bv::rank_1_type;
+    using select_type = typename t_bv::select_1_type;
+    t_bv v(bv);
+    rank_type rank;
+    util::init_support(rank, &v);
+    select_type sel;
+    util::init_support(sel, &v);
+    uint64_t n = v.size();
+    uint64_t m = rank(n);
+
+    auto pos = gen_positions(dist, 20, n, rng);
+    measure(name, "access", dist, n, pos, times,
+            [&](uint64_t i) { return (uint64_t)v[i]; });
+    measure(name, "rank", dist, n, pos, times,
+            [&](uint64_t i) { return rank(i); });
+    if (m > 0) {
+        auto rpos = gen_positions(dist, 20, m, rng);
+        measure(name, "select", dist, n, rpos, times,
+                [&](uint64_t i) { return sel(i+1); });
+    }
+}
+
+template<uint8_t t_width>
+void bench_int(const string& name, uint64_t n, const string& dist,
+               uint64_t times, std::mt19937_64& rng)
+{
+    int_vector<t_width> v(n);
+    for (uint64_t i=0; i < n; ++i)
+        v[i] = rng() % (1ULL<<t_width);
+    rank_support_int_v<t_width> rank(&v);
+    auto pos = gen_positions(dist, 20, n, rng);
+    measure(name, "access", dist, n, pos, times,
+            [&](uint64_t i) { return (uint64_t)v[i]; });
+    measure(name, "rank", dist, n, pos, times,
+            [&](uint64_t i) { return rank(i, i&(rank.sigma-1)); });
+    uint64_t m = rank.rank(n, 0);
+    if (m > 0) {
+        auto rpos = gen_positions(dist, 20, m, rng);
+        measure(name, "select", dist, n, rpos, times,
+                [&](uint64_t i) { return rank.select(i+1, 0); });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint64_t log_n = 25;      // 32 MiB working set by default
+    uint64_t times = 1ULL<<22;
+    if (argc > 1) log_n = stoull(argv[1]);
+    if (argc > 2) times = 1ULL<<stoull(argv[2]);
+    const uint64_t n = 1ULL<<log_n;
+
+    std::mt19937_64 rng(4711);
+    bit_vector bv(n, 0);       // dense input, p=0.5
+    for (uint64_t i=0; i < n; ++i)
+        bv[i] = rng() & 1;
+    bit_vector bv_sparse(n, 0); // sparse input for sd_vector, p=1/64
+    for (uint64_t i=0; i < n; ++i)
+        bv_sparse[i] = 0 == (rng() & 0x3F);
+
+    cout << "# structure;operation;distribution;universe;"
+         << "ns_per_op;cache_misses_per_op" << endl;
+
+    for (string dist : {"uniform", "clustered", "sequential"}) {
+        // plain bit vector with the uncompressed rank/select supports
+        {
+            bit_vector v = bv;
+            rank_support_v<1> rank_v(&v);
+            rank_support_v5<1> rank_v5(&v);
+            select_support_mcl<1> sel_mcl(&v);
+            uint64_t m = rank_v(n);
+            auto pos = gen_positions(dist, 20, n, rng);
+            measure("bit_vector", "access", dist, n, pos, times,
+                    [&](uint64_t i) { return (uint64_t)v[i]; });
+            measure("rank_support_v", "rank", dist, n, pos, times,
+                    [&](uint64_t i) { return rank_v(i); });
+            measure("rank_support_v5", "rank", dist, n, pos, times,
+                    [&](uint64_t i) { return rank_v5(i); });
+            auto rpos = gen_positions(dist, 20, m, rng);
+            measure("select_support_mcl", "select", dist, n, rpos, times,
+                    [&](uint64_t i) { return sel_mcl(i+1); });
+        }
+        bench_bv<rrr_vector<15>>("rrr_vector<15>", bv, dist, times, rng);
+        bench_bv<rrr_vector<63>>("rrr_vector<63>", bv, dist, times, rng);
+        bench_bv<sd_vector<>>("sd_vector", bv_sparse, dist, times, rng);
+        bench_int<2>("rank_support_int_v<2>", n/2, dist, times, rng);
+        bench_int<4>("rank_support_int_v<4>", n/4, dist, times, rng);
+    }
+    // report the checksum so the compiler cannot elide the loops
+    cout << "# checksum = " << g_checksum << endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Generates a synthetic query log in the replay format (see replay.cpp)
+ * from a text file, for testing the harness when no captured production
+ * log is at hand. Patterns are substrings of the text, so counts and
+ * locates hit; the operation mix is 70% count, 20% locate, 10% extract.
+ *
+ * Usage: genlog text_file num_records log_file [seed]
+ */
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const char LOG_MAGIC[8] = {'s','d','s','l','q','l','o','g'};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4) {
+        cout << "Usage: " << argv[0]
+             << " text_file num_records log_file [seed]" << endl;
+        return 1;
+    }
+    ifstream text_in(argv[1], ios::binary);
+    if (!text_in) {
+        cerr << "could not open text file " << argv[1] << endl;
+        return 1;
+    }
+    string text((istreambuf_iterator<char>(text_in)),
+                istreambuf_iterator<char>());
+    if (text.size() < 64) {
+        cerr << "text file " << argv[1] << " is too small" << endl;
+        return 1;
+    }
+    uint64_t n = stoull(argv[2]);
+    uint64_t seed = (argc > 4) ? stoull(argv[4]) : 4711;
+    mt19937_64 rng(seed);
+
+    ofstream out(argv[3], ios::binary);
+    uint64_t version = 1;
+    out.write(LOG_MAGIC, 8);
+    out.write((const char*)&version, 8);
+    out.write((const char*)&n, 8);
+    for (uint64_t i=0; i < n; ++i) {
+        uint64_t r = rng() % 10;
+        if (r < 9) {  // count or locate of a text substring
+            uint8_t op = (r < 7) ? 'C' : 'L';
+            uint64_t len = 4 + rng() % 17;              // length in [4..20]
+            uint64_t pos = rng() % (text.size() - len);
+            out.write((const char*)&op, 1);
+            out.write((const char*)&len, 8);
+            out.write(text.data() + pos, len);
+        } else {      // extract of a 64 character snippet
+            uint8_t op = 'E';
+            uint64_t len = 64;
+            uint64_t pos = rng() % (text.size() - len);
+            out.write((const char*)&op, 1);
+            out.write((const char*)&pos, 8);
+            out.write((const char*)&len, 8);
+        }
+    }
+    if (!out) {
+        cerr << "could not write log file " << argv[3] << endl;
+        return 1;
+    }
+    return 0;
+}
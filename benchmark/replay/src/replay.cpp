@@ -0,0 +1,190 @@
+/*
+ * Replays a captured binary query log against a serialized index and
+ * reports throughput and latency percentiles.
+ *
+ * Log format (little endian):
+ *   8 byte magic "sdslqlog", uint64_t version (=1), uint64_t #records,
+ *   then per record one uint8_t op code followed by its payload:
+ *     'C' (count)   : uint64_t length, `length` pattern bytes
+ *     'L' (locate)  : uint64_t length, `length` pattern bytes
+ *     'E' (extract) : uint64_t begin, uint64_t length
+ *
+ * Usage: replay_idx_[IDX_ID] index_file log_file [threads]
+ *
+ * The records are read into memory up front and distributed round-robin
+ * over the worker threads, so a replay with t threads issues exactly the
+ * captured queries, just concurrently. Latencies are taken per query
+ * with a monotonic clock; the percentiles are computed over the merged
+ * samples of all threads.
+ */
+#include <sdsl/suffix_arrays.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+using timer = std::chrono::high_resolution_clock;
+
+const char LOG_MAGIC[8] = {'s','d','s','l','q','l','o','g'};
+
+struct log_record {
+    uint8_t  op;      // 'C', 'L' or 'E'
+    uint64_t begin;   // pattern offset in the pattern buffer, or text position
+    uint64_t length;  // pattern length, or number of extracted characters
+};
+
+//! Reads a query log; patterns are concatenated into `pattern_buf`.
+bool read_log(const string& file, vector<log_record>& records,
+              vector<char>& pattern_buf)
+{
+    ifstream in(file, ios::binary);
+    if (!in) {
+        cerr << "could not open log file " << file << endl;
+        return false;
+    }
+    char magic[8];
+    uint64_t version = 0, n = 0;
+    in.read(magic, 8);
+    in.read((char*)&version, 8);
+    in.read((char*)&n, 8);
+    if (!in or 0 != memcmp(magic, LOG_MAGIC, 8) or 1 != version) {
+        cerr << file << " is not a version 1 sdsl query log" << endl;
+        return false;
+    }
+    records.reserve(n);
+    for (uint64_t i=0; i < n; ++i) {
+        log_record rec;
+        in.read((char*)&rec.op, 1);
+        if ('C' == rec.op or 'L' == rec.op) {
+            in.read((char*)&rec.length, 8);
+            rec.begin = pattern_buf.size();
+            pattern_buf.resize(pattern_buf.size() + rec.length);
+            in.read(pattern_buf.data() + rec.begin, rec.length);
+        } else if ('E' == rec.op) {
+            in.read((char*)&rec.begin, 8);
+            in.read((char*)&rec.length, 8);
+        } else {
+            cerr << "unknown op code " << (int)rec.op
+                 << " in record " << i << endl;
+            return false;
+        }
+        if (!in) {
+            cerr << "log file " << file << " is truncated" << endl;
+            return false;
+        }
+        records.push_back(rec);
+    }
+    return true;
+}
+
+//! Replays every t-th record; latencies in ns are appended to `lat`.
+void replay_worker(const CSA_TYPE& csa, const vector<log_record>& records,
+                   const vector<char>& pattern_buf, uint64_t tid, uint64_t t,
+                   const atomic<bool>* go, vector<uint64_t>* lat,
+                   uint64_t* checksum)
+{
+    while (!go->load(memory_order_acquire)) {
+        this_thread::yield();
+    }
+    uint64_t sum = 0;
+    for (uint64_t i=tid; i < records.size(); i += t) {
+        const log_record& rec = records[i];
+        auto start = timer::now();
+        if ('C' == rec.op) {
+            const char* pat = pattern_buf.data() + rec.begin;
+            sum += count(csa, pat, pat + rec.length);
+        } else if ('L' == rec.op) {
+            const char* pat = pattern_buf.data() + rec.begin;
+            auto occ = locate(csa, pat, pat + rec.length);
+            sum += occ.size();
+        } else { // 'E'
+            uint64_t b = rec.begin % csa.size();
+            uint64_t e = std::min(b + rec.length, (uint64_t)csa.size()) - 1;
+            sum += extract(csa, b, e).size();
+        }
+        auto stop = timer::now();
+        lat->push_back(chrono::duration_cast<chrono::nanoseconds>(
+                           stop-start).count());
+    }
+    *checksum = sum;
+}
+
+uint64_t percentile(const vector<uint64_t>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    uint64_t idx = (uint64_t)((p/100.0)*sorted.size());
+    return sorted[std::min(idx, (uint64_t)sorted.size()-1)];
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0]
+             << " index_file log_file [threads]" << endl;
+        return 1;
+    }
+    uint64_t threads = (argc > 3) ? stoull(argv[3]) : 1;
+    if (0 == threads) {
+        threads = 1;
+    }
+
+    CSA_TYPE csa;
+    if (!load_from_file(csa, argv[1])) {
+        cerr << "could not load index " << argv[1] << endl;
+        return 1;
+    }
+    vector<log_record> records;
+    vector<char> pattern_buf;
+    if (!read_log(argv[2], records, pattern_buf)) {
+        return 1;
+    }
+
+    vector<vector<uint64_t>> lat(threads);
+    vector<uint64_t> checksum(threads, 0);
+    for (uint64_t t=0; t < threads; ++t) {
+        lat[t].reserve(records.size()/threads + 1);
+    }
+    atomic<bool> go(false);
+    vector<thread> workers;
+    for (uint64_t t=0; t < threads; ++t) {
+        workers.emplace_back(replay_worker, cref(csa), cref(records),
+                             cref(pattern_buf), t, threads, &go,
+                             &lat[t], &checksum[t]);
+    }
+    auto start = timer::now();
+    go.store(true, memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto stop = timer::now();
+
+    vector<uint64_t> all;
+    all.reserve(records.size());
+    uint64_t sum = 0;
+    for (uint64_t t=0; t < threads; ++t) {
+        all.insert(all.end(), lat[t].begin(), lat[t].end());
+        sum += checksum[t];
+    }
+    sort(all.begin(), all.end());
+    double sec = chrono::duration_cast<chrono::microseconds>(
+                     stop-start).count()/1000000.0;
+
+    // index;log;threads;ops;seconds;ops_per_sec;p50_ns;p90_ns;p99_ns;p999_ns;max_ns
+    cout << SUF << ";" << argv[2] << ";" << threads << ";"
+         << records.size() << ";" << sec << ";"
+         << (sec > 0 ? records.size()/sec : 0) << ";"
+         << percentile(all, 50) << ";" << percentile(all, 90) << ";"
+         << percentile(all, 99) << ";" << percentile(all, 99.9) << ";"
+         << (all.empty() ? 0 : all.back()) << endl;
+    cerr << "# checksum = " << sum << endl;
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Measures count/locate/extract throughput of one shared index under a
+ * growing number of concurrent reader threads.
+ *
+ * Usage: scale_idx_[IDX_ID] index_file max_threads [log_ops]
+ *
+ * One index instance is loaded and shared read-only by all threads, as
+ * in a server deployment. For every thread count T in 1,2,4,...,
+ * max_threads each thread issues 2^log_ops queries against patterns
+ * sampled from the indexed text itself (so counts and locates hit), and
+ * the wall time of the slowest thread defines the throughput. Scaling
+ * efficiency relates the measured throughput to T times the
+ * single-thread baseline; a drop far below 1.0 at high T reproduces
+ * the cache/TLB pressure on the shared rank tables. Run the binary
+ * under `numactl --interleave=all` (see the Makefile) to measure the
+ * socket-interleave sensitivity of the same working set.
+ *
+ * Output, one CSV line per (operation, thread count) cell:
+ *   index;op;threads;total_ops;ops_per_sec;efficiency
+ */
+#include <sdsl/suffix_arrays.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+using timer = std::chrono::high_resolution_clock;
+
+atomic<uint64_t> g_checksum(0); // keeps the measured loops from being optimized away
+
+struct pattern_set {
+    vector<string>   patterns;
+    vector<uint64_t> positions; // extract positions
+};
+
+//! Samples patterns and extract positions from the indexed text.
+pattern_set sample_patterns(const CSA_TYPE& csa, uint64_t num,
+                            uint64_t pat_len, std::mt19937_64& rng)
+{
+    pattern_set ps;
+    ps.patterns.reserve(num);
+    ps.positions.reserve(num);
+    for (uint64_t i=0; i < num; ++i) {
+        uint64_t pos = rng() % (csa.size()-pat_len-1);
+        auto snippet = extract(csa, pos, pos+pat_len-1);
+        ps.patterns.emplace_back(snippet.begin(), snippet.end());
+        ps.positions.push_back(pos);
+    }
+    return ps;
+}
+
+template<class t_fun>
+double run_threads(uint64_t threads, uint64_t ops_per_thread, t_fun f)
+{
+    atomic<bool> go(false);
+    vector<thread> workers;
+    vector<double> seconds(threads, 0);
+    for (uint64_t t=0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            uint64_t sum = 0;
+            auto start = timer::now();
+            for (uint64_t i=0; i < ops_per_thread; ++i) {
+                sum += f(t, i);
+            }
+            auto stop = timer::now();
+            g_checksum += sum;
+            seconds[t] = chrono::duration_cast<chrono::microseconds>(
+                             stop-start).count()/1000000.0;
+        });
+    }
+    go.store(true, memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    // the slowest thread defines the achieved throughput
+    double max_sec = 0;
+    for (double s : seconds) {
+        max_sec = std::max(max_sec, s);
+    }
+    return (threads*ops_per_thread)/max_sec;
+}
+
+void report(const string& op, uint64_t threads, uint64_t total_ops,
+            double ops_per_sec, double base_ops_per_sec)
+{
+    cout << SUF << ";" << op << ";" << threads << ";" << total_ops << ";"
+         << ops_per_sec << ";"
+         << ops_per_sec/(threads*base_ops_per_sec) << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0]
+             << " index_file max_threads [log_ops]" << endl;
+        return 1;
+    }
+    uint64_t max_threads = stoull(argv[2]);
+    uint64_t log_ops = (argc > 3) ? stoull(argv[3]) : 14;
+    const uint64_t ops = 1ULL<<log_ops;
+    const uint64_t pat_len = 10;
+    const uint64_t extract_len = 64;
+
+    CSA_TYPE csa;
+    if (!load_from_file(csa, argv[1])) {
+        cerr << "could not load index " << argv[1] << endl;
+        return 1;
+    }
+    std::mt19937_64 rng(4711);
+    // one private pattern sequence per thread, all sampled identically,
+    // so higher thread counts add load but not new working-set skew
+    vector<pattern_set> ps;
+    for (uint64_t t=0; t < max_threads; ++t) {
+        ps.push_back(sample_patterns(csa, ops, pat_len, rng));
+    }
+
+    cout << "# index;op;threads;total_ops;ops_per_sec;efficiency" << endl;
+    double base_count = 0, base_locate = 0, base_extract = 0;
+    for (uint64_t t=1; t <= max_threads; t <<= 1) {
+        double ops_s;
+        ops_s = run_threads(t, ops, [&](uint64_t tid, uint64_t i) {
+            const string& p = ps[tid].patterns[i];
+            return count(csa, p.begin(), p.end());
+        });
+        if (1 == t) base_count = ops_s;
+        report("count", t, t*ops, ops_s, base_count);
+
+        ops_s = run_threads(t, ops>>4, [&](uint64_t tid, uint64_t i) {
+            const string& p = ps[tid].patterns[i];
+            return locate(csa, p.begin(), p.end()).size();
+        });
+        if (1 == t) base_locate = ops_s;
+        report("locate", t, t*(ops>>4), ops_s, base_locate);
+
+        ops_s = run_threads(t, ops>>2, [&](uint64_t tid, uint64_t i) {
+            uint64_t b = ps[tid].positions[i] % (csa.size()-extract_len-1);
+            return extract(csa, b, b+extract_len-1).size();
+        });
+        if (1 == t) base_extract = ops_s;
+        report("extract", t, t*(ops>>2), ops_s, base_extract);
+    }
+    cerr << "# checksum = " << g_checksum.load() << endl;
+    return 0;
+}
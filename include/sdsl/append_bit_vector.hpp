@@ -0,0 +1,313 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file append_bit_vector.hpp
+    \brief append_bit_vector.hpp contains an append-only bit vector with
+           rank and select support over the growing sequence.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_APPEND_BIT_VECTOR
+#define INCLUDED_SDSL_APPEND_BIT_VECTOR
+
+#include <algorithm>
+#include "int_vector.hpp"
+#include "rank_support_v.hpp"
+#include "select_support_mcl.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! An append-only bit vector with rank and select support.
+/*! \tparam t_buf_bits Tail capacity in bits; when the tail reaches this
+ *                     size it is merged into the frozen core. Must be a
+ *                     multiple of 512.
+ *
+ *  The sequence is split into a frozen core, supported by a
+ *  precomputed rank and select structure, and a small append tail with
+ *  cumulative counts per 512-bit block maintained on the fly. A query
+ *  is answered from the core structure or from the tail counts plus a
+ *  popcount over at most eight words, so it stays close to static
+ *  speed; a push_back costs amortized constant time. When the tail
+ *  runs full it is merged into the core and the core supports are
+ *  rebuilt — an \f$ \Order{n} \f$ rebuild every t_buf_bits appends —
+ *  so new data is queryable immediately instead of after a full
+ *  reconstruction.
+ */
+template<uint32_t t_buf_bits = 1<<20>
+class append_bit_vector
+{
+    public:
+        static_assert(t_buf_bits > 0 and t_buf_bits % 512 == 0,
+                      "append_bit_vector: t_buf_bits must be a positive multiple of 512");
+        typedef bit_vector::size_type size_type;
+        typedef bit_vector::value_type value_type;
+
+    private:
+        bit_vector            m_core;      // frozen prefix
+        rank_support_v<1>     m_core_rank;
+        select_support_mcl<1> m_core_select;
+        size_type             m_core_ones = 0;
+        bit_vector            m_tail;      // append buffer; only the first
+        size_type             m_tail_size = 0; // m_tail_size bits are live
+        size_type             m_tail_ones = 0;
+        int_vector<64>        m_tail_cnt;  // ones before each 512-bit tail block
+
+        void copy(const append_bit_vector& v)
+        {
+            m_core = v.m_core;
+            m_core_rank = v.m_core_rank;
+            m_core_rank.set_vector(&m_core);
+            m_core_select = v.m_core_select;
+            m_core_select.set_vector(&m_core);
+            m_core_ones = v.m_core_ones;
+            m_tail = v.m_tail;
+            m_tail_size = v.m_tail_size;
+            m_tail_ones = v.m_tail_ones;
+            m_tail_cnt = v.m_tail_cnt;
+        }
+
+        //! Number of ones in the tail prefix [0..j-1].
+        size_type tail_rank(size_type j) const
+        {
+            size_type res = m_tail_cnt[j>>9];
+            const uint64_t* data = m_tail.data();
+            for (size_type w=(j>>9)<<3; w < (j>>6); ++w) {
+                res += bits::cnt(data[w]);
+            }
+            if (j & 0x3F) {
+                res += bits::cnt(data[j>>6] & bits::lo_set[j&0x3F]);
+            }
+            return res;
+        }
+
+        //! Position of the j-th one in the tail.
+        size_type tail_select(size_type j) const
+        {
+            // last block with fewer than j ones before it
+            size_type lb = 0, rb = (m_tail_size+511)>>9;
+            while (rb - lb > 1) { // invariant: m_tail_cnt[lb] < j
+                size_type mid = lb + (rb-lb)/2;
+                if (m_tail_cnt[mid] < j) {
+                    lb = mid;
+                } else {
+                    rb = mid;
+                }
+            }
+            size_type rest = j - m_tail_cnt[lb];
+            const uint64_t* data = m_tail.data();
+            size_type w = lb<<3;
+            while (bits::cnt(data[w]) < rest) {
+                rest -= bits::cnt(data[w]);
+                ++w;
+            }
+            return (w<<6) + bits::sel(data[w], rest);
+        }
+
+    public:
+        append_bit_vector()
+        {
+            m_tail_cnt = int_vector<64>((t_buf_bits>>9)+1, 0);
+            util::init_support(m_core_rank, &m_core);
+            util::init_support(m_core_select, &m_core);
+        }
+
+        append_bit_vector(const append_bit_vector& v)
+        {
+            copy(v);
+        }
+
+        append_bit_vector(append_bit_vector&& v)
+        {
+            *this = std::move(v);
+        }
+
+        append_bit_vector& operator=(const append_bit_vector& v)
+        {
+            if (this != &v) {
+                copy(v);
+            }
+            return *this;
+        }
+
+        append_bit_vector& operator=(append_bit_vector&& v)
+        {
+            if (this != &v) {
+                m_core = std::move(v.m_core);
+                m_core_rank = std::move(v.m_core_rank);
+                m_core_rank.set_vector(&m_core);
+                m_core_select = std::move(v.m_core_select);
+                m_core_select.set_vector(&m_core);
+                m_core_ones = v.m_core_ones;
+                m_tail = std::move(v.m_tail);
+                m_tail_size = v.m_tail_size;
+                m_tail_ones = v.m_tail_ones;
+                m_tail_cnt = std::move(v.m_tail_cnt);
+            }
+            return *this;
+        }
+
+        //! Appends bit b to the sequence.
+        /*! Amortized constant time; triggers a merge of the tail into
+         *  the core every t_buf_bits appends.
+         */
+        void push_back(value_type b)
+        {
+            if (m_tail_size == t_buf_bits) {
+                merge();
+            }
+            if (m_tail_size == m_tail.size()) {
+                m_tail.resize(std::min<size_type>(t_buf_bits,
+                                                  std::max<size_type>(512, 2*m_tail.size())));
+            }
+            if (0 == (m_tail_size & 0x1FF)) {
+                m_tail_cnt[m_tail_size>>9] = m_tail_ones;
+                // clear the block so that word-wise popcounts see zeros
+                // after the live bits
+                for (size_type w=(m_tail_size>>6); w < std::min(m_tail.size(), m_tail_size+512)>>6; ++w) {
+                    m_tail.data()[w] = 0;
+                }
+            }
+            m_tail[m_tail_size] = b;
+            m_tail_ones += b;
+            ++m_tail_size;
+            if (0 == (m_tail_size & 0x1FF)) {
+                // keep the boundary entry valid for rank(size()) queries
+                m_tail_cnt[m_tail_size>>9] = m_tail_ones;
+            }
+        }
+
+        //! Merges the tail into the frozen core and rebuilds its supports.
+        /*! \f$ \Order{n} \f$; called automatically when the tail is full.
+         */
+        void merge()
+        {
+            if (0 == m_tail_size) {
+                return;
+            }
+            size_type old = m_core.size();
+            m_core.resize(old + m_tail_size);
+            for (size_type off=0; off < m_tail_size; off += 64) {
+                uint8_t len = (uint8_t)std::min<size_type>(64, m_tail_size-off);
+                m_core.set_int(old+off, m_tail.get_int(off, len), len);
+            }
+            util::init_support(m_core_rank, &m_core);
+            util::init_support(m_core_select, &m_core);
+            m_core_ones += m_tail_ones;
+            m_tail_size = 0;
+            m_tail_ones = 0;
+        }
+
+        //! Length of the sequence.
+        size_type size() const
+        {
+            return m_core.size() + m_tail_size;
+        }
+
+        //! Number of ones in the sequence.
+        size_type ones() const
+        {
+            return m_core_ones + m_tail_ones;
+        }
+
+        //! Accessing the i-th element of the sequence.
+        value_type operator[](size_type i) const
+        {
+            assert(i < size());
+            if (i < m_core.size()) {
+                return m_core[i];
+            }
+            return m_tail[i - m_core.size()];
+        }
+
+        //! Number of ones in the prefix [0..i-1].
+        /*! \param i An index i with \f$ 0 \leq i \leq size() \f$.
+         */
+        size_type rank(size_type i) const
+        {
+            assert(i <= size());
+            if (i <= m_core.size()) {
+                return m_core_rank(i);
+            }
+            return m_core_ones + tail_rank(i - m_core.size());
+        }
+
+        //! Position of the i-th one in the sequence.
+        /*! \param i An index i with \f$ 1 \leq i \leq ones() \f$.
+         */
+        size_type select(size_type i) const
+        {
+            assert(i > 0 and i <= ones());
+            if (i <= m_core_ones) {
+                return m_core_select(i);
+            }
+            return m_core.size() + tail_select(i - m_core_ones);
+        }
+
+        //! Swap method
+        void swap(append_bit_vector& v)
+        {
+            if (this != &v) {
+                m_core.swap(v.m_core);
+                util::swap_support(m_core_rank, v.m_core_rank,
+                                   &m_core, &v.m_core);
+                util::swap_support(m_core_select, v.m_core_select,
+                                   &m_core, &v.m_core);
+                std::swap(m_core_ones, v.m_core_ones);
+                m_tail.swap(v.m_tail);
+                std::swap(m_tail_size, v.m_tail_size);
+                std::swap(m_tail_ones, v.m_tail_ones);
+                m_tail_cnt.swap(v.m_tail_cnt);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += m_core.serialize(out, child, "core");
+            written_bytes += m_core_rank.serialize(out, child, "core_rank");
+            written_bytes += m_core_select.serialize(out, child, "core_select");
+            written_bytes += write_member(m_core_ones, out, child, "core_ones");
+            written_bytes += m_tail.serialize(out, child, "tail");
+            written_bytes += write_member(m_tail_size, out, child, "tail_size");
+            written_bytes += write_member(m_tail_ones, out, child, "tail_ones");
+            written_bytes += m_tail_cnt.serialize(out, child, "tail_cnt");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            m_core.load(in);
+            m_core_rank.load(in, &m_core);
+            m_core_select.load(in, &m_core);
+            read_member(m_core_ones, in);
+            m_tail.load(in);
+            read_member(m_tail_size, in);
+            read_member(m_tail_ones, in);
+            m_tail_cnt.load(in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -0,0 +1,129 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file async_filebuf.hpp
+    \brief async_filebuf.hpp contains a file stream buffer which keeps several
+           large I/O requests in flight (io_uring or a worker thread).
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_ASYNC_FILEBUF
+#define INCLUDED_SDSL_ASYNC_FILEBUF
+
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace sdsl
+{
+
+//! A std::streambuf backed by asynchronous file I/O.
+/*! The buffer splits the stream into large chunks and keeps up to
+ *  queue_depth chunk requests in flight, submitted either through a raw
+ *  io_uring ring (Linux, with the chunk buffers registered with the kernel
+ *  when permitted) or, where io_uring is not available, through a worker
+ *  thread issuing pread/pwrite calls. Reads are prefetched ahead of the
+ *  stream position, writes are retired in the background, so sequential
+ *  scans over cache files overlap computation with I/O and amortize the
+ *  syscall cost over chunk-sized requests.
+ *
+ *  A buffer instance supports exactly one direction: it has to be opened
+ *  either in pure input or in pure output mode. osfstream/isfstream select
+ *  this buffer for plain files when construct_config::stream_queue_depth
+ *  is non-zero and fall back to std::filebuf otherwise.
+ */
+class async_filebuf : public std::streambuf
+{
+    public:
+        // completion-queue entry of the I/O engines: (buffer index, result)
+        struct io_result {
+            uint64_t idx;
+            int64_t  res;  // transferred bytes or -errno
+        };
+        // interface of the two backends; defined in async_filebuf.cpp
+        struct io_engine {
+            virtual bool start(int fd, std::vector<std::vector<char>>& bufs) = 0;
+            virtual void submit(uint64_t idx, uint64_t file_off, uint64_t len,
+                                bool read, uint64_t buf_off) = 0;
+            virtual io_result wait() = 0;
+            virtual ~io_engine() {}
+        };
+    private:
+        int         m_fd = -1;
+        bool        m_write_mode = false;
+        bool        m_error      = false;
+        uint64_t    m_chunk      = 0;    // size of one I/O buffer in bytes
+        io_engine*  m_engine     = nullptr;
+        std::vector<std::vector<char>> m_buf;    // queue_depth+1 chunk buffers
+        std::vector<uint8_t>  m_state;           // per buffer: free/in-flight/ready
+        std::vector<uint64_t> m_op_off;          // submitted file offset per buffer
+        std::vector<uint64_t> m_op_len;          // submitted resp. completed length
+        uint64_t    m_inflight = 0;
+        uint64_t    m_cur      = 0;       // buffer holding the active put area
+        uint64_t    m_pos      = 0;       // file offset of the active put area
+        uint64_t    m_next_off = 0;       // in: file offset after the get area
+        uint64_t    m_submit_off = 0;     // in: next offset to prefetch
+        bool        m_stop_submit = false; // in: a short read ended the pipeline
+        bool        m_at_eof      = false; // in: m_next_off is the end of file
+        uint64_t    m_eof_off     = 0;
+
+        void reap_one();                  // retire one completion
+        void drain();                     // retire all outstanding requests
+        void fill_pipeline();             // in: submit prefetch reads
+        uint64_t acquire_free();          // out: index of a free buffer
+        bool flush_put();                 // out: submit the active put area
+        void reset_get(uint64_t pos);     // in: restart the pipeline at pos
+        uint64_t file_size();
+        pos_type seek(off_type off, std::ios_base::seekdir way);
+
+    public:
+        async_filebuf() {}
+        ~async_filebuf() override;
+
+        //! Open file in pure input or pure output mode; nullptr on failure.
+        std::streambuf*
+        open(const std::string& file, std::ios_base::openmode mode);
+
+        bool is_open();
+
+        async_filebuf*
+        close();
+
+        pos_type
+        seekpos(pos_type sp,
+                std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+        pos_type
+        seekoff(off_type off, std::ios_base::seekdir way,
+                std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+        int
+        sync() override;
+
+        int_type
+        overflow(int_type c = traits_type::eof()) override;
+
+        int_type
+        underflow() override;
+
+        //! Bulk read; requests of at least one chunk bypass the pipeline.
+        std::streamsize
+        xsgetn(char_type* s, std::streamsize n) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,209 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file bidirectional_index.hpp
+    \brief bidirectional_index.hpp contains a wrapper class which packages
+           the CSAs of the forward and the backward text for bidirectional
+           search.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_BIDIRECTIONAL_INDEX
+#define INCLUDED_SDSL_BIDIRECTIONAL_INDEX
+
+#include "csa_wt.hpp"
+#include "suffix_array_algorithm.hpp"
+#include "construct.hpp"
+#include "util.hpp"
+#include <string>
+
+namespace sdsl
+{
+
+//! A bidirectional index consisting of the CSAs of the forward and backward text.
+/*! The class owns both CSAs and keeps their intervals synchronized, so a
+ *  pattern can be extended by single characters on either side; this is
+ *  the primitive needed e.g. for maximal exact match enumeration. The
+ *  backward CSA is constructed from the already cached forward text, so
+ *  the input is parsed only once.
+ *
+ * \tparam t_csa CSA type of both directions; the wavelet tree has to be
+ *               lex_ordered (see bidirectional_search).
+ *
+ * \par Reference
+ *         Thomas Schnattinger, Enno Ohlebusch, Simon Gog:
+ *         Bidirectional search in a string with wavelet trees and bidirectional matching statistics.
+ *         Inf. Comput. 213: 13-22
+ */
+template<class t_csa = csa_wt<wt_blcd<>>>
+class bidirectional_index
+{
+    public:
+        typedef t_csa                             csa_type;
+        typedef typename t_csa::size_type         size_type;
+        typedef typename t_csa::char_type         char_type;
+        typedef typename t_csa::alphabet_category alphabet_category;
+        typedef csa_tag                           index_category;
+
+        //! Interval state; represents the same pattern in both CSAs.
+        struct interval_type {
+            size_type l_fwd, r_fwd;  // interval in the CSA of the forward text
+            size_type l_bwd, r_bwd;  // interval in the CSA of the backward text
+
+            //! Number of occurrences of the represented pattern
+            size_type size() const
+            {
+                return r_fwd-l_fwd+1;
+            }
+        };
+
+    private:
+        csa_type m_fwd;  // CSA of the forward text
+        csa_type m_bwd;  // CSA of the backward text
+
+    public:
+        const csa_type& fwd = m_fwd;
+        const csa_type& bwd = m_bwd;
+
+        //! Default constructor
+        bidirectional_index() {}
+
+        //! Constructor
+        /*! \param config Cache configuration; the caches of the forward
+         *                text (text, SA, BWT) are expected to be present.
+         *                The backward caches are derived from the cached
+         *                forward text under the id `<id>_rev`.
+         */
+        bidirectional_index(cache_config& config)
+        {
+            {
+                csa_type tmp(config);
+                m_fwd.swap(tmp);
+            }
+            const char* KEY_TEXT = key_text_trait<alphabet_category::WIDTH>::KEY_TEXT;
+            cache_config rev_config(config.delete_files, config.dir,
+                                    config.id+"_rev");
+            rev_config.resume = config.resume;
+            {
+                int_vector<alphabet_category::WIDTH> text;
+                load_from_cache(text, KEY_TEXT, config);
+                // reverse the text; the zero sentinel stays at the end
+                size_type n = text.size();
+                for (size_type i=0, j=(n >= 2 ? n-2 : 0); i < j; ++i, --j) {
+                    auto tmp = (typename int_vector<alphabet_category::WIDTH>::value_type)text[i];
+                    text[i] = text[j];
+                    text[j] = tmp;
+                }
+                store_to_cache(text, KEY_TEXT, rev_config);
+                phase_complete(KEY_TEXT, rev_config);
+            }
+            // run the normal CSA pipeline on the cached backward text
+            construct(m_bwd, "", rev_config, 0, csa_tag());
+        }
+
+        //! Copy constructor
+        bidirectional_index(const bidirectional_index& idx) :
+            m_fwd(idx.m_fwd), m_bwd(idx.m_bwd) {}
+
+        //! Assignment operation
+        bidirectional_index& operator=(const bidirectional_index& idx)
+        {
+            if (this != &idx) {
+                m_fwd = idx.m_fwd;
+                m_bwd = idx.m_bwd;
+            }
+            return *this;
+        }
+
+        //! Swap operation
+        void swap(bidirectional_index& idx)
+        {
+            if (this != &idx) {
+                m_fwd.swap(idx.m_fwd);
+                m_bwd.swap(idx.m_bwd);
+            }
+        }
+
+        //! Number of elements of the forward CSA.
+        size_type size() const
+        {
+            return m_fwd.size();
+        }
+
+        //! Returns the interval of the empty pattern.
+        interval_type init_interval() const
+        {
+            return {0, m_fwd.size()-1, 0, m_bwd.size()-1};
+        }
+
+        //! Extends the pattern by character c on the left.
+        /*! \param c  Character which is prepended to the pattern.
+         *  \param iv Interval of the pattern; is replaced by the interval
+         *            of the extended pattern.
+         *  \return Number of occurrences of the extended pattern;
+         *          if it is zero, iv is unchanged.
+         */
+        size_type extend_left(char_type c, interval_type& iv) const
+        {
+            interval_type res = iv;
+            size_type occs = bidirectional_search(m_fwd, iv.l_fwd, iv.r_fwd,
+                                                  iv.l_bwd, iv.r_bwd, c,
+                                                  res.l_fwd, res.r_fwd,
+                                                  res.l_bwd, res.r_bwd);
+            if (occs > 0) {
+                iv = res;
+            }
+            return occs;
+        }
+
+        //! Extends the pattern by character c on the right.
+        /*! \param c  Character which is appended to the pattern.
+         *  \param iv Interval of the pattern; is replaced by the interval
+         *            of the extended pattern.
+         *  \return Number of occurrences of the extended pattern;
+         *          if it is zero, iv is unchanged.
+         */
+        size_type extend_right(char_type c, interval_type& iv) const
+        {
+            interval_type res = iv;
+            size_type occs = bidirectional_search(m_bwd, iv.l_bwd, iv.r_bwd,
+                                                  iv.l_fwd, iv.r_fwd, c,
+                                                  res.l_bwd, res.r_bwd,
+                                                  res.l_fwd, res.r_fwd);
+            if (occs > 0) {
+                iv = res;
+            }
+            return occs;
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += m_fwd.serialize(out, child, "fwd");
+            written_bytes += m_bwd.serialize(out, child, "bwd");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in)
+        {
+            m_fwd.load(in);
+            m_bwd.load(in);
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -38,6 +38,9 @@ class rank_support_il;  // in bit_vector_il
 template<uint8_t t_b=1,uint32_t t_bs=512>// forward declaration needed for friend declaration
 class select_support_il;  // in bit_vector_il
 
+template<uint8_t t_b=1,uint32_t t_bs=512>// forward declaration needed for friend declaration
+class rank_select_support_il;  // in bit_vector_il
+
 template<class T>
 constexpr bool power_of_two(T x)
 {
@@ -71,6 +74,8 @@ class bit_vector_il
         friend class rank_support_il<0,t_bs>;
         friend class select_support_il<1,t_bs>;
         friend class select_support_il<0,t_bs>;
+        friend class rank_select_support_il<1,t_bs>;
+        friend class rank_select_support_il<0,t_bs>;
 
         typedef rank_support_il<1,t_bs>     rank_1_type;
         typedef rank_support_il<0,t_bs>     rank_0_type;
@@ -517,5 +522,161 @@ class select_support_il
         }
 };
 
+//! A combined rank and select support for bit_vector_il.
+/*!
+ * Stores for every t_bs-th argument the index of the superblock which
+ * contains it. A select query therefore jumps directly to a narrow
+ * superblock range and resolves it against the rank counters which are
+ * interleaved with the data, instead of binary searching the separate
+ * rank-sample tree select_support_il uses. A rank-then-select pair (the
+ * pattern in bp_support and wavelet tree navigation) thus works on the
+ * same interleaved cache lines for both queries.
+ *
+ * \tparam t_b  Bit pattern `0` or `1`.
+ * \tparam t_bs Block size of the supported bit_vector_il.
+ */
+template<uint8_t t_b, uint32_t t_bs>
+class rank_select_support_il
+{
+        static_assert(t_b == 1 or t_b == 0 , "rank_select_support_il only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef bit_vector_il<t_bs>   bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+        rank_support_il<t_b, t_bs> m_rank;
+        size_type m_block_shift;
+        size_type m_block_size_U64;
+        size_type m_arg_cnt = 0;
+        int_vector<> m_hint; // superblock index of every t_bs-th argument
+
+        // cumulative number of arguments before superblock sb
+        size_type sblock_args(size_type sb) const
+        {
+            size_type pos = (sb << m_block_size_U64) + sb;
+            uint64_t ones = m_v->m_data[pos];
+            return t_b ? ones : (sb << m_block_shift) - ones;
+        }
+
+        void init_hints()
+        {
+            m_arg_cnt = 0;
+            m_hint = int_vector<>();
+            if (m_v == nullptr or m_v->size() == 0)
+                return;
+            m_arg_cnt = m_rank.rank(m_v->size());
+            if (m_arg_cnt == 0)
+                return;
+            m_hint = int_vector<>((m_arg_cnt+t_bs-1)/t_bs, 0,
+                                  bits::hi(m_v->m_superblocks)+1);
+            size_type s = 0;
+            for (size_type sb = 0; sb < m_v->m_superblocks and s < m_hint.size(); ++sb) {
+                size_type args_after = (sb+1 < m_v->m_superblocks)
+                                       ? sblock_args(sb+1) : m_arg_cnt;
+                while (s < m_hint.size() and args_after > s*t_bs) {
+                    m_hint[s++] = sb;
+                }
+            }
+        }
+
+    public:
+        explicit rank_select_support_il(const bit_vector_type* v=nullptr)
+        {
+            m_block_shift = bits::hi(t_bs);
+            m_block_size_U64 = bits::hi(t_bs>>6);
+            set_vector(v);
+            init_hints();
+        }
+
+        //! Returns the number of arguments in the prefix [0..i-1].
+        size_type rank(size_type i) const
+        {
+            return m_rank.rank(i);
+        }
+
+        //! Returns the position of the i-th argument in the bit vector.
+        size_type select(size_type i) const
+        {
+            assert(i > 0 and i <= m_arg_cnt);
+            size_type j = (i-1)/t_bs;
+            // search interval [lb..rb), bounded by two adjacent hints
+            size_type lb = m_hint[j];
+            size_type rb = (j+1 < m_hint.size()) ? m_hint[j+1]+1
+                                                 : m_v->m_superblocks;
+            // invariant: lb==0 or sblock_args(lb-1) < i; sblock_args(rb) >= i
+            while (lb < rb) {
+                size_type mid = (lb+rb)/2;
+                if (sblock_args(mid) >= i) {
+                    rb = mid;
+                } else {
+                    lb = mid + 1;
+                }
+            }
+            size_type res = (rb-1) << m_block_shift;
+            /* iterate in 64 bit steps */
+            const uint64_t* w = m_v->m_data.data()
+                                + ((rb-1) << m_block_size_U64) + (rb-1);
+            i -= sblock_args(rb-1); // subtract cumulative sum before the superblock
+            ++w; /* step into the data */
+            size_type args = t_b ? bits::cnt(*w) : bits::cnt(~ *w);
+            while (args < i) {
+                i -= args; ++w;
+                args = t_b ? bits::cnt(*w) : bits::cnt(~ *w);
+                res += 64;
+            }
+            /* handle last word */
+            res += bits::sel(t_b ? *w : ~ *w, i);
+            return res;
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+            m_rank.set_vector(v);
+        }
+
+        rank_select_support_il& operator=(const rank_select_support_il& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+                m_arg_cnt = rs.m_arg_cnt;
+                m_hint = rs.m_hint;
+            }
+            return *this;
+        }
+
+        void swap(rank_select_support_il& rs)
+        {
+            std::swap(m_v, rs.m_v);
+            m_rank.swap(rs.m_rank);
+            std::swap(m_arg_cnt, rs.m_arg_cnt);
+            m_hint.swap(rs.m_hint);
+        }
+
+        void load(std::istream& in, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+            read_member(m_arg_cnt, in);
+            m_hint.load(in);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_arg_cnt, out, child, "arg_cnt");
+            written_bytes += m_hint.serialize(out, child, "hint");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+};
+
 } // end namespace sdsl
 #endif
@@ -0,0 +1,132 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file bit_vector_ops.hpp
+    \brief bit_vector_ops.hpp contains bulk logical operations on
+           bit_vector which can build the rank support of the result
+           in the same pass.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_BIT_VECTOR_OPS
+#define INCLUDED_SDSL_BIT_VECTOR_OPS
+
+#include "int_vector.hpp"
+#include "rank_support_v.hpp"
+#include <cassert>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! \defgroup bv_ops Bulk logical operations on bit_vector
+/*! Word-parallel AND/OR/ANDNOT over whole bit vectors. Each operation
+ *  exists in two flavors: plain, and fused with the construction of a
+ *  rank_support_v<1,1> over the result. The fused flavor counts the set
+ *  bits of every result word while it is still in registers, so the
+ *  result vector is written exactly once and never re-read to build the
+ *  support -- for vectors beyond cache size this halves the memory
+ *  traffic of an op-then-init_support sequence.
+ *
+ *  The result reference may alias one of the operands (in-place update).
+ *  The fused flavors bind the support to `res`, so `res` must stay at
+ *  its address while the support is in use (as after init_support).
+ *  \{
+ */
+
+template<class t_op>
+void _bv_bulk_op(const bit_vector& a, const bit_vector& b, bit_vector& res,
+                 rank_support_v<1,1>* rs, t_op op)
+{
+    assert(a.size() == b.size());
+    if (&res != &a and &res != &b) {
+        res.resize(a.size());
+    }
+    const uint64_t* da = a.data();
+    const uint64_t* db = b.data();
+    uint64_t*       dr = res.data();
+    bit_vector::size_type words = (a.size()+63)>>6;
+    if (rs != nullptr) {
+        typename rank_support_v<1,1>::builder builder;
+        builder.init(a.size());
+        // compute a cache-resident chunk with the plain (vectorizable)
+        // loop, then count its words while they are still in L1; the
+        // result is written once and never fetched back from memory
+        const bit_vector::size_type chunk = 4096; // 32 KB
+        for (bit_vector::size_type c=0; c < words; c += chunk) {
+            bit_vector::size_type end = std::min(words, c+chunk);
+            for (bit_vector::size_type w=c; w < end; ++w) {
+                dr[w] = op(da[w], db[w]);
+            }
+            builder.add_words(dr+c, end-c);
+        }
+        *rs = builder.finish(&res);
+    } else {
+        for (bit_vector::size_type w=0; w < words; ++w) {
+            dr[w] = op(da[w], db[w]);
+        }
+    }
+}
+
+//! res = a AND b.
+inline void bv_and(const bit_vector& a, const bit_vector& b, bit_vector& res)
+{
+    _bv_bulk_op(a, b, res, nullptr,
+                [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+//! res = a AND b; rs becomes the rank support of res, built in the same pass.
+inline void bv_and(const bit_vector& a, const bit_vector& b, bit_vector& res,
+                   rank_support_v<1,1>& rs)
+{
+    _bv_bulk_op(a, b, res, &rs,
+                [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+//! res = a OR b.
+inline void bv_or(const bit_vector& a, const bit_vector& b, bit_vector& res)
+{
+    _bv_bulk_op(a, b, res, nullptr,
+                [](uint64_t x, uint64_t y) { return x | y; });
+}
+
+//! res = a OR b; rs becomes the rank support of res, built in the same pass.
+inline void bv_or(const bit_vector& a, const bit_vector& b, bit_vector& res,
+                  rank_support_v<1,1>& rs)
+{
+    _bv_bulk_op(a, b, res, &rs,
+                [](uint64_t x, uint64_t y) { return x | y; });
+}
+
+//! res = a AND NOT b.
+inline void bv_andnot(const bit_vector& a, const bit_vector& b, bit_vector& res)
+{
+    _bv_bulk_op(a, b, res, nullptr,
+                [](uint64_t x, uint64_t y) { return x & ~y; });
+}
+
+//! res = a AND NOT b; rs becomes the rank support of res, built in the same pass.
+inline void bv_andnot(const bit_vector& a, const bit_vector& b, bit_vector& res,
+                      rank_support_v<1,1>& rs)
+{
+    _bv_bulk_op(a, b, res, &rs,
+                [](uint64_t x, uint64_t y) { return x & ~y; });
+}
+
+//! \}
+
+}// end namespace sdsl
+
+#endif // end file
@@ -9,6 +9,9 @@
 #include "bit_vector_il.hpp"
 #include "rrr_vector.hpp"
 #include "sd_vector.hpp"
+#include "gap_vector.hpp"
+#include "pef_vector.hpp"
 #include "hyb_vector.hpp"
+#include "append_bit_vector.hpp"
 
 #endif
@@ -22,6 +22,7 @@
 #define INCLUDED_SDSL_BITS
 
 #include <cstdint> // for uint64_t uint32_t declaration
+#include <iosfwd>  // for the dispatch report stream
 #ifdef __BMI2__
 #include <immintrin.h>
 #endif
@@ -33,6 +34,28 @@
 #include "iso646.h"
 #endif
 
+// the dispatch pointers (cnt_impl, sel_impl) are declared and defined
+// for every GCC/Clang x86 build, independent of the ISA flags of the
+// translation unit, so the library ABI does not change with compile
+// flags: a library built with -msse4.2 still defines the symbols a
+// plain -O2 consumer references
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SDSL_X86_DISPATCH_SYMBOLS
+#endif
+
+// runtime CPU dispatch for the in-word select kernel: used whenever
+// BMI2 was not already enabled at compile time
+#if defined(SDSL_X86_DISPATCH_SYMBOLS) && !defined(__BMI2__)
+#define SDSL_SEL_X86_DISPATCH
+#endif
+
+// runtime CPU dispatch for the in-word popcount kernel: used whenever
+// POPCNT (implied by SSE4.2) was not already enabled at compile time
+// and no lookup-table popcount was requested
+#if defined(SDSL_X86_DISPATCH_SYMBOLS) && !defined(__SSE4_2__) && !defined(POPCOUNT_TL)
+#define SDSL_CNT_X86_DISPATCH
+#endif
+
 //! Namespace for the succinct data structure library.
 namespace sdsl
 {
@@ -107,6 +130,55 @@ struct bits {
      */
     static uint64_t cnt(uint64_t x);
 
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+    //! Pointer to the in-word popcount kernel used by cnt.
+    /*! Resolves on first use (CPUID check) to the POPCNT instruction if
+        the executing CPU supports it, and to the broadword implementation
+        otherwise.
+        \sa cnt
+     */
+    static uint64_t (*cnt_impl)(uint64_t x);
+#endif
+
+    //! Counts the number of set bits in the word_num 64-bit words starting at word.
+    /*! On x86-64 the kernel is selected at runtime: an AVX-512 VPOPCNTDQ or
+        AVX2 implementation processes 8 resp. 4 words per iteration, with a
+        scalar fallback via cnt on older CPUs.
+        \param word     Pointer to the first 64-bit word.
+        \param word_num Number of 64-bit words to process.
+        \return Number of set bits in word[0..word_num-1].
+        \sa cnt
+     */
+    static uint64_t cnt_words(const uint64_t* word, uint64_t word_num);
+
+    //! Counts the number of occurrences of "10" in the word_num words starting at word.
+    /*! The words are interpreted as one bit stream, i.e. the carry between
+        adjacent words is propagated; the stream starts with carry 0. On
+        x86-64 an AVX2 kernel selected at runtime processes 4 words per
+        iteration.
+        \param word     Pointer to the first 64-bit word.
+        \param word_num Number of 64-bit words to process.
+        \return Number of occurrences of "10" in the bit stream.
+        \sa cnt10
+     */
+    static uint64_t cnt10_words(const uint64_t* word, uint64_t word_num);
+
+    //! Counts the number of occurrences of "01" in the word_num words starting at word.
+    /*! Stream variant of cnt01; see cnt10_words for details. The stream
+        starts with carry 1, i.e. it behaves as if preceded by a one.
+        \param word     Pointer to the first 64-bit word.
+        \param word_num Number of 64-bit words to process.
+        \return Number of occurrences of "01" in the bit stream.
+        \sa cnt01
+     */
+    static uint64_t cnt01_words(const uint64_t* word, uint64_t word_num);
+
+    //! Prefetches the cache line containing ptr for reading.
+    /*! A hint only; no operation on compilers without prefetch support.
+        \param ptr Address which will be read soon.
+     */
+    static void prefetch(const void* ptr);
+
     //! Position of the most significant set bit the 64-bit word x
     /*! \param x 64-bit word
         \return The position (in 0..63) of the most significant set bit
@@ -175,6 +247,16 @@ struct bits {
     static uint32_t sel(uint64_t x, uint32_t i);
     static uint32_t _sel(uint64_t x, uint32_t i);
 
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+    //! Pointer to the in-word select kernel used by sel.
+    /*! Resolves on first use (CPUID check) to a BMI2 PDEP-based kernel if
+        the executing CPU supports it, and to the broadword implementation
+        _sel otherwise.
+        \sa sel, _sel
+     */
+    static uint32_t (*sel_impl)(uint64_t x, uint32_t i);
+#endif
+
     //! Calculates the position of the i-th rightmost 11-bit-pattern which terminates a Fibonacci coded integer in x.
     /*!	\param x 64 bit integer.
         \param i Index of 11-bit-pattern. \f$i \in [1..cnt11(x)]\f$
@@ -198,12 +280,28 @@ struct bits {
     //! Writes value x to an bit position in an array.
     static void write_int(uint64_t* word, uint64_t x, const uint8_t offset=0, const uint8_t len=64);
 
+    //! Variant of write_int with the length fixed at compile time.
+    /*! With t_len known to the compiler the masks and shift amounts
+        become immediates.
+        \sa write_int
+     */
+    template<uint8_t t_len>
+    static void write_int(uint64_t* word, uint64_t x, const uint8_t offset=0);
+
     //! Writes value x to an bit position in an array and moves the bit-pointer.
     static void write_int_and_move(uint64_t*& word, uint64_t x, uint8_t& offset, const uint8_t len);
 
     //! Reads a value from a bit position in an array.
     static uint64_t read_int(const uint64_t* word, uint8_t offset=0, const uint8_t len=64);
 
+    //! Variant of read_int with the length fixed at compile time.
+    /*! With t_len known to the compiler the masks and shift amounts
+        become immediates.
+        \sa read_int
+     */
+    template<uint8_t t_len>
+    static uint64_t read_int(const uint64_t* word, uint8_t offset=0);
+
     //! Reads a value from a bit position in an array and moved the bit-pointer.
     static uint64_t read_int_and_move(const uint64_t*& word, uint8_t& offset, const uint8_t len=64);
 
@@ -237,6 +335,29 @@ struct bits {
 
     //! reverses a given 64 bit word
     static uint64_t rev(uint64_t x);
+
+    //! Benchmarks the candidate kernels and installs the fastest ones.
+    /*! For every function with a runtime dispatch (cnt, sel, cnt_words,
+        cnt10_words, cnt01_words) all kernels the executing CPU supports
+        are timed on synthetic data and the fastest one is installed in
+        the dispatch pointer, replacing the default feature-flag based
+        choice. Optional: without this call the first use of each
+        function resolves via CPUID as before. Takes a few milliseconds;
+        intended to run once at startup on heterogeneous fleets where
+        the newest supported instruction set is not always the fastest.
+        No effect for kernels fixed at compile time (e.g. -msse4.2).
+        \sa write_dispatch_report
+     */
+    static void autotune();
+
+    //! Writes one line per dispatched function with the installed kernel.
+    /*! Format: `function: kernel (candidates: a b c)`. Functions whose
+        kernel was fixed at compile time report `compile-time`. Forces
+        the first-use resolution of all dispatch pointers, so the report
+        reflects what subsequent calls will execute.
+        \sa autotune
+     */
+    static void write_dispatch_report(std::ostream& out);
 };
 
 
@@ -247,18 +368,27 @@ inline uint64_t bits::cnt(uint64_t x)
 {
 #ifdef __SSE4_2__
     return static_cast<uint64_t>(__builtin_popcountll(x));
-#else
-#ifdef POPCOUNT_TL
+#elif defined(POPCOUNT_TL)
     return lt_cnt[x&0xFFULL] + lt_cnt[(x>>8)&0xFFULL] +
            lt_cnt[(x>>16)&0xFFULL] + lt_cnt[(x>>24)&0xFFULL] +
            lt_cnt[(x>>32)&0xFFULL] + lt_cnt[(x>>40)&0xFFULL] +
            lt_cnt[(x>>48)&0xFFULL] + lt_cnt[(x>>56)&0xFFULL];
+#elif defined(SDSL_CNT_X86_DISPATCH)
+    return cnt_impl(x);
 #else
     x = x-((x>>1) & 0x5555555555555555ull);
     x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
     x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
     return (0x0101010101010101ull*x >> 56);
 #endif
+}
+
+inline void bits::prefetch(const void* ptr)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr);
+#else
+    (void)ptr;
 #endif
 }
 
@@ -327,6 +457,8 @@ inline uint32_t bits::sel(uint64_t x, uint32_t i)
 #ifdef __BMI2__
     // index i is 1-based here, (i-1) changes it to 0-based
     return static_cast<uint32_t>(__builtin_ctzll(_pdep_u64(1ull << (i-1), x)));
+#elif defined(SDSL_SEL_X86_DISPATCH)
+    return sel_impl(x, i);
 #elif defined(__SSE4_2__)
     uint64_t s = x, b;
     s = s-((s>>1) & 0x5555555555555555ULL);
@@ -389,7 +521,10 @@ inline uint32_t bits::_sel(uint64_t x, uint32_t i)
 // http://www-graphics.stanford.edu/~seander/bithacks.html
 inline uint32_t bits::hi(uint64_t x)
 {
-#ifdef __SSE4_2__
+// __builtin_clzll lowers to a single instruction (bsr/lzcnt/clz) on every
+// supported target, independent of SSE4.2; the Elias delta/gamma and
+// Fibonacci decoders are hot users of this function
+#if defined(__SSE4_2__) || defined(__GNUC__)
     if (x == 0)
         return 0;
     return 63 - static_cast<uint32_t>(__builtin_clzll(x));
@@ -415,7 +550,7 @@ inline uint32_t bits::hi(uint64_t x)
 // or page 10, Knuth TAOCP Vol 4 F1A
 inline uint32_t bits::lo(uint64_t x)
 {
-#ifdef __SSE4_2__
+#if defined(__SSE4_2__) || defined(__GNUC__)
     if (x==0)
         return 0;
     return static_cast<uint32_t>(__builtin_ctzll(x));
@@ -508,6 +643,43 @@ inline uint64_t bits::read_int(const uint64_t* word, uint8_t offset, const uint8
     }
 }
 
+template<uint8_t t_len>
+inline uint64_t bits::read_int(const uint64_t* word, uint8_t offset)
+{
+    static_assert(t_len > 0, "read_int: length must be non-zero");
+    uint64_t w1 = (*word)>>offset;
+    if (t_len < 64 and (offset+t_len) <= 64) { // common case first: value in one word
+        return w1 & bits::lo_set[t_len];
+    } else if (offset == 0) { // t_len == 64 and aligned
+        return w1;
+    } else {
+        return w1 |
+               ((*(word+1) & bits::lo_set[(offset+t_len)&0x3F])
+                << (64-offset));
+    }
+}
+
+template<uint8_t t_len>
+inline void bits::write_int(uint64_t* word, uint64_t x, const uint8_t offset)
+{
+    static_assert(t_len > 0, "write_int: length must be non-zero");
+    x &= bits::lo_set[t_len];
+    if (offset + t_len < 64) {
+        *word &=
+            ((bits::all_set << (offset+t_len)) | bits::lo_set[offset]); // mask 1..10..01..1
+        *word |= (x << offset);
+    } else {
+        *word &=
+            ((bits::lo_set[offset]));  // mask 0....01..1
+        *word |= (x << offset);
+        uint8_t high = (offset+t_len)&0x3F;
+        if (high) { // offset+t_len > 64
+            *(word+1) &= (~bits::lo_set[high]); // mask 1...10..0
+            *(word+1) |= (x >> (t_len-high));
+        }
+    }
+}
+
 inline uint64_t bits::read_int_and_move(const uint64_t*& word, uint8_t& offset, const uint8_t len)
 {
     uint64_t w1 = (*word)>>offset;
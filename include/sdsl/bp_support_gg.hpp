@@ -26,12 +26,18 @@
 #include "rank_support.hpp"
 #include "select_support.hpp"
 #include "bp_support_algorithm.hpp"
+#include "fast_cache.hpp"
 #include "util.hpp"
+#include <algorithm>
 #include <stack>
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 #include <stdexcept>
+#ifdef USE_CACHE
+#include <atomic>
+#endif
 
 namespace sdsl
 {
@@ -89,6 +95,53 @@ class bp_support_gg
         size_type m_size;
         size_type m_blocks; // number of blocks
 
+        struct pair_hash {
+            size_t operator()(const std::pair<size_type,size_type>& p) const {
+                return p.first*0x9E3779B97F4A7C15ULL ^ p.second;
+            }
+        };
+
+#ifdef USE_CACHE
+        // Per-thread memo for find_close and enclose; overlapping
+        // double_enclose/lca chains over hot subtrees repeat these
+        // primitives with the same arguments. Entries are keyed with a
+        // per-structure generation so a rebuilt or reloaded support can
+        // never serve answers of its predecessor, and thread_local
+        // storage keeps concurrent query threads free of shared state.
+        uint64_t m_generation = 0;
+
+        static uint64_t next_generation()
+        {
+            static std::atomic<uint64_t> gen(0);
+            return ++gen;
+        }
+
+        struct cache_key {
+            uint64_t  gen;
+            size_type i;
+            bool operator==(const cache_key& k) const {
+                return gen == k.gen and i == k.i;
+            }
+        };
+        struct cache_key_hash {
+            size_t operator()(const cache_key& k) const {
+                return k.gen*0x9E3779B97F4A7C15ULL ^ k.i;
+            }
+        };
+        typedef query_cache<cache_key, size_type, 13, cache_key_hash> op_cache_type;
+
+        static op_cache_type& find_close_cache()
+        {
+            static thread_local op_cache_type cache;
+            return cache;
+        }
+        static op_cache_type& enclose_cache()
+        {
+            static thread_local op_cache_type cache;
+            return cache;
+        }
+#endif
+
         void copy(const bp_support_gg& bp_support)
         {
             m_bp = bp_support.m_bp;
@@ -103,6 +156,11 @@ class bp_support_gg
             m_blocks = bp_support.m_blocks;
 
 
+#ifdef USE_CACHE
+            // same structure, same answers: the source generation stays valid
+            m_generation = bp_support.m_generation;
+#endif
+
             m_pioneer_bp = bp_support.m_pioneer_bp;
             if (bp_support.m_pioneer_bp_support == nullptr) {
                 delete m_pioneer_bp_support;
@@ -134,6 +192,9 @@ class bp_support_gg
             if (bp == nullptr) { // -> m_bp == nullptr
                 return;
             }
+#ifdef USE_CACHE
+            m_generation = next_generation();
+#endif
             util::init_support(m_rank_bp, bp);
             util::init_support(m_select_bp, bp);
             {
@@ -183,6 +244,9 @@ class bp_support_gg
 
             std::swap(m_size, bp_support.m_size);
             std::swap(m_blocks, bp_support.m_blocks);
+#ifdef USE_CACHE
+            std::swap(m_generation, bp_support.m_generation);
+#endif
 
             m_pioneer_bp.swap(bp_support.m_pioneer_bp);
 
@@ -219,6 +283,9 @@ class bp_support_gg
 
                 m_size = std::move(bp_support.m_size);
                 m_blocks = std::move(bp_support.m_blocks);
+#ifdef USE_CACHE
+                m_generation = bp_support.m_generation;
+#endif
 
                 m_pioneer_bp = bp_support.m_pioneer_bp;
                 delete m_pioneer_bp_support;
@@ -274,6 +341,22 @@ class bp_support_gg
             if (!(*m_bp)[i]) {// if there is a closing parenthesis at index i return i
                 return i;
             }
+#ifdef USE_CACHE
+            cache_key key = {m_generation, i};
+            size_type a;
+            if (find_close_cache().exists(key, a)) {
+                return a;
+            }
+            a = find_close_uncached(i);
+            find_close_cache().write(key, a);
+            return a;
+#else
+            return find_close_uncached(i);
+#endif
+        }
+    private:
+        size_type find_close_uncached(size_type i)const
+        {
             size_type mi = 0; // match for i
             if ((mi=near_find_closing(*m_bp, i+1, 1, t_bs))==i) {
                 const size_type i_ = m_nnd.rank(i+1)-1; // lemma that this gives us an opening pioneer
@@ -289,6 +372,7 @@ class bp_support_gg
             }
             return mi;
         }
+    public:
 
         //! Calculate the matching opening parenthesis
         /*! \param i Index of a closing parenthesis.
@@ -330,6 +414,22 @@ class bp_support_gg
             if (!(*m_bp)[i]) { // if there is closing parenthesis at position i
                 return find_open(i);
             }
+#ifdef USE_CACHE
+            cache_key key = {m_generation, i};
+            size_type a;
+            if (enclose_cache().exists(key, a)) {
+                return a;
+            }
+            a = enclose_uncached(i);
+            enclose_cache().write(key, a);
+            return a;
+#else
+            return enclose_uncached(i);
+#endif
+        }
+    private:
+        size_type enclose_uncached(size_type i)const
+        {
             const size_type exi = excess(i);
             if (exi == 1)  // if i is not enclosed by a parentheses pair..
                 return size();
@@ -347,6 +447,7 @@ class bp_support_gg
             }
             return ei;
         }
+    public:
 
         //! Range restricted enclose operation
         /*! Range restricted enclose operation for parentheses pairs
@@ -482,6 +583,71 @@ class bp_support_gg
                 return enclose(k);
         }
 
+        //! Bulk double enclose operation
+        /*! \param queries Vector of (i,j) pairs; each pair has to fulfill
+         *                 the preconditions of double_enclose.
+         *  \param answers Caller-owned vector; resized to queries.size().
+         *                 After the call answers[k] equals
+         *                 double_enclose(queries[k].first, queries[k].second).
+         *
+         *  The queries are processed ordered by the block of the second
+         *  parenthesis, so consecutive queries work on the same blocks of
+         *  the sequence and of the pioneer structures, and the find_close
+         *  and enclose primitives are memoized in caches local to the
+         *  call. LCA-heavy batches over hot subtrees repeat these
+         *  primitives constantly; a batch of m LCAs of nodes in the same
+         *  subtree then decomposes into few distinct enclose chains
+         *  instead of m full queries. The caches live on the stack of this
+         *  call, so concurrent batches on different threads do not share
+         *  any state.
+         */
+        void double_enclose_bulk(const std::vector<std::pair<size_type,size_type>>& queries,
+                                 std::vector<size_type>& answers)const
+        {
+            answers.resize(queries.size());
+            std::vector<size_type> order(queries.size());
+            for (size_type k=0; k < order.size(); ++k) {
+                order[k] = k;
+            }
+            std::sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                size_type block_a = queries[a].second/t_bs;
+                size_type block_b = queries[b].second/t_bs;
+                if (block_a != block_b) {
+                    return block_a < block_b;
+                }
+                return queries[a].first < queries[b].first;
+            });
+            query_cache<size_type, size_type, 12> fc_cache;
+            query_cache<size_type, size_type, 12> en_cache;
+            query_cache<std::pair<size_type,size_type>, size_type, 12,
+                        pair_hash> de_cache;
+            for (size_type k=0; k < order.size(); ++k) {
+                const size_type i = queries[order[k]].first;
+                const size_type j = queries[order[k]].second;
+                assert(j > i);
+                assert((*m_bp)[i]==1 and(*m_bp)[j]==1);
+                size_type de; // repeated pairs skip the whole query
+                if (de_cache.exists(std::make_pair(i, j), de)) {
+                    answers[order[k]] = de;
+                    continue;
+                }
+                size_type mi; // match for i
+                if (!fc_cache.exists(i, mi)) {
+                    mi = find_close(i);
+                    fc_cache.write(i, mi);
+                }
+                size_type rr = (mi+1 >= j) ? size() : rmq_open(mi+1, j);
+                const size_type target = (rr == size()) ? j : rr;
+                size_type e;
+                if (!en_cache.exists(target, e)) {
+                    e = enclose(target);
+                    en_cache.write(target, e);
+                }
+                de_cache.write(std::make_pair(i, j), e);
+                answers[order[k]] = e;
+            }
+        }
+
         //! Return the number of zeros which procede position i in the balanced parentheses sequence.
         /*! \param i Index of an parenthesis.
          */
@@ -537,6 +703,9 @@ class bp_support_gg
         void load(std::istream& in, const bit_vector* bp)
         {
             m_bp = bp;
+#ifdef USE_CACHE
+            m_generation = next_generation();
+#endif
             read_member(m_size, in);
             read_member(m_blocks, in);
 
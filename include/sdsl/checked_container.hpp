@@ -0,0 +1,386 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file checked_container.hpp
+    \brief checked_container.hpp contains a versioned container file format
+           with per-section integrity checksums and direct section access.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CHECKED_CONTAINER
+#define INCLUDED_SDSL_CHECKED_CONTAINER
+
+#include "io.hpp"
+#include "util.hpp"
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! Constants and helpers of the checked container file format.
+/*! A checked container file looks as follows:
+ *  \verbatim
+ *  header : magic (8 bytes), format version (4), reserved (4)
+ *  body   : the serialized payloads of all sections, back to back
+ *  TOC    : per section: name, type id, offset, length, checksum
+ *  footer : TOC offset (8 bytes), number of sections (8 bytes)
+ *  \endverbatim
+ *  The table of contents (TOC) at the end of the file allows a reader to
+ *  seek directly to any section without touching its predecessors, to skip
+ *  sections whose name or type id it does not know, and to detect a
+ *  truncated write (the footer is written last).
+ */
+namespace checked_container_format
+{
+const uint64_t magic   = 0x3143544E4C534453ULL; // "SDSLNTC1"
+const uint32_t version = 1;
+
+//! 64-bit FNV-1a hash; used as section checksum and type id.
+inline uint64_t fnv1a(const char* data, size_t size,
+                      uint64_t hash = 0xCBF29CE484222325ULL)
+{
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= (uint8_t)data[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+//! Type id of type `T`; the same class-name hash the `_check` files use.
+template<class T>
+uint64_t type_id(const T& t)
+{
+    return util::hashvalue_of_classname(t);
+}
+
+//! One TOC entry.
+struct section_info {
+    std::string name;     // user-chosen section name
+    uint64_t type_hash;   // hash of the class name of the stored object
+    uint64_t offset;      // start of the payload in the file
+    uint64_t length;      // payload length in bytes
+    uint64_t checksum;    // FNV-1a over the payload bytes
+};
+
+//! A streambuf filter which forwards all output and hashes it on the fly.
+class hashing_ostreambuf : public std::streambuf
+{
+    private:
+        std::streambuf* m_target;
+        uint64_t m_hash = 0xCBF29CE484222325ULL;
+    public:
+        hashing_ostreambuf(std::streambuf* target) : m_target(target) {}
+        uint64_t hash() const { return m_hash; }
+    protected:
+        int_type overflow(int_type c = traits_type::eof()) override
+        {
+            if (traits_type::eof() != c) {
+                char ch = traits_type::to_char_type(c);
+                m_hash = fnv1a(&ch, 1, m_hash);
+                return m_target->sputc(ch);
+            }
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            std::streamsize written = m_target->sputn(s, n);
+            if (written > 0) {
+                m_hash = fnv1a(s, written, m_hash);
+            }
+            return written;
+        }
+};
+
+//! A streambuf filter over one section: bounded, forwarding, hashing input.
+/*! Reads at most `length` bytes from the source, so a broken load routine
+ *  cannot run into the next section, and hashes every byte it hands out.
+ */
+class hashing_istreambuf : public std::streambuf
+{
+    private:
+        std::streambuf* m_source;
+        uint64_t m_remaining;
+        uint64_t m_hash = 0xCBF29CE484222325ULL;
+        static const size_t buf_size = 64*1024;
+        std::vector<char> m_buf;
+    public:
+        hashing_istreambuf(std::streambuf* source, uint64_t length)
+            : m_source(source), m_remaining(length), m_buf(buf_size) {}
+        uint64_t hash() const { return m_hash; }
+        //! Bytes of the section which have not been consumed yet.
+        uint64_t remaining() const { return m_remaining + (egptr()-gptr()); }
+        //! Consume and hash the rest of the section.
+        void drain()
+        {
+            while (traits_type::eof() != sbumpc());
+        }
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr()) {
+                return traits_type::to_int_type(*gptr());
+            }
+            if (0 == m_remaining) {
+                return traits_type::eof();
+            }
+            std::streamsize chunk = (std::streamsize)std::min<uint64_t>(m_remaining, buf_size);
+            std::streamsize got = m_source->sgetn(m_buf.data(), chunk);
+            if (got <= 0) {
+                return traits_type::eof();
+            }
+            m_hash = fnv1a(m_buf.data(), got, m_hash);
+            m_remaining -= got;
+            setg(m_buf.data(), m_buf.data(), m_buf.data()+got);
+            return traits_type::to_int_type(*gptr());
+        }
+};
+
+} // end namespace checked_container_format
+
+//! Writer for the checked container format.
+/*! Sections are appended with add() and the table of contents is written
+ *  by close(); a file without a valid footer (e.g. after a crash mid-write)
+ *  is rejected by checked_container_reader instead of producing a corrupt
+ *  structure at query time.
+ *
+ *  \par Example
+ *  \code
+ *  checked_container_writer w("index.sdsl");
+ *  w.add("csa", csa);
+ *  w.add("lcp", lcp);
+ *  w.close();
+ *  \endcode
+ */
+class checked_container_writer
+{
+    public:
+        typedef checked_container_format::section_info section_info;
+    private:
+        osfstream m_out;
+        std::vector<section_info> m_toc;
+        bool m_open = false;
+    public:
+        checked_container_writer() = delete;
+        checked_container_writer(const checked_container_writer&) = delete;
+        checked_container_writer& operator=(const checked_container_writer&) = delete;
+
+        //! Constructor. Opens `file` and writes the format header.
+        checked_container_writer(const std::string& file)
+            : m_out(file, std::ios::binary | std::ios::trunc | std::ios::out)
+        {
+            if (!m_out) {
+                throw std::ios_base::failure("checked_container_writer: could not open file `"+file+"`");
+            }
+            write_member(checked_container_format::magic, m_out);
+            write_member(checked_container_format::version, m_out);
+            write_member((uint32_t)0, m_out); // reserved
+            m_open = true;
+        }
+
+        ~checked_container_writer()
+        {
+            close();
+        }
+
+        //! Serialize `t` as section `name`.
+        /*! \param name Section name; must be unique within the container.
+         *  \param t    Structure to serialize.
+         *  \return Number of payload bytes written.
+         */
+        template<class T>
+        uint64_t add(const std::string& name, const T& t)
+        {
+            if (!m_open) {
+                throw std::logic_error("checked_container_writer: add() after close()");
+            }
+            section_info si;
+            si.name      = name;
+            si.type_hash = checked_container_format::type_id(t);
+            si.offset    = (uint64_t)m_out.tellp();
+            checked_container_format::hashing_ostreambuf buf(m_out.rdbuf());
+            std::ostream hashed_out(&buf);
+            si.length   = serialize(t, hashed_out, nullptr, name);
+            si.checksum = buf.hash();
+            if (!m_out) {
+                throw std::ios_base::failure("checked_container_writer: write error in section `"+name+"`");
+            }
+            m_toc.push_back(si);
+            return si.length;
+        }
+
+        //! Write the table of contents and the footer and close the file.
+        void close()
+        {
+            if (!m_open) {
+                return;
+            }
+            m_open = false;
+            uint64_t toc_offset = (uint64_t)m_out.tellp();
+            for (const section_info& si : m_toc) {
+                write_member(si.name, m_out);
+                write_member(si.type_hash, m_out);
+                write_member(si.offset, m_out);
+                write_member(si.length, m_out);
+                write_member(si.checksum, m_out);
+            }
+            write_member(toc_offset, m_out);
+            write_member((uint64_t)m_toc.size(), m_out);
+            m_out.close();
+        }
+};
+
+//! Reader for the checked container format.
+/*! The constructor validates magic, version, and footer; load() seeks
+ *  directly to the requested section without reading its predecessors,
+ *  verifies the checksum while the bytes stream through the load routine,
+ *  and simply ignores sections it is not asked for — so readers can skip
+ *  sections added by newer writers.
+ */
+class checked_container_reader
+{
+    public:
+        typedef checked_container_format::section_info section_info;
+    private:
+        isfstream m_in;
+        std::map<std::string, section_info> m_toc;
+        std::vector<std::string> m_names; // in file order
+    public:
+        checked_container_reader() = delete;
+        checked_container_reader(const checked_container_reader&) = delete;
+        checked_container_reader& operator=(const checked_container_reader&) = delete;
+
+        //! Constructor. Opens `file` and validates header and footer.
+        checked_container_reader(const std::string& file)
+            : m_in(file, std::ios::binary | std::ios::in)
+        {
+            if (!m_in) {
+                throw std::ios_base::failure("checked_container_reader: could not open file `"+file+"`");
+            }
+            uint64_t magic = 0;
+            uint32_t version = 0, reserved = 0;
+            read_member(magic, m_in);
+            read_member(version, m_in);
+            read_member(reserved, m_in);
+            if (!m_in or checked_container_format::magic != magic) {
+                throw std::runtime_error("checked_container_reader: `"+file+"` is not a checked container");
+            }
+            if (checked_container_format::version < version) {
+                throw std::runtime_error("checked_container_reader: unsupported format version in `"+file+"`");
+            }
+            m_in.seekg(-16, std::ios::end);
+            uint64_t toc_offset = 0, sections = 0;
+            read_member(toc_offset, m_in);
+            read_member(sections, m_in);
+            m_in.seekg(toc_offset);
+            for (uint64_t i = 0; i < sections; ++i) {
+                section_info si;
+                read_member(si.name, m_in);
+                read_member(si.type_hash, m_in);
+                read_member(si.offset, m_in);
+                read_member(si.length, m_in);
+                read_member(si.checksum, m_in);
+                m_names.push_back(si.name);
+                m_toc[si.name] = si;
+            }
+            if (!m_in) {
+                throw std::runtime_error("checked_container_reader: truncated table of contents in `"+file+"`");
+            }
+        }
+
+        //! Check if section `name` is present.
+        bool has(const std::string& name) const
+        {
+            return m_toc.find(name) != m_toc.end();
+        }
+
+        //! Section names in file order.
+        const std::vector<std::string>& names() const { return m_names; }
+
+        //! TOC entry of section `name`; throws if the section is absent.
+        const section_info& info(const std::string& name) const
+        {
+            auto it = m_toc.find(name);
+            if (it == m_toc.end()) {
+                throw std::runtime_error("checked_container_reader: no section `"+name+"`");
+            }
+            return it->second;
+        }
+
+        //! Load section `name` into `t`.
+        /*! \param name Section name.
+         *  \param t    Structure to load into; its type must match the
+         *              type which was stored.
+         *  \return True if the section exists and was loaded.
+         *
+         *  Seeks directly to the section, verifies the checksum while the
+         *  payload streams through `t.load`, and throws std::runtime_error
+         *  on a type or checksum mismatch.
+         */
+        template<class T>
+        bool load(const std::string& name, T& t)
+        {
+            auto it = m_toc.find(name);
+            if (it == m_toc.end()) {
+                return false;
+            }
+            const section_info& si = it->second;
+            if (si.type_hash != checked_container_format::type_id(t)) {
+                throw std::runtime_error("checked_container_reader: type mismatch in section `"+name+"`");
+            }
+            m_in.seekg(si.offset);
+            checked_container_format::hashing_istreambuf buf(m_in.rdbuf(), si.length);
+            std::istream hashed_in(&buf);
+            t.load(hashed_in);
+            buf.drain(); // hash trailing bytes the load routine did not touch
+            if (si.checksum != buf.hash()) {
+                throw std::runtime_error("checked_container_reader: checksum mismatch in section `"+name+"`");
+            }
+            return true;
+        }
+};
+
+//! Store `t` as the single section "data" of a checked container file.
+template<class T>
+bool store_to_container_file(const T& t, const std::string& file)
+{
+    try {
+        checked_container_writer w(file);
+        w.add("data", t);
+        w.close();
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+//! Load `t` from a container file written by store_to_container_file.
+template<class T>
+bool load_from_container_file(T& t, const std::string& file)
+{
+    try {
+        checked_container_reader r(file);
+        return r.load("data", t);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // end namespace sdsl
+#endif
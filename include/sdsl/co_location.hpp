@@ -0,0 +1,184 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file co_location.hpp
+    \brief co_location.hpp contains a container which loads a tuple of
+           structures into one contiguous memory arena.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CO_LOCATION
+#define INCLUDED_SDSL_CO_LOCATION
+
+#include "int_vector.hpp"
+#include "io.hpp"
+#include "util.hpp"
+#include "memory_management.hpp"
+#include <tuple>
+#include <type_traits>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A container which co-locates a tuple of structures in one memory arena.
+/*! Queries which touch several indexes per step (e.g. a CSA, a bit vector
+ *  of document borders and a weights vector) suffer when the structures
+ *  live in unrelated memory regions: their hot arrays compete for the
+ *  same cache sets and spread over many TLB entries. co_located holds
+ *  such a group as a tuple and loads all members back-to-back into one
+ *  contiguous arena (see memory_manager::open_arena), so co-queried data
+ *  stays dense in the address space. The members keep their full
+ *  individual APIs via get<I>().
+ *
+ *  The template parameter order is the layout order in the arena, so
+ *  structures which are hot in the same queries should be declared
+ *  adjacently.
+ *
+ *  \tparam t_idx Types of the co-located structures; each has to provide
+ *                the usual serialize/load/swap interface.
+ *
+ *  \par Example
+ *  \code
+ *  co_located<csa_wt<>, sd_vector<>, int_vector<>> grp;
+ *  // ... build the members, store_to_file(grp, file) ...
+ *  load_from_file(grp, file);           // members land in one arena
+ *  auto& csa = grp.get<0>();
+ *  \endcode
+ */
+template<class... t_idx>
+class co_located
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+        enum { num_members = sizeof...(t_idx) };
+    private:
+        std::tuple<t_idx...> m_idx;
+
+        // size of the slack added to the arena: the in-memory members
+        // differ from their serialized size by allocation rounding and
+        // the cache line alignment of each block
+        static size_type arena_slack(size_type bytes)
+        {
+            return bytes/16 + 4096*num_members;
+        }
+
+        template<size_t I>
+        typename std::enable_if<I == sizeof...(t_idx), size_type>::type
+        serialize_members(std::ostream&, structure_tree_node*) const
+        {
+            return 0;
+        }
+        template<size_t I>
+        typename std::enable_if < I<sizeof...(t_idx), size_type>::type
+        serialize_members(std::ostream& out, structure_tree_node* v) const
+        {
+            size_type written_bytes = std::get<I>(m_idx).serialize(
+                                          out, v, "member_"+util::to_string(I));
+            return written_bytes + serialize_members<I+1>(out, v);
+        }
+
+        template<size_t I>
+        typename std::enable_if<I == sizeof...(t_idx), void>::type
+        load_members(std::istream&) {}
+        template<size_t I>
+        typename std::enable_if < I<sizeof...(t_idx), void>::type
+        load_members(std::istream& in)
+        {
+            std::get<I>(m_idx).load(in);
+            load_members<I+1>(in);
+        }
+
+        template<size_t I>
+        typename std::enable_if<I == sizeof...(t_idx), size_type>::type
+        size_members() const
+        {
+            return 0;
+        }
+        template<size_t I>
+        typename std::enable_if < I<sizeof...(t_idx), size_type>::type
+        size_members() const
+        {
+            return size_in_bytes(std::get<I>(m_idx)) + size_members<I+1>();
+        }
+
+    public:
+        co_located() = default;
+        co_located(const co_located&) = default;
+        co_located(co_located&&) = default;
+        co_located& operator=(const co_located&) = default;
+        co_located& operator=(co_located&&) = default;
+
+        //! Access the I-th member.
+        template<size_t I>
+        typename std::tuple_element<I, std::tuple<t_idx...>>::type& get()
+        {
+            return std::get<I>(m_idx);
+        }
+
+        //! Access the I-th member.
+        template<size_t I>
+        const typename std::tuple_element<I, std::tuple<t_idx...>>::type& get() const
+        {
+            return std::get<I>(m_idx);
+        }
+
+        void swap(co_located& c)
+        {
+            if (this != &c) {
+                std::swap(m_idx, c.m_idx);
+            }
+        }
+
+        //! Serializes the container to a stream.
+        /*! The members are written back-to-back, preceded by the sum of
+         *  their serialized sizes, which load() uses to dimension the
+         *  arena.
+         */
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            size_type members_size = size_members<0>();
+            written_bytes += write_member(members_size, out, child, "members_size");
+            written_bytes += serialize_members<0>(out, child);
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the container from a stream.
+        /*! All members are loaded into one contiguous arena, laid out in
+         *  declaration order. If no arena can be opened (e.g. one is
+         *  already in use) the members are loaded regularly; the result
+         *  is then correct but not co-located.
+         */
+        void load(std::istream& in)
+        {
+            size_type members_size = 0;
+            read_member(members_size, in);
+            bool arena = memory_manager::open_arena(members_size
+                                                    + arena_slack(members_size));
+            load_members<0>(in);
+            if (arena) {
+                memory_manager::close_arena();
+            }
+        }
+};
+
+}// end namespace sdsl
+
+#endif // end file
@@ -164,6 +164,18 @@ class comma
                                           const size_type start_idx, const size_type end_idx,
                                           size_type n);
 
+        //! Decode n values into out; see elias_delta::decode_batch.
+        /*! Comma codes have no windowed fast path yet, so this simply
+         *  forwards to the sequential decoder with the same interface.
+         */
+        template<bool t_sumup>
+        static void decode_batch(const uint64_t* data,
+                                 const size_type start_idx, SDSL_UNUSED const size_type end_idx,
+                                 size_type n, uint64_t* out)
+        {
+            decode<t_sumup, true>(data, start_idx, n, out);
+        }
+
         //! Decode vector z containing comma encoded integers
         //  and store them in vector v.
         /*! \param z vector that contains encoded integers.
@@ -124,6 +124,22 @@ class elias_gamma
         static uint64_t decode_prefix_sum(const uint64_t* d, const size_type start_idx, size_type n);
         static uint64_t decode_prefix_sum(const uint64_t* d, const size_type start_idx, const size_type end_idx, size_type n);
 
+        //! Decode n values into out, parsing whole codes from 64-bit windows.
+        /*! Each value is extracted from a single two-word window with shifts
+         *  against compile-time masks instead of serial bit-pointer updates;
+         *  only codes longer than the window (values above 2^31) fall back to
+         *  the sequential reader.
+         *  \param d         Bitstring.
+         *  \param start_idx Starting index of the decoding.
+         *  \param end_idx   Bit size of the bitstring; bounds the window
+         *                   look-ahead so no word behind the stream is read.
+         *  \param n         Number of values to decode.
+         *  \param out       Array of length at least n receiving the values
+         *                   (prefix sums of the values if t_sumup is true).
+         */
+        template<bool t_sumup>
+        static void decode_batch(const uint64_t* d, const size_type start_idx, const size_type end_idx, size_type n, uint64_t* out);
+
         template<class int_vector>
         static bool encode(const int_vector& v, int_vector& z);
         template<class int_vector>
@@ -249,6 +265,47 @@ inline uint64_t elias_gamma::decode(const uint64_t* d, const size_type start_idx
     return value;
 }
 
+template<bool t_sumup>
+inline void elias_gamma::decode_batch(const uint64_t* d, const size_type start_idx, const size_type end_idx, size_type n, uint64_t* out)
+{
+    const size_type words = (end_idx+63)>>6; // occupied words of the stream
+    size_type bitpos = start_idx;
+    uint64_t value = 0;
+    for (size_type i=0; i < n; ++i) {
+        const uint64_t* word = d + (bitpos>>6);
+        uint8_t off = bitpos & 0x3F;
+        uint64_t w = *word >> off;
+        if (off and static_cast<size_type>(word-d)+1 < words) {
+            w |= *(word+1) << (64-off); // complete the 64-bit window
+        }
+        if (!t_sumup) value = 0;
+        if (w & 1) { // a code of length 1 encodes the value 1
+            value += 1;
+            bitpos += 1;
+        } else if (w) {
+            size_type len_1 = bits::lo(w); // length of x minus one
+            if ((len_1<<1) < 64) { // code fits into the window
+                value += ((w >> (len_1+1)) & bits::lo_set[len_1])
+                         | (1ULL << len_1);
+                bitpos += (len_1<<1) + 1;
+            } else {
+                uint8_t o = off;
+                bits::move_right(word, o, static_cast<uint8_t>(len_1+1));
+                value += bits::read_int_and_move(word, o, len_1)
+                         + (len_1<64) * (1ULL << len_1);
+                bitpos += (len_1<<1) + 1;
+            }
+        } else { // unary part longer than the window: use the sequential reader
+            uint8_t o = off;
+            size_type len_1 = bits::read_unary_and_move(word, o);
+            value += bits::read_int_and_move(word, o, len_1)
+                     + (len_1<64) * (1ULL << len_1);
+            bitpos += (len_1<<1) + 1;
+        }
+        out[i] = value;
+    }
+}
+
 } // end namespace coder
 } // end namespace sdsl
 #endif
@@ -132,6 +132,16 @@ class fibonacci
           */
         static uint64_t decode_prefix_sum(const uint64_t* d, const size_type start_idx, const size_type end_idx, size_type n);
 
+        //! Decode n values into out; see elias_delta::decode_batch.
+        /*! Fibonacci codes have no windowed fast path yet, so this simply
+         *  forwards to the sequential decoder with the same interface.
+         */
+        template<bool t_sumup>
+        static void decode_batch(const uint64_t* d, const size_type start_idx, SDSL_UNUSED const size_type end_idx, size_type n, uint64_t* out)
+        {
+            decode<t_sumup, true>(d, start_idx, n, out);
+        }
+
         template<class int_vector1, class int_vector2>
         static bool encode(const int_vector1& v, int_vector2& z);
 
@@ -5,6 +5,30 @@
 #include <map>
 #include <string>
 
+// SDSL_CONCURRENT_READS: guaranteed-immutable query mode. All optional
+// single-slot query caches write through mutable members during const
+// queries and therefore race under concurrent readers; this flag forces
+// them off, so no query path writes through any member and a structure
+// can be served by any number of threads without pre-touching. Lazily
+// materialized components (e.g. the tree part of a lazy_cst) stay
+// thread-safe via their internal locking and can be forced eagerly with
+// util::finalize(). Compile a multi-threaded query run under
+// -fsanitize=thread to audit that no write remains.
+#ifdef SDSL_CONCURRENT_READS
+#ifdef USE_CACHE
+#undef USE_CACHE
+#endif
+#ifdef USE_CSA_CACHE
+#undef USE_CSA_CACHE
+#endif
+#ifdef WT_PC_CACHE
+#undef WT_PC_CACHE
+#endif
+#ifdef RRR_BLOCK_CACHE
+#undef RRR_BLOCK_CACHE
+#endif
+#endif
+
 namespace sdsl
 {
 namespace conf  // namespace for library constant
@@ -30,7 +54,8 @@ typedef std::map<std::string, std::string> tMSS;
 
 enum format_type {JSON_FORMAT, R_FORMAT, HTML_FORMAT};
 
-enum byte_sa_algo_type {LIBDIVSUFSORT, SE_SAIS};
+enum byte_sa_algo_type {LIBDIVSUFSORT, SE_SAIS, PARALLEL_PREFIX_DOUBLING};
+enum int_sa_algo_type {QSUFSORT, INT_PARALLEL_PREFIX_DOUBLING};
 
 //! Helper class for construction process
 struct cache_config {
@@ -42,6 +67,28 @@ struct cache_config {
     // a concatenation of PID and a unique ID inside the
     // current process.
     tMSS 		file_map;		// Files stored during the construction process.
+    bool		mmap_files = false; // Hand construction phases a memory-mapped
+    // view of the cache files instead of loading
+    // a copy into RAM, where supported.
+    bool		resume = false; // Trust cache files of completed phases only
+    // if they match their checkpoint marker, and
+    // write a marker after each phase, so an
+    // interrupted construction can be resumed.
+    bool		direct_io = false; // Write cache files via O_DIRECT
+    // (store_to_file_direct), so serializing huge
+    // write-once resources does not evict the
+    // page cache of a live index on the same box.
+    bool		compress_cache = false; // Write intermediate cache files
+    // frame-compressed (see frame_compress.hpp),
+    // trading unpack time for a fraction of the
+    // disk footprint on disk-constrained boxes.
+    uint64_t	memory_budget = 0; // Hard main-memory budget in bytes for
+    // the construction phases; 0 means unlimited.
+    // Phases which can choose between in-memory
+    // and (semi-)external variants pick the most
+    // economical variant which stays under the
+    // budget, trading time for predictable peak
+    // memory (see construct_sa).
     cache_config(bool f_delete_files=true, std::string f_dir="./", std::string f_id="", tMSS f_file_map=tMSS());
 };
 
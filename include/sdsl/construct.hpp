@@ -27,8 +27,14 @@
 #include "int_vector_buffer.hpp"
 #include "construct_lcp.hpp"
 #include "construct_bwt.hpp"
+#include "construct_estimate.hpp"
+#include "construct_progress.hpp"
 #include "construct_sa.hpp"
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace sdsl
 {
@@ -55,6 +61,31 @@ void append_zero_symbol(int_vector& text)
 }
 
 
+//! Returns true if the output of a construction phase can be reused.
+/*! Without resume mode this is a plain existence check, as before. In
+ *  resume mode (cache_config::resume) a cache file only counts if it
+ *  verifies against its checkpoint marker, so a file truncated by a
+ *  crashed run triggers a rebuild of exactly that phase.
+ */
+inline bool phase_done(const std::string& key, const cache_config& config)
+{
+    if (!cache_file_exists(key, config)) {
+        return false;
+    }
+    if (!config.resume) {
+        return true;
+    }
+    return is_checkpoint_valid(key, config);
+}
+
+//! Records the completion of a construction phase in resume mode.
+inline void phase_complete(const std::string& key, const cache_config& config)
+{
+    if (config.resume) {
+        write_checkpoint(key, config);
+    }
+}
+
 template<class t_index>
 void construct(t_index& idx, const std::string& file, uint8_t num_bytes=0)
 {
@@ -75,6 +106,57 @@ void construct_im(t_index& idx, const t_data& data, uint8_t num_bytes=0)
     ram_fs::remove(tmp_file);
 }
 
+//! Constructs a batch of in-memory indexes in parallel.
+/*!
+ * \param idxs      Vector which is filled with one t_index object per input.
+ * \param data      Vector of inputs; data[i] is handed to construct_im.
+ * \param num_bytes Format of the inputs, as in construct_im.
+ * \param threads   Number of worker threads; 0 = one thread per core.
+ *
+ * The inputs are distributed over a pool of worker threads; each worker
+ * runs the normal construct_im pipeline on RAM-files of its own. If the
+ * construction of an input fails, the first raised exception is
+ * rethrown after all workers have finished.
+ */
+template<class t_index, class t_data>
+void construct_im_batch(std::vector<t_index>& idxs, const std::vector<t_data>& data,
+                        uint8_t num_bytes=0, uint64_t threads=0)
+{
+    if (0 == threads) {
+        threads = std::thread::hardware_concurrency();
+        if (0 == threads)
+            threads = 1;
+    }
+    if (threads > data.size())
+        threads = data.size();
+    idxs = std::vector<t_index>(data.size());
+    std::atomic<uint64_t>   next(0);
+    std::atomic<bool>       failed(false);
+    std::exception_ptr      first_error = nullptr;
+    std::mutex              error_lock;
+    std::vector<std::thread> pool;
+    for (uint64_t t=0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            uint64_t i = 0;
+            while ((i = next.fetch_add(1)) < data.size()) {
+                try {
+                    construct_im(idxs[i], data[i], num_bytes);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_lock);
+                    if (!failed) {
+                        first_error = std::current_exception();
+                        failed = true;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    if (failed) {
+        std::rethrow_exception(first_error);
+    }
+}
+
 //! Constructs an index object of type t_index for a text stored on disk.
 /*!
  * \param idx       	t_index object.  Any sdsl suffix array of suffix tree.
@@ -129,36 +211,47 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     typedef int_vector<t_index::alphabet_category::WIDTH> text_type;
     {
         auto event = memory_monitor::event("parse input text");
+        construct_progress::phase progress("parse input text");
         // (1) check, if the text is cached
-        if (!cache_file_exists(KEY_TEXT, config)) {
+        if (!phase_done(KEY_TEXT, config)) {
             text_type text;
             load_vector_from_file(text, file, num_bytes);
             if (contains_no_zero_symbol(text, file)) {
                 append_zero_symbol(text);
                 store_to_cache(text,KEY_TEXT, config);
             }
+            phase_complete(KEY_TEXT, config);
         }
         register_cache_file(KEY_TEXT, config);
     }
     {
         // (2) check, if the suffix array is cached
         auto event = memory_monitor::event("SA");
-        if (!cache_file_exists(conf::KEY_SA, config)) {
+        // the suffix sorter reports no intermediate progress
+        construct_progress::phase progress("SA");
+        if (!phase_done(conf::KEY_SA, config)) {
             construct_sa<t_index::alphabet_category::WIDTH>(config);
+            phase_complete(conf::KEY_SA, config);
         }
         register_cache_file(conf::KEY_SA, config);
     }
     {
         //  (3) construct BWT
         auto event = memory_monitor::event("BWT");
-        if (!cache_file_exists(KEY_BWT, config)) {
-            construct_bwt<t_index::alphabet_category::WIDTH>(config);
+        if (!phase_done(KEY_BWT, config)) {
+            if (construct_config::pipelined) {
+                construct_bwt_pipelined<t_index::alphabet_category::WIDTH>(config);
+            } else {
+                construct_bwt<t_index::alphabet_category::WIDTH>(config);
+            }
+            phase_complete(KEY_BWT, config);
         }
         register_cache_file(KEY_BWT, config);
     }
     {
         //  (4) use BWT to construct the CSA
         auto event = memory_monitor::event("construct CSA");
+        construct_progress::phase progress("construct CSA");
         t_index tmp(config);
         idx.swap(tmp);
     }
@@ -178,25 +271,27 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     {
         // (2) check, if the longest common prefix array is cached
         auto event = memory_monitor::event("LCP");
-        if (!cache_file_exists(conf::KEY_LCP, config)) {
+        if (!phase_done(conf::KEY_LCP, config)) {
             {
                 auto event = memory_monitor::event("parse input text");
                 // (1) check, if the text is cached
-                if (!cache_file_exists(KEY_TEXT, config)) {
+                if (!phase_done(KEY_TEXT, config)) {
                     text_type text;
                     load_vector_from_file(text, file, num_bytes);
                     if (contains_no_zero_symbol(text, file)) {
                         append_zero_symbol(text);
                         store_to_cache(text,KEY_TEXT, config);
                     }
+                    phase_complete(KEY_TEXT, config);
                 }
                 register_cache_file(KEY_TEXT, config);
             }
             {
                 // (2) check, if the suffix array is cached
                 auto event = memory_monitor::event("SA");
-                if (!cache_file_exists(conf::KEY_SA, config)) {
+                if (!phase_done(conf::KEY_SA, config)) {
                     construct_sa<t_width>(config);
+                    phase_complete(conf::KEY_SA, config);
                 }
                 register_cache_file(conf::KEY_SA, config);
             }
@@ -205,11 +300,13 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
             } else {
                 construct_lcp_PHI<t_width>(config);
             }
+            phase_complete(conf::KEY_LCP, config);
         }
         register_cache_file(conf::KEY_LCP, config);
     }
     {
         auto event = memory_monitor::event("compressed LCP");
+        construct_progress::phase progress("compressed LCP");
         t_index tmp(config);
         tmp.swap(idx);
     }
@@ -243,12 +340,16 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     {
         // (1) check, if the compressed suffix array is cached
         typename t_index::csa_type csa;
-        if (!cache_file_exists(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config)) {
+        if (!phase_done(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config)) {
             cache_config csa_config(false, config.dir, config.id, config.file_map);
+            csa_config.resume = config.resume;
+            csa_config.memory_budget = config.memory_budget;
             construct(csa, file, csa_config, num_bytes, csa_t);
             auto event = memory_monitor::event("store CSA");
+            construct_progress::phase progress("store CSA");
             config.file_map = csa_config.file_map;
             store_to_cache(csa,std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config);
+            phase_complete(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config);
         }
         register_cache_file(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config);
     }
@@ -258,17 +359,19 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
         register_cache_file(KEY_TEXT, config);
         register_cache_file(KEY_BWT, config);
         register_cache_file(conf::KEY_SA, config);
-        if (!cache_file_exists(conf::KEY_LCP, config)) {
+        if (!phase_done(conf::KEY_LCP, config)) {
             if (t_index::alphabet_category::WIDTH==8) {
                 construct_lcp_semi_extern_PHI(config);
             } else {
                 construct_lcp_PHI<t_index::alphabet_category::WIDTH>(config);
             }
+            phase_complete(conf::KEY_LCP, config);
         }
         register_cache_file(conf::KEY_LCP, config);
     }
     {
         auto event = memory_monitor::event("CST");
+        construct_progress::phase progress("CST");
         t_index tmp(config);
         tmp.swap(idx);
     }
@@ -278,5 +381,182 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     }
 }
 
+//! Streams a text from an istream directly into the cache directory.
+/*! The text is written under `key` in int_vector format, chunked, so
+ *  the raw input never touches the disk: the cache file is the only
+ *  copy. `num_bytes` has the same meaning as in construct(); for
+ *  num_bytes==0 the stream must contain a serialized int_vector, which
+ *  is copied verbatim. If `zero_terminated` is true, the text is
+ *  checked for zero symbols and the terminator is appended, as the
+ *  CSA/CST/LCP pipelines require.
+ *  \return Number of symbols written, including the terminator.
+ */
+template<uint8_t t_width>
+uint64_t store_text_stream_to_cache(std::istream& in, uint8_t num_bytes,
+                                    bool zero_terminated,
+                                    const std::string& key, cache_config& config)
+{
+    std::string file = cache_file_name(key, config);
+    auto zero_error = [](uint64_t pos) {
+        throw std::logic_error("Error: Input stream contains zero symbol at position "
+                               +std::to_string(pos)+".");
+    };
+    uint64_t written = 0;
+    if (0 == num_bytes) {  // stream is already in int_vector format
+        {
+            osfstream out(file, std::ios::binary | std::ios::trunc | std::ios::out);
+            std::vector<char> buf(1024*1024);
+            do {
+                in.read(buf.data(), buf.size());
+                out.write(buf.data(), in.gcount());
+            } while (in.gcount() > 0);
+        }
+        int_vector_buffer<t_width> text(file, std::ios::in | std::ios::out);
+        written = text.size();
+        if (zero_terminated) {
+            for (uint64_t i=0; i < written; ++i) {
+                if ((uint64_t)0 == text[i]) {
+                    zero_error(i);
+                }
+            }
+            text.push_back(0);
+            ++written;
+        }
+    } else if ('d' == num_bytes) {  // whitespace separated decimals
+        int_vector_buffer<t_width> text(file, std::ios::out, 1024*1024,
+                                        t_width == 0 ? 64 : t_width);
+        uint64_t x = 0;
+        while (in >> x) {
+            if (zero_terminated and 0 == x) {
+                zero_error(text.size());
+            }
+            text.push_back(x);
+        }
+        if (zero_terminated) {
+            text.push_back(0);
+        }
+        written = text.size();
+    } else {  // sequence of num_bytes-byte integers
+        int_vector_buffer<t_width> text(file, std::ios::out, 1024*1024,
+                                        t_width == 0 ? std::min<uint8_t>(64, 8*num_bytes) : t_width);
+        std::vector<uint8_t> buf(1024*1024);
+        uint64_t x = 0;
+        uint8_t  cur_byte = 0;
+        do {
+            in.read(reinterpret_cast<char*>(buf.data()), buf.size());
+            size_t read = static_cast<size_t>(in.gcount());
+            for (size_t i=0; i < read; ++i) {
+                x |= (static_cast<uint64_t>(buf[i])) << (cur_byte*8);
+                if (++cur_byte == num_bytes) {
+                    if (zero_terminated and 0 == x) {
+                        zero_error(text.size());
+                    }
+                    text.push_back(x);
+                    cur_byte = 0;
+                    x = 0ULL;
+                }
+            }
+        } while (in.gcount() > 0);
+        if (0 != cur_byte) {
+            throw std::logic_error("Error: Stream size is not a multiple of num_bytes="
+                                   +std::to_string(num_bytes)+".");
+        }
+        if (zero_terminated) {
+            text.push_back(0);
+        }
+        written = text.size();
+    }
+    register_cache_file(key, config);
+    return written;
+}
+
+template<uint8_t t_width, class t_index, class t_tag>
+void construct_stream_cached(t_index& idx, std::istream& in, cache_config& config, uint8_t num_bytes, t_tag tag)
+{
+    const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    {
+        auto event = memory_monitor::event("parse input stream");
+        construct_progress::phase progress("parse input stream");
+        if (!phase_done(KEY_TEXT, config)) {
+            store_text_stream_to_cache<t_width>(in, num_bytes, true, KEY_TEXT, config);
+            phase_complete(KEY_TEXT, config);
+        }
+        register_cache_file(KEY_TEXT, config);
+    }
+    // the text phase is cached now, so the remaining pipeline never
+    // opens the file argument
+    construct(idx, cache_file_name(KEY_TEXT, config), config, num_bytes, tag);
+}
+
+// Specialization for WTs
+template<class t_index>
+void construct_stream(t_index& idx, std::istream& in, cache_config& config, uint8_t num_bytes, wt_tag)
+{
+    auto event = memory_monitor::event("construct wavelet tree");
+    std::string tmp_key = util::to_string(util::pid())+"_"+util::to_string(util::id());
+    store_text_stream_to_cache<t_index::alphabet_category::WIDTH>(in, num_bytes, false, tmp_key, config);
+    std::string tmp_file_name = cache_file_name(tmp_key, config);
+    {
+        int_vector_buffer<t_index::alphabet_category::WIDTH> text_buf(tmp_file_name);
+        t_index tmp(text_buf, text_buf.size());
+        idx.swap(tmp);
+    }
+    sdsl::remove(tmp_file_name);
+}
+
+// Specialization for CSAs
+template<class t_index>
+void construct_stream(t_index& idx, std::istream& in, cache_config& config, uint8_t num_bytes, csa_tag tag)
+{
+    construct_stream_cached<t_index::alphabet_category::WIDTH>(idx, in, config, num_bytes, tag);
+}
+
+// Specialization for CSTs
+template<class t_index>
+void construct_stream(t_index& idx, std::istream& in, cache_config& config, uint8_t num_bytes, cst_tag tag)
+{
+    construct_stream_cached<t_index::alphabet_category::WIDTH>(idx, in, config, num_bytes, tag);
+}
+
+// Specialization for standalone LCPs
+template<class t_index>
+void construct_stream(t_index& idx, std::istream& in, cache_config& config, uint8_t num_bytes, lcp_tag tag)
+{
+    if (1 == num_bytes) {
+        construct_stream_cached<8>(idx, in, config, num_bytes, tag);
+    } else {
+        construct_stream_cached<0>(idx, in, config, num_bytes, tag);
+    }
+}
+
+//! Constructs an index object of type t_index for a text read from a stream.
+/*!
+ * \param idx       t_index object. Any sdsl suffix array, suffix tree,
+ *                  standalone LCP array or wavelet tree.
+ * \param in        Stream holding the text, e.g. std::cin or a pipe
+ *                  wrapped into an istream. Read once, front to back.
+ * \param config    Construction configuration; the cache directory
+ *                  receives the intermediate files.
+ * \param num_bytes Format of the stream, as in construct().
+ *
+ * In contrast to construct(), the input needs no named file: the text
+ * is spilled chunk-wise into the cache directory in the int_vector
+ * format the pipeline consumes, saving one full round-trip of the
+ * input through disk.
+ */
+template<class t_index>
+void construct_stream(t_index& idx, std::istream& in, cache_config& config, uint8_t num_bytes=1)
+{
+    typename t_index::index_category index_tag;
+    construct_stream(idx, in, config, num_bytes, index_tag);
+}
+
+template<class t_index>
+void construct_stream(t_index& idx, std::istream& in, uint8_t num_bytes=1)
+{
+    cache_config config;
+    construct_stream(idx, in, config, num_bytes);
+}
+
 } // end namespace sdsl
 #endif
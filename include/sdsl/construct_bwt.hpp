@@ -23,13 +23,20 @@
 
 #include "int_vector.hpp"
 #include "int_vector_buffer.hpp"
+#include "int_vector_mapper.hpp"
 #include "sfstream.hpp"
 #include "util.hpp"
 #include "config.hpp" // for cache_config
+#include "construct_progress.hpp"
 
 #include <iostream>
 #include <stdexcept>
 #include <list>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
 
 namespace sdsl
 {
@@ -57,6 +64,29 @@ void construct_bwt(cache_config& config)
     const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
     const char* KEY_BWT = key_bwt_trait<t_width>::KEY_BWT;
 
+    if (config.mmap_files) {
+        //  (1') Map text and SA read-only instead of copying them into RAM:
+        //  the SA is streamed exactly once, the text is hit in SA order
+        const int_vector_mapper<t_width, std::ios_base::in> text(cache_file_name(KEY_TEXT, config));
+        text.advise_random();
+        const int_vector_mapper<0, std::ios_base::in> sa(cache_file_name(conf::KEY_SA, config));
+        sa.advise_sequential();
+        size_type n = text.size();
+        construct_progress::phase progress("BWT", n);
+        bwt_type bwt_buf(cache_file_name(KEY_BWT, config), std::ios::out, 1000000, text.width());
+        size_type to_add[2] = {(size_type)-1,n-1};
+        for (size_type i=0; i < n; ++i) {
+            size_type sai = sa[i];
+            bwt_buf[i] = text[ sai+to_add[sai==0] ];
+            if (0 == (i & 0xFFFFF)) {
+                construct_progress::report(i);
+            }
+        }
+        bwt_buf.close();
+        register_cache_file(KEY_BWT, config);
+        return;
+    }
+
     //  (1) Load text from disk
     text_type text;
     load_from_cache(text, KEY_TEXT, config);
@@ -70,10 +100,102 @@ void construct_bwt(cache_config& config)
     bwt_type bwt_buf(bwt_file, std::ios::out, buffer_size, bwt_width);
 
     //  (3) Construct BWT sequentially by streaming SA and random access to text
+    construct_progress::phase progress("BWT", n);
     size_type to_add[2] = {(size_type)-1,n-1};
     for (size_type i=0; i < n; ++i) {
         bwt_buf[i] = text[ sa_buf[i]+to_add[sa_buf[i]==0] ];
+        if (0 == (i & 0xFFFFF)) {
+            construct_progress::report(i);
+        }
+    }
+    bwt_buf.close();
+    register_cache_file(KEY_BWT, config);
+}
+
+//! Constructs the BWT like construct_bwt, but overlaps SA disk reads with the BWT computation.
+/*!	A producer thread streams the suffix array cache file into a bounded
+ *  queue of fixed-size chunks while the main thread turns the chunks into
+ *  BWT symbols and writes them out, so the SA read I/O and the
+ *  compute/write side run concurrently instead of alternating.
+ *  \tparam t_width Width of the text. 0==integer alphabet, 8=byte alphabet.
+ *  \param config	Reference to cache configuration
+ *  \par Space complexity
+ *		\f$ n \log \sigma \f$ bits plus a constant number of chunk buffers
+ *  \pre Text and Suffix array exist in the cache. Keys:
+ *         * conf::KEY_TEXT for t_width=8 or conf::KEY_TEXT_INT for t_width=0
+ *         * conf::KEY_SA
+ *  \post BWT exist in the cache. Key
+ *         * conf::KEY_BWT for t_width=8 or conf::KEY_BWT_INT for t_width=0
+ */
+template<uint8_t t_width>
+void construct_bwt_pipelined(cache_config& config)
+{
+    static_assert(t_width == 0 or t_width == 8 , "construct_bwt_pipelined: width must be `0` for integer alphabet and `8` for byte alphabet");
+
+    typedef int_vector<>::size_type size_type;
+    typedef int_vector<t_width> text_type;
+    typedef int_vector_buffer<t_width> bwt_type;
+    const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    const char* KEY_BWT = key_bwt_trait<t_width>::KEY_BWT;
+
+    //  (1) Load text from disk
+    text_type text;
+    load_from_cache(text, KEY_TEXT, config);
+    size_type n = text.size();
+    uint8_t bwt_width = text.width();
+
+    //  (2) Bounded queue of SA chunks between the reader and the BWT writer
+    const size_type chunk_size = 1000000;
+    const size_t max_chunks = 4;
+    std::queue<std::vector<uint64_t>> chunks;
+    std::mutex mtx;
+    std::condition_variable not_full, not_empty;
+    bool done = false;
+
+    std::thread producer([&]() {
+        int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config), std::ios::in, chunk_size);
+        std::vector<uint64_t> chunk;
+        chunk.reserve(std::min(n, chunk_size));
+        for (size_type i=0; i < n; ++i) {
+            chunk.push_back(sa_buf[i]);
+            if (chunk.size() == chunk_size or i+1 == n) {
+                std::unique_lock<std::mutex> lock(mtx);
+                not_full.wait(lock, [&]() { return chunks.size() < max_chunks; });
+                chunks.push(std::move(chunk));
+                not_empty.notify_one();
+                chunk = std::vector<uint64_t>();
+                chunk.reserve(std::min(n-i, chunk_size));
+            }
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        done = true;
+        not_empty.notify_one();
+    });
+
+    //  (3) Consume the chunks: random access to text, stream BWT to disk
+    construct_progress::phase progress("BWT", n);
+    std::string bwt_file = cache_file_name(KEY_BWT, config);
+    bwt_type bwt_buf(bwt_file, std::ios::out, chunk_size, bwt_width);
+    size_type to_add[2] = {(size_type)-1,n-1};
+    size_type i = 0;
+    while (i < n) {
+        std::vector<uint64_t> chunk;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            not_empty.wait(lock, [&]() { return !chunks.empty() or done; });
+            if (chunks.empty()) {
+                break;
+            }
+            chunk = std::move(chunks.front());
+            chunks.pop();
+            not_full.notify_one();
+        }
+        for (uint64_t sai : chunk) {
+            bwt_buf[i++] = text[ sai+to_add[sai==0] ];
+        }
+        construct_progress::report(i);
     }
+    producer.join();
     bwt_buf.close();
     register_cache_file(KEY_BWT, config);
 }
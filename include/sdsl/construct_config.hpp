@@ -10,6 +10,34 @@ class construct_config
 {
     public:
         static byte_sa_algo_type byte_algo_sa;
+        static int_sa_algo_type  int_algo_sa;
+        // number of threads used by parallel construction algorithms;
+        // 0 = one thread per hardware core
+        static uint64_t num_threads;
+        // overlap construction phases with the cache file I/O between them
+        // where possible (see e.g. construct_bwt_pipelined)
+        static bool pipelined;
+        // run independent component construction phases concurrently on a
+        // thread pool (see construct_executor.hpp); the serial order is
+        // used when disabled
+        static bool parallel_components;
+        // buffer size in bytes per external stream of the semi-external
+        // construction algorithms; 0 = default (1 MiB)
+        static uint64_t io_buffer_size;
+        // number of external streams per algorithm which additionally get
+        // asynchronous read-ahead and write-behind
+        // (see int_vector_buffer::async_io); 0 = all I/O stays synchronous
+        static uint64_t io_async_streams;
+        // queue depth of the asynchronous stream backend (async_filebuf)
+        // which osfstream/isfstream use for plain files opened in pure
+        // read or pure write mode; the backend keeps stream_queue_depth
+        // chunk requests in flight via io_uring, or via a pread/pwrite
+        // worker thread where io_uring is unavailable;
+        // 0 = keep the default std::filebuf backend
+        static uint64_t stream_queue_depth;
+        // size in bytes of one chunk buffer of the asynchronous stream
+        // backend; 0 = default (1 MiB)
+        static uint64_t stream_buffer_size;
 
         construct_config() = delete;
 };
@@ -0,0 +1,260 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file construct_estimate.hpp
+    \brief construct_estimate.hpp contains a planning API which predicts
+           the peak memory and temporary disk space of construct().
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_ESTIMATE
+#define INCLUDED_SDSL_CONSTRUCT_ESTIMATE
+
+#include <string>
+#include <vector>
+#include "config.hpp"
+#include "construct_config.hpp"
+#include "int_vector.hpp"
+#include "io.hpp"
+#include "sdsl_concepts.hpp"
+
+namespace sdsl
+{
+
+//! Resource estimate of one construction phase.
+struct construction_phase_estimate {
+    typedef int_vector<>::size_type size_type;
+    std::string phase;        //!< Phase name as used by memory_monitor.
+    size_type   memory_bytes; //!< Estimated peak main memory of the phase.
+    size_type   disk_bytes;   //!< Temporary disk space held after the phase.
+};
+
+//! Resource estimate of a whole construct() run.
+/*! Returned by estimate_construction_resources. The phases appear in
+ *  execution order; disk_bytes is cumulative, so a scheduler can read
+ *  the memory budget from peak_memory_bytes() and the scratch-space
+ *  budget from peak_disk_bytes() and bin-pack build jobs instead of
+ *  overprovisioning.
+ */
+struct construction_resources {
+    typedef construction_phase_estimate::size_type size_type;
+    std::vector<construction_phase_estimate> phases;
+
+    //! Largest per-phase memory estimate.
+    size_type peak_memory_bytes()const
+    {
+        size_type res = 0;
+        for (const auto& p : phases)
+            res = std::max(res, p.memory_bytes);
+        return res;
+    }
+
+    //! Largest temporary disk footprint over all phases.
+    size_type peak_disk_bytes()const
+    {
+        size_type res = 0;
+        for (const auto& p : phases)
+            res = std::max(res, p.disk_bytes);
+        return res;
+    }
+};
+
+namespace internal_estimate
+{
+
+typedef construction_phase_estimate::size_type size_type;
+
+//! Width of a text position of a text of length n.
+inline uint8_t pos_width(size_type n)
+{
+    return n ? bits::hi(n)+1 : 1;
+}
+
+//! Serialized size of an int_vector of n elements of the given width.
+inline size_type iv_bytes(size_type n, uint8_t width)
+{
+    return (((n*width+63)>>6)<<3) + 9;  // payload + header
+}
+
+//! True if construct() would skip the phase on resume.
+inline bool phase_cached(const std::string& key, const cache_config& config)
+{
+    return config.resume and cache_file_exists(key, config);
+}
+
+//! Phases shared by csa_tag and cst_tag: text, SA and (byte) BWT.
+/*! The formulas mirror the implementations: construct_sa keeps the
+ *  text plus a 32-bit (64-bit above 2 GiB) suffix array in memory for
+ *  LIBDIVSUFSORT, stays below 1.5n bytes but writes up to 10n bytes of
+ *  scratch for SE_SAIS, and holds three 64-bit rank arrays plus the
+ *  result for PARALLEL_PREFIX_DOUBLING; qsufsort for integer alphabets
+ *  sorts two word arrays in place. construct_bwt streams SA and BWT
+ *  through 1 MB buffers with the text in memory.
+ */
+template<uint8_t t_width>
+void csa_phases(construction_resources& res, size_type text_size,
+                const cache_config& config)
+{
+    const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    const char* KEY_BWT  = key_bwt_trait<t_width>::KEY_BWT;
+    size_type n = text_size+1;  // construct() appends the terminator
+    uint8_t   w = pos_width(n);
+    size_type text_bytes = (8 == t_width) ? iv_bytes(n, 8) : iv_bytes(n, w);
+    size_type sa_bytes   = iv_bytes(n, w);
+    size_type disk = 0;
+
+    if (!phase_cached(KEY_TEXT, config)) {
+        disk += text_bytes;
+        res.phases.push_back({"parse input text", text_bytes, disk});
+    } else {
+        disk += text_bytes;
+    }
+
+    if (!phase_cached(conf::KEY_SA, config)) {
+        size_type mem = 0;
+        if (8 == t_width) {
+            if (construct_config::byte_algo_sa == SE_SAIS) {
+                mem = (3*n)/2;
+                disk = std::max(disk, 10*n);  // scratch peak inside the phase
+            } else if (construct_config::byte_algo_sa == PARALLEL_PREFIX_DOUBLING) {
+                mem = n + 4*8*n;  // text + order/rank/new_rank/result words
+            } else {  // LIBDIVSUFSORT
+                size_type sa_width = (n < 0x7FFFFFFFULL) ? 32 : 64;
+                mem = n + n*sa_width/8 + iv_bytes(n, w);
+            }
+        } else {  // qsufsort: text and rank array as 64-bit words
+            mem = 2*8*n;
+        }
+        disk += sa_bytes;
+        res.phases.push_back({"SA", mem, disk});
+    } else {
+        disk += sa_bytes;
+    }
+
+    if (!phase_cached(KEY_BWT, config)) {
+        disk += text_bytes;  // the BWT file has the size of the text file
+        res.phases.push_back({"BWT", text_bytes + 2*1000000, disk});
+    } else {
+        disk += text_bytes;
+    }
+}
+
+} // end namespace internal_estimate
+
+//! Estimates the construction resources of a CSA.
+template<class t_index>
+construction_resources
+estimate_construction_resources(typename construction_resources::size_type text_size,
+                                const cache_config& config, csa_tag)
+{
+    using namespace internal_estimate;
+    const uint8_t t_width = t_index::alphabet_category::WIDTH;
+    construction_resources res;
+    csa_phases<t_width>(res, text_size, config);
+    // the index is assembled from streamed cache files; the dominating
+    // term is the result itself, at most n log sigma bits plus samples
+    size_type n = text_size+1;
+    size_type index_mem = (8 == t_width) ? n + 2*1000000
+                                         : iv_bytes(n, pos_width(n)) + 2*1000000;
+    size_type disk = res.phases.empty() ? 0 : res.phases.back().disk_bytes;
+    res.phases.push_back({"construct CSA", index_mem, disk});
+    return res;
+}
+
+//! Estimates the construction resources of a CST.
+/*! Adds the LCP phase to the CSA phases: the semi-external PHI
+ *  algorithm for byte alphabets needs about
+ *  \f$ n + n\lceil\log n\rceil/64 \f$ bytes, the PHI algorithm for
+ *  integer alphabets two position-wide arrays.
+ */
+template<class t_index>
+construction_resources
+estimate_construction_resources(typename construction_resources::size_type text_size,
+                                const cache_config& config, cst_tag)
+{
+    using namespace internal_estimate;
+    const uint8_t t_width = t_index::alphabet_category::WIDTH;
+    construction_resources res;
+    csa_phases<t_width>(res, text_size, config);
+    size_type n = text_size+1;
+    uint8_t   w = pos_width(n);
+    size_type disk = res.phases.empty() ? 0 : res.phases.back().disk_bytes;
+    {   // CSA of the CST, kept in a cache file until the CST is assembled
+        size_type index_mem = (8 == t_width) ? n + 2*1000000
+                                             : iv_bytes(n, w) + 2*1000000;
+        disk += iv_bytes(n, w);
+        res.phases.push_back({"construct CSA", index_mem, disk});
+    }
+    if (!phase_cached(conf::KEY_LCP, config)) {
+        size_type lcp_mem = (8 == t_width) ? n + n*w/64 + 1000000
+                                           : 2*iv_bytes(n, w);
+        disk += iv_bytes(n, w);
+        res.phases.push_back({"LCP", lcp_mem, disk});
+    } else {
+        disk += iv_bytes(n, w);
+    }
+    res.phases.push_back({"construct CST", iv_bytes(n, w) + 2*1000000, disk});
+    return res;
+}
+
+//! Estimates the construction resources of a WT.
+/*! Wavelet trees are built by streaming the input file through an
+ *  int_vector_buffer; the memory peak is the result itself.
+ */
+template<class t_index>
+construction_resources
+estimate_construction_resources(typename construction_resources::size_type text_size,
+                                const cache_config&, wt_tag)
+{
+    using namespace internal_estimate;
+    const uint8_t t_width = t_index::alphabet_category::WIDTH;
+    construction_resources res;
+    size_type n = text_size;
+    size_type mem = (8 == t_width) ? iv_bytes(n, 8) : iv_bytes(n, pos_width(n));
+    res.phases.push_back({"construct wavelet tree", mem + 1000000, 0});
+    return res;
+}
+
+//! Estimates the peak memory and temporary disk space of construct().
+/*! \tparam t_index Index type the estimate is computed for.
+ *  \param text_size Length of the input text in symbols.
+ *  \param config    Cache configuration of the planned run; with
+ *                   config.resume set, phases whose cache files
+ *                   already exist are skipped, exactly as construct()
+ *                   would skip them.
+ *  \return Per-phase estimates in execution order; see
+ *          construction_resources.
+ *
+ *  The formulas are derived from the allocation profiles the
+ *  implementations embody (construct_sa, construct_bwt, construct_lcp)
+ *  and from the current construct_config::byte_algo_sa setting, so a
+ *  scheduler can reserve memory and scratch disk per job instead of
+ *  overprovisioning. The numbers are estimates of the dominating
+ *  terms, not byte-exact accounting; lower-order overheads (alphabet
+ *  mappings, samplings, rank supports) are below the slack any
+ *  scheduler needs anyway.
+ */
+template<class t_index>
+construction_resources
+estimate_construction_resources(typename construction_resources::size_type text_size,
+                                const cache_config& config)
+{
+    return estimate_construction_resources<t_index>(text_size, config,
+                                                    typename t_index::index_category());
+}
+
+} // end namespace sdsl
+
+#endif // end file
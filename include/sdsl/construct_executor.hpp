@@ -0,0 +1,177 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file construct_executor.hpp
+    \brief construct_executor.hpp contains a small dependency-graph
+           executor for independent construction phases.
+    \author Simon Gog
+
+    Construction of a compressed index decomposes into phases that read
+    cache files (or already finished components) and produce new ones;
+    the cache keys form the edges of a DAG. Phases without a path
+    between them — e.g. the alphabet scan and the SA sampling of a
+    csa_wt, which read different cache files — can run concurrently.
+    construct_executor runs such a DAG on a thread pool: tasks are
+    added with the names of the tasks they depend on and started as
+    soon as all dependencies finished. With one thread the tasks run
+    serially in a topological order, which keeps the sequential
+    behavior bit-identical.
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_EXECUTOR
+#define INCLUDED_SDSL_CONSTRUCT_EXECUTOR
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "construct_config.hpp"
+
+namespace sdsl
+{
+
+//! Executes construction phases as a DAG on a thread pool.
+class construct_executor
+{
+    private:
+        struct task {
+            std::string           name;
+            std::function<void()> fn;
+            std::vector<size_t>   dependents; // tasks waiting for this one
+            size_t                unmet;      // unfinished dependencies
+        };
+        std::vector<task>             m_tasks;
+        std::map<std::string, size_t> m_id; // task name -> index
+    public:
+        //! Adds a task depending on the already added tasks named in `deps`.
+        /*! \param name Unique name of the task, e.g. the cache key or
+         *              component it produces.
+         *  \param deps Names of the tasks whose output this task reads.
+         *  \param fn   The work of the task.
+         */
+        void add(const std::string& name,
+                 const std::vector<std::string>& deps,
+                 std::function<void()> fn)
+        {
+            if (m_id.count(name)) {
+                throw std::logic_error("construct_executor: duplicate task "+name);
+            }
+            size_t id = m_tasks.size();
+            task t;
+            t.name  = name;
+            t.fn    = fn;
+            t.unmet = deps.size();
+            for (const auto& dep : deps) {
+                auto it = m_id.find(dep);
+                if (it == m_id.end()) {
+                    throw std::logic_error("construct_executor: unknown dependency "
+                                           +dep+" of task "+name);
+                }
+                m_tasks[it->second].dependents.push_back(id);
+            }
+            m_tasks.push_back(std::move(t));
+            m_id[name] = id;
+        }
+
+        //! Runs all tasks; returns when the whole DAG finished.
+        /*! \param num_threads Size of the thread pool; 0 = one thread
+         *                     per hardware core (the
+         *                     construct_config::num_threads convention).
+         *
+         *  The first exception thrown by a task is rethrown here after
+         *  the already running tasks finished; tasks depending on the
+         *  failed one are not started.
+         */
+        void run(uint64_t num_threads = construct_config::num_threads)
+        {
+            if (m_tasks.empty()) {
+                return;
+            }
+            if (0 == num_threads) {
+                num_threads = std::thread::hardware_concurrency();
+            }
+            num_threads = std::min<uint64_t>(num_threads, m_tasks.size());
+
+            std::mutex              mutex;
+            std::condition_variable cv;
+            std::vector<size_t>     ready;
+            size_t                  remaining = m_tasks.size();
+            std::exception_ptr      error = nullptr;
+            for (size_t i=0; i < m_tasks.size(); ++i) {
+                if (0 == m_tasks[i].unmet) {
+                    ready.push_back(i);
+                }
+            }
+            auto worker = [&]() {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (true) {
+                    cv.wait(lock, [&]() {
+                        return !ready.empty() or 0 == remaining or error;
+                    });
+                    if (ready.empty()) { // finished or aborted
+                        return;
+                    }
+                    size_t id = ready.back();
+                    ready.pop_back();
+                    lock.unlock();
+                    std::exception_ptr task_error = nullptr;
+                    try {
+                        m_tasks[id].fn();
+                    } catch (...) {
+                        task_error = std::current_exception();
+                    }
+                    lock.lock();
+                    if (task_error) {
+                        if (!error) {
+                            error = task_error;
+                        }
+                        remaining = 0; // don't start dependent tasks
+                        ready.clear();
+                    } else {
+                        for (size_t dep : m_tasks[id].dependents) {
+                            if (0 == --m_tasks[dep].unmet) {
+                                ready.push_back(dep);
+                            }
+                        }
+                        --remaining;
+                    }
+                    cv.notify_all();
+                }
+            };
+            if (num_threads <= 1) {
+                worker();
+            } else {
+                std::vector<std::thread> pool;
+                for (uint64_t t=0; t < num_threads; ++t) {
+                    pool.emplace_back(worker);
+                }
+                for (auto& t : pool) {
+                    t.join();
+                }
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -31,7 +31,15 @@
 namespace sdsl
 {
 
-void construct_isa(cache_config& config);
+//! Constructs the inverse suffix array (ISA) from the SA in the cache.
+/*! \param config         Cache configuration; the SA has to be cached.
+ *  \param isa_mem_budget Memory budget in bytes for the construction.
+ *                        0 (the default) keeps the full ISA in memory.
+ *                        A smaller budget switches to a blocked
+ *                        construction which streams the SA once per
+ *                        ISA slice of the given size.
+ */
+void construct_isa(cache_config& config, uint64_t isa_mem_budget=0);
 
 }// end namespace
 
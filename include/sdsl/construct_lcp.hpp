@@ -23,6 +23,7 @@
 #define INCLUDED_SDSL_CONSTRUCT_LCP
 
 #include "config.hpp"
+#include "construct_progress.hpp"
 #include "int_vector.hpp"
 #include "int_vector_buffer.hpp"
 #include "sfstream.hpp"
@@ -34,10 +35,12 @@
 #include "wt_huff.hpp"
 #include "wt_algorithm.hpp"
 #include "construct_lcp_helper.hpp"
+#include "construct_config.hpp"
 
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <thread>
 
 //#define STUDY_INFORMATIONS
 
@@ -139,12 +142,18 @@ void construct_lcp_PHI(cache_config& config)
         return;
     }
 
+    // progress covers the three scans: PHI, PLCP and the final transform
+    construct_progress::phase progress("LCP", 3*n);
+
 //	(1) Calculate PHI (stored in array plcp)
     int_vector<> plcp(n, 0, sa_buf.width());
     for (size_type i=0, sai_1 = 0; i < n; ++i) {
         size_type sai = sa_buf[i];
         plcp[ sai ] = sai_1;
         sai_1 = sai;
+        if (0 == (i & 0xFFFFF)) {
+            construct_progress::report(i);
+        }
     }
 
 //  (2) Load text from disk
@@ -163,8 +172,119 @@ void construct_lcp_PHI(cache_config& config)
             max_l = std::max(max_l, l);
             --l;
         }
+        if (0 == (i & 0xFFFFF)) {
+            construct_progress::report(n+i);
+        }
+    }
+    util::clear(text);
+    uint8_t lcp_width = bits::hi(max_l)+1;
+
+//	(4) Transform PLCP into LCP
+    std::string lcp_file = cache_file_name(conf::KEY_LCP, config);
+    int_vector_buffer<> lcp_buf(lcp_file, std::ios::out, 1024*1024, lcp_width);   // open buffer for lcp
+    lcp_buf[0] = 0;
+    for (size_type i=1; i < n; ++i) {
+        size_type sai = sa_buf[i];
+        lcp_buf[i] = plcp[sai];
+        if (0 == (i & 0xFFFFF)) {
+            construct_progress::report(2*n+i);
+        }
+    }
+    lcp_buf.close();
+    register_cache_file(conf::KEY_LCP, config);
+}
+
+//! Construct the LCP array for text over byte- or integer-alphabet with multiple threads.
+/*!	The algorithm computes the lcp array and stores it to disk. It is the
+ *  multi-threaded variant of construct_lcp_PHI: the PLCP computation in
+ *  text order parallelizes over text blocks, where each thread restarts
+ *  its match length at its block boundary. The number of threads is taken
+ *  from construct_config::num_threads (0 = one per hardware core).
+ *  \pre Text and Suffix array exist in the cache. Keys:
+ *         * conf::KEY_TEXT for t_width=8  or conf::KEY_TEXT_INT for t_width=0
+ *         * conf::KEY_SA
+ *  \post LCP array exist in the cache. Key
+ *         * conf::KEY_LCP
+ *  \par Time complexity
+ *         \f$ \Order{n} \f$ work, split over the threads
+ *  \par Space complexity
+ *         \f$ n( \log \sigma + 64 ) \f$ bits; the PLCP values are kept in
+ *         64-bit slots so the threads never share a word
+ *  \par Reference
+ *         Juha Kärkkäinen, Giovanni Manzini, Simon J. Puglisi:
+ *         Permuted Longest-Common-Prefix Array.
+ *         CPM 2009: 181-192
+ */
+template<uint8_t t_width>
+void construct_lcp_PHI_parallel(cache_config& config)
+{
+    static_assert(t_width == 0 or t_width == 8 , "construct_lcp_PHI_parallel: width must be `0` for integer alphabet and `8` for byte alphabet");
+    typedef int_vector<>::size_type size_type;
+    typedef int_vector<t_width> text_type;
+    const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+    size_type n = sa_buf.size();
+
+    assert(n > 0);
+    if (1 == n) {  // Handle special case: Input only the sentinel character.
+        int_vector<> lcp(1, 0);
+        store_to_cache(lcp, conf::KEY_LCP, config);
+        return;
+    }
+
+    uint64_t threads = construct_config::num_threads;
+    if (0 == threads) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (0 == threads) {
+        threads = 1;
+    }
+
+//	(1) Calculate PHI (stored in array plcp); 64-bit slots, so the
+//      parallel phase (3) writes to distinct words
+    std::vector<uint64_t> plcp(n, 0);
+    for (size_type i=0, sai_1 = 0; i < n; ++i) {
+        size_type sai = sa_buf[i];
+        plcp[ sai ] = sai_1;
+        sai_1 = sai;
+    }
+
+//  (2) Load text from disk
+    text_type text;
+    load_from_cache(text, KEY_TEXT, config);
+
+//  (3) Calculate permuted LCP array (text order) blockwise in parallel;
+//      each thread restarts with l=0, which adds at most one full match
+//      per block but keeps the blocks independent
+    std::vector<uint64_t> block_max_l(threads, 0);
+    {
+        std::vector<std::thread> workers;
+        size_type chunk = ((n-1) + threads - 1) / threads;
+        for (uint64_t t = 0; t < threads and t*chunk < n-1; ++t) {
+            size_type begin = t*chunk;
+            size_type end   = std::min(n-1, (t+1)*chunk);
+            workers.emplace_back([&,t,begin,end]() {
+                size_type max_l = 0;
+                for (size_type i=begin, l=0; i < end; ++i) {
+                    size_type phii = plcp[i];
+                    while (text[i+l] == text[phii+l]) {
+                        ++l;
+                    }
+                    plcp[i] = l;
+                    if (l) {
+                        max_l = std::max(max_l, l);
+                        --l;
+                    }
+                }
+                block_max_l[t] = max_l;
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
     }
     util::clear(text);
+    size_type max_l = *std::max_element(block_max_l.begin(), block_max_l.end());
     uint8_t lcp_width = bits::hi(max_l)+1;
 
 //	(4) Transform PLCP into LCP
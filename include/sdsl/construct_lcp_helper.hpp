@@ -37,7 +37,7 @@ class buffered_char_queue
         typedef bit_vector::size_type size_type;
         typedef std::queue<uint8_t> tQ;
     private:
-        static const uint32_t m_buffer_size =  10000;//409600;
+        static const uint32_t m_buffer_size = 1u<<14; // power of two, so indices wrap with a mask
         uint8_t m_write_buf[m_buffer_size];
         uint8_t m_read_buf[m_buffer_size];
         size_type 	m_widx; // write index
@@ -52,20 +52,159 @@ class buffered_char_queue
 
         std::fstream	m_stream;
 
+        void flush_write_buf();  // spill the full write buffer to disk
+        void refill_read_buf();  // refill the empty read buffer
+
     public:
 
         buffered_char_queue();
         void init(const std::string& dir, char c);
         ~buffered_char_queue();
         void push_back(uint8_t x);
+        //! Append len characters from buf in chunk-sized memcpy transfers.
+        void push_back(const uint8_t* buf, size_type len);
         uint8_t pop_front();
+        //! Remove len characters into buf in chunk-sized memcpy transfers.
+        void pop_front(uint8_t* buf, size_type len);
+};
+
+//! Arena of fixed-size index chunks, shared by all arena_index_queues.
+/*! Exhausted chunks are recycled over a free list, so the per-character
+ *  queues of construct_lcp_go touch the heap only when the arena grows,
+ *  instead of once per stored index as std::list does.
+ */
+class index_chunk_arena
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+        static const uint32_t chunk_size = 1u<<10; // indices per chunk, power of two
+        struct chunk_type {
+            size_type   val[chunk_size];
+            chunk_type* next;
+        };
+    private:
+        std::vector<chunk_type*> m_chunks; // all allocated chunks
+        chunk_type* m_free = nullptr;      // recycled chunks
+    public:
+        index_chunk_arena() = default;
+        index_chunk_arena(const index_chunk_arena&) = delete;
+        index_chunk_arena& operator=(const index_chunk_arena&) = delete;
+        ~index_chunk_arena()
+        {
+            for (size_t i=0; i < m_chunks.size(); ++i)
+                delete m_chunks[i];
+        }
+        chunk_type* get_chunk()
+        {
+            if (m_free != nullptr) {
+                chunk_type* c = m_free;
+                m_free = c->next;
+                c->next = nullptr;
+                return c;
+            }
+            chunk_type* c = new chunk_type;
+            c->next = nullptr;
+            m_chunks.push_back(c);
+            return c;
+        }
+        void put_chunk(chunk_type* c)
+        {
+            c->next = m_free;
+            m_free = c;
+        }
+};
+
+//! Arena-backed index deque; drop-in for std::list in construct_lcp_go.
+/*! Indices live in chunks of the shared index_chunk_arena; a push or pop
+ *  is an array access plus a wrap check, and chunks move between queue
+ *  and arena in whole blocks.
+ */
+class arena_index_queue
+{
+    public:
+        typedef index_chunk_arena::size_type  size_type;
+        typedef index_chunk_arena::chunk_type chunk_type;
+    private:
+        static const uint32_t c_size = index_chunk_arena::chunk_size;
+        index_chunk_arena* m_arena = nullptr;
+        chunk_type* m_head      = nullptr;
+        chunk_type* m_tail      = nullptr;
+        uint32_t    m_front_idx = 0; // position of the front element in m_head
+        uint32_t    m_back_idx  = 0; // one past the back element in m_tail
+    public:
+        arena_index_queue() = default;
+        arena_index_queue(const arena_index_queue&) = delete;
+        arena_index_queue& operator=(const arena_index_queue&) = delete;
+        ~arena_index_queue()
+        {
+            while (m_head != nullptr) {
+                chunk_type* c = m_head;
+                m_head = c->next;
+                m_arena->put_chunk(c);
+            }
+        }
+        //! Set the backing arena; has to be called before the first push.
+        void set_arena(index_chunk_arena* arena)
+        {
+            m_arena = arena;
+        }
+        bool empty() const
+        {
+            return m_head == nullptr;
+        }
+        size_type front() const
+        {
+            return m_head->val[m_front_idx];
+        }
+        void push_front(size_type x)
+        {
+            if (nullptr == m_head) {
+                m_head = m_tail = m_arena->get_chunk();
+                m_front_idx = m_back_idx = c_size;
+            } else if (0 == m_front_idx) {
+                chunk_type* c = m_arena->get_chunk();
+                c->next = m_head;
+                m_head  = c;
+                m_front_idx = c_size;
+            }
+            m_head->val[--m_front_idx] = x;
+        }
+        void push_back(size_type x)
+        {
+            if (nullptr == m_tail) {
+                m_head = m_tail = m_arena->get_chunk();
+                m_front_idx = m_back_idx = 0;
+            } else if (c_size == m_back_idx) {
+                chunk_type* c = m_arena->get_chunk();
+                m_tail->next = c;
+                m_tail       = c;
+                m_back_idx = 0;
+            }
+            m_tail->val[m_back_idx++] = x;
+        }
+        void pop_front()
+        {
+            ++m_front_idx;
+            if (m_head == m_tail) {
+                if (m_front_idx == m_back_idx) { // queue ran empty
+                    m_arena->put_chunk(m_head);
+                    m_head = m_tail = nullptr;
+                    m_front_idx = m_back_idx = 0;
+                }
+            } else if (c_size == m_front_idx) {
+                chunk_type* c = m_head;
+                m_head = c->next;
+                m_arena->put_chunk(c);
+                m_front_idx = 0;
+            }
+        }
 };
 
 typedef std::list<int_vector<>::size_type> tLI;
 typedef std::vector<int_vector<>::size_type> tVI;
 
-template<class size_type_class>
-void push_front_m_index(size_type_class i, uint8_t c, tLI(&m_list)[256], uint8_t (&m_chars)[256], size_type_class& m_char_count)
+template<class t_list, class size_type_class>
+void push_front_m_index(size_type_class i, uint8_t c, t_list(&m_list)[256], uint8_t (&m_chars)[256], size_type_class& m_char_count)
 {
     if (m_list[c].empty()) {
         m_chars[m_char_count++] = c;
@@ -73,8 +212,8 @@ void push_front_m_index(size_type_class i, uint8_t c, tLI(&m_list)[256], uint8_t
     m_list[c].push_front(i);
 }
 
-template<class size_type_class>
-void push_back_m_index(size_type_class i, uint8_t c, tLI(&m_list)[256], uint8_t (&m_chars)[256], size_type_class& m_char_count)
+template<class t_list, class size_type_class>
+void push_back_m_index(size_type_class i, uint8_t c, t_list(&m_list)[256], uint8_t (&m_chars)[256], size_type_class& m_char_count)
 {
     if (m_list[c].empty()) {
         m_chars[m_char_count++] = c;
@@ -0,0 +1,221 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file construct_progress.hpp
+    \brief construct_progress.hpp contains a progress callback interface
+           for the construction phases.
+    \author Simon Gog
+
+    The construct() pipeline marks its phases with scoped
+    construct_progress::phase objects, mirroring the memory_monitor
+    events. An application can register a callback which is then invoked
+    at phase start, at phase end and — for phases which report
+    intermediate progress, like the BWT and LCP scans — periodically in
+    between with fraction complete, processing rate and an ETA. Without
+    a registered callback the instrumentation reduces to one relaxed
+    atomic load per report, so construction speed is unaffected.
+
+    Example:
+        construct_progress::set_callback([](const construct_progress::info& p) {
+            std::cerr << p.phase << ": " << 100*p.fraction << "%" << std::endl;
+        });
+        construct(cst, file, 1);
+        construct_progress::clear_callback();
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_PROGRESS
+#define INCLUDED_SDSL_CONSTRUCT_PROGRESS
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Progress reporting for the phases of construct().
+/*! Phases may nest (e.g. "construct CSA" contains "SA" and "BWT"); a
+ *  report always refers to the innermost open phase of the calling
+ *  thread. The callback is shared between threads and must therefore be
+ *  thread-safe when indexes are built concurrently
+ *  (construct_im_batch).
+ */
+class construct_progress
+{
+    public:
+        typedef std::chrono::high_resolution_clock timer;
+
+        //! One progress sample, handed to the registered callback.
+        struct info {
+            std::string phase;     //!< Name of the innermost open phase.
+            double      fraction;  //!< Completed fraction, or -1.0 if the phase total is unknown.
+            uint64_t    processed; //!< Units processed so far (bytes for I/O bound phases, symbols for array scans).
+            uint64_t    total;     //!< Units in total, or 0 if unknown.
+            double      rate;      //!< Units per second since phase start.
+            double      eta_sec;   //!< Estimated seconds to phase end, or -1.0 if unknown.
+        };
+
+    private:
+        struct phase_state {
+            std::string         name;
+            uint64_t            total;
+            timer::time_point   start;
+            timer::time_point   last_report;
+        };
+
+        std::atomic<bool>                        m_active;
+        std::mutex                               m_mutex;     // protects m_callback
+        std::function<void(const info&)>         m_callback;
+        double                                   m_interval = 1.0;
+
+        construct_progress() : m_active(false) {}
+
+        static construct_progress& the_progress()
+        {
+            static construct_progress p;
+            return p;
+        }
+
+        static std::vector<phase_state>& the_stack()
+        {
+            static thread_local std::vector<phase_state> stack;
+            return stack;
+        }
+
+        static void emit(const phase_state& ps, uint64_t processed)
+        {
+            auto& p = the_progress();
+            info i;
+            i.phase     = ps.name;
+            i.processed = processed;
+            i.total     = ps.total;
+            double sec  = std::chrono::duration_cast<std::chrono::microseconds>(
+                              timer::now()-ps.start).count()/1000000.0;
+            i.rate      = (sec > 0) ? processed/sec : 0.0;
+            if (ps.total > 0) {
+                i.fraction = (double)processed/ps.total;
+                i.eta_sec  = (i.rate > 0) ? (ps.total-processed)/i.rate : -1.0;
+            } else {
+                i.fraction = -1.0;
+                i.eta_sec  = -1.0;
+            }
+            std::function<void(const info&)> cb;
+            {
+                std::lock_guard<std::mutex> lock(p.m_mutex);
+                cb = p.m_callback;
+            }
+            if (cb) {
+                cb(i);
+            }
+        }
+
+    public:
+        //! Registers the progress callback.
+        /*! \param cb           Invoked at phase start/end and in between
+         *                      for phases with intermediate reports.
+         *  \param interval_sec Minimum seconds between two intermediate
+         *                      reports for the same phase.
+         */
+        static void set_callback(std::function<void(const info&)> cb,
+                                 double interval_sec = 1.0)
+        {
+            auto& p = the_progress();
+            std::lock_guard<std::mutex> lock(p.m_mutex);
+            p.m_callback = cb;
+            p.m_interval = interval_sec;
+            p.m_active   = (bool)cb;
+        }
+
+        //! Removes the callback; reporting becomes a no-op again.
+        static void clear_callback()
+        {
+            set_callback(nullptr);
+        }
+
+        //! Returns true if a callback is registered.
+        static bool active()
+        {
+            return the_progress().m_active.load(std::memory_order_relaxed);
+        }
+
+        //! Reports intermediate progress of the innermost open phase.
+        /*! Call sites pass their loop counter; the report is forwarded
+         *  to the callback at most every interval_sec seconds, so the
+         *  call is cheap enough for inner loops (amortized one atomic
+         *  load) when invoked every ~2^20 iterations.
+         */
+        static void report(uint64_t processed)
+        {
+            if (!active() or the_stack().empty()) {
+                return;
+            }
+            phase_state& ps = the_stack().back();
+            auto now = timer::now();
+            double since = std::chrono::duration_cast<std::chrono::microseconds>(
+                               now-ps.last_report).count()/1000000.0;
+            if (since < the_progress().m_interval) {
+                return;
+            }
+            ps.last_report = now;
+            emit(ps, processed);
+        }
+
+        //! Scoped marker for one construction phase.
+        /*! Opens the phase on construction (reporting 0 units done) and
+         *  closes it on destruction (reporting total units done), like
+         *  the memory_monitor event proxies next to which the markers
+         *  are placed.
+         */
+        class phase
+        {
+            private:
+                bool m_open = false;
+            public:
+                phase(const phase&) = delete;
+                phase& operator=(const phase&) = delete;
+
+                //! \param name  Phase name; matches the memory_monitor event name.
+                //! \param total Units the phase will process, or 0 if unknown.
+                phase(const std::string& name, uint64_t total=0)
+                {
+                    if (!construct_progress::active()) {
+                        return;
+                    }
+                    m_open = true;
+                    phase_state ps;
+                    ps.name        = name;
+                    ps.total       = total;
+                    ps.start       = timer::now();
+                    ps.last_report = ps.start;
+                    the_stack().push_back(ps);
+                    emit(the_stack().back(), 0);
+                }
+
+                ~phase()
+                {
+                    if (m_open) {
+                        emit(the_stack().back(), the_stack().back().total);
+                        the_stack().pop_back();
+                    }
+                }
+        };
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -33,6 +33,8 @@
 #include "construct_sa_se.hpp"
 #include "construct_config.hpp"
 
+#include <thread>
+
 namespace sdsl
 {
 
@@ -124,6 +126,157 @@ void calculate_sa(const unsigned char* c, typename int_vector<fixedIntWidth>::si
 }
 
 
+// resolve the requested thread count; 0 = one thread per hardware core
+inline uint64_t sa_num_threads(uint64_t requested)
+{
+    uint64_t t = requested ? requested : std::thread::hardware_concurrency();
+    return t ? t : 1;
+}
+
+// run f(begin, end) on roughly equal-sized subranges of [0, n), one per thread
+template<class t_fun>
+void sa_parallel_for(uint64_t n, uint64_t threads, t_fun f)
+{
+    if (threads <= 1 or n < (1ULL<<16)) {
+        f((uint64_t)0, n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    uint64_t chunk = (n + threads - 1) / threads;
+    for (uint64_t t = 0; t < threads and t*chunk < n; ++t) {
+        workers.emplace_back(f, t*chunk, std::min(n, (t+1)*chunk));
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+// sort [begin, end) with `threads` threads: recursive halving + inplace_merge
+template<class t_it, class t_cmp>
+void sa_parallel_sort(t_it begin, t_it end, t_cmp cmp, uint64_t threads)
+{
+    uint64_t n = end - begin;
+    if (threads <= 1 or n < (1ULL<<16)) {
+        std::sort(begin, end, cmp);
+        return;
+    }
+    t_it mid = begin + n/2;
+    std::thread left([&]() { sa_parallel_sort(begin, mid, cmp, threads/2); });
+    sa_parallel_sort(mid, end, cmp, threads - threads/2);
+    left.join();
+    std::inplace_merge(begin, mid, end, cmp);
+}
+
+// Multi-threaded prefix doubling over any random-access text; the symbol
+// type only has to be convertible to uint64_t. Shared core of
+// calculate_sa_parallel and calculate_sa_int_parallel.
+template<class t_text>
+void calculate_sa_prefix_doubling(const t_text& c, uint64_t len, int_vector<>& sa, uint64_t threads)
+{
+    if (len <= 1) { // handle special case
+        sa = int_vector<>(len, 0);
+        return;
+    }
+    uint8_t old_width = sa.width();
+    if (old_width < bits::hi(len)+1) {
+        throw std::logic_error("width of int_vector is to small for the text!!!");
+    }
+    threads = sa_num_threads(threads);
+    std::vector<uint64_t> order(len), rank(len), new_rank(len);
+    sa_parallel_for(len, threads, [&](uint64_t b, uint64_t e) {
+        for (uint64_t i = b; i < e; ++i) {
+            order[i] = i;
+            rank[i] = (uint64_t)c[i] + 1; // keep 0 as the rank of out-of-range positions
+        }
+    });
+    // rank of position i+k, where positions beyond the text are smallest
+    for (uint64_t k = 0; ; k = k ? k<<1 : 1) {
+        auto suf_key = [&](uint64_t i) {
+            return std::make_pair(rank[i], (k and i+k < len) ? rank[i+k] : (k ? 0 : rank[i]));
+        };
+        sa_parallel_sort(order.begin(), order.end(),
+                         [&](uint64_t a, uint64_t b) { return suf_key(a) < suf_key(b); },
+                         threads);
+        // re-rank: count group starts per block, prefix-sum the block counts,
+        // then assign the ranks of each block in parallel
+        uint64_t blocks = std::min<uint64_t>(threads, len);
+        uint64_t chunk = (len + blocks - 1) / blocks;
+        std::vector<uint64_t> block_cnt(blocks, 0);
+        sa_parallel_for(blocks, blocks, [&](uint64_t tb, uint64_t te) {
+            for (uint64_t t = tb; t < te; ++t) {
+                uint64_t cnt = 0;
+                for (uint64_t i = t*chunk; i < std::min(len, (t+1)*chunk); ++i) {
+                    cnt += (i == 0) or (suf_key(order[i]) != suf_key(order[i-1]));
+                }
+                block_cnt[t] = cnt;
+            }
+        });
+        for (uint64_t t = 1; t < blocks; ++t) {
+            block_cnt[t] += block_cnt[t-1];
+        }
+        sa_parallel_for(blocks, blocks, [&](uint64_t tb, uint64_t te) {
+            for (uint64_t t = tb; t < te; ++t) {
+                uint64_t r = t ? block_cnt[t-1] : 0;
+                for (uint64_t i = t*chunk; i < std::min(len, (t+1)*chunk); ++i) {
+                    r += (i == 0) or (suf_key(order[i]) != suf_key(order[i-1]));
+                    new_rank[order[i]] = r;
+                }
+            }
+        });
+        rank.swap(new_rank);
+        if (block_cnt[blocks-1] == len) { // all ranks distinct, SA is final
+            break;
+        }
+    }
+    // materialize at full width, then narrow in place to the caller's width
+    sa.width(64);
+    sa.resize(len);
+    uint64_t* sa_data = sa.data();
+    sa_parallel_for(len, threads, [&](uint64_t b, uint64_t e) {
+        for (uint64_t i = b; i < e; ++i) {
+            sa_data[i] = order[i];
+        }
+    });
+    if (old_width != 64) {
+        util::narrow_width(sa, old_width);
+    }
+}
+
+//! Calculates the Suffix Array for a text with multiple threads.
+/*! Multi-threaded prefix doubling: the suffixes are sorted by their first
+ *  character and then repeatedly by rank pairs (rank[i], rank[i+k]) with
+ *  doubling k, using a parallel merge sort and a parallel re-ranking pass.
+ *  Runs in \f$ \Order{n \log^2 n} \f$ work over \f$ \log n \f$ rounds and
+ *  needs about \f$ 24n \f$ bytes of working memory, so it trades space for
+ *  wall-clock time compared to the sequential divsufsort backend.
+ * \param c       Text (c-string) to calculate the suffix array for.
+ * \param len     Length of the text.
+ * \param sa      Reference to the resulting suffix array; sa.width() must
+ *                be at least \f$ \log len \f$ bits.
+ * \param threads Number of threads, 0 = one per hardware core.
+ */
+inline void calculate_sa_parallel(const unsigned char* c, uint64_t len, int_vector<>& sa, uint64_t threads)
+{
+    calculate_sa_prefix_doubling(c, len, sa, threads);
+}
+
+//! Calculates the Suffix Array for an integer-alphabet text with multiple threads.
+/*! Same parallel prefix doubling as calculate_sa_parallel, but over an
+ *  int_vector<> text. The round count and the sorting passes are
+ *  independent of the alphabet size, so a token-id text with
+ *  \f$ \sigma \approx 10^6 \f$ costs the same as a byte text of equal
+ *  length -- in contrast to qsufsort, whose refinement degrades with
+ *  large alphabets and which is single-threaded.
+ * \param text    Text; text[len-1] has to be the unique smallest symbol 0.
+ * \param sa      Reference to the resulting suffix array; sa.width() must
+ *                be at least \f$ \log len \f$ bits.
+ * \param threads Number of threads, 0 = one per hardware core.
+ */
+inline void calculate_sa_int_parallel(const int_vector<>& text, int_vector<>& sa, uint64_t threads)
+{
+    calculate_sa_prefix_doubling(text, text.size(), sa, threads);
+}
+
 } // end namespace algorithm
 
 //! Constructs the Suffix Array (SA) from text over byte- or integer-alphabet.
@@ -141,6 +294,16 @@ void calculate_sa(const unsigned char* c, typename int_vector<fixedIntWidth>::si
  *  \par Reference
  *    For t_width=8: DivSufSort (http://code.google.com/p/libdivsufsort/)
  *    For t_width=0: qsufsort (http://www.larsson.dogma.net/qsufsort.c)
+ *
+ *  With cache_config::memory_budget set, a byte-alphabet sorter whose
+ *  in-memory profile exceeds the budget is downgraded to a more
+ *  economical variant, down to the semi-external SE_SAIS at 1.5n
+ *  bytes, overriding construct_config::byte_algo_sa.
+ *
+ *  For t_width=0 construct_config::int_algo_sa selects between the
+ *  sequential qsufsort and the multi-threaded prefix doubling sorter
+ *  (INT_PARALLEL_PREFIX_DOUBLING), whose running time is independent
+ *  of the alphabet size.
  */
 template<uint8_t t_width>
 void construct_sa(cache_config& config)
@@ -148,7 +311,23 @@ void construct_sa(cache_config& config)
     static_assert(t_width == 0 or t_width == 8 , "construct_sa: width must be `0` for integer alphabet and `8` for byte alphabet");
     const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
     if (t_width == 8) {
-        if (construct_config::byte_algo_sa == LIBDIVSUFSORT) {
+        byte_sa_algo_type algo = construct_config::byte_algo_sa;
+        if (config.memory_budget > 0 and SE_SAIS != algo) {
+            // downgrade to a more economical variant if the in-memory
+            // profile of the configured sorter exceeds the budget
+            uint64_t n = util::file_size(cache_file_name(KEY_TEXT, config));
+            uint64_t divsufsort_mem = n + n*((n < 0x7FFFFFFFULL) ? 4 : 8)
+                                      + ((n*(bits::hi(n)+1)+63)/64)*8;
+            if (PARALLEL_PREFIX_DOUBLING == algo
+                and n + 4*8*n > config.memory_budget) {
+                algo = LIBDIVSUFSORT;
+            }
+            if (LIBDIVSUFSORT == algo
+                and divsufsort_mem > config.memory_budget) {
+                algo = SE_SAIS;  // <= 1.5n bytes, the most economical variant
+            }
+        }
+        if (algo == LIBDIVSUFSORT) {
             typedef int_vector<t_width> text_type;
             text_type text;
             load_from_cache(text, KEY_TEXT, config);
@@ -156,14 +335,30 @@ void construct_sa(cache_config& config)
             int_vector<> sa(text.size(), 0, bits::hi(text.size())+1);
             algorithm::calculate_sa((const unsigned char*)text.data(), text.size(), sa);
             store_to_cache(sa, conf::KEY_SA, config);
-        } else if (construct_config::byte_algo_sa == SE_SAIS) {
+        } else if (algo == SE_SAIS) {
             construct_sa_se(config);
+        } else if (algo == PARALLEL_PREFIX_DOUBLING) {
+            typedef int_vector<t_width> text_type;
+            text_type text;
+            load_from_cache(text, KEY_TEXT, config);
+            int_vector<> sa(text.size(), 0, bits::hi(text.size())+1);
+            algorithm::calculate_sa_parallel((const unsigned char*)text.data(), text.size(),
+                                             sa, construct_config::num_threads);
+            store_to_cache(sa, conf::KEY_SA, config);
         }
     } else if (t_width == 0) {
-        // call qsufsort
-        int_vector<> sa;
-        sdsl::qsufsort::construct_sa(sa, cache_file_name(KEY_TEXT, config).c_str(), 0);
-        store_to_cache(sa, conf::KEY_SA, config);
+        if (construct_config::int_algo_sa == INT_PARALLEL_PREFIX_DOUBLING) {
+            int_vector<> text;
+            load_from_cache(text, KEY_TEXT, config);
+            int_vector<> sa(text.size(), 0, bits::hi(text.size())+1);
+            algorithm::calculate_sa_int_parallel(text, sa,
+                                                 construct_config::num_threads);
+            store_to_cache(sa, conf::KEY_SA, config);
+        } else { // QSUFSORT
+            int_vector<> sa;
+            sdsl::qsufsort::construct_sa(sa, cache_file_name(KEY_TEXT, config).c_str(), 0);
+            store_to_cache(sa, conf::KEY_SA, config);
+        }
     } else {
         std::cerr << "Unknown alphabet type" << std::endl;
     }
@@ -4,6 +4,7 @@
 #include "io.hpp"
 #include "int_vector.hpp"
 #include "int_vector_buffer.hpp"
+#include "construct_config.hpp"
 #include "rank_support.hpp"
 #include "select_support.hpp"
 #include <cmath>
@@ -14,6 +15,24 @@
 namespace sdsl
 {
 
+// buffer size in bytes per external stream, see construct_config
+inline uint64_t _sa_se_buffersize()
+{
+    return construct_config::io_buffer_size ? construct_config::io_buffer_size
+           : 1024*1024/8;
+}
+
+// enable asynchronous I/O on `buf` while the configured stream budget
+// (construct_config::io_async_streams) is not yet exhausted
+template<uint8_t t_width>
+void _sa_se_maybe_async(int_vector_buffer<t_width>& buf, uint64_t& async_budget)
+{
+    if (async_budget > 0) {
+        buf.async_io(true);
+        --async_budget;
+    }
+}
+
 template<class int_vector_type>
 uint64_t _get_next_lms_position(int_vector_type& text, uint64_t i)
 {
@@ -56,7 +75,8 @@ void _construct_sa_se(int_vector_type& text, std::string filename_sa, uint64_t s
     uint64_t n = text.size();
     uint64_t nsize = bits::hi(n)+1;
     uint8_t int_width = bits::hi(n-1)+1;
-    uint64_t buffersize = 1024*1024/8;
+    uint64_t buffersize = _sa_se_buffersize();
+    uint64_t async_budget = construct_config::io_async_streams;
 
     // Step 1 - Scan Text from right to left and count LMS, S and L characters and store lms_positions
 
@@ -73,6 +93,7 @@ void _construct_sa_se(int_vector_type& text, std::string filename_sa, uint64_t s
 
     {
         int_vector_buffer<1> lms_pos_b(filename_lms_pos_b, std::ios::out, buffersize, 1);
+        _sa_se_maybe_async(lms_pos_b, async_budget);
         uint64_t ci = text[n-1];
         ++C[ci];
         bool was_s_typ = 1;
@@ -106,8 +127,10 @@ void _construct_sa_se(int_vector_type& text, std::string filename_sa, uint64_t s
 
     // Step 2 - Scan Text from right to left and detect LMS-Positions. Sort and write them to disk
     int_vector_buffer<> right(tmp_file(filename_sa, "_right"+util::to_string(recursion)), std::ios::out, buffersize, nsize);
+    _sa_se_maybe_async(right, async_budget);
     size_t right_pointer=0;
     int_vector_buffer<> left(tmp_file(filename_sa, "_left"+util::to_string(recursion)), std::ios::out, buffersize, nsize);
+    _sa_se_maybe_async(left, async_budget);
     size_t left_pointer=0;
     {
         for (size_t i=0, tmp2=0, tmp=0; i<sigma; ++i) {
@@ -116,6 +139,7 @@ void _construct_sa_se(int_vector_type& text, std::string filename_sa, uint64_t s
             tmp2 = tmp;
         }
         int_vector_buffer<> lms_positions(tmp_file(filename_sa, "_lms_positions"+util::to_string(recursion)), std::ios::out, buffersize, nsize);
+        _sa_se_maybe_async(lms_positions, async_budget);
         for (size_t i=n-2, was_s_typ=1, ci=text[n-1]; i<n; --i) {
             uint64_t cip1 = ci;
             ci = text[i];
@@ -499,6 +523,7 @@ void _construct_sa_se(int_vector_type& text, std::string filename_sa, uint64_t s
             util::init_support(lms_select_support, &lms_pos_b);      // create select_support
             // write to left sa_rec buffered
             int_vector_buffer<> sa_rec_buf(filename_sa_rec, std::ios::in, buffersize, nsize);
+            _sa_se_maybe_async(sa_rec_buf, async_budget);
             for (uint64_t i=0; i<sa_rec_buf.size(); ++i) {
                 uint64_t pos = lms_select_support.select(sa_rec_buf[i]+1);
                 left[number_of_lms_strings-1-left_pointer++] = pos;
@@ -517,6 +542,7 @@ void _construct_sa_se(int_vector_type& text, std::string filename_sa, uint64_t s
     // Step 12 - Scan virtual array from left to right second time
     right_pointer = 0;
     int_vector_buffer<> cached_sa(filename_sa, std::ios::out, buffersize, nsize);
+    _sa_se_maybe_async(cached_sa, async_budget);
     size_t sa_pointer = 0;
     {
         size_t partsize = bkt_l_sum/parts+1;
@@ -54,6 +54,8 @@
 #include "select_support.hpp"
 #include "sdsl_concepts.hpp"
 #include "config.hpp"
+#include <algorithm>
+#include <stdexcept>
 #include <string>
 
 namespace sdsl
@@ -63,6 +65,9 @@ namespace sdsl
 
 class byte_alphabet;
 
+template<uint16_t t_max_sigma = 16>
+class small_alphabet;
+
 template<class bit_vector_type     = bit_vector,
          class rank_support_type   = rank_support_scan<>,   //typename bit_vector_type::rank_1_type,
          class select_support_type = select_support_scan<>, //typename bit_vector_type::select_1_type,
@@ -380,6 +385,216 @@ class succinct_byte_alphabet
         }
 };
 
+//! An alphabet strategy for tiny byte alphabets with all data stored inline.
+/*!
+ *  \tparam t_max_sigma Capacity of the alphabet; construction throws if the
+ *                      text contains more distinct symbols.
+ *
+ *  All tables are plain arrays inside the object itself, so char2comp, C[c]
+ *  and C[c+1] are loads relative to the alphabet member of the CSA without
+ *  any pointer chase into a separately allocated vector. comp2char and C are
+ *  kept adjacent and 64-byte aligned: for a genomic alphabet (sigma <= 8)
+ *  the C entries of a backward search step share one cache line. Every LF
+ *  step pays for these lookups, which makes the difference on tiny, hot
+ *  alphabets; for larger alphabets use byte_alphabet or
+ *  succinct_byte_alphabet.
+ *
+ *  \par Space consumption:
+ *       256 + t_max_sigma + 8*(t_max_sigma+1) + 2 bytes, e.g. 410 bytes for
+ *       the default capacity 16.
+ */
+template<uint16_t t_max_sigma>
+class small_alphabet
+{
+        static_assert(t_max_sigma >= 1 and t_max_sigma <= 256,
+                      "small_alphabet: capacity has to be in [1..256]");
+    public:
+        class char2comp_wrapper;
+        class comp2char_wrapper;
+        class C_wrapper;
+        friend class char2comp_wrapper;
+        friend class comp2char_wrapper;
+        friend class C_wrapper;
+
+        typedef int_vector<>::size_type size_type;
+        typedef char2comp_wrapper       char2comp_type;
+        typedef comp2char_wrapper       comp2char_type;
+        typedef C_wrapper               C_type;
+        typedef uint16_t                sigma_type;
+        typedef uint8_t                 char_type;
+        typedef uint8_t                 comp_char_type;
+        typedef std::string             string_type;
+        typedef byte_alphabet_tag       alphabet_category;
+        enum { int_width = 8 };
+
+        //! Helper class for the char2comp mapping
+        class char2comp_wrapper
+        {
+            private:
+                const small_alphabet* m_strat;
+            public:
+                char2comp_wrapper(const small_alphabet* strat) : m_strat(strat) {}
+                comp_char_type operator[](char_type c) const
+                {
+                    return m_strat->m_char2comp[c];
+                }
+        };
+
+        //! Helper class for the comp2char mapping
+        class comp2char_wrapper
+        {
+            private:
+                const small_alphabet* m_strat;
+            public:
+                comp2char_wrapper(const small_alphabet* strat) : m_strat(strat) {}
+                char_type operator[](comp_char_type c) const
+                {
+                    return m_strat->m_comp2char[c];
+                }
+        };
+
+        //! Helper class for the C array
+        class C_wrapper
+        {
+            private:
+                const small_alphabet* m_strat;
+            public:
+                C_wrapper(const small_alphabet* strat) : m_strat(strat) {}
+                uint64_t operator[](size_type i) const
+                {
+                    return m_strat->m_C[i];
+                }
+                size_type size() const
+                {
+                    return m_strat->m_sigma + 1;
+                }
+        };
+
+    private:
+        uint8_t m_char2comp[256];            // mapping from a character into the compact alphabet
+        alignas(64)
+        uint8_t    m_comp2char[t_max_sigma]; // inverse mapping of m_char2comp
+        uint64_t   m_C[t_max_sigma+1];       // cumulative counts, adjacent to m_comp2char
+        sigma_type m_sigma;                  // effective size of the alphabet
+
+        void copy(const small_alphabet& strat)
+        {
+            std::copy(strat.m_char2comp, strat.m_char2comp+256, m_char2comp);
+            std::copy(strat.m_comp2char, strat.m_comp2char+t_max_sigma, m_comp2char);
+            std::copy(strat.m_C, strat.m_C+t_max_sigma+1, m_C);
+            m_sigma = strat.m_sigma;
+        }
+
+        void clear()
+        {
+            std::fill(m_char2comp, m_char2comp+256, 0);
+            std::fill(m_comp2char, m_comp2char+t_max_sigma, 0);
+            std::fill(m_C, m_C+t_max_sigma+1, 0);
+            m_sigma = 0;
+        }
+    public:
+
+        const char2comp_type char2comp;
+        const comp2char_type comp2char;
+        const C_type         C;
+        const sigma_type&    sigma;
+
+        //! Default constructor
+        small_alphabet() : char2comp(this), comp2char(this), C(this), sigma(m_sigma)
+        {
+            clear();
+        }
+
+        //! Construct from a byte-stream
+        /*!
+         *  \param text_buf Byte stream.
+         *  \param len      Length of the byte stream.
+         */
+        small_alphabet(int_vector_buffer<8>& text_buf, int_vector_size_type len):
+            char2comp(this), comp2char(this), C(this), sigma(m_sigma)
+        {
+            clear();
+            if (0 == len or 0 == text_buf.size())
+                return;
+            assert(len <= text_buf.size());
+            // count occurrences of each symbol
+            int_vector<64> D(257, 0);
+            for (size_type i=0; i < len; ++i) {
+                ++D[text_buf[i]];
+            }
+            assert(1 == D[0]); // null-byte should occur exactly once
+            for (int i=0; i<256; ++i)
+                if (D[i]) {
+                    if (m_sigma >= t_max_sigma) {
+                        throw std::logic_error("small_alphabet: text contains more than "
+                                               + std::to_string(t_max_sigma) + " distinct symbols");
+                    }
+                    m_char2comp[i]          = m_sigma;
+                    m_comp2char[m_sigma]    = i;
+                    m_C[m_sigma+1]          = D[i];
+                    ++m_sigma;
+                }
+            for (int i=1; i <= (int)m_sigma; ++i) {
+                m_C[i] += m_C[i-1];
+            }
+            assert(m_C[m_sigma]==len);
+        }
+
+        //! Copy constructor
+        small_alphabet(const small_alphabet& strat) : char2comp(this), comp2char(this), C(this), sigma(m_sigma)
+        {
+            copy(strat);
+        }
+
+        //! Move constructor
+        small_alphabet(small_alphabet&& strat) : small_alphabet(strat) {}
+
+        small_alphabet& operator=(const small_alphabet& strat)
+        {
+            if (this != &strat) {
+                copy(strat);
+            }
+            return *this;
+        }
+
+        small_alphabet& operator=(small_alphabet&& strat)
+        {
+            return *this = strat;
+        }
+
+        //! Swap operator
+        void swap(small_alphabet& strat)
+        {
+            std::swap_ranges(m_char2comp, m_char2comp+256, strat.m_char2comp);
+            std::swap_ranges(m_comp2char, m_comp2char+t_max_sigma, strat.m_comp2char);
+            std::swap_ranges(m_C, m_C+t_max_sigma+1, strat.m_C);
+            std::swap(m_sigma, strat.m_sigma);
+        }
+
+        //! Serialize method
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_sigma, out, child, "m_sigma");
+            out.write((const char*) m_char2comp, 256);
+            out.write((const char*) m_comp2char, t_max_sigma);
+            out.write((const char*) m_C, sizeof(m_C));
+            written_bytes += 256 + t_max_sigma + sizeof(m_C);
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Load method
+        void load(std::istream& in)
+        {
+            read_member(m_sigma, in);
+            in.read((char*) m_char2comp, 256);
+            in.read((char*) m_comp2char, t_max_sigma);
+            in.read((char*) m_C, sizeof(m_C));
+        }
+};
+
 //! A space-efficient representation for byte alphabets.
 /*!
  *  The mapping `char2comp` and its inverse `comp2char` is realized internally
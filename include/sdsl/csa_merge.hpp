@@ -0,0 +1,238 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file csa_merge.hpp
+    \brief csa_merge.hpp contains methods to merge two CSAs and to
+           carve a document-range sub-index out of a CSA, both without
+           the original text.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CSA_MERGE
+#define INCLUDED_SDSL_CSA_MERGE
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "int_vector.hpp"
+#include "config.hpp"
+#include "construct.hpp"
+#include "csa_alphabet_strategy.hpp"
+#include "io.hpp"
+#include "select_support.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! Merges two CSAs into the CSA of the separator-joined text.
+/*! \tparam t_csa CSA type with a wavelet tree over the BWT and a byte
+ *                alphabet, e.g. csa_wt.
+ *  \param csa_big    CSA of the large text A.
+ *  \param csa_delta  CSA of the small delta text B.
+ *  \param csa_merged Result object; holds the CSA of the text
+ *                    A sep B afterwards, as if it had been built with
+ *                    construct() over the concatenation.
+ *  \param config     Cache configuration; the directory receives the
+ *                    intermediate BWT and SA of the merge.
+ *  \param sep        Separator symbol; must occur in neither text and
+ *                    be smaller than every text symbol, so that the
+ *                    suffix orders of the inputs carry over.
+ *
+ *  \par Algorithm
+ *  With a separator below the text alphabet, the relative order of
+ *  the suffixes of A inside A sep B equals their order in csa_big
+ *  (the tail behind a mismatch is never reached before the unique
+ *  separator), and the suffixes starting in sep B are exactly the
+ *  suffixes of csa_delta. Merging therefore only needs the insertion
+ *  rank of every delta row among the big rows, which one LF-driven
+ *  backward walk over the delta text computes: the rank of \f$cw\f$
+ *  follows from the rank of \f$w\f$ as
+ *  \f$ C_{big}[c] + rank_{BWT_{big}}(p, c) \f$, evaluated with the
+ *  wavelet tree of csa_big. The interleave determines the merged BWT
+ *  directly; the merged SA, needed for the samplings of the result,
+ *  is read off the interleave and the two input SAs. Total work is
+ *  \f$ \Order{(|A|+|B|) \log\sigma} \f$ -- the full rebuild this
+ *  replaces pays suffix sorting of the whole corpus instead, so
+ *  repeated small-delta ingestion stays proportional to I/O, not to
+ *  suffix sorting.
+ */
+template<class t_csa>
+void merge_csa(const t_csa& csa_big, const t_csa& csa_delta,
+               t_csa& csa_merged, cache_config& config, uint8_t sep=1)
+{
+    typedef typename t_csa::size_type size_type;
+    static_assert(t_csa::alphabet_category::WIDTH==8,
+                  "merge_csa is implemented for byte alphabets.");
+    size_type n1 = csa_big.size();
+    size_type n2 = csa_delta.size();
+    size_type n  = n1+n2;
+    if (0 == sep or csa_big.char2comp[sep] > 0 or csa_delta.char2comp[sep] > 0
+        or csa_big.comp2char[1] < sep or csa_delta.comp2char[1] < sep) {
+        throw std::logic_error("merge_csa: separator must be absent from "
+                               "both texts and smaller than their symbols.");
+    }
+
+    // number of rows of csa_big which start with a character < c; the
+    // terminator row of A, which becomes the separator row of the
+    // result, keeps its place because sep is below the text alphabet
+    std::vector<size_type> smaller(257, 0);
+    for (size_type c=0; c < 256; ++c) {
+        size_type cnt = 0;
+        size_type cc  = csa_big.char2comp[c];
+        if (0 == c or cc > 0) {
+            cnt = csa_big.C[cc+1] - csa_big.C[cc];
+        }
+        smaller[c+1] = smaller[c] + cnt;
+    }
+
+    // (1) LF-driven interleave: insertion rank of every delta row
+    auto event_il = memory_monitor::event("merge interleave");
+    int_vector<> ins(n2, 0, bits::hi(n1)+1);
+    size_type k = 0;  // row of the terminator suffix, smaller than all of A
+    size_type p = 0;
+    ins[k] = p;
+    for (size_type i=1; i < n2; ++i) {
+        k = csa_delta.lf[k];
+        uint64_t c = csa_delta.F[k];
+        p = smaller[c] + csa_big.wavelet_tree.rank(p, c);
+        ins[k] = p;
+    }
+
+    // (2) plain SAs of both inputs via one Psi walk each
+    auto event_sa = memory_monitor::event("merge SA");
+    int_vector<> sa_big(n1, 0, bits::hi(n1)+1);
+    {
+        size_type r = csa_big.isa[0];
+        for (size_type i=0; i < n1; ++i) {
+            sa_big[r] = i;
+            r = csa_big.psi[r];
+        }
+    }
+    int_vector<> sa_delta(n2, 0, bits::hi(n2)+1);
+    {
+        size_type r = csa_delta.isa[0];
+        for (size_type i=0; i < n2; ++i) {
+            sa_delta[r] = i;
+            r = csa_delta.psi[r];
+        }
+    }
+
+    // (3) interleave BWT and SA; delta row k lands at global ins[k]+k.
+    // The BWT symbols carry over unchanged: the character in front of
+    // the old terminator position of A is still the last character of
+    // A, only the first position of B is now preceded by the separator
+    // instead of the old terminator of B.
+    auto event_bwt = memory_monitor::event("merge BWT");
+    int_vector<8> bwt(n);
+    int_vector<>  sa(n, 0, bits::hi(n)+1);
+    size_type r = 0;  // next big row
+    k = 0;            // next delta row
+    for (size_type g=0; g < n; ++g) {
+        if (k < n2 and g == ins[k]+k) {
+            uint8_t c = csa_delta.bwt[k];
+            bwt[g] = c ? c : sep;
+            sa[g]  = n1 + sa_delta[k];
+            ++k;
+        } else {
+            bwt[g] = csa_big.bwt[r];
+            sa[g]  = sa_big[r];
+            ++r;
+        }
+    }
+    util::clear(sa_big);
+    util::clear(sa_delta);
+    util::clear(ins);
+
+    // (4) assemble the merged CSA from the cached BWT and SA
+    auto event_csa = memory_monitor::event("merge CSA");
+    cache_config merge_config(false, config.dir,
+                              util::to_string(util::pid())+"_merge_"+util::to_string(util::id()));
+    store_to_cache(bwt, key_trait<8>::KEY_BWT, merge_config);
+    util::clear(bwt);
+    store_to_cache(sa, conf::KEY_SA, merge_config);
+    util::clear(sa);
+    {
+        t_csa tmp(merge_config);
+        csa_merged.swap(tmp);
+    }
+    util::delete_all_files(merge_config.file_map);
+}
+
+//! Carves the sub-index of a document range out of a CSA.
+/*! \tparam t_csa CSA type with a byte alphabet, e.g. csa_wt.
+ *  \param csa        CSA of the document collection; the indexed text
+ *                    is the concatenation of the documents, each
+ *                    terminated by a delimiter symbol.
+ *  \param doc_border Bit vector with a one at every delimiter position
+ *                    of the text, as produced by construct_doc_border.
+ *  \param a          First document of the range (0-based).
+ *  \param b          Last document of the range; a <= b, b smaller
+ *                    than the number of documents.
+ *  \param csa_carved Result object; holds the CSA of the documents
+ *                    a..b afterwards, delimiters included, as if it
+ *                    had been built with construct() over that part of
+ *                    the text.
+ *
+ *  \par Algorithm
+ *  The document range is mapped to the text interval [pa,pb] with the
+ *  select support of doc_border, and the carved text is recovered from
+ *  the index itself with a single Psi walk -- one isa access and then
+ *  one F plus one Psi evaluation per character -- so no raw text is
+ *  touched. The sub-index is then built from the recovered part with
+ *  the regular construction pipeline. Restricting the BWT of the full
+ *  index to the rows of the range, which would skip the suffix sort of
+ *  the carved part, is not sound with a shared delimiter symbol: a
+ *  suffix of document b continues into document b+1, so its rank among
+ *  the in-range suffixes can differ from its rank in the carved text,
+ *  where it is cut off by the terminator. (Example: documents "xa",
+ *  "xa", "z"; carving the first two reorders the two suffixes starting
+ *  with "a".) Suffix sorting is therefore paid, but only for the
+ *  carved part -- extraction is \f$\Order{(pb-pa)\log\sigma}\f$ and
+ *  the rebuild cost is proportional to the range, not to the corpus.
+ */
+template<class t_csa>
+void carve_csa(const t_csa& csa, const bit_vector& doc_border,
+               typename t_csa::size_type a, typename t_csa::size_type b,
+               t_csa& csa_carved)
+{
+    typedef typename t_csa::size_type size_type;
+    static_assert(t_csa::alphabet_category::WIDTH==8,
+                  "carve_csa is implemented for byte alphabets.");
+    size_type docs = util::cnt_one_bits(doc_border);
+    if (a > b or b >= docs) {
+        throw std::logic_error("carve_csa: document range [a,b] must "
+                               "satisfy a <= b < number of documents.");
+    }
+    select_support_mcl<1> doc_border_select(&doc_border);
+    size_type pa = (0==a) ? 0 : doc_border_select(a)+1;
+    size_type pb = doc_border_select(b+1);  // delimiter of document b
+
+    auto event_extract = memory_monitor::event("carve extract");
+    int_vector<8> text(pb-pa+1);
+    size_type r = csa.isa[pa];
+    for (size_type i=0; i < text.size(); ++i) {
+        text[i] = csa.F[r];
+        r = csa.psi[r];
+    }
+
+    auto event_csa = memory_monitor::event("carve CSA");
+    construct_im(csa_carved, text, 0);
+}
+
+} // end namespace sdsl
+
+#endif // end file
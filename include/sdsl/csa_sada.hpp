@@ -118,7 +118,19 @@ class csa_sada
         isa_sample_type m_isa_sample; // inverse suffix array samples
         alphabet_type   m_alphabet;   // alphabet component
 
-        mutable std::vector<uint64_t> m_psi_buf; // buffer for decoded psi values
+        //! Per-thread buffer for decoded psi values.
+        /*! The buffer is written during const queries (rank_bwt); a shared
+         *  member would race when several threads query the same index
+         *  concurrently, so each thread gets its own copy. It is empty when
+         *  the sample density is too large for the batched decode.
+         */
+        static std::vector<uint64_t>& psi_buf()
+        {
+            static thread_local std::vector<uint64_t> buf(
+                enc_vector_type::sample_dens < linear_decode_limit ?
+                enc_vector_type::sample_dens+1 : 0);
+            return buf;
+        }
 
         void copy(const csa_sada& csa)
         {
@@ -129,13 +141,6 @@ class csa_sada
             m_alphabet   = csa.m_alphabet;
         };
 
-        void create_buffer()
-        {
-            if (enc_vector_type::sample_dens < linear_decode_limit) {
-                m_psi_buf = std::vector<uint64_t>(enc_vector_type::sample_dens+1);
-            }
-        }
-
     public:
         const typename alphabet_type::char2comp_type& char2comp  = m_alphabet.char2comp;
         const typename alphabet_type::comp2char_type& comp2char  = m_alphabet.comp2char;
@@ -153,17 +158,13 @@ class csa_sada
 
 
         //! Default Constructor
-        csa_sada()
-        {
-            create_buffer();
-        }
+        csa_sada() { }
         //! Default Destructor
         ~csa_sada() { }
 
         //! Copy constructor
         csa_sada(const csa_sada& csa)
         {
-            create_buffer();
             copy(csa);
         }
 
@@ -265,7 +266,6 @@ class csa_sada
                 m_sa_sample  = std::move(csa.m_sa_sample);
                 m_isa_sample = std::move(csa.m_isa_sample);
                 m_alphabet   = std::move(csa.m_alphabet);
-                m_psi_buf    = std::move(csa.m_psi_buf);
             }
             return *this;
         }
@@ -286,8 +286,292 @@ class csa_sada
             return t_dens;
         }
 
+        //! Writes the substring T[begin..end] to text[0..end-begin].
+        /*! \param begin First position of the substring (inclusive).
+         *  \param end   Last position of the substring (inclusive).
+         *  \param text  Random access iterator receiving the characters.
+         *  \returns The number of extracted characters.
+         *  \par In repetitive regions successive \f$\Psi\f$ values stay
+         *       within one sample block of the encoded \f$\Psi\f$
+         *       function for long stretches. A full block is decoded only
+         *       once the walk touches it in two consecutive steps -- a
+         *       single touch keeps the cheaper prefix decode, since a
+         *       full decode costs about twice as much -- and is then
+         *       reused for free while the walk stays inside it, with the
+         *       following block prefetched. Results equal the generic
+         *       character-wise extraction.
+         */
+        template<class t_text_iter>
+        size_type extract(size_type begin, size_type end, t_text_iter text)const
+        {
+            assert(end < size());
+            assert(begin <= end);
+            size_type steps = end-begin+1;
+            const size_type sd = m_psi.get_sample_dens();
+            std::vector<uint64_t>& buf = psi_buf();
+            size_type block_idx  = size(); // currently decoded sample block; size() = none
+            size_type last_idx   = size(); // sample block of the previous step
+            uint64_t  block_base = 0;      // sample value of the decoded block
+            size_type streak     = 0;      // consecutive steps inside last_idx
+            size_type order = isa[begin];
+            for (size_type i=0; steps != 0; --steps, ++i) {
+                text[i] = first_row_symbol(order, *this);
+                if (steps > 1) {
+                    if (0 == buf.size()) { // sample density too large for buffering
+                        order = m_psi[order];
+                        continue;
+                    }
+                    size_type idx = order/sd;
+                    if (idx == block_idx) { // block already decoded: reuse for free
+                        order = block_base + buf[order - idx*sd];
+                        continue;
+                    }
+                    if (idx == last_idx) {
+                        ++streak;
+                    } else {
+                        streak   = 0;
+                        last_idx = idx;
+                    }
+                    if (streak >= 3) { // proven locality: decode the whole block
+                        m_psi.get_inter_sampled_values(idx, buf.data());
+                        block_base = m_psi.sample(idx);
+                        block_idx  = idx;
+                        m_psi.prefetch_block(idx+1);
+                        order = block_base + buf[order - idx*sd];
+                    } else {           // stray access: cheaper prefix decode
+                        order = m_psi[order];
+                    }
+                }
+            }
+            return end-begin+1;
+        }
+
+        //! Apply \f$\Psi\f$ to a batch of positions in place.
+        /*! \param pos Array of m positions, each < size(), sorted ascending.
+         *  \param m   Number of positions.
+         *  \par A \f$\Psi\f$ sample block holding two or more of the queued
+         *       positions is decoded once and serves all of them; isolated
+         *       positions use the cheaper prefix decode of operator[].
+         */
+        void psi_batch(size_type* pos, size_type m)const
+        {
+            const size_type sd = m_psi.get_sample_dens();
+            std::vector<uint64_t>& buf = psi_buf();
+            size_type k = 0;
+            while (k < m) {
+                size_type idx = pos[k]/sd;
+                size_type k2 = k+1;
+                while (k2 < m and pos[k2]/sd == idx)
+                    ++k2;
+                if (k2-k > 1 and buf.size() > 0) { // shared block decode
+                    m_psi.get_inter_sampled_values(idx, buf.data());
+                    uint64_t smpl = m_psi.sample(idx);
+                    for (; k < k2; ++k)
+                        pos[k] = smpl + buf[pos[k]-idx*sd];
+                } else {
+                    for (; k < k2; ++k)
+                        pos[k] = m_psi[pos[k]];
+                }
+            }
+        }
+
+        //! Compute SA[begin..end-1] with one \f$\Psi\f$ sweep per offset.
+        /*! \param begin Start of the suffix array interval.
+         *  \param end   End (exclusive) of the suffix array interval.
+         *  \param res   Array receiving the end-begin suffix array values.
+         *  \par All unresolved positions of the interval walk to their
+         *       next sample together: each round resolves the sampled
+         *       positions and advances the rest through psi_batch in
+         *       ascending order, so walks passing through the same
+         *       \f$\Psi\f$ sample block share one decode instead of each
+         *       position decoding it on its own as in operator[].
+         */
+        void sa_batch(size_type begin, size_type end, size_type* res)const
+        {
+            assert(begin <= end);
+            assert(end <= size());
+            const size_type n = size();
+            // active (position, index in res) pairs; common offset `off`
+            std::vector<std::pair<size_type,size_type>> act(end-begin);
+            for (size_type i=0; i < end-begin; ++i)
+                act[i] = std::make_pair(begin+i, i);
+            std::vector<size_type> tmp, runs;
+            size_type off = 0;
+            while (!act.empty()) {  // act is sorted by position
+                size_type w = 0;
+                for (size_type i=0; i < act.size(); ++i) {
+                    if (m_sa_sample.is_sampled(act[i].first)) {
+                        value_type r = m_sa_sample[act[i].first];
+                        res[act[i].second] = r >= off ? r-off : n-(off-r);
+                    } else {
+                        act[w++] = act[i];
+                    }
+                }
+                act.resize(w);
+                if (act.empty())
+                    break;
+                tmp.resize(act.size());
+                for (size_type i=0; i < act.size(); ++i)
+                    tmp[i] = act[i].first;
+                psi_batch(tmp.data(), tmp.size());
+                for (size_type i=0; i < act.size(); ++i)
+                    act[i].first = tmp[i];
+                // the Psi values of sorted positions form one ascending run
+                // per character; merging the runs restores the order much
+                // cheaper than a full sort
+                runs.clear();
+                runs.push_back(0);
+                for (size_type i=1; i < act.size(); ++i) {
+                    if (act[i].first < act[i-1].first)
+                        runs.push_back(i);
+                }
+                while (runs.size() > 1) {
+                    size_type w2 = 0;
+                    for (size_type k=0; k < runs.size(); k += 2) {
+                        if (k+1 < runs.size()) {
+                            size_type end = (k+2 < runs.size()) ? runs[k+2]
+                                            : act.size();
+                            std::inplace_merge(act.begin()+runs[k],
+                                               act.begin()+runs[k+1],
+                                               act.begin()+end);
+                        }
+                        runs[w2++] = runs[k];
+                    }
+                    runs.resize(w2);
+                }
+                ++off;
+            }
+        }
+
+        //! Computes rank_bwt at two positions of the same symbol in one pass.
+        /*! \param i     First prefix bound, \f$i\in [0..size()]\f$.
+         *  \param j     Second prefix bound, \f$j\in [0..size()]\f$.
+         *  \param c     The symbol to count.
+         *  \param res_i Gets the number of occurrences of c in the prefix [0..i-1].
+         *  \param res_j Gets the number of occurrences of c in the prefix [0..j-1].
+         *  \par Both bounds search the same increasing \f$\Psi\f$ interval,
+         *       so the sample binary search of the second bound starts
+         *       where the first one ended and a sample block decoded for
+         *       one bound is reused for the other. This answers the two
+         *       rank queries of a backward search step with at most one
+         *       block decode instead of two independent searches.
+         */
+        void rank_bwt_2(size_type i, size_type j, const char_type c,
+                        size_type& res_i, size_type& res_j)const
+        {
+            comp_char_type cc = char2comp[c];
+            if (cc==0 and c!=0) { // character is not in the text
+                res_i = 0; res_j = 0;
+                return;
+            }
+            std::pair<size_type,size_type> q[2];
+            size_type res[2];
+            if (i <= j) {
+                q[0] = std::make_pair(i, (size_type)0);
+                q[1] = std::make_pair(j, (size_type)1);
+            } else {
+                q[0] = std::make_pair(j, (size_type)1);
+                q[1] = std::make_pair(i, (size_type)0);
+            }
+            rank_bwt_sorted(cc, q, 2, res);
+            res_i = res[0];
+            res_j = res[1];
+        }
+
+        //! Computes rank_bwt for a batch of positions of the same symbol.
+        /*! \param pos Array of n prefix bounds, each \f$\in [0..size()]\f$.
+         *  \param n   Number of queries.
+         *  \param c   The symbol to count.
+         *  \param res Array receiving res[k] = number of occurrences of c
+         *             in the prefix [0..pos[k]-1].
+         *  \par The queries are sorted and answered in ascending order;
+         *       each touched \f$\Psi\f$ sample block is decoded at most
+         *       once per call and the linear scan inside a block resumes
+         *       where the previous query stopped.
+         */
+        void rank_bwt_batch(const size_type* pos, size_type n, const char_type c,
+                            size_type* res)const
+        {
+            comp_char_type cc = char2comp[c];
+            if (cc==0 and c!=0) {
+                for (size_type k=0; k < n; ++k) res[k] = 0;
+                return;
+            }
+            std::vector<std::pair<size_type,size_type>> q(n);
+            for (size_type k=0; k < n; ++k) {
+                q[k] = std::make_pair(pos[k], k);
+            }
+            std::sort(q.begin(), q.end());
+            rank_bwt_sorted(cc, q.data(), n, res);
+        }
+
     private:
 
+        // monotone rank_bwt kernel: answers rank queries for the symbol
+        // class cc at ascending positions q[0..n-1].first and writes each
+        // result to res[q[k].second]. Since \f$\Psi\f$ is increasing on
+        // [C[cc]..C[cc+1]), the sample search window, the decoded block
+        // and the scan position inside it only move forward over the
+        // queries, so no block is decoded twice.
+        void rank_bwt_sorted(const comp_char_type cc,
+                             const std::pair<size_type,size_type>* q,
+                             size_type n, size_type* res)const
+        {
+            const size_type b  = C[cc], e = C[cc+1];
+            const size_type sd = m_psi.get_sample_dens();
+            const size_type first_sb = (b+sd-1)/sd; // first sample in [b..e), inclusive
+            const size_type end_sb   = (e+sd-1)/sd; // exclusive
+            std::vector<uint64_t>& buf = psi_buf();
+            size_type low_sb = first_sb; // monotone lower limit of the sample search
+            size_type dec_sb = end_sb;   // decoded sample block; end_sb = none
+            uint64_t  smpl   = 0;        // sample value of the decoded block
+            size_type scan   = 0;        // resume position of the linear scan
+            for (size_type k=0; k < n; ++k) {
+                const size_type i = q[k].first;
+                if (i == 0) {
+                    res[q[k].second] = 0;
+                    continue;
+                }
+                size_type lo = low_sb, hi = end_sb;
+                if (lo == hi or m_psi.sample(lo) >= i) {
+                    // no sample value below i: the result lies in the head
+                    // segment of the interval, before the first sample
+                    size_type l2 = b, h2 = std::min(first_sb*sd, e);
+                    while (l2 < h2) {
+                        size_type mid = (l2+h2)/2;
+                        if (m_psi[mid] >= i) h2 = mid; else l2 = mid+1;
+                    }
+                    res[q[k].second] = l2 - b;
+                    continue;
+                }
+                // largest sample block in [lo..hi) whose sample value is < i;
+                // invariant: sample(lo) < i and (hi==end_sb or sample(hi) >= i)
+                while (lo+1 < hi) {
+                    size_type mid = (lo+hi)/2;
+                    if (m_psi.sample(mid) >= i) hi = mid; else lo = mid;
+                }
+                low_sb = lo;
+                if (0 == buf.size()) { // sample density too large for buffering
+                    size_type l2 = lo*sd+1, h2 = std::min((lo+1)*sd, e);
+                    while (l2 < h2) {
+                        size_type mid = (l2+h2)/2;
+                        if (m_psi[mid] >= i) h2 = mid; else l2 = mid+1;
+                    }
+                    res[q[k].second] = l2 - b;
+                    continue;
+                }
+                if (lo != dec_sb) { // decode the block the result lies in
+                    m_psi.get_inter_sampled_values(lo, buf.data());
+                    smpl   = m_psi.sample(lo);
+                    dec_sb = lo;
+                    buf[std::min(sd, e - lo*sd)] = size() - smpl; // sentinel
+                    scan   = 0;
+                }
+                while (buf[scan] + smpl < i) ++scan;
+                res[q[k].second] = lo*sd + scan - b;
+            }
+        }
+
         // Calculates how many symbols c are in the prefix [0..i-1] of the BWT of the original text.
         /*
          *  \param i The exclusive index of the prefix range [0..i-1], so \f$i\in [0..size()]\f$.
@@ -324,24 +608,25 @@ class csa_sada
 // TODO: don't use get_inter_sampled_values if t_dens is really
 //       large
                 lower_b = lower_sb*sd;
-                if (0 == m_psi_buf.size()) {
+                std::vector<uint64_t>& buf = psi_buf();
+                if (0 == buf.size()) {
                     upper_b = std::min(upper_sb*sd, C[cc+1]);
                     goto finish;
                 }
-                uint64_t* p = m_psi_buf.data();
+                uint64_t* p = buf.data();
                 // extract the psi values between two samples
                 m_psi.get_inter_sampled_values(lower_sb, p);
-                p = m_psi_buf.data();
+                p = buf.data();
                 uint64_t smpl = m_psi.sample(lower_sb);
                 // handle border cases
                 if (lower_b + m_psi.get_sample_dens() >= C[cc+1])
-                    m_psi_buf[ C[cc+1]-lower_b ] = size()-smpl;
+                    buf[ C[cc+1]-lower_b ] = size()-smpl;
                 else
-                    m_psi_buf[ m_psi.get_sample_dens() ] = size()-smpl;
+                    buf[ m_psi.get_sample_dens() ] = size()-smpl;
                 // search the result linear
                 while ((*p++)+smpl < i);
 
-                return p-1-m_psi_buf.data() + lower_b - C[cc];
+                return p-1-buf.data() + lower_b - C[cc];
             } else { // lower_b == (m_C[cc]+sd-1)/sd and lower_sb < upper_sb
                 if (m_psi.sample(lower_sb) >= i) {
                     lower_b = C[cc];
@@ -395,7 +680,6 @@ finish:
 template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
 csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::csa_sada(cache_config& config)
 {
-    create_buffer();
     if (!cache_file_exists(key_trait<alphabet_type::int_width>::KEY_BWT, config)) {
         return;
     }
@@ -491,5 +775,59 @@ void csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabe
     }
 }
 
+//! Specialization of extract for csa_sada: walks \f$\Psi\f$ with block reuse.
+/*! Overload of the generic psi_tag extraction; it forwards to
+ *  csa_sada::extract, which decodes each touched \f$\Psi\f$ sample block at
+ *  most once per entry and prefetches the following block.
+ */
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat, class t_text_iter>
+typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type extract(
+    const csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type begin,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type end,
+    t_text_iter text,
+    psi_tag)
+{
+    return csa.extract(begin, end, text);
+}
+
+//! Specialization of backward_search for csa_sada: shares block decodes.
+/*! Overload of the generic backward search step; the rank queries for
+ *  both interval borders search the same increasing \f$\Psi\f$ interval,
+ *  so they are answered together via csa_sada::rank_bwt_2 with at most
+ *  one sample block decode instead of two independent binary searches.
+ */
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type backward_search(
+    const csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type l,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type r,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::char_type c,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type& l_res,
+    typename csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type& r_res)
+{
+    typedef csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat> csa_type;
+    typedef typename csa_type::size_type size_type;
+    assert(l <= r); assert(r < csa.size());
+    size_type cc = csa.char2comp[c];
+    if (cc == 0 and c > 0) {
+        l_res = 1;
+        r_res = 0;
+    } else {
+        size_type c_begin = csa.C[cc];
+        if (l == 0 and r+1 == csa.size()) {
+            l_res = c_begin;
+            r_res = csa.C[cc+1] - 1;
+        } else {
+            size_type rank_l, rank_r;
+            csa.rank_bwt_2(l, r+1, c, rank_l, rank_r); // count c in bwt[0..l-1] and bwt[0..r]
+            l_res = c_begin + rank_l;
+            r_res = c_begin + rank_r - 1;
+        }
+    }
+    assert(r_res+1-l_res >= 0);
+    return r_res+1-l_res;
+}
+
 } // end namespace sdsl
 #endif
@@ -246,6 +246,181 @@ struct text_order_sa_sampling {
     using sampling_category = sa_sampling_tag;
 };
 
+//! Text order sampling with successor/predecessor queries on the samples.
+/*! Extends the text order sampling by a select structure on the marked
+ *  bitvector (cheap for the default sd_vector), so that for any SA
+ *  position i the nearest sampled SA position \f$\leq i\f$ resp.
+ *  \f$\geq i\f$ and its SA value are available in constant time. Since
+ *  the samples are taken in text order, an occurrence walk terminates
+ *  after at most sample_dens-1 LF steps, and the successor queries let
+ *  callers which process whole SA intervals pick up the already sampled
+ *  entries of an interval directly instead of probing every position.
+ */
+template<class t_csa,
+         class t_bv=sd_vector<>,
+         class t_rank=typename t_bv::rank_1_type,
+         class t_select=typename t_bv::select_1_type,
+         uint8_t t_width=0
+         >
+class _text_order_succ_sampling : public int_vector<t_width>
+{
+    private:
+        t_bv     m_marked;
+        t_rank   m_rank_marked;
+        t_select m_select_marked;
+    public:
+        typedef int_vector<t_width> base_type;
+        typedef typename base_type::size_type  size_type;	// make typedefs of base_type visible
+        typedef typename base_type::value_type value_type;	//
+        typedef t_bv                           bv_type;
+        enum { sample_dens = t_csa::sa_sample_dens };
+        enum { text_order = true };
+        typedef sa_sampling_tag                sampling_category;
+
+        const bv_type&  marked = m_marked;
+        const t_rank&   rank_marked = m_rank_marked;
+        const t_select& select_marked = m_select_marked;
+
+        //! Default constructor
+        _text_order_succ_sampling() {}
+
+        //! Constructor
+        /*
+         * \param cconfig Cache configuration (SA is expected to be cached.).
+         * \param csa    Pointer to the corresponding CSA. Not used in this class.
+         * \par Time complexity
+         *      Linear in the size of the suffix array.
+         */
+        _text_order_succ_sampling(const cache_config& cconfig, SDSL_UNUSED const t_csa* csa=nullptr)
+        {
+            int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, cconfig));
+            size_type n = sa_buf.size();
+            bit_vector marked(n, 0);                // temporary bitvector for the marked text positions
+            this->width(bits::hi(n/sample_dens)+1);
+            this->resize((n+sample_dens-1)/sample_dens);
+
+            for (size_type i=0, sa_cnt=0; i < n; ++i) {
+                size_type sa = sa_buf[i];
+                if (0 == (sa % sample_dens)) {
+                    marked[i] = 1;
+                    base_type::operator[](sa_cnt++) = sa / sample_dens;
+                }
+            }
+            m_marked = std::move(t_bv(marked));
+            util::init_support(m_rank_marked, &m_marked);
+            util::init_support(m_select_marked, &m_marked);
+        }
+
+        //! Copy constructor
+        _text_order_succ_sampling(const _text_order_succ_sampling& st) : base_type(st)
+        {
+            m_marked = st.m_marked;
+            m_rank_marked = st.m_rank_marked;
+            m_rank_marked.set_vector(&m_marked);
+            m_select_marked = st.m_select_marked;
+            m_select_marked.set_vector(&m_marked);
+        }
+
+        //! Determine if index i is sampled or not
+        inline bool is_sampled(size_type i) const
+        {
+            return m_marked[i];
+        }
+
+        //! Return the suffix array value for the sampled index i
+        inline value_type operator[](size_type i) const
+        {
+            return base_type::operator[](m_rank_marked(i)) * sample_dens;
+        }
+
+        value_type condensed_sa(size_type i) const
+        {
+            return base_type::operator[](i);
+        }
+
+        //! Returns the rightmost SA sample at a position <= i and its position
+        /*! Wraps around to the last sample if no sample lies at or before i. */
+        inline std::tuple<value_type, size_type>
+        sample_leq(size_type i) const
+        {
+            size_type r = m_rank_marked(i+1);
+            if (0 == r) {  // no sample at or before i
+                r = this->size();
+            }
+            size_type j = m_select_marked(r);
+            return std::make_tuple(base_type::operator[](r-1) * sample_dens, j);
+        }
+
+        //! Returns the leftmost SA sample at a position >= i and its position
+        /*! Wraps around to the first sample if no sample lies at or after i. */
+        inline std::tuple<value_type, size_type>
+        sample_qeq(size_type i) const
+        {
+            size_type r = m_rank_marked(i);
+            if (r == this->size()) {  // no sample at or after i
+                r = 0;
+            }
+            size_type j = m_select_marked(r+1);
+            return std::make_tuple(base_type::operator[](r) * sample_dens, j);
+        }
+
+        //! Assignment operation
+        _text_order_succ_sampling& operator=(const _text_order_succ_sampling& st)
+        {
+            if (this != &st) {
+                base_type::operator=(st);
+                m_marked = st.m_marked;
+                m_rank_marked = st.m_rank_marked;
+                m_rank_marked.set_vector(&m_marked);
+                m_select_marked = st.m_select_marked;
+                m_select_marked.set_vector(&m_marked);
+            }
+            return *this;
+        }
+
+        //! Swap operation
+        void swap(_text_order_succ_sampling& st)
+        {
+            base_type::swap(st);
+            m_marked.swap(st.m_marked);
+            util::swap_support(m_rank_marked, st.m_rank_marked, &m_marked, &(st.m_marked));
+            util::swap_support(m_select_marked, st.m_select_marked, &m_marked, &(st.m_marked));
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += base_type::serialize(out, child, "samples");
+            written_bytes += m_marked.serialize(out, child, "marked");
+            written_bytes += m_rank_marked.serialize(out, child, "rank_marked");
+            written_bytes += m_select_marked.serialize(out, child, "select_marked");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in)
+        {
+            base_type::load(in);
+            m_marked.load(in);
+            m_rank_marked.load(in);
+            m_rank_marked.set_vector(&m_marked);
+            m_select_marked.load(in);
+            m_select_marked.set_vector(&m_marked);
+        }
+};
+
+template<class t_bit_vec=sd_vector<>,
+         class t_rank_sup=typename t_bit_vec::rank_1_type,
+         class t_select_sup=typename t_bit_vec::select_1_type,
+         uint8_t t_width=0>
+struct text_order_succ_sa_sampling {
+    template<class t_csa>
+    using type = _text_order_succ_sampling<t_csa, t_bit_vec, t_rank_sup,
+          t_select_sup, t_width>;
+    using sampling_category = sa_sampling_tag;
+};
+
 
 template<class t_csa,
          class t_bv_sa=sd_vector<>,
@@ -29,6 +29,8 @@
 #include "fast_cache.hpp"
 #include "csa_sampling_strategy.hpp"
 #include "csa_alphabet_strategy.hpp"
+#include "construct_executor.hpp"
+#include "instrumentation.hpp"
 #include <iostream>
 #include <algorithm> // for std::swap
 #include <cassert>
@@ -124,7 +126,18 @@ class csa_wt
         alphabet_type   m_alphabet;
 //#define USE_CSA_CACHE
 #ifdef USE_CSA_CACHE
-        mutable fast_cache csa_cache;
+        // Memo for (i,c) -> rank_bwt(i,c). Query streams with position
+        // locality (repeated backward searches of similar patterns, LF
+        // walks from neighboring rows) hit this cache where an external
+        // cache cannot, because the locality only shows at the rank layer.
+        struct rank_key_hash {
+            size_t operator()(const std::pair<size_type, char_type>& k) const {
+                return k.first ^ (static_cast<size_t>(k.second) * 0xC2B2AE3D27D4EB4FULL);
+            }
+        };
+        typedef query_cache<std::pair<size_type, char_type>, size_type,
+                13, rank_key_hash> cache_type;
+        mutable cache_type csa_cache;
 #endif
 
         void copy(const csa_wt& csa)
@@ -134,6 +147,9 @@ class csa_wt
             m_isa_sample   = csa.m_isa_sample;
             m_isa_sample.set_vector(&m_sa_sample);
             m_alphabet     = csa.m_alphabet;
+#ifdef USE_CSA_CACHE
+            csa_cache.clear();
+#endif
         }
 
     public:
@@ -260,6 +276,43 @@ class csa_wt
          */
         void load(std::istream& in);
 
+        //! Computes C[cc] + rank_bwt(i, comp2char[cc]) for all symbols at once.
+        /*!
+         *  \param i   Position in the range \f$[0..size()]\f$.
+         *  \param out Caller-owned vector; resized to sigma entries. After
+         *             the call out[cc] is the LF value of compact symbol cc
+         *             at position i, i.e. C[cc] + rank_bwt(i, comp2char[cc]).
+         *
+         *  The all-symbol rank is answered with interval_symbols on the
+         *  prefix [0..i), which visits every wavelet tree node at most
+         *  once; a backward search step over a character class — or over
+         *  all branches of an approximate search — therefore costs one
+         *  descent instead of one rank query per symbol.
+         *  \par Time complexity
+         *        \f$ \Order{|\Sigma|} \f$ instead of
+         *        \f$ \Order{|\Sigma|\log|\Sigma|} \f$ for sigma single
+         *        rank queries.
+         */
+        void lf_all(size_type i, std::vector<size_type>& out) const
+        {
+            assert(i <= size());
+            out.resize(sigma);
+            for (size_type cc=0; cc < sigma; ++cc) {
+                out[cc] = C[cc];
+            }
+            if (0 == i) {
+                return;
+            }
+            size_type k = 0;
+            std::vector<typename wavelet_tree_type::value_type> cs(m_wavelet_tree.sigma);
+            std::vector<size_type> rank_c_i(m_wavelet_tree.sigma);
+            std::vector<size_type> rank_c_j(m_wavelet_tree.sigma);
+            m_wavelet_tree.interval_symbols(0, i, k, cs, rank_c_i, rank_c_j);
+            for (size_type p=0; p < k; ++p) {
+                out[char2comp[cs[p]]] += rank_c_j[p];
+            }
+        }
+
     private:
 
         // Calculates how many symbols c are in the prefix [0..i-1] of the BWT of the original text.
@@ -272,7 +325,18 @@ class csa_wt
          */
         size_type rank_bwt(size_type i, const char_type c)const
         {
+#ifdef USE_CSA_CACHE
+            typename cache_type::key_type key(i, c);
+            size_type x;
+            if (csa_cache.exists(key, x)) {
+                return x;
+            }
+            x = m_wavelet_tree.rank(i, c);
+            csa_cache.write(key, x);
+            return x;
+#else
             return m_wavelet_tree.rank(i, c);
+#endif
         }
 
         // Calculates the position of the i-th c in the BWT of the original text.
@@ -305,6 +369,35 @@ csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::cs
     if (!cache_file_exists(key_trait<alphabet_type::int_width>::KEY_BWT, config)) {
         return;
     }
+    if (construct_config::parallel_components) {
+        // the alphabet scan and the wavelet tree read the BWT, the two
+        // samplings read the SA; only the ISA sampling depends on a
+        // component (the SA samples), so the DAG overlaps the rest
+        auto event = memory_monitor::event("construct csa components");
+        construct_executor exec;
+        exec.add("alphabet", {}, [&]() {
+            int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
+            size_type n = bwt_buf.size();
+            alphabet_type tmp_alphabet(bwt_buf, n);
+            m_alphabet.swap(tmp_alphabet);
+        });
+        exec.add("wavelet tree", {}, [&]() {
+            int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
+            size_type n = bwt_buf.size();
+            wavelet_tree_type tmp_wt(bwt_buf, n);
+            m_wavelet_tree.swap(tmp_wt);
+        });
+        exec.add("sample SA", {}, [&]() {
+            sa_sample_type tmp_sa_sample(config);
+            m_sa_sample.swap(tmp_sa_sample);
+        });
+        exec.add("sample ISA", {"sample SA"}, [&]() {
+            isa_sample_type isa_s(config, &m_sa_sample);
+            util::swap_support(m_isa_sample, isa_s, &m_sa_sample, &m_sa_sample);
+        });
+        exec.run();
+        return;
+    }
     {
         auto event = memory_monitor::event("construct csa-alpbabet");
         int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
@@ -340,6 +433,7 @@ inline auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabe
         i = lf[i];
         ++off;
     }
+    SDSL_RECORD_SAMPLE("csa_locate_walk", off);
     value_type result = m_sa_sample[i];
     if (result + off < size()) {
         return result + off;
@@ -366,6 +460,9 @@ auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
         m_sa_sample    = std::move(csa.m_sa_sample);
         m_isa_sample   = std::move(csa.m_isa_sample);
         m_alphabet     = std::move(csa.m_alphabet);
+#ifdef USE_CSA_CACHE
+        csa_cache.clear();
+#endif
     }
     return *this;
 }
@@ -391,6 +488,9 @@ void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
     m_sa_sample.load(in);
     m_isa_sample.load(in, &m_sa_sample);
     m_alphabet.load(in);
+#ifdef USE_CSA_CACHE
+    csa_cache.clear();
+#endif
 }
 
 template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
@@ -401,6 +501,10 @@ void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
         m_sa_sample.swap(csa.m_sa_sample);
         util::swap_support(m_isa_sample, csa.m_isa_sample, &m_sa_sample, &(csa.m_sa_sample));
         m_alphabet.swap(csa.m_alphabet);
+#ifdef USE_CSA_CACHE
+        csa_cache.clear();
+        csa.csa_cache.clear();
+#endif
     }
 }
 
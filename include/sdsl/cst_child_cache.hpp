@@ -0,0 +1,148 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file cst_child_cache.hpp
+    \brief cst_child_cache.hpp contains a cache which accelerates the
+           child operation of a CST for the top levels of the tree.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_CST_CHILD_CACHE
+#define INCLUDED_SDSL_CST_CHILD_CACHE
+
+#include "suffix_tree_helper.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace sdsl
+{
+
+//! A child table which accelerates the child operation near the root of a CST.
+/*! The child operation of e.g. cst_sct3 locates the child with a given
+ *  edge character through a sibling search with one BWT interval query
+ *  per probed child, which is expensive on the high-degree nodes close
+ *  to the root. This class caches the (node, edge character) -> child
+ *  mapping of the top levels in a hash table at construction time, so
+ *  top-down pattern walks resolve these levels with one lookup instead
+ *  of wavelet tree operations; deeper nodes fall back to the CST.
+ *
+ *  The cache references the CST and is rebuilt in memory; it is not
+ *  serialized with the index.
+ *
+ * \tparam t_cst CST type.
+ */
+template<class t_cst>
+class cst_child_cache
+{
+    public:
+        typedef typename t_cst::size_type size_type;
+        typedef typename t_cst::node_type node_type;
+        typedef typename t_cst::char_type char_type;
+
+    private:
+        typedef std::pair<size_type, char_type> key_type;
+
+        struct key_hash {
+            size_t operator()(const key_type& k) const
+            {
+                // Fibonacci hashing to mix node id and character
+                return (size_t)((k.first*0x9e3779b97f4a7c15ULL)
+                                ^ ((uint64_t)k.second*0xc2b2ae3d27d4eb4fULL));
+            }
+        };
+
+        const t_cst* m_cst = nullptr;
+        // (node id, edge character) -> (child node, char position)
+        std::unordered_map<key_type, std::pair<node_type, size_type>, key_hash> m_child;
+        // ids of the nodes whose children are completely cached
+        std::unordered_set<size_type> m_nodes;
+
+    public:
+        //! Default constructor
+        cst_child_cache() {}
+
+        //! Constructor
+        /*! \param cst         The CST whose top levels should be cached.
+         *  \param levels      Number of tree levels below the root to cache.
+         *  \param max_entries Upper bound on the number of cached children;
+         *                     limits the space usage on wide alphabets.
+         *  \par Time complexity
+         *        One child enumeration per cached inner node.
+         */
+        cst_child_cache(const t_cst& cst, size_type levels=3,
+                        size_type max_entries=1ULL<<20) : m_cst(&cst)
+        {
+            std::vector<node_type> cur_level = { cst.root() };
+            for (size_type lvl=0; lvl < levels and !cur_level.empty(); ++lvl) {
+                std::vector<node_type> next_level;
+                for (const auto& v : cur_level) {
+                    if (cst.is_leaf(v)) {
+                        continue;
+                    }
+                    if (m_child.size() + cst.degree(v) > max_entries) {
+                        return; // v stays uncached and falls back to the CST
+                    }
+                    size_type d = cst.depth(v);
+                    for (const auto& w : cst.children(v)) {
+                        char_type c = cst.edge(w, d+1);
+                        size_type char_pos = get_char_pos(cst.lb(w), d, cst.csa);
+                        m_child[key_type(cst.id(v), c)] = {w, char_pos};
+                        next_level.push_back(w);
+                    }
+                    m_nodes.insert(cst.id(v));
+                }
+                cur_level = std::move(next_level);
+            }
+        }
+
+        //! Number of cached children.
+        size_type size() const
+        {
+            return m_child.size();
+        }
+
+        //! Get the child w of node v which edge label (v,w) starts with character c.
+        /*! \param v        A valid tree node.
+         *  \param c        First character on the edge label.
+         *  \param char_pos Position of the matching character c in the sorted
+         *                  text/suffix array; only set if a child is returned.
+         *  \return The child node w or root() if it does not exist.
+         */
+        node_type child(const node_type& v, char_type c, size_type& char_pos) const
+        {
+            size_type nid = m_cst->id(v);
+            if (m_nodes.count(nid)) {
+                auto it = m_child.find(key_type(nid, c));
+                if (it == m_child.end()) {
+                    return m_cst->root();
+                }
+                char_pos = it->second.second;
+                return it->second.first;
+            }
+            return m_cst->child(v, c, char_pos);
+        }
+
+        //! Get the child w of node v which edge label (v,w) starts with character c.
+        node_type child(const node_type& v, char_type c) const
+        {
+            size_type char_pos;
+            return child(v, c, char_pos);
+        }
+};
+
+} // end namespace sdsl
+#endif
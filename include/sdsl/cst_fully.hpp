@@ -622,6 +622,102 @@ class cst_fully
             return lca(m_csa.psi[v.first], m_csa.psi[v.second]);
         }
 
+//! Compute the suffix-link chain v, sl(v), sl^2(v),..., sl^{k-1}(v).
+        /*!
+         * \param v The node v.
+         * \param k Maximal number of chain elements; the chain stops after
+         *          the root is reached.
+         * \return Vector of the chain elements, starting with v.
+         * \par Time complexity
+         *   \f$ \Order( (k + \delta) \cdot ( 1 + t_{rank\_bwt} ) ) \f$
+         *
+         * Calling sl() k-1 times costs \f$ \Order( k \cdot \delta ) \f$
+         * sampled LCA queries, because each call walks \f$ \delta \f$ steps
+         * of the psi chain to find a sampled ancestor. The walks of
+         * consecutive chain elements traverse the same psi chain, so this
+         * method walks it only once: depth(sl^j(v)) = depth(v)-j is known,
+         * and each element is reconstructed from the first recorded sampled
+         * ancestor in its window.
+         */
+        std::vector<node_type> sl_chain(node_type v, size_type k) const
+        {
+            std::vector<node_type> chain;
+            if (0 == k) {
+                return chain;
+            }
+            chain.push_back(v);
+            if (v == root()) {
+                return chain;
+            }
+            if (is_leaf(v)) { // suffixes of a suffix: the chain stays in the leaves
+                size_type d = depth(v);
+                leaf_type l = v.first;
+                for (size_type j = 1; j < k; j++) {
+                    if (j >= d) {
+                        chain.push_back(root());
+                        break;
+                    }
+                    l = m_csa.psi[l];
+                    chain.push_back(node_type(l, l));
+                }
+                return chain;
+            }
+            // walk the psi chain once; record for each step the sampled LCA,
+            // its depth contribution and the prepended character
+            leaf_type l = v.first, r = v.second;
+            std::vector<sampled_node_type> anc;
+            std::vector<size_type>         anc_d; // t + depth(anc[t])
+            std::vector<char_type>         label;
+            while (true) {
+                size_type t = anc.size();
+                sampled_node_type u = sampled_lca(lsa_leaf(l), lsa_leaf(r));
+                anc.push_back(u);
+                anc_d.push_back(t + depth(u));
+                char_type c = m_csa.F[l];
+                label.push_back(c);
+                char_type comp = csa.char2comp[c];
+                // the LCA of the next step would be the root
+                if (l < m_csa.C[comp] || r >= m_csa.C[comp + 1]) {
+                    break;
+                }
+                if (t + 1 >= k - 1 + m_delta) {
+                    break;
+                }
+                l = m_csa.psi[l];
+                r = m_csa.psi[r];
+            }
+            size_type d = 0; // depth of v, as computed by depth_lca
+            for (size_type t = 0; t < std::min((size_type)anc.size(), m_delta); t++) {
+                d = std::max(d, anc_d[t]);
+            }
+            size_type t = 0; // anchors are non-decreasing in j
+            for (size_type j = 1; j < k; j++) {
+                if (d <= j) {
+                    chain.push_back(root());
+                    break;
+                }
+                // smallest anchor t >= j with j + delta > t and anc_d[t] == d;
+                // it exists by the correctness of depth_lca
+                if (t < j) {
+                    t = j;
+                }
+                while (t < anc.size() and t < j + m_delta and anc_d[t] != d) {
+                    t++;
+                }
+                if (t >= anc.size() or t >= j + m_delta) {
+                    chain.push_back(sl(chain.back())); // defensive fallback
+                    continue;
+                }
+                node_type w = sampled_node(anc[t]);
+                leaf_type lb = w.first, rb = w.second;
+                for (size_type q = t; q > j; q--) {
+                    backward_search(m_csa, lb, rb, label[q - 1], lb, rb);
+                }
+                chain.push_back(node_type(lb, rb));
+            }
+            return chain;
+        }
+
 //! Compute the Weiner link of node v and character c.
         /*
          * \param v A valid node of a cst_fully.
@@ -862,6 +958,158 @@ class cst_fully
         }
 };
 
+//! An optional level-ancestor support structure for the sampled tree of a cst_fully.
+/*! Suffix-link walks repeatedly have to jump from a sampled node to a
+ *  sampled ancestor of bounded depth; with the plain cst_fully this means
+ *  iterating enclose() on the parentheses sequence s level by level. This
+ *  structure stores the parent of each sampled node together with
+ *  binary-lifting jump pointers, so the k-th ancestor and the deepest
+ *  ancestor of bounded string depth are found in \f$ \Order{\log k} \f$
+ *  steps. It needs \f$ \Order{\log^2 n} \f$ bits per sampled node, which is
+ *  \f$ o(n) \f$ for the default sampling parameter.
+ *
+ * \tparam t_cst cst_fully type.
+ */
+template<class t_cst>
+class cst_fully_levelanc_support
+{
+    public:
+        typedef typename t_cst::size_type         size_type;
+        typedef typename t_cst::sampled_node_type sampled_node_type;
+
+    private:
+        const t_cst*              m_cst = nullptr;
+        std::vector<int_vector<>> m_jump; // m_jump[q][i] = 2^q-th ancestor of the i-th sampled node
+
+        // index of a sampled node in preorder of the sampled tree
+        size_type idx(sampled_node_type u) const
+        {
+            return m_cst->s_support.rank(u) - 1;
+        }
+
+        // string depth of the i-th sampled node, cf. cst_fully::depth
+        size_type sdepth(size_type i) const
+        {
+            return m_cst->depth_sampling[i] * (m_cst->delta / 2);
+        }
+
+    public:
+        cst_fully_levelanc_support() {}
+
+        //! Constructor
+        /*! \param cst The cst_fully whose sampled tree should be supported.
+         *  \par Time complexity
+         *    \f$ \Order{ n_{sampled} \log n_{sampled} } \f$
+         */
+        cst_fully_levelanc_support(const t_cst& cst) : m_cst(&cst)
+        {
+            size_type nodes = cst.sampled_nodes();
+            uint8_t width = bits::hi(nodes ? nodes : 1) + 1;
+            m_jump.push_back(int_vector<>(nodes, 0, width));
+            // parents via a scan over the parentheses sequence s
+            std::vector<size_type> path;
+            size_type i = 0;
+            for (size_type p = 0; p < cst.s.size(); p++) {
+                if (cst.s[p]) {
+                    m_jump[0][i] = path.empty() ? i : path.back();
+                    path.push_back(i++);
+                } else {
+                    path.pop_back();
+                }
+            }
+            for (size_type q = 1; (1ULL << q) < nodes; q++) {
+                m_jump.push_back(int_vector<>(nodes, 0, width));
+                for (size_type j = 0; j < nodes; j++) {
+                    m_jump[q][j] = m_jump[q-1][m_jump[q-1][j]];
+                }
+            }
+        }
+
+        //! Returns the parent of sampled node u in the sampled tree.
+        /*! \param u A sampled node; the root is its own parent.
+         */
+        sampled_node_type parent(sampled_node_type u) const
+        {
+            return m_cst->s_support.select(m_jump[0][idx(u)] + 1);
+        }
+
+        //! Returns the k-th ancestor of sampled node u in the sampled tree.
+        /*! \param u A sampled node.
+         *  \param k Number of sampled tree levels to go up; jumps beyond the
+         *           root return the root.
+         *  \par Time complexity
+         *    \f$ \Order{\log k} \f$
+         */
+        sampled_node_type levelanc(sampled_node_type u, size_type k) const
+        {
+            size_type i = idx(u);
+            for (size_type q = 0; k > 0 and q < m_jump.size(); q++, k >>= 1) {
+                if (k & 1) {
+                    i = m_jump[q][i];
+                }
+            }
+            if (k > 0) {
+                i = 0; // beyond the root
+            }
+            return m_cst->s_support.select(i + 1);
+        }
+
+        //! Returns the deepest sampled ancestor of u with string depth <= d.
+        /*! \param u A sampled node.
+         *  \param d Maximal string depth of the ancestor.
+         *  \par Time complexity
+         *    \f$ \Order{\log n_{sampled}} \f$
+         */
+        sampled_node_type anc_depth_leq(sampled_node_type u, size_type d) const
+        {
+            size_type i = idx(u);
+            for (size_type q = m_jump.size(); q > 0; q--) {
+                if (sdepth(m_jump[q-1][i]) > d) {
+                    i = m_jump[q-1][i];
+                }
+            }
+            if (sdepth(i) > d) {
+                i = m_jump[0][i];
+            }
+            return m_cst->s_support.select(i + 1);
+        }
+
+        void swap(cst_fully_levelanc_support& s)
+        {
+            std::swap(m_cst, s.m_cst);
+            m_jump.swap(s.m_jump);
+        }
+
+        //! Sets the supported cst_fully, e.g. after loading.
+        void set_cst(const t_cst* cst)
+        {
+            m_cst = cst;
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member((size_type)m_jump.size(), out, child, "levels");
+            for (size_type q = 0; q < m_jump.size(); q++) {
+                written_bytes += m_jump[q].serialize(out, child, "jump");
+            }
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in, const t_cst* cst=nullptr)
+        {
+            m_cst = cst;
+            size_type levels = 0;
+            read_member(levels, in);
+            m_jump = std::vector<int_vector<>>(levels);
+            for (size_type q = 0; q < levels; q++) {
+                m_jump[q].load(in);
+            }
+        }
+};
+
 template<class t_csa, uint32_t t_delta, class t_s_support, class t_b, class t_depth, bool t_sample_leaves>
 cst_fully<t_csa, t_delta, t_s_support, t_b, t_depth, t_sample_leaves>::cst_fully(cache_config& config)
 {
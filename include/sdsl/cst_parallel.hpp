@@ -0,0 +1,163 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file cst_parallel.hpp
+    \brief cst_parallel.hpp contains a parallel bottom-up traversal
+           driver for compressed suffix trees.
+    \author Simon Gog
+
+    A whole-tree walk with cst_bottom_up_const_forward_iterator is
+    serial, while the subtrees of a CST are independent. The driver
+    below splits the tree at a configurable depth into one task per
+    subtree, processes the tasks on a thread pool — every idle thread
+    pulls the next unprocessed subtree, with the largest subtrees
+    scheduled first, so the load balances like a work-stealing deque —
+    and visits each subtree bottom-up with a user functor over
+    per-thread state. The per-thread states are merged afterwards and
+    the nodes above the split frontier are visited last, so every node
+    is still seen after all nodes of its subtree.
+*/
+#ifndef INCLUDED_SDSL_CST_PARALLEL
+#define INCLUDED_SDSL_CST_PARALLEL
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "construct_config.hpp"
+
+namespace sdsl
+{
+
+// collects the split frontier (roots of the parallel subtree tasks) and
+// the spine (their proper ancestors, in post-order) of the traversal
+template<class t_cst>
+void _collect_frontier(const t_cst& cst, const typename t_cst::node_type& v,
+                       uint64_t depth, uint64_t split_depth,
+                       std::vector<typename t_cst::node_type>& frontier,
+                       std::vector<typename t_cst::node_type>& spine)
+{
+    if (depth == split_depth or cst.is_leaf(v)) {
+        frontier.push_back(v);
+        return;
+    }
+    for (const auto& w : cst.children(v)) {
+        _collect_frontier(cst, w, depth+1, split_depth, frontier, spine);
+    }
+    spine.push_back(v);
+}
+
+//! Traverses all nodes of a CST bottom-up with subtree-parallel tasks.
+/*! \tparam t_cst   A class which fulfills the CST concept.
+ *  \tparam t_state The per-thread state of the traversal.
+ *  \tparam t_visit Functor type; called as visit(state, node).
+ *  \tparam t_merge Functor type; called as merge(target, source) to fold
+ *                  a finished per-thread state into the result.
+ *
+ *  \param cst         The CST to traverse.
+ *  \param visit       Called once per node; within one subtree the nodes
+ *                     arrive in bottom-up order, and every ancestor is
+ *                     visited after all nodes of its subtree. No order
+ *                     holds between different subtrees.
+ *  \param merge       Folds the per-thread states into the returned state.
+ *  \param init        Initial value of every per-thread state.
+ *  \param split_depth The tree is cut split_depth levels below the root;
+ *                     each subtree rooted there becomes one task, so the
+ *                     task count grows with the depth. 3 yields thousands
+ *                     of tasks on natural-language and DNA trees.
+ *  \param num_threads Size of the pool; 0 = one thread per hardware core
+ *                     (the construct_config::num_threads convention).
+ *  \return The merged state; the nodes above the split frontier are
+ *          visited on it after the merge.
+ *
+ *  \par Time complexity
+ *       \f$ \Order{ nodes \cdot t_{visit} / threads } \f$ for balanced
+ *       trees; skew is limited by scheduling the largest subtrees first.
+ */
+template<class t_cst, class t_state, class t_visit, class t_merge>
+t_state cst_bottom_up_parallel(const t_cst& cst, t_visit visit, t_merge merge,
+                               t_state init = t_state(),
+                               uint64_t split_depth = 3,
+                               uint64_t num_threads = construct_config::num_threads)
+{
+    typedef typename t_cst::node_type node_type;
+    if (0 == cst.size()) {
+        return init;
+    }
+    std::vector<node_type> frontier, spine;
+    _collect_frontier(cst, cst.root(), 0, split_depth, frontier, spine);
+    // largest subtrees first, so no big task starts late
+    std::sort(frontier.begin(), frontier.end(),
+    [&cst](const node_type& a, const node_type& b) {
+        return cst.size(a) > cst.size(b);
+    });
+
+    auto run_subtree = [&cst, &visit](t_state& state, const node_type& v) {
+        node_type node = cst.leftmost_leaf(v);
+        while (true) {
+            visit(state, node);
+            if (node == v) {
+                return;
+            }
+            node_type w = cst.sibling(node);
+            if (w == cst.root()) { // no right sibling inside the subtree
+                node = cst.parent(node);
+            } else {
+                node = cst.leftmost_leaf(w);
+            }
+        }
+    };
+
+    if (0 == num_threads) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    num_threads = std::min<uint64_t>(num_threads, frontier.size());
+    t_state result(init);
+    if (num_threads <= 1) {
+        for (const node_type& v : frontier) {
+            run_subtree(result, v);
+        }
+    } else {
+        std::vector<t_state> states(num_threads, init);
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> pool;
+        for (uint64_t t=0; t < num_threads; ++t) {
+            pool.emplace_back([&, t]() {
+                size_t i = 0;
+                while ((i = next.fetch_add(1, std::memory_order_relaxed))
+                       < frontier.size()) {
+                    run_subtree(states[t], frontier[i]);
+                }
+            });
+        }
+        for (auto& th : pool) {
+            th.join();
+        }
+        for (uint64_t t=0; t < num_threads; ++t) {
+            merge(result, states[t]);
+        }
+    }
+    // the ancestors of the frontier, after all their subtrees
+    for (const node_type& v : spine) {
+        visit(result, v);
+    }
+    return result;
+}
+
+} // end namespace sdsl
+
+#endif // end file
@@ -122,6 +122,87 @@ class cst_sada
             return m_bp_rank10(m_bp_support.find_close(v+1)+1);
         }
 
+        // Apply Psi once to all positions; pos has to be sorted ascending.
+        // Overload resolution picks the block-grouped kernel when the CSA
+        // provides one (csa_sada) and plain sorted lookups otherwise.
+        template<class t_csa_>
+        static auto psi_round(const t_csa_& csa, std::vector<size_type>& pos, int)
+        -> decltype(csa.psi_batch(pos.data(), pos.size()), void())
+        {
+            csa.psi_batch(pos.data(), pos.size());
+        }
+        template<class t_csa_>
+        static void psi_round(const t_csa_& csa, std::vector<size_type>& pos, long)
+        {
+            for (size_type i=0; i < pos.size(); ++i)
+                pos[i] = csa.psi[pos[i]];
+        }
+
+        // Batched get_char_pos: replace each entry idx by ISA[SA[idx]+d].
+        // The pending Psi lookups of each application are sorted by
+        // position first, so lookups into the same Psi sample block are
+        // decoded together.
+        void resolve_char_pos(std::vector<size_type>& pos, size_type d)const
+        {
+            if (0 == d)
+                return;
+            if (m_csa.sa_sample_dens + m_csa.isa_sample_dens > 2*d+2) {
+                std::vector<std::pair<size_type,size_type>> q(pos.size());
+                std::vector<size_type> tmp(pos.size());
+                for (size_type step=0; step < d; ++step) {
+                    for (size_type i=0; i < pos.size(); ++i)
+                        q[i] = std::make_pair(pos[i], i);
+                    std::sort(q.begin(), q.end());
+                    for (size_type i=0; i < q.size(); ++i)
+                        tmp[i] = q[i].first;
+                    psi_round(m_csa, tmp, 0);
+                    for (size_type i=0; i < q.size(); ++i)
+                        pos[q[i].second] = tmp[i];
+                }
+            } else {
+                for (size_type i=0; i < pos.size(); ++i)
+                    pos[i] = m_csa.isa[m_csa[pos[i]] + d];
+            }
+        }
+
+        // Collect SA[begin..end-1]; the batched kernel is used when the
+        // CSA provides one, the plain operator[] loop otherwise.
+        template<class t_csa_>
+        static auto subtree_batch_dispatch(const t_csa_& csa, size_type begin,
+                                           size_type end, int)
+        -> decltype(csa.sa_batch(begin, end, (size_type*)nullptr),
+                    std::vector<size_type>())
+        {
+            std::vector<size_type> res(end-begin);
+            csa.sa_batch(begin, end, res.data());
+            return res;
+        }
+        template<class t_csa_>
+        static std::vector<size_type>
+        subtree_batch_dispatch(const t_csa_& csa, size_type begin,
+                               size_type end, long)
+        {
+            std::vector<size_type> res(end-begin);
+            for (size_type i=begin; i < end; ++i)
+                res[i-begin] = csa[i];
+            return res;
+        }
+
+        // Character whose position interval in the first row contains order.
+        char_type char_of_pos(size_type order)const
+        {
+            size_type c_begin = 1, c_end = ((size_type)m_csa.sigma)+1, mid;
+            while (c_begin < c_end) {
+                mid = (c_begin+c_end)>>1;
+                if (m_csa.C[mid] <= order) {
+                    c_begin = mid+1;
+                } else {
+                    c_end = mid;
+                }
+            }
+            return m_csa.comp2char[c_begin-1];
+        }
+
         void copy(const cst_sada& cst)
         {
             m_csa           = cst.m_csa;
@@ -238,8 +319,9 @@ class cst_sada
             {
                 auto event = memory_monitor::event("bpss-dfs");
                 util::assign(m_bp_support, bp_support_type(&m_bp));
-                util::init_support(m_bp_rank10,   &m_bp);
-                util::init_support(m_bp_select10, &m_bp);
+                util::init_supports_parallel(
+                    std::make_pair(&m_bp_rank10,   &m_bp),
+                    std::make_pair(&m_bp_select10, &m_bp));
             }
             {
                 auto event = memory_monitor::event("clcp");
@@ -581,6 +663,63 @@ class cst_sada
             return cst_node_child_proxy<cst_sada>(this,v);
         }
 
+        //! Enumerate the children of v with the first characters of their edge labels.
+        /*! \param v A valid node of the suffix tree.
+         *  \return Vector of (first character of the edge label (v,w), w)
+         *          pairs for all children w of v, in lexicographical order.
+         *  \par Time complexity
+         *     \f$ \Order{\degree(v) \cdot (\saaccess+\isaaccess)} \f$
+         *  \par Computes what degree(v) calls of child(v, c, char_pos)
+         *       compute, but resolves the character positions of all
+         *       children together: one batched \f$\Psi\f$ sweep per
+         *       character depth, with the pending lookups sorted by
+         *       position, so lookups which fall into the same \f$\Psi\f$
+         *       sample block of the underlying enc_vector share a single
+         *       block decode instead of each child decoding on its own.
+         */
+        std::vector<std::pair<char_type, node_type>>
+        children_batch(node_type v)const
+        {
+            std::vector<std::pair<char_type, node_type>> res;
+            if (is_leaf(v)) // if v is a leaf = (), v has no child
+                return res;
+            size_type d = depth(v);
+            std::vector<node_type> childs;
+            std::vector<size_type> pos;
+            node_type w = v+1;
+            while (m_bp[w]) {
+                childs.push_back(w);
+                if (is_leaf(w)) {
+                    pos.push_back(m_bp_rank10(w));
+                } else {
+                    pos.push_back(inorder(w));
+                }
+                w = m_bp_support.find_close(w)+1;
+            }
+            resolve_char_pos(pos, d);
+            res.reserve(childs.size());
+            for (size_type i=0; i < childs.size(); ++i) {
+                res.emplace_back(char_of_pos(pos[i]), childs[i]);
+            }
+            return res;
+        }
+
+        //! Collect the text positions of all suffixes in the subtree of v.
+        /*! \param v A valid node of the suffix tree.
+         *  \return SA[lb(v)..rb(v)], i.e. the occurrence positions of the
+         *          path label of v, in suffix array order.
+         *  \par Batched version of csa[i] for all leaves below v: all
+         *       unresolved positions walk to their next suffix array
+         *       sample together (csa_sada::sa_batch), sorted by position
+         *       in every round, so \f$\Psi\f$ walks passing through the
+         *       same sample block share one decode. For CSAs without a
+         *       batched kernel the positions are resolved one by one.
+         */
+        std::vector<size_type> subtree_batch(node_type v)const
+        {
+            return subtree_batch_dispatch(m_csa, lb(v), rb(v)+1, 0);
+        }
+
 
 //! Returns the next sibling of node v.
         /*!
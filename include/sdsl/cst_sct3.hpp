@@ -487,6 +487,22 @@ class cst_sct3
          */
         void load(std::istream& in);
 
+        //! Load only the CSA component from a stream.
+        /*! The stream has to be positioned at the begin of a serialized
+         *  cst_sct3 object; afterwards it is positioned at the begin of the
+         *  remaining components, which can be loaded with load_tree.
+         *  Together with load_tree this allows component-wise lazy loading,
+         *  see lazy_cst.
+         *  \param in Inputstream to load the CSA from.
+         */
+        void load_csa(std::istream& in);
+
+        //! Load all components except the CSA from a stream.
+        /*! Expects the stream to be positioned as left by load_csa.
+         *  \param in Inputstream to load the tree components from.
+         */
+        void load_tree(std::istream& in);
+
         /*! \defgroup cst_sct3_tree_methods Tree methods of cst_sct3 */
         /* @{ */
 
@@ -1157,9 +1173,10 @@ cst_sct3<t_csa, t_lcp, t_bp_support, t_bv, t_rank, t_sel>::cst_sct3(cache_config
     }
     {
         auto event = memory_monitor::event("bpss-sct");
-        util::init_support(m_bp_support, &m_bp);
-        util::init_support(m_first_child_rank, &m_first_child);
-        util::init_support(m_first_child_select, &m_first_child);
+        util::init_supports_parallel(
+            std::make_pair(&m_bp_support, &m_bp),
+            std::make_pair(&m_first_child_rank, &m_first_child),
+            std::make_pair(&m_first_child_select, &m_first_child));
     }
     if (!build_only_bps) {
         auto event = memory_monitor::event("clcp");
@@ -1192,8 +1209,20 @@ auto cst_sct3<t_csa, t_lcp, t_bp_support, t_bv, t_rank, t_sel>::serialize(std::o
 
 template<class t_csa, class t_lcp, class t_bp_support, class t_bv, class t_rank, class t_sel>
 void cst_sct3<t_csa, t_lcp, t_bp_support, t_bv, t_rank, t_sel>::load(std::istream& in)
+{
+    load_csa(in);
+    load_tree(in);
+}
+
+template<class t_csa, class t_lcp, class t_bp_support, class t_bv, class t_rank, class t_sel>
+void cst_sct3<t_csa, t_lcp, t_bp_support, t_bv, t_rank, t_sel>::load_csa(std::istream& in)
 {
     m_csa.load(in);
+}
+
+template<class t_csa, class t_lcp, class t_bp_support, class t_bv, class t_rank, class t_sel>
+void cst_sct3<t_csa, t_lcp, t_bp_support, t_bv, t_rank, t_sel>::load_tree(std::istream& in)
+{
     load_lcp(m_lcp, in, *this);
     m_bp.load(in);
     m_bp_support.load(in, &m_bp);
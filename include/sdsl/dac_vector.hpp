@@ -421,6 +421,17 @@ class dac_vector
         template<uint8_t int_width>
         dac_vector(int_vector_buffer<int_width>& v_buf);
 
+        //! Constructor for an iterator pair of unsigned integers.
+        /*! \param begin Iterator pointing to the first element.
+            \param end   Iterator pointing behind the last element.
+            \par The range is traversed twice -- once to count the blocks
+                 per level and once to write them -- so the iterators have
+                 to be multi-pass forward iterators. The source is never
+                 materialized in RAM.
+         */
+        template<class t_itr>
+        dac_vector(t_itr begin, t_itr end);
+
         //! The number of elements in the dac_vector.
         size_type size()const
         {
@@ -468,9 +479,12 @@ class dac_vector
         {
             uint8_t level = 1;
             uint8_t offset = t_b;
-            value_type result = m_data[i];
             const uint64_t* p = m_level_pointer_and_rank.data();
             uint64_t ppi = (*p)+i;
+            // issue the overflow-bit load before the block read; the two
+            // lines are independent, so the misses overlap
+            bits::prefetch(m_overflow.data() + (ppi>>6));
+            value_type result = m_data[i];
             while (level < m_max_level and m_overflow[ppi]) {
                 p += 2;
                 ppi = *p + (m_overflow_rank(ppi) - *(p-1));
@@ -483,6 +497,55 @@ class dac_vector
 
         size_t levels() const { return m_max_level; }
 
+        //! Decode the values at the n positions indices[0..n-1] into out.
+        /*! The elements are processed level by level: first all first-level
+         *  blocks are fetched, then the overflow tests, rank queries and
+         *  block reads of the second level for the surviving elements, and
+         *  so on. The per-level arrays and rank counters stay hot in cache
+         *  and the overflow words of upcoming elements are prefetched, so
+         *  the dependent misses of the level chase overlap across elements
+         *  instead of serializing as in operator[].
+         *  \param indices Array of n element positions.
+         *  \param n       Number of positions.
+         *  \param out     Array of length at least n receiving the values.
+         */
+        void access_batch(const size_type* indices, size_type n, uint64_t* out)const
+        {
+            const size_type lookahead = 8;
+            const uint64_t* p = m_level_pointer_and_rank.data();
+            std::vector<size_type> ppi(n), act(n);
+            for (size_type j=0; j < n; ++j) {
+                ppi[j] = *p + indices[j];
+                out[j] = m_data[ppi[j]];
+                act[j] = j;
+            }
+            size_type m = n;         // number of still overflowing elements
+            uint8_t offset = t_b;
+            for (uint8_t level = 1; level < m_max_level and m > 0; ++level) {
+                size_type mm = 0;    // keep elements that continue one level up
+                for (size_type k=0; k < m; ++k) {
+                    if (k+lookahead < m) {
+                        bits::prefetch(m_overflow.data() + (ppi[act[k+lookahead]]>>6));
+                    }
+                    size_type j = act[k];
+                    if (m_overflow[ppi[j]]) {
+                        act[mm++] = j;
+                    }
+                }
+                p += 2;
+                for (size_type k=0; k < mm; ++k) {
+                    size_type j = act[k];
+                    ppi[j] = *p + (m_overflow_rank(ppi[j]) - *(p-1));
+                }
+                for (size_type k=0; k < mm; ++k) {
+                    size_type j = act[k];
+                    out[j] |= (uint64_t)(m_data[ppi[j]]) << offset;
+                }
+                m = mm;
+                offset += t_b;
+            }
+        }
+
         //! Serializes the dac_vector to a stream.
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const;
 
@@ -650,6 +713,82 @@ dac_vector<t_b, t_rank>::dac_vector(int_vector_buffer<int_width>& v_buf)
     }
 }
 
+template<uint8_t t_b, typename t_rank>
+template<class t_itr>
+dac_vector<t_b, t_rank>::dac_vector(t_itr begin, t_itr end)
+{
+//  (1) Count for each level, how many blocks are needed for the representation
+//      Running time: \f$ O(n \times \frac{\log n}{b}  \f$
+//      Result is sorted in m_level_pointer_and_rank
+    size_type n = 0, val=0;
+    if (begin == end)
+        return;
+// initialize counter
+    m_level_pointer_and_rank = int_vector<64>(128, 0);
+
+    uint8_t level_x_2 = 0;
+    uint8_t max_level_x_2 = 4;
+    for (t_itr it = begin; it != end; ++it, ++n) {
+        val = *it;
+        val >>= t_b; // shift value b bits to the right
+        level_x_2 = 2;
+        while (val) {
+            // increase counter for current level by 1
+            ++m_level_pointer_and_rank[level_x_2];
+            val >>= t_b; // shift value b bits to the right
+            level_x_2 += 2; // increase level by 1
+            max_level_x_2 = std::max(max_level_x_2, level_x_2);
+        }
+    }
+    m_level_pointer_and_rank[0] = n; // level 0 has n entries
+    m_level_pointer_and_rank.resize(max_level_x_2);
+//  (2)    Determine maximum level and prefix sums of level counters
+    m_max_level = 0;
+    size_type sum_blocks = 0, last_block_size=0;
+    for (size_type i=0, t=0; i < m_level_pointer_and_rank.size(); i+=2) {
+        t = sum_blocks;
+        sum_blocks += m_level_pointer_and_rank[i];
+        m_level_pointer_and_rank[i] = t;
+        if (sum_blocks > t) {
+            ++m_max_level;
+            last_block_size = sum_blocks - t;
+        }
+    }
+    m_overflow = bit_vector(sum_blocks - last_block_size, 0);
+    m_data.resize(sum_blocks);
+
+    assert(last_block_size > 0);
+
+//  (3)    Enter block and overflow data
+    int_vector<64> cnt = m_level_pointer_and_rank;
+    const uint64_t mask = bits::lo_set[t_b];
+
+    for (t_itr it = begin; it != end; ++it) {
+        val = *it;
+        size_type j = cnt[0]++;
+        m_data[ j ] =  val & mask;
+        val >>= t_b; // shift value b bits to the right
+        level_x_2 = 2;
+        while (val) {
+            m_overflow[j] = 1;
+            // increase counter for current level by 1
+            j = cnt[level_x_2]++;
+            m_data[ j ] = val & mask;
+            val >>= t_b; // shift value b bits to the right
+            level_x_2 += 2; // increase level by 1
+        }
+    }
+
+//  (4) Initialize rank data structure for m_overflow and precalc rank for
+//      pointers
+    util::init_support(m_overflow_rank, &m_overflow);
+    for (size_type i=0; 2*i < m_level_pointer_and_rank.size() and
+         m_level_pointer_and_rank[2*i] < m_overflow.size(); ++i) {
+        m_level_pointer_and_rank[2*i+1] = m_overflow_rank(
+                                              m_level_pointer_and_rank[2*i]);
+    }
+}
+
 template<uint8_t t_b, typename t_rank>
 dac_vector<>::size_type dac_vector<t_b, t_rank>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const
 {
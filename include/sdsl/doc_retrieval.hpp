@@ -0,0 +1,521 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file doc_retrieval.hpp
+    \brief doc_retrieval.hpp contains a document retrieval index which
+           supports distinct-document listing and top-k most frequent
+           document queries over a concatenated document collection.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_DOC_RETRIEVAL
+#define INCLUDED_SDSL_DOC_RETRIEVAL
+
+#include "suffix_arrays.hpp"
+#include "wavelet_trees.hpp"
+#include "rmq_support.hpp"
+#include "sd_vector.hpp"
+#include <queue>
+#include <stack>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A document retrieval index over a delimited document collection.
+/*! The index is built from the concatenation of the documents, each
+ *  terminated by the delimiter symbol t_doc_delim. It packages a CSA of
+ *  the collection, the document border bit vector (an sd_vector by
+ *  default), a wavelet tree of the document array, and a range minimum
+ *  structure over the C_prev array, and answers
+ *    - count:  number of occurrences of a pattern,
+ *    - list:   the distinct documents containing a pattern
+ *              (Muthukrishnan's RMQ-based algorithm), and
+ *    - top_k:  the k documents containing a pattern most often
+ *              (greedy wavelet tree traversal of the document array).
+ *
+ *  \tparam t_csa        CSA type for the collection text.
+ *  \tparam t_wtd        Wavelet tree type for the document array.
+ *  \tparam t_rmq        Range minimum structure for the C_prev array.
+ *  \tparam t_doc_border Bit vector type for the document borders.
+ *  \tparam t_doc_delim  Delimiter symbol between two documents.
+ *
+ *  \par References
+ *      [1] S. Muthukrishnan: ,,Efficient algorithms for document
+ *          retrieval problems'', SODA 2002.
+ *      [2] W.-K. Hon, R. Shah, J. S. Vitter: ,,Space-Efficient
+ *          Framework for Top-k String Retrieval Problems'', FOCS 2009.
+ *      [3] J. S. Culpepper, G. Navarro, S. J. Puglisi, A. Turpin:
+ *          ,,Top-k Ranked Document Search in General Text Databases'',
+ *          ESA 2010.
+ */
+template<class t_csa        = csa_wt<wt_huff<rrr_vector<63>>, 32, 1000000>,
+         class t_wtd        = wt_int<bit_vector,
+                                     rank_support_v5<1>,
+                                     select_support_scan<1>,
+                                     select_support_scan<0>>,
+         class t_rmq        = rmq_succinct_sct<true>,
+         class t_doc_border = sd_vector<>,
+         typename t_csa::char_type t_doc_delim = 1>
+class doc_retrieval
+{
+    public:
+        typedef t_csa                                 csa_type;
+        typedef t_wtd                                 wtd_type;
+        typedef t_rmq                                 rmq_type;
+        typedef t_doc_border                          doc_border_type;
+        typedef typename t_doc_border::rank_1_type    doc_border_rank_type;
+        typedef typename t_doc_border::select_1_type  doc_border_select_type;
+        typedef int_vector<>::size_type               size_type;
+        typedef typename t_wtd::value_type            value_type;
+        typedef std::vector<std::pair<value_type, size_type>> list_type;
+
+        enum { WIDTH = t_csa::alphabet_category::WIDTH };
+
+    private:
+        size_type              m_doc_cnt = 0;       // number of documents
+        csa_type               m_csa;               // CSA of the collection text
+        wtd_type               m_wtd;               // wavelet tree of the document array
+        rmq_type               m_rminq;             // range minimum structure over C_prev
+        doc_border_type        m_doc_border;        // positions of the delimiters
+        doc_border_rank_type   m_doc_border_rank;   // rank on m_doc_border
+        doc_border_select_type m_doc_border_select; // select on m_doc_border
+        mutable bit_vector     m_doc_marked;        // helper bitvector for listing
+
+        // heap entry of the greedy top-k traversal: a node of the
+        // document array wavelet tree together with the query range
+        struct wt_range_t {
+            typedef typename wtd_type::node_type node_type;
+            node_type  v;
+            range_type r;
+
+            size_type size() const {
+                return r[1] - r[0] + 1;
+            }
+            bool operator<(const wt_range_t& x) const {
+                if (x.size() != size())
+                    return size() < x.size();
+                return v.sym > x.v.sym;
+            }
+            wt_range_t(const node_type& _v, const range_type& _r) :
+                v(_v), r(_r) {}
+        };
+
+        void copy(const doc_retrieval& dr) {
+            m_doc_cnt = dr.m_doc_cnt;
+            m_csa = dr.m_csa;
+            m_wtd = dr.m_wtd;
+            m_rminq = dr.m_rminq;
+            m_doc_border = dr.m_doc_border;
+            m_doc_border_rank = dr.m_doc_border_rank;
+            m_doc_border_rank.set_vector(&m_doc_border);
+            m_doc_border_select = dr.m_doc_border_select;
+            m_doc_border_select.set_vector(&m_doc_border);
+            m_doc_marked = dr.m_doc_marked;
+        }
+
+        //! Construct the doc_border bitvector by streaming the text file
+        void construct_doc_border(const std::string& text_file,
+                                  doc_border_type& doc_border)
+        {
+            int_vector_buffer<WIDTH> text_buf(text_file);
+            bit_vector tmp_doc_border(text_buf.size(), 0);
+            for (size_type i = 0; i < text_buf.size(); ++i) {
+                if (t_doc_delim == text_buf[i]) {
+                    tmp_doc_border[i] = 1;
+                }
+            }
+            doc_border = doc_border_type(tmp_doc_border);
+        }
+
+        void construct_D_array(int_vector_buffer<0>& sa_buf,
+                               const doc_border_rank_type& doc_border_rank,
+                               const size_type doc_cnt,
+                               int_vector<>& D)
+        {
+            D = int_vector<>(sa_buf.size(), 0, bits::hi(doc_cnt+1)+1);
+            for (size_type i = 0; i < sa_buf.size(); ++i) {
+                D[i] = doc_border_rank(sa_buf[i]+1);
+            }
+        }
+
+        void construct_Cprev_array(const int_vector<>& D,
+                                   size_type doc_cnt,
+                                   int_vector<>& Cprev)
+        {
+            Cprev = int_vector<>(D.size(), 0, bits::hi(D.size())+1);
+            int_vector<> last_occ(doc_cnt+2, 0, bits::hi(D.size())+1);
+            for (size_type i = 0; i < D.size(); ++i) {
+                size_type doc = D[i];
+                Cprev[i]      = last_occ[doc];
+                last_occ[doc] = i;
+            }
+        }
+
+    public:
+
+        const size_type&       doc_cnt = m_doc_cnt;
+        const csa_type&        csa     = m_csa;
+        const wtd_type&        wtd     = m_wtd;
+
+        //! Default constructor
+        doc_retrieval() {}
+
+        //! Constructor
+        /*! \param file_name File with the concatenation of the
+         *                   documents, each terminated by t_doc_delim.
+         *  \param cconfig   Cache configuration; the text and suffix
+         *                   array produced during CSA construction are
+         *                   reused, so the configuration must keep the
+         *                   cached files (delete_files == false).
+         *  \param num_bytes Bytes per symbol of the input, see
+         *                   construct().
+         */
+        doc_retrieval(const std::string& file_name,
+                      sdsl::cache_config& cconfig, uint8_t num_bytes)
+        {
+            construct(m_csa, file_name, cconfig, num_bytes);
+
+            const char* KEY_TEXT = key_text_trait<WIDTH>::KEY_TEXT;
+            std::string text_file = cache_file_name(KEY_TEXT, cconfig);
+
+            construct_doc_border(text_file, m_doc_border);
+            m_doc_border_rank   = doc_border_rank_type(&m_doc_border);
+            m_doc_border_select = doc_border_select_type(&m_doc_border);
+            m_doc_cnt = m_doc_border_rank(m_doc_border.size());
+
+            int_vector_buffer<0> sa_buf(cache_file_name(conf::KEY_SA, cconfig));
+            {
+                int_vector<> D;
+                construct_D_array(sa_buf, m_doc_border_rank, m_doc_cnt, D);
+                std::string d_file = cache_file_name("doc_retrieval_darray",
+                                                     cconfig);
+                store_to_file(D, d_file);
+                construct(m_wtd, d_file);
+                sdsl::remove(d_file);
+                {
+                    int_vector<> Cprev;
+                    construct_Cprev_array(D, m_doc_cnt, Cprev);
+                    rmq_type rminq(&Cprev);
+                    m_rminq = rminq;
+                }
+            }
+            m_doc_marked = bit_vector(m_doc_cnt+2, 0);
+        }
+
+        //! Copy constructor
+        doc_retrieval(const doc_retrieval& dr) {
+            copy(dr);
+        }
+
+        //! Move constructor
+        doc_retrieval(doc_retrieval&& dr) {
+            *this = std::move(dr);
+        }
+
+        doc_retrieval& operator=(const doc_retrieval& dr) {
+            if (this != &dr) {
+                copy(dr);
+            }
+            return *this;
+        }
+
+        doc_retrieval& operator=(doc_retrieval&& dr) {
+            if (this != &dr) {
+                m_doc_cnt = dr.m_doc_cnt;
+                m_csa = std::move(dr.m_csa);
+                m_wtd = std::move(dr.m_wtd);
+                m_rminq = std::move(dr.m_rminq);
+                m_doc_border = std::move(dr.m_doc_border);
+                m_doc_border_rank = std::move(dr.m_doc_border_rank);
+                m_doc_border_rank.set_vector(&m_doc_border);
+                m_doc_border_select = std::move(dr.m_doc_border_select);
+                m_doc_border_select.set_vector(&m_doc_border);
+                m_doc_marked = std::move(dr.m_doc_marked);
+            }
+            return *this;
+        }
+
+        void swap(doc_retrieval& dr) {
+            if (this != &dr) {
+                std::swap(m_doc_cnt, dr.m_doc_cnt);
+                m_csa.swap(dr.m_csa);
+                m_wtd.swap(dr.m_wtd);
+                m_rminq.swap(dr.m_rminq);
+                m_doc_border.swap(dr.m_doc_border);
+                util::swap_support(m_doc_border_rank, dr.m_doc_border_rank,
+                                   &m_doc_border, &(dr.m_doc_border));
+                util::swap_support(m_doc_border_select, dr.m_doc_border_select,
+                                   &m_doc_border, &(dr.m_doc_border));
+                m_doc_marked.swap(dr.m_doc_marked);
+            }
+        }
+
+        //! Number of symbols in the collection text.
+        size_type size() const {
+            return m_csa.size();
+        }
+
+        //! Locate the suffix array interval of a pattern.
+        /*! \return The number of occurrences; on success sp and ep hold
+         *          the interval borders.
+         */
+        template<class t_pat_iter>
+        size_type interval(t_pat_iter begin, t_pat_iter end,
+                           size_type& sp, size_type& ep) const
+        {
+            return backward_search(m_csa, 0, m_csa.size()-1,
+                                   begin, end, sp, ep);
+        }
+
+        //! Count the occurrences of a pattern in the collection.
+        template<class t_pat_iter>
+        size_type count(t_pat_iter begin, t_pat_iter end) const
+        {
+            size_type sp=1, ep=0;
+            return interval(begin, end, sp, ep);
+        }
+
+        //! List the distinct documents whose suffixes fall in [sp..ep].
+        /*! \param sp Left border of the suffix array interval.
+         *  \param ep Right border of the suffix array interval.
+         *  \return The distinct document numbers in increasing order.
+         *  \par Time complexity
+         *      \f$ \Order{ndoc} \f$ range minimum queries and document
+         *      array accesses, where ndoc is the size of the answer.
+         */
+        std::vector<value_type> list(size_type sp, size_type ep) const
+        {
+            std::vector<value_type> docs;
+            if (sp > ep or ep >= m_wtd.size())
+                return docs;
+            typedef std::pair<size_type, size_type> t_range;
+            std::stack<t_range> ranges;
+            ranges.emplace(sp, ep);
+            while (!ranges.empty()) {
+                auto range = ranges.top();
+                ranges.pop();
+                size_type rsp = std::get<0>(range);
+                size_type rep = std::get<1>(range);
+                if (rsp <= rep) {
+                    size_type min_idx = m_rminq(rsp, rep);
+                    value_type doc    = m_wtd[min_idx];
+                    if (!m_doc_marked[doc]) {
+                        docs.push_back(doc);
+                        m_doc_marked[doc] = 1;
+                        ranges.emplace(min_idx+1, rep);
+                        if (min_idx > rsp) {
+                            ranges.emplace(rsp, min_idx-1);
+                        }
+                    }
+                }
+            }
+            for (auto doc : docs) {
+                m_doc_marked[doc] = 0;
+            }
+            std::sort(docs.begin(), docs.end());
+            return docs;
+        }
+
+        //! List the distinct documents which contain a pattern.
+        template<class t_pat_iter>
+        std::vector<value_type> list(t_pat_iter begin, t_pat_iter end) const
+        {
+            size_type sp=1, ep=0;
+            if (0 == interval(begin, end, sp, ep)) {
+                return std::vector<value_type>();
+            }
+            return list(sp, ep);
+        }
+
+        //! The k documents with the most suffixes in [sp..ep].
+        /*! \param sp Left border of the suffix array interval.
+         *  \param ep Right border of the suffix array interval.
+         *  \param k  Number of documents to report.
+         *  \return Pairs (document, frequency) in decreasing order of
+         *          frequency.
+         *
+         *  Greedy traversal of the document array wavelet tree: the
+         *  node covering the largest part of the interval is expanded
+         *  first, so the leaves -- the documents -- are reached in
+         *  decreasing order of frequency and the traversal stops after
+         *  the k-th one.
+         */
+        list_type top_k(size_type sp, size_type ep, size_type k) const
+        {
+            list_type results;
+            if (sp > ep or ep >= m_wtd.size() or 0 == k)
+                return results;
+            std::priority_queue<wt_range_t> heap;
+            heap.emplace(m_wtd.root(), range_type {sp, ep});
+            while (!heap.empty()) {
+                wt_range_t e = heap.top();
+                heap.pop();
+                if (m_wtd.is_leaf(e.v)) {
+                    results.emplace_back(e.v.sym, e.size());
+                    if (results.size() == k) {
+                        break;
+                    }
+                    continue;
+                }
+                auto child        = m_wtd.expand(e.v);
+                auto child_ranges = m_wtd.expand(e.v, e.r);
+                auto left_range   = std::get<0>(child_ranges);
+                auto right_range  = std::get<1>(child_ranges);
+                if (!empty(left_range)) {
+                    heap.emplace(std::get<0>(child), left_range);
+                }
+                if (!empty(right_range)) {
+                    heap.emplace(std::get<1>(child), right_range);
+                }
+            }
+            return results;
+        }
+
+        //! The k documents which contain a pattern most often.
+        template<class t_pat_iter>
+        list_type top_k(t_pat_iter begin, t_pat_iter end, size_type k) const
+        {
+            size_type sp=1, ep=0;
+            if (0 == interval(begin, end, sp, ep)) {
+                return list_type();
+            }
+            return top_k(sp, ep, k);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(
+                                             v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_doc_cnt, out, child, "doc_cnt");
+            written_bytes += m_csa.serialize(out, child, "csa");
+            written_bytes += m_wtd.serialize(out, child, "wtd");
+            written_bytes += m_rminq.serialize(out, child, "rminq");
+            written_bytes += m_doc_border.serialize(out, child, "doc_border");
+            written_bytes += m_doc_border_rank.serialize(out, child,
+                             "doc_border_rank");
+            written_bytes += m_doc_border_select.serialize(out, child,
+                             "doc_border_select");
+            // the helper bitvector m_doc_marked is not serialized
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in)
+        {
+            read_member(m_doc_cnt, in);
+            m_csa.load(in);
+            m_wtd.load(in);
+            m_rminq.load(in);
+            m_doc_border.load(in);
+            m_doc_border_rank.load(in);
+            m_doc_border_rank.set_vector(&m_doc_border);
+            m_doc_border_select.load(in);
+            m_doc_border_select.set_vector(&m_doc_border);
+            m_doc_marked = bit_vector(m_doc_cnt+2, 0);
+        }
+};
+
+//! Streams (node, tf, df) statistics for all frequent CST nodes in one pass.
+/*! \tparam t_cst        CST type, e.g. cst_sct3.
+ *  \tparam t_doc_border Bit vector type of the document borders.
+ *  \tparam t_report     Functor type for the reported statistics.
+ *
+ *  \param cst          The CST of the concatenated document collection.
+ *  \param doc_border   Bit vector with a one at each document delimiter.
+ *  \param tf_threshold Minimal term frequency for a node to be reported.
+ *  \param report       Functor called as report(v, tf, df) for every
+ *                      node v with \f$ tf \geq tf\_threshold \f$, where
+ *                      tf is the number of occurrences of the node's
+ *                      string and df the number of distinct documents
+ *                      containing it. Nodes are reported bottom-up
+ *                      (postorder).
+ *
+ *  Replaces per-term count() plus document-border rank queries by one
+ *  linear pass: the document array is derived in suffix array order by
+ *  a single \f$ \Psi \f$ walk, each pair of consecutive suffixes of the
+ *  same document charges one duplicate to the lca of the two leaves
+ *  (Sadakane's scheme), and a bottom-up traversal accumulates the
+ *  subtree duplicate sums on a stack, so that \f$ df(v) = tf(v) -
+ *  dup(v) \f$ falls out for every node as it is visited.
+ *
+ *  \par Time complexity
+ *       \f$ \Order{ n (t_{\Psi} + t_{lca}) } \f$
+ *  \par Space complexity
+ *       \f$ 2 n \log n \f$ bits of working memory for the document
+ *       array and the per-node duplicate counters.
+ */
+template<class t_cst, class t_doc_border, class t_report>
+void doc_statistics(const t_cst& cst, const t_doc_border& doc_border,
+                    typename t_cst::size_type tf_threshold, t_report&& report)
+{
+    typedef typename t_cst::size_type size_type;
+    typedef typename t_cst::node_type node_type;
+    size_type n = cst.size();
+    if (0 == n) {
+        return;
+    }
+    typename t_doc_border::rank_1_type border_rank;
+    util::init_support(border_rank, &doc_border);
+    size_type doc_cnt = border_rank(doc_border.size());
+    // document array in suffix array order via one Psi walk
+    int_vector<> dark(n, 0, bits::hi(doc_cnt+1)+1);
+    size_type row = cst.csa.isa[0];
+    for (size_type t=0; t < n; ++t) {
+        dark[row] = border_rank(t+1);
+        row = cst.csa.psi[row];
+    }
+    // charge each pair of consecutive same-document suffixes to the
+    // lca of the two leaves
+    int_vector<> dup(cst.nodes(), 0, bits::hi(n)+1);
+    {
+        int_vector<> last(doc_cnt+1, n, bits::hi(n)+1);
+        for (size_type i=0; i < n; ++i) {
+            size_type d = dark[i];
+            if (last[d] != n) {
+                node_type w = cst.lca(cst.select_leaf(last[d]+1),
+                                      cst.select_leaf(i+1));
+                size_type id = cst.id(w);
+                dup[id] = dup[id] + 1;
+            }
+            last[d] = i;
+        }
+    }
+    // bottom-up traversal accumulating subtree duplicate sums
+    std::vector<size_type> sums;
+    for (auto it = cst.begin_bottom_up(); it != cst.end_bottom_up(); ++it) {
+        node_type v = *it;
+        size_type s = dup[cst.id(v)];
+        if (!cst.is_leaf(v)) {
+            for (size_type c = cst.degree(v); c > 0; --c) {
+                s += sums.back();
+                sums.pop_back();
+            }
+        }
+        sums.push_back(s);
+        size_type tf = cst.size(v);
+        if (tf >= tf_threshold) {
+            report(v, tf, tf - s);
+        }
+    }
+}
+
+} // end namespace sdsl
+#endif
@@ -110,6 +110,18 @@ class enc_vector
         template<uint8_t int_width>
         enc_vector(int_vector_buffer<int_width>& v_buf);
 
+        //! Constructor for an iterator pair of unsigned integers.
+        /*! \param begin Iterator pointing to the first element.
+            \param end   Iterator pointing behind the last element.
+            \par The range is traversed twice -- once to size the samples
+                 and the encoded deltas and once to write them -- so the
+                 iterators have to be multi-pass forward iterators. The
+                 source is never materialized in RAM; peak memory during
+                 construction is the size of the result.
+         */
+        template<class t_itr>
+        enc_vector(t_itr begin, t_itr end);
+
         //! Default Destructor
         ~enc_vector() { }
 
@@ -179,12 +191,130 @@ class enc_vector
         {
             *(it++) = 0;
             if (i*t_dens + t_dens - 1 < size()) {
-                t_coder::template decode<true, true>(m_z.data(), m_sample_vals_and_pointer[(i<<1)+1], t_dens - 1, it);
+                t_coder::template decode_batch<true>(m_z.data(), m_sample_vals_and_pointer[(i<<1)+1], m_z.size(), t_dens - 1, it);
             } else {
                 assert(i*t_dens < size());
-                t_coder::template decode<true, true>(m_z.data(), m_sample_vals_and_pointer[(i<<1)+1], size()-i*t_dens - 1, it);
+                t_coder::template decode_batch<true>(m_z.data(), m_sample_vals_and_pointer[(i<<1)+1], m_z.size(), size()-i*t_dens - 1, it);
+            }
+        };
+
+        //! Prefetch the sample pair and encoded data of the i-th sample block.
+        /*! \param i Index of the sample block; out-of-range values are ignored.
+         *  Useful when the block which will be decoded next is already known,
+         *  e.g. during a block-wise scan: the loads overlap with the decoding
+         *  of the current block.
+         */
+        void prefetch_block(const size_type i)const
+        {
+            if ((i<<1)+1 < m_sample_vals_and_pointer.size()) {
+                bits::prefetch(m_sample_vals_and_pointer.data()
+                               + (((i<<1)*m_sample_vals_and_pointer.width())>>6));
+                bits::prefetch(m_z.data() + (m_sample_vals_and_pointer[(i<<1)+1]>>6));
+            }
+        }
+
+        //! Decode the n consecutive values v[i],...,v[i+n-1] into buf.
+        /*! Each sample block overlapping the range is decoded exactly once,
+         *  in contrast to operator[], which restarts the block for every
+         *  access.
+         *  \param i   Index of the first value. \f$ i+n \leq size() \f$.
+         *  \param n   Number of values to decode.
+         *  \param buf Array of length at least n receiving the values.
+         */
+        void decode_range(size_type i, size_type n, uint64_t* buf)const
+        {
+            assert(i+n <= m_size);
+            uint64_t block[t_dens];
+            while (n > 0) {
+                size_type idx      = i/t_dens;        // current sample block
+                size_type off      = i - idx*t_dens;  // offset in the block
+                size_type in_block = t_dens - off < n ? t_dens - off : n;
+                get_inter_sampled_values(idx, block);
+                value_type base = m_sample_vals_and_pointer[idx<<1];
+                for (size_type k=0; k < in_block; ++k) {
+                    buf[k] = base + block[off+k];
+                }
+                buf += in_block;
+                i   += in_block;
+                n   -= in_block;
             }
+        }
+
+        //! Forward iterator which keeps the current sample block decoded.
+        /*! A sequential scan decodes every block once instead of restarting
+         *  it for each of its t_dens elements, as operator[] does.
+         */
+        class stream_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag        iterator_category;
+                typedef enc_vector::value_type           value_type;
+                typedef enc_vector::difference_type      difference_type;
+                typedef const value_type*                pointer;
+                typedef const value_type                 reference;
+            private:
+                const enc_vector* m_v = nullptr;        // supported vector
+                size_type         m_idx = 0;            // current position
+                size_type         m_block_idx = 0;      // buffered sample block
+                bool              m_block_valid = false;
+                value_type        m_base = 0;           // sample of the block
+                uint64_t          m_block[t_dens];      // decoded deltas
+
+                void buffer_block()
+                {
+                    m_block_idx = m_idx/t_dens;
+                    m_v->get_inter_sampled_values(m_block_idx, m_block);
+                    m_base = m_v->m_sample_vals_and_pointer[m_block_idx<<1];
+                    m_block_valid = true;
+                }
+            public:
+                stream_iterator() = default;
+                stream_iterator(const enc_vector* v, size_type idx)
+                    : m_v(v), m_idx(idx) { }
+
+                value_type operator*()
+                {
+                    if (!m_block_valid or m_idx/t_dens != m_block_idx) {
+                        buffer_block();
+                    }
+                    return m_base + m_block[m_idx - m_block_idx*t_dens];
+                }
+
+                stream_iterator& operator++()
+                {
+                    ++m_idx;
+                    return *this;
+                }
+
+                stream_iterator operator++(int)
+                {
+                    stream_iterator it = *this;
+                    ++(*this);
+                    return it;
+                }
+
+                bool operator==(const stream_iterator& it)const
+                {
+                    return m_v == it.m_v and m_idx == it.m_idx;
+                }
+
+                bool operator!=(const stream_iterator& it)const
+                {
+                    return !(*this == it);
+                }
         };
+
+        //! Stream iterator that points to the first element of the enc_vector.
+        stream_iterator stream_begin()const
+        {
+            return stream_iterator(this, 0);
+        }
+
+        //! Stream iterator that points to the position after the last element of the enc_vector.
+        stream_iterator stream_end()const
+        {
+            return stream_iterator(this, m_size);
+        }
 };
 
 template<class t_coder, uint32_t t_dens, uint8_t t_width>
@@ -338,6 +468,65 @@ enc_vector<t_coder, t_dens,t_width>::enc_vector(int_vector_buffer<int_width>& v_
     m_size = n;
 }
 
+template<class t_coder, uint32_t t_dens, uint8_t t_width>
+template<class t_itr>
+enc_vector<t_coder, t_dens,t_width>::enc_vector(t_itr begin, t_itr end)
+{
+    // clear bit_vectors
+    clear();
+    if (begin == end)  // if the range is empty there is nothing to do...
+        return;
+    value_type     v1=0, v2=0, max_sample_value=0;
+    size_type n=0, samples=0, z_size=0;
+    const size_type sd = get_sample_dens();
+//  (1) Count elements; calculate maximal value of samples and of deltas
+    size_type no_sample = 0;
+    for (t_itr it = begin; it != end; ++it, ++n, --no_sample) {
+        v2 = *it;
+        if (!no_sample) { // is sample
+            no_sample = sd;
+            if (max_sample_value < v2) max_sample_value = v2;
+            ++samples;
+        } else {
+            z_size += t_coder::encoding_length(v2-v1);
+        }
+        v1 = v2;
+    }
+
+//    (2) Write sample values and deltas
+//    (a) Initialize array for sample values and pointers
+    if (max_sample_value > z_size+1)
+        m_sample_vals_and_pointer.width(bits::hi(max_sample_value) + 1);
+    else
+        m_sample_vals_and_pointer.width(bits::hi(z_size+1) + 1);
+    m_sample_vals_and_pointer.resize(2*samples+2); // add 2 for last entry
+    util::set_to_value(m_sample_vals_and_pointer, 0);
+
+//    (b) Initilize bit_vector for encoded data
+    m_z = int_vector<>(z_size, 0, 1);
+    uint64_t* z_data = t_coder::raw_data(m_z);
+    uint8_t offset = 0;
+
+//    (c) Write sample values and deltas
+    z_size = 0;
+    v1 = 0;
+    no_sample = 0;
+    size_type j = 0;
+    for (t_itr it = begin; it != end; ++it, --no_sample) {
+        v2 = *it;
+        if (!no_sample) { // is sample
+            no_sample = sd;
+            m_sample_vals_and_pointer[j++] = v2;    // write samples
+            m_sample_vals_and_pointer[j++] = z_size;// write pointers
+        } else {
+            z_size += t_coder::encoding_length(v2-v1);
+            t_coder::encode(v2-v1, z_data, offset);   // write encoded values
+        }
+        v1 = v2;
+    }
+    m_size = n;
+}
+
 template<class t_coder, uint32_t t_dens, uint8_t t_width>
 enc_vector<>::size_type enc_vector<t_coder, t_dens,t_width>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const
 {
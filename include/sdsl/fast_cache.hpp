@@ -3,6 +3,9 @@
 #define INCLUDED_SDSL_FAST_CACHE
 
 #include "int_vector.hpp"
+#include <functional>
+#include <utility>
+#include <vector>
 
 namespace sdsl
 {
@@ -34,6 +37,93 @@ struct fast_cache {
     }
 };
 
+//! A small fixed-size query-result cache.
+/*! \tparam t_key      Key type of the memoized queries; has to be
+ *                     equality-comparable.
+ *  \tparam t_value    Result type of the memoized queries.
+ *  \tparam t_log_sets Base 2 logarithm of the number of sets. The cache
+ *                     holds \f$ 2^{t\_log\_sets+1} \f$ entries.
+ *  \tparam t_hash     Functor mapping a key to a size_t. The returned
+ *                     value is mixed with a multiplicative constant
+ *                     before indexing, so the identity hash of the
+ *                     standard library for integral keys is fine.
+ *
+ *  The cache is 2-way set-associative. Aging is a move-to-front within
+ *  the set: the most recently used entry of a set sits in way 0, and a
+ *  write evicts way 1. Lookup and write therefore cost at most two key
+ *  comparisons and no bookkeeping besides one conditional swap, in
+ *  contrast to the direct-mapped fast_cache above, where two frequent
+ *  keys which collide evict each other on every access.
+ *
+ *  Intended as an optional memo layer inside a structure (see
+ *  USE_CSA_CACHE in csa_wt.hpp); the member has to be mutable and the
+ *  cache has to be cleared whenever the underlying structure changes.
+ */
+template<class t_key, class t_value, uint8_t t_log_sets=13,
+         class t_hash=std::hash<t_key> >
+class query_cache
+{
+    public:
+        typedef t_key   key_type;
+        typedef t_value value_type;
+        typedef typename int_vector<>::size_type size_type;
+
+    private:
+        struct entry_type {
+            key_type   key;
+            value_type value;
+        };
+        static const size_type sets = 1ULL << t_log_sets;
+        std::vector<entry_type> m_table;  // 2 ways per set; way 0 is the MRU one
+        std::vector<uint8_t>    m_valid;
+        t_hash                  m_hash;
+
+        size_type set_start(const key_type& key) const {
+            // multiplicative mix, index with the high bits
+            uint64_t h = static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ULL;
+            // two-step shift: stays defined for t_log_sets == 0
+            return static_cast<size_type>((h >> 1) >> (63 - t_log_sets)) << 1;
+        }
+
+    public:
+        query_cache() : m_table(2*sets), m_valid(2*sets, 0) {}
+
+        //! Returns true and sets x to the cached answer if key is cached.
+        bool exists(const key_type& key, value_type& x) {
+            size_type s = set_start(key);
+            if (m_valid[s] and m_table[s].key == key) {
+                x = m_table[s].value;
+                return true;
+            }
+            if (m_valid[s+1] and m_table[s+1].key == key) {
+                std::swap(m_table[s], m_table[s+1]);  // move to front
+                std::swap(m_valid[s], m_valid[s+1]);
+                x = m_table[s].value;
+                return true;
+            }
+            return false;
+        }
+
+        //! Writes the answer x for the query key to the cache.
+        void write(const key_type& key, const value_type& x) {
+            size_type s = set_start(key);
+            if (m_valid[s] and m_table[s].key == key) {
+                m_table[s].value = x;
+                return;
+            }
+            m_table[s+1] = m_table[s];  // evict the LRU way
+            m_valid[s+1] = m_valid[s];
+            m_table[s].key   = key;
+            m_table[s].value = x;
+            m_valid[s]       = 1;
+        }
+
+        //! Invalidates all entries.
+        void clear() {
+            std::fill(m_valid.begin(), m_valid.end(), 0);
+        }
+};
+
 } // end namespace sdsl
 
 #endif
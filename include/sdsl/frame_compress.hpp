@@ -0,0 +1,329 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file frame_compress.hpp
+    \brief frame_compress.hpp contains frame-wise compression for
+           intermediate cache files.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_FRAME_COMPRESS
+#define INCLUDED_SDSL_FRAME_COMPRESS
+
+#include <string>
+#include <vector>
+#include "int_vector.hpp"
+#include "io.hpp"
+#include "sfstream.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! Frame-wise bit-packing codec for cache files.
+/*! Intermediate construction files (SA, ISA, LCP) are written with
+ *  the declared element width -- 64 bits per symbol for the suffix
+ *  array -- although the values of most frames fit into far fewer
+ *  bits. The codec splits the sequence into frames of 4096 values and
+ *  packs each frame with the width of its largest value; a one-byte
+ *  width table in the header makes every frame offset computable, so
+ *  readers can seek frame-aligned without scanning. SA files shrink
+ *  by roughly 64/ceil(log n) and LCP files far more; no external
+ *  compression library is required.
+ *
+ *  File layout: magic (8 bytes), element width (1 byte), number of
+ *  elements (8 bytes), one packed width per frame (1 byte each),
+ *  then the frame payloads, each a word-aligned sequence of
+ *  fixed-width integers.
+ */
+class frame_compress
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+
+        static const uint64_t magic     = 0x3153464c534453ULL; // "SDSLFS1\0"
+        static const uint64_t frame_len = 4096; // values per frame
+
+        //! Number of 64-bit payload words of a frame.
+        static size_type frame_words(size_type values, uint8_t width)
+        {
+            return (values*width+63)>>6;
+        }
+
+        //! Returns true if `file` starts with the codec magic.
+        static bool is_compressed(const std::string& file)
+        {
+            isfstream in(file, std::ios::binary | std::ios::in);
+            uint64_t m = 0;
+            if (in) {
+                read_member(m, in);
+            }
+            return m == magic;
+        }
+
+        //! Compresses `v` to `out`.
+        /*! \return Number of written bytes.
+         */
+        template<uint8_t t_width>
+        static size_type store(const int_vector<t_width>& v, std::ostream& out)
+        {
+            size_type written_bytes = 0;
+            written_bytes += write_member(static_cast<uint64_t>(magic), out);
+            written_bytes += write_member((uint8_t)v.width(), out);
+            written_bytes += write_member((uint64_t)v.size(), out);
+            size_type frames = (v.size()+frame_len-1)/frame_len;
+            std::vector<uint8_t> fw(frames, 1);
+            for (size_type f=0; f < frames; ++f) {  // pass 1: frame widths
+                uint64_t max_val = 0;
+                size_type end = std::min(v.size(), (f+1)*frame_len);
+                for (size_type i=f*frame_len; i < end; ++i) {
+                    max_val |= v[i];
+                }
+                fw[f] = max_val ? bits::hi(max_val)+1 : 1;
+                written_bytes += write_member(fw[f], out);
+            }
+            std::vector<uint64_t> words(frame_words(frame_len, 64));
+            for (size_type f=0; f < frames; ++f) {  // pass 2: payloads
+                size_type end = std::min(v.size(), (f+1)*frame_len);
+                size_type cnt = end - f*frame_len;
+                size_type wc  = frame_words(cnt, fw[f]);
+                std::fill(words.begin(), words.begin()+wc, 0);
+                uint64_t* word = words.data();
+                uint8_t   offset = 0;
+                for (size_type i=f*frame_len; i < end; ++i) {
+                    bits::write_int_and_move(word, v[i], offset, fw[f]);
+                }
+                out.write(reinterpret_cast<const char*>(words.data()),
+                          static_cast<std::streamsize>(wc<<3));
+                written_bytes += wc<<3;
+            }
+            return written_bytes;
+        }
+
+        //! Decompresses `in` into `v`.
+        template<uint8_t t_width>
+        static void load(std::istream& in, int_vector<t_width>& v)
+        {
+            uint64_t m = 0;
+            uint8_t  width = 0;
+            uint64_t size = 0;
+            read_member(m, in);
+            assert(m == magic);
+            read_member(width, in);
+            read_member(size, in);
+            v.width(width);
+            v.resize(size);
+            size_type frames = (size+frame_len-1)/frame_len;
+            std::vector<uint8_t> fw(frames);
+            in.read(reinterpret_cast<char*>(fw.data()),
+                    static_cast<std::streamsize>(frames));
+            std::vector<uint64_t> words(frame_words(frame_len, 64));
+            for (size_type f=0; f < frames; ++f) {
+                size_type end = std::min((size_type)size, (f+1)*frame_len);
+                size_type cnt = end - f*frame_len;
+                size_type wc  = frame_words(cnt, fw[f]);
+                in.read(reinterpret_cast<char*>(words.data()),
+                        static_cast<std::streamsize>(wc<<3));
+                const uint64_t* word = words.data();
+                uint8_t offset = 0;
+                for (size_type i=f*frame_len; i < end; ++i) {
+                    v[i] = bits::read_int_and_move(word, offset, fw[f]);
+                }
+            }
+        }
+};
+
+//! Read-only random access to a cache file, compressed or plain.
+/*! The buffer decodes one frame at a time, so sequential scans and
+ *  frame-local seeks cost one read plus one unpack per 4096 values.
+ *  A plain int_vector file is handled transparently as the special
+ *  case in which every frame is packed with the element width and the
+ *  width table is implicit, so phases can switch a reader to this
+ *  class without caring whether the producing phase compressed.
+ *
+ *  \tparam t_width Width of the int_vector file, as in int_vector_buffer.
+ */
+template<uint8_t t_width=0>
+class frame_compressed_buffer
+{
+    public:
+        typedef typename int_vector<t_width>::size_type size_type;
+        typedef typename int_vector<t_width>::value_type value_type;
+
+    private:
+        isfstream              m_ifile;
+        std::string            m_filename;
+        uint64_t               m_size  = 0;
+        uint8_t                m_width = t_width ? t_width : 64;
+        std::vector<uint8_t>   m_frame_width;  // packed width per frame
+        std::vector<uint64_t>  m_frame_offset; // byte offset per frame
+        int_vector<t_width>    m_buffer;       // decoded current frame
+        uint64_t               m_begin = 0;    // first element in m_buffer
+        std::vector<uint64_t>  m_words;        // raw frame scratch
+        bool                   m_valid = false; // m_buffer holds a frame
+
+        static const uint64_t frame_len = frame_compress::frame_len;
+
+        void read_frame(uint64_t f)
+        {
+            size_type end = std::min(m_size, (f+1)*frame_len);
+            size_type cnt = end - f*frame_len;
+            size_type wc  = frame_compress::frame_words(cnt, m_frame_width[f]);
+            m_ifile.seekg(static_cast<std::streamoff>(m_frame_offset[f]));
+            m_ifile.read(reinterpret_cast<char*>(m_words.data()),
+                         static_cast<std::streamsize>(wc<<3));
+            const uint64_t* word = m_words.data();
+            uint8_t offset = 0;
+            for (size_type i=0; i < cnt; ++i) {
+                m_buffer[i] = bits::read_int_and_move(word, offset,
+                                                      m_frame_width[f]);
+            }
+            m_begin = f*frame_len;
+            m_valid = true;
+        }
+
+    public:
+        frame_compressed_buffer() {}
+
+        //! Constructor, opens `filename` for reading.
+        explicit frame_compressed_buffer(const std::string& filename)
+            : m_ifile(filename, std::ios::binary | std::ios::in),
+              m_filename(filename)
+        {
+            if (!m_ifile) {
+                throw std::ios_base::failure("frame_compressed_buffer: could not open "
+                                             +filename);
+            }
+            uint64_t first = 0;
+            read_member(first, m_ifile);
+            uint64_t frames = 0;
+            uint64_t data_start = 0;
+            if (frame_compress::magic == first) {
+                read_member(m_width, m_ifile);
+                read_member(m_size, m_ifile);
+                frames = (m_size+frame_len-1)/frame_len;
+                m_frame_width.resize(frames);
+                m_ifile.read(reinterpret_cast<char*>(m_frame_width.data()),
+                             static_cast<std::streamsize>(frames));
+                data_start = 8+1+8+frames;
+            } else {  // plain int_vector file: all frames use the file width
+                if (0 == t_width) {
+                    read_member(m_width, m_ifile);
+                    data_start = 9;
+                } else {
+                    m_width = t_width;
+                    data_start = 8;
+                }
+                m_size = first / m_width;  // header stores the size in bits
+                frames = (m_size+frame_len-1)/frame_len;
+                m_frame_width.assign(frames, m_width);
+            }
+            m_frame_offset.resize(frames);
+            uint64_t offset = data_start;
+            for (uint64_t f=0; f < frames; ++f) {
+                m_frame_offset[f] = offset;
+                size_type end = std::min(m_size, (f+1)*frame_len);
+                offset += frame_compress::frame_words(end-f*frame_len,
+                                                      m_frame_width[f])<<3;
+            }
+            m_buffer.width(m_width);
+            m_buffer.resize(frame_len);
+            m_words.resize(frame_compress::frame_words(frame_len, 64));
+        }
+
+        //! Returns the number of elements.
+        uint64_t size()const
+        {
+            return m_size;
+        }
+
+        //! Returns the element width.
+        uint8_t width()const
+        {
+            return m_width;
+        }
+
+        //! Returns the filename.
+        std::string filename()const
+        {
+            return m_filename;
+        }
+
+        //! Accessing the i-th element; frame-aligned random access.
+        value_type operator[](uint64_t i)
+        {
+            assert(i < m_size);
+            if (!m_valid or i < m_begin or m_begin+frame_len <= i) {
+                read_frame(i/frame_len);
+            }
+            return m_buffer[i-m_begin];
+        }
+
+        //! Closes the file.
+        void close()
+        {
+            m_ifile.close();
+            m_valid = false;
+        }
+};
+
+//! Stores an int_vector as a cache resource, compressed if requested.
+/*! Drop-in counterpart of store_to_cache which honors
+ *  cache_config::compress_cache: with the flag set, the file is
+ *  written in the frame_compress format; otherwise the behavior is
+ *  exactly store_to_cache. Readers using load_from_cache_compressed
+ *  or frame_compressed_buffer handle both layouts transparently.
+ */
+template<uint8_t t_width>
+bool store_to_cache_compressed(const int_vector<t_width>& v, const std::string& key,
+                               cache_config& config)
+{
+    if (!config.compress_cache) {
+        return store_to_cache(v, key, config);
+    }
+    std::string file = cache_file_name(key, config);
+    osfstream out(file, std::ios::binary | std::ios::trunc | std::ios::out);
+    if (!out) {
+        std::cerr << "WARNING: store_to_cache_compressed: could not store file `"
+                  << file << "`" << std::endl;
+        return false;
+    }
+    frame_compress::store(v, out);
+    config.file_map[std::string(key)] = file;
+    return true;
+}
+
+//! Loads an int_vector cache resource, compressed or plain.
+template<uint8_t t_width>
+bool load_from_cache_compressed(int_vector<t_width>& v, const std::string& key,
+                                const cache_config& config)
+{
+    std::string file = cache_file_name(key, config);
+    if (frame_compress::is_compressed(file)) {
+        isfstream in(file, std::ios::binary | std::ios::in);
+        if (!in) {
+            std::cerr << "WARNING: Could not load file '" << file << "'"
+                      << std::endl;
+            return false;
+        }
+        frame_compress::load(in, v);
+        return true;
+    }
+    return load_from_cache(v, key, config);
+}
+
+} // end namespace sdsl
+
+#endif // end file
@@ -0,0 +1,465 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*!\file gap_vector.hpp
+   \brief gap_vector.hpp contains the sdsl::gap_vector class, and
+          classes which support rank and select for gap_vector.
+   \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_GAP_VECTOR
+#define INCLUDED_SDSL_GAP_VECTOR
+
+#include <algorithm>
+#include <cassert>
+
+#include "int_vector.hpp"
+#include "enc_vector.hpp"
+#include "coder.hpp"
+#include "iterators.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+// forward declaration needed for friend declaration
+template<uint8_t t_b      = 1,
+         class t_coder    = coder::elias_delta,
+         uint32_t t_dens  = 128>
+class rank_support_gap;  // in gap_vector
+
+// forward declaration needed for friend declaration
+template<uint8_t t_b      = 1,
+         class t_coder    = coder::elias_delta,
+         uint32_t t_dens  = 128>
+class select_support_gap;  // in gap_vector
+
+//! A gap-compressed bit vector representation.
+/*!
+ * \tparam t_coder Coder for the gaps between consecutive set bits.
+ * \tparam t_dens  Every t_dens-th set bit is stored as an absolute sample.
+ *
+ * The positions of the \f$m\f$ set bits are stored in an
+ * enc_vector<t_coder, t_dens>, i.e. as self-delimiting codes of the gaps
+ * between consecutive set bits plus an absolute position sample every
+ * t_dens bits. For Elias-\f$\delta\f$ coded gaps this takes about
+ * \f$ m(\log\frac{n}{m} + 2\log\log\frac{n}{m}) \f$ bits, which
+ * undercuts sd_vector's \f$ m(\log\frac{n}{m} + 2) \f$ bits for very
+ * sparse vectors (density below about \f$10^{-4}\f$), where the two
+ * overhead bits per element of the sd_vector high part dominate.
+ *
+ * Rank costs a binary search over the samples plus the decoding of one
+ * block (\f$\Order{\log\frac{m}{t\_dens} + t\_dens}\f$), select the
+ * decoding of one block (\f$\Order{t\_dens}\f$). The class is therefore
+ * intended for marker vectors which are queried comparatively rarely,
+ * e.g. the sampled-suffix markers of csa_sampling_strategy or the run
+ * head vectors of wt_rlmn.
+ */
+template<class t_coder   = coder::elias_delta,
+         uint32_t t_dens = 128>
+class gap_vector
+{
+        static_assert(t_dens > 1, "gap_vector: sample density must be larger than `1`");
+    public:
+        typedef bit_vector::size_type                    size_type;
+        typedef size_type                                value_type;
+        typedef bit_vector::difference_type              difference_type;
+        typedef random_access_const_iterator<gap_vector> iterator;
+        typedef iterator                                 const_iterator;
+        typedef bv_tag                                   index_category;
+        typedef enc_vector<t_coder, t_dens>              pos_vector_type;
+
+        typedef rank_support_gap<0, t_coder, t_dens>   rank_0_type;
+        typedef rank_support_gap<1, t_coder, t_dens>   rank_1_type;
+        typedef select_support_gap<0, t_coder, t_dens> select_0_type;
+        typedef select_support_gap<1, t_coder, t_dens> select_1_type;
+
+    private:
+        size_type       m_size = 0;  // length of the original bit vector
+        size_type       m_ones = 0;  // number of set bits
+        pos_vector_type m_pos;       // positions of the set bits
+
+    public:
+        gap_vector() { }
+        gap_vector(const gap_vector&) = default;
+        gap_vector(gap_vector&&) = default;
+        gap_vector& operator=(const gap_vector&) = default;
+        gap_vector& operator=(gap_vector&&) = default;
+
+        //! Constructor taking an uncompressed bit vector.
+        gap_vector(const bit_vector& bv)
+        {
+            m_size = bv.size();
+            m_ones = util::cnt_one_bits(bv);
+            if (0 == m_ones)
+                return;
+            int_vector<> pos(m_ones, 0, bits::hi(m_size)+1);
+            const uint64_t* data = bv.data();
+            size_type idx = 0;
+            for (size_type i=0; i < (m_size+63)/64; ++i) {
+                uint64_t w = data[i];
+                if (i+1 == (m_size+63)/64 and (m_size&0x3F))
+                    w &= bits::lo_set[m_size&0x3F];  // mask bits behind the end
+                while (w) {
+                    pos[idx++] = (i<<6) + bits::lo(w);
+                    w &= w-1;
+                }
+            }
+            m_pos = pos_vector_type(pos);
+        }
+
+        //! Constructor taking a strictly increasing sequence of set positions.
+        /*! \param begin Iterator to the first position.
+         *  \param end   Iterator behind the last position.
+         *  \par The size of the vector is the last position plus 1.
+         */
+        template<class t_itr>
+        gap_vector(t_itr begin, t_itr end)
+        {
+            if (begin == end)
+                return;
+            assert(std::is_sorted(begin, end));
+            m_size = *(end-1) + 1;
+            m_ones = end - begin;
+            m_pos = pos_vector_type(begin, end);
+        }
+
+        //! Accessing the i-th element of the original bit vector.
+        /*! \param i An index i with \f$ 0 \leq i < size() \f$.
+         *  \return The i-th bit of the original bit vector.
+         *  \par Time complexity
+         *       \f$ \Order{\log\frac{m}{t\_dens} + t\_dens} \f$
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < m_size);
+            if (0 == m_ones)
+                return 0;
+            size_type block = block_before(i+1);
+            if (block == blocks())  // all set bits are behind position i
+                return 0;
+            if (m_pos.sample(block) == i)
+                return 1;
+            uint64_t buf[t_dens];
+            m_pos.get_inter_sampled_values(block, buf);
+            size_type base = m_pos.sample(block);
+            size_type len  = block_len(block);
+            for (size_type k=1; k < len; ++k) {
+                if (base + buf[k] >= i)
+                    return base + buf[k] == i;
+            }
+            return 0;
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *  \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, const uint8_t len=64)const
+        {
+            uint64_t res = 0;
+            size_type k = rank_1(idx);
+            while (k < m_ones) {
+                size_type block = k/t_dens;
+                uint64_t buf[t_dens];
+                m_pos.get_inter_sampled_values(block, buf);
+                size_type base = m_pos.sample(block);
+                size_type blen = block_len(block);
+                for (size_type off = k - block*t_dens; off < blen; ++off, ++k) {
+                    size_type p = base + buf[off];
+                    if (p >= idx + len)
+                        return res;
+                    res |= 1ULL << (p - idx);
+                }
+            }
+            return res;
+        }
+
+        //! Number of set bits in the prefix [0..i).
+        /*! \param i An index i with \f$ 0 \leq i \leq size() \f$.
+         */
+        size_type rank_1(size_type i)const
+        {
+            assert(i <= m_size);
+            if (0 == m_ones or 0 == i)
+                return 0;
+            size_type block = block_before(i);
+            if (block == blocks())  // all set bits are at position i or behind
+                return 0;
+            uint64_t buf[t_dens];
+            m_pos.get_inter_sampled_values(block, buf);
+            size_type base = m_pos.sample(block);
+            size_type len  = block_len(block);
+            size_type cnt  = 1;  // the sample position itself is < i
+            while (cnt < len and base + buf[cnt] < i)
+                ++cnt;
+            return block*t_dens + cnt;
+        }
+
+        //! Position of the i-th set bit.
+        /*! \param i An index i with \f$ 1 \leq i \leq ones() \f$.
+         *  \par Time complexity
+         *       \f$ \Order{t\_dens} \f$
+         */
+        size_type select_1(size_type i)const
+        {
+            assert(1 <= i and i <= m_ones);
+            return m_pos[i-1];
+        }
+
+        //! Position of the i-th unset bit.
+        /*! \param i An index i with \f$ 1 \leq i \leq size()-ones() \f$.
+         */
+        size_type select_0(size_type i)const
+        {
+            assert(1 <= i and i <= m_size - m_ones);
+            // binary search the smallest position p with rank_0(p+1) == i;
+            // for the intended ultra-sparse vectors p is close to i-1
+            size_type lo = i-1, hi = std::min(m_size, i + m_ones);
+            while (lo < hi) {
+                size_type mid = lo + (hi-lo)/2;
+                if (mid+1 - rank_1(mid+1) < i)
+                    lo = mid+1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Returns the number of set bits.
+        size_type ones()const
+        {
+            return m_ones;
+        }
+
+        //! Iterator to the first element of the original bit vector.
+        iterator begin()const
+        {
+            return iterator(this, 0);
+        }
+
+        //! Iterator behind the last element of the original bit vector.
+        iterator end()const
+        {
+            return iterator(this, size());
+        }
+
+        void swap(gap_vector& v)
+        {
+            if (this != &v) {
+                std::swap(m_size, v.m_size);
+                std::swap(m_ones, v.m_ones);
+                m_pos.swap(v.m_pos);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_ones, out, child, "ones");
+            written_bytes += m_pos.serialize(out, child, "positions");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            read_member(m_ones, in);
+            m_pos.load(in);
+        }
+
+    private:
+        size_type blocks()const
+        {
+            return (m_ones+t_dens-1)/t_dens;
+        }
+
+        size_type block_len(size_type block)const
+        {
+            return std::min((size_type)t_dens, m_ones - block*t_dens);
+        }
+
+        // Largest block whose sample position is smaller than i;
+        // blocks() is returned when there is none.
+        size_type block_before(size_type i)const
+        {
+            size_type lo = 0, hi = blocks();
+            while (lo < hi) {
+                size_type mid = lo + (hi-lo)/2;
+                if (m_pos.sample(mid) < i)
+                    lo = mid+1;
+                else
+                    hi = mid;
+            }
+            return 0 == lo ? blocks() : lo-1;
+        }
+};
+
+//! Rank data structure for gap_vector.
+/*!
+ * \tparam t_b     The bit pattern of size one. (so `0` or `1`)
+ * \tparam t_coder Coder of the supported gap_vector.
+ * \tparam t_dens  Sample density of the supported gap_vector.
+ */
+template<uint8_t t_b, class t_coder, uint32_t t_dens>
+class rank_support_gap
+{
+        static_assert(t_b == 1u or t_b == 0u , "rank_support_gap: bit pattern must be `0` or `1`");
+    public:
+        typedef bit_vector::size_type       size_type;
+        typedef gap_vector<t_coder, t_dens> bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+    public:
+        explicit rank_support_gap(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type rank(size_type i)const
+        {
+            assert(m_v != nullptr);
+            assert(i <= m_v->size());
+            if (t_b)
+                return m_v->rank_1(i);
+            return i - m_v->rank_1(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return rank(i);
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        rank_support_gap& operator=(const rank_support_gap& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+            }
+            return *this;
+        }
+
+        void swap(rank_support_gap&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+//! Select data structure for gap_vector.
+/*!
+ * \tparam t_b     The bit pattern of size one. (so `0` or `1`)
+ * \tparam t_coder Coder of the supported gap_vector.
+ * \tparam t_dens  Sample density of the supported gap_vector.
+ */
+template<uint8_t t_b, class t_coder, uint32_t t_dens>
+class select_support_gap
+{
+        static_assert(t_b == 1u or t_b == 0u , "select_support_gap: bit pattern must be `0` or `1`");
+    public:
+        typedef bit_vector::size_type       size_type;
+        typedef gap_vector<t_coder, t_dens> bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+    public:
+        explicit select_support_gap(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the position of the i-th occurrence of the bit pattern.
+        size_type select(size_type i)const
+        {
+            assert(m_v != nullptr);
+            if (t_b)
+                return m_v->select_1(i);
+            return m_v->select_0(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return select(i);
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        select_support_gap& operator=(const select_support_gap& ss)
+        {
+            if (this != &ss) {
+                set_vector(ss.m_v);
+            }
+            return *this;
+        }
+
+        void swap(select_support_gap&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+}// end namespace sdsl
+#endif
@@ -824,7 +824,10 @@ class rank_support_hyb
 /*!
  * \tparam t_b            The bit pattern of size one. (so `0` or `1`)
  * \tparam k_sblock_rate  Superblock rate (number of blocks inside superblock)
- * TODO: implement select queries, currently this uses binary search on rank.
+ *
+ * The position of every k_sample_rate-th argument is sampled, so a query
+ * binary-searches on rank only between two adjacent samples instead of over
+ * the whole vector.
  */
 template<uint8_t t_b, uint32_t k_sblock_rate>
 class select_support_hyb
@@ -835,26 +838,79 @@ class select_support_hyb
         enum { bit_pat = t_b };
         enum { bit_pat_len = (uint8_t)1 };
     private:
+        static const size_type k_sample_rate = 4096;
+
         const bit_vector_type *m_v;
         rank_support_hyb<t_b, k_sblock_rate> rank;
+        size_type m_arg_cnt = 0;    // number of arguments in the supported vector
+        int_vector<> m_sample;      // position of every k_sample_rate-th argument
+
+        //! Sample the position of every k_sample_rate-th argument.
+        void init_sample()
+        {
+            m_arg_cnt = 0;
+            m_sample = int_vector<>();
+            if (m_v == nullptr or m_v->size() == 0)
+                return;
+            m_arg_cnt = rank(size());
+            if (m_arg_cnt == 0)
+                return;
+            m_sample = int_vector<>((m_arg_cnt+k_sample_rate-1)/k_sample_rate,
+                                    0, bits::hi(size())+1);
+            const size_type bs = bit_vector_type::k_block_size;
+            size_type s = 0;           // index of the next sample to find
+            size_type prev_rank = 0;
+            for (size_type pos = 0; pos < size() and s < m_sample.size(); pos += bs) {
+                size_type pos_end = std::min(pos + bs, size());
+                size_type r = rank(pos_end);
+                while (s < m_sample.size() and s*k_sample_rate < r) {
+                    // the (s*k_sample_rate+1)-th argument lies in [pos..pos_end)
+                    size_type cnt = prev_rank;
+                    for (size_type j = pos; j < pos_end; ++j) {
+                        if ((*m_v)[j] == (t_b == 1)) {
+                            if (cnt == s*k_sample_rate) {
+                                m_sample[s] = j;
+                                break;
+                            }
+                            ++cnt;
+                        }
+                    }
+                    ++s;
+                }
+                prev_rank = r;
+            }
+        }
 
     public:
         //! Standard constructor
         explicit select_support_hyb(const bit_vector_type* v = nullptr)
         {
             set_vector(v);
+            init_sample();
         }
 
         //! Answers select queries
         size_type select(size_type i) const
         {
             assert(i > 0);
-            if (i > rank(size())) {
+            size_type begin = 0;
+            size_type end = size();
+            if (!m_sample.empty()) { // narrow the search range to two samples
+                if (i > m_arg_cnt) {
+                    return size();
+                }
+                size_type s = (i-1)/k_sample_rate;
+                begin = m_sample[s];
+                if ((i-1)%k_sample_rate == 0) {
+                    return begin;
+                }
+                if (s+1 < m_sample.size()) {
+                    end = m_sample[s+1]+1;
+                }
+            } else if (i > rank(size())) {
                 return size();
             }
             // do binary search
-            size_type begin = 0;
-            size_type end = size();
             size_type idx;
             while (end - begin > 1) {
                 idx = (begin + end) / 2;
@@ -891,6 +947,8 @@ class select_support_hyb
         {
             if (this != &rs) {
                 set_vector(rs.m_v);
+                m_arg_cnt = rs.m_arg_cnt;
+                m_sample = rs.m_sample;
             }
             return *this;
         }
@@ -899,20 +957,27 @@ class select_support_hyb
         void swap(select_support_hyb &other) {
             std::swap(m_v, other.m_v);
             rank.swap(other.rank);
+            std::swap(m_arg_cnt, other.m_arg_cnt);
+            m_sample.swap(other.m_sample);
         }
 
         //! Load the data structure from a stream and set the supported vector
-        void load(std::istream&, const bit_vector_type* v = nullptr)
+        void load(std::istream& in, const bit_vector_type* v = nullptr)
         {
             set_vector(v);
+            read_member(m_arg_cnt, in);
+            m_sample.load(in);
         }
 
         //! Serializes the data structure into a stream
-        size_type serialize(std::ostream&, structure_tree_node* v = nullptr, std::string name = "") const
+        size_type serialize(std::ostream& out, structure_tree_node* v = nullptr, std::string name = "") const
         {
             structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
-            structure_tree::add_size(child, 0);
-            return 0;
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_arg_cnt, out, child, "arg_cnt");
+            written_bytes += m_sample.serialize(out, child, "sample");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
         }
 };
 
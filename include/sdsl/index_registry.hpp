@@ -0,0 +1,177 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file index_registry.hpp
+    \brief index_registry.hpp contains a process-level registry of loaded
+           structures with shared, reference-counted handles.
+    \author Simon Gog
+
+    Services that run several query threads (or several logical
+    services) over the same index file should share one physical copy,
+    and a blue/green deploy should never need two full copies longer
+    than the drain window. The registry keys loaded structures by the
+    hash of the file content plus the structure type: load() returns a
+    std::shared_ptr<const T> handle and deduplicates against all
+    structures that are still alive, so loading the same content twice
+    yields the same physical copy. The registry additionally pins the
+    most recently loaded version per file name; reloading a replaced
+    file atomically swaps that pin, after which the old version lives
+    exactly as long as the handles still draining on it. Loading goes
+    through load_from_file, i.e. the int_vector payloads materialize
+    over the memory-mapped read path.
+*/
+#ifndef INCLUDED_SDSL_INDEX_REGISTRY
+#define INCLUDED_SDSL_INDEX_REGISTRY
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include "io.hpp"
+#include "sfstream.hpp"
+
+namespace sdsl
+{
+
+//! Process-level registry of loaded structures, keyed by file content hash.
+class index_registry
+{
+    private:
+        typedef std::pair<std::type_index, uint64_t> key_type;
+
+        std::mutex m_mutex;
+        // all structures that are still alive somewhere in the process;
+        // weak, so the registry never extends their lifetime by itself
+        std::map<key_type, std::weak_ptr<const void>> m_alive;
+        // the pinned current version per file name: the strong reference
+        // that keeps an index alive between load() and its replacement
+        std::map<std::string, std::pair<key_type, std::shared_ptr<const void>>> m_current;
+
+        static index_registry& the_registry()
+        {
+            static index_registry r;
+            return r;
+        }
+
+        //! FNV-1a hash over the file content.
+        static uint64_t content_hash(const std::string& file)
+        {
+            isfstream in(file, std::ios::binary | std::ios::in);
+            if (!in) {
+                throw std::runtime_error("index_registry: could not open "+file);
+            }
+            uint64_t h = 0xcbf29ce484222325ULL;
+            char buf[1ULL<<16];
+            while (in) {
+                in.read(buf, sizeof(buf));
+                for (std::streamsize i=0; i < in.gcount(); ++i) {
+                    h = (h ^ (uint8_t)buf[i]) * 0x100000001b3ULL;
+                }
+            }
+            return h;
+        }
+    public:
+        //! Loads `file` and returns a shared handle to the structure.
+        /*! \tparam T The structure type stored in the file.
+         *  \param file Name of the serialized structure.
+         *  \return Handle sharing one physical copy with every other
+         *          handle to the same content.
+         *
+         *  If a structure of type T with identical file content is
+         *  already alive in the process the existing copy is returned
+         *  and no loading happens. The loaded version becomes the
+         *  pinned current version of `file`; when the file was replaced
+         *  on disk, calling load() again therefore performs the hot
+         *  reload — the pin swaps to the new copy and the old one is
+         *  freed once the last draining handle is released. Throws
+         *  std::runtime_error if the file cannot be read.
+         */
+        template<class T>
+        static std::shared_ptr<const T> load(const std::string& file)
+        {
+            key_type key(std::type_index(typeid(T)), content_hash(file));
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            std::shared_ptr<const T> handle;
+            auto it = r.m_alive.find(key);
+            if (it != r.m_alive.end()) {
+                handle = std::static_pointer_cast<const T>(it->second.lock());
+            }
+            if (!handle) {
+                std::shared_ptr<T> loaded = std::make_shared<T>();
+                if (!load_from_file(*loaded, file)) {
+                    throw std::runtime_error("index_registry: could not load "+file);
+                }
+                handle = loaded;
+                r.m_alive[key] = std::weak_ptr<const void>(handle);
+            }
+            auto cur = std::make_pair(key,
+                    std::static_pointer_cast<const void>(handle));
+            auto ins = r.m_current.insert(std::make_pair(file, cur));
+            if (!ins.second) { // pin swap of the hot reload
+                ins.first->second = cur;
+            }
+            return handle;
+        }
+
+        //! Returns the pinned current version of `file` without any I/O.
+        /*! \return The handle of the last load() of `file`, or an empty
+         *          handle if `file` was never loaded, was released, or
+         *          was loaded as a different type.
+         */
+        template<class T>
+        static std::shared_ptr<const T> current(const std::string& file)
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            auto it = r.m_current.find(file);
+            if (it == r.m_current.end()
+                or it->second.first.first != std::type_index(typeid(T))) {
+                return std::shared_ptr<const T>();
+            }
+            return std::static_pointer_cast<const T>(it->second.second);
+        }
+
+        //! Drops the pin of `file`; draining handles stay valid.
+        static void release(const std::string& file)
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            r.m_current.erase(file);
+        }
+
+        //! Drops all pins and forgets all dead entries.
+        static void reset()
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            r.m_current.clear();
+            for (auto it = r.m_alive.begin(); it != r.m_alive.end();) {
+                if (it->second.expired()) {
+                    it = r.m_alive.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
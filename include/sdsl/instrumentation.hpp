@@ -0,0 +1,192 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file instrumentation.hpp
+    \brief instrumentation.hpp contains an optional, compile-time enabled
+           histogram layer for observing the internal steps of queries.
+    \author Simon Gog
+
+    Compile with -DSDSL_INSTRUMENTED to activate the layer. Hot paths
+    record samples through the SDSL_RECORD_SAMPLE macro, which expands
+    to nothing in regular builds, so the instrumentation is zero-cost
+    when disabled. Currently instrumented:
+
+      * backward_search_steps: characters matched per backward_search call
+      * csa_locate_walk:       LF steps until a locate query hits a
+                               suffix array sample
+      * wt_pc_rank_depth:      levels descended per wavelet tree rank
+
+    The collected histograms are written with
+    instrumentation::write_report(std::cout).
+*/
+#ifndef INCLUDED_SDSL_INSTRUMENTATION
+#define INCLUDED_SDSL_INSTRUMENTATION
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "bits.hpp"
+
+namespace sdsl
+{
+
+#ifdef SDSL_INSTRUMENTED
+
+//! A lock-free histogram over power-of-two value buckets.
+/*! Bucket 0 counts the value 0 and bucket b>0 the values in
+ *  \f$[2^{b-1}..2^b-1]\f$, so recording is one bits::hi plus one relaxed
+ *  atomic increment and the histogram covers the full 64-bit range in
+ *  65 counters. Percentiles are reported as the upper bound of the
+ *  bucket containing them.
+ */
+class event_histogram
+{
+    private:
+        std::array<std::atomic<uint64_t>, 65> m_bucket;
+    public:
+        event_histogram()
+        {
+            reset();
+        }
+
+        void record(uint64_t value)
+        {
+            uint32_t b = value ? bits::hi(value)+1 : 0;
+            m_bucket[b].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint64_t count() const
+        {
+            uint64_t c = 0;
+            for (const auto& b : m_bucket) {
+                c += b.load(std::memory_order_relaxed);
+            }
+            return c;
+        }
+
+        //! Upper bound of the bucket containing the p-th percentile.
+        uint64_t percentile(double p) const
+        {
+            uint64_t total = count();
+            if (0 == total) {
+                return 0;
+            }
+            uint64_t limit = (uint64_t)((p/100.0)*total + 0.5);
+            if (limit == 0) {
+                limit = 1;
+            }
+            uint64_t c = 0;
+            for (size_t b=0; b < m_bucket.size(); ++b) {
+                c += m_bucket[b].load(std::memory_order_relaxed);
+                if (c >= limit) {
+                    return b ? (1ULL<<b)-1 : 0;
+                }
+            }
+            return bits::all_set;
+        }
+
+        //! Upper bound of the largest recorded value.
+        uint64_t max() const
+        {
+            for (size_t b=m_bucket.size(); b > 0; --b) {
+                if (m_bucket[b-1].load(std::memory_order_relaxed)) {
+                    return (b-1) ? (1ULL<<(b-1))-1 : 0;
+                }
+            }
+            return 0;
+        }
+
+        void reset()
+        {
+            for (auto& b : m_bucket) {
+                b.store(0, std::memory_order_relaxed);
+            }
+        }
+};
+
+//! Registry of the named histograms of the instrumentation layer.
+class instrumentation
+{
+    private:
+        std::mutex m_mutex;
+        std::map<std::string, std::unique_ptr<event_histogram>> m_histograms;
+        static instrumentation& the_registry()
+        {
+            static instrumentation i;
+            return i;
+        }
+    public:
+        //! Returns the histogram registered under `name`.
+        /*! The reference stays valid for the lifetime of the process, so
+         *  call sites cache it in a static local and pay the registry
+         *  lookup only once.
+         */
+        static event_histogram& histogram(const std::string& name)
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            auto it = r.m_histograms.find(name);
+            if (it == r.m_histograms.end()) {
+                it = r.m_histograms.emplace(name,
+                        std::unique_ptr<event_histogram>(new event_histogram())).first;
+            }
+            return *(it->second);
+        }
+
+        //! One line per histogram: count and p50/p90/p99/max bucket bounds.
+        static void write_report(std::ostream& out)
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            for (const auto& h : r.m_histograms) {
+                out << h.first << ": count=" << h.second->count()
+                    << " p50<=" << h.second->percentile(50)
+                    << " p90<=" << h.second->percentile(90)
+                    << " p99<=" << h.second->percentile(99)
+                    << " max<=" << h.second->max() << std::endl;
+            }
+        }
+
+        //! Clears all histograms; the registered names stay.
+        static void reset()
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            for (const auto& h : r.m_histograms) {
+                h.second->reset();
+            }
+        }
+};
+
+#define SDSL_RECORD_SAMPLE(name, value)                                     \
+    do {                                                                    \
+        static sdsl::event_histogram& _sdsl_hist =                          \
+            sdsl::instrumentation::histogram(name);                         \
+        _sdsl_hist.record((uint64_t)(value));                               \
+    } while (0)
+
+#else
+
+#define SDSL_RECORD_SAMPLE(name, value) do { } while (0)
+
+#endif // SDSL_INSTRUMENTED
+
+} // end namespace sdsl
+
+#endif // end file
@@ -317,6 +317,7 @@ class int_vector
         size_type      m_size;  //!< Number of bits needed to store int_vector.
         uint64_t*      m_data;  //!< Pointer to the memory for the bits.
         int_width_type m_width; //!< Width of the integers.
+        bool           m_mapped = false; //!< m_data points into a read-only memory mapping, see map_from_file.
 
     public:
 
@@ -360,6 +361,14 @@ class int_vector
             return 0==m_size;
         }
 
+        //! Returns true if the data is a read-only view into a memory-mapped file.
+        /*! \sa map_from_file
+         */
+        bool is_mapped() const
+        {
+            return m_mapped;
+        }
+
         //! Swap method for int_vector.
         void swap(int_vector& v);
 
@@ -444,6 +453,27 @@ class int_vector
         */
         void set_int(size_type idx, value_type x, const uint8_t len=64);
 
+        //! Extract the n consecutive integers v[idx],...,v[idx+n-1] into out.
+        /*! The bit offset into the raw data is carried from element to
+            element, so a run of fixed-width integers is decoded with one
+            addition per element instead of recomputing word index and
+            shift each time.
+            \param idx Index of the first integer.
+            \param n   Number of integers to extract.
+            \param out Array of length at least n receiving the values.
+            \sa get_int, set_range
+        */
+        void get_range(size_type idx, size_type n, uint64_t* out) const;
+
+        //! Store the n integers in[0],...,in[n-1] at positions idx,...,idx+n-1.
+        /*! Values wider than width() are truncated to the low width() bits.
+            \param idx Index of the first integer to overwrite.
+            \param n   Number of integers to store.
+            \param in  Array of length at least n with the values.
+            \sa set_int, get_range
+        */
+        void set_range(size_type idx, size_type n, const uint64_t* in);
+
         //! Returns the width of the integers which are accessed via the [] operator.
         /*! \returns The width of the integers which are accessed via the [] operator.
             \sa width
@@ -1206,10 +1236,11 @@ inline int_vector<t_width>::int_vector(size_type size, value_type default_value,
 
 template<uint8_t t_width>
 inline int_vector<t_width>::int_vector(int_vector&& v) noexcept :
-    m_size(v.m_size), m_data(v.m_data), m_width(v.m_width)
+    m_size(v.m_size), m_data(v.m_data), m_width(v.m_width), m_mapped(v.m_mapped)
 {
-    v.m_data = nullptr; // ownership of v.m_data now transferred
-    v.m_size = 0;
+    v.m_data   = nullptr; // ownership of v.m_data now transferred
+    v.m_size   = 0;
+    v.m_mapped = false;
 }
 
 template<uint8_t t_width>
@@ -1267,6 +1298,7 @@ void int_vector<t_width>::swap(int_vector& v)
         v.m_size = size;
         v.m_data = data;
         v.width(int_width);
+        std::swap(m_mapped, v.m_mapped);
     }
 }
 
@@ -1304,6 +1336,48 @@ inline void int_vector<t_width>::set_int(size_type idx, value_type x, const uint
     bits::write_int(m_data+(idx>>6), x, idx&0x3F, len);
 }
 
+template<uint8_t t_width>
+inline void int_vector<t_width>::get_range(size_type idx, size_type n, uint64_t* out) const
+{
+#ifdef SDSL_DEBUG
+    if (idx+n > size()) {
+        throw std::out_of_range("OUT_OF_RANGE_ERROR: int_vector::get_range(size_type, size_type, uint64_t*); idx+n > size()!");
+    }
+#endif
+    const uint8_t len = m_width;
+    if (len == 64) { // elements coincide with raw words
+        memcpy(out, m_data+idx, n*sizeof(uint64_t));
+        return;
+    }
+    size_type bit_idx = idx * len;
+    const uint64_t* word = m_data + (bit_idx>>6);
+    uint8_t offset = bit_idx & 0x3F;
+    for (size_type i=0; i < n; ++i) {
+        out[i] = bits::read_int_and_move(word, offset, len);
+    }
+}
+
+template<uint8_t t_width>
+inline void int_vector<t_width>::set_range(size_type idx, size_type n, const uint64_t* in)
+{
+#ifdef SDSL_DEBUG
+    if (idx+n > size()) {
+        throw std::out_of_range("OUT_OF_RANGE_ERROR: int_vector::set_range(size_type, size_type, const uint64_t*); idx+n > size()!");
+    }
+#endif
+    const uint8_t len = m_width;
+    if (len == 64) { // elements coincide with raw words
+        memcpy(m_data+idx, in, n*sizeof(uint64_t));
+        return;
+    }
+    size_type bit_idx = idx * len;
+    uint64_t* word = m_data + (bit_idx>>6);
+    uint8_t offset = bit_idx & 0x3F;
+    for (size_type i=0; i < n; ++i) {
+        bits::write_int_and_move(word, in[i], offset, len);
+    }
+}
+
 template<uint8_t t_width>
 inline auto int_vector<t_width>::operator[](const size_type& idx) -> reference {
     assert(idx < this->size());
@@ -1344,7 +1418,10 @@ inline auto
 int_vector<t_width>::operator[](const size_type& idx)const -> const_reference
 {
     assert(idx < this->size());
-    return get_int(idx * t_width, t_width);
+    // the width is a compile-time constant here, so the masks and shift
+    // amounts of the extraction become immediates
+    size_type i = idx * t_width;
+    return bits::read_int<t_width>(this->m_data + (i>>6), i&0x3F);
 }
 
 template<>
@@ -1534,6 +1611,25 @@ void int_vector<t_width>::load(std::istream& in)
     size_type size = 0;
     int_vector<t_width>::read_header(size, m_width, in);
 
+    // zero-copy path: alias word-aligned payloads of a memory-mapped stream
+    // instead of copying them, see map_from_file
+    if (mmap_istreambuf* buf = dynamic_cast<mmap_istreambuf*>(in.rdbuf())) {
+        uint64_t offset        = buf->offset();
+        uint64_t payload_bytes = ((size + 63) >> 6) << 3;
+        // the extra 8 bytes keep the padding word, which rank structures
+        // access for rank(size()) if size()%64==0, inside the mapped pages
+        if (0 == (offset & 0x7ULL)
+            and offset + payload_bytes + 8 <= buf->readable_size()) {
+            memory_manager::clear(*this);
+            m_size   = size;
+            m_data   = reinterpret_cast<uint64_t*>(buf->base() + offset);
+            m_mapped = true;
+            in.seekg(static_cast<std::streamoff>(offset + payload_bytes),
+                     std::ios_base::beg);
+            return;
+        }
+    }
+
     bit_resize(size);
     uint64_t* p = m_data;
     size_type idx = 0;
@@ -26,7 +26,10 @@
 #include "sfstream.hpp"
 #include "ram_fs.hpp"
 #include <cassert>
+#include <cstring>
 #include <fstream>
+#include <vector>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <stdio.h>
@@ -56,36 +59,115 @@ class int_vector_buffer
         uint64_t            m_buffersize = 8;    // in elements! m_buffersize*width() must be a multiple of 8!
         uint64_t            m_size       = 0;    // size of int_vector_buffer
         uint64_t            m_begin      = 0;    // number in elements
+        // async read-ahead / write-behind state: at most one background
+        // task is in flight and it owns m_shadow exclusively until joined
+        bool                m_async         = false;
+        int_vector<t_width> m_shadow;
+        uint64_t            m_shadow_begin  = 0;
+        bool                m_shadow_is_prefetch = false;
+        std::future<void>   m_io_task;
 
         void throw_error(const std::string &message) const {
             throw std::ios_base::failure("int_vector_buffer " + m_filename + " error: " + message);
         }
 
-        //! Read block containing element at index idx.
-        void read_block(const uint64_t idx)
+        //! Join the background task; rethrows any I/O error it hit.
+        void wait_io()
         {
-            m_begin = (idx/m_buffersize)*m_buffersize;
-            if (m_begin >= m_size) {
-                util::set_to_value(m_buffer, 0);
+            if (m_io_task.valid()) {
+                m_io_task.get();
+            }
+        }
+
+        //! Fill buf with the block starting at element begin, reading via in.
+        void fill_buffer(int_vector<t_width>& buf, const uint64_t begin, const uint64_t size, sdsl::isfstream& in) const
+        {
+            if (begin >= size) {
+                util::set_to_value(buf, 0);
             } else {
-                std::streampos pos = m_offset+static_cast<std::streampos>(m_begin*width()/8);
-                m_ifile->seekg(pos);
-                if (!m_ifile->good())
+                std::streampos pos = m_offset+static_cast<std::streampos>(begin*width()/8);
+                in.seekg(pos);
+                if (!in.good())
                     throw_error("seekg error");
-                if (m_size-m_begin<m_buffersize)
-                    util::set_to_value(m_buffer, 0);
-                uint64_t wb = std::min(m_buffersize*width(), (m_size-m_begin)*width()+7)/8;
-                m_ifile->read(reinterpret_cast<char*>(m_buffer.data()), wb);
-                if (!m_ifile->good())
+                if (size-begin<m_buffersize)
+                    util::set_to_value(buf, 0);
+                uint64_t wb = std::min(m_buffersize*width(), (size-begin)*width()+7)/8;
+                in.read(reinterpret_cast<char*>(buf.data()), wb);
+                if (!in.good())
                     throw_error("read block error");
             }
         }
 
+        //! Start filling m_shadow with the block starting at element begin.
+        void schedule_prefetch(const uint64_t begin)
+        {
+            if (begin >= m_size) {
+                return;
+            }
+            m_shadow.width(width());
+            m_shadow.resize(m_buffersize);
+            m_shadow_begin = begin;
+            m_shadow_is_prefetch = true;
+            uint64_t size = m_size;
+            m_io_task = std::async(std::launch::async, [this, begin, size]() {
+                sdsl::isfstream in(m_filename, std::ios::in|std::ios::binary);
+                if (!in.good())
+                    throw_error("prefetch open error");
+                fill_buffer(m_shadow, begin, size, in);
+            });
+        }
+
+        //! Read block containing element at index idx.
+        void read_block(const uint64_t idx)
+        {
+            m_begin = (idx/m_buffersize)*m_buffersize;
+            if (m_async) {
+                wait_io();
+                if (m_shadow_is_prefetch and m_shadow_begin == m_begin) {
+                    m_buffer.swap(m_shadow); // block already read ahead
+                } else {
+                    fill_buffer(m_buffer, m_begin, m_size, *m_ifile);
+                }
+                m_shadow_is_prefetch = false;
+                schedule_prefetch(m_begin+m_buffersize);
+                return;
+            }
+            fill_buffer(m_buffer, m_begin, m_size, *m_ifile);
+        }
+
         //! Write current block to file.
         void write_block()
         {
             if (m_need_to_write) {
                 assert(m_ofile->is_open());
+                if (m_async) {
+                    // hand the dirty block to a background task; the next
+                    // read_block/write_block joins it before touching the file
+                    wait_io();
+                    m_shadow.width(width());
+                    m_shadow.resize(m_buffersize);
+                    m_shadow.swap(m_buffer);
+                    m_shadow_is_prefetch = false;
+                    uint64_t begin = m_begin;
+                    uint64_t wb = std::min(m_buffersize*width(), (m_size-m_begin)*width()+7)/8;
+                    m_need_to_write = false;
+                    m_io_task = std::async(std::launch::async, [this, begin, wb]() {
+                        sdsl::osfstream out(m_filename, std::ios::in|std::ios::out|std::ios::binary);
+                        if (!out.good())
+                            throw_error("write-behind open error");
+                        std::streampos pos = m_offset+static_cast<std::streampos>(begin*width()/8);
+                        out.seekp(pos);
+                        if (!out.good())
+                            throw_error("seekp error");
+                        out.write(reinterpret_cast<const char*>(m_shadow.data()), wb);
+                        if (!out.good())
+                            throw_error("write block error");
+                        out.flush();
+                        if (!out.good())
+                            throw_error("flush block error");
+                    });
+                    return;
+                }
                 std::streampos pos = m_offset+static_cast<std::streampos>(m_begin*width()/8);
                 m_ofile->seekp(pos);
                 if (!m_ofile->good())
@@ -248,6 +330,35 @@ class int_vector_buffer
             return (m_buffersize*width())/8;
         }
 
+        //! Returns true if the file is interpreted as a plain array, i.e. has no int_vector header.
+        bool is_plain() const
+        {
+            return m_offset == m_start;
+        }
+
+        //! Returns the offset in bytes at which the data of the buffer starts in the file.
+        uint64_t file_offset() const
+        {
+            return static_cast<uint64_t>(m_start);
+        }
+
+        //! Enable or disable asynchronous read-ahead and write-behind.
+        /*! While enabled, crossing a buffer boundary during a sequential
+         *  scan hands the read of the next block and the flush of a dirty
+         *  block to a background task, so the calling thread no longer
+         *  stalls on disk latency at every boundary. Access semantics are
+         *  unchanged; non-sequential jumps simply fall back to a
+         *  synchronous read.
+         */
+        void async_io(bool enable=true)
+        {
+            if (!enable) {
+                wait_io();
+                m_shadow_is_prefetch = false;
+            }
+            m_async = enable;
+        }
+
         //! Returns whether state of underlying streams are good
         bool good() const
         {
@@ -265,6 +376,7 @@ class int_vector_buffer
         {
             assert(m_ofile->is_open());
             write_block();
+            wait_io();
             if (m_start < m_offset) { // in case of int_vector, write header and trailing zeros
                 uint64_t size = m_size*width();
                 m_ofile->seekp(m_start);
@@ -283,6 +395,8 @@ class int_vector_buffer
         //! Delete all content and set size to 0
         void reset()
         {
+            wait_io();
+            m_shadow_is_prefetch = false;
             // reset file
             assert(m_ifile->good());
             assert(m_ofile->good());
@@ -321,12 +435,62 @@ class int_vector_buffer
             write(m_size, value);
         }
 
+        //! Appends `n` values to the end of the int_vector_buffer.
+        /*! \param vals Pointer to the values; each value is truncated to
+         *              width() bits, like in push_back.
+         *  \param n    Number of values to append.
+         *
+         *  Bulk counterpart of push_back: values are written directly into
+         *  the in-memory buffer with one boundary check per block instead
+         *  of per element, and width-64 buffers take a raw word copy.
+         */
+        void append(const uint64_t* vals, uint64_t n)
+        {
+            assert(is_open());
+            if (0 == n) {
+                return;
+            }
+            uint64_t idx = m_size;
+            if (idx < m_begin or m_begin+m_buffersize <= idx) {
+                write_block();
+                read_block(idx);
+            }
+            while (n > 0) {
+                if (m_begin+m_buffersize <= idx) { // tail block is full
+                    write_block();
+                    read_block(idx);
+                }
+                uint64_t chunk = std::min(n, m_begin+m_buffersize-idx);
+                m_size = idx+chunk;
+                m_need_to_write = true;
+                uint64_t off = idx-m_begin;
+                if (64 == width()) { // raw word copy
+                    memcpy(m_buffer.data()+off, vals, chunk*8);
+                } else {
+                    for (uint64_t i=0; i < chunk; ++i) {
+                        m_buffer[off+i] = vals[i];
+                    }
+                }
+                vals += chunk;
+                idx  += chunk;
+                n    -= chunk;
+            }
+        }
+
+        //! Appends all values of `vec` to the end of the int_vector_buffer.
+        void append(const std::vector<uint64_t>& vec)
+        {
+            append(vec.data(), vec.size());
+        }
+
         //! Close the int_vector_buffer.
         /*! It is not possible to read from / write into the int_vector_buffer after calling this method
          *  \param remove_file If true, the underlying file will be removed on closing.
          */
         void close(bool remove_file=false)
         {
+            wait_io();
+            m_shadow_is_prefetch = false;
             if (is_open()) {
                 if (m_ofile->is_open()) {
                     if (!remove_file)
@@ -365,6 +529,14 @@ class int_vector_buffer
         void swap(int_vector_buffer<t_width>& ivb)
         {
             if (this != &ivb) {
+                // background tasks hold a pointer to their object, so both
+                // have to be idle before the members move
+                wait_io();
+                ivb.wait_io();
+                std::swap(m_async, ivb.m_async);
+                std::swap(m_shadow, ivb.m_shadow);
+                std::swap(m_shadow_begin, ivb.m_shadow_begin);
+                std::swap(m_shadow_is_prefetch, ivb.m_shadow_is_prefetch);
                 std::swap(m_ifile, ivb.m_ifile);
                 std::swap(m_ofile, ivb.m_ofile);
                 std::swap(m_start, ivb.m_start);
@@ -6,10 +6,31 @@
 
 #include <cstdio>
 #include <ios>
+#include <limits>
 
 namespace sdsl
 {
 
+//! Mapping options for int_vector_mapper.
+/*! Collects the access-pattern hints which are applied when the file is
+ *  mapped (and re-applied after every remapping, e.g. on bit_resize).
+ */
+struct mapper_options {
+    enum advice_type {
+        advice_normal,     //!< no access-pattern hint
+        advice_sequential, //!< MADV_SEQUENTIAL: aggressive read-ahead, early eviction
+        advice_random,     //!< MADV_RANDOM: no read-ahead
+        advice_willneed    //!< MADV_WILLNEED: start asynchronous read-ahead of all pages
+    };
+    advice_type advice = advice_normal;
+    //! Eagerly fault in all pages at mmap time (MAP_POPULATE), avoiding
+    //! minutes of random 4k faults on cold starts.
+    bool populate = false;
+    //! Back the mapping with transparent huge pages (MADV_HUGEPAGE),
+    //! reducing TLB pressure for large mapped vectors.
+    bool hugepage = false;
+};
+
 template <uint8_t t_width = 0,std::ios_base::openmode t_mode = std::ios_base::out|std::ios_base::in>
 class int_vector_mapper
 {
@@ -30,6 +51,26 @@ class int_vector_mapper
         int_vector<t_width> m_wrapper;
         std::string m_file_name;
         bool m_delete_on_close;
+        mapper_options m_options;
+
+        // apply the madvise-based options; called after every (re)mapping
+        void apply_options() const
+        {
+#ifndef MSVC_COMPILER
+            if (nullptr == m_mapped_data) {
+                return;
+            }
+            switch (m_options.advice) {
+                case mapper_options::advice_sequential: advise_sequential(); break;
+                case mapper_options::advice_random:     advise_random();     break;
+                case mapper_options::advice_willneed:   advise_willneed();   break;
+                case mapper_options::advice_normal:     break;
+            }
+            if (m_options.hugepage) {
+                advise_hugepage();
+            }
+#endif
+        }
     public:
         int_vector_mapper() = delete;
         int_vector_mapper(const int_vector_mapper&) = delete;
@@ -110,6 +151,7 @@ class int_vector_mapper
             m_fd = ivm.m_fd;
             m_file_name = ivm.m_file_name;
             m_delete_on_close = ivm.m_delete_on_close;
+            m_options = ivm.m_options;
             ivm.m_wrapper.m_data = nullptr;
             ivm.m_wrapper.m_size = 0;
             ivm.m_mapped_data = nullptr;
@@ -124,7 +166,19 @@ class int_vector_mapper
         int_vector_mapper(const std::string filename,
                           bool is_plain = false,
                           bool delete_on_close = false) :
-            m_file_name(filename), m_delete_on_close(delete_on_close)
+            int_vector_mapper(filename, is_plain, delete_on_close, mapper_options()) {}
+
+        //! Constructor with explicit mapping options.
+        /*! \param filename        Name of the file to map.
+         *  \param is_plain        True if the file has no int_vector header.
+         *  \param delete_on_close Remove the file in the destructor.
+         *  \param options         Access-pattern hints, see mapper_options.
+         */
+        int_vector_mapper(const std::string filename,
+                          bool is_plain,
+                          bool delete_on_close,
+                          const mapper_options& options) :
+            m_file_name(filename), m_delete_on_close(delete_on_close), m_options(options)
         {
             size_type size_in_bits = 0;
             uint8_t int_width = t_width;
@@ -170,7 +224,7 @@ class int_vector_mapper
             // prepare for mmap
             m_wrapper.width(int_width);
             // mmap data
-            m_mapped_data = (uint8_t*)memory_manager::mmap_file(m_fd,m_file_size_bytes,t_mode);
+            m_mapped_data = (uint8_t*)memory_manager::mmap_file(m_fd,m_file_size_bytes,t_mode,m_options.populate);
             if (m_mapped_data == nullptr) {
                 std::string mmap_error
                     = std::string("int_vector_mapper: mmap error. ")
@@ -180,9 +234,85 @@ class int_vector_mapper
 
             m_wrapper.m_size = size_in_bits;
             m_wrapper.m_data = (uint64_t*)(m_mapped_data + m_data_offset);
-
+            apply_options();
         }
 
+        //! Advise the kernel that the mapped file will be read sequentially.
+        /*! Enables aggressive read-ahead and early eviction of pages already
+         *  streamed over, so a single pass keeps the RSS low. No effect on
+         *  systems without madvise.
+         */
+        void advise_sequential() const
+        {
+#ifndef MSVC_COMPILER
+            if (m_mapped_data) {
+                madvise(m_mapped_data, m_file_size_bytes, MADV_SEQUENTIAL);
+            }
+#endif
+        }
+        //! Advise the kernel that the mapped file will be accessed randomly.
+        void advise_random() const
+        {
+#ifndef MSVC_COMPILER
+            if (m_mapped_data) {
+                madvise(m_mapped_data, m_file_size_bytes, MADV_RANDOM);
+            }
+#endif
+        }
+        //! Advise the kernel that the whole mapped file will be needed soon.
+        /*! Starts asynchronous read-ahead of all pages without blocking.
+         */
+        void advise_willneed() const
+        {
+#ifndef MSVC_COMPILER
+            if (m_mapped_data) {
+                madvise(m_mapped_data, m_file_size_bytes, MADV_WILLNEED);
+            }
+#endif
+        }
+        //! Ask the kernel to back the mapping with transparent huge pages.
+        /*! Reduces TLB pressure for large mapped vectors. A hint only; the
+         *  kernel decides, and systems without MADV_HUGEPAGE ignore it.
+         */
+        void advise_hugepage() const
+        {
+#if !defined(MSVC_COMPILER) && defined(MADV_HUGEPAGE)
+            if (m_mapped_data) {
+                madvise(m_mapped_data, m_file_size_bytes, MADV_HUGEPAGE);
+            }
+#endif
+        }
+        //! Fault in the pages which back the elements [begin_idx, end_idx).
+        /*! \param begin_idx First element of the range.
+         *  \param end_idx   One past the last element; values past size()
+         *                   are clamped. Default is the whole vector.
+         *
+         *  Touches one byte per page synchronously, so a known-hot range is
+         *  resident before query traffic arrives; a full populate at mmap
+         *  time is available via mapper_options::populate.
+         */
+        void prefault(size_type begin_idx=0, size_type end_idx=std::numeric_limits<size_type>::max()) const
+        {
+            if (nullptr == m_mapped_data or 0 == size()) {
+                return;
+            }
+            if (end_idx > size()) {
+                end_idx = size();
+            }
+            if (begin_idx >= end_idx) {
+                return;
+            }
+            const size_type page = 4096;
+            size_type begin_byte = m_data_offset + (begin_idx * width()) / 8;
+            size_type end_byte = std::min(m_file_size_bytes,
+                                          m_data_offset + (end_idx * width() + 7) / 8);
+            volatile uint8_t sink = 0;
+            for (size_type b = begin_byte; b < end_byte; b += page) {
+                sink += m_mapped_data[b];
+            }
+            sink += m_mapped_data[end_byte - 1];
+            (void)sink;
+        }
         std::string file_name() const { return m_file_name; }
         width_type width() const { return m_wrapper.width(); }
         void width(const uint8_t new_int_width)
@@ -216,13 +346,14 @@ class int_vector_mapper
                 m_file_size_bytes = new_size_in_bytes + m_data_offset;
 
                 // perform the actual mapping
-                m_mapped_data = (uint8_t*)memory_manager::mmap_file(m_fd,m_file_size_bytes, t_mode);
+                m_mapped_data = (uint8_t*)memory_manager::mmap_file(m_fd,m_file_size_bytes, t_mode,m_options.populate);
                 if (m_mapped_data == nullptr) {
                     std::string mmap_error
                         = std::string("int_vector_mapper: mmap error. ")
                           + std::string(util::str_from_errno());
                     throw std::runtime_error(mmap_error);
                 }
+                apply_options();
 
                 // update wrapper
                 m_wrapper.m_data = (uint64_t*)(m_mapped_data + m_data_offset);
@@ -402,6 +533,126 @@ class write_out_buffer
         }
 };
 
+//! Read-only buffer which streams a file through a sliding mmap window.
+/*! Drop-in replacement for a read-only int_vector_buffer in streaming
+ *  phases: the file is mapped once with int_vector_mapper and the
+ *  elements are read in place, so nothing is ever copied into an
+ *  internal buffer. A sliding window of madvise hints keeps the
+ *  resident set bounded anyway: when an access enters a new window,
+ *  the window ahead is prefetched with MADV_WILLNEED and the window
+ *  behind is dropped with MADV_DONTNEED. Random jumps are correct but
+ *  re-fault their pages; the class is tuned for (mostly) sequential
+ *  scans like the SA passes of construct_lcp_semi_extern_PHI. On
+ *  systems without madvise the hints are no-ops and the class degrades
+ *  to a plain read-only mapping.
+ *
+ *  \tparam t_width Width of the int_vector file, as in int_vector_buffer.
+ */
+template<uint8_t t_width = 0>
+class int_vector_window_buffer
+{
+    public:
+        typedef typename int_vector<t_width>::size_type size_type;
+        typedef typename int_vector<t_width>::value_type value_type;
+
+    private:
+        int_vector_mapper<t_width,std::ios_base::in> m_mapper;
+        std::string m_file_name;
+        size_type m_window_bytes;
+        size_type m_cur_window = std::numeric_limits<size_type>::max();
+
+        // apply `advice` to the pages backing window w; for MADV_DONTNEED
+        // the range is shrunk to page boundaries so that a page shared
+        // with the current window is never dropped
+        void advise_window(size_type w, int advice)const
+        {
+#ifndef MSVC_COMPILER
+            static const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+            size_type data_bytes = (m_mapper.bit_size()+7)>>3;
+            size_type begin = w*m_window_bytes;
+            if (begin >= data_bytes) {
+                return;
+            }
+            size_type end = std::min(begin+m_window_bytes, data_bytes);
+            const uint8_t* base = reinterpret_cast<const uint8_t*>(m_mapper.data());
+            uintptr_t a = reinterpret_cast<uintptr_t>(base+begin) & ~(page-1);
+            uintptr_t b = reinterpret_cast<uintptr_t>(base+end);
+            if (MADV_DONTNEED == advice) {
+                b &= ~(page-1);
+            }
+            if (b > a) {
+                madvise(reinterpret_cast<void*>(a), b-a, advice);
+            }
+#else
+            (void)w;
+            (void)advice;
+#endif
+        }
+
+        void slide_to(size_type w)
+        {
+#ifndef MSVC_COMPILER
+            advise_window(w, MADV_WILLNEED);    // read-ahead of the window
+            advise_window(w+1, MADV_WILLNEED);  // and of the one after it
+            if (w > 0) {
+                advise_window(w-1, MADV_DONTNEED);  // drop the streamed-over one
+            }
+#endif
+            m_cur_window = w;
+        }
+
+    public:
+        int_vector_window_buffer() = delete;
+        int_vector_window_buffer(const int_vector_window_buffer&) = delete;
+        int_vector_window_buffer& operator=(const int_vector_window_buffer&) = delete;
+
+        //! Constructor, maps `filename` for windowed reading.
+        /*! \param filename     Name of the int_vector file to stream.
+         *  \param window_bytes Size of the sliding window; the resident
+         *                      set stays around two windows in a
+         *                      sequential scan.
+         *  \param is_plain     True if the file has no int_vector header,
+         *                      as in int_vector_mapper.
+         */
+        explicit int_vector_window_buffer(const std::string& filename,
+                                          size_type window_bytes = (1ULL<<24),
+                                          bool is_plain = false)
+            : m_mapper(filename, is_plain, false),
+              m_file_name(filename),
+              m_window_bytes(window_bytes ? window_bytes : (1ULL<<24))
+        {}
+
+        //! Returns the number of elements.
+        size_type size()const
+        {
+            return m_mapper.size();
+        }
+
+        //! Returns the element width.
+        uint8_t width()const
+        {
+            return m_mapper.width();
+        }
+
+        //! Returns the filename.
+        std::string filename()const
+        {
+            return m_file_name;
+        }
+
+        //! Accessing the i-th element, read directly from the mapping.
+        value_type operator[](size_type i)
+        {
+            assert(i < size());
+            size_type w = ((i*width())>>3) / m_window_bytes;
+            if (w != m_cur_window) {
+                slide_to(w);
+            }
+            const auto& mapper = m_mapper;  // select the read-only accessor
+            return mapper[i];
+        }
+};
+
 template<std::ios_base::openmode t_mode = std::ios_base::out|std::ios_base::in>
 using bit_vector_mapper = int_vector_mapper<1,t_mode>;
 
@@ -146,6 +146,79 @@ class inv_perm_support
             return j;
         }
 
+        //! Batched access to the inverse permutation.
+        /*! \param ids Array of n indices of the inverse permutation.
+         *  \param n   Number of queries.
+         *  \param out Array of size n; out[q] is set to the value of
+         *             the inverse permutation at ids[q].
+         *
+         *  Each single query walks its permutation cycle to the next
+         *  back-pointer sample -- a chain of dependent cache misses.
+         *  Here up to 16 cycle walks are advanced round-robin and the
+         *  permutation word of the next step of every walk is
+         *  software-prefetched, so the miss latencies of independent
+         *  queries overlap instead of serializing.
+         */
+        void inverse_batch(const size_type* ids, size_type n,
+                           value_type* out) const {
+            const size_type lanes = 16;
+            struct lane_t {
+                size_type i;   // queried index
+                size_type j;   // current position on the cycle
+                size_type q;   // index into ids/out
+                bool jumped;   // back pointer already taken
+            };
+            lane_t lane[lanes];
+            size_type active = 0, next_q = 0;
+            auto start = [&](lane_t& s) {
+                s.i = ids[next_q];
+                s.j = s.i;
+                s.q = next_q;
+                s.jumped = false;
+                ++next_q;
+                bits::prefetch(m_v->data() + ((s.j * m_v->width())>>6));
+            };
+            while (active < lanes and next_q < n) {
+                start(lane[active++]);
+            }
+            while (active > 0) {
+                for (size_type l = 0; l < active;) {
+                    lane_t& s = lane[l];
+                    size_type j_new = (*m_v)[s.j];
+                    if (j_new == s.i) { // cycle walk finished
+                        out[s.q] = s.j;
+                        if (next_q < n) {
+                            start(s);
+                            ++l;
+                        } else {
+                            s = lane[--active];
+                        }
+                        continue;
+                    }
+                    if (!s.jumped and m_marked[s.j]) {
+                        s.j = m_back_pointer[m_rank_marked(s.j)];
+                        s.jumped = true;
+                    } else {
+                        s.j = j_new;
+                    }
+                    bits::prefetch(m_v->data() + ((s.j * m_v->width())>>6));
+                    ++l;
+                }
+            }
+        }
+
+        //! Batched access to the inverse permutation.
+        /*! \param ids Indices of the inverse permutation.
+         *  \return res[q] is the value of the inverse permutation at
+         *          ids[q].
+         */
+        std::vector<value_type>
+        inverse_batch(const std::vector<size_type>& ids) const {
+            std::vector<value_type> res(ids.size());
+            inverse_batch(ids.data(), ids.size(), res.data());
+            return res;
+        }
+
         size_type size() const {
             return nullptr == m_v ? 0 : m_v->size();
         }
@@ -78,6 +78,8 @@ class k2_treap
         t_bv                      m_bp;
         t_rank                    m_bp_rank;
         t_max_vec                 m_maxval;
+        t_max_vec                 m_cnt;
+        t_max_vec                 m_sum;
         std::vector<int_vector<>> m_coord;
         int_vector<64>            m_level_idx;
 
@@ -125,6 +127,8 @@ class k2_treap
                 m_bp_rank = std::move(tr.m_bp_rank);
                 m_bp_rank.set_vector(&m_bp);
                 m_maxval = std::move(tr.m_maxval);
+                m_cnt = std::move(tr.m_cnt);
+                m_sum = std::move(tr.m_sum);
                 m_coord = std::move(tr.m_coord);
                 m_level_idx = std::move(tr.m_level_idx);
             }
@@ -140,6 +144,8 @@ class k2_treap
                 m_bp_rank = tr.m_bp_rank;
                 m_bp_rank.set_vector(&m_bp);
                 m_maxval = tr.m_maxval;
+                m_cnt = tr.m_cnt;
+                m_sum = tr.m_sum;
                 m_coord = tr.m_coord;
                 m_level_idx = tr.m_level_idx;
             }
@@ -161,6 +167,8 @@ class k2_treap
                 m_bp.swap(tr.m_bp);
                 util::swap_support(m_bp_rank, tr.m_bp_rank, &m_bp, &(tr.m_bp));
                 m_maxval.swap(tr.m_maxval);
+                m_cnt.swap(tr.m_cnt);
+                m_sum.swap(tr.m_sum);
                 m_coord.swap(tr.m_coord);
                 m_level_idx.swap(tr.m_level_idx);
             }
@@ -253,10 +261,16 @@ class k2_treap
                                     + id_part + ".sdsl";
             std::string bp_file  = temp_file_prefix + "_bp_" + id_part
                                    + ".sdsl";
+            std::string cnt_file = temp_file_prefix + "_cnt_" + id_part
+                                   + ".sdsl";
+            std::string sum_file = temp_file_prefix + "_sum_" + id_part
+                                   + ".sdsl";
 
             {
                 int_vector_buffer<> val_buf(val_file, std::ios::out);
                 int_vector_buffer<1> bp_buf(bp_file, std::ios::out);
+                int_vector_buffer<> cnt_buf(cnt_file, std::ios::out);
+                int_vector_buffer<> sum_buf(sum_file, std::ios::out);
 
                 auto end = std::end(v);
                 uint64_t last_level_nodes = 1;
@@ -292,6 +306,15 @@ class k2_treap
                         }
 
                         val_buf.push_back(std::get<2>(*max_it));
+                        // the group holds exactly the points of the node's
+                        // submatrix which were not picked at higher levels,
+                        // i.e. the cardinality of the subtree rooted here
+                        cnt_buf.push_back(ep - sp);
+                        uint64_t w_sum = 0;
+                        for (auto wit = sp; wit != ep; ++wit) {
+                            w_sum += std::get<2>(*wit);
+                        }
+                        sum_buf.push_back(w_sum);
                         *max_it = MM;
                         --ep;
                         std::swap(*max_it, *ep);
@@ -352,6 +375,14 @@ class k2_treap
                 int_vector_buffer<> val_r(val_file);
                 m_maxval = t_max_vec(val_r);
             }
+            {
+                int_vector_buffer<> cnt_r(cnt_file);
+                m_cnt = t_max_vec(cnt_r);
+            }
+            {
+                int_vector_buffer<> sum_r(sum_file);
+                m_sum = t_max_vec(sum_r);
+            }
             {
                 bit_vector _bp;
                 _bp.swap(bp);
@@ -360,6 +391,8 @@ class k2_treap
             util::init_support(m_bp_rank, &m_bp);
             sdsl::remove(bp_file);
             sdsl::remove(val_file);
+            sdsl::remove(cnt_file);
+            sdsl::remove(sum_file);
         }
 
 
@@ -375,6 +408,8 @@ class k2_treap
             written_bytes += m_bp_rank.serialize(out, child, "bp_rank");
             written_bytes += serialize_vector(m_coord, out, child, "coord");
             written_bytes += m_maxval.serialize(out, child, "maxval");
+            written_bytes += m_cnt.serialize(out, child, "cnt");
+            written_bytes += m_sum.serialize(out, child, "sum");
             written_bytes += m_level_idx.serialize(out, child, "level_idx");
             structure_tree::add_size(child, written_bytes);
             return written_bytes;
@@ -390,6 +425,8 @@ class k2_treap
             m_coord.resize(t);
             load_vector(m_coord, in);
             m_maxval.load(in);
+            m_cnt.load(in);
+            m_sum.load(in);
             m_level_idx.load(in);
         }
 
@@ -406,6 +443,20 @@ class k2_treap
             return v.idx >= m_bp.size();
         }
 
+        //! Number of points in the subtree rooted at node v (including v)
+        size_type
+        subtree_count(const node_type& v) const
+        {
+            return m_cnt[v.idx/(t_k*t_k)];
+        }
+
+        //! Sum of the weights in the subtree rooted at node v (including v)
+        uint64_t
+        subtree_sum(const node_type& v) const
+        {
+            return m_sum[v.idx/(t_k*t_k)];
+        }
+
         std::vector<node_type>
         children(const node_type& v) const
         {
@@ -33,6 +33,9 @@
 #include <complex>
 #include <queue>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -282,6 +285,245 @@ top_k(const t_k2_treap& t,
 }
 
 
+//! Get the k heaviest points in rectangle (p1,p2), expanding in parallel
+/*! \param treap k2-treap
+ *  \param p1    Lower left corner of the rectangle
+ *  \param p2    Upper right corner of the rectangle
+ *  \param k     Number of points to report.
+ *  \param num_threads Number of worker threads; values <= 1 expand
+ *                     sequentially.
+ *  \return The up to k heaviest points in the rectangle, in decreasing
+ *          order of weight.
+ *  \pre real(p1) <= real(p2) and imag(p1)<=imag(p2)
+ *
+ *  The workers share a priority frontier of navigation states and a
+ *  candidate heap of the k heaviest points seen so far; a subtree whose
+ *  maximum is not heavier than the current k-th candidate is pruned, so
+ *  the threshold established by one worker terminates the others early.
+ *  The result is exact for any expansion order.
+ */
+template<typename t_k2_treap>
+std::vector<std::pair<k2_treap_ns::point_type, uint64_t>>
+top_k_parallel(const t_k2_treap& treap,
+               k2_treap_ns::point_type p1,
+               k2_treap_ns::point_type p2,
+               uint64_t k,
+               uint32_t num_threads = std::thread::hardware_concurrency())
+{
+    using namespace k2_treap_ns;
+    typedef std::pair<point_type, uint64_t> t_point_val;
+    typedef std::pair<node_type, bool> t_nt_b;
+    std::vector<t_point_val> res;
+    if (0 == k or treap.size() == 0)
+        return res;
+
+    // the k heaviest points seen so far; the lightest on top
+    auto cand_gt = [](const t_point_val& a, const t_point_val& b) {
+        return a.second > b.second;
+    };
+    std::priority_queue<t_point_val, std::vector<t_point_val>,
+        decltype(cand_gt)> cand(cand_gt);
+    std::mutex cand_mutex;
+    // weight of the k-th heaviest candidate; meaningful once full
+    std::atomic<uint64_t> threshold(0);
+    std::atomic<bool> full(false);
+
+    std::priority_queue<t_nt_b> frontier;
+    std::mutex frontier_mutex;
+    // states in the frontier or currently being expanded
+    std::atomic<uint64_t> pending(1);
+    frontier.emplace(treap.root(), false);
+
+    auto add_candidate = [&](const point_type& p, uint64_t w) {
+        std::lock_guard<std::mutex> lock(cand_mutex);
+        if (cand.size() < k) {
+            cand.emplace(p, w);
+            if (cand.size() == k) {
+                threshold = cand.top().second;
+                full = true;
+            }
+        } else if (w > cand.top().second) {
+            cand.pop();
+            cand.emplace(p, w);
+            threshold = cand.top().second;
+        }
+    };
+
+    auto expand = [&](const node_type& v, bool is_contained) {
+        if (!is_contained) {
+            if (contained<t_k2_treap::k>(p1, p2, v)) {
+                is_contained = true;
+            } else if (!overlap<t_k2_treap::k>(p1, p2, v)) {
+                return;
+            }
+        }
+        if (is_contained or contained(v.max_p, p1, p2))
+            add_candidate(v.max_p, v.max_v);
+        auto nodes = treap.children(v);
+        std::lock_guard<std::mutex> lock(frontier_mutex);
+        for (auto node : nodes) {
+            // a subtree not heavier than the k-th candidate can not
+            // change the result
+            if (full and node.max_v <= threshold)
+                continue;
+            ++pending;
+            frontier.emplace(node, is_contained);
+        }
+    };
+
+    auto work = [&]() {
+        while (true) {
+            t_nt_b s;
+            bool got = false;
+            {
+                std::lock_guard<std::mutex> lock(frontier_mutex);
+                if (!frontier.empty()) {
+                    s = frontier.top();
+                    frontier.pop();
+                    got = true;
+                }
+            }
+            if (got) {
+                // the threshold may have grown since the state was pushed
+                if (!full or s.first.max_v > threshold)
+                    expand(s.first, s.second);
+                --pending;
+            } else {
+                if (0 == pending)
+                    return;
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    if (num_threads > 1) {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < num_threads; ++t)
+            threads.emplace_back(work);
+        for (auto& t : threads)
+            t.join();
+    } else {
+        work();
+    }
+
+    res.reserve(cand.size());
+    while (!cand.empty()) {
+        res.push_back(cand.top());
+        cand.pop();
+    }
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+
+//! Answer a batch of top-k queries with a single traversal
+/*! \param treap k2-treap
+ *  \param rects Query rectangles, each a (lower left, upper right) pair.
+ *  \param k     Number of points to report per query.
+ *  \return One result list per rectangle, each holding the up to k
+ *          heaviest points of its rectangle in decreasing order of
+ *          weight.
+ *
+ *  A navigation state carries all queries whose rectangle overlaps the
+ *  node, so queries with nearby rectangles share the descent through
+ *  the common upper region of the treap instead of repeating it. A
+ *  query leaves a state as soon as its rectangle no longer overlaps or
+ *  its k-th candidate is at least as heavy as the subtree maximum.
+ */
+template<typename t_k2_treap>
+std::vector<std::vector<std::pair<k2_treap_ns::point_type, uint64_t>>>
+top_k_batch(const t_k2_treap& treap,
+            const std::vector<std::pair<k2_treap_ns::point_type,
+            k2_treap_ns::point_type>>& rects,
+            uint64_t k)
+{
+    using namespace k2_treap_ns;
+    typedef std::pair<point_type, uint64_t> t_point_val;
+    std::vector<std::vector<t_point_val>> res(rects.size());
+    if (0 == k or treap.size() == 0 or rects.empty())
+        return res;
+
+    auto cand_gt = [](const t_point_val& a, const t_point_val& b) {
+        return a.second > b.second;
+    };
+    typedef std::priority_queue<t_point_val, std::vector<t_point_val>,
+            decltype(cand_gt)> t_cand_pq;
+    std::vector<t_cand_pq> cand(rects.size(), t_cand_pq(cand_gt));
+
+    // navigation state: node and the queries still interested in it,
+    // each with a flag whether its rectangle contains the node area
+    struct state {
+        node_type v;
+        std::vector<std::pair<uint32_t, bool>> qs;
+        bool operator<(const state& s) const { return v < s.v; }
+    };
+    std::priority_queue<state> pq; // heaviest subtree first
+    {
+        state s;
+        s.v = treap.root();
+        for (uint32_t q = 0; q < rects.size(); q++)
+            s.qs.emplace_back(q, false);
+        pq.push(std::move(s));
+    }
+
+    std::vector<std::pair<uint32_t, bool>> active;
+    while (!pq.empty()) {
+        state s = pq.top();
+        pq.pop();
+        active.clear();
+        for (auto qb : s.qs) {
+            uint32_t q = qb.first;
+            bool is_contained = qb.second;
+            if (cand[q].size() == k and s.v.max_v <= cand[q].top().second)
+                continue; // can not improve query q any more
+            if (!is_contained) {
+                if (contained<t_k2_treap::k>(rects[q].first,
+                                             rects[q].second, s.v)) {
+                    is_contained = true;
+                } else if (!overlap<t_k2_treap::k>(rects[q].first,
+                                                   rects[q].second, s.v)) {
+                    continue;
+                }
+            }
+            if (is_contained or
+                contained(s.v.max_p, rects[q].first, rects[q].second)) {
+                if (cand[q].size() < k) {
+                    cand[q].emplace(s.v.max_p, s.v.max_v);
+                } else if (s.v.max_v > cand[q].top().second) {
+                    cand[q].pop();
+                    cand[q].emplace(s.v.max_p, s.v.max_v);
+                }
+            }
+            active.emplace_back(q, is_contained);
+        }
+        if (active.empty())
+            continue;
+        for (auto node : treap.children(s.v)) {
+            state cs;
+            cs.v = node;
+            for (auto qb : active) {
+                if (cand[qb.first].size() == k and
+                    node.max_v <= cand[qb.first].top().second)
+                    continue;
+                cs.qs.push_back(qb);
+            }
+            if (!cs.qs.empty())
+                pq.push(std::move(cs));
+        }
+    }
+
+    for (uint32_t q = 0; q < rects.size(); q++) {
+        res[q].reserve(cand[q].size());
+        while (!cand[q].empty()) {
+            res[q].push_back(cand[q].top());
+            cand[q].pop();
+        }
+        std::reverse(res[q].begin(), res[q].end());
+    }
+    return res;
+}
+
+
 //! Get iterator for all points in rectangle (p1,p2) with weights in range
 /*! \param treap k2-treap
  *  \param p1    Lower left corner of the rectangle
@@ -366,6 +608,172 @@ __count(const t_k2_treap& treap,
 }
 
 
+// forward declaration
+template<typename t_k2_treap>
+uint64_t _count_2d(const t_k2_treap&, k2_treap_ns::point_type,
+                   k2_treap_ns::point_type, typename t_k2_treap::node_type);
+
+//! Count how many points are in the rectangle (p1,p2) without enumeration
+/*! \param treap k2-treap
+ *  \param p1    Lower left corner of the rectangle.
+ *  \param p2    Upper right corner of the rectangle.
+ *  \return The number of points in rectangle (p1,p2).
+ *  \pre real(p1) <= real(p2) and imag(p1)<=imag(p2)
+ *
+ *  A node whose submatrix is fully contained in the rectangle
+ *  contributes its stored subtree cardinality in constant time, so only
+ *  the nodes straddling the rectangle border are visited — in contrast
+ *  to count(), which descends through every contained subtree.
+ */
+template<typename t_k2_treap>
+uint64_t
+count_2d(const t_k2_treap& treap,
+         k2_treap_ns::point_type p1,
+         k2_treap_ns::point_type p2)
+{
+    if (treap.size() > 0) {
+        return _count_2d(treap, p1, p2, treap.root());
+    }
+    return 0;
+}
+
+
+template<typename t_k2_treap>
+uint64_t
+_count_2d(const t_k2_treap& treap,
+          k2_treap_ns::point_type p1,
+          k2_treap_ns::point_type p2,
+          typename t_k2_treap::node_type v)
+{
+    using namespace k2_treap_ns;
+    if (contained<t_k2_treap::k>(p1, p2, v)) {
+        return treap.subtree_count(v);
+    } else if (overlap<t_k2_treap::k>(p1, p2, v)) {
+        uint64_t res = contained(v.max_p, p1, p2);
+        auto nodes = treap.children(v);
+        for (auto node : nodes) {
+            res += _count_2d(treap, p1, p2, node);
+        }
+        return res;
+    }
+    return 0;
+}
+
+
+// forward declaration
+template<typename t_k2_treap>
+uint64_t _sum_2d(const t_k2_treap&, k2_treap_ns::point_type,
+                 k2_treap_ns::point_type, typename t_k2_treap::node_type);
+
+//! Sum up the weights of all points in the rectangle (p1,p2)
+/*! \param treap k2-treap
+ *  \param p1    Lower left corner of the rectangle.
+ *  \param p2    Upper right corner of the rectangle.
+ *  \return The sum of the weights of all points in rectangle (p1,p2).
+ *  \pre real(p1) <= real(p2) and imag(p1)<=imag(p2)
+ *
+ *  A node whose submatrix is fully contained in the rectangle
+ *  contributes its stored subtree weight sum in constant time, so only
+ *  the nodes straddling the rectangle border are visited instead of
+ *  every point in the rectangle.
+ */
+template<typename t_k2_treap>
+uint64_t
+sum_2d(const t_k2_treap& treap,
+       k2_treap_ns::point_type p1,
+       k2_treap_ns::point_type p2)
+{
+    if (treap.size() > 0) {
+        return _sum_2d(treap, p1, p2, treap.root());
+    }
+    return 0;
+}
+
+
+template<typename t_k2_treap>
+uint64_t
+_sum_2d(const t_k2_treap& treap,
+        k2_treap_ns::point_type p1,
+        k2_treap_ns::point_type p2,
+        typename t_k2_treap::node_type v)
+{
+    using namespace k2_treap_ns;
+    if (contained<t_k2_treap::k>(p1, p2, v)) {
+        return treap.subtree_sum(v);
+    } else if (overlap<t_k2_treap::k>(p1, p2, v)) {
+        uint64_t res = contained(v.max_p, p1, p2) ? v.max_v : 0;
+        auto nodes = treap.children(v);
+        for (auto node : nodes) {
+            res += _sum_2d(treap, p1, p2, node);
+        }
+        return res;
+    }
+    return 0;
+}
+
+
+// forward declaration
+template<typename t_k2_treap>
+void _max_2d(const t_k2_treap&, k2_treap_ns::point_type,
+             k2_treap_ns::point_type, typename t_k2_treap::node_type,
+             uint64_t&);
+
+//! Maximal weight of a point in the rectangle (p1,p2)
+/*! \param treap k2-treap
+ *  \param p1    Lower left corner of the rectangle.
+ *  \param p2    Upper right corner of the rectangle.
+ *  \return The maximal weight of a point in rectangle (p1,p2), or 0 if
+ *          the rectangle contains no point.
+ *  \pre real(p1) <= real(p2) and imag(p1)<=imag(p2)
+ *
+ *  The stored value of a node is the maximum of its submatrix, so a
+ *  fully contained node and a node whose maximal point lies in the
+ *  rectangle are settled in constant time; at straddling nodes only
+ *  children heavier than the current maximum are descended, heaviest
+ *  first.
+ */
+template<typename t_k2_treap>
+uint64_t
+max_2d(const t_k2_treap& treap,
+       k2_treap_ns::point_type p1,
+       k2_treap_ns::point_type p2)
+{
+    uint64_t res = 0;
+    if (treap.size() > 0) {
+        _max_2d(treap, p1, p2, treap.root(), res);
+    }
+    return res;
+}
+
+
+template<typename t_k2_treap>
+void
+_max_2d(const t_k2_treap& treap,
+        k2_treap_ns::point_type p1,
+        k2_treap_ns::point_type p2,
+        typename t_k2_treap::node_type v,
+        uint64_t& res)
+{
+    using namespace k2_treap_ns;
+    if (contained<t_k2_treap::k>(p1, p2, v) or contained(v.max_p, p1, p2)) {
+        res = std::max(res, v.max_v);
+        return; // v.max_v bounds the whole subtree
+    }
+    if (overlap<t_k2_treap::k>(p1, p2, v)) {
+        auto nodes = treap.children(v);
+        std::sort(nodes.begin(), nodes.end(),
+        [](const node_type& a, const node_type& b) {
+            return b < a;
+        });
+        for (auto node : nodes) {
+            if (node.max_v <= res) // lighter subtrees can not improve
+                break;
+            _max_2d(treap, p1, p2, node, res);
+        }
+    }
+}
+
+
 // forward declaration
 template<uint8_t  t_k,
          typename t_bv,
@@ -21,13 +21,19 @@
 #ifndef INCLUDED_SDSL_K2_TREE
 #define INCLUDED_SDSL_K2_TREE
 
+#include <algorithm>
 #include <deque>
+#include <map>
 #include <queue>
 #include <stdexcept>
 #include <tuple>
+#include <vector>
 #include "sdsl/bit_vectors.hpp"
+#include "sdsl/dac_vector.hpp"
 #include "sdsl/k2_tree_helper.hpp"
 #include "sdsl/int_vector_buffer.hpp"
+#include "sdsl/config.hpp"
+#include "sdsl/io.hpp"
 
 
 //! Namespace for the succint data structure library
@@ -45,11 +51,25 @@ namespace sdsl
  *          (pp. 18-30). Springer Berlin Heidelberg.
  */
 
+/*! \tparam k      Dimension of the submatrices, the matrix is split into
+ *                 k x k submatrices per level.
+ *  \tparam t_bv   Bit vector type of the tree levels.
+ *  \tparam t_rank Rank support for pattern `1` on the tree levels.
+ *  \tparam t_comp If true, the last level is not stored as a plain bit
+ *                 array but as a frequency-sorted vocabulary of the
+ *                 distinct k^2-bit leaf submatrices plus a dac_vector
+ *                 of vocabulary indices, one per leaf. Real-world
+ *                 adjacency matrices repeat few leaf patterns, so the
+ *                 frequent patterns get the shortest DAC codes.
+ */
 template<uint8_t k,
          typename t_bv=bit_vector,
-         typename t_rank=typename t_bv::rank_1_type>
+         typename t_rank=typename t_bv::rank_1_type,
+         bool t_comp=false>
 class k2_tree
 {
+        static_assert(!t_comp or (uint16_t)k*k <= 64,
+                      "compressed leaves require k^2 <= 64 bit leaf words");
     public:
         typedef k2_tree_ns::idx_type idx_type;
         typedef k2_tree_ns::size_type size_type;
@@ -58,8 +78,12 @@ class k2_tree
         //! Bit array to store all the bits of the tree, except those in the
         //! last level.
         t_bv        k_t;
-        //! Bit array to store the last level of the tree.
+        //! Bit array to store the last level of the tree (t_comp=false).
         t_bv        k_l;
+        //! Distinct leaf submatrix words, most frequent first (t_comp=true).
+        int_vector<> k_voc;
+        //! Vocabulary index of each leaf submatrix (t_comp=true).
+        dac_vector<> k_leaf;
 
         t_rank      k_t_rank;
 
@@ -68,6 +92,76 @@ class k2_tree
 
     protected:
 
+        //! Number of bits of the last level.
+        size_type l_size() const
+        {
+            return t_comp ? k_leaf.size()*k*k : k_l.size();
+        }
+
+        //! Bit p of the last level.
+        bool l_bit(size_type p) const
+        {
+            if (t_comp) {
+                const size_type k_2 = (size_type)k*k;
+                return (k_voc[k_leaf[p/k_2]] >> (p%k_2)) & 1;
+            }
+            return k_l[p] == 1;
+        }
+
+        //! len bits of the last level starting at bit p; the range must
+        //! not cross a leaf submatrix border.
+        uint64_t l_bits(size_type p, uint8_t len) const
+        {
+            if (t_comp) {
+                const size_type k_2 = (size_type)k*k;
+                return (k_voc[k_leaf[p/k_2]] >> (p%k_2)) & bits::lo_set[len];
+            }
+            return k_l.get_int(p, len);
+        }
+
+        //! Builds the leaf vocabulary and the per-leaf indices from the
+        //! plain last-level bits (t_comp=true).
+        void compress_leaves(const bit_vector& k_l_)
+        {
+            const size_type k_2 = (size_type)k*k;
+            size_type cnt = k_l_.size()/k_2;
+            std::map<uint64_t, size_type> freq;
+            for (size_type i = 0; i < cnt; i++)
+                freq[k_l_.get_int(i*k_2, (uint8_t)k_2)] += 1;
+            // most frequent words get the smallest indices
+            std::vector<std::pair<size_type, uint64_t>> by_freq;
+            by_freq.reserve(freq.size());
+            for (auto& w : freq)
+                by_freq.push_back(std::make_pair(w.second, w.first));
+            std::sort(by_freq.begin(), by_freq.end(),
+            [](const std::pair<size_type, uint64_t>& a,
+            const std::pair<size_type, uint64_t>& b) {
+                return a.first > b.first
+                       or (a.first == b.first and a.second < b.second);
+            });
+            k_voc = int_vector<>(by_freq.size(), 0, (uint8_t)k_2);
+            std::map<uint64_t, size_type> code;
+            for (size_type i = 0; i < by_freq.size(); i++) {
+                k_voc[i] = by_freq[i].second;
+                code[by_freq[i].second] = i;
+            }
+            std::vector<uint64_t> idx(cnt);
+            for (size_type i = 0; i < cnt; i++)
+                idx[i] = code[k_l_.get_int(i*k_2, (uint8_t)k_2)];
+            k_leaf = dac_vector<>(idx);
+        }
+
+        //! Finishes the level vectors of all build paths: compresses the
+        //! leaves into the vocabulary or keeps them as a plain bit array.
+        void build_level_vectors(bit_vector& k_t_, bit_vector& k_l_)
+        {
+            if (t_comp) {
+                compress_leaves(k_l_);
+                k_l_ = bit_vector();
+            }
+            k2_tree_ns::build_template_vector<t_bv>(k_t_, k_l_, k_t, k_l);
+        }
+
         void build_from_matrix(const std::vector<std::vector <int>>& matrix)
         {
             // Makes the size a power of k.
@@ -106,7 +200,7 @@ class k2_tree
                     n++;
                 }
 
-            k2_tree_ns::build_template_vector<t_bv>(k_t_, k_l_, k_t, k_l);
+            build_level_vectors(k_t_, k_l_);
         }
 
 
@@ -125,7 +219,7 @@ class k2_tree
                     std::vector<idx_type>& acc) const
         {
             if (level >= k_t.size()) { // Last level
-                if (k_l[level - k_t.size()] == 1)
+                if (l_bit(level - k_t.size()))
                     acc.push_back(col);
                 return;
             }
@@ -138,6 +232,27 @@ class k2_tree
             }
         }
 
+        // Batched rank: use the prefetched rank_batch of the support if it
+        // has one (e.g. rank_support_v), a plain loop otherwise.
+        template<class t_r>
+        static auto _rank_many(const t_r& rs, const std::vector<size_type>& idx,
+                               std::vector<size_type>& res, int)
+        -> decltype(rs.rank_batch((const size_type*)nullptr, 0,
+                                  (size_type*)nullptr), void())
+        {
+            res.resize(idx.size());
+            rs.rank_batch(idx.data(), idx.size(), res.data());
+        }
+
+        template<class t_r>
+        static void _rank_many(const t_r& rs, const std::vector<size_type>& idx,
+                               std::vector<size_type>& res, long)
+        {
+            res.resize(idx.size());
+            for (size_type i = 0; i < idx.size(); i++)
+                res[i] = rs(idx[i]);
+        }
+
         /*! Recursive function to retrieve list of reverse neighbors.
          *
          *  \param n Size of the submatrix in the next recursive step.
@@ -153,7 +268,7 @@ class k2_tree
                             size_type level, std::vector<idx_type>& acc) const
         {
             if (level >= k_t.size()) { // Last level
-                if (k_l[level - k_t.size()] == 1) {
+                if (l_bit(level - k_t.size())) {
                     acc.push_back(row);
                 }
                 return;
@@ -263,12 +378,237 @@ class k2_tree
                 }
             }
             k_l_.resize(t);
-            k2_tree_ns::build_template_vector<t_bv>(k_t_, k_l_, k_t, k_l);
+            build_level_vectors(k_t_, k_l_);
 
             k_t_rank = t_rank(&k_t);
 
 		}
 
+        /*! In-memory partitioning of the edges of one subtree, appending
+         *  the level bits to the per-level accumulators. Same counting
+         *  sort as build_from_edges, but the subtree may start at any
+         *  level and position of the tree.
+         *
+         *  \param edges Edges of the subtree, will be reordered.
+         *  \param l Size of the submatrices one level below the subtree
+         *           root.
+         *  \param r_0 Row offset of the subtree in the global matrix.
+         *  \param c_0 Column offset of the subtree in the global matrix.
+         *  \param depth Level of the subtree root.
+         *  \param acc One bit accumulator per level of the tree.
+         */
+        void _partition_in_memory(std::vector<std::tuple<idx_type,
+                                  idx_type>>& edges,
+                                  size_type l, idx_type r_0, idx_type c_0,
+                                  uint16_t depth,
+                                  std::vector<std::vector<bool>>& acc)
+        {
+            typedef std::tuple<idx_type, idx_type, size_type, idx_type,
+                    idx_type, uint16_t> t_part_tuple;
+            size_type k_2 = std::pow(k_k, 2);
+            idx_type i, j, r_ch, c_ch, it, chunk;
+            uint16_t d;
+            std::vector<idx_type> pos_by_chunk(k_2 + 1, 0);
+
+            std::queue<t_part_tuple> q;
+            q.push(t_part_tuple(0, edges.size(), l, r_0, c_0, depth));
+
+            while (!q.empty()) {
+                std::vector<idx_type> amount_by_chunk(k_2, 0);
+                std::tie(i, j, l, r_0, c_0, d) = q.front();
+                q.pop();
+                // Get size for each chunk
+                for (it = i; it < j; it++)
+                    amount_by_chunk[k2_tree_ns::get_chunk_idx(
+                                        std::get<0>(edges[it]), std::get<1>(edges[it]),
+                                        c_0, r_0, l, k_k)] += 1;
+                if (l == 1) {
+                    for (it = 0; it < k_2; it++)
+                        acc[d].push_back(amount_by_chunk[it] != 0);
+                    // At l == 1 we do not put new elements at the queue.
+                    continue;
+                }
+
+                // Set starting position in the vector for each chunk
+                pos_by_chunk[0] = i;
+                for (it = 1; it < k_2; it++)
+                    pos_by_chunk[it] =
+                        pos_by_chunk[it - 1] + amount_by_chunk[it - 1];
+                // To handle the last case when it = k_2 - 1
+                pos_by_chunk[k_2] = j;
+                // Push to the queue every non zero elements chunk
+                for (it = 0; it < k_2; it++) {
+                    acc[d].push_back(amount_by_chunk[it] != 0);
+                    if (amount_by_chunk[it] != 0) {
+                        r_ch = it / k_k;
+                        c_ch = it % k_k;
+                        q.push(t_part_tuple(pos_by_chunk[it],
+                                            pos_by_chunk[it + 1],
+                                            l/k_k,
+                                            r_0 + r_ch * l,
+                                            c_0 + c_ch * l,
+                                            d + 1));
+                    }
+                }
+
+                // Sort edges' vector
+                for (unsigned ch = 0; ch < k_2; ch++) {
+                    idx_type be = ch == 0 ? i : pos_by_chunk[ch - 1];
+                    for (it = pos_by_chunk[ch]; it < be + amount_by_chunk[ch];) {
+                        chunk = k2_tree_ns::get_chunk_idx(
+                                    std::get<0>(edges[it]), std::get<1>(edges[it]),
+                                    c_0, r_0, l, k_k);
+
+                        if (pos_by_chunk[chunk] != it)
+                            std::iter_swap(edges.begin() + it,
+                                           edges.begin() + pos_by_chunk[chunk]);
+                        else
+                            it++;
+                        pos_by_chunk[chunk]++;
+                    }
+                }
+            }
+        }
+
+        /*! External partitioning of the edges of one subtree: one
+         *  sequential pass distributes the edges in Morton order over
+         *  k^2 temporary bucket files, which are then processed
+         *  recursively; subtrees whose edges fit in memory are handed
+         *  over to _partition_in_memory.
+         *
+         *  \param buf_x Stream with the x component of the edges.
+         *  \param buf_y Stream with the y component of the edges.
+         *  \param cnt Number of edges in the streams.
+         *  \param l Size of the submatrices one level below the subtree
+         *           root.
+         *  \param r_0 Row offset of the subtree in the global matrix.
+         *  \param c_0 Column offset of the subtree in the global matrix.
+         *  \param depth Level of the subtree root.
+         *  \param acc One bit accumulator per level of the tree.
+         *  \param config Placement of the temporary bucket files.
+         *  \param mem_edges Threshold for the in-memory hand-over.
+         */
+        void _partition_external(int_vector_buffer<>& buf_x,
+                                 int_vector_buffer<>& buf_y,
+                                 size_type cnt, size_type l,
+                                 idx_type r_0, idx_type c_0, uint16_t depth,
+                                 std::vector<std::vector<bool>>& acc,
+                                 const cache_config& config,
+                                 size_type mem_edges)
+        {
+            size_type k_2 = std::pow(k_k, 2);
+            size_type it, chunk;
+            if (l == 1) { // Last level
+                std::vector<size_type> amount_by_chunk(k_2, 0);
+                for (it = 0; it < cnt; it++)
+                    amount_by_chunk[k2_tree_ns::get_chunk_idx(
+                                        buf_x[it], buf_y[it],
+                                        c_0, r_0, l, k_k)] += 1;
+                for (it = 0; it < k_2; it++)
+                    acc[depth].push_back(amount_by_chunk[it] != 0);
+                return;
+            }
+            if (cnt <= mem_edges) { // Subtree fits in memory
+                std::vector<std::tuple<idx_type, idx_type>> edges;
+                edges.reserve(cnt);
+                for (it = 0; it < cnt; it++)
+                    edges.push_back(std::tuple<idx_type, idx_type> {
+                                        buf_x[it], buf_y[it]});
+                _partition_in_memory(edges, l, r_0, c_0, depth, acc);
+                return;
+            }
+            // Distribute the edges over k^2 bucket files
+            std::vector<size_type> amount_by_chunk(k_2, 0);
+            std::vector<std::string> f_names(k_2);
+            std::vector<int_vector_buffer<>> out_x, out_y;
+            for (it = 0; it < k_2; it++) {
+                f_names[it] = tmp_file(config, "_k2_bucket_"
+                                       + util::to_string(depth) + "_"
+                                       + util::to_string(it));
+                out_x.emplace_back(f_names[it] + ".x", std::ios::out);
+                out_y.emplace_back(f_names[it] + ".y", std::ios::out);
+            }
+            for (it = 0; it < cnt; it++) {
+                chunk = k2_tree_ns::get_chunk_idx(buf_x[it], buf_y[it],
+                                                  c_0, r_0, l, k_k);
+                out_x[chunk].push_back(buf_x[it]);
+                out_y[chunk].push_back(buf_y[it]);
+                amount_by_chunk[chunk] += 1;
+            }
+            for (it = 0; it < k_2; it++) {
+                acc[depth].push_back(amount_by_chunk[it] != 0);
+                out_x[it].close();
+                out_y[it].close();
+            }
+            // Process the buckets in Morton order
+            for (it = 0; it < k_2; it++) {
+                if (amount_by_chunk[it] != 0) {
+                    int_vector_buffer<> in_x(f_names[it] + ".x", std::ios::in);
+                    int_vector_buffer<> in_y(f_names[it] + ".y", std::ios::in);
+                    _partition_external(in_x, in_y, amount_by_chunk[it],
+                                        l/k_k,
+                                        r_0 + (it / k_k) * l,
+                                        c_0 + (it % k_k) * l,
+                                        depth + 1, acc, config, mem_edges);
+                    in_x.close(true);
+                    in_y.close(true);
+                } else {
+                    sdsl::remove(f_names[it] + ".x");
+                    sdsl::remove(f_names[it] + ".y");
+                }
+            }
+        }
+
+        //! Build a tree from an edge stream
+        /*! This method consumes the edges from a pair of
+         *  int_vector_buffers and never materializes the full edge list
+         *  in memory: a node whose edge set exceeds mem_edges is split
+         *  into its k^2 submatrices by one sequential pass over
+         *  temporary bucket files, and the in-memory counting sort takes
+         *  over once a subtree fits. The level bit vectors are collected
+         *  bottom-up per level, so the I/O volume is at most
+         *  height/log(mem_edges) scans of the input.
+         *  \param buf_x Stream with the x component of the edges.
+         *  \param buf_y Stream with the y component of the edges.
+         *  \param size Size of the graph, all the nodes in the edges
+         *              must be within 0 and size ([0, size[).
+         *  \param config Placement of the temporary bucket files.
+         *  \param mem_edges Maximum number of edges partitioned in
+         *                   memory at once.
+         */
+        void build_from_edge_stream(int_vector_buffer<>& buf_x,
+                                    int_vector_buffer<>& buf_y,
+                                    const size_type size,
+                                    const cache_config& config,
+                                    const size_type mem_edges)
+        {
+            k_k = k;
+            k_height = std::ceil(std::log(size)/std::log(k_k));
+            k_height = k_height > 1 ? k_height : 1; // If size == 0
+
+            std::vector<std::vector<bool>> acc(k_height);
+            size_type l = std::pow(k_k, k_height - 1);
+            _partition_external(buf_x, buf_y, buf_x.size(), l, 0, 0, 0,
+                                acc, config, mem_edges);
+
+            // Concatenate the per-level bits; the last level goes to l
+            size_type t_size = 0;
+            for (uint16_t d = 0; d + 1 < k_height; d++)
+                t_size += acc[d].size();
+            bit_vector k_t_(t_size, 0);
+            bit_vector k_l_(acc[k_height - 1].size(), 0);
+            size_type n = 0;
+            for (uint16_t d = 0; d + 1 < k_height; d++)
+                for (size_type i = 0; i < acc[d].size(); i++)
+                    k_t_[n++] = acc[d][i];
+            for (n = 0; n < acc[k_height - 1].size(); n++)
+                k_l_[n] = acc[k_height - 1][n];
+
+            build_level_vectors(k_t_, k_l_);
+
+            k_t_rank = t_rank(&k_t);
+        }
+
     public:
 
         k2_tree() = default;
@@ -355,6 +695,41 @@ class k2_tree
 			build_from_edges(edges, size);
 		}
 
+        //! Constructor
+        /*! This constructor streams the edges from a pair of
+         *  int_vector_buffers, e.g. over files too large to load. The
+         *  edges may come in any order; they are bucketed in Morton
+         *  order over temporary files and at no point is the full edge
+         *  list or matrix held in memory.
+         *  \param buf_x Stream with the x component of each edge.
+         *  \param buf_y Stream with the y component of each edge, the
+         *               edge i goes from node buf_x[i] to node buf_y[i].
+         *  \param size Size of the graph, all the nodes in the edges
+         *              must be within 0 and size ([0, size[). If
+         *              size==0, the size will be taken as the max node
+         *              in the edges.
+         *  \param config Placement of the temporary bucket files.
+         *  \param mem_edges Maximum number of edges partitioned in
+         *                   memory at once.
+         */
+        k2_tree(int_vector_buffer<>& buf_x, int_vector_buffer<>& buf_y,
+                size_type size, cache_config config=cache_config(),
+                size_type mem_edges=1ULL<<24)
+        {
+            assert(buf_x.size() == buf_y.size());
+            assert(buf_x.size() > 0);
+
+            if (size == 0) {
+                size_type max = 0;
+                for (auto v : buf_x)
+                    max = std::max(static_cast<size_type>(v), max);
+                for (auto v : buf_y)
+                    max = std::max(static_cast<size_type>(v), max);
+                size = max + 1;
+            }
+
+            build_from_edge_stream(buf_x, buf_y, size, config, mem_edges);
+        }
 
         k2_tree(const k2_tree& tr)
         {
@@ -372,6 +747,8 @@ class k2_tree
             if (this != &tr) {
                 k_t = std::move(tr.k_t);
                 k_l = std::move(tr.k_l);
+                k_voc = std::move(tr.k_voc);
+                k_leaf = std::move(tr.k_leaf);
                 k_k = std::move(tr.k_k);
                 k_height = std::move(tr.k_height);
                 k_t_rank = std::move(tr.k_t_rank);
@@ -381,11 +758,13 @@ class k2_tree
         }
 
         //! Assignment operator
-        k2_tree& operator=(k2_tree& tr)
+        k2_tree& operator=(const k2_tree& tr)
         {
             if (this != &tr) {
                 k_t = tr.k_t;
                 k_l = tr.k_l;
+                k_voc = tr.k_voc;
+                k_leaf = tr.k_leaf;
                 k_t_rank = tr.k_t_rank;
                 k_t_rank.set_vector(&k_t);
                 k_k = tr.k_k;
@@ -400,6 +779,8 @@ class k2_tree
             if (this != &tr) {
                 std::swap(k_t, tr.k_t);
                 std::swap(k_l, tr.k_l);
+                k_voc.swap(tr.k_voc);
+                k_leaf.swap(tr.k_leaf);
                 util::swap_support(k_t_rank, tr.k_t_rank, &k_t, &(tr.k_t));
                 std::swap(k_k, tr.k_k);
                 std::swap(k_height, tr.k_height);
@@ -412,13 +793,13 @@ class k2_tree
             // TODO check the rank support equality?
             if (k_k != tr.k_k || k_height != tr.k_height)
                 return false;
-            if (k_t.size() != tr.k_t.size() || k_l.size() != tr.k_l.size())
+            if (k_t.size() != tr.k_t.size() || l_size() != tr.l_size())
                 return false;
             for (unsigned i = 0; i < k_t.size(); i++)
                 if (k_t[i] != tr.k_t[i])
                     return false;
-            for (unsigned i = 0; i < k_l.size(); i++)
-                if (k_l[i] != tr.k_l[i])
+            for (size_type i = 0; i < l_size(); i++)
+                if (l_bit(i) != tr.l_bit(i))
                     return false;
             return true;
         }
@@ -442,7 +823,7 @@ class k2_tree
          */
         bool adj(idx_type i, idx_type j) const
         {
-            if (k_t.size() == 0 && k_l.size() == 0)
+            if (k_t.size() == 0 && l_size() == 0)
                 return false;
             size_type n = std::pow(k_k, k_height - 1);
             size_type k_2 = std::pow(k_k, 2);
@@ -469,7 +850,7 @@ class k2_tree
                 n = n/k_k;
             }
 
-            return k_l[level - k_t.size()] == 1;
+            return l_bit(level - k_t.size());
         }
 
         //! Returns a list of neighbors of node i.
@@ -480,7 +861,7 @@ class k2_tree
         std::vector<idx_type> neigh(idx_type i) const
         {
             std::vector<idx_type> acc{};
-            if (k_l.size() == 0 && k_t.size() == 0)
+            if (l_size() == 0 && k_t.size() == 0)
                 return acc;
 			// n = k^h / k
 			// k^h - dimension n of matrix nxn
@@ -494,6 +875,79 @@ class k2_tree
             return acc;
         }
 
+        //! Returns the neighbor lists of a batch of nodes.
+        /*!
+         *  \param vertices Nodes to get the neighbors from, e.g. a BFS
+         *      frontier.
+         *  \returns One list of neighbors per node, in the order of
+         *      vertices.
+         *
+         *  Instead of one recursive descent per vertex, the whole batch
+         *  is expanded level by level over the k^2 hierarchy. The k
+         *  sibling cells of a node row are contiguous in t:l and are
+         *  read as one k-bit word, and the rank lookups of a level are
+         *  evaluated together, so the support can overlap their memory
+         *  latencies (see rank_support_v::rank_batch).
+         */
+        std::vector<std::vector<idx_type>>
+        neigh_batch(const std::vector<idx_type>& vertices) const
+        {
+            std::vector<std::vector<idx_type>> res(vertices.size());
+            if (l_size() == 0 && k_t.size() == 0)
+                return res;
+            // A group covers the k sibling cells base..base+k-1 of one
+            // matrix row; cell j has column offset col + n * j, where n
+            // is the submatrix size of the group's level.
+            struct group {
+                size_type base;
+                idx_type  row;   // row inside the child submatrices
+                idx_type  col;   // global column offset of cell j=0
+                size_type q;     // index into vertices
+            };
+            size_type n =
+                static_cast<size_type>(std::pow(k_k, k_height)) / k_k;
+            size_type k_2 = k_k * k_k;
+            std::vector<group> frontier, next;
+            frontier.reserve(vertices.size());
+            for (size_type q = 0; q < vertices.size(); q++) {
+                idx_type i = vertices[q];
+                frontier.push_back(group{k_k * (i/n), static_cast<idx_type>(i % n), 0, q});
+            }
+            std::vector<size_type> rank_pos, ranks;
+            while (!frontier.empty()) {
+                next.clear();
+                rank_pos.clear();
+                for (const group& g : frontier) {
+                    if (g.base >= k_t.size()) { // Last level
+                        uint64_t mask = l_bits(g.base - k_t.size(), k_k);
+                        while (mask) {
+                            unsigned j = bits::lo(mask);
+                            mask &= mask - 1;
+                            res[g.q].push_back(g.col + n * j);
+                        }
+                    } else {
+                        uint64_t mask = k_t.get_int(g.base, k_k);
+                        while (mask) {
+                            unsigned j = bits::lo(mask);
+                            mask &= mask - 1;
+                            rank_pos.push_back(g.base + j + 1);
+                            next.push_back(group{0, g.row,
+                                                 static_cast<idx_type>(g.col + n * j), g.q});
+                        }
+                    }
+                }
+                _rank_many(k_t_rank, rank_pos, ranks, 0);
+                size_type n_c = n / k_k;
+                for (size_type t = 0; t < next.size(); t++) {
+                    next[t].base = ranks[t] * k_2 + k_k * (next[t].row / n_c);
+                    next[t].row  = next[t].row % n_c;
+                }
+                frontier.swap(next);
+                n = n_c;
+            }
+            return res;
+        }
+
         //! Returns a list of reverse neighbors of node i.
         /*!
          *  \param i Node to get reverse neighbors from.
@@ -502,7 +956,7 @@ class k2_tree
         std::vector<idx_type> reverse_neigh(idx_type i) const
         {
             std::vector<idx_type> acc{};
-            if (k_l.size() == 0 && k_t.size() == 0)
+            if (l_size() == 0 && k_t.size() == 0)
                 return acc;
             // Size of the first square division
             size_type n =
@@ -537,7 +991,7 @@ class k2_tree
 
 				//TODO: peel first loop where z==-1 atm
 				if(s.z!=std::numeric_limits<idx_type>::max() && s.z >= k_t.size()){ // Last level
-					if(k_l[s.z - k_t.size()] == 1){
+					if(l_bit(s.z - k_t.size())){
 						res.emplace_back(s.dr, s.dc);
 					}
 				}else if(s.z==std::numeric_limits<idx_type>::max() || k_t[s.z]==1){
@@ -582,6 +1036,10 @@ class k2_tree
 
             written_bytes += k_t.serialize(out, child, "t");
             written_bytes += k_l.serialize(out, child, "l");
+            if (t_comp) {
+                written_bytes += k_voc.serialize(out, child, "voc");
+                written_bytes += k_leaf.serialize(out, child, "leaf");
+            }
             written_bytes += k_t_rank.serialize(out, child, "t_rank");
             written_bytes += write_member(k_k, out, child, "k");
             written_bytes += write_member(k_height, out, child, "height");
@@ -598,6 +1056,10 @@ class k2_tree
         {
             k_t.load(in);
             k_l.load(in);
+            if (t_comp) {
+                k_voc.load(in);
+                k_leaf.load(in);
+            }
             k_t_rank.load(in);
             k_t_rank.set_vector(&k_t);
             read_member(k_k, in);
@@ -0,0 +1,154 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file lazy_cst.hpp
+    \brief lazy_cst.hpp contains a wrapper which loads the tree components
+           of a CST on first use.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_LAZY_CST
+#define INCLUDED_SDSL_LAZY_CST
+
+#include "sdsl_concepts.hpp"
+#include "sfstream.hpp"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace sdsl
+{
+
+//! A wrapper which loads the CSA of a CST eagerly and the tree components lazily.
+/*! Loading a serialized CST materializes the CSA, the compressed LCP array,
+ *  and the balanced parentheses plus their support structures, although
+ *  services which only count and locate never touch the tree part. This
+ *  wrapper opens a serialized CST file, loads only the CSA (the first
+ *  component in the serialization layout), and remembers the stream offset
+ *  of the remaining components; the first access to cst() loads them into
+ *  the same object. The csa() reference stays valid across materialization.
+ *
+ *  Materialization is guarded by a mutex and is safe to trigger from
+ *  several threads. The wrapper is not serializable itself; it reads the
+ *  regular serialization of t_cst.
+ *
+ * \tparam t_cst CST type which provides load_csa and load_tree
+ *               (e.g. cst_sct3).
+ */
+template<class t_cst>
+class lazy_cst
+{
+    public:
+        typedef t_cst                          cst_type;
+        typedef typename t_cst::csa_type       csa_type;
+        typedef typename t_cst::size_type      size_type;
+        typedef typename t_cst::node_type      node_type;
+        typedef typename t_cst::char_type      char_type;
+        typedef cst_tag                        index_category;
+
+    private:
+        std::string               m_file;
+        mutable cst_type          m_cst;
+        std::streampos            m_tree_offset = 0;
+        mutable std::atomic<bool> m_tree_loaded;
+        mutable std::mutex        m_mutex;
+
+        void load_tree_components() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_tree_loaded.load(std::memory_order_acquire)) {
+                return;
+            }
+            isfstream in(m_file, std::ios::binary | std::ios::in);
+            if (!in) {
+                throw std::ios_base::failure("lazy_cst: could not open file `"
+                                             + m_file + "`");
+            }
+            in.seekg(m_tree_offset);
+            m_cst.load_tree(in);
+            m_tree_loaded.store(true, std::memory_order_release);
+        }
+
+    public:
+        //! Default constructor
+        lazy_cst() : m_tree_loaded(false) {}
+
+        //! Constructor
+        /*! \param file Name of a file containing a serialized t_cst object.
+         */
+        lazy_cst(const std::string& file) : m_tree_loaded(false)
+        {
+            load(file);
+        }
+
+        // materialization state is tied to the source file, so the wrapper
+        // is not copyable; copy the materialized CST if a copy is needed
+        lazy_cst(const lazy_cst&) = delete;
+        lazy_cst& operator=(const lazy_cst&) = delete;
+
+        //! Load the CSA component from file and defer the tree components.
+        /*! \param file Name of a file containing a serialized t_cst object.
+         */
+        void load(const std::string& file)
+        {
+            isfstream in(file, std::ios::binary | std::ios::in);
+            if (!in) {
+                throw std::ios_base::failure("lazy_cst: could not open file `"
+                                             + file + "`");
+            }
+            m_file = file;
+            m_cst = cst_type();
+            m_cst.load_csa(in);
+            m_tree_offset = in.tellg();
+            m_tree_loaded.store(false, std::memory_order_release);
+        }
+
+        //! The eagerly loaded CSA; sufficient for count and locate queries.
+        const csa_type& csa() const
+        {
+            return m_cst.csa;
+        }
+
+        //! The full CST; the tree components are loaded on the first call.
+        const cst_type& cst() const
+        {
+            if (!m_tree_loaded.load(std::memory_order_acquire)) {
+                load_tree_components();
+            }
+            return m_cst;
+        }
+
+        //! Load the tree components now instead of on first use.
+        void materialize() const
+        {
+            cst();
+        }
+
+        //! Returns true if the tree components have been loaded.
+        bool materialized() const
+        {
+            return m_tree_loaded.load(std::memory_order_acquire);
+        }
+
+        //! Number of elements in the index.
+        size_type size() const
+        {
+            return m_cst.csa.size();
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -0,0 +1,305 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file lce_support_fp.hpp
+    \brief lce_support_fp.hpp contains a sampled fingerprint structure
+           for longest common extension queries on a byte text.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_LCE_SUPPORT_FP
+#define INCLUDED_SDSL_LCE_SUPPORT_FP
+
+#include <algorithm>
+#include <random>
+#include "int_vector.hpp"
+#include "bits.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A longest common extension support structure on an int_vector<8> text.
+/*! lce(i, j) returns the length of the longest common prefix of the
+ *  suffixes starting at i and j. Short extensions - the overwhelming
+ *  majority in practice - are resolved by comparing the text 64-bit
+ *  word by 64-bit word; long extensions fall back to exponential plus
+ *  binary search over Karp-Rabin fingerprints modulo the Mersenne
+ *  prime \f$ 2^{61}-1 \f$, where a sample table of prefix fingerprints
+ *  (and matching base powers) every t_sample positions makes any
+ *  substring fingerprint computable with at most t_sample character
+ *  accesses. No LCP array, RMQ or suffix array is needed.
+ *
+ *  The fingerprint base is drawn at random during construction, so
+ *  long queries are Monte Carlo: they are correct with high
+ *  probability (error probability \f$ \Order{n/2^{61}} \f$ per query)
+ *  and never underestimate by more than a fingerprint collision.
+ *
+ *  \tparam t_sample Sample rate of the fingerprint table; the
+ *          structure uses \f$ 128/t_{sample} \f$ bits per text
+ *          character (6.25% of the text for the default 256).
+ *
+ *  \par Time complexity
+ *       \f$ \Order{\ell/8} \f$ for extensions \f$ \ell \leq 1024 \f$,
+ *       \f$ \Order{t_{sample}\log \ell} \f$ beyond.
+ */
+template<uint32_t t_sample = 256>
+class lce_support_fp
+{
+    public:
+        typedef int_vector<8>::size_type size_type;
+        typedef int_vector<8>            text_type;
+    private:
+        static_assert(t_sample > 0 and t_sample % 8 == 0,
+                      "lce_support_fp: t_sample must be a positive multiple of 8.");
+        static const uint64_t  s_prime = (1ULL<<61) - 1;
+        static const size_type s_kernel = 1024; // word-compare limit in chars
+
+        const text_type* m_v = nullptr; // pointer to the supported text
+        uint64_t      m_base = 0;  // random fingerprint base
+        int_vector<64> m_fp;       // prefix fingerprint at i*t_sample
+        int_vector<64> m_pow;      // m_base^(i*t_sample) mod s_prime
+        int_vector<64> m_pow_sml;  // m_base^i, i in [0..t_sample]
+
+        //! a*b mod 2^61-1 without 128-bit arithmetic
+        static uint64_t mod_mul(uint64_t a, uint64_t b)
+        {
+            uint64_t a1 = a>>31, a0 = a & 0x7FFFFFFFULL;
+            uint64_t b1 = b>>31, b0 = b & 0x7FFFFFFFULL;
+            // a*b = (a1*b1)<<62 + (a1*b0 + a0*b1)<<31 + a0*b0
+            // and 2^61 = 1 (mod p)
+            uint64_t mid = a1*b0 + a0*b1; // < 2^62
+            uint64_t res = 2*(a1*b1)      // x<<62 = 2x (mod p)
+                           + (mid>>30)     // (mid>>30)<<61 = mid>>30 (mod p)
+                           + ((mid & 0x3FFFFFFFULL)<<31);
+            res = (res & s_prime) + (res>>61);
+            res += a0*b0;
+            res = (res & s_prime) + (res>>61);
+            return res >= s_prime ? res - s_prime : res;
+        }
+
+        static uint64_t mod_add(uint64_t a, uint64_t b)
+        {
+            uint64_t res = a + b; // a, b < 2^61
+            return res >= s_prime ? res - s_prime : res;
+        }
+
+        //! fingerprint of the text prefix [0..x)
+        uint64_t fp_prefix(size_type x)const
+        {
+            size_type k = x/t_sample;
+            uint64_t res = m_fp[k];
+            for (size_type i=k*t_sample; i < x; ++i) {
+                res = mod_add(mod_mul(res, m_base), (*m_v)[i]+1);
+            }
+            return res;
+        }
+
+        //! m_base^e mod s_prime for e < size()+t_sample
+        uint64_t power(size_type e)const
+        {
+            return mod_mul(m_pow[e/t_sample], m_pow_sml[e%t_sample]);
+        }
+
+        //! true if text[i..i+l) and text[j..j+l) have equal fingerprints
+        bool fp_equal(size_type i, size_type j, size_type l)const
+        {
+            uint64_t shift = power(l);
+            uint64_t fi = fp_prefix(i+l) + s_prime
+                          - mod_mul(fp_prefix(i), shift);
+            uint64_t fj = fp_prefix(j+l) + s_prime
+                          - mod_mul(fp_prefix(j), shift);
+            return fi % s_prime == fj % s_prime;
+        }
+
+        void copy(const lce_support_fp& lce)
+        {
+            m_v       = lce.m_v;
+            m_base    = lce.m_base;
+            m_fp      = lce.m_fp;
+            m_pow     = lce.m_pow;
+            m_pow_sml = lce.m_pow_sml;
+        }
+
+    public:
+        //! Constructor
+        /*! \param v Pointer to the text which should be supported.
+         *  \par Time complexity
+         *       \f$ \Order{n} \f$; one pass over the text.
+         */
+        explicit lce_support_fp(const text_type* v = nullptr) : m_v(v)
+        {
+            if (nullptr == v) {
+                return;
+            }
+            std::mt19937_64 rng(0x5dcf0e84a1b2c3d4ULL ^ v->size());
+            m_base = 2 + rng() % (s_prime-3); // random base in [2..p-2]
+            size_type n = v->size();
+            m_fp      = int_vector<64>(n/t_sample+1);
+            m_pow     = int_vector<64>(n/t_sample+2);
+            m_pow_sml = int_vector<64>(t_sample+1);
+            m_pow_sml[0] = 1;
+            for (size_type i=0; i < t_sample; ++i) {
+                m_pow_sml[i+1] = mod_mul(m_pow_sml[i], m_base);
+            }
+            m_pow[0] = 1;
+            for (size_type k=0; k+1 < m_pow.size(); ++k) {
+                m_pow[k+1] = mod_mul(m_pow[k], m_pow_sml[t_sample]);
+            }
+            uint64_t f = 0;
+            m_fp[0] = 0;
+            for (size_type i=0; i < n; ++i) {
+                f = mod_add(mod_mul(f, m_base), (*v)[i]+1);
+                if ((i+1) % t_sample == 0) {
+                    m_fp[(i+1)/t_sample] = f;
+                }
+            }
+        }
+
+        //! Copy constructor
+        lce_support_fp(const lce_support_fp& lce)
+        {
+            copy(lce);
+        }
+
+        //! Move constructor
+        lce_support_fp(lce_support_fp&& lce)
+        {
+            *this = std::move(lce);
+        }
+
+        //! Assignment operator
+        lce_support_fp& operator=(const lce_support_fp& lce)
+        {
+            if (this != &lce) {
+                copy(lce);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        lce_support_fp& operator=(lce_support_fp&& lce)
+        {
+            if (this != &lce) {
+                m_v       = lce.m_v;
+                m_base    = lce.m_base;
+                m_fp      = std::move(lce.m_fp);
+                m_pow     = std::move(lce.m_pow);
+                m_pow_sml = std::move(lce.m_pow_sml);
+            }
+            return *this;
+        }
+
+        //! Longest common extension of the suffixes starting at i and j.
+        /*! \param i First position, \f$ i \in [0..size()] \f$.
+         *  \param j Second position, \f$ j \in [0..size()] \f$.
+         *  \return The length of the longest common prefix of the
+         *          suffixes text[i..] and text[j..].
+         */
+        size_type lce(size_type i, size_type j)const
+        {
+            size_type n = m_v->size();
+            assert(i <= n and j <= n);
+            if (i == j) {
+                return n - i;
+            }
+            size_type maxl = n - std::max(i, j);
+            // word-compare kernel for short extensions
+            size_type l = 0;
+            const uint64_t* data = m_v->data();
+            while (l+8 <= maxl and l < s_kernel) {
+                uint64_t wi = bits::read_int(data + ((i+l)>>3), ((i+l)&7)<<3, 64);
+                uint64_t wj = bits::read_int(data + ((j+l)>>3), ((j+l)&7)<<3, 64);
+                if (wi != wj) {
+                    return l + (bits::lo(wi^wj)>>3);
+                }
+                l += 8;
+            }
+            if (l+8 > maxl) { // the tail of a short extension
+                while (l < maxl and (*m_v)[i+l] == (*m_v)[j+l]) {
+                    ++l;
+                }
+                return l;
+            }
+            // long extension: exponential plus binary search on
+            // fingerprints; the prefix of length l is known to be equal
+            size_type step = t_sample;
+            while (l+step <= maxl and fp_equal(i, j, l+step)) {
+                l += step;
+                step <<= 1;
+            }
+            size_type hi = std::min(l+step, maxl+1); // first length which differs
+            while (l+1 < hi) { // invariant: length l equal, length hi not
+                size_type mid = l + (hi-l)/2;
+                if (fp_equal(i, j, mid)) {
+                    l = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            return l;
+        }
+
+        //! Returns the size of the supported text.
+        size_type size()const
+        {
+            return nullptr == m_v ? 0 : m_v->size();
+        }
+
+        //! Sets the supported text.
+        void set_vector(const text_type* v)
+        {
+            m_v = v;
+        }
+
+        //! Swap method
+        void swap(lce_support_fp& lce)
+        {
+            if (this != &lce) {
+                std::swap(m_base, lce.m_base);
+                m_fp.swap(lce.m_fp);
+                m_pow.swap(lce.m_pow);
+                m_pow_sml.swap(lce.m_pow_sml);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_base, out, child, "base");
+            written_bytes += m_fp.serialize(out, child, "fp");
+            written_bytes += m_pow.serialize(out, child, "pow");
+            written_bytes += m_pow_sml.serialize(out, child, "pow_sml");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in, const text_type* v=nullptr)
+        {
+            m_v = v;
+            read_member(m_base, in);
+            m_fp.load(in);
+            m_pow.load(in);
+            m_pow_sml.load(in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -220,6 +220,7 @@ void load_lcp(t_lcp& lcp, std::istream& in, const t_cst& cst, lcp_tree_and_lf_co
 #include "lcp_bitcompressed.hpp"    // type (a)
 #include "lcp_support_tree.hpp"     // type (c)
 #include "lcp_support_tree2.hpp"    // type (c)
+#include "nsv_support_bp.hpp"       // NSV/PSV support for LCP arrays
 
 
 #endif
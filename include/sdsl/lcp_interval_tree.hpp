@@ -0,0 +1,283 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file lcp_interval_tree.hpp
+    \brief lcp_interval_tree.hpp contains a lightweight suffix tree
+           interval navigator over a CSA and a compressed LCP array.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_LCP_INTERVAL_TREE
+#define INCLUDED_SDSL_LCP_INTERVAL_TREE
+
+#include <utility>
+#include <vector>
+#include "csa_wt.hpp"
+#include "int_vector.hpp"
+#include "lcp.hpp"
+#include "nsv_support_bp.hpp"
+#include "rmq_support.hpp"
+#include "suffix_array_algorithm.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A suffix tree interval navigator over a CSA and an LCP array.
+/*! The navigator emulates the suffix tree topology on plain suffix
+ *  array intervals: a node is the interval \f$ [l..r] \f$ of its
+ *  string. parent() and the lca step of slink() come from PSV/NSV
+ *  queries on the LCP array (\sa nsv_support_bp), slink() maps the
+ *  interval bounds with \f$ \Psi \f$, children are enumerated by
+ *  recursive range-minimum partitioning of the LCP interval, and
+ *  backward_extend() wraps backward_search. This is a middle tier
+ *  between the bare CSA and a full CST: traversals needing only
+ *  extend/shrink, parent and suffix links avoid the CST's navigation
+ *  structures; only the NSV/PSV and RMQ supports over the LCP array
+ *  (\f$ 5n + o(n) \f$ bits) are added to CSA and LCP.
+ *
+ *  The navigator is a support structure: it references an existing
+ *  CSA and LCP array and serializes only its own supports.
+ *
+ *  \tparam t_csa CSA type.
+ *  \tparam t_lcp LCP array type, e.g. lcp_dac<>.
+ *  \tparam t_nsv NSV/PSV support type over the LCP array.
+ *  \tparam t_rmq Range minimum structure type over the LCP array.
+ */
+template<class t_csa = csa_wt<>,
+         class t_lcp = lcp_dac<>,
+         class t_nsv = nsv_support_bp<t_lcp>,
+         class t_rmq = rmq_succinct_sct<true>>
+class lcp_interval_tree
+{
+    public:
+        typedef typename t_csa::size_type           size_type;
+        typedef std::pair<size_type, size_type>     node_type; // [l..r]
+        typedef t_csa                               csa_type;
+        typedef t_lcp                               lcp_type;
+        typedef t_nsv                               nsv_type;
+        typedef t_rmq                               rmq_type;
+    private:
+        const t_csa* m_csa = nullptr; // the supported CSA
+        const t_lcp* m_lcp = nullptr; // the supported LCP array
+        nsv_type     m_nsv;           // PSV/NSV support over the LCP array
+        rmq_type     m_rmq;           // RMQ over the LCP array
+
+        //! LCP value with the conventional 0 past the last position.
+        size_type lcp_at(size_type i)const
+        {
+            return i < m_lcp->size() ? (*m_lcp)[i] : 0;
+        }
+
+        //! Smallest lcp-interval containing boundary position i with
+        //! \f$ LCP[i] = d > 0 \f$.
+        node_type enclosing_interval(size_type i)const
+        {
+            size_type p = m_nsv.psv(i);
+            size_type q = m_nsv.nsv(i);
+            return node_type(p == size() ? 0 : p,
+                             (q == size() ? size() : q) - 1);
+        }
+
+        //! Appends all i in [lb..rb] with LCP[i] = d in ascending order.
+        void l_indices(size_type lb, size_type rb, size_type d,
+                       std::vector<size_type>& out)const
+        {
+            if (lb > rb) {
+                return;
+            }
+            size_type k = m_rmq(lb, rb);
+            if ((*m_lcp)[k] != d) {
+                return;
+            }
+            if (lb < k) {
+                l_indices(lb, k-1, d, out);
+            }
+            out.push_back(k);
+            if (k < rb) {
+                l_indices(k+1, rb, d, out);
+            }
+        }
+
+    public:
+        //! Constructor
+        /*! \param csa Pointer to the CSA which should be supported.
+         *  \param lcp Pointer to the LCP array of the same text.
+         */
+        explicit lcp_interval_tree(const t_csa* csa = nullptr,
+                                   const t_lcp* lcp = nullptr)
+            : m_csa(csa), m_lcp(lcp)
+        {
+            if (nullptr != lcp) {
+                m_nsv = nsv_type(lcp);
+                m_rmq = rmq_type(lcp);
+            }
+        }
+
+        //! The root of the interval tree.
+        node_type root()const
+        {
+            return node_type(0, size()-1);
+        }
+
+        //! Returns whether v is a leaf.
+        bool is_leaf(const node_type& v)const
+        {
+            return v.first == v.second;
+        }
+
+        //! String depth of node v.
+        /*! Leaves cost one suffix array access, inner nodes one RMQ
+         *  plus one LCP access.
+         */
+        size_type depth(const node_type& v)const
+        {
+            if (is_leaf(v)) {
+                return size() - (*m_csa)[v.first];
+            }
+            return (*m_lcp)[m_rmq(v.first+1, v.second)];
+        }
+
+        //! Parent node of v; the root is its own parent.
+        /*! One PSV and one NSV query on the boundary with the larger
+         *  LCP value.
+         */
+        node_type parent(const node_type& v)const
+        {
+            size_type dl = lcp_at(v.first);
+            size_type dr = lcp_at(v.second+1);
+            size_type k  = dl > dr ? v.first : v.second+1;
+            if (0 == std::max(dl, dr)) {
+                return root();
+            }
+            return enclosing_interval(k);
+        }
+
+        //! Suffix link: the node of the string with the first character
+        //! removed.
+        /*! The interval bounds are mapped with \f$ \Psi \f$ and the
+         *  result is closed to an lcp-interval via RMQ and PSV/NSV.
+         *  \pre v is not the root.
+         */
+        node_type slink(const node_type& v)const
+        {
+            size_type l = m_csa->psi[v.first];
+            if (is_leaf(v)) {
+                return node_type(l, l);
+            }
+            size_type r = m_csa->psi[v.second];
+            size_type k = m_rmq(l+1, r);
+            if (0 == (*m_lcp)[k]) {
+                return root();
+            }
+            return enclosing_interval(k);
+        }
+
+        //! Enumerates the children of v in lexicographic order.
+        /*! The child boundaries are the positions of depth(v) in the
+         *  LCP interval, found by recursive range-minimum partitioning;
+         *  one RMQ per child plus one per subrange without a boundary.
+         */
+        std::vector<node_type> children(const node_type& v)const
+        {
+            std::vector<node_type> res;
+            if (is_leaf(v)) {
+                return res;
+            }
+            size_type d = depth(v);
+            std::vector<size_type> li;
+            l_indices(v.first+1, v.second, d, li);
+            size_type l = v.first;
+            for (size_type i : li) {
+                res.emplace_back(l, i-1);
+                l = i;
+            }
+            res.emplace_back(l, v.second);
+            return res;
+        }
+
+        //! Extends the node's string by a character to the left.
+        /*! \param v The current node.
+         *  \param c The prepended character.
+         *  \param res The interval of c + string(v); untouched if empty.
+         *  \return The size of the resulting interval.
+         */
+        size_type backward_extend(const node_type& v,
+                                  typename t_csa::char_type c,
+                                  node_type& res)const
+        {
+            size_type l = 0, r = 0;
+            if (backward_search(*m_csa, v.first, v.second, c, l, r) > 0) {
+                res = node_type(l, r);
+                return r-l+1;
+            }
+            return 0;
+        }
+
+        //! Number of leaves below v.
+        size_type size(const node_type& v)const
+        {
+            return v.second - v.first + 1;
+        }
+
+        //! Returns the size of the supported CSA.
+        size_type size()const
+        {
+            return nullptr == m_csa ? 0 : m_csa->size();
+        }
+
+        //! Sets the supported CSA and LCP array.
+        void set_vector(const t_csa* csa, const t_lcp* lcp)
+        {
+            m_csa = csa;
+            m_lcp = lcp;
+            m_nsv.set_vector(lcp);
+        }
+
+        //! Swap method
+        void swap(lcp_interval_tree& t)
+        {
+            if (this != &t) {
+                m_nsv.swap(t.m_nsv);
+                m_rmq.swap(t.m_rmq);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += m_nsv.serialize(out, child, "nsv");
+            written_bytes += m_rmq.serialize(out, child, "rmq");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in, const t_csa* csa=nullptr,
+                  const t_lcp* lcp=nullptr)
+        {
+            m_csa = csa;
+            m_lcp = lcp;
+            m_nsv.load(in, lcp);
+            m_rmq.load(in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -7,8 +7,11 @@
 #include "int_vector_buffer.hpp"
 #include "wt_huff.hpp"
 #include "sorted_multi_stack_support.hpp"
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace sdsl
 {
@@ -165,6 +168,60 @@ start:
             }
         }
 
+        //! Answers LCP queries for a batch of independent positions.
+        /*! \param idx Array of n query positions, each in \f$[0..size()-1]\f$.
+            \param n   Number of queries.
+            \param res Array of size n; res[k] is set to (*this)[idx[k]].
+            \par The queries are processed in rounds: each round sorts the
+                 still unresolved positions, so tlcp_idx, the wavelet tree
+                 and the big-value rank are walked left to right instead of
+                 jumping with every query, and equal positions -- frequent
+                 in RMQ-driven bursts -- are resolved only once per round.
+                 Positions whose value is reducible continue into the next
+                 round at LF[i]. Output order is restored via the query
+                 ids, so res matches idx element for element.
+         */
+        void lcp_batch(const size_type* idx, size_type n, value_type* res)const
+        {
+            // unresolved queries as (position, query id) pairs
+            std::vector<std::pair<size_type, size_type>> work(n);
+            for (size_type k=0; k < n; ++k) {
+                work[k] = std::make_pair(idx[k], k);
+            }
+            std::vector<size_type> offset(n, 0); // LF-steps done per query
+            std::vector<std::pair<size_type, size_type>> next_work;
+            while (!work.empty()) {
+                std::sort(work.begin(), work.end());
+                next_work.clear();
+                size_type prev_i   = size();    // impossible position
+                uint8_t   prev_val = 0;
+                size_type prev_aux = 0;         // big value or LF[i]
+                for (size_type k=0; k < work.size(); ++k) {
+                    size_type i = work[k].first;
+                    if (i != prev_i) { // resolve position once per round
+                        size_type tidx = m_cst->tlcp_idx(i);
+                        prev_val = m_small_lcp[tidx];
+                        if (254 == prev_val) {        // reducible
+                            prev_aux = m_cst->csa.lf[i];
+                        } else if (255 == prev_val) { // big and sampled
+                            prev_aux = m_big_lcp[m_small_lcp.rank(tidx, 255)];
+                        }
+                        prev_i = i;
+                    }
+                    size_type id = work[k].second;
+                    if (prev_val < 254) {
+                        res[id] = prev_val;
+                    } else if (254 == prev_val) {
+                        ++offset[id];
+                        next_work.emplace_back(prev_aux, id);
+                    } else {
+                        res[id] = prev_aux - offset[id];
+                    }
+                }
+                work.swap(next_work);
+            }
+        }
+
         //! Serialize to a stream.
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
         {
@@ -0,0 +1,206 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file loser_tree.hpp
+    \brief loser_tree.hpp contains a loser tree for k-way merging of
+           sorted streams and a merge routine for sorted int_vector files.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_LOSER_TREE
+#define INCLUDED_SDSL_LOSER_TREE
+
+#include "int_vector_buffer.hpp"
+#include "construct_config.hpp"
+#include <string>
+#include <vector>
+
+namespace sdsl
+{
+
+//! A loser tree for k-way merging of sorted sources.
+/*! Each pop costs only \f$\log k\f$ comparisons, as opposed to the
+ *  \f$2\log k\f$ of a binary heap, since only the path from the popped
+ *  leaf to the root is replayed. Equal keys are emitted in source
+ *  order, so the merge is stable.
+ *
+ * \tparam t_source Source type; must provide `value_type`,
+ *                  `bool empty() const`, `value_type front() const`
+ *                  and `void pop()`.
+ */
+template<class t_source>
+class loser_tree
+{
+    public:
+        typedef uint64_t                      size_type;
+        typedef typename t_source::value_type value_type;
+
+    private:
+        std::vector<t_source>& m_source;
+        std::vector<size_type> m_tree;  // m_tree[0] = index of the winner,
+        // m_tree[1..m_k-1] = indices of the losers of the internal nodes
+        size_type              m_k = 0; // number of leaves, power of two
+
+        // compares the fronts of two sources; an empty source loses
+        // against everything, ties are broken by source index
+        bool source_less(size_type a, size_type b) const
+        {
+            bool a_empty = a >= m_source.size() or m_source[a].empty();
+            bool b_empty = b >= m_source.size() or m_source[b].empty();
+            if (a_empty or b_empty) {
+                return !a_empty;
+            }
+            if (m_source[a].front() != m_source[b].front()) {
+                return m_source[a].front() < m_source[b].front();
+            }
+            return a < b;
+        }
+
+        // plays the initial tournament of the subtree rooted at `node`
+        // and returns the index of its winner
+        size_type init_winner(size_type node)
+        {
+            if (node >= m_k) {
+                return node-m_k;
+            }
+            size_type left  = init_winner(2*node);
+            size_type right = init_winner(2*node+1);
+            if (source_less(left, right)) {
+                m_tree[node] = right;
+                return left;
+            }
+            m_tree[node] = left;
+            return right;
+        }
+
+    public:
+        //! Constructor; plays the initial tournament over the sources.
+        loser_tree(std::vector<t_source>& sources) : m_source(sources)
+        {
+            m_k = 1;
+            while (m_k < m_source.size()) {
+                m_k <<= 1;
+            }
+            m_tree = std::vector<size_type>(m_k, 0);
+            m_tree[0] = init_winner(1);
+        }
+
+        //! Returns true if all sources are exhausted.
+        bool empty() const
+        {
+            return m_tree[0] >= m_source.size() or m_source[m_tree[0]].empty();
+        }
+
+        //! Returns the smallest front value of the sources.
+        value_type front() const
+        {
+            return m_source[m_tree[0]].front();
+        }
+
+        //! Advances the winning source and replays its path to the root.
+        void pop()
+        {
+            size_type winner = m_tree[0];
+            m_source[winner].pop();
+            for (size_type node = (winner+m_k)/2; node > 0; node /= 2) {
+                if (source_less(m_tree[node], winner)) {
+                    std::swap(winner, m_tree[node]);
+                }
+            }
+            m_tree[0] = winner;
+        }
+};
+
+//! Buffered source which reads a sorted run from an int_vector file.
+class int_vector_file_source
+{
+    public:
+        typedef uint64_t value_type;
+
+    private:
+        int_vector_buffer<> m_buf;
+        uint64_t            m_idx = 0;
+
+    public:
+        int_vector_file_source() {}
+
+        //! Constructor
+        /*! \param file        Name of the int_vector file.
+         *  \param buffer_size Buffer size in bytes; reads are batched in
+         *                     blocks of this size.
+         *  \param async       Enable asynchronous read-ahead.
+         */
+        int_vector_file_source(const std::string& file,
+                               uint64_t buffer_size=1024*1024,
+                               bool async=false) :
+            m_buf(file, std::ios::in, buffer_size)
+        {
+            if (async) {
+                m_buf.async_io(true);
+            }
+        }
+
+        uint8_t width() const { return m_buf.width(); }
+        uint64_t size() const { return m_buf.size(); }
+        bool empty() const { return m_idx >= m_buf.size(); }
+        value_type front() { return m_buf[m_idx]; }
+        void pop() { ++m_idx; }
+};
+
+//! Merges sorted int_vector files into one sorted int_vector file.
+/*! \param in_files    Names of the input files; each must contain a sorted
+ *                     int_vector<> run.
+ *  \param out_file    Name of the output file.
+ *  \param buffer_size Buffer size in bytes per stream; 0 = the value of
+ *                     construct_config::io_buffer_size (or 1 MiB if that
+ *                     is also 0). Reads and writes are batched in blocks
+ *                     of this size.
+ *
+ *  Up to construct_config::io_async_streams of the input streams prefetch
+ *  their next block asynchronously, which keeps more requests in flight
+ *  on flash storage.
+ */
+inline void merge_sorted_int_vector_files(const std::vector<std::string>& in_files,
+        const std::string& out_file,
+        uint64_t buffer_size=0)
+{
+    if (0 == buffer_size) {
+        buffer_size = construct_config::io_buffer_size;
+        if (0 == buffer_size) {
+            buffer_size = 1024*1024;
+        }
+    }
+    uint64_t async_budget = construct_config::io_async_streams;
+    std::vector<int_vector_file_source> sources(in_files.size());
+    uint8_t width = 64;
+    for (uint64_t i=0; i < in_files.size(); ++i) {
+        sources[i] = int_vector_file_source(in_files[i], buffer_size,
+                                            async_budget > 0);
+        if (async_budget > 0) {
+            --async_budget;
+        }
+        width = i ? std::max(width, sources[i].width()) : sources[i].width();
+    }
+    int_vector_buffer<> out(out_file, std::ios::out, buffer_size, width);
+    loser_tree<int_vector_file_source> tree(sources);
+    while (!tree.empty()) {
+        out.push_back(tree.front());
+        tree.pop();
+    }
+    out.close();
+}
+
+} // end namespace sdsl
+#endif
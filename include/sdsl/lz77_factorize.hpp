@@ -0,0 +1,138 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file lz77_factorize.hpp
+    \brief lz77_factorize.hpp computes the LZ77 parse of a cached text
+           from its cached suffix array.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_LZ77_FACTORIZE
+#define INCLUDED_SDSL_LZ77_FACTORIZE
+
+#include <algorithm>
+#include <vector>
+#include "int_vector.hpp"
+#include "int_vector_buffer.hpp"
+#include "config.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! Computes the LZ77 factorization of a cached byte text.
+/*! \param config Cache configuration with the byte text (conf::KEY_TEXT)
+ *                and its suffix array (conf::KEY_SA) present, e.g.
+ *                produced by construct_sa<8>.
+ *  \param report Functor called once per factor in text order, as
+ *                report(val, len): a copy factor has source position
+ *                val and length len > 0 (sources may overlap the
+ *                factor, i.e. the parse is self-referential), a
+ *                literal has val = character and len = 0.
+ *  \return The number z of factors.
+ *
+ *  KKP-style parse: a single pass over the cached suffix array fills
+ *  the PSV/NSV arrays (the starting positions of the
+ *  lexicographically nearest suffixes which start earlier in the
+ *  text) with one monotonic stack, and the longest previous factor at
+ *  each phrase boundary is the longer of the character-wise extensions
+ *  with those two candidates. The trailing sentinel of the cached text
+ *  is not part of the parse.
+ *
+ *  \par Space complexity
+ *       \f$ 2n\log n \f$ bits for PSV/NSV plus the \f$ n \f$ byte text;
+ *       the suffix array itself is streamed from the cache.
+ *  \par Time complexity
+ *       \f$ \Order{n} \f$: every text position takes part in at most
+ *       two character comparisons per candidate.
+ */
+template<class t_report>
+int_vector<>::size_type
+lz77_factorize(cache_config& config, t_report&& report)
+{
+    typedef int_vector<>::size_type size_type;
+    int_vector<8> text;
+    load_from_cache(text, conf::KEY_TEXT, config);
+    size_type n = text.size() > 0 ? text.size()-1 : 0; // drop the sentinel
+    if (0 == n) {
+        return 0;
+    }
+    const size_type undef = n;
+    int_vector<> psv(n, undef, bits::hi(n)+1);
+    int_vector<> nsv(n, undef, bits::hi(n)+1);
+    {
+        int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+        std::vector<size_type> stack;
+        for (size_type r=0; r < sa_buf.size(); ++r) {
+            size_type s = sa_buf[r];
+            if (s >= n) { // sentinel suffix
+                continue;
+            }
+            while (!stack.empty() and stack.back() > s) {
+                nsv[stack.back()] = s;
+                stack.pop_back();
+            }
+            psv[s] = stack.empty() ? undef : stack.back();
+            stack.push_back(s);
+        }
+    }
+    size_type z = 0;
+    size_type k = 0;
+    while (k < n) {
+        size_type p1 = psv[k], p2 = nsv[k];
+        size_type len1 = 0, len2 = 0;
+        if (p1 != undef) {
+            while (k+len1 < n and text[p1+len1] == text[k+len1]) {
+                ++len1;
+            }
+        }
+        if (p2 != undef) {
+            while (k+len2 < n and text[p2+len2] == text[k+len2]) {
+                ++len2;
+            }
+        }
+        size_type len = std::max(len1, len2);
+        if (0 == len) {
+            report((size_type)text[k], (size_type)0);
+            ++k;
+        } else {
+            report(len1 >= len2 ? p1 : p2, len);
+            k += len;
+        }
+        ++z;
+    }
+    return z;
+}
+
+//! Computes the LZ77 parse and returns it as a factor list.
+/*! \param config Cache configuration, \sa lz77_factorize.
+ *  \return Vector of (val, len) pairs; len = 0 marks a literal with
+ *          character val.
+ */
+inline std::vector<std::pair<int_vector<>::size_type, int_vector<>::size_type>>
+lz77_parse(cache_config& config)
+{
+    typedef int_vector<>::size_type size_type;
+    std::vector<std::pair<size_type, size_type>> factors;
+    lz77_factorize(config, [&factors](size_type val, size_type len) {
+        factors.emplace_back(val, len);
+    });
+    return factors;
+}
+
+} // end namespace sdsl
+
+#endif // end file
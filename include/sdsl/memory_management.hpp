@@ -9,8 +9,12 @@
 #include "util.hpp"
 
 #include <map>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include <chrono>
 #include <cstddef>
 #include <fstream>
@@ -21,13 +25,46 @@
 
 #ifdef MSVC_COMPILER
 // windows.h has min/max macro which causes problems when using std::min/max
-#define NOMINMAX 
+#define NOMINMAX
 #include <windows.h>
 #include <io.h>
 #else
 #include <sys/mman.h>
 #endif
 
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef __NR_perf_event_open
+#include <linux/perf_event.h>
+#define SDSL_PERF_EVENTS
+#endif
+// raw mbind/get_mempolicy interface so no libnuma dependency is needed
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+#define SDSL_NUMA_POLICY
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+#ifndef MPOL_F_NODE
+#define MPOL_F_NODE (1<<0)
+#endif
+#ifndef MPOL_F_ADDR
+#define MPOL_F_ADDR (1<<1)
+#endif
+#ifndef MPOL_F_MEMS_ALLOWED
+#define MPOL_F_MEMS_ALLOWED (1<<2)
+#endif
+#endif
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h> // malloc_usable_size, for migrating blocks into an arena
+#endif
+
 namespace sdsl
 {
 
@@ -36,6 +73,111 @@ class memory_monitor;
 template<format_type F>
 void write_mem_log(std::ostream& out, const memory_monitor& m);
 
+//! One reading of the monitored hardware performance counters.
+/*! A value of -1 means the counter could not be read. */
+struct mm_perf_sample {
+    int64_t cycles      = -1;
+    int64_t llc_misses  = -1;
+    int64_t dtlb_misses = -1;
+};
+
+// Hardware counter sampling via perf_event_open, used by memory_monitor
+// to attribute cycles, LLC misses and dTLB misses to mm_event phases.
+// All calls are best effort and turn into no-ops on builds or kernels
+// without the perf interface (e.g. perf_event_paranoid > 2).
+class perf_event_support
+{
+    private:
+        friend class memory_monitor;
+        int m_fd[3] = {-1, -1, -1};
+        static perf_event_support& the_support()
+        {
+            static perf_event_support p;
+            return p;
+        }
+#ifdef SDSL_PERF_EVENTS
+        static int open_counter(uint32_t type, uint64_t config)
+        {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type           = type;
+            attr.size           = sizeof(attr);
+            attr.config         = config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+        static int64_t read_counter(int fd)
+        {
+            long long count = -1;
+            if (fd < 0 or read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+                return -1;
+            }
+            return count;
+        }
+#endif
+    public:
+        static void open()
+        {
+#ifdef SDSL_PERF_EVENTS
+            auto& p = the_support();
+            if (p.m_fd[0] >= 0) {
+                return; // already open
+            }
+            p.m_fd[0] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            p.m_fd[1] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            p.m_fd[2] = open_counter(PERF_TYPE_HW_CACHE,
+                                     PERF_COUNT_HW_CACHE_DTLB
+                                     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+        }
+        static void close()
+        {
+#ifdef SDSL_PERF_EVENTS
+            auto& p = the_support();
+            for (int i=0; i < 3; ++i) {
+                if (p.m_fd[i] >= 0) {
+                    ::close(p.m_fd[i]);
+                    p.m_fd[i] = -1;
+                }
+            }
+#endif
+        }
+        static bool active()
+        {
+            return the_support().m_fd[0] >= 0;
+        }
+        //! Current absolute counter values.
+        static mm_perf_sample sample()
+        {
+            mm_perf_sample s;
+#ifdef SDSL_PERF_EVENTS
+            auto& p = the_support();
+            s.cycles      = read_counter(p.m_fd[0]);
+            s.llc_misses  = read_counter(p.m_fd[1]);
+            s.dtlb_misses = read_counter(p.m_fd[2]);
+#endif
+            return s;
+        }
+        //! Counter deltas between two samples; -1 propagates.
+        static mm_perf_sample diff(const mm_perf_sample& begin,
+                                   const mm_perf_sample& end)
+        {
+            mm_perf_sample d;
+            if (begin.cycles >= 0 and end.cycles >= 0) {
+                d.cycles = end.cycles - begin.cycles;
+            }
+            if (begin.llc_misses >= 0 and end.llc_misses >= 0) {
+                d.llc_misses = end.llc_misses - begin.llc_misses;
+            }
+            if (begin.dtlb_misses >= 0 and end.dtlb_misses >= 0) {
+                d.dtlb_misses = end.dtlb_misses - begin.dtlb_misses;
+            }
+            return d;
+        }
+};
+
 class memory_monitor
 {
     public:
@@ -48,9 +190,21 @@ class memory_monitor
         struct mm_event {
             std::string name;
             std::vector<mm_alloc> allocations;
+            mm_perf_sample perf_start; // counters at phase begin
+            mm_perf_sample perf;       // counter deltas of the phase
             mm_event(std::string n, int64_t usage) : name(n)
             {
                 allocations.emplace_back(timer::now(), usage);
+                if (perf_event_support::active()) {
+                    perf_start = perf_event_support::sample();
+                }
+            }
+            void close_perf()
+            {
+                if (perf_start.cycles >= 0) {
+                    perf = perf_event_support::diff(perf_start,
+                                                    perf_event_support::sample());
+                }
             }
             bool operator< (const mm_event& a) const
             {
@@ -64,15 +218,71 @@ class memory_monitor
                 return true;
             }
         };
+        // aggregated view of one mm_event phase in sampling mode: the peak
+        // plus a fixed-size ring buffer of the most recent usage samples
+        struct mm_event_stats {
+            std::string name;
+            int64_t peak = 0;          // highest usage seen during the phase
+            int64_t last = 0;          // usage at the end of the phase
+            size_t samples = 0;        // number of usage samples taken
+            std::vector<int64_t> ring; // most recent samples
+            size_t ring_pos = 0;
+            mm_perf_sample perf_start; // counters at phase begin
+            mm_perf_sample perf;       // counter deltas of the phase
+            mm_event_stats(std::string n, int64_t usage) : name(n)
+            {
+                add_sample(usage, 1);
+                if (perf_event_support::active()) {
+                    perf_start = perf_event_support::sample();
+                }
+            }
+            void close_perf()
+            {
+                if (perf_start.cycles >= 0) {
+                    perf = perf_event_support::diff(perf_start,
+                                                    perf_event_support::sample());
+                }
+            }
+            void add_sample(int64_t usage, size_t capacity)
+            {
+                if (usage > peak) {
+                    peak = usage;
+                }
+                if (ring.size() < capacity) {
+                    ring.push_back(usage);
+                } else {
+                    ring[ring_pos] = usage;
+                    ring_pos = (ring_pos+1) % ring.size();
+                }
+                ++samples;
+                last = usage;
+            }
+            int64_t percentile(double p) const
+            {
+                if (ring.empty()) {
+                    return 0;
+                }
+                std::vector<int64_t> sorted(ring);
+                std::sort(sorted.begin(), sorted.end());
+                size_t k = static_cast<size_t>((p/100.0)*(sorted.size()-1) + 0.5);
+                return sorted[k];
+            }
+        };
         struct mm_event_proxy {
             bool add;
+            bool sampled;
             timer::time_point created;
-            mm_event_proxy(const std::string& name, int64_t usage, bool a) : add(a)
+            mm_event_proxy(const std::string& name, int64_t usage, bool a) : add(a), sampled(false)
             {
                 if (add) {
                     auto& m = the_monitor();
                     std::lock_guard<util::spin_lock> lock(m.spinlock);
-                    m.event_stack.emplace(name, usage);
+                    sampled = m.sampling;
+                    if (sampled) {
+                        m.stats_stack.emplace(name, usage);
+                    } else {
+                        m.event_stack.emplace(name, usage);
+                    }
                 }
             }
             ~mm_event_proxy()
@@ -80,9 +290,20 @@ class memory_monitor
                 if (add) {
                     auto& m = the_monitor();
                     std::lock_guard<util::spin_lock> lock(m.spinlock);
+                    if (sampled) {
+                        if (!m.stats_stack.empty()) {
+                            auto& cur = m.stats_stack.top();
+                            cur.add_sample(m.current_usage, m.ring_capacity);
+                            cur.close_perf();
+                            m.completed_stats.emplace_back(std::move(cur));
+                            m.stats_stack.pop();
+                        }
+                        return;
+                    }
                     auto& cur = m.event_stack.top();
                     auto cur_time = timer::now();
                     cur.allocations.emplace_back(cur_time, m.current_usage);
+                    cur.close_perf();
                     m.completed_events.emplace_back(std::move(cur));
                     m.event_stack.pop();
                     // add a point to the new "top" with the same memory
@@ -99,8 +320,13 @@ class memory_monitor
         std::chrono::milliseconds log_granularity = std::chrono::milliseconds(20ULL);
         int64_t current_usage = 0;
         bool track_usage = false;
+        bool sampling = false;
+        size_t ring_capacity = 1024; // samples kept per phase in sampling mode
         std::vector<mm_event> completed_events;
         std::stack<mm_event> event_stack;
+        std::vector<mm_event_stats> completed_stats;
+        std::stack<mm_event_stats> stats_stack;
+        std::atomic<int64_t> usage_peak{0};
         timer::time_point start_log;
         timer::time_point last_event;
         util::spin_lock spinlock;
@@ -130,7 +356,7 @@ class memory_monitor
         static int64_t peak()
         {
             auto& m = the_monitor();
-            int64_t max = 0;
+            int64_t max = m.usage_peak.load(std::memory_order_relaxed);
             for (auto events : m.completed_events) {
                 for (auto alloc : events.allocations) {
                     if (max < alloc.usage) {
@@ -152,18 +378,34 @@ class memory_monitor
             while (m.event_stack.size()) {
                 m.event_stack.pop();
             }
+            m.completed_stats.clear();
+            while (m.stats_stack.size()) {
+                m.stats_stack.pop();
+            }
             m.start_log = timer::now();
             m.current_usage = 0;
+            m.usage_peak.store(0, std::memory_order_relaxed);
             m.last_event = m.start_log;
-            m.event_stack.emplace("unknown", 0);
+            if (m.sampling) {
+                m.stats_stack.emplace("unknown", 0);
+            } else {
+                m.event_stack.emplace("unknown", 0);
+            }
         }
         static void stop()
         {
             auto& m = the_monitor();
             while (!m.event_stack.empty()) {
+                m.event_stack.top().close_perf();
                 m.completed_events.emplace_back(std::move(m.event_stack.top()));
                 m.event_stack.pop();
             }
+            while (!m.stats_stack.empty()) {
+                m.stats_stack.top().add_sample(m.current_usage, m.ring_capacity);
+                m.stats_stack.top().close_perf();
+                m.completed_stats.emplace_back(std::move(m.stats_stack.top()));
+                m.stats_stack.pop();
+            }
             m.track_usage = false;
         }
         static void record(int64_t delta)
@@ -171,6 +413,18 @@ class memory_monitor
             auto& m = the_monitor();
             if (m.track_usage) {
                 std::lock_guard<util::spin_lock> lock(m.spinlock);
+                if (m.sampling) {
+                    m.current_usage = m.current_usage + delta;
+                    if (m.current_usage > m.usage_peak.load(std::memory_order_relaxed)) {
+                        m.usage_peak.store(m.current_usage, std::memory_order_relaxed);
+                    }
+                    auto cur = timer::now();
+                    if (m.last_event + m.log_granularity < cur and !m.stats_stack.empty()) {
+                        m.stats_stack.top().add_sample(m.current_usage, m.ring_capacity);
+                        m.last_event = cur;
+                    }
+                    return;
+                }
                 auto cur = timer::now();
                 if (m.last_event + m.log_granularity < cur) {
                     m.event_stack.top().allocations.emplace_back(cur, m.current_usage);
@@ -199,6 +453,225 @@ class memory_monitor
         {
             write_mem_log<F>(out, the_monitor());
         }
+        //! Switch the monitor to low-overhead sampling mode.
+        /*! Instead of recording every allocation event with a timestamp,
+         *  sampling mode aggregates each mm_event phase into its peak usage
+         *  and a fixed-size ring buffer of the most recent usage samples
+         *  (taken at the configured granularity). Monitoring the
+         *  construct() of a huge index then keeps O(phases * ring_size)
+         *  data instead of one entry per allocation, so it can stay enabled
+         *  in production. Toggle before start().
+         *  \param enable    Switch sampling mode on or off.
+         *  \param ring_size Number of samples kept per phase.
+         */
+        static void use_sampling(bool enable = true, size_t ring_size = 1024)
+        {
+            auto& m = the_monitor();
+            m.sampling = enable;
+            if (ring_size > 0) {
+                m.ring_capacity = ring_size;
+            }
+        }
+        //! Enable hardware counter sampling per mm_event phase.
+        /*! While enabled, every phase additionally records the cycles,
+         *  last-level cache misses and dTLB read misses it consumed
+         *  (perf_event_open, user space only). The counts are inclusive:
+         *  a phase also contains the work of its nested phases. The
+         *  values appear in the JSON/HTML memory reports and in
+         *  write_sampling_report(), so a construct() regression can be
+         *  attributed to cache or TLB behaviour without rerunning under
+         *  an external profiler. Toggle before start(); best effort:
+         *  without the perf interface (non-Linux kernels or
+         *  perf_event_paranoid > 2) the counters simply stay at -1.
+         *  \param enable Switch counter sampling on or off.
+         */
+        static void use_perf_counters(bool enable = true)
+        {
+            if (enable) {
+                perf_event_support::open();
+            } else {
+                perf_event_support::close();
+            }
+        }
+        //! Current peak usage in bytes while sampling; lock-free, safe to poll from another thread.
+        static int64_t live_peak()
+        {
+            return the_monitor().usage_peak.load(std::memory_order_relaxed);
+        }
+        //! Write the per-phase aggregates collected in sampling mode.
+        /*! One line per completed phase: sample count, peak, the 50th/90th/99th
+         *  usage percentiles over the ring buffer, and the usage at phase end.
+         */
+        static void write_sampling_report(std::ostream& out)
+        {
+            auto& m = the_monitor();
+            for (const auto& s : m.completed_stats) {
+                out << s.name << ": samples=" << s.samples
+                    << " peak=" << s.peak
+                    << " p50=" << s.percentile(50)
+                    << " p90=" << s.percentile(90)
+                    << " p99=" << s.percentile(99)
+                    << " final=" << s.last;
+                if (s.perf.cycles >= 0) {
+                    out << " cycles=" << s.perf.cycles
+                        << " llc_misses=" << s.perf.llc_misses
+                        << " dtlb_misses=" << s.perf.dtlb_misses;
+                }
+                out << std::endl;
+            }
+        }
+};
+
+//! Allocation profiler which attributes int_vector memory to structure paths.
+/*! memory_monitor shows when a peak happens; this profiler shows which
+ *  member it belongs to. While enabled, every allocation flowing through
+ *  memory_manager::resize/clear is tagged with the current scope path of
+ *  the calling thread — a '/'-joined stack of names pushed with scoped
+ *  memory_profiler::scope objects, by convention the same names the
+ *  structure uses in its serialize() structure_tree. Frees are matched
+ *  by pointer, so a block is always subtracted from the path it was
+ *  allocated under, no matter where it dies.
+ *
+ *  \code
+ *  memory_profiler::start();
+ *  {
+ *      memory_profiler::scope s("lcp_support_tree2");
+ *      construct(lcp, file, config, 0);
+ *  }
+ *  memory_profiler::write_report(std::cout); // live/peak bytes per path
+ *  memory_profiler::stop();
+ *  \endcode
+ *
+ *  The bookkeeping takes a mutex per allocation; int_vector allocations
+ *  are block-sized and rare, so this is not measurable in construction
+ *  time. Disabled, the hooks are one relaxed atomic load.
+ */
+class memory_profiler
+{
+    public:
+        friend class memory_manager;
+
+        struct path_stats {
+            int64_t  live = 0;   //!< currently allocated bytes
+            int64_t  peak = 0;   //!< maximum of live over the run
+            uint64_t allocs = 0; //!< number of allocations
+        };
+
+    private:
+        std::atomic<bool> m_active;
+        std::mutex        m_mutex;  // protects the two maps
+        std::map<std::string, path_stats>                  m_stats;
+        std::map<const void*, std::pair<int64_t, std::string>> m_blocks;
+
+        memory_profiler() : m_active(false) {}
+
+        static memory_profiler& the_profiler()
+        {
+            static memory_profiler p;
+            return p;
+        }
+
+        static std::vector<std::string>& the_path()
+        {
+            static thread_local std::vector<std::string> path;
+            return path;
+        }
+
+        static std::string current_path()
+        {
+            auto& path = the_path();
+            if (path.empty()) {
+                return "[unattributed]";
+            }
+            std::string res = path[0];
+            for (size_t i=1; i < path.size(); ++i) {
+                res += "/" + path[i];
+            }
+            return res;
+        }
+
+        // called by memory_manager::resize/clear; ptr_old==nullptr is an
+        // allocation, bytes==0 with ptr_new==nullptr a free. The block
+        // keeps the path it was first allocated under.
+        static void on_realloc(const void* ptr_old, const void* ptr_new,
+                               int64_t bytes)
+        {
+            auto& p = the_profiler();
+            std::lock_guard<std::mutex> lock(p.m_mutex);
+            std::string path = current_path();
+            auto it = (ptr_old == nullptr) ? p.m_blocks.end()
+                                           : p.m_blocks.find(ptr_old);
+            if (it != p.m_blocks.end()) {
+                path = it->second.second;
+                p.m_stats[path].live -= it->second.first;
+                p.m_blocks.erase(it);
+            }
+            if (ptr_new != nullptr and bytes > 0) {
+                path_stats& s = p.m_stats[path];
+                s.live += bytes;
+                s.peak  = std::max(s.peak, s.live);
+                ++s.allocs;
+                p.m_blocks[ptr_new] = {bytes, path};
+            }
+        }
+
+    public:
+        //! Opens a path component for the lifetime of the object.
+        class scope
+        {
+            public:
+                scope(const scope&) = delete;
+                scope& operator=(const scope&) = delete;
+                scope(const std::string& name)
+                {
+                    the_path().push_back(name);
+                }
+                ~scope()
+                {
+                    the_path().pop_back();
+                }
+        };
+
+        //! Starts profiling; previous statistics are discarded.
+        static void start()
+        {
+            auto& p = the_profiler();
+            std::lock_guard<std::mutex> lock(p.m_mutex);
+            p.m_stats.clear();
+            p.m_blocks.clear();
+            p.m_active = true;
+        }
+
+        //! Stops profiling; the statistics stay available for reporting.
+        static void stop()
+        {
+            the_profiler().m_active = false;
+        }
+
+        static bool active()
+        {
+            return the_profiler().m_active.load(std::memory_order_relaxed);
+        }
+
+        //! One line per path, sorted by peak bytes descending:
+        //! path;live_bytes;peak_bytes;allocs
+        static void write_report(std::ostream& out)
+        {
+            auto& p = the_profiler();
+            std::lock_guard<std::mutex> lock(p.m_mutex);
+            std::vector<std::pair<std::string, path_stats>> rows(
+                p.m_stats.begin(), p.m_stats.end());
+            std::sort(rows.begin(), rows.end(),
+                      [](const std::pair<std::string, path_stats>& a,
+                         const std::pair<std::string, path_stats>& b) {
+                          return a.second.peak > b.second.peak;
+                      });
+            out << "path;live_bytes;peak_bytes;allocs" << std::endl;
+            for (const auto& r : rows) {
+                out << r.first << ";" << r.second.live << ";"
+                    << r.second.peak << ";" << r.second.allocs << std::endl;
+            }
+        }
 };
 
 #pragma pack(push, 1)
@@ -214,6 +687,71 @@ typedef struct bfoot {
 #pragma pack(pop)
 
 
+//! NUMA placement policy for the hugepage pool.
+enum numa_policy_type {
+    numa_first_touch = 0, //!< kernel default: a page lands on the node of the thread that first writes it
+    numa_interleave  = 1, //!< spread pages round-robin over all allowed nodes
+    numa_bind        = 2  //!< place all pages on one fixed node
+};
+
+// NUMA support built directly on the mbind/get_mempolicy syscalls, so no
+// libnuma dependency is needed. All calls are best effort and turn into
+// no-ops on builds or kernels without a NUMA policy interface.
+class numa_support
+{
+    private:
+        friend class memory_manager;
+        numa_policy_type m_policy = numa_first_touch;
+        int m_node = 0;
+        static numa_support& the_support()
+        {
+            static numa_support n;
+            return n;
+        }
+    public:
+        // apply the configured policy to a freshly mapped region
+        static void apply(void* addr, size_t len)
+        {
+#ifdef SDSL_NUMA_POLICY
+            auto& n = the_support();
+            if (n.m_policy == numa_first_touch) {
+                return; // first-touch is the kernel default
+            }
+            unsigned long mask = 0;
+            int mode = 0;
+            if (n.m_policy == numa_bind) {
+                mode = MPOL_BIND;
+                mask = 1UL << n.m_node;
+            } else {
+                mode = MPOL_INTERLEAVE;
+                // interleave over all nodes the process may allocate on
+                int dummy = 0;
+                if (syscall(SYS_get_mempolicy, &dummy, &mask, sizeof(mask)*8,
+                            nullptr, MPOL_F_MEMS_ALLOWED) != 0 or mask == 0) {
+                    return;
+                }
+            }
+            syscall(SYS_mbind, addr, len, mode, &mask, sizeof(mask)*8, 0);
+#else
+            (void)addr; (void)len;
+#endif
+        }
+        //! Returns the node the page containing `ptr` resides on, or -1 if unknown.
+        static int node_of(const void* ptr)
+        {
+#ifdef SDSL_NUMA_POLICY
+            int node = -1;
+            if (syscall(SYS_get_mempolicy, &node, nullptr, 0,
+                        const_cast<void*>(ptr), MPOL_F_NODE | MPOL_F_ADDR) == 0) {
+                return node;
+            }
+#else
+            (void)ptr;
+#endif
+            return -1;
+        }
+};
+
 #ifndef MSVC_COMPILER
 class hugepage_allocator
 {
@@ -253,6 +791,7 @@ class hugepage_allocator
                 // init the allocator
                 m_top = m_base;
                 m_first_block = (mm_block_t*)m_base;
+                numa_support::apply(m_base, m_total_size);
             }
         }
 #endif
@@ -280,22 +819,125 @@ class hugepage_allocator
 
 class memory_manager
 {
+    public:
+        // alignment used when aligned allocation is enabled; matches the
+        // cache line size of current x86/ARM implementations
+        static const size_t cache_line_size = 64;
     private:
         bool hugepages = false;
+        bool aligned = false;
+        bool pooling = false;
+        size_t pool_max_bytes    = 0; // upper bound for cached blocks, 0 = unlimited
+        size_t pool_cached_bytes = 0; // bytes currently cached in the free lists
+        std::multimap<size_t, uint64_t*> pool_free;  // freed blocks by size class
+        std::map<uint64_t*, size_t>      pool_sizes; // size class of live pool blocks
+        uint64_t* arena_base  = nullptr; // one contiguous block for co-located loads
+        size_t    arena_size  = 0;       // capacity of the arena in bytes
+        size_t    arena_pos   = 0;       // bump pointer into the arena
+        bool      arena_active = false;  // new allocations are carved from the arena
+        std::map<uint64_t*, size_t> arena_allocs; // live blocks inside the arena
     private:
         static memory_manager& the_manager()
         {
             static memory_manager m;
             return m;
         }
+        // round a request up to its size class: the next power of two for
+        // small blocks, the next multiple of 2 MiB for large ones
+        static size_t pool_size_class(size_t size_in_bytes)
+        {
+            const size_t large = 1ULL<<21;
+            if (size_in_bytes >= large) {
+                return (size_in_bytes + large - 1) & ~(large - 1);
+            }
+            size_t c = 64;
+            while (c < size_in_bytes) c <<= 1;
+            return c;
+        }
+        static void pool_release_all()
+        {
+            auto& m = the_manager();
+            for (auto& b : m.pool_free) {
+                m.pool_sizes.erase(b.second);
+                std::free(b.second);
+            }
+            m.pool_free.clear();
+            m.pool_cached_bytes = 0;
+        }
+        static bool in_arena(const uint64_t* ptr)
+        {
+            auto& m = the_manager();
+            return m.arena_base != nullptr and
+                   reinterpret_cast<uintptr_t>(ptr) >=
+                   reinterpret_cast<uintptr_t>(m.arena_base) and
+                   reinterpret_cast<uintptr_t>(ptr) <
+                   reinterpret_cast<uintptr_t>(m.arena_base) + m.arena_size;
+        }
+        // return the arena block once it is closed and the last structure
+        // living in it has been freed
+        static void arena_release_if_done()
+        {
+            auto& m = the_manager();
+            if (m.arena_base != nullptr and !m.arena_active
+                and m.arena_allocs.empty()) {
+                uint64_t* base = m.arena_base;
+                m.arena_base = nullptr;
+                m.arena_size = m.arena_pos = 0;
+                free_mem(base);
+            }
+        }
+#ifndef MSVC_COMPILER
+        static uint64_t* alloc_aligned_mem(size_t size_in_bytes)
+        {
+            void* ptr = nullptr;
+            if (posix_memalign(&ptr, cache_line_size, size_in_bytes) != 0) {
+                throw std::bad_alloc();
+            }
+            return static_cast<uint64_t*>(ptr);
+        }
+#endif
     public:
         static uint64_t* alloc_mem(size_t size_in_bytes)
         {
 #ifndef MSVC_COMPILER
             auto& m = the_manager();
+            if (m.arena_active and size_in_bytes > 0) {
+                size_t pos = (m.arena_pos + cache_line_size - 1)
+                             & ~(cache_line_size - 1);
+                if (pos + size_in_bytes <= m.arena_size) {
+                    uint64_t* ptr = reinterpret_cast<uint64_t*>(
+                                        reinterpret_cast<char*>(m.arena_base) + pos);
+                    m.arena_pos = pos + size_in_bytes;
+                    m.arena_allocs[ptr] = size_in_bytes;
+                    memset(ptr, 0, size_in_bytes);
+                    return ptr;
+                }
+                // arena exhausted: fall through, further allocations are
+                // served regularly and are merely not co-located
+            }
             if (m.hugepages) {
                 return static_cast<uint64_t*>(hugepage_allocator::the_allocator().mm_alloc(size_in_bytes));
             }
+            if (m.pooling and size_in_bytes > 0) {
+                size_t sc = pool_size_class(size_in_bytes);
+                auto it = m.pool_free.find(sc);
+                uint64_t* ptr;
+                if (it != m.pool_free.end()) { // reuse a cached block
+                    ptr = it->second;
+                    m.pool_free.erase(it);
+                    m.pool_cached_bytes -= sc;
+                } else {
+                    ptr = alloc_aligned_mem(sc);
+                    m.pool_sizes[ptr] = sc;
+                }
+                memset(ptr, 0, size_in_bytes);
+                return ptr;
+            }
+            if (m.aligned and size_in_bytes > 0) {
+                uint64_t* ptr = alloc_aligned_mem(size_in_bytes);
+                memset(ptr, 0, size_in_bytes);
+                return ptr;
+            }
 #endif
             return static_cast<uint64_t*>(calloc(size_in_bytes, 1));
         }
@@ -303,10 +945,31 @@ class memory_manager
         {
 #ifndef MSVC_COMPILER
             auto& m = the_manager();
+            if (in_arena(ptr)) {
+                m.arena_allocs.erase(ptr);
+                arena_release_if_done();
+                return;
+            }
             if (m.hugepages and hugepage_allocator::the_allocator().in_address_space(ptr)) {
                 hugepage_allocator::the_allocator().mm_free(ptr);
                 return;
             }
+            if (!m.pool_sizes.empty()) {
+                auto it = m.pool_sizes.find(ptr);
+                if (it != m.pool_sizes.end()) {
+                    size_t sc = it->second;
+                    if (m.pooling and
+                        (m.pool_max_bytes == 0 or m.pool_cached_bytes + sc <= m.pool_max_bytes)) {
+                        // keep the block for the next allocation of its class
+                        m.pool_free.emplace(sc, ptr);
+                        m.pool_cached_bytes += sc;
+                    } else {
+                        m.pool_sizes.erase(it);
+                        std::free(ptr);
+                    }
+                    return;
+                }
+            }
 #endif
             std::free(ptr);
         }
@@ -314,16 +977,83 @@ class memory_manager
         {
 #ifndef MSVC_COMPILER
             auto& m = the_manager();
+            if (in_arena(ptr)) {
+                size_t old_size = m.arena_allocs[ptr];
+                if (size <= old_size) { // still fits into the arena block
+                    return ptr;
+                }
+                uint64_t* new_ptr = alloc_mem(size); // stays co-located while
+                memcpy(new_ptr, ptr, old_size);      // the arena has room
+                free_mem(ptr);
+                return new_ptr;
+            }
+            if (m.arena_active) {
+                if (ptr == nullptr) { // fresh block: place it into the arena
+                    return alloc_mem(size);
+                }
+#ifdef __GLIBC__
+                // int_vector grows via realloc, so a vector which existed
+                // before the arena was opened holds a regular heap block;
+                // migrate it, otherwise nothing would ever be co-located
+                if (!(m.hugepages and
+                      hugepage_allocator::the_allocator().in_address_space(ptr))
+                    and 0 == m.pool_sizes.count(ptr)) {
+                    size_t old_size = malloc_usable_size(ptr);
+                    uint64_t* new_ptr = alloc_mem(size);
+                    memcpy(new_ptr, ptr, std::min(old_size, size));
+                    std::free(ptr);
+                    return new_ptr;
+                }
+#endif
+            }
             if (m.hugepages and hugepage_allocator::the_allocator().in_address_space(ptr)) {
                 return static_cast<uint64_t*>(hugepage_allocator::the_allocator().mm_realloc(ptr, size));
             }
+            if (!m.pool_sizes.empty() and m.pool_sizes.count(ptr)) {
+                size_t old_sc = m.pool_sizes[ptr];
+                if (size <= old_sc) { // still fits into the block's size class
+#ifdef __linux__
+                    // a large shrink (e.g. util::bit_compress of a temporary)
+                    // keeps the block, but whole pages of the unused tail can
+                    // be returned to the OS so RSS drops without a copy; the
+                    // pages refault zero-filled, which alloc_mem guarantees
+                    // for reused blocks anyway
+                    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                    uintptr_t keep = (reinterpret_cast<uintptr_t>(ptr) + size + page - 1) & ~(page-1);
+                    uintptr_t block_end = reinterpret_cast<uintptr_t>(ptr) + old_sc;
+                    if (block_end >= keep + page) {
+                        madvise(reinterpret_cast<void*>(keep), block_end - keep, MADV_DONTNEED);
+                    }
+#endif
+                    return ptr;
+                }
+                uint64_t* new_ptr = alloc_mem(size);
+                memcpy(new_ptr, ptr, old_sc);
+                free_mem(ptr);
+                return new_ptr;
+            }
 #endif
             uint64_t* temp = static_cast<uint64_t*>(realloc(ptr, size));
             if (!temp) {
                 throw std::bad_alloc();
             }
+#ifndef MSVC_COMPILER
+            if (the_manager().aligned and size > 0 and !is_aligned(temp)) {
+                // realloc may move the block to an unaligned address;
+                // copy it to a fresh cache-line-aligned one
+                uint64_t* aligned_ptr = alloc_aligned_mem(size);
+                memcpy(aligned_ptr, temp, size);
+                std::free(temp);
+                return aligned_ptr;
+            }
+#endif
             return temp;
         }
+        //! Returns true if `ptr` is aligned to an `alignment`-byte boundary.
+        static bool is_aligned(const void* ptr, size_t alignment = cache_line_size)
+        {
+            return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+        }
     public:
 #ifndef MSVC_COMPILER
 #ifdef MAP_HUGETLB
@@ -339,12 +1069,173 @@ class memory_manager
 //             throw std::runtime_error("hugepages not support on MSVC_COMPILER");
 #endif
 #endif
+        //! Enable or disable cache-line-aligned allocation.
+        /*! All subsequent int_vector allocations (and thus the counter
+         *  arrays of the rank/select support structures) are placed on
+         *  64-byte boundaries, so a basic block is never split across
+         *  two cache lines. Combine with use_hugepages() for
+         *  2MB-page-backed memory. Has no effect on MSVC.
+         */
+        static void use_aligned_allocation(bool enable = true)
+        {
+            the_manager().aligned = enable;
+        }
+        //! Enable or disable the block-recycling pool.
+        /*! While enabled, freed int_vector blocks are kept in per-size-class
+         *  free lists and handed out again instead of going back to the
+         *  system, so the repeated multi-GB allocate/free cycles of the
+         *  construct() phases stop paying mmap/munmap and soft page faults
+         *  for the same memory. Typical use brackets back-to-back index
+         *  builds:
+         *  \code
+         *  memory_manager::use_block_pool();
+         *  // ... construct(...) calls ...
+         *  memory_manager::use_block_pool(false); // releases cached blocks
+         *  \endcode
+         *  \param enable    Switch the pool on or off; switching it off
+         *                   returns all cached blocks to the system.
+         *  \param max_bytes Upper bound for the cached bytes (0 = unlimited).
+         *  Has no effect on MSVC and is bypassed while hugepages are active,
+         *  since hugepage_allocator keeps its own free lists.
+         */
+        static void use_block_pool(bool enable = true, size_t max_bytes = 0)
+        {
+#ifndef MSVC_COMPILER
+            auto& m = the_manager();
+            m.pooling = enable;
+            m.pool_max_bytes = max_bytes;
+            if (!enable) {
+                pool_release_all();
+            }
+#else
+            (void)enable; (void)max_bytes;
+#endif
+        }
+        //! Open a co-location arena of `bytes` bytes.
+        /*! Subsequent allocations are carved from one contiguous block in
+         *  the order they are made, each aligned to a cache line, until
+         *  close_arena() is called or the arena is full; allocations which
+         *  do not fit any more are served regularly and are merely not
+         *  co-located. The block itself is obtained through the regular
+         *  allocation path, so it is hugepage-backed if use_hugepages() is
+         *  active. It is returned to the system once the arena has been
+         *  closed and the last structure living in it has been freed.
+         *  Returns false if an arena is already open or the allocation
+         *  fails. See co_located<> for the intended use. Has no effect on
+         *  MSVC.
+         */
+        static bool open_arena(size_t bytes)
+        {
+#ifndef MSVC_COMPILER
+            auto& m = the_manager();
+            if (m.arena_base != nullptr or bytes == 0) { // one arena at a time
+                return false;
+            }
+            m.arena_base = alloc_mem(bytes);
+            if (m.arena_base == nullptr) {
+                return false;
+            }
+            m.arena_size   = bytes;
+            m.arena_pos    = 0;
+            m.arena_active = true;
+            return true;
+#else
+            (void)bytes;
+            return false;
+#endif
+        }
+        //! Stop carving allocations from the arena.
+        static void close_arena()
+        {
+#ifndef MSVC_COMPILER
+            auto& m = the_manager();
+            m.arena_active = false;
+            arena_release_if_done();
+#endif
+        }
+        //! Select the NUMA placement policy for the hugepage pool.
+        /*! Call before use_hugepages(); the policy is applied once, when the
+         *  pool mapping is created. numa_first_touch keeps the kernel
+         *  default (a page lands on the node of the thread that first writes
+         *  it, i.e. the construction thread), numa_interleave spreads the
+         *  pool round-robin over all allowed nodes, and numa_bind pins it to
+         *  `node`. Best effort: on kernels without a NUMA policy interface
+         *  the call has no effect.
+         */
+        static void set_numa_policy(numa_policy_type policy, int node = 0)
+        {
+            numa_support::the_support().m_policy = policy;
+            numa_support::the_support().m_node = node;
+        }
+        //! Returns the NUMA node backing `ptr`, or -1 if unknown.
+        static int numa_node_of(const void* ptr)
+        {
+            return numa_support::node_of(ptr);
+        }
+        //! Write a per-node placement report for the region [ptr, ptr+bytes).
+        /*! Queries the backing node of every page in the region and prints
+         *  one line per NUMA node with the byte count and share that lives
+         *  there; node `?` collects pages whose location is unknown (e.g.
+         *  non-NUMA kernels). Point it at the data() of a structure's large
+         *  arrays to see where an index physically lives.
+         */
+        static void write_placement(const void* ptr, size_t bytes, std::ostream& out)
+        {
+            out << "numa placement of " << bytes << " bytes:" << std::endl;
+            if (bytes == 0) {
+                return;
+            }
+            size_t page = 4096;
+#ifdef __linux__
+            long ps = sysconf(_SC_PAGESIZE);
+            if (ps > 0) {
+                page = static_cast<size_t>(ps);
+            }
+#endif
+            std::map<int, size_t> node_bytes;
+            uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+            uintptr_t end   = begin + bytes;
+            for (uintptr_t a = begin & ~(page-1); a < end; a += page) {
+                size_t len = std::min(end, a+page) - std::max(begin, a);
+                node_bytes[numa_support::node_of(reinterpret_cast<const void*>(std::max(begin, a)))] += len;
+            }
+            for (const auto& nb : node_bytes) {
+                out << "  node ";
+                if (nb.first < 0) {
+                    out << "?";
+                } else {
+                    out << nb.first;
+                }
+                out << " : " << nb.second << " bytes ("
+                    << (100.0*nb.second)/bytes << "%)" << std::endl;
+            }
+        }
         template<class t_vec>
         static void resize(t_vec& v, const typename t_vec::size_type size)
         {
             uint64_t old_size_in_bytes = ((v.m_size + 63) >> 6) << 3;
             uint64_t new_size_in_bytes = ((size + 63) >> 6) << 3;
             bool do_realloc = old_size_in_bytes != new_size_in_bytes;
+            if (v.m_mapped) {
+                // materialize a vector whose data is a read-only memory-mapped
+                // view (see map_from_file) before it can be resized or written
+                uint64_t* mapped_data = v.m_data;
+                size_t allocated_bytes = static_cast<size_t>(((v.m_size + 64) >> 6) << 3);
+                v.m_data = memory_manager::alloc_mem(allocated_bytes);
+                if (allocated_bytes != 0 && v.m_data == nullptr) {
+                    throw std::bad_alloc();
+                }
+                memcpy(v.m_data, mapped_data, old_size_in_bytes);
+                if (((v.m_size) % 64) == 0) {
+                    v.m_data[v.m_size / 64] = 0;
+                }
+                v.m_mapped = false;
+                memory_monitor::record(static_cast<int64_t>(old_size_in_bytes));
+                if (memory_profiler::active()) {
+                    memory_profiler::on_realloc(nullptr, v.m_data,
+                                                static_cast<int64_t>(old_size_in_bytes));
+                }
+            }
             v.m_size = size;
             if (do_realloc || v.m_data == nullptr) {
                 // Note that we allocate 8 additional bytes if m_size % 64 == 0.
@@ -352,10 +1243,15 @@ class memory_manager
                 // access to this padding to answer rank(size()) if size()%64 ==0.
                 // Note that this padding is not counted in the serialize method!
                 size_t allocated_bytes = static_cast<size_t>(((size + 64) >> 6) << 3);
+                uint64_t* old_data = v.m_data;
                 v.m_data = memory_manager::realloc_mem(v.m_data, allocated_bytes);
                 if (allocated_bytes != 0 && v.m_data == nullptr) {
                     throw std::bad_alloc();
                 }
+                if (memory_profiler::active()) {
+                    memory_profiler::on_realloc(old_data, v.m_data,
+                                                static_cast<int64_t>(new_size_in_bytes));
+                }
                 // update and fill with 0s
                 if (v.bit_size() < v.capacity()) {
                     uint8_t len = uint8_t(v.capacity() - v.bit_size());
@@ -376,8 +1272,17 @@ class memory_manager
         template<class t_vec>
         static void clear(t_vec& v)
         {
+            if (v.m_mapped) { // the mapping is owned by the mmap_source
+                v.m_data   = nullptr;
+                v.m_mapped = false;
+                v.m_size   = 0;
+                return;
+            }
             int64_t size_in_bytes = static_cast<int64_t>((v.m_size + 63) >> 6) << 3;
             // remove mem
+            if (memory_profiler::active()) {
+                memory_profiler::on_realloc(v.m_data, nullptr, 0);
+            }
             memory_manager::free_mem(v.m_data);
             v.m_data = nullptr;
 
@@ -400,8 +1305,9 @@ class memory_manager
             return -1;
         }
 
-        static void* mmap_file(int fd,uint64_t file_size, std::ios_base::openmode mode) {
+        static void* mmap_file(int fd,uint64_t file_size, std::ios_base::openmode mode, bool populate=false) {
 #ifdef MSVC_COMPILER
+            (void)populate; // no MAP_POPULATE equivalent
             HANDLE fh = (HANDLE)_get_osfhandle(fd);
             if (fh == INVALID_HANDLE_VALUE) {
                 return nullptr;
@@ -425,8 +1331,14 @@ class memory_manager
             return map;
 #else
             void* map = nullptr;
-            if (!(mode&std::ios_base::out)) map = mmap(nullptr,file_size,PROT_READ,MAP_SHARED,fd, 0);
-            else map = mmap(nullptr,file_size,PROT_READ | PROT_WRITE,MAP_SHARED,fd, 0);
+            int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+            if (populate) flags |= MAP_POPULATE; // eagerly fault in all pages
+#else
+            (void)populate;
+#endif
+            if (!(mode&std::ios_base::out)) map = mmap(nullptr,file_size,PROT_READ,flags,fd, 0);
+            else map = mmap(nullptr,file_size,PROT_READ | PROT_WRITE,flags,fd, 0);
             if(map == MAP_FAILED) map = nullptr; // unify windows and unix error behaviour
             return map;
 #endif
@@ -465,6 +1377,230 @@ class memory_manager
 
 };
 
+//! A read-only memory mapping of a complete file.
+/*! Used by map_from_file to back deserialized structures with the page
+ *  cache instead of fresh allocations. The mapping has to outlive every
+ *  structure which aliases it.
+ */
+class mmap_source
+{
+    private:
+        int      m_fd   = -1;
+        char*    m_data = nullptr;
+        uint64_t m_size = 0;
+
+    public:
+        mmap_source() {}
+
+        explicit mmap_source(const std::string& file)
+        {
+            open(file);
+        }
+
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+
+        mmap_source(mmap_source&& s)
+        {
+            *this = std::move(s);
+        }
+
+        mmap_source& operator=(mmap_source&& s)
+        {
+            if (this != &s) {
+                close();
+                m_fd     = s.m_fd;
+                m_data   = s.m_data;
+                m_size   = s.m_size;
+                s.m_fd   = -1;
+                s.m_data = nullptr;
+                s.m_size = 0;
+            }
+            return *this;
+        }
+
+        ~mmap_source()
+        {
+            close();
+        }
+
+        void open(const std::string& file)
+        {
+            close();
+            m_size = util::file_size(file);
+            if (0 == m_size) {
+                throw std::runtime_error("mmap_source: could not map empty or "
+                                         "missing file `" + file + "`");
+            }
+            std::string name = file;
+            m_fd = memory_manager::open_file_for_mmap(name, std::ios_base::in);
+            if (m_fd == -1) {
+                throw std::runtime_error("mmap_source: could not open file `"
+                                         + file + "`");
+            }
+            m_data = (char*)memory_manager::mmap_file(m_fd, m_size, std::ios_base::in);
+            if (nullptr == m_data) {
+                memory_manager::close_file_for_mmap(m_fd);
+                m_fd = -1;
+                throw std::runtime_error("mmap_source: could not map file `"
+                                         + file + "`");
+            }
+        }
+
+        void close()
+        {
+            if (m_data != nullptr) {
+                memory_manager::mem_unmap(m_data, m_size);
+                m_data = nullptr;
+            }
+            if (m_fd != -1) {
+                memory_manager::close_file_for_mmap(m_fd);
+                m_fd = -1;
+            }
+            m_size = 0;
+        }
+
+        const char* data() const
+        {
+            return m_data;
+        }
+
+        uint64_t size() const
+        {
+            return m_size;
+        }
+
+        //! Size up to which reads stay inside the mapped pages.
+        uint64_t readable_size() const
+        {
+            return (m_size + 0xFFFULL) & ~0xFFFULL;
+        }
+};
+
+//! A stream buffer which exposes a memory mapping as an istream source.
+/*! int_vector::load recognizes this buffer type and aliases word-aligned
+ *  payloads instead of copying them, see map_from_file.
+ */
+class mmap_istreambuf : public std::streambuf
+{
+    private:
+        char*    m_base = nullptr;
+        uint64_t m_size = 0;
+        uint64_t m_readable_size = 0;
+
+    protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override
+        {
+            if (!(which & std::ios_base::in)) {
+                return pos_type(off_type(-1));
+            }
+            off_type target = off;
+            if (std::ios_base::cur == dir) {
+                target += gptr() - eback();
+            } else if (std::ios_base::end == dir) {
+                target += (off_type)m_size;
+            }
+            if (target < 0 or target > (off_type)m_size) {
+                return pos_type(off_type(-1));
+            }
+            setg(m_base, m_base + target, m_base + m_size);
+            return pos_type(target);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+        {
+            return seekoff(off_type(pos), std::ios_base::beg, which);
+        }
+
+    public:
+        mmap_istreambuf() {}
+
+        mmap_istreambuf(const mmap_source& source)
+            : m_base(const_cast<char*>(source.data())), m_size(source.size()),
+              m_readable_size(source.readable_size())
+        {
+            setg(m_base, m_base, m_base + m_size);
+        }
+
+        char* base() const
+        {
+            return m_base;
+        }
+
+        //! Current read position relative to the begin of the mapping.
+        uint64_t offset() const
+        {
+            return gptr() - eback();
+        }
+
+        //! Size up to which reads stay inside the mapped pages.
+        uint64_t readable_size() const
+        {
+            return m_readable_size;
+        }
+};
+
+//! RAII owner of a structure loaded with map_from_file.
+/*! Keeps the file mapping alive as long as the contained structure, which
+ *  may alias it. The structure is read-only; mutating it (or resizing one
+ *  of its vectors) materializes the touched vector in fresh memory first.
+ */
+template<class T>
+class mapped_structure
+{
+    private:
+        mmap_source m_source; // declared first so it outlives m_structure
+        T           m_structure;
+
+    public:
+        mapped_structure() {}
+
+        explicit mapped_structure(const std::string& file) : m_source(file)
+        {
+            mmap_istreambuf buf(m_source);
+            std::istream in(&buf);
+            m_structure.load(in);
+        }
+
+        mapped_structure(const mapped_structure&) = delete;
+        mapped_structure& operator=(const mapped_structure&) = delete;
+        mapped_structure(mapped_structure&&) = default;
+        mapped_structure& operator=(mapped_structure&&) = default;
+
+        const T& operator*() const
+        {
+            return m_structure;
+        }
+
+        const T* operator->() const
+        {
+            return &m_structure;
+        }
+
+        const T& structure() const
+        {
+            return m_structure;
+        }
+};
+
+//! Load a serialized structure with its int_vector payloads mapped from file.
+/*! \tparam T Type of the serialized structure.
+ *  \param file Name of a file containing a serialized T object.
+ *  \return A mapped_structure owning the loaded object and its mapping.
+ *
+ *  Word-aligned int_vector payloads inside the serialization (bit vectors,
+ *  wavelet tree levels, sampled arrays, ...) become read-only views into
+ *  the mapped file: they page in lazily, share the page cache between
+ *  processes, and are never copied. Headers, plain members and unaligned
+ *  payloads are read through the stream as usual.
+ */
+template<class T>
+mapped_structure<T> map_from_file(const std::string& file)
+{
+    return mapped_structure<T>(file);
+}
+
 } // end namespace
 
 #endif
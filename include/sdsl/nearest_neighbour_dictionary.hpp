@@ -85,14 +85,23 @@ class nearest_neighbour_dictionary
             size_type ones = 0; // counter for the ones in v
 
             // get maximal distance between to ones in the bit vector
-            // speed this up by broadword computing
-            for (size_type i=0, last_one_pos_plus_1=0; i < v.size(); ++i) {
-                if (v[i]) {
-                    if (i+1-last_one_pos_plus_1 > max_distance_between_two_ones)
-                        max_distance_between_two_ones = i+1-last_one_pos_plus_1;
-                    last_one_pos_plus_1 = i+1;
-                    ++ones;
-
+            // word-wise scan: skip zero words, extract set bits via bits::lo
+            {
+                const uint64_t* data = v.data();
+                size_type last_one_pos_plus_1 = 0;
+                for (size_type word=0; word < (v.capacity()>>6); ++word) {
+                    uint64_t w = data[word];
+                    if (word == (v.capacity()>>6)-1 and (v.size()&0x3F)) {
+                        w &= bits::lo_set[v.size()&0x3F]; // mask padding bits
+                    }
+                    while (w) {
+                        size_type i = (word<<6) + bits::lo(w);
+                        if (i+1-last_one_pos_plus_1 > max_distance_between_two_ones)
+                            max_distance_between_two_ones = i+1-last_one_pos_plus_1;
+                        last_one_pos_plus_1 = i+1;
+                        ++ones;
+                        w &= w-1; // clear the extracted bit
+                    }
                 }
             }
             m_ones = ones;
@@ -105,16 +114,26 @@ class nearest_neighbour_dictionary
             // initialize m_contains_abs_sample
             m_contains_abs_sample = bit_vector((v.size()+t_sample_dens-1)/t_sample_dens, 0);
             ones = 0;
-            for (size_type i=0, last_one_pos=0; i < v.size(); ++i) {
-                if (v[i]) {
-                    ++ones;
-                    if ((ones % t_sample_dens) == 0) {  // insert absolute samples
-                        m_abs_samples[ones/t_sample_dens] = i;
-                        m_contains_abs_sample[i/t_sample_dens] = 1;
-                    } else {
-                        m_differences[ones - ones/t_sample_dens - 1] = i - last_one_pos;
+            {
+                const uint64_t* data = v.data();
+                size_type last_one_pos = 0;
+                for (size_type word=0; word < (v.capacity()>>6); ++word) {
+                    uint64_t w = data[word];
+                    if (word == (v.capacity()>>6)-1 and (v.size()&0x3F)) {
+                        w &= bits::lo_set[v.size()&0x3F]; // mask padding bits
+                    }
+                    while (w) {
+                        size_type i = (word<<6) + bits::lo(w);
+                        ++ones;
+                        if ((ones % t_sample_dens) == 0) {  // insert absolute samples
+                            m_abs_samples[ones/t_sample_dens] = i;
+                            m_contains_abs_sample[i/t_sample_dens] = 1;
+                        } else {
+                            m_differences[ones - ones/t_sample_dens - 1] = i - last_one_pos;
+                        }
+                        last_one_pos = i;
+                        w &= w-1; // clear the extracted bit
                     }
-                    last_one_pos = i;
                 }
             }
             util::init_support(m_rank_contains_abs_sample, &m_contains_abs_sample);
@@ -24,6 +24,8 @@
 
 #include <sdsl/int_vector.hpp>
 #include <sdsl/util.hpp>
+#include <atomic>
+#include <memory>
 
 namespace sdsl
 {
@@ -375,6 +377,383 @@ class nn_dict_dynamic
 
 };
 
+//! A variant of nn_dict_dynamic which supports concurrent writers.
+/*! The leaf words and the summary words of the tree are std::atomic
+ *  and all bit updates are performed with fetch_or/fetch_and, so
+ *  multiple threads can set and reset bits without an external mutex.
+ *  A writer which causes a word to switch between zero and nonzero
+ *  repairs the summary bit of the parent word with a lock-free
+ *  verify-and-retry loop and continues upwards only while the
+ *  zero/nonzero state of the parent changed, so concurrent marking in
+ *  different subtrees never touches the same cache lines above their
+ *  lowest common ancestor.
+ *
+ *  Guarantees: set and reset are linearizable per bit; prev, next and
+ *  operator[] are safe to call concurrently with writers but reflect
+ *  some interleaving of the in-flight updates. After all writers have
+ *  finished (e.g. after joining the threads), the answers equal those
+ *  of a sequentially filled nn_dict_dynamic.
+ */
+class nn_dict_dynamic_atomic
+{
+    public:
+        typedef int_vector<64>::size_type size_type;
+
+    private:
+        uint64_t m_depth = 0;          // Depth of the tree
+        uint64_t m_v_begin_leaves = 0; // Virtual begin of leaves
+        size_type m_size = 0;
+        size_type m_nodes = 0;         // Number of 64-bit words in the tree
+        int_vector<64> m_offset;       // Number of nodes to skip on each level
+        std::unique_ptr<std::atomic<uint64_t>[]> m_tree; // Tree incl. leaves
+
+        void copy(const nn_dict_dynamic_atomic& nn)
+        {
+            m_depth = nn.m_depth;
+            m_v_begin_leaves = nn.m_v_begin_leaves;
+            m_size = nn.m_size;
+            m_nodes = nn.m_nodes;
+            m_offset = nn.m_offset;
+            m_tree = std::unique_ptr<std::atomic<uint64_t>[]>(
+                         new std::atomic<uint64_t>[m_nodes]);
+            for (size_type i = 0; i < m_nodes; ++i) {
+                m_tree[i].store(nn.m_tree[i].load());
+            }
+        }
+
+        /*! Repair the summary bits above a leaf resp. inner word whose
+         *  zero/nonzero state may have changed. v_node_position is the
+         *  virtual position of the changed word on level dep.
+         */
+        void update_summary(uint64_t v_node_position, uint64_t dep)
+        {
+            while (dep) {
+                uint64_t child_r = v_node_position - m_offset[dep];
+                --dep;
+                --v_node_position;
+                uint8_t offset = v_node_position & 0x3F;
+                v_node_position >>= 6;
+                uint64_t parent_r = v_node_position - m_offset[dep];
+                uint64_t mask = 1ULL << offset;
+                uint64_t old;
+                while (true) {
+                    if (m_tree[child_r].load()) {
+                        old = m_tree[parent_r].fetch_or(mask);
+                        if (m_tree[child_r].load()) {
+                            // parent bit verified against the child word
+                            break;
+                        }
+                    } else {
+                        old = m_tree[parent_r].fetch_and(~mask);
+                        old &= ~mask; // remaining bits after the update
+                        if (!m_tree[child_r].load()) {
+                            break;
+                        }
+                    }
+                    // the child word switched state concurrently; retry
+                }
+                if (old != 0) {
+                    // the zero/nonzero state of the parent word did not
+                    // change, the levels above are consistent
+                    return;
+                }
+            }
+        }
+
+    public:
+
+        const uint64_t& depth = m_depth;
+
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        //! Constructor
+        /*! \param n Number of supported bits
+         */
+        nn_dict_dynamic_atomic(const uint64_t n = 0)
+        {
+            m_size = n;
+            if (n == 0)
+                return;
+            uint64_t level;     // level indicator
+            uint64_t nodes = 1; // number of nodes (=64 bit integer)
+            uint64_t tmp;       // tmp-variable
+
+            /* Calc depth and begin of leaves */
+            m_depth = bits::hi(n)/6;
+            m_v_begin_leaves = (1ULL<<(m_depth*6))/63;
+
+            /* Calc how many nodes to skip on each level */
+            m_offset = int_vector<64>(m_depth+2, 0);
+            level = m_depth;
+            tmp = n;
+            while (level) {
+                tmp = (tmp+63)/64;
+                m_offset[level+1] = (1ULL<<(6*level)) - tmp;
+                nodes += tmp;
+                --level;
+            }
+
+            /* Calc how many nodes to skip up to each level*/
+            for (level = 1; level <= m_depth; ++level) {
+                m_offset[level] += m_offset[level-1];
+            }
+
+            /* Create Tree incl. leaves */
+            m_nodes = nodes;
+            m_tree = std::unique_ptr<std::atomic<uint64_t>[]>(
+                         new std::atomic<uint64_t>[m_nodes]);
+            for (size_type i = 0; i < m_nodes; ++i) {
+                m_tree[i].store(0);
+            }
+        }
+
+        //! Copy constructor
+        nn_dict_dynamic_atomic(const nn_dict_dynamic_atomic& nn)
+        {
+            copy(nn);
+        }
+
+        //! Move constructor
+        nn_dict_dynamic_atomic(nn_dict_dynamic_atomic&& nn)
+        {
+            *this = std::move(nn);
+        }
+
+        //! Assignment operator
+        nn_dict_dynamic_atomic& operator=(const nn_dict_dynamic_atomic& nn)
+        {
+            if (this != &nn) {
+                copy(nn);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        nn_dict_dynamic_atomic& operator=(nn_dict_dynamic_atomic&& nn)
+        {
+            if (this != &nn) {
+                m_depth = nn.m_depth;
+                m_v_begin_leaves = nn.m_v_begin_leaves;
+                m_size = nn.m_size;
+                m_nodes = nn.m_nodes;
+                m_offset = std::move(nn.m_offset);
+                m_tree = std::move(nn.m_tree);
+                // set nn to default-constructor state
+                nn.m_size = 0;
+                nn.m_depth = 0;
+                nn.m_v_begin_leaves = 0;
+                nn.m_nodes = 0;
+            }
+            return *this;
+        }
+
+        void swap(nn_dict_dynamic_atomic& nn)
+        {
+            if (this != &nn) {
+                std::swap(m_depth, nn.m_depth);
+                std::swap(m_v_begin_leaves, nn.m_v_begin_leaves);
+                std::swap(m_size, nn.m_size);
+                std::swap(m_nodes, nn.m_nodes);
+                m_offset.swap(nn.m_offset);
+                std::swap(m_tree, nn.m_tree);
+            }
+        }
+
+        //! Access the bit at index idx
+        /*! \param idx Index
+         *  \par Precondition
+         *    \f$ 0 \leq  idx < size() \f$
+         */
+        bool operator[](const size_type& idx) const
+        {
+            uint64_t node = m_tree[(m_v_begin_leaves + (idx>>6))
+                                   - m_offset[m_depth]].load();
+            return (node >> (idx&0x3F)) & 1;
+        }
+
+        //! Set the bit at index idx; safe for concurrent writers.
+        /*! \return The previous value of the bit.
+         */
+        bool set(const size_type idx)
+        {
+            uint64_t v_node_position = m_v_begin_leaves + (idx>>6);
+            uint64_t r_node_position = v_node_position - m_offset[m_depth];
+            uint64_t mask = 1ULL << (idx & 0x3F);
+            uint64_t w = m_tree[r_node_position].fetch_or(mask);
+            if (w & mask) { // the bit was already set
+                return true;
+            }
+            if (!w) { // the leaf word switched from zero to nonzero
+                update_summary(v_node_position, m_depth);
+            }
+            return false;
+        }
+
+        //! Reset the bit at index idx; safe for concurrent writers.
+        /*! \return The previous value of the bit.
+         */
+        bool reset(const size_type idx)
+        {
+            uint64_t v_node_position = m_v_begin_leaves + (idx>>6);
+            uint64_t r_node_position = v_node_position - m_offset[m_depth];
+            uint64_t mask = 1ULL << (idx & 0x3F);
+            uint64_t w = m_tree[r_node_position].fetch_and(~mask);
+            if (!(w & mask)) { // the bit was already 0
+                return false;
+            }
+            if (!(w & ~mask)) { // the leaf word switched to zero
+                update_summary(v_node_position, m_depth);
+            }
+            return true;
+        }
+
+        //! Get the leftmost index \f$i\geq idx\f$ where a bit is set.
+        /*! \param idx Left border of the search interval. \f$ 0\leq idx < size()\f$
+         *
+         *  \return If there exists a leftmost index \f$i\geq idx\f$ where a bit is set,
+         *          then \f$i\f$ is returned, otherwise size().
+         */
+        size_type next(const size_type idx) const
+        {
+            uint64_t v_node_position; // virtual node position
+            uint64_t node;            // current node
+            uint64_t dep = m_depth;   // current depth of node
+            uint64_t position;        // position of the 1-bit
+
+            v_node_position = m_v_begin_leaves + (idx>>6);
+            uint8_t off = idx & 0x3F; // mod 64
+
+            // Go up until a 1-bit is found
+            node = m_tree[ v_node_position-m_offset[dep] ].load()>>off;
+            while (!node or off==64) {
+                // Not in the root
+                if (v_node_position) {
+                    --dep;
+                    --v_node_position;
+                    off = (v_node_position&0x3F)+1;
+                    v_node_position >>= 6;
+                    node = m_tree[ v_node_position-m_offset[dep] ].load()>>off;
+                } else {
+                    return size();
+                }
+            }
+            // Calculate the position of the 1-bit
+            position = bits::lo(node)+off;
+
+            // Go down to the leaf
+            while (v_node_position < m_v_begin_leaves) {
+                ++dep;
+                v_node_position = (v_node_position<<6) + 1 + position;
+                node = m_tree[ v_node_position-m_offset[dep] ].load();
+
+                // Calculate the position of the 1-bit
+                position = bits::lo(node);
+            }
+            return ((v_node_position - m_v_begin_leaves)<<6) + position;
+        }
+
+        //! Get the rightmost index \f$i \leq idx\f$ where a bit is set.
+        /*! \param idx Right border of the search interval. \f$ 0 \leq idx < size()\f$
+         *
+         *  \return If there exists a rightmost index \f$i \leq idx\f$ where a bit is set,
+         *          then \f$i\f$ is returned, otherwise size().
+         */
+        size_type prev(const size_type idx) const
+        {
+            uint64_t v_node_position; // virtual node position
+            uint64_t node;            // current node
+            uint64_t dep = m_depth;   // current depth of node
+            uint64_t position;        // position of the 1-bit
+
+            v_node_position = m_v_begin_leaves + (idx>>6);
+            uint8_t off = idx & 0x3F; // mod 64
+
+            // Go up until a 1-bit is found
+            node = m_tree[ v_node_position-m_offset[dep] ].load()<<(63-off);
+            while (!node or off == (uint8_t)-1) {
+
+                // Not in the root
+                if (v_node_position) {
+                    --dep;
+                    --v_node_position;
+
+                    off = ((uint8_t)(v_node_position&0x3F))-1;
+                    v_node_position >>= 6;
+
+                    node = m_tree[ v_node_position-m_offset[dep] ].load()<<(63-off);
+                } else {
+                    return size();
+                }
+            }
+            // Calculate the position of the 1-bit
+            position = bits::hi(node)-(63-off);
+
+            // Go down to the leaf
+            while (v_node_position < m_v_begin_leaves) {
+                ++dep;
+                v_node_position = (v_node_position<<6) + 1 + position;
+                node = m_tree[ v_node_position-m_offset[dep] ].load();
+
+                // Calculate the position of the 1-bit
+                position = bits::hi(node);
+            }
+            return ((v_node_position - m_v_begin_leaves)<<6) + position;
+        }
+
+        //! Take a frozen copy for checkpointing while writers continue.
+        /*! The tree words are copied with individual atomic loads, so no
+         *  writer is blocked; the image reflects some interleaving of the
+         *  in-flight updates, word by word. For an image whose prev/next
+         *  answers are guaranteed consistent, take the snapshot at a
+         *  point where no writer is active (cf. the class guarantees).
+         *  The copy can be serialized from a background thread via
+         *  store_to_file_background while updates proceed on the live
+         *  structure.
+         */
+        std::shared_ptr<const nn_dict_dynamic_atomic> snapshot() const
+        {
+            return std::make_shared<nn_dict_dynamic_atomic>(*this);
+        }
+
+        //! Load the data structure
+        void load(std::istream& in)
+        {
+            read_member(m_depth, in);
+            read_member(m_v_begin_leaves, in);
+            read_member(m_size, in);
+            m_offset.load(in);
+            int_vector<64> tree;
+            tree.load(in);
+            m_nodes = tree.size();
+            m_tree = std::unique_ptr<std::atomic<uint64_t>[]>(
+                         new std::atomic<uint64_t>[m_nodes]);
+            for (size_type i = 0; i < m_nodes; ++i) {
+                m_tree[i].store(tree[i]);
+            }
+        }
+
+        //! Serialize the data structure
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_depth, out, child, "depth");
+            written_bytes += write_member(m_v_begin_leaves, out, child, "v_begin_leaves");
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += m_offset.serialize(out, child, "offset");
+            int_vector<64> tree(m_nodes);
+            for (size_type i = 0; i < m_nodes; ++i) {
+                tree[i] = m_tree[i].load();
+            }
+            written_bytes += tree.serialize(out, child, "tree");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+};
+
 
 
 } // end of namespace
@@ -0,0 +1,257 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file nsv_support_bp.hpp
+    \brief nsv_support_bp.hpp contains a succinct next/previous smaller
+           value support for LCP arrays.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_NSV_SUPPORT_BP
+#define INCLUDED_SDSL_NSV_SUPPORT_BP
+
+#include <utility>
+#include <vector>
+#include "int_vector.hpp"
+#include "bp_support_sada.hpp"
+#include "rank_support_v.hpp"
+#include "select_support_mcl.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A succinct NSV/PSV support structure for LCP arrays.
+/*! The structure answers next-smaller-value and previous-smaller-value
+ *  queries (strictly smaller, the LCP-interval convention) on any
+ *  random access sequence, in particular on the lcp_* classes, in
+ *  constant time. It consists of the balanced parentheses sequence of
+ *  the 2d-min-heap of the sequence (one pass with a monotonic stack,
+ *  2n bits) plus one bit per element marking whether its value equals
+ *  that of its heap parent - the marks resolve ties, which are
+ *  frequent in LCP arrays, without an access to the supported
+ *  sequence at query time.
+ *
+ *  \tparam t_lcp        Type of the supported sequence, e.g. lcp_dac<>.
+ *  \tparam t_bp_support Support type for the parentheses sequence.
+ *
+ *  \par Space complexity
+ *       \f$ 3n + o(n) \f$ bits.
+ *
+ *  \par Reference
+ *       Johannes Fischer:
+ *       Combined data structure for previous- and next-smaller-values.
+ *       Theor. Comput. Sci. 412(22): 2451-2456 (2011)
+ */
+template<class t_lcp, class t_bp_support = bp_support_sada<>>
+class nsv_support_bp
+{
+    public:
+        typedef typename t_lcp::size_type  size_type;
+        typedef t_lcp                      lcp_type;
+        typedef t_bp_support               bp_support_type;
+    private:
+        const t_lcp*           m_v = nullptr; // the supported sequence
+        bit_vector             m_bp;          // BP of the 2d-min-heap
+        bp_support_type        m_bp_support;  // support for m_bp
+        bit_vector             m_eq;          // m_eq[r]=1 iff the element
+        // with the r-th closing parenthesis has the same value as its parent
+        rank_support_v<0>      m_eq_rank0;    // rank support for zeros in m_eq
+        select_support_mcl<0>  m_eq_select0;  // select support for zeros in m_eq
+
+        void copy(const nsv_support_bp& nsv)
+        {
+            m_v          = nsv.m_v;
+            m_bp         = nsv.m_bp;
+            m_bp_support = nsv.m_bp_support;
+            m_bp_support.set_vector(&m_bp);
+            m_eq         = nsv.m_eq;
+            m_eq_rank0   = nsv.m_eq_rank0;
+            m_eq_rank0.set_vector(&m_eq);
+            m_eq_select0 = nsv.m_eq_select0;
+            m_eq_select0.set_vector(&m_eq);
+        }
+
+    public:
+        const bit_vector& bp = m_bp; // BP sequence of the 2d-min-heap
+
+        //! Constructor
+        /*! \param v Pointer to the sequence which should be supported.
+         *  \par Time complexity
+         *       \f$ \Order{n} \f$; every element is pushed and popped once.
+         */
+        explicit nsv_support_bp(const t_lcp* v = nullptr) : m_v(v)
+        {
+            if (nullptr == v) {
+                return;
+            }
+            size_type n = v->size();
+            m_bp = bit_vector(2*n, 0);
+            m_eq = bit_vector(n, 0);
+            std::vector<std::pair<uint64_t, bool>> stack; // (value, eq flag)
+            size_type bp_pos = 0, closed = 0;
+            for (size_type i=0; i < n; ++i) {
+                uint64_t x = (*v)[i];
+                while (!stack.empty() and stack.back().first > x) {
+                    ++bp_pos; // closing parenthesis
+                    m_eq[closed++] = stack.back().second;
+                    stack.pop_back();
+                }
+                bool eq = (!stack.empty() and stack.back().first == x);
+                m_bp[bp_pos++] = 1; // opening parenthesis
+                stack.emplace_back(x, eq);
+            }
+            while (!stack.empty()) { // pop the remaining stack into the tail
+                ++bp_pos;
+                m_eq[closed++] = stack.back().second;
+                stack.pop_back();
+            }
+            util::init_support(m_bp_support, &m_bp);
+            util::init_support(m_eq_rank0, &m_eq);
+            util::init_support(m_eq_select0, &m_eq);
+        }
+
+        //! Copy constructor
+        nsv_support_bp(const nsv_support_bp& nsv)
+        {
+            copy(nsv);
+        }
+
+        //! Move constructor
+        nsv_support_bp(nsv_support_bp&& nsv)
+        {
+            *this = std::move(nsv);
+        }
+
+        //! Assignment operator
+        nsv_support_bp& operator=(const nsv_support_bp& nsv)
+        {
+            if (this != &nsv) {
+                copy(nsv);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        nsv_support_bp& operator=(nsv_support_bp&& nsv)
+        {
+            if (this != &nsv) {
+                m_v          = nsv.m_v;
+                m_bp         = std::move(nsv.m_bp);
+                m_bp_support = std::move(nsv.m_bp_support);
+                m_bp_support.set_vector(&m_bp);
+                m_eq         = std::move(nsv.m_eq);
+                m_eq_rank0   = std::move(nsv.m_eq_rank0);
+                m_eq_rank0.set_vector(&m_eq);
+                m_eq_select0 = std::move(nsv.m_eq_select0);
+                m_eq_select0.set_vector(&m_eq);
+            }
+            return *this;
+        }
+
+        //! Next smaller value.
+        /*! \param i Index \f$ i \in [0..size()-1] \f$.
+         *  \return The minimal \f$ j > i \f$ with \f$ v[j] < v[i] \f$,
+         *          or size() if no such j exists.
+         *  \par Time complexity \f$ \Order{1} \f$
+         */
+        size_type nsv(size_type i)const
+        {
+            assert(i < size());
+            size_type c = m_bp_support.find_close(m_bp_support.select(i+1));
+            return m_bp_support.rank(c); // index of the popping element
+        }
+
+        //! Previous smaller value.
+        /*! \param i Index \f$ i \in [0..size()-1] \f$.
+         *  \return The maximal \f$ j < i \f$ with \f$ v[j] < v[i] \f$,
+         *          or size() if no such j exists.
+         *  \par Time complexity \f$ \Order{1} \f$
+         */
+        size_type psv(size_type i)const
+        {
+            assert(i < size());
+            size_type o = m_bp_support.select(i+1);
+            size_type c = m_bp_support.find_close(o);
+            size_type r = c - m_bp_support.rank(c); // closing rank of i
+            if (m_eq[r]) { // skip the chain of equal-valued ancestors;
+                // they are popped together, so their closings are consecutive
+                size_type z = m_eq_select0.select(m_eq_rank0.rank(r)+1);
+                o = m_bp_support.find_open(c + (z - r));
+            }
+            size_type e = m_bp_support.enclose(o);
+            if (e == m_bp.size()) { // no enclosing parenthesis pair
+                return size();
+            }
+            return m_bp_support.rank(e) - 1;
+        }
+
+        //! Returns the size of the supported sequence.
+        size_type size()const
+        {
+            return m_eq.size();
+        }
+
+        //! Sets the supported sequence.
+        void set_vector(const t_lcp* v)
+        {
+            m_v = v;
+        }
+
+        //! Swap method
+        void swap(nsv_support_bp& nsv)
+        {
+            if (this != &nsv) {
+                m_bp.swap(nsv.m_bp);
+                util::swap_support(m_bp_support, nsv.m_bp_support,
+                                   &m_bp, &(nsv.m_bp));
+                m_eq.swap(nsv.m_eq);
+                util::swap_support(m_eq_rank0, nsv.m_eq_rank0,
+                                   &m_eq, &(nsv.m_eq));
+                util::swap_support(m_eq_select0, nsv.m_eq_select0,
+                                   &m_eq, &(nsv.m_eq));
+            }
+        }
+
+        //! Serializes the data structure into the given ostream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += m_bp.serialize(out, child, "bp");
+            written_bytes += m_bp_support.serialize(out, child, "bp_support");
+            written_bytes += m_eq.serialize(out, child, "eq");
+            written_bytes += m_eq_rank0.serialize(out, child, "eq_rank0");
+            written_bytes += m_eq_select0.serialize(out, child, "eq_select0");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in, const t_lcp* v=nullptr)
+        {
+            m_v = v;
+            m_bp.load(in);
+            m_bp_support.load(in, &m_bp);
+            m_eq.load(in);
+            m_eq_rank0.load(in, &m_eq);
+            m_eq_select0.load(in, &m_eq);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
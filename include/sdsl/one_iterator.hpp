@@ -0,0 +1,175 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2016 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file one_iterator.hpp
+    \brief one_iterator.hpp contains an iterator over the positions of the
+           set bits of a bit vector.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_ONE_ITERATOR
+#define INCLUDED_SDSL_ONE_ITERATOR
+
+#include "int_vector.hpp"
+#include "rrr_vector.hpp"
+#include "sd_vector.hpp"
+#include <algorithm>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! An iterator over the positions of the set bits of a bit vector.
+/*! next_one() reports the positions of the 1-bits in increasing order
+ *  in amortized constant time per reported position, which replaces the
+ *  repeated select(i+1) calls of a full enumeration: a select support
+ *  re-searches from its samples on every call, while the iterator
+ *  streams through the vector and keeps its position.
+ *
+ *  The primary template works for every bit vector type which provides
+ *  get_int (e.g. the plain bit_vector, for which a chunk fetch is a
+ *  single word load); rrr_vector and sd_vector have specializations
+ *  which exploit their representation (block-aligned decoding resp.
+ *  merging the high and low parts).
+ *
+ *  \tparam t_bv Type of the supported bit vector.
+ *
+ *  \par Example
+ *  \code
+ *  one_iterator<sd_vector<>> it(&sd);
+ *  for (auto i = it.next_one(); i < sd.size(); i = it.next_one()) {
+ *      // i is the position of the next 1-bit
+ *  }
+ *  \endcode
+ */
+template<class t_bv>
+class one_iterator
+{
+    public:
+        typedef bit_vector::size_type size_type;
+    private:
+        const t_bv* m_v;
+        size_type   m_chunk = 0; // start position of the buffered chunk
+        uint64_t    m_word  = 0; // not yet reported set bits of the chunk
+    public:
+        explicit one_iterator(const t_bv* v) : m_v(v)
+        {
+            if (m_v->size() > 0) {
+                m_word = m_v->get_int(0,
+                         (uint8_t)std::min<size_type>(64, m_v->size()));
+            }
+        }
+
+        //! Position of the next set bit, or size() if there is none left.
+        size_type next_one()
+        {
+            while (m_word == 0) {
+                m_chunk += 64;
+                if (m_chunk >= m_v->size()) {
+                    return m_v->size();
+                }
+                m_word = m_v->get_int(m_chunk,
+                         (uint8_t)std::min<size_type>(64, m_v->size()-m_chunk));
+            }
+            uint8_t b = bits::lo(m_word);
+            m_word &= m_word - 1; // clear the reported bit
+            return m_chunk + b;
+        }
+};
+
+//! Specialization for rrr_vector: chunks are aligned to the rrr blocks.
+/*! A block-aligned get_int touches exactly one block (two for blocks
+ *  beyond 64 bits), so the sequential walk decodes every block once via
+ *  the vector's internal block cache instead of twice for straddling
+ *  word reads.
+ */
+template<uint16_t t_bs, class t_rac, uint16_t t_k>
+class one_iterator<rrr_vector<t_bs, t_rac, t_k>>
+{
+    public:
+        typedef bit_vector::size_type size_type;
+    private:
+        const rrr_vector<t_bs, t_rac, t_k>* m_v;
+        size_type m_chunk = 0; // start position of the buffered chunk
+        size_type m_len   = 0; // length of the buffered chunk
+        uint64_t  m_word  = 0; // not yet reported set bits of the chunk
+
+        size_type chunk_len(size_type start) const
+        {
+            size_type block_end = (start/t_bs + 1) * (size_type)t_bs;
+            return std::min<size_type>(64,
+                   std::min(block_end, m_v->size()) - start);
+        }
+    public:
+        explicit one_iterator(const rrr_vector<t_bs, t_rac, t_k>* v) : m_v(v)
+        {
+            if (m_v->size() > 0) {
+                m_len  = chunk_len(0);
+                m_word = m_v->get_int(0, (uint8_t)m_len);
+            }
+        }
+
+        //! Position of the next set bit, or size() if there is none left.
+        size_type next_one()
+        {
+            while (m_word == 0) {
+                m_chunk += m_len;
+                if (m_chunk >= m_v->size()) {
+                    return m_v->size();
+                }
+                m_len  = chunk_len(m_chunk);
+                m_word = m_v->get_int(m_chunk, (uint8_t)m_len);
+            }
+            uint8_t b = bits::lo(m_word);
+            m_word &= m_word - 1; // clear the reported bit
+            return m_chunk + b;
+        }
+};
+
+//! Specialization for sd_vector: merges the high and the low part.
+/*! The k-th one of the high part sits at position k plus the number of
+ *  preceding zeros, so streaming over the ones of HI with an inner
+ *  one_iterator yields the upper bits as (position - k), which are
+ *  combined with the k-th low entry; no select structure is involved.
+ */
+template<class t_hi_bit_vector, class t_select_1, class t_select_0>
+class one_iterator<sd_vector<t_hi_bit_vector, t_select_1, t_select_0>>
+{
+    public:
+        typedef bit_vector::size_type size_type;
+    private:
+        const sd_vector<t_hi_bit_vector, t_select_1, t_select_0>* m_v;
+        one_iterator<t_hi_bit_vector> m_hi_it;
+        size_type m_k = 0; // number of already reported ones
+    public:
+        explicit one_iterator(const sd_vector<t_hi_bit_vector, t_select_1,
+                              t_select_0>* v) : m_v(v), m_hi_it(&v->high) {}
+
+        //! Position of the next set bit, or size() if there is none left.
+        size_type next_one()
+        {
+            if (m_k >= m_v->low.size()) {
+                return m_v->size();
+            }
+            size_type p   = m_hi_it.next_one();
+            size_type res = ((p - m_k) << m_v->wl) | m_v->low[m_k];
+            ++m_k;
+            return res;
+        }
+};
+
+}// end namespace sdsl
+
+#endif // end file
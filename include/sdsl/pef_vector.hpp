@@ -0,0 +1,457 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file pef_vector.hpp
+    \brief pef_vector.hpp contains a partitioned Elias-Fano compressed
+           bit vector.
+    \author Simon Gog
+
+    sd_vector splits every position into the same number of low bits,
+    chosen from the global density m/n. When the local density varies
+    wildly — postings-style marker vectors with dense and sparse
+    stretches — that single split is far from optimal. pef_vector
+    partitions the universe into uniform blocks and encodes each block
+    with its own optimal low-bit width: empty and full blocks cost no
+    bits at all, and the others store an Elias-Fano encoding sized for
+    their local density. A two-level directory (ones and bit offset
+    per block) routes rank and select to the right block, so queries
+    touch one block's encoding only.
+*/
+#ifndef INCLUDED_SDSL_PEF_VECTOR
+#define INCLUDED_SDSL_PEF_VECTOR
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "int_vector.hpp"
+#include "util.hpp"
+
+namespace sdsl
+{
+
+//! A partitioned Elias-Fano compressed bit vector.
+/*! \tparam t_block_size Universe positions per partition; must be a
+ *                       multiple of 64.
+ *
+ *  Offers the same query surface as sd_vector — operator[], rank and
+ *  select supports, successor — so it is drop-in usable wherever an
+ *  sd_vector marks positions, e.g. as the marker vector of the
+ *  csa_sampling_strategy classes or the run bitmaps of wt_rlmn.
+ *
+ *  \par Reference
+ *       Giuseppe Ottaviano, Rossano Venturini:
+ *       Partitioned Elias-Fano Indexes. SIGIR 2014.
+ */
+template<uint32_t t_block_size = 1024>
+class pef_vector
+{
+    public:
+        static_assert(t_block_size % 64 == 0,
+                      "pef_vector: block size must be a multiple of 64");
+        typedef bit_vector::size_type       size_type;
+        typedef size_type                   value_type;
+        typedef bit_vector::difference_type difference_type;
+        class rank_1_type;    // forward declarations
+        class select_1_type;
+        friend class rank_1_type;
+        friend class select_1_type;
+
+    private:
+        size_type     m_size = 0;     // length of the universe
+        int_vector<>  m_block_ones;   // cumulative ones per block
+        int_vector<>  m_block_offset; // cumulative encoding bits per block
+        bit_vector    m_data;         // concatenated block encodings
+
+        // geometry of the encoding of one block
+        struct block_info {
+            size_type len;      // universe positions in the block
+            size_type m;        // ones in the block
+            uint8_t   l;        // low-bit width
+            size_type low_off;  // first bit of the low array in m_data
+            size_type high_off; // first bit of the high (unary) part
+            size_type high_len; // bits of the high part
+        };
+
+        //! Optimal low-bit width for a block of len positions with m ones.
+        static uint8_t low_width(size_type len, size_type m)
+        {
+            if (0 == m or m == len or len/m < 2) {
+                return 0;
+            }
+            return bits::hi(len/m);
+        }
+
+        //! Encoded bits of a block; empty and full blocks are implicit.
+        static size_type block_bits(size_type len, size_type m)
+        {
+            if (0 == m or m == len) {
+                return 0;
+            }
+            uint8_t l = low_width(len, m);
+            return m*l + m + ((len-1)>>l) + 1;
+        }
+
+        block_info info(size_type b) const
+        {
+            block_info bi;
+            bi.len = std::min<size_type>(t_block_size,
+                                         m_size - b*(size_type)t_block_size);
+            bi.m   = m_block_ones[b+1] - m_block_ones[b];
+            bi.l   = low_width(bi.len, bi.m);
+            bi.low_off  = m_block_offset[b];
+            bi.high_off = bi.low_off + bi.m*bi.l;
+            bi.high_len = bi.m + ((bi.len-1)>>bi.l) + 1;
+            return bi;
+        }
+
+        //! Number of ones in block b strictly before local position i.
+        size_type block_rank(size_type b, size_type i) const
+        {
+            block_info bi = info(b);
+            if (0 == bi.m) {
+                return 0;
+            }
+            if (bi.m == bi.len) {
+                return std::min(i, bi.len);
+            }
+            if (i >= bi.len) {
+                return bi.m;
+            }
+            size_type h = i >> bi.l; // bucket of position i
+            size_type pos = 0, ones = 0;
+            if (h > 0) { // find the h-th 0 = separator opening bucket h
+                size_type zeros = 0;
+                while (true) {
+                    size_type chunk = std::min<size_type>(64, bi.high_len-pos);
+                    uint64_t w = ~m_data.get_int(bi.high_off+pos, chunk)
+                                 & bits::lo_set[chunk];
+                    size_type cz = bits::cnt(w);
+                    if (zeros + cz >= h) {
+                        size_type q = pos + bits::sel(w, h-zeros);
+                        ones = q - (h-1); // ones in buckets < h
+                        pos  = q + 1;
+                        break;
+                    }
+                    zeros += cz;
+                    pos   += chunk;
+                }
+            }
+            // ones of bucket h follow consecutively; compare low bits
+            size_type r = ones;
+            uint64_t low_i = i & bits::lo_set[bi.l];
+            while (pos < bi.high_len and m_data[bi.high_off+pos]) {
+                uint64_t low = bi.l ? m_data.get_int(bi.low_off+r*bi.l, bi.l)
+                               : 0;
+                if (low >= low_i) {
+                    break;
+                }
+                ++r;
+                ++pos;
+            }
+            return r;
+        }
+
+        //! Local position of the k-th (1-based) one in block b.
+        size_type block_select(size_type b, size_type k) const
+        {
+            block_info bi = info(b);
+            if (bi.m == bi.len) {
+                return k-1;
+            }
+            size_type pos = 0, ones = 0, q = 0;
+            while (true) { // find the k-th 1 in the high part
+                size_type chunk = std::min<size_type>(64, bi.high_len-pos);
+                uint64_t w = m_data.get_int(bi.high_off+pos, chunk);
+                size_type c = bits::cnt(w);
+                if (ones + c >= k) {
+                    q = pos + bits::sel(w, k-ones);
+                    break;
+                }
+                ones += c;
+                pos  += chunk;
+            }
+            size_type bucket = q - (k-1);
+            uint64_t low = bi.l ? m_data.get_int(bi.low_off+(k-1)*bi.l, bi.l)
+                           : 0;
+            return (bucket << bi.l) | low;
+        }
+
+    public:
+        //! Default constructor
+        pef_vector() { }
+        pef_vector(const pef_vector&) = default;
+        pef_vector(pef_vector&&) = default;
+        pef_vector& operator=(const pef_vector&) = default;
+        pef_vector& operator=(pef_vector&&) = default;
+
+        //! Constructor from a plain bit_vector.
+        pef_vector(const bit_vector& bv)
+        {
+            m_size = bv.size();
+            size_type nb = (m_size + t_block_size - 1)/t_block_size;
+            std::vector<size_type> ones(nb, 0);
+            for (size_type i=0; i < m_size; i += 64) {
+                size_type chunk = std::min<size_type>(64, m_size-i);
+                ones[i/t_block_size] += bits::cnt(bv.get_int(i, chunk));
+            }
+            size_type total_ones = 0, total_bits = 0;
+            m_block_ones   = int_vector<>(nb+1, 0, 64);
+            m_block_offset = int_vector<>(nb+1, 0, 64);
+            for (size_type b=0; b < nb; ++b) {
+                size_type len = std::min<size_type>(t_block_size,
+                                m_size - b*(size_type)t_block_size);
+                m_block_ones[b]   = total_ones;
+                m_block_offset[b] = total_bits;
+                total_ones += ones[b];
+                total_bits += block_bits(len, ones[b]);
+            }
+            m_block_ones[nb]   = total_ones;
+            m_block_offset[nb] = total_bits;
+            util::bit_compress(m_block_ones);
+            util::bit_compress(m_block_offset);
+            m_data = bit_vector(total_bits, 0);
+            std::vector<size_type> written(nb, 0);
+            for (size_type i=0; i < m_size; i += 64) {
+                size_type chunk = std::min<size_type>(64, m_size-i);
+                uint64_t w = bv.get_int(i, chunk);
+                while (w) {
+                    size_type p = i + bits::lo(w);
+                    w &= w-1;
+                    size_type b = p/t_block_size;
+                    block_info bi = info(b);
+                    if (bi.m == bi.len) { // full block: implicit
+                        continue;
+                    }
+                    size_type o = p - b*(size_type)t_block_size;
+                    size_type j = written[b]++;
+                    if (bi.l) {
+                        m_data.set_int(bi.low_off + j*bi.l,
+                                       o & bits::lo_set[bi.l], bi.l);
+                    }
+                    m_data[bi.high_off + (o>>bi.l) + j] = 1;
+                }
+            }
+        }
+
+        //! Accessing the i-th element of the original bit_vector.
+        value_type operator[](size_type i) const
+        {
+            size_type b = i/t_block_size;
+            size_type il = i - b*(size_type)t_block_size;
+            return block_rank(b, il+1) - block_rank(b, il);
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *  \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, const uint8_t len=64) const
+        {
+            uint64_t res = 0;
+            size_type p = successor(idx);
+            while (p < idx + len) {
+                res |= 1ULL << (p - idx);
+                p = successor(p + 1);
+            }
+            return res;
+        }
+
+        //! Number of set bits.
+        size_type ones() const
+        {
+            return 0 == m_size ? 0 : m_block_ones[m_block_ones.size()-1];
+        }
+
+        //! Smallest position \f$\geq i\f$ with a set bit; size() if none.
+        size_type successor(size_type i) const
+        {
+            if (i >= m_size) {
+                return m_size;
+            }
+            size_type b = i/t_block_size;
+            size_type r = m_block_ones[b] + block_rank(b, i-b*(size_type)t_block_size);
+            if (r == ones()) {
+                return size();
+            }
+            // the (r+1)-th one is the successor
+            while (m_block_ones[b+1] <= r) {
+                ++b;
+            }
+            return b*(size_type)t_block_size
+                   + block_select(b, r+1 - m_block_ones[b]);
+        }
+
+        void swap(pef_vector& v)
+        {
+            if (this != &v) {
+                std::swap(m_size, v.m_size);
+                m_block_ones.swap(v.m_block_ones);
+                m_block_offset.swap(v.m_block_offset);
+                m_data.swap(v.m_data);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += m_block_ones.serialize(out, child, "block_ones");
+            written_bytes += m_block_offset.serialize(out, child, "block_offset");
+            written_bytes += m_data.serialize(out, child, "data");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            m_block_ones.load(in);
+            m_block_offset.load(in);
+            m_data.load(in);
+        }
+
+        //! Rank support for pef_vector.
+        class rank_1_type
+        {
+            private:
+                const pef_vector* m_v;
+            public:
+                typedef pef_vector::size_type size_type;
+
+                explicit rank_1_type(const pef_vector* v=nullptr) : m_v(v) { }
+
+                //! Number of set bits in the prefix [0..i-1].
+                size_type rank(size_type i) const
+                {
+                    if (0 == i) {
+                        return 0;
+                    }
+                    size_type b = (i-1)/t_block_size;
+                    return m_v->m_block_ones[b]
+                           + m_v->block_rank(b, i - b*(size_type)t_block_size);
+                }
+
+                size_type operator()(size_type i) const
+                {
+                    return rank(i);
+                }
+
+                size_type size() const
+                {
+                    return m_v->size();
+                }
+
+                void set_vector(const pef_vector* v)
+                {
+                    m_v = v;
+                }
+
+                void swap(rank_1_type&) { }
+
+                size_type serialize(std::ostream&, structure_tree_node* v=nullptr,
+                                    std::string name="") const
+                {
+                    structure_tree_node* child = structure_tree::add_child(v,
+                                                 name, util::class_name(*this));
+                    structure_tree::add_size(child, 0);
+                    return 0;
+                }
+
+                void load(std::istream&, const pef_vector* v=nullptr)
+                {
+                    m_v = v;
+                }
+        };
+
+        //! Select support for pef_vector.
+        class select_1_type
+        {
+            private:
+                const pef_vector* m_v;
+            public:
+                typedef pef_vector::size_type size_type;
+
+                explicit select_1_type(const pef_vector* v=nullptr) : m_v(v) { }
+
+                //! Position of the i-th (1-based) set bit.
+                size_type select(size_type i) const
+                {
+                    // binary search for the block holding the i-th one
+                    size_type lo = 0, hi = m_v->m_block_ones.size()-1;
+                    while (lo+1 < hi) {
+                        size_type mid = lo + (hi-lo)/2;
+                        if (m_v->m_block_ones[mid] < i) {
+                            lo = mid;
+                        } else {
+                            hi = mid;
+                        }
+                    }
+                    return lo*(size_type)t_block_size
+                           + m_v->block_select(lo, i - m_v->m_block_ones[lo]);
+                }
+
+                size_type operator()(size_type i) const
+                {
+                    return select(i);
+                }
+
+                size_type size() const
+                {
+                    return m_v->size();
+                }
+
+                void set_vector(const pef_vector* v)
+                {
+                    m_v = v;
+                }
+
+                void swap(select_1_type&) { }
+
+                size_type serialize(std::ostream&, structure_tree_node* v=nullptr,
+                                    std::string name="") const
+                {
+                    structure_tree_node* child = structure_tree::add_child(v,
+                                                 name, util::class_name(*this));
+                    structure_tree::add_size(child, 0);
+                    return 0;
+                }
+
+                void load(std::istream&, const pef_vector* v=nullptr)
+                {
+                    m_v = v;
+                }
+        };
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -0,0 +1,447 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file portable_io.hpp
+    \brief portable_io.hpp contains an endianness- and version-checked
+           container format for serialized structures.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_PORTABLE_IO
+#define INCLUDED_SDSL_PORTABLE_IO
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "int_vector.hpp"
+#include "io.hpp"
+#include "sfstream.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! Portable container format for serialized structures.
+/*! store_to_file_portable wraps the regular serialization in a fixed
+ *  header which records the payload endianness, the demangled class
+ *  name and a caller-chosen class version. The payload itself stays
+ *  the regular serialize() output, so writing costs nothing beyond the
+ *  header, and load_from_file_portable is a zero-overhead load() when
+ *  the host endianness matches the file. On a mismatch the loader
+ *  byte-swaps int_vector payloads in place (a plain word loop the
+ *  compiler vectorizes); structures other than int_vector have no
+ *  derivable layout schema, so a mismatched composite file is refused
+ *  with a clear message instead of being misread -- as are files of
+ *  the wrong class or version, which is what silently shifts across
+ *  library revisions.
+ *
+ *  Header layout (multi-byte fields always little-endian):
+ *  magic "SDSLPORT" (8 bytes), format version (1 byte), flags (1 byte,
+ *  bit 0 = payload little-endian), class version (4 bytes), class name
+ *  length (2 bytes), class name, then the payload.
+ */
+namespace portable_io
+{
+
+const char     magic[8] = {'S','D','S','L','P','O','R','T'};
+const uint8_t  format_version = 1;
+
+//! Returns true if the host stores the low byte of a word first.
+inline bool little_endian_host()
+{
+    uint32_t probe = 1;
+    uint8_t byte;
+    std::memcpy(&byte, &probe, 1);
+    return 1 == byte;
+}
+
+inline uint64_t bswap64(uint64_t x)
+{
+#ifdef MSVC_COMPILER
+    return _byteswap_uint64(x);
+#else
+    return __builtin_bswap64(x);
+#endif
+}
+
+//! Byte-swap n 64-bit words in place; the loop auto-vectorizes.
+inline void bswap64_words(uint64_t* words, uint64_t n)
+{
+    for (uint64_t i=0; i < n; ++i) {
+        words[i] = bswap64(words[i]);
+    }
+}
+
+inline void write_le(uint64_t x, uint8_t bytes, std::ostream& out)
+{
+    for (uint8_t i=0; i < bytes; ++i) {
+        out.put((char)(x & 0xFF));
+        x >>= 8;
+    }
+}
+
+inline uint64_t read_le(uint8_t bytes, std::istream& in)
+{
+    uint64_t x = 0;
+    for (uint8_t i=0; i < bytes; ++i) {
+        x |= ((uint64_t)(uint8_t)in.get()) << (8*i);
+    }
+    return x;
+}
+
+//! Header of a portable file, as returned by read_header.
+struct file_header {
+    bool        valid = false;      //!< Magic and format version matched.
+    bool        little_endian = false; //!< Payload endianness.
+    bool        has_toc = false;    //!< Component table follows the payload.
+    uint32_t    class_version = 0;  //!< Version the writer passed.
+    std::string class_name;         //!< Demangled class name of the payload.
+    uint64_t    payload_offset = 0; //!< First payload byte in the file.
+};
+
+inline void write_header(const std::string& class_name, uint32_t class_version,
+                         std::ostream& out, bool has_toc=false)
+{
+    out.write(magic, 8);
+    out.put((char)format_version);
+    out.put((char)((little_endian_host() ? 1 : 0) | (has_toc ? 2 : 0)));
+    write_le(class_version, 4, out);
+    write_le(class_name.size(), 2, out);
+    out.write(class_name.data(), class_name.size());
+}
+
+inline file_header read_header(std::istream& in)
+{
+    file_header header;
+    char file_magic[8] = {0};
+    in.read(file_magic, 8);
+    uint8_t version = (uint8_t)in.get();
+    if (!in or 0 != std::memcmp(file_magic, magic, 8)
+        or format_version != version) {
+        return header;
+    }
+    uint64_t flags = read_le(1, in);
+    header.little_endian = (flags & 1);
+    header.has_toc = (flags & 2);
+    header.class_version = (uint32_t)read_le(4, in);
+    uint64_t name_len = read_le(2, in);
+    header.class_name.resize(name_len);
+    in.read(&header.class_name[0], name_len);
+    header.payload_offset = 16 + name_len;
+    header.valid = in.good();
+    return header;
+}
+
+//! One entry of the component table of a portable file with TOC.
+struct toc_entry {
+    std::string path;   //!< structure_tree names joined by '/'.
+    std::string type;   //!< Class name of the component.
+    uint64_t    offset; //!< First byte, relative to the payload start.
+    uint64_t    size;   //!< Serialized size in bytes.
+};
+
+//! Reads the component table of a portable file with TOC.
+/*! Returns an empty vector if the file has no table.
+ */
+inline std::vector<toc_entry> toc(const std::string& file)
+{
+    std::vector<toc_entry> entries;
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        return entries;
+    }
+    file_header header = read_header(in);
+    if (!header.valid or !header.has_toc) {
+        return entries;
+    }
+    in.seekg(-8, std::ios::end);
+    uint64_t toc_offset = read_le(8, in);
+    in.seekg(static_cast<std::streamoff>(toc_offset));
+    uint64_t count = read_le(4, in);
+    entries.resize(count);
+    for (uint64_t i=0; i < count; ++i) {
+        entries[i].path.resize(read_le(2, in));
+        in.read(&entries[i].path[0], entries[i].path.size());
+        entries[i].type.resize(read_le(2, in));
+        in.read(&entries[i].type[0], entries[i].type.size());
+        entries[i].offset = read_le(8, in);
+        entries[i].size   = read_le(8, in);
+    }
+    if (!in.good()) {
+        entries.clear();
+    }
+    return entries;
+}
+
+inline void collect_toc(const memory_layout_node& node, const std::string& prefix,
+                        std::vector<toc_entry>& entries)
+{
+    std::string path = node.name.empty() ? prefix
+                     : (prefix.empty() ? node.name : prefix+"/"+node.name);
+    if (!node.name.empty() and node.contiguous()) {
+        entries.push_back({path, node.type, node.begin, node.bytes});
+    }
+    for (const auto& child : node.children) {
+        collect_toc(child, path, entries);
+    }
+}
+
+//! Reads and returns the header of a portable file.
+/*! The valid member is false if the file is missing or not in the
+ *  portable format.
+ */
+inline file_header inspect(const std::string& file)
+{
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        return file_header();
+    }
+    return read_header(in);
+}
+
+} // end namespace portable_io
+
+//! Stores a structure in the portable container format.
+/*! \param t             Structure to serialize.
+ *  \param file          Name of the output file.
+ *  \param class_version Version the reader must pass to load the file
+ *                       again; bump it whenever the serialized layout
+ *                       of the class changes.
+ *
+ *  The payload is the regular serialize() output with its endianness
+ *  recorded in the header, so storing costs only the header.
+ */
+template<class T>
+bool store_to_file_portable(const T& t, const std::string& file,
+                            uint32_t class_version=1)
+{
+    osfstream out(file, std::ios::binary | std::ios::trunc | std::ios::out);
+    if (!out) {
+        if (util::verbose) {
+            std::cerr << "ERROR: store_to_file_portable not successful for: `"
+                      << file << "`" << std::endl;
+        }
+        return false;
+    }
+    portable_io::write_header(util::class_name(t), class_version, out);
+    serialize(t, out);
+    return true;
+}
+
+//! Loads a structure from the portable container format.
+/*! \param t             Structure to load into.
+ *  \param file          Name of the input file.
+ *  \param class_version Expected class version.
+ *  \return True on success. A file of another class, another version
+ *          or -- for structures without a converting path -- another
+ *          endianness is refused with a warning instead of misread.
+ */
+template<class T>
+bool load_from_file_portable(T& t, const std::string& file,
+                             uint32_t class_version=1)
+{
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        return false;
+    }
+    portable_io::file_header header = portable_io::read_header(in);
+    if (!header.valid) {
+        std::cerr << "WARNING: load_from_file_portable: `" << file
+                  << "` is not a portable sdsl file" << std::endl;
+        return false;
+    }
+    if (header.class_name != util::class_name(t)
+        or header.class_version != class_version) {
+        std::cerr << "WARNING: load_from_file_portable: `" << file
+                  << "` holds `" << header.class_name << "` version "
+                  << header.class_version << ", expected `"
+                  << util::class_name(t) << "` version "
+                  << class_version << std::endl;
+        return false;
+    }
+    if (header.little_endian != portable_io::little_endian_host()) {
+        std::cerr << "WARNING: load_from_file_portable: `" << file
+                  << "` was written on a host of the other endianness "
+                  << "and the class has no converting load path"
+                  << std::endl;
+        return false;
+    }
+    load(t, in);
+    return true;
+}
+
+//! Loads an int_vector from the portable format, converting if needed.
+/*! Specialization with a converting path: an int_vector written on a
+ *  host of the other endianness is loaded by byte-swapping the size
+ *  field and the payload words in place.
+ */
+template<uint8_t t_width>
+bool load_from_file_portable(int_vector<t_width>& v, const std::string& file,
+                             uint32_t class_version=1)
+{
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        return false;
+    }
+    portable_io::file_header header = portable_io::read_header(in);
+    if (!header.valid) {
+        std::cerr << "WARNING: load_from_file_portable: `" << file
+                  << "` is not a portable sdsl file" << std::endl;
+        return false;
+    }
+    if (header.class_name != util::class_name(v)
+        or header.class_version != class_version) {
+        std::cerr << "WARNING: load_from_file_portable: `" << file
+                  << "` holds `" << header.class_name << "` version "
+                  << header.class_version << ", expected `"
+                  << util::class_name(v) << "` version "
+                  << class_version << std::endl;
+        return false;
+    }
+    if (header.little_endian == portable_io::little_endian_host()) {
+        v.load(in);  // fast path: plain load
+        return true;
+    }
+    // converting path: the payload is the regular int_vector
+    // serialization of the other endianness
+    uint64_t size_bits = 0;
+    in.read(reinterpret_cast<char*>(&size_bits), 8);
+    size_bits = portable_io::bswap64(size_bits);
+    if (0 == t_width) {
+        v.width((uint8_t)in.get());
+    }
+    v.bit_resize(size_bits);
+    uint64_t words = (size_bits+63)>>6;
+    in.read(reinterpret_cast<char*>(v.data()),
+            static_cast<std::streamsize>(words<<3));
+    portable_io::bswap64_words(v.data(), words);
+    return in.good() or 0 == words;
+}
+
+//! Stores a structure in the portable format with a component table.
+/*! Like store_to_file_portable, but the serialization is captured with
+ *  the structure_tree offset hook, and a table of contents -- one
+ *  (path, type, offset, size) entry per named component, paths being
+ *  the structure_tree names joined by '/' -- is appended after the
+ *  payload, followed by an 8-byte pointer to the table. The payload
+ *  bytes are unchanged, so load_from_file_portable reads such files as
+ *  usual, and load_component can additionally seek to any recorded
+ *  component directly.
+ */
+template<class T>
+bool store_to_file_portable_toc(const T& t, const std::string& file,
+                                uint32_t class_version=1)
+{
+    osfstream out(file, std::ios::binary | std::ios::trunc | std::ios::out);
+    if (!out) {
+        if (util::verbose) {
+            std::cerr << "ERROR: store_to_file_portable_toc not successful for: `"
+                      << file << "`" << std::endl;
+        }
+        return false;
+    }
+    portable_io::write_header(util::class_name(t), class_version, out, true);
+    uint64_t payload_offset = (uint64_t)out.tellp();
+
+    // serialize with byte-range capture, offsets relative to the payload
+    std::unique_ptr<structure_tree_node> st_node(new structure_tree_node("", ""));
+    structure_tree::offset_source() = [&out, payload_offset] {
+        return (uint64_t)out.tellp() - payload_offset;
+    };
+    serialize(t, out, st_node.get(), "");
+    structure_tree::offset_source() = nullptr;
+
+    memory_layout_node layout;
+    if (1 == st_node->children.size()) {  // the structure itself is the root
+        layout = _layout_from_structure(st_node->children.begin()->second.get());
+    } else {
+        layout = _layout_from_structure(st_node.get());
+    }
+    std::vector<portable_io::toc_entry> entries;
+    portable_io::collect_toc(layout, "", entries);
+
+    uint64_t toc_offset = (uint64_t)out.tellp();
+    portable_io::write_le(entries.size(), 4, out);
+    for (const auto& entry : entries) {
+        portable_io::write_le(entry.path.size(), 2, out);
+        out.write(entry.path.data(), entry.path.size());
+        portable_io::write_le(entry.type.size(), 2, out);
+        out.write(entry.type.data(), entry.type.size());
+        portable_io::write_le(entry.offset, 8, out);
+        portable_io::write_le(entry.size, 8, out);
+    }
+    portable_io::write_le(toc_offset, 8, out);
+    return out.good();
+}
+
+//! Loads a single component out of a portable file with component table.
+/*! \param component Structure to load into, e.g. the csa_type of a CST.
+ *  \param file      File written by store_to_file_portable_toc.
+ *  \param path      Component path: the structure_tree names joined by
+ *                   '/', e.g. "csa" or "csa/wavelet_tree".
+ *  \return True on success; a missing table, unknown path or component
+ *          of another class is refused with a warning.
+ *
+ *  Only the bytes of the component are read, so a CSA-only consumer of
+ *  a serialized CST file pays the load time of the CSA, not of the
+ *  tree. Components whose load() expects enclosing context (support
+ *  structures needing set_vector etc.) have the same obligations as
+ *  after a standalone load.
+ */
+template<class t_component>
+bool load_component(t_component& component, const std::string& file,
+                    const std::string& path)
+{
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        return false;
+    }
+    portable_io::file_header header = portable_io::read_header(in);
+    if (!header.valid or !header.has_toc) {
+        std::cerr << "WARNING: load_component: `" << file
+                  << "` has no component table" << std::endl;
+        return false;
+    }
+    if (header.little_endian != portable_io::little_endian_host()) {
+        std::cerr << "WARNING: load_component: `" << file
+                  << "` was written on a host of the other endianness"
+                  << std::endl;
+        return false;
+    }
+    std::vector<portable_io::toc_entry> entries = portable_io::toc(file);
+    for (const auto& entry : entries) {
+        if (entry.path == path) {
+            if (entry.type != util::class_name(component)) {
+                std::cerr << "WARNING: load_component: component `" << path
+                          << "` of `" << file << "` is a `" << entry.type
+                          << "`, not a `" << util::class_name(component)
+                          << "`" << std::endl;
+                return false;
+            }
+            in.seekg(static_cast<std::streamoff>(header.payload_offset
+                                                 + entry.offset));
+            component.load(in);
+            return in.good();
+        }
+    }
+    std::cerr << "WARNING: load_component: `" << file
+              << "` has no component `" << path << "`" << std::endl;
+    return false;
+}
+
+} // end namespace sdsl
+
+#endif // end file
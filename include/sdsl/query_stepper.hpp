@@ -0,0 +1,207 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file query_stepper.hpp
+    \brief query_stepper.hpp contains resumable step objects for CSA
+           queries, so a driver can interleave many in-flight queries.
+    \author Simon Gog
+
+    A single backward search or locate walk is a chain of dependent
+    memory accesses and therefore latency bound. backward_search_batch
+    and the bulk locate already interleave homogeneous batches
+    internally; the steppers below expose the same step boundaries as
+    resumable objects, so that a caller can software-pipeline an
+    arbitrary mix of queries: keep 16+ steppers in flight, issue all
+    prefetches of a round, then advance each stepper by one step. The
+    independent cache misses of the concurrently advanced steppers
+    overlap, which is where the speed-up on pointer-chasing indexes
+    comes from. execute_interleaved() is the canonical driver loop for
+    a homogeneous set of steppers.
+*/
+#ifndef INCLUDED_SDSL_QUERY_STEPPER
+#define INCLUDED_SDSL_QUERY_STEPPER
+
+#include <vector>
+#include "suffix_array_algorithm.hpp"
+
+namespace sdsl
+{
+
+//! A backward search expressed as a resumable state machine.
+/*! \tparam t_csa      A CSA type.
+ *  \tparam t_pat_iter Pattern iterator type.
+ *
+ *  Each step() matches one further pattern character, i.e. performs
+ *  the two rank queries of one interval refinement; prefetch() issues
+ *  the software prefetches for the memory the next step will touch.
+ *  The stepper is done when the pattern is exhausted or the interval
+ *  became empty.
+ */
+template<class t_csa, class t_pat_iter>
+class backward_search_stepper
+{
+    public:
+        typedef typename t_csa::size_type size_type;
+    private:
+        const t_csa* m_csa;
+        t_pat_iter   m_begin; // first pattern character
+        t_pat_iter   m_it;    // next character to match, moving backwards
+        size_type    m_lb;    // left border of the current interval
+        size_type    m_rb;    // right border of the current interval
+        bool         m_empty; // interval became empty
+    public:
+        //! Starts a backward search for pattern [begin..end) on the full interval.
+        backward_search_stepper(const t_csa& csa, t_pat_iter begin, t_pat_iter end)
+            : m_csa(&csa), m_begin(begin), m_it(end),
+              m_lb(0), m_rb(csa.size()-1), m_empty(false)
+        { }
+
+        bool done() const
+        {
+            return m_empty or m_it == m_begin;
+        }
+
+        //! Prefetches the memory the next step() will access.
+        void prefetch() const
+        {
+            _prefetch_rank_bwt(*m_csa, m_lb, 0);
+            _prefetch_rank_bwt(*m_csa, m_rb+1, 0);
+        }
+
+        //! Matches one further pattern character.
+        void step()
+        {
+            --m_it;
+            if (0 == backward_search(*m_csa, m_lb, m_rb,
+                                     (typename t_csa::char_type)*m_it,
+                                     m_lb, m_rb)) {
+                m_empty = true;
+            }
+        }
+
+        //! Number of occurrences; only meaningful once done().
+        size_type count() const
+        {
+            return m_empty ? 0 : m_rb+1-m_lb;
+        }
+
+        size_type lb() const { return m_lb; }
+        size_type rb() const { return m_rb; }
+};
+
+//! Convenience constructor deducing the stepper type.
+template<class t_csa, class t_pat_iter>
+backward_search_stepper<t_csa, t_pat_iter>
+make_backward_search_stepper(const t_csa& csa, t_pat_iter begin, t_pat_iter end)
+{
+    return backward_search_stepper<t_csa, t_pat_iter>(csa, begin, end);
+}
+
+//! One locate walk of an LF-function based CSA as a resumable state machine.
+/*! \tparam t_csa A CSA type with extract_category lf_tag (e.g. csa_wt).
+ *
+ *  Each step() either resolves the walk at a suffix array sample or
+ *  performs one LF step; prefetch() issues the software prefetch for
+ *  the position the next step will rank.
+ */
+template<class t_csa>
+class locate_stepper
+{
+    public:
+        typedef typename t_csa::size_type size_type;
+    private:
+        static_assert(std::is_same<typename t_csa::extract_category, lf_tag>::value,
+                      "locate_stepper requires an LF-function based CSA");
+        const t_csa* m_csa;
+        size_type    m_i;      // current position of the walk
+        size_type    m_off;    // number of LF steps taken so far
+        size_type    m_result; // resolved text position
+        bool         m_done;
+    public:
+        //! Starts a walk resolving the suffix array value at position i.
+        locate_stepper(const t_csa& csa, size_type i)
+            : m_csa(&csa), m_i(i), m_off(0), m_result(0), m_done(false)
+        { }
+
+        bool done() const
+        {
+            return m_done;
+        }
+
+        //! Prefetches the memory the next step() will access.
+        void prefetch() const
+        {
+            _prefetch_rank_bwt(*m_csa, m_i, 0);
+        }
+
+        //! Resolves at a sample or performs one LF step.
+        void step()
+        {
+            if (m_csa->sa_sample.is_sampled(m_i)) {
+                size_type result = m_csa->sa_sample[m_i] + m_off;
+                m_result = result < m_csa->size() ? result
+                           : result - m_csa->size();
+                m_done   = true;
+            } else {
+                m_i = m_csa->lf[m_i];
+                ++m_off;
+            }
+        }
+
+        //! The located text position; only meaningful once done().
+        size_type result() const
+        {
+            return m_result;
+        }
+};
+
+//! Advances a set of steppers round-robin until all are done.
+/*! \tparam t_stepper A stepper type (done/prefetch/step interface).
+ *  \param steppers The steppers to execute; advanced in place.
+ *
+ *  All prefetches of a round are issued before the first step, so the
+ *  cache misses of the independent steppers stay in flight together.
+ *  Callers with a heterogeneous query mix run the same loop over their
+ *  own stepper collections.
+ */
+template<class t_stepper>
+void execute_interleaved(std::vector<t_stepper>& steppers)
+{
+    std::vector<size_t> active;
+    for (size_t i=0; i < steppers.size(); ++i) {
+        if (!steppers[i].done()) {
+            active.push_back(i);
+        }
+    }
+    while (!active.empty()) {
+        for (size_t j=0; j < active.size(); ++j) {
+            steppers[active[j]].prefetch();
+        }
+        size_t in = 0;
+        for (size_t j=0; j < active.size(); ++j) {
+            t_stepper& s = steppers[active[j]];
+            s.step();
+            if (!s.done()) {
+                active[in++] = active[j];
+            }
+        }
+        active.resize(in);
+    }
+}
+
+} // end namespace sdsl
+
+#endif // end file
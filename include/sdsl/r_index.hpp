@@ -0,0 +1,391 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file r_index.hpp
+    \brief r_index.hpp contains a run-length compressed FM-index with
+           run-boundary SA samples (r-index).
+    \author Simon Gog
+
+    csa_wt<wt_rlmn<>> compresses the BWT to its r runs, but locate
+    still walks to fixed-density SA samples, so each occurrence costs
+    d LF steps and the samples take n/d words regardless of how
+    repetitive the text is. The r-index samples the suffix array only
+    at BWT run boundaries: the backward search carries the SA value of
+    the right interval border (the toehold, refreshed from a run-end
+    sample whenever the border moves), and the remaining occurrences
+    are enumerated with the phi function, which is piecewise linear
+    with one piece per run. Both sample sets are O(r) words, and
+    locate costs O(1) phi evaluations per occurrence.
+*/
+#ifndef INCLUDED_SDSL_R_INDEX
+#define INCLUDED_SDSL_R_INDEX
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "int_vector.hpp"
+#include "int_vector_buffer.hpp"
+#include "io.hpp"
+#include "sd_vector.hpp"
+#include "util.hpp"
+#include "wt_rlmn.hpp"
+
+namespace sdsl
+{
+
+//! A run-length compressed FM-index with run-boundary SA samples.
+/*! \tparam t_wt Wavelet tree type for the BWT; the default wt_rlmn<>
+ *               stores only the run heads, so the whole index is
+ *               O(r) words for a BWT with r runs.
+ *
+ *  The index supports count() and locate() over a byte text; it is
+ *  built from the cached BWT and suffix array (conf::KEY_BWT and
+ *  conf::KEY_SA). Unlike the csa_* classes it does not offer random
+ *  access to SA or ISA — that is the access pattern the run-boundary
+ *  sampling trades away.
+ *
+ *  \par Reference
+ *       Travis Gagie, Gonzalo Navarro, Nicola Prezza:
+ *       Fully Functional Suffix Trees and Optimal Text Searching in
+ *       BWT-Runs Bounded Space. J. ACM 67(1), 2020.
+ */
+template<class t_wt = wt_rlmn<>>
+class r_index
+{
+    public:
+        typedef int_vector<>::size_type size_type;
+        typedef uint8_t                 char_type;
+        typedef t_wt                    wt_type;
+
+    private:
+        size_type                  m_size = 0; // text length n
+        wt_type                    m_wt;       // run-length compressed BWT
+        int_vector<64>             m_C;        // C[c] = # symbols < c
+        sd_vector<>                m_run_end;      // marks run-end BWT positions
+        sd_vector<>::rank_1_type   m_run_end_rank;
+        int_vector<>               m_sa_run_end;   // SA value at each run end
+        sd_vector<>                m_first;        // marks text pos. SA[i], i run start
+        sd_vector<>::rank_1_type   m_first_rank;
+        sd_vector<>::select_1_type m_first_select;
+        int_vector<>               m_phi;      // phi of each marked position
+        size_type                  m_sa_last = 0;  // SA[n-1]; initial toehold
+
+        void copy(const r_index& idx)
+        {
+            m_size        = idx.m_size;
+            m_wt          = idx.m_wt;
+            m_C           = idx.m_C;
+            m_run_end     = idx.m_run_end;
+            m_run_end_rank= idx.m_run_end_rank;
+            m_run_end_rank.set_vector(&m_run_end);
+            m_sa_run_end  = idx.m_sa_run_end;
+            m_first       = idx.m_first;
+            m_first_rank  = idx.m_first_rank;
+            m_first_rank.set_vector(&m_first);
+            m_first_select= idx.m_first_select;
+            m_first_select.set_vector(&m_first);
+            m_phi         = idx.m_phi;
+            m_sa_last     = idx.m_sa_last;
+        }
+
+        //! phi(SA[i]) = SA[i-1] (SA[n-1] for i=0), evaluated per run.
+        /*! phi is linear between consecutive marked positions, with the
+         *  piece below the smallest mark wrapping around to the largest.
+         */
+        size_type phi(size_type p) const
+        {
+            size_type k = m_first_rank(p+1); // # marked positions <= p
+            if (0 == k) { // wrap to the largest marked position
+                size_type p2 = m_first_select(m_phi.size());
+                return (m_phi[m_phi.size()-1] + (p + m_size - p2)) % m_size;
+            }
+            size_type p2 = m_first_select(k);
+            return (m_phi[k-1] + (p - p2)) % m_size;
+        }
+
+        //! One backward search step which maintains the toehold SA[r].
+        /*! \return False if the new interval is empty.
+         *
+         *  If BWT[r]=c the border occurrence survives and its SA value
+         *  just shifts by one; otherwise the last occurrence of c in
+         *  [l,r] ends a c-run, so its SA value is a run-end sample.
+         */
+        bool lf_step(char_type c, size_type& l, size_type& r,
+                     size_type& sa_r) const
+        {
+            size_type rank_l = m_wt.rank(l, c);
+            size_type rank_r = m_wt.rank(r+1, c);
+            if (rank_l >= rank_r) {
+                return false;
+            }
+            if (m_wt[r] == c) {
+                sa_r = sa_r - 1;
+            } else {
+                size_type j = m_wt.select(rank_r, c); // run end, j < r
+                sa_r = m_sa_run_end[m_run_end_rank(j)] - 1;
+            }
+            l = m_C[c] + rank_l;
+            r = m_C[c] + rank_r - 1;
+            return true;
+        }
+
+    public:
+        const wt_type& wt = m_wt;
+
+        //! Default constructor
+        r_index() { }
+
+        //! Copy constructor
+        r_index(const r_index& idx)
+        {
+            copy(idx);
+        }
+
+        //! Move constructor
+        r_index(r_index&& idx)
+        {
+            *this = std::move(idx);
+        }
+
+        //! Constructor taking a cache_config with cached BWT and SA.
+        /*! \param config A cache_config for which conf::KEY_BWT and
+         *                conf::KEY_SA are cached (cf. construct_bwt,
+         *                construct_sa).
+         */
+        r_index(cache_config& config)
+        {
+            int_vector_buffer<8> bwt_buf(cache_file_name(conf::KEY_BWT, config));
+            int_vector_buffer<>  sa_buf(cache_file_name(conf::KEY_SA, config));
+            m_size = bwt_buf.size();
+            if (0 == m_size) {
+                return;
+            }
+            uint8_t sa_width = bits::hi(m_size)+1;
+            size_type cnt[257] = {0};
+            bit_vector run_end_marks(m_size, 0);
+            std::vector<std::pair<size_type, size_type>> first; // (SA[i], phi)
+            size_type runs = 0;
+            uint8_t prev_c = 0;
+            for (size_type i=0; i < m_size; ++i) {
+                uint8_t c = bwt_buf[i];
+                ++cnt[c];
+                if (0 == i or c != prev_c) { // i starts a run
+                    ++runs;
+                    size_type p = sa_buf[i];
+                    size_type ph = (0 == i) ? sa_buf[m_size-1] : sa_buf[i-1];
+                    first.emplace_back(p, ph);
+                    if (i > 0) {
+                        run_end_marks[i-1] = 1;
+                    }
+                }
+                prev_c = c;
+            }
+            run_end_marks[m_size-1] = 1;
+            m_sa_run_end = int_vector<>(runs, 0, sa_width);
+            size_type k = 0;
+            for (size_type i=0; i < m_size; ++i) {
+                if (run_end_marks[i]) {
+                    m_sa_run_end[k++] = sa_buf[i];
+                }
+            }
+            m_run_end = sd_vector<>(run_end_marks);
+            util::init_support(m_run_end_rank, &m_run_end);
+            std::sort(first.begin(), first.end());
+            bit_vector first_marks(m_size, 0);
+            m_phi = int_vector<>(runs, 0, sa_width);
+            for (size_type i=0; i < runs; ++i) {
+                first_marks[first[i].first] = 1;
+                m_phi[i] = first[i].second;
+            }
+            m_first = sd_vector<>(first_marks);
+            util::init_support(m_first_rank, &m_first);
+            util::init_support(m_first_select, &m_first);
+            m_C = int_vector<64>(257, 0);
+            for (size_type c=0; c < 256; ++c) {
+                m_C[c+1] = m_C[c] + cnt[c];
+            }
+            m_sa_last = sa_buf[m_size-1];
+            wt_type tmp_wt(bwt_buf, m_size);
+            m_wt.swap(tmp_wt);
+        }
+
+        //! Assignment operator
+        r_index& operator=(const r_index& idx)
+        {
+            if (this != &idx) {
+                copy(idx);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        r_index& operator=(r_index&& idx)
+        {
+            if (this != &idx) {
+                m_size        = idx.m_size;
+                m_wt          = std::move(idx.m_wt);
+                m_C           = std::move(idx.m_C);
+                m_run_end     = std::move(idx.m_run_end);
+                m_run_end_rank= std::move(idx.m_run_end_rank);
+                m_run_end_rank.set_vector(&m_run_end);
+                m_sa_run_end  = std::move(idx.m_sa_run_end);
+                m_first       = std::move(idx.m_first);
+                m_first_rank  = std::move(idx.m_first_rank);
+                m_first_rank.set_vector(&m_first);
+                m_first_select= std::move(idx.m_first_select);
+                m_first_select.set_vector(&m_first);
+                m_phi         = std::move(idx.m_phi);
+                m_sa_last     = idx.m_sa_last;
+            }
+            return *this;
+        }
+
+        void swap(r_index& idx)
+        {
+            if (this != &idx) {
+                std::swap(m_size, idx.m_size);
+                m_wt.swap(idx.m_wt);
+                m_C.swap(idx.m_C);
+                m_run_end.swap(idx.m_run_end);
+                util::swap_support(m_run_end_rank, idx.m_run_end_rank,
+                                   &m_run_end, &idx.m_run_end);
+                m_sa_run_end.swap(idx.m_sa_run_end);
+                m_first.swap(idx.m_first);
+                util::swap_support(m_first_rank, idx.m_first_rank,
+                                   &m_first, &idx.m_first);
+                util::swap_support(m_first_select, idx.m_first_select,
+                                   &m_first, &idx.m_first);
+                m_phi.swap(idx.m_phi);
+                std::swap(m_sa_last, idx.m_sa_last);
+            }
+        }
+
+        //! Length of the indexed text (including the sentinel).
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        //! Number of BWT runs r.
+        size_type runs() const
+        {
+            return m_phi.size();
+        }
+
+        //! Counts the occurrences of pattern [begin, end).
+        /*! \par Time complexity
+         *       \f$ \Order{ m \cdot t_{rank} } \f$ for a pattern of
+         *       length m.
+         */
+        template<class t_pat_iter>
+        size_type count(t_pat_iter begin, t_pat_iter end) const
+        {
+            if (0 == m_size) {
+                return 0;
+            }
+            size_type l = 0, r = m_size-1;
+            for (t_pat_iter it = end; it != begin and l <= r;) {
+                --it;
+                char_type c = (char_type)*it;
+                size_type rank_l = m_wt.rank(l, c);
+                size_type rank_r = m_wt.rank(r+1, c);
+                if (rank_l >= rank_r) {
+                    return 0;
+                }
+                l = m_C[c] + rank_l;
+                r = m_C[c] + rank_r - 1;
+            }
+            return r+1-l;
+        }
+
+        //! Reports all occurrences of pattern [begin, end).
+        /*! \return Vector of the text positions of the occurrences, in
+         *          suffix array order (not sorted by position).
+         *
+         *  \par Time complexity
+         *       \f$ \Order{ m \cdot t_{rank} + occ } \f$ — the backward
+         *       search maintains the SA value of the right interval
+         *       border, and every further occurrence costs one phi
+         *       evaluation instead of a walk to a fixed-density sample.
+         */
+        template<class t_pat_iter>
+        std::vector<size_type> locate(t_pat_iter begin, t_pat_iter end) const
+        {
+            std::vector<size_type> res;
+            if (0 == m_size) {
+                return res;
+            }
+            size_type l = 0, r = m_size-1, sa_r = m_sa_last;
+            for (t_pat_iter it = end; it != begin;) {
+                --it;
+                if (!lf_step((char_type)*it, l, r, sa_r)) {
+                    return res;
+                }
+            }
+            res.resize(r+1-l);
+            size_type p = sa_r;
+            for (size_type k = res.size(); k-- > 0;) {
+                res[k] = p;
+                if (k > 0) {
+                    p = phi(p);
+                }
+            }
+            return res;
+        }
+
+        //! Serializes the index to a stream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += m_wt.serialize(out, child, "wt");
+            written_bytes += m_C.serialize(out, child, "C");
+            written_bytes += m_run_end.serialize(out, child, "run_end");
+            written_bytes += m_run_end_rank.serialize(out, child, "run_end_rank");
+            written_bytes += m_sa_run_end.serialize(out, child, "sa_run_end");
+            written_bytes += m_first.serialize(out, child, "first");
+            written_bytes += m_first_rank.serialize(out, child, "first_rank");
+            written_bytes += m_first_select.serialize(out, child, "first_select");
+            written_bytes += m_phi.serialize(out, child, "phi");
+            written_bytes += write_member(m_sa_last, out, child, "sa_last");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the index from a stream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            m_wt.load(in);
+            m_C.load(in);
+            m_run_end.load(in);
+            m_run_end_rank.load(in, &m_run_end);
+            m_sa_run_end.load(in);
+            m_first.load(in);
+            m_first_rank.load(in, &m_first);
+            m_first_select.load(in, &m_first);
+            m_phi.load(in);
+            read_member(m_sa_last, in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
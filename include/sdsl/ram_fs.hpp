@@ -8,6 +8,7 @@
 #include "uintx_t.hpp"
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 #include <mutex>
 
@@ -35,8 +36,14 @@ class ram_fs
     private:
         friend class ram_fs_initializer;
         typedef std::map<std::string, content_type> mss_type;
-        static mss_type m_map;
-        static std::recursive_mutex m_rlock;
+        // the store is sharded by file name hash, so that concurrent
+        // construction jobs which work on different RAM-files do not
+        // serialize on one global lock
+        static const size_t m_shards = 64;
+        static mss_type m_map[m_shards];
+        static std::recursive_mutex m_rlock[m_shards];
+        // shard which is responsible for file `name`
+        static size_t shard_id(const std::string& name);
 
     public:
         //! Default construct
@@ -48,6 +55,31 @@ class ram_fs
         static size_t file_size(const std::string& name);
         //! Get the content
         static content_type& content(const std::string& name);
+        //! Open a file and return a stable handle to its content.
+        /*! \param name   The file name.
+         *  \param create If true, a missing file is created empty.
+         *  \return Pointer to the content, or nullptr if the file does not
+         *          exist and `create` is false.
+         *
+         * Performs one lookup under one shard lock. The handle stays valid
+         * until the file is removed or renamed (map nodes are stable), so
+         * reads and writes through it take no lock at all; ram_filebuf keeps
+         * the handle for the lifetime of the stream and never looks up the
+         * name again.
+         */
+        static content_type* open_handle(const std::string& name, bool create);
+        //! Take a frozen copy of the content of file `name`.
+        /*! \param name The file name.
+         *  \return Shared pointer to an immutable copy of the content,
+         *          or nullptr if the file does not exist.
+         *
+         * The copy is taken under the shard lock of the file, so writers
+         * stall for the duration of one memcpy instead of a full
+         * serialization; the snapshot can then be written to disk from a
+         * background thread (see store_to_file_background) while
+         * foreground operations continue on the live file.
+         */
+        static std::shared_ptr<const content_type> snapshot(const std::string& name);
         //! Remove the file with key `name`
         static int remove(const std::string& name);
         //! Rename the file. Change key `old_filename` into `new_filename`.
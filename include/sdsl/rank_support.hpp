@@ -105,6 +105,11 @@ struct rank_support_trait {
         return 0;
     }
 
+    static size_type full_words_rank(const uint64_t*, size_type, size_type)
+    {
+        return 0;
+    }
+
     static uint64_t init_carry()
     {
         return 0;
@@ -130,6 +135,11 @@ struct rank_support_trait<0,1> {
         return	bits::cnt((~*(data+(idx>>6))));
     }
 
+    static size_type full_words_rank(const uint64_t* data, size_type word_pos, size_type word_num)
+    {
+        return (word_num<<6) - bits::cnt_words(data+word_pos, word_num);
+    }
+
     static uint64_t init_carry()
     {
         return 0;
@@ -155,6 +165,11 @@ struct rank_support_trait<1,1> {
         return	bits::cnt(*(data+(idx>>6)));
     }
 
+    static size_type full_words_rank(const uint64_t* data, size_type word_pos, size_type word_num)
+    {
+        return bits::cnt_words(data+word_pos, word_num);
+    }
+
     static uint64_t init_carry()
     {
         return 0;
@@ -184,6 +199,15 @@ struct rank_support_trait<10,2> {
         return	bits::cnt(bits::map10(*data, carry));
     }
 
+    static size_type full_words_rank(const uint64_t* data, size_type word_pos, size_type word_num)
+    {
+        size_type res = 0;
+        for (size_type i=0; i < word_num; ++i) {
+            res += full_word_rank(data, (word_pos+i)<<6);
+        }
+        return res;
+    }
+
     static uint64_t init_carry()
     {
         return 0;
@@ -213,6 +237,15 @@ struct rank_support_trait<01,2> {
         return	bits::cnt(bits::map01(*data, carry));
     }
 
+    static size_type full_words_rank(const uint64_t* data, size_type word_pos, size_type word_num)
+    {
+        size_type res = 0;
+        for (size_type i=0; i < word_num; ++i) {
+            res += full_word_rank(data, (word_pos+i)<<6);
+        }
+        return res;
+    }
+
     static uint64_t init_carry()
     {
         return 1;
@@ -244,6 +277,15 @@ struct rank_support_trait<00,2> {
         return bits::cnt(~(*data | ((*data)<<1 | carry)));
     }
 
+    static size_type full_words_rank(const uint64_t* data, size_type word_pos, size_type word_num)
+    {
+        size_type res = 0;
+        for (size_type i=0; i < word_num; ++i) {
+            res += full_word_rank(data, (word_pos+i)<<6);
+        }
+        return res;
+    }
+
     static uint64_t init_carry()
     {
         return 1;
@@ -275,6 +317,15 @@ struct rank_support_trait<11,2> {
         return bits::cnt(*data & ((*data)<<1 | carry));
     }
 
+    static size_type full_words_rank(const uint64_t* data, size_type word_pos, size_type word_num)
+    {
+        size_type res = 0;
+        for (size_type i=0; i < word_num; ++i) {
+            res += full_word_rank(data, (word_pos+i)<<6);
+        }
+        return res;
+    }
+
     static uint64_t init_carry()
     {
         return 0;
@@ -285,6 +336,8 @@ struct rank_support_trait<11,2> {
 
 #include "rank_support_v.hpp"
 #include "rank_support_v5.hpp"
+#include "rank_support_poppy.hpp"
 #include "rank_support_scan.hpp"
+#include "rank_support_int.hpp"
 
 #endif // end file 
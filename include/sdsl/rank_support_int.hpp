@@ -0,0 +1,306 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file rank_support_int.hpp
+    \brief rank_support_int.hpp contains rank and select support for
+           int_vectors over small fixed-width alphabets (2 and 4 bit).
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_RANK_SUPPORT_INT
+#define INCLUDED_SDSL_RANK_SUPPORT_INT
+
+#include <array>
+#include "int_vector.hpp"
+
+namespace sdsl
+{
+
+//! Word kernels for counting fixed-width symbols in 64-bit words.
+/*! For a word holding 64/t_width packed symbols, mask_eq() marks every
+ *  symbol equal to a query symbol with a single bit, so occurrences can
+ *  be counted with one popcount (mask-compare + cnt).
+ */
+template<uint8_t t_width>
+struct rank_support_int_trait;
+
+template<>
+struct rank_support_int_trait<2> {
+    //! Returns the query symbol c repeated in every 2-bit slot.
+    static uint64_t pattern(uint64_t c)
+    {
+        return c * 0x5555555555555555ULL;
+    }
+
+    //! Marks each 2-bit symbol equal to the pattern with its low bit.
+    static uint64_t mask_eq(uint64_t w, uint64_t pat)
+    {
+        uint64_t x = ~(w ^ pat);
+        x &= x >> 1;
+        return x & 0x5555555555555555ULL;
+    }
+};
+
+template<>
+struct rank_support_int_trait<4> {
+    //! Returns the query symbol c repeated in every 4-bit slot.
+    static uint64_t pattern(uint64_t c)
+    {
+        return c * 0x1111111111111111ULL;
+    }
+
+    //! Marks each 4-bit symbol equal to the pattern with its low bit.
+    static uint64_t mask_eq(uint64_t w, uint64_t pat)
+    {
+        uint64_t x = ~(w ^ pat);
+        x &= x >> 2;
+        x &= x >> 1;
+        return x & 0x1111111111111111ULL;
+    }
+};
+
+//! Rank and select support for int_vectors over 2- or 4-bit alphabets.
+/*! Answers for every symbol c of the alphabet the queries
+ *  rank(i,c) = occurrences of c in v[0..i-1] and
+ *  select(i,c) = position of the i-th occurrence of c.
+ *
+ *  The structure uses the interleaved block layout of rank_support_v:
+ *  per superblock of 512 symbols and per symbol an absolute count and
+ *  a word which packs the seven 9-bit counts at the 64-symbol basic
+ *  block boundaries. In-word counting is done with the mask-compare +
+ *  popcount kernels of rank_support_int_trait, so a rank query costs
+ *  two array accesses plus at most t_width popcounts and avoids the
+ *  \f$\log\sigma\f$ wavelet tree descent entirely.
+ *
+ *  \tparam t_width Width of the supported int_vector; 2 or 4.
+ *
+ *  \par Space complexity
+ *       \f$ 2\sigma/512 \f$ words per symbol of the supported vector,
+ *       i.e. 25% overhead for t_width=2 and t_width=4.
+ */
+template<uint8_t t_width=2>
+class rank_support_int_v
+{
+        static_assert(t_width == 2 or t_width == 4,
+                      "rank_support_int_v: width has to be 2 or 4");
+    public:
+        typedef int_vector<t_width>                int_vector_type;
+        typedef typename int_vector_type::size_type  size_type;
+        typedef typename int_vector_type::value_type value_type;
+        enum { sigma = 1ULL << t_width };
+    private:
+        typedef rank_support_int_trait<t_width> trait_type;
+        // symbols per data word and data words per basic block
+        enum { t_spw = 64/t_width, t_wpb = t_width };
+
+        const int_vector_type* m_v = nullptr; // supported vector
+        // per superblock and symbol: (absolute count, packed relative
+        // counts at the basic block boundaries); one sentinel
+        // superblock at the end holds the total counts
+        int_vector<64> m_block;
+
+        size_type block_idx(size_type sb, value_type c) const
+        {
+            return 2*(sb*sigma + c);
+        }
+
+    public:
+        //! Constructor
+        /*! \param v Pointer to the supported int_vector.
+         */
+        rank_support_int_v(const int_vector_type* v = nullptr)
+        {
+            set_vector(v);
+            if (nullptr == m_v)
+                return;
+            size_type n      = m_v->size();
+            size_type num_sb = (n+511)>>9;
+            m_block = int_vector<64>((num_sb+1)*sigma*2, 0);
+            const uint64_t* data = m_v->data();
+            size_type total_words = (n*t_width+63)>>6;
+            uint64_t last_mask = bits::lo_set[(n*t_width)&0x3F];
+            if (0 == ((n*t_width)&0x3F))
+                last_mask = bits::all_set;
+
+            std::array<size_type, sigma> abs_cnt;
+            abs_cnt.fill(0);
+            for (size_type sb=0; sb < num_sb; ++sb) {
+                std::array<size_type, sigma> rel;
+                rel.fill(0);
+                for (value_type c=0; c < sigma; ++c) {
+                    m_block[block_idx(sb, c)] = abs_cnt[c];
+                }
+                for (size_type bb=0; bb < 8; ++bb) {
+                    if (bb > 0) {
+                        for (value_type c=0; c < sigma; ++c) {
+                            m_block[block_idx(sb, c)+1] |=
+                                ((uint64_t)rel[c]) << (9*(bb-1));
+                        }
+                    }
+                    size_type w = sb*8*t_wpb + bb*t_wpb;
+                    for (size_type j=0; j < t_wpb and w+j < total_words; ++j) {
+                        for (value_type c=0; c < sigma; ++c) {
+                            uint64_t eq = trait_type::mask_eq(data[w+j],
+                                                             trait_type::pattern(c));
+                            if (w+j+1 == total_words) {
+                                // exclude the padding symbols
+                                eq &= last_mask;
+                            }
+                            rel[c] += bits::cnt(eq);
+                        }
+                    }
+                }
+                for (value_type c=0; c < sigma; ++c) {
+                    abs_cnt[c] += rel[c];
+                }
+            }
+            for (value_type c=0; c < sigma; ++c) {
+                m_block[block_idx(num_sb, c)] = abs_cnt[c];
+            }
+        }
+
+        rank_support_int_v(const rank_support_int_v&) = default;
+        rank_support_int_v(rank_support_int_v&&) = default;
+        rank_support_int_v& operator=(const rank_support_int_v&) = default;
+        rank_support_int_v& operator=(rank_support_int_v&&) = default;
+
+        //! Counts the occurrences of symbol c in the prefix [0..idx-1]
+        /*! \param idx Argument for the length of the prefix v[0..idx-1].
+         *  \param c   The counted symbol.
+         *  \par Time complexity
+         *       \f$ \Order{1} \f$
+         */
+        size_type rank(size_type idx, value_type c) const
+        {
+            assert(m_v != nullptr);
+            assert(idx <= m_v->size());
+            assert(c < sigma);
+            const uint64_t* data = m_v->data();
+            size_type sb  = idx>>9;
+            size_type bb  = (idx&0x1FF)>>6;
+            size_type res = m_block[block_idx(sb, c)];
+            if (bb > 0) {
+                res += (m_block[block_idx(sb, c)+1] >> (9*(bb-1))) & 0x1FF;
+            }
+            uint64_t pat       = trait_type::pattern(c);
+            size_type bit_idx  = idx*t_width;
+            size_type word     = sb*8*t_wpb + bb*t_wpb;
+            size_type last_word = bit_idx>>6;
+            for (; word < last_word; ++word) {
+                res += bits::cnt(trait_type::mask_eq(data[word], pat));
+            }
+            if (bit_idx&0x3F) {
+                res += bits::cnt(trait_type::mask_eq(data[word], pat)
+                                 & bits::lo_set[bit_idx&0x3F]);
+            }
+            return res;
+        }
+
+        //! Alias for rank(idx, c)
+        size_type operator()(size_type idx, value_type c) const
+        {
+            return rank(idx, c);
+        }
+
+        //! Returns the position of the i-th occurrence of symbol c.
+        /*! \param i The 1-based rank of the queried occurrence;
+         *           \f$ 1 \leq i \leq rank(size(), c)\f$.
+         *  \param c The queried symbol.
+         *  \par Time complexity
+         *       \f$ \Order{\log{\frac{n}{512}}} \f$ for the binary search
+         *       on the superblock counts plus constant in-block work.
+         */
+        size_type select(size_type i, value_type c) const
+        {
+            assert(m_v != nullptr);
+            assert(c < sigma);
+            size_type num_sb = m_block.size()/(2*sigma) - 1;
+            assert(i > 0 and i <= m_block[block_idx(num_sb, c)]);
+            // largest superblock sb with absolute count < i
+            size_type begin = 0, end = num_sb;
+            while (begin+1 < end) {
+                size_type mid = (begin+end)>>1;
+                if (m_block[block_idx(mid, c)] < i)
+                    begin = mid;
+                else
+                    end = mid;
+            }
+            size_type sb  = (m_block[block_idx(end, c)] < i) ? end : begin;
+            size_type rem = i - m_block[block_idx(sb, c)];
+            // largest basic block with relative count < rem
+            uint64_t rel = m_block[block_idx(sb, c)+1];
+            size_type bb = 0;
+            while (bb < 7 and ((rel >> (9*bb)) & 0x1FF) < rem) {
+                ++bb;
+            }
+            if (bb > 0) {
+                rem -= (rel >> (9*(bb-1))) & 0x1FF;
+            }
+            uint64_t pat   = trait_type::pattern(c);
+            size_type word = sb*8*t_wpb + bb*t_wpb;
+            const uint64_t* data = m_v->data();
+            while (true) {
+                uint64_t eq = trait_type::mask_eq(data[word], pat);
+                size_type cnt = bits::cnt(eq);
+                if (rem <= cnt) {
+                    return (word<<6 | bits::sel(eq, rem)) / t_width;
+                }
+                rem -= cnt;
+                ++word;
+            }
+        }
+
+        //! Returns the size of the supported vector.
+        size_type size() const
+        {
+            return nullptr == m_v ? 0 : m_v->size();
+        }
+
+        //! Sets the supported vector to the given pointer.
+        void set_vector(const int_vector_type* v = nullptr)
+        {
+            m_v = v;
+        }
+
+        //! Swap operation
+        void swap(rank_support_int_v& rs)
+        {
+            if (this != &rs) {
+                m_block.swap(rs.m_block);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = m_block.serialize(out, child, "block");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in, const int_vector_type* v=nullptr)
+        {
+            m_block.load(in);
+            set_vector(v);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -0,0 +1,181 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file rank_support_poppy.hpp
+    \brief rank_support_poppy.hpp contains rank_support_poppy, a rank
+           structure with one interleaved count word per 2048-bit block.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_RANK_SUPPORT_POPPY
+#define INCLUDED_SDSL_RANK_SUPPORT_POPPY
+
+#include "rank_support.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A poppy-style rank structure with interleaved single-word counts.
+/*! \par Space complexity
+ *  \f$ 0.032n \f$ bits for a bit vector of length n bits.
+ *
+ * One 64-bit header per basic block of 2048 bits: a 32-bit count of
+ * arguments before the block (relative to a sparse upper level with
+ * one entry per 2^32 bits) and three 10-bit counts, one per 512-bit
+ * sub-block. A query reads the header word, adds up to three sub-block
+ * counts from it and popcounts at most eight data words — all counts
+ * for a block come from one word, so there is no second level of
+ * indirection on the hot path as in rank_support_v5, and the overhead
+ * is an eighth of the 25% of rank_support_v.
+ *
+ * \tparam t_b       Bit pattern `0` or `1` which should be ranked.
+ * \tparam t_pat_len Length of the bit pattern (must be 1).
+ *
+ * \par Reference
+ *    Dong Zhou, David G. Andersen, Michael Kaminsky:
+ *    Space-Efficient, High-Performance Rank and Select Structures on
+ *    Uncompressed Bit Sequences. SEA 2013: 151-163
+ *
+ * @ingroup rank_support_group
+ */
+template<uint8_t t_b=1, uint8_t t_pat_len=1>
+class rank_support_poppy : public rank_support
+{
+    private:
+        static_assert(t_b == 1u or t_b == 0u,
+                      "rank_support_poppy: bit pattern must be `0` or `1`");
+        static_assert(t_pat_len == 1u,
+                      "rank_support_poppy: bit pattern length must be 1");
+    public:
+        typedef bit_vector                         bit_vector_type;
+        typedef rank_support_trait<t_b, t_pat_len> trait_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = t_pat_len };
+    private:
+        int_vector<64> m_block; // one interleaved count word per 2048 bits
+        int_vector<64> m_upper; // absolute count per 2^32 bits
+
+    public:
+        explicit rank_support_poppy(const bit_vector* v = nullptr)
+        {
+            set_vector(v);
+            if (v == nullptr) {
+                return;
+            }
+            size_type words   = v->capacity()>>6;
+            size_type nblocks = (v->capacity()>>11)+1; // incl. trailing header
+            m_block = int_vector<64>(nblocks, 0);
+            m_upper = int_vector<64>((v->capacity()>>32)+1, 0);
+            const uint64_t* data = v->data();
+            uint64_t carry = trait_type::init_carry();
+            size_type total = 0; // arguments before the current block
+            for (size_type b=0; b < nblocks; ++b) {
+                if (0 == (b & ((1ULL<<21)-1))) { // every 2^32 bits
+                    m_upper[b>>21] = total;
+                }
+                uint64_t hdr = total - m_upper[b>>21];
+                size_type word0 = b<<5, sub_cnt = 0, k = 0;
+                for (; k < 32 and word0+k < words; ++k) {
+                    if (k > 0 and 0 == (k & 0x7)) { // sub-block boundary
+                        hdr |= (uint64_t)sub_cnt << (32 + 10*((k>>3)-1));
+                        sub_cnt = 0;
+                    }
+                    size_type c = trait_type::args_in_the_word(data[word0+k],
+                                                               carry);
+                    total   += c;
+                    sub_cnt += c;
+                }
+                // the data may end exactly on a sub-block boundary of a
+                // partial block; rank(size()) still needs that count
+                if (k > 0 and k < 32 and 0 == (k & 0x7)) {
+                    hdr |= (uint64_t)sub_cnt << (32 + 10*((k>>3)-1));
+                }
+                m_block[b] = hdr;
+            }
+        }
+
+        rank_support_poppy(const rank_support_poppy&) = default;
+        rank_support_poppy(rank_support_poppy&&) = default;
+        rank_support_poppy& operator=(const rank_support_poppy&) = default;
+        rank_support_poppy& operator=(rank_support_poppy&&) = default;
+
+        size_type rank(size_type idx) const
+        {
+            assert(m_v != nullptr);
+            assert(idx <= m_v->size());
+            uint64_t hdr = m_block[idx>>11];
+            size_type res = m_upper[idx>>32] + (hdr & 0xFFFFFFFFULL);
+            // branchless sum of the sub-block counts below idx's sub-block
+            static const uint64_t mask[4] = {0, 0x3FFULL, 0xFFFFFULL,
+                                             0x3FFFFFFFULL
+                                            };
+            uint64_t rel = (hdr >> 32) & mask[(idx>>9) & 0x3];
+            res += (rel & 0x3FF) + ((rel>>10) & 0x3FF) + ((rel>>20) & 0x3FF);
+            const uint64_t* data = m_v->data();
+            size_type first = (idx>>6) & ~0x7ULL; // first word of the sub-block
+            res += trait_type::full_words_rank(data, first, (idx>>6)-first);
+            if (idx & 0x3F) {
+                res += trait_type::word_rank(data, idx);
+            }
+            return res;
+        }
+
+        size_type operator()(size_type idx) const
+        {
+            return rank(idx);
+        }
+
+        size_type size() const
+        {
+            return m_v->size();
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            size_type written_bytes = 0;
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            written_bytes += m_block.serialize(out, child, "block");
+            written_bytes += m_upper.serialize(out, child, "upper");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in, const bit_vector* v=nullptr)
+        {
+            set_vector(v);
+            m_block.load(in);
+            m_upper.load(in);
+        }
+
+        void set_vector(const bit_vector* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        void swap(rank_support_poppy& rs)
+        {
+            if (this != &rs) {
+                m_block.swap(rs.m_block);
+                m_upper.swap(rs.m_upper);
+            }
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -95,12 +95,7 @@ inline typename rank_support_scan<t_b, t_pat_len>::size_type rank_support_scan<t
     assert(m_v != nullptr);
     assert(idx <= m_v->size());
     const uint64_t* p   = m_v->data();
-    size_type       i   = 0;
-    size_type   result  = 0;
-    while (i+64 <= idx) {
-        result += rank_support_trait<t_b, t_pat_len>::full_word_rank(p, i);
-        i += 64;
-    }
+    size_type result = rank_support_trait<t_b, t_pat_len>::full_words_rank(p, 0, idx>>6);
     return  result+rank_support_trait<t_b, t_pat_len>::word_rank(p, idx);
 }
 
@@ -22,6 +22,7 @@
 #define INCLUDED_SDSL_RANK_SUPPORT_V
 
 #include "rank_support.hpp"
+#include <vector>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -127,6 +128,27 @@ class rank_support_v : public rank_support
             return rank(idx);
         }
 
+        //! Answers rank queries for a batch of independent positions.
+        /*! \param idx Array of n query positions, each in \f$[0..size()]\f$.
+            \param n   Number of queries.
+            \param res Array of size n; res[k] is set to rank(idx[k]).
+            \par The counter and data words of upcoming queries are
+                 software-prefetched while earlier queries are computed, so
+                 the DRAM latencies of independent lookups overlap.
+         */
+        void rank_batch(const size_type* idx, size_type n, size_type* res) const {
+            const size_type lookahead = 8;
+            for (size_type k=0; k < n; ++k) {
+                if (k+lookahead < n) {
+                    size_type j = idx[k+lookahead];
+                    bits::prefetch(m_basic_block.data()
+                                   + ((j>>8)&0xFFFFFFFFFFFFFFFEULL));
+                    bits::prefetch(m_v->data() + (j>>6));
+                }
+                res[k] = rank(idx[k]);
+            }
+        }
+
         size_type size()const {
             return m_v->size();
         }
@@ -156,6 +178,180 @@ class rank_support_v : public rank_support
                 m_basic_block.swap(rs.m_basic_block);
             }
         }
+
+        //! Incremental builder for the interleaved rank counts.
+        /*! Collects the number of set bits of the supported bit vector
+         *  while it is being written (e.g. during wavelet tree construction
+         *  or a bulk logical operation), so no second scan over the
+         *  finished bit vector is needed. Sequential word streams
+         *  (add_word) assemble the basic blocks directly; scattered 1-runs
+         *  (add_ones) are gathered in a per-word count array first and
+         *  assembled in finish(). The two feeding styles must not be
+         *  mixed. Only the plain pattern `1` can be built this way.
+         */
+        class builder
+        {
+            private:
+                std::vector<uint8_t> m_word_cnt; // set bits per data word (add_ones)
+                int_vector<64>       m_bb;       // basic blocks under assembly (add_word)
+                size_type            m_bits  = 0; // size of the supported bit vector
+                size_type            m_words = 0; // words fed via add_word
+                size_type            m_j     = 0;
+                uint64_t             m_sum   = 0;
+                uint64_t             m_second_level_cnt = 0;
+                bool                 m_active = false;
+            public:
+                builder() {}
+
+                //! Prepare the builder for a bit vector of n bits.
+                void init(size_type n) {
+                    m_word_cnt.clear();
+                    m_bb.resize(0);
+                    m_bits   = n;
+                    m_words  = 0;
+                    m_active = true;
+                }
+
+                //! Returns true if init was called, i.e. counts are collected.
+                bool active() const {
+                    return m_active;
+                }
+
+                //! Append the next data word of the bit vector.
+                /*! The basic blocks are assembled on the fly, mirroring one
+                 *  iteration of the scanning constructor per call.
+                 */
+                void add_word(uint64_t w) {
+                    if (m_words == 0) { // first word: set up the basic blocks
+                        size_type words = (m_bits+63)>>6;
+                        m_bb = int_vector<64>(((words>>3)+1)<<1, 0);
+                        m_sum = bits::cnt(w);
+                        m_second_level_cnt = 0;
+                        m_j = 0;
+                        m_words = 1;
+                        return;
+                    }
+                    if (!(m_words&0x7)) { // if m_words%8==0
+                        m_j += 2;
+                        m_bb[m_j-1] = m_second_level_cnt;
+                        m_bb[m_j]   = m_bb[m_j-2] + m_sum;
+                        m_second_level_cnt = m_sum = 0;
+                    } else {
+                        m_second_level_cnt |= m_sum<<(63-9*(m_words&0x7));
+                    }
+                    m_sum += bits::cnt(w);
+                    ++m_words;
+                }
+
+                //! Append n consecutive data words (bulk variant of add_word).
+                /*! Whole superblocks are processed branch-free with an
+                 *  unrolled prefix sum over the eight word counts.
+                 */
+                void add_words(const uint64_t* w, size_type n) {
+                    while (n > 0 and (m_words == 0 or (m_words&0x7) != 0)) {
+                        add_word(*w);
+                        ++w; --n;
+                    }
+                    while (n >= 8) { // m_words is a positive multiple of 8
+                        m_j += 2;    // flush the finished superblock
+                        m_bb[m_j-1] = m_second_level_cnt;
+                        m_bb[m_j]   = m_bb[m_j-2] + m_sum;
+                        uint64_t p = bits::cnt(w[0]);
+                        uint64_t second = p<<54;
+                        p += bits::cnt(w[1]); second |= p<<45;
+                        p += bits::cnt(w[2]); second |= p<<36;
+                        p += bits::cnt(w[3]); second |= p<<27;
+                        p += bits::cnt(w[4]); second |= p<<18;
+                        p += bits::cnt(w[5]); second |= p<<9;
+                        p += bits::cnt(w[6]); second |= p;
+                        m_second_level_cnt = second;
+                        m_sum = p + bits::cnt(w[7]);
+                        m_words += 8;
+                        w += 8; n -= 8;
+                    }
+                    while (n > 0) {
+                        add_word(*w);
+                        ++w; --n;
+                    }
+                }
+
+                //! Record a run of `times` set bits starting at position pos.
+                void add_ones(size_type pos, uint64_t times) {
+                    if (m_word_cnt.empty()) {
+                        m_word_cnt.assign((m_bits+63)>>6, 0);
+                    }
+                    while (times > 0) {
+                        uint64_t in_word = 64 - (pos&0x3F);
+                        if (in_word > times)
+                            in_word = times;
+                        m_word_cnt[pos>>6] += in_word;
+                        pos   += in_word;
+                        times -= in_word;
+                    }
+                }
+
+                //! Assemble the rank support for v from the collected counts.
+                rank_support_v finish(const bit_vector* v) {
+                    static_assert(t_b == 1u and t_pat_len == 1u,
+                                  "rank_support_v::builder: only pattern `1` can be built from word counts");
+                    rank_support_v rs;
+                    rs.set_vector(v);
+                    m_active = false;
+                    if (v == nullptr) {
+                        return rs;
+                    } else if (v->empty()) {
+                        rs.m_basic_block = int_vector<64>(2,0);
+                        return rs;
+                    }
+                    if (m_words > 0) { // fed via add_word: only the tail is left
+                        assert(m_words == (v->capacity()>>6));
+                        if (m_words&0x7) { // if m_words%8 != 0
+                            m_second_level_cnt |= m_sum << (63-9*(m_words&0x7));
+                            m_bb[m_j+1] = m_second_level_cnt;
+                        } else { // if m_words%8 == 0
+                            m_j += 2;
+                            m_bb[m_j-1] = m_second_level_cnt;
+                            m_bb[m_j]   = m_bb[m_j-2] + m_sum;
+                            m_bb[m_j+1] = 0;
+                        }
+                        rs.m_basic_block = std::move(m_bb);
+                        m_words = 0;
+                        return rs;
+                    }
+                    if (m_word_cnt.empty()) { // no 1-run was ever recorded
+                        m_word_cnt.assign((m_bits+63)>>6, 0);
+                    }
+                    size_type basic_block_size = ((v->capacity() >> 9)+1)<<1;
+                    rs.m_basic_block.resize(basic_block_size);
+                    if (rs.m_basic_block.empty())
+                        return rs;
+                    size_type i, j=0;
+                    rs.m_basic_block[0] = rs.m_basic_block[1] = 0;
+                    uint64_t sum = m_word_cnt[0];
+                    uint64_t second_level_cnt = 0;
+                    for (i = 1; i < (v->capacity()>>6) ; ++i) {
+                        if (!(i&0x7)) {// if i%8==0
+                            j += 2;
+                            rs.m_basic_block[j-1] = second_level_cnt;
+                            rs.m_basic_block[j]   = rs.m_basic_block[j-2] + sum;
+                            second_level_cnt = sum = 0;
+                        } else {
+                            second_level_cnt |= sum<<(63-9*(i&0x7));
+                        }
+                        sum += m_word_cnt[i];
+                    }
+                    if (i&0x7) { // if i%8 != 0
+                        second_level_cnt |= sum << (63-9*(i&0x7));
+                        rs.m_basic_block[j+1] = second_level_cnt;
+                    } else { // if i%8 == 0
+                        j += 2;
+                        rs.m_basic_block[j-1] = second_level_cnt;
+                        rs.m_basic_block[j]   = rs.m_basic_block[j-2] + sum;
+                        rs.m_basic_block[j+1] = 0;
+                    }
+                    return rs;
+                }
+        };
 };
 
 }// end namespace sds
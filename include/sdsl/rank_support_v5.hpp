@@ -122,24 +122,89 @@ class rank_support_v5 : public rank_support
             size_type result = *p
                                + ((*(p+1)>>(60-12*((idx&0x7FF)/(64*6))))&0x7FFULL)
                                + trait_type::word_rank(m_v->data(), idx);
-            idx -= (idx&0x3F);
-            uint8_t to_do = ((idx>>6)&0x1FULL)%6;
-            --idx;
-            while (to_do) {
-                result += trait_type::full_word_rank(m_v->data(), idx);
-                --to_do;
-                idx-=64;
-            }
-            return result;
+            size_type word = idx>>6;
+            size_type to_do = (word&0x1FULL)%6; // complete words in the 6-word block
+            return result + trait_type::full_words_rank(m_v->data(), word-to_do, to_do);
         }
 
         inline size_type operator()(size_type idx)const {
             return rank(idx);
         }
+
+        //! Answers rank queries for a batch of independent positions.
+        /*! \param idx Array of n query positions, each in \f$[0..size()]\f$.
+            \param n   Number of queries.
+            \param res Array of size n; res[k] is set to rank(idx[k]).
+            \par The counter and data words of upcoming queries are
+                 software-prefetched while earlier queries are computed, so
+                 the DRAM latencies of independent lookups overlap.
+         */
+        void rank_batch(const size_type* idx, size_type n, size_type* res) const {
+            const size_type lookahead = 8;
+            for (size_type k=0; k < n; ++k) {
+                if (k+lookahead < n) {
+                    size_type j = idx[k+lookahead];
+                    bits::prefetch(m_basic_block.data()
+                                   + ((j>>10)&0xFFFFFFFFFFFFFFFEULL));
+                    bits::prefetch(m_v->data() + (j>>6));
+                }
+                res[k] = rank(idx[k]);
+            }
+        }
+
         size_type size()const {
             return m_v->size();
         }
 
+        //! A cursor for rank queries at mostly increasing positions.
+        /*! The cursor caches the rank at the start of the word of the last
+         *  query. A query in the same word then costs one popcount and no
+         *  counter load at all; a query a few words further costs the
+         *  popcounts of the skipped words. Only on larger jumps -- and on
+         *  any backward jump -- the counter structure is consulted again,
+         *  and the supported vector is prefetched a few words ahead of the
+         *  scan position. Results equal rank() for every position, the
+         *  cursor only changes which loads are performed. The cursor holds
+         *  no owning state: it is invalidated by the same events which
+         *  invalidate the support itself.
+         */
+        class sequential_cursor
+        {
+            private:
+                const rank_support_v5* m_rs;
+                size_type m_word;      // word which the cached rank refers to
+                size_type m_word_rank; // rank at position 64*m_word
+            public:
+                explicit sequential_cursor(const rank_support_v5* rs=nullptr)
+                    : m_rs(rs), m_word(0), m_word_rank(0) {}
+
+                size_type rank(size_type idx) {
+                    assert(m_rs != nullptr and m_rs->m_v != nullptr);
+                    assert(idx <= m_rs->m_v->size());
+                    const uint64_t* data = m_rs->m_v->data();
+                    size_type w = idx>>6;
+                    if (w != m_word) {
+                        if (w > m_word and w - m_word <= 8) {
+                            m_word_rank += trait_type::full_words_rank(data, m_word, w-m_word);
+                        } else {
+                            m_word_rank = m_rs->rank(w<<6);
+                        }
+                        m_word = w;
+                        bits::prefetch(data + w + 8);
+                    }
+                    return m_word_rank + trait_type::word_rank(data, idx);
+                }
+
+                inline size_type operator()(size_type idx) {
+                    return rank(idx);
+                }
+        };
+
+        //! Returns a sequential_cursor for this support.
+        sequential_cursor cursor() const {
+            return sequential_cursor(this);
+        }
+
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const {
             size_type written_bytes = 0;
             structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
@@ -0,0 +1,310 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file rlz_text.hpp
+    \brief rlz_text.hpp contains a compressed text container with
+           block-wise random access for snippet extraction.
+    \author Simon Gog
+
+    Serving snippets from a CSA via extract() costs one LF/psi walk per
+    character, so deployments keep the raw text next to the index and
+    pay for the storage twice. rlz_text stores the text compressed but
+    block-addressable: a dictionary of uniformly sampled text chunks,
+    and every block encoded as an LZ77 parse against that dictionary
+    (relative Lempel-Ziv). Each block decodes independently, so an
+    extraction touches only the blocks covering the requested range —
+    the block directory is the sampled-access-point structure, and a
+    snippet costs one block decode instead of an LF walk per character.
+*/
+#ifndef INCLUDED_SDSL_RLZ_TEXT
+#define INCLUDED_SDSL_RLZ_TEXT
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "int_vector.hpp"
+#include "iterators.hpp"
+#include "util.hpp"
+
+namespace sdsl
+{
+
+//! A compressed text container with block-wise random access.
+/*! \tparam t_block_size Characters per independently decodable block.
+ *  \tparam t_dict_frac  Every t_dict_frac-th block is sampled into the
+ *                       dictionary, so the dictionary is a 1/t_dict_frac
+ *                       fraction of the text.
+ *
+ *  On repetitive inputs (versioned documents, genome collections) the
+ *  blocks parse into few factors and the container approaches the
+ *  dictionary size; on incompressible inputs it degrades gracefully to
+ *  literal runs, i.e. the raw text plus a small per-block overhead.
+ *  operator[] and the random access iterators make it a drop-in text
+ *  source wherever a byte container is read sequentially or by
+ *  position, e.g. to feed construct().
+ */
+template<uint32_t t_block_size = 4096, uint32_t t_dict_frac = 16>
+class rlz_text
+{
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef uint8_t               value_type;
+        typedef random_access_const_iterator<rlz_text> const_iterator;
+        typedef const_iterator        iterator;
+        typedef ptrdiff_t             difference_type;
+
+    private:
+        static const uint32_t t_min_match = 8; // shortest encoded match
+
+        size_type     m_size = 0;
+        int_vector<8> m_dict;      // sampled dictionary text
+        int_vector<8> m_factors;   // concatenated block parses
+        int_vector<>  m_block_ptr; // byte offset of each block's parse
+
+        static void append_varint(std::vector<uint8_t>& out, size_type v)
+        {
+            while (v > 0x7F) {
+                out.push_back((uint8_t)(v & 0x7F) | 0x80);
+                v >>= 7;
+            }
+            out.push_back((uint8_t)v);
+        }
+
+        size_type read_varint(size_type& pos) const
+        {
+            size_type v = 0;
+            uint8_t shift = 0;
+            while (true) {
+                uint8_t byte = m_factors[pos++];
+                v |= (size_type)(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return v;
+                }
+                shift += 7;
+            }
+        }
+
+        //! Decodes block b into buf; returns the number of characters.
+        size_type decode_block(size_type b, uint8_t* buf) const
+        {
+            size_type len = std::min<size_type>(t_block_size,
+                                                m_size - b*(size_type)t_block_size);
+            size_type pos = m_block_ptr[b];
+            size_type out = 0;
+            while (out < len) {
+                size_type v = read_varint(pos);
+                if (v & 1) { // match (length, dictionary position)
+                    size_type mlen = v >> 1;
+                    size_type dpos = read_varint(pos);
+                    for (size_type k=0; k < mlen; ++k) {
+                        buf[out++] = m_dict[dpos+k];
+                    }
+                } else {     // literal run
+                    size_type run = v >> 1;
+                    for (size_type k=0; k < run; ++k) {
+                        buf[out++] = m_factors[pos++];
+                    }
+                }
+            }
+            return len;
+        }
+
+    public:
+        //! Default constructor
+        rlz_text() { }
+        rlz_text(const rlz_text&) = default;
+        rlz_text(rlz_text&&) = default;
+        rlz_text& operator=(const rlz_text&) = default;
+        rlz_text& operator=(rlz_text&&) = default;
+
+        //! Constructor compressing the byte text [begin, end).
+        template<class t_it>
+        rlz_text(t_it begin, t_it end)
+        {
+            m_size = std::distance(begin, end);
+            size_type nb = (m_size + t_block_size - 1)/t_block_size;
+            // dictionary: every t_dict_frac-th block
+            std::vector<uint8_t> dict;
+            for (size_type b=0; b < nb; b += t_dict_frac) {
+                size_type s = b*(size_type)t_block_size;
+                size_type e = std::min<size_type>(s+t_block_size, m_size);
+                for (size_type i=s; i < e; ++i) {
+                    dict.push_back((uint8_t)*(begin+i));
+                }
+            }
+            // index the dictionary's t_min_match-grams in a hash table
+            size_type table_size = 1;
+            while (table_size < 2*dict.size()+2) {
+                table_size <<= 1;
+            }
+            std::vector<size_type> table(table_size, (size_type)-1);
+            auto gram_hash = [&dict](size_type p) {
+                uint64_t h = 14695981039346656037ULL;
+                for (uint32_t k=0; k < t_min_match; ++k) {
+                    h = (h ^ dict[p+k]) * 1099511628211ULL;
+                }
+                return h;
+            };
+            for (size_type p=0; p+t_min_match <= dict.size(); ++p) {
+                table[gram_hash(p) & (table_size-1)] = p;
+            }
+            // greedy parse of each block against the dictionary
+            std::vector<uint8_t> factors;
+            m_block_ptr = int_vector<>(nb+1, 0, 64);
+            std::vector<uint8_t> lit;
+            auto flush_literals = [&]() {
+                if (!lit.empty()) {
+                    append_varint(factors, lit.size() << 1);
+                    factors.insert(factors.end(), lit.begin(), lit.end());
+                    lit.clear();
+                }
+            };
+            for (size_type b=0; b < nb; ++b) {
+                m_block_ptr[b] = factors.size();
+                size_type s = b*(size_type)t_block_size;
+                size_type e = std::min<size_type>(s+t_block_size, m_size);
+                size_type i = s;
+                while (i < e) {
+                    size_type mlen = 0, dpos = 0;
+                    if (i + t_min_match <= e) {
+                        uint64_t h = 14695981039346656037ULL;
+                        for (uint32_t k=0; k < t_min_match; ++k) {
+                            h = (h ^ (uint8_t)*(begin+i+k)) * 1099511628211ULL;
+                        }
+                        size_type cand = table[h & (table_size-1)];
+                        if (cand != (size_type)-1) {
+                            size_type l = 0;
+                            while (i+l < e and cand+l < dict.size()
+                                   and dict[cand+l] == (uint8_t)*(begin+i+l)) {
+                                ++l;
+                            }
+                            if (l >= t_min_match) {
+                                mlen = l;
+                                dpos = cand;
+                            }
+                        }
+                    }
+                    if (mlen) {
+                        flush_literals();
+                        append_varint(factors, (mlen << 1) | 1);
+                        append_varint(factors, dpos);
+                        i += mlen;
+                    } else {
+                        lit.push_back((uint8_t)*(begin+i));
+                        ++i;
+                    }
+                }
+                flush_literals();
+            }
+            m_block_ptr[nb] = factors.size();
+            util::bit_compress(m_block_ptr);
+            m_dict = int_vector<8>(dict.size());
+            std::copy(dict.begin(), dict.end(), m_dict.begin());
+            m_factors = int_vector<8>(factors.size());
+            std::copy(factors.begin(), factors.end(), m_factors.begin());
+        }
+
+        //! Length of the text.
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        //! Random access to the i-th character.
+        /*! Decodes the block containing i; use extract() for ranges.
+         */
+        value_type operator[](size_type i) const
+        {
+            uint8_t buf[t_block_size];
+            decode_block(i/t_block_size, buf);
+            return buf[i % t_block_size];
+        }
+
+        //! Extracts the substring [i, i+l).
+        /*! \par Time complexity
+         *       \f$ \Order{ l + t_{block} } \f$ — only the blocks
+         *       covering the range are decoded.
+         */
+        std::string extract(size_type i, size_type l) const
+        {
+            std::string res;
+            if (i >= m_size) {
+                return res;
+            }
+            l = std::min(l, m_size-i); // clamp to the text end
+            res.reserve(l);
+            uint8_t buf[t_block_size];
+            while (l > 0) {
+                size_type b = i/t_block_size;
+                size_type off = i - b*(size_type)t_block_size;
+                size_type len = decode_block(b, buf);
+                size_type take = std::min<size_type>(l, len-off);
+                res.append((const char*)buf+off, take);
+                i += take;
+                l -= take;
+            }
+            return res;
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, size());
+        }
+
+        void swap(rlz_text& t)
+        {
+            if (this != &t) {
+                std::swap(m_size, t.m_size);
+                m_dict.swap(t.m_dict);
+                m_factors.swap(t.m_factors);
+                m_block_ptr.swap(t.m_block_ptr);
+            }
+        }
+
+        //! Serializes the container to a stream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += m_dict.serialize(out, child, "dict");
+            written_bytes += m_factors.serialize(out, child, "factors");
+            written_bytes += m_block_ptr.serialize(out, child, "block_ptr");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the container from a stream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            m_dict.load(in);
+            m_factors.load(in);
+            m_block_ptr.load(in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -27,6 +27,8 @@
 #include "bp_support_sada.hpp"
 #include "suffix_tree_helper.hpp"
 #include "util.hpp"
+#include <unordered_map>
+#include <vector>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -161,6 +163,101 @@ class rmq_succinct_sct
             return m_sct_bp.size()/2;
         }
 
+        //! An engine for cascades of nested range min/max queries.
+        /*! Document-listing style algorithms (e.g. Muthukrishnan's
+         *  algorithm over the document array) recurse on the ranges
+         *  \f$[\ell..m-1]\f$ and \f$[m+1..r]\f$ after each reported
+         *  minimum m, so every child query inherits one endpoint of its
+         *  parent. The engine memoizes the BPS positions of the
+         *  endpoints seen so far together with their matching closing
+         *  parentheses, so an inherited endpoint costs a hash lookup
+         *  instead of a select and a find_close on the BPS-SCT. The
+         *  results are identical to those of operator() of the
+         *  underlying structure.
+         */
+        class cascade_engine
+        {
+            private:
+                const rmq_succinct_sct* m_rmq = nullptr;
+                // v -> select(v+1) on the BPS-SCT
+                std::unordered_map<size_type, size_type> m_sel;
+                // position of an opening parenthesis -> matching closing one
+                std::unordered_map<size_type, size_type> m_fc;
+
+                size_type sel(size_type v) {
+                    auto it = m_sel.find(v);
+                    if (it != m_sel.end())
+                        return it->second;
+                    size_type s = m_rmq->m_sct_bp_support.select(v+1);
+                    m_sel.emplace(v, s);
+                    return s;
+                }
+
+                size_type fc(size_type i) {
+                    auto it = m_fc.find(i);
+                    if (it != m_fc.end())
+                        return it->second;
+                    size_type c = m_rmq->m_sct_bp_support.find_close(i);
+                    m_fc.emplace(i, c);
+                    return c;
+                }
+
+            public:
+                cascade_engine() = default;
+                cascade_engine(const rmq_succinct_sct& rmq) : m_rmq(&rmq) {}
+
+                //! Discard the memoized traversal state, e.g. between
+                //! two unrelated cascades.
+                void reset() {
+                    m_sel.clear();
+                    m_fc.clear();
+                }
+
+                //! Range minimum/maximum query; same result as
+                //! operator() of the underlying structure.
+                size_type operator()(const size_type l, const size_type r) {
+                    assert(l <= r); assert(r < m_rmq->size());
+                    if (l==r)
+                        return l;
+                    size_type i    = sel(l);
+                    size_type j    = sel(r);
+                    size_type fc_i = fc(i);
+                    if (j < fc_i) { // i < j < find_close(j) < find_close(i)
+                        return l;
+                    } else { // if i < find_close(i) < j < find_close(j)
+                        size_type ec = m_rmq->m_sct_bp_support.rr_enclose(i,j);
+                        if (ec == m_rmq->m_sct_bp_support.size()) {
+                            return r;
+                        } else {
+                            size_type m = m_rmq->m_sct_bp_support.rank(ec)-1;
+                            // ec is the opening parenthesis of m
+                            m_sel.emplace(m, ec);
+                            return m;
+                        }
+                    }
+                }
+
+                //! Process a work queue of ranges.
+                /*! \param ranges Queries \f$(\ell_i, r_i)\f$; nested
+                 *      queries profit from the endpoints of the earlier
+                 *      ones.
+                 *  \return res[i] is the answer to ranges[i].
+                 */
+                std::vector<size_type>
+                batch(const std::vector<std::pair<size_type, size_type>>& ranges) {
+                    std::vector<size_type> res;
+                    res.reserve(ranges.size());
+                    for (const auto& q : ranges)
+                        res.push_back((*this)(q.first, q.second));
+                    return res;
+                }
+        };
+
+        //! Get a cascade_engine for this structure.
+        cascade_engine cascade() const {
+            return cascade_engine(*this);
+        }
+
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const {
             structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
             size_type written_bytes = 0;
@@ -44,6 +44,7 @@ struct min_max_trait<RandomAccessContainer, false> {
 };
 
 #include "rmq_support_sparse_table.hpp"
+#include "rmq_support_hybrid.hpp"
 #include "rmq_succinct_sct.hpp"
 #include "rmq_succinct_sada.hpp"
 
@@ -0,0 +1,269 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2009 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file rmq_support_hybrid.hpp
+    \brief rmq_support_hybrid.hpp contains the class rmq_support_hybrid.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_RMQ_SUPPORT_HYBRID
+#define INCLUDED_SDSL_RMQ_SUPPORT_HYBRID
+
+#include "rmq_support.hpp"
+#include "int_vector.hpp"
+#include <ostream>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+template<class t_rac = int_vector<>, bool t_min=true, uint32_t t_bs=64>
+class rmq_support_hybrid;
+
+template<class t_rac = int_vector<>, uint32_t t_bs=64>
+using range_maximum_support_hybrid = rmq_support_hybrid<t_rac, false, t_bs>;
+
+//! A class to support range minimum or range maximum queries on a random access container.
+/*!
+ * The structure is the standard blocked hybrid between
+ * rmq_support_sparse_table and the succinct solutions: the container is
+ * cut into blocks of t_bs elements, the position of the minimum of each
+ * block is stored, and a sparse table is built over the block minima.
+ * A query scans the two partial blocks at its borders and answers the
+ * covered blocks in between from the sparse table.
+ *
+ * \tparam t_rac Type of random access container for which the structure should be build.
+ * \tparam t_min Specifies whether the data structure should answer range min/max queries (mimumum=true)
+ * \tparam t_bs  Block size; trades space for in-block scan time.
+ *
+ * \par Time complexity
+ *        \f$ \Order{t\_bs} \f$ for the range minimum/maximum queries.
+ * \par Space complexity:
+ *      \f$ \frac{n}{t\_bs}(\log^2 \frac{n}{t\_bs} + \log t\_bs) \f$ bits
+ *      ( \f$ n=size() \f$ ), e.g. about \f$ 4n \f$ bits for
+ *      \f$ n=10^{10} \f$ and the default block size, instead of the
+ *      \f$ \Order{n\log^2 n} \f$ bits of the plain sparse table.
+ */
+template<class t_rac, bool t_min, uint32_t t_bs>
+class rmq_support_hybrid
+{
+        static_assert(t_bs > 1, "rmq_support_hybrid: block size must be > 1");
+
+        const t_rac*              m_v;         // pointer to the supported random access container
+        bit_vector::size_type     m_k;         // number of sparse table levels
+        int_vector<>              m_block_min; // offset of the min/max within each block
+        std::vector<int_vector<>> m_table;     // sparse table over the block minima
+        typedef min_max_trait<t_rac, t_min> mm_trait;
+
+        void copy(const rmq_support_hybrid& rm)
+        {
+            m_v         = rm.m_v;
+            m_k         = rm.m_k;
+            m_block_min = rm.m_block_min;
+            m_table.resize(m_k);
+            std::copy(rm.m_table.begin(), rm.m_table.end(),
+                      m_table.begin());
+        }
+
+    public:
+        typedef typename t_rac::size_type size_type;
+        typedef typename t_rac::size_type value_type;
+
+    private:
+
+        // position of the block minimum/maximum of block b
+        size_type block_pos(size_type b)const
+        {
+            return b*t_bs + m_block_min[b];
+        }
+
+        // block with the minimal/maximal value in the block range [b1..b2]
+        size_type block_query(size_type b1, size_type b2)const
+        {
+            if (b1 == b2)
+                return b1;
+            if (b1+1 == b2)
+                return mm_trait::compare((*m_v)[block_pos(b1)],
+                                         (*m_v)[block_pos(b2)]) ? b1 : b2;
+            size_type k = bits::hi(b2-b1);
+            const size_type bb = b2-(1ULL<<k)+1;
+            size_type c1 = b1+m_table[k-1][b1];
+            size_type c2 = bb+m_table[k-1][bb];
+            return mm_trait::compare((*m_v)[block_pos(c1)],
+                                     (*m_v)[block_pos(c2)]) ? c1 : c2;
+        }
+
+        // position of the minimal/maximal value in [l..r]; scan of <= t_bs elements
+        size_type scan(size_type l, size_type r)const
+        {
+            size_type pos = l;
+            for (size_type i=l+1; i <= r; ++i) {
+                if (mm_trait::strict_compare((*m_v)[i], (*m_v)[pos]))
+                    pos = i;
+            }
+            return pos;
+        }
+
+    public:
+
+        rmq_support_hybrid(const t_rac* v=nullptr):m_v(v), m_k(0)
+        {
+            if (m_v == nullptr)
+                return;
+            const size_type n = m_v->size();
+            if (n < 2)  // for n<2 the queries could be answerd without any table
+                return;
+            const size_type nb = (n+t_bs-1)/t_bs; // number of blocks
+            m_block_min = int_vector<>(nb, 0, bits::hi(t_bs-1)+1);
+            for (size_type b=0; b < nb; ++b) {
+                size_type end = std::min(n, (b+1)*(size_type)t_bs);
+                m_block_min[b] = scan(b*t_bs, end-1) - b*t_bs;
+            }
+            size_type k=0;
+            while (2*(1ULL<<k) < nb) ++k;
+            m_table.resize(k);
+            m_k = k;
+            for (size_type i=0; i<k; ++i) {
+                m_table[i] = int_vector<>(nb-(1ULL<<(i+1))+1, 0, i+1);
+            }
+            for (size_type i=0; k > 0 and i<nb-1; ++i) {
+                if (!mm_trait::compare((*m_v)[block_pos(i)], (*m_v)[block_pos(i+1)]))
+                    m_table[0][i] = 1;
+            }
+            for (size_type i=1; i<k; ++i) {
+                for (size_type j=0; j<m_table[i].size(); ++j) {
+                    size_type c1 = j+m_table[i-1][j];
+                    size_type c2 = j+(1ULL<<i)+m_table[i-1][j+(1ULL<<i)];
+                    m_table[i][j] = mm_trait::compare((*m_v)[block_pos(c1)],
+                                                      (*m_v)[block_pos(c2)])
+                                    ? c1-j : c2-j;
+                }
+            }
+        }
+
+        //! Copy constructor
+        rmq_support_hybrid(const rmq_support_hybrid& rm)
+        {
+            if (this != &rm) { // if v is not the same object
+                copy(rm);
+            }
+        }
+
+        //! Move constructor
+        rmq_support_hybrid(rmq_support_hybrid&& rm)
+        {
+            *this = std::move(rm);
+        }
+
+        rmq_support_hybrid& operator=(const rmq_support_hybrid& rm)
+        {
+            if (this != &rm) {
+                copy(rm);
+            }
+            return *this;
+        }
+
+        rmq_support_hybrid& operator=(rmq_support_hybrid&& rm)
+        {
+            if (this != &rm) {
+                m_v         = rm.m_v;
+                m_k         = rm.m_k;
+                m_block_min = std::move(rm.m_block_min);
+                m_table     = std::move(rm.m_table);
+            }
+            return *this;
+        }
+
+        void swap(rmq_support_hybrid& rm)
+        {
+            std::swap(m_k, rm.m_k);
+            m_block_min.swap(rm.m_block_min);
+            m_table.swap(rm.m_table);
+        }
+
+        void set_vector(const t_rac* v)
+        {
+            m_v = v;
+        }
+
+        //! Range minimum/maximum query for the supported random access container v.
+        /*!
+         * \param l Leftmost position of the interval \f$[\ell..r]\f$.
+         * \param r Rightmost position of the interval \f$[\ell..r]\f$.
+         * \return The minimal index i with \f$\ell \leq i \leq r\f$ for which \f$ v[i] \f$ is minimal/maximal.
+         * \pre
+         *   - r < size()
+         *   - \f$ \ell \leq r \f$
+         * \par Time complexity
+         *      \f$ \Order{t\_bs} \f$
+         */
+        size_type operator()(const size_type l, const size_type r)const
+        {
+            assert(l <= r); assert(r < size());
+            const size_type bl = l/t_bs;
+            const size_type br = r/t_bs;
+            if (bl == br)   // in-block query
+                return scan(l, r);
+            // minimum/maximum of the partial block at the left border
+            size_type pos = scan(l, (bl+1)*(size_type)t_bs-1);
+            if (bl+1 < br) { // blocks fully covered by [l..r]
+                size_type mid = block_pos(block_query(bl+1, br-1));
+                if (mm_trait::strict_compare((*m_v)[mid], (*m_v)[pos]))
+                    pos = mid;
+            }
+            // partial block at the right border
+            size_type rp = scan(br*(size_type)t_bs, r);
+            if (mm_trait::strict_compare((*m_v)[rp], (*m_v)[pos]))
+                pos = rp;
+            return pos;
+        }
+
+        size_type size()const
+        {
+            if (m_v == nullptr)
+                return 0;
+            else
+                return m_v->size();
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            size_type written_bytes = 0;
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            written_bytes += write_member(m_k, out);
+            written_bytes += m_block_min.serialize(out);
+            if (m_k > 0) {
+                for (size_type i=0; i < m_k; ++i)
+                    written_bytes += m_table[i].serialize(out);
+            }
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in, const t_rac* v)
+        {
+            set_vector(v);
+            read_member(m_k, in);
+            m_block_min.load(in);
+            if (m_k > 0) {
+                m_table.resize(m_k);
+                for (size_type i=0; i < m_k; ++i)
+                    m_table[i].load(in);
+            }
+        }
+};
+
+}// end namespace sdsl
+#endif
@@ -88,7 +88,7 @@ class rmq_support_sparse_table
             for (size_type i=0; i<k; ++i) {
                 m_table[i] = int_vector<>(n-(1ULL<<(i+1))+1, 0, i+1);
             }
-            for (size_type i=0; i<n-1; ++i) {
+            for (size_type i=0; k > 0 and i<n-1; ++i) {
                 if (!mm_trait::compare((*m_v)[i], (*m_v)[i+1]))
                     m_table[0][i] = 1;
             }
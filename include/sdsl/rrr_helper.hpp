@@ -76,9 +76,12 @@ struct binomial_coefficients_trait {
 };
 
 //! Specialization of binomial_coefficients_trait for 128-bit integers.
+/*! The block numbers only live in registers and the binomial table, so the
+ *  compute-only uint128_fast_t can be used here.
+ */
 template<>
 struct binomial_coefficients_trait<7> {
-    typedef uint128_t number_type;
+    typedef uint128_fast_t number_type;
     static inline uint16_t hi(number_type x) {
         if ((x >> 64)) {
             return bits::hi(x >> 64) + 64;
@@ -410,6 +413,46 @@ struct rrr_helper {
     }
 
 
+    //! Decode the whole block encoded by the pair (k, nr) into an array of 64-bit words.
+    /*! \param k     Number of set bits in the block.
+        \param nr    Number of the block.
+        \param block Array of \f$ \lceil n/64 \rceil \f$ words which is
+                     overwritten with the bit pattern of the block; bit i of
+                     the block is stored at bit \f$ i \bmod 64 \f$ of word
+                     \f$ \lfloor i/64 \rfloor \f$.
+        \par In contrast to repeated decode_bit/decode_popcount calls the
+             block is unranked in one pass, so the dependent compare chain is
+             walked only once per block.
+     */
+    static inline void decode_block(uint16_t k, number_type nr, uint64_t* block) {
+        for (uint16_t w=0; w < (n+63)/64; ++w) {
+            block[w] = 0;
+        }
+        if (k == 0) {
+            return;
+        }
+        if (k == n) {
+            for (uint16_t i=0; i < n; ++i) {
+                block[i>>6] |= 1ULL << (i&0x3F);
+            }
+            return;
+        }
+        uint16_t nn = std::min(n, binomial::data.ubound_n[k][trait::hi(nr)]);
+        assert(nn <= n);
+        while (k > 1) {
+            if (nr >= binomial::data.table_tr[k][nn-1]) {
+                nr -= binomial::data.table_tr[k][nn-1];
+                --k;
+                uint16_t i = n-nn;
+                block[i>>6] |= 1ULL << (i&0x3F);
+                nn = std::min((int)nn, binomial::data.ubound_n[k][trait::hi(nr)] + 1);
+            }
+            --nn;
+        }
+        uint16_t i = n-static_cast<uint16_t>(nr)-1;
+        block[i>>6] |= 1ULL << (i&0x3F);
+    }
+
     //! Decode the first off bits bits of the block encoded by the pair (k, nr) and return the set bits.
     static inline uint16_t decode_popcount(uint16_t k, number_type nr, uint16_t off) {
         assert(k != 0 && k != n); // this must have already been checked in the caller
@@ -102,6 +102,39 @@ class rrr_vector
         bit_vector   m_btnr;   // Compressed block type numbers.
         int_vector<> m_btnrp;  // Sample pointers into m_btnr.
         int_vector<> m_rank;   // Sample rank values.
+#ifdef RRR_BLOCK_CACHE
+        // one-entry cache holding the fully decoded bits of the last
+        // decoded block; pays off for larger block sizes (t_bs=63/127)
+        // where on-the-fly unranking is a long dependent chain
+        mutable size_type m_dec_idx = (size_type)-1;
+        mutable uint64_t  m_dec_block[(t_bs+63)/64];
+
+        //! Returns the decoded bit pattern of block bt_idx.
+        /*! \param bt_idx Index of the block.
+            \param bt     Type (number of set bits) of the block.
+            \param btnrp  Position of the block type number in m_btnr.
+         */
+        const uint64_t* decoded_block(size_type bt_idx, uint16_t bt, size_type btnrp) const
+        {
+            if (m_dec_idx != bt_idx) {
+                uint16_t btnrlen = rrr_helper_type::space_for_bt(bt);
+                number_type btnr = rrr_helper_type::decode_btnr(m_btnr, btnrp, btnrlen);
+                if (bt <= t_bs/2) {
+                    rrr_helper_type::decode_block(bt, btnr, m_dec_block);
+                } else { // blocks with more than n/2 1-bits are stored inverted
+                    rrr_helper_type::decode_block(t_bs - bt, btnr, m_dec_block);
+                    for (uint16_t w=0; w < (t_bs+63)/64; ++w) {
+                        m_dec_block[w] = ~m_dec_block[w];
+                    }
+                    if (t_bs % 64) {
+                        m_dec_block[t_bs/64] &= bits::lo_set[t_bs%64];
+                    }
+                }
+                m_dec_idx = bt_idx;
+            }
+            return m_dec_block;
+        }
+#endif
 
     public:
 
@@ -202,6 +235,9 @@ class rrr_vector
                 m_btnr.swap(rrr.m_btnr);
                 m_btnrp.swap(rrr.m_btnrp);
                 m_rank.swap(rrr.m_rank);
+#ifdef RRR_BLOCK_CACHE
+                m_dec_idx = rrr.m_dec_idx = (size_type)-1;
+#endif
             }
         }
 
@@ -223,11 +259,17 @@ class rrr_vector
             for (size_type j = sample_pos*t_k; j < bt_idx; ++j) {
                 btnrp += rrr_helper_type::space_for_bt(m_bt[j]);
             }
+#ifdef RRR_BLOCK_CACHE
+            const uint64_t* block = decoded_block(bt_idx, bt, btnrp);
+            uint16_t off = i % t_bs;
+            value_type bit = (block[off>>6] >> (off&0x3F)) & 1;
+#else
             uint16_t btnrlen = rrr_helper_type::space_for_bt(bt);
             number_type btnr = rrr_helper_type::decode_btnr(m_btnr, btnrp, btnrlen);
             // blocks with more than n/2 1-bits are inverted
             value_type bit = (bt <= t_bs/2) ? rrr_helper_type::decode_bit(bt, btnr, i % t_bs)
                                             : !rrr_helper_type::decode_bit(t_bs - bt, btnr, i % t_bs);
+#endif
             assert(bit == inverse_select(i).first);
             return bit;
         }
@@ -391,6 +433,9 @@ class rrr_vector
             m_btnr.load(in);
             m_btnrp.load(in);
             m_rank.load(in);
+#ifdef RRR_BLOCK_CACHE
+            m_dec_idx = (size_type)-1; // drop cached bits of the old content
+#endif
         }
 
         iterator begin() const
@@ -447,6 +492,38 @@ class rank_support_rrr
 
     private:
         const bit_vector_type* m_v; //!< Pointer to the rank supported rrr_vector
+        // second-level samples: for every t_sk-th block the rank and the
+        // btnr position relative to the enclosing t_k sample, packed into
+        // one entry so a query touches one extra cache line at most; the
+        // layer shortens the block header scan from t_k-1 to t_sk-1 steps
+        int_vector<> m_sub;
+        // t_k must be a multiple of t_sk so every t_k group starts on the
+        // sub-sample grid; otherwise the layer is disabled
+        enum { t_sk = (t_k >= 8 and t_k % 4 == 0) ? t_k/4 : 0 };
+
+        //! Build the second-level sample layer by one scan over the headers.
+        void build_sub_samples()
+        {
+            m_sub = int_vector<>();
+            if (0 == t_sk or nullptr == m_v or 0 == m_v->m_bt.size()) {
+                return;
+            }
+            size_type blocks = m_v->m_bt.size();
+            uint8_t w = bits::hi((size_type)t_k*t_bs)+1; // fits both deltas
+            m_sub = int_vector<>(blocks/t_sk+1, 0, 2*w);
+            size_type rank_d = 0, btnrp_d = 0;
+            for (size_type j=0; j < blocks; ++j) {
+                if (0 == j % t_k) {
+                    rank_d = btnrp_d = 0;
+                }
+                if (0 == j % t_sk) {
+                    m_sub[j/t_sk] = (btnrp_d << w) | rank_d;
+                }
+                uint16_t bt = m_v->m_bt[j];
+                rank_d  += bt;
+                btnrp_d += rrr_helper_type::space_for_bt(bt);
+            }
+        }
 
     public:
         //! Standard constructor
@@ -455,8 +532,14 @@ class rank_support_rrr
         explicit rank_support_rrr(const bit_vector_type* v=nullptr)
         {
             set_vector(v);
+            build_sub_samples();
         }
 
+        rank_support_rrr(const rank_support_rrr&) = default;
+        rank_support_rrr(rank_support_rrr&&) = default;
+        rank_support_rrr& operator=(const rank_support_rrr&) = default;
+        rank_support_rrr& operator=(rank_support_rrr&&) = default;
+
         //! Answers rank queries
         /*! \param i Argument for the length of the prefix v[0..i-1], with \f$0\leq i \leq size()\f$.
            \returns Number of 1-bits in the prefix [0..i-1] of the original bit_vector.
@@ -483,7 +566,16 @@ class rank_support_rrr
             }
 #endif
             size_type btnrp = m_v->m_btnrp[ sample_pos ];
-            for (size_type j = sample_pos*t_k; j < bt_idx; ++j) {
+            size_type j = sample_pos*t_k;
+            if (t_sk != 0 and m_sub.size() > 0) { // jump to the nearest sub-sample
+                size_type sub_pos = bt_idx/t_sk;
+                uint64_t  entry   = m_sub[sub_pos];
+                uint8_t   w       = m_sub.width()>>1;
+                rank  += entry & bits::lo_set[w];
+                btnrp += entry >> w;
+                j = sub_pos*t_sk;
+            }
+            for (; j < bt_idx; ++j) {
                 rank  += m_v->m_bt[j];
                 btnrp += rrr_helper_type::space_for_bt(m_v->m_bt[j]);
             }
@@ -493,11 +585,21 @@ class rank_support_rrr
             } else if (bt == t_bs) { // very effective optimization
                 return  rank_support_rrr_trait<t_b>::adjust_rank(rank + off, i);
             }
+#ifdef RRR_BLOCK_CACHE
+            const uint64_t* block = m_v->decoded_block(bt_idx, bt, btnrp);
+            uint16_t popcnt = 0, rem = off, w = 0;
+            while (rem >= 64) {
+                popcnt += bits::cnt(block[w++]);
+                rem -= 64;
+            }
+            popcnt += bits::cnt(block[w] & bits::lo_set[rem]);
+#else
             uint16_t btnrlen = rrr_helper_type::space_for_bt(bt);
             number_type btnr = rrr_helper_type::decode_btnr(m_v->m_btnr, btnrp, btnrlen);
             // blocks with more than n/2 1-bits are inverted
             uint16_t popcnt = (bt <= t_bs/2) ? rrr_helper_type::decode_popcount(bt, btnr, off)
                                              : off - rrr_helper_type::decode_popcount(t_bs - bt, btnr, off);
+#endif
             assert(i >= size() || rank + popcnt == m_v->inverse_select(i).second);
             return rank_support_rrr_trait<t_b>::adjust_rank(rank + popcnt, i);
         }
@@ -520,12 +622,21 @@ class rank_support_rrr
             m_v = v;
         }
 
-        void swap(rank_support_rrr&) { }
+        void swap(rank_support_rrr& rs)
+        {
+            if (this != &rs) {
+                m_sub.swap(rs.m_sub);
+            }
+        }
 
         //! Load the data structure from a stream and set the supported vector.
+        /*! Nothing is read; the second-level samples are rebuilt from the
+         *  supported vector, so the serialized format stays empty.
+         */
         void load(std::istream&, const bit_vector_type* v=nullptr)
         {
             set_vector(v);
+            build_sub_samples();
         }
 
         //! Serializes the data structure into a stream.
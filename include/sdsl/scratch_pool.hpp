@@ -0,0 +1,153 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file scratch_pool.hpp
+    \brief scratch_pool.hpp contains a per-thread arena for the
+           temporary containers of query algorithms.
+    \author Simon Gog
+
+    Query algorithms allocate small temporaries per call (pattern
+    cursors, range stacks, candidate lists). Under heavy multi-threaded
+    query load the shared heap lock behind those allocations becomes a
+    measurable fraction of the query time. scratch_arena is a
+    thread_local bump allocator: allocations advance an offset in a
+    thread-owned block, deallocation is a counter decrement, and when
+    the last scratch object of a query dies the offset rewinds and the
+    block is kept at its high-water size — so in steady state a query
+    touches the heap zero times. Requests that do not fit the block fall
+    through to the heap, and the block grows to the observed peak at the
+    next rewind.
+
+    Scratch memory is strictly query-local: a scratch-backed container
+    must be destroyed on the thread that created it, before the
+    enclosing query returns. Never store one in a member or return it.
+*/
+#ifndef INCLUDED_SDSL_SCRATCH_POOL
+#define INCLUDED_SDSL_SCRATCH_POOL
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Thread-local bump arena with high-water reuse.
+class scratch_arena
+{
+    public:
+        //! The arena of the calling thread.
+        static scratch_arena& local()
+        {
+            static thread_local scratch_arena arena;
+            return arena;
+        }
+
+        void* allocate(std::size_t bytes)
+        {
+            bytes = (bytes + 15) & ~static_cast<std::size_t>(15);
+            ++m_live;
+            if (m_offset + bytes <= m_cap) {
+                void* p = m_data.get() + m_offset;
+                m_offset += bytes;
+                if (m_offset > m_peak)
+                    m_peak = m_offset;
+                return p;
+            }
+            // does not fit; served by the heap and counted, so the
+            // block grows to the full working set at the next rewind
+            m_peak += bytes;
+            return ::operator new(bytes);
+        }
+
+        void deallocate(void* p)
+        {
+            if (!owns(p)) {
+                ::operator delete(p);
+            }
+            if (0 == --m_live) { // last scratch object gone: rewind
+                if (m_peak > m_cap) {
+                    std::size_t cap = 64;
+                    while (cap < m_peak)
+                        cap <<= 1;
+                    m_data.reset(new char[cap]);
+                    m_cap = cap;
+                }
+                m_offset = 0;
+                m_peak   = 0;
+            }
+        }
+
+        //! Capacity of the thread's block; the high-water mark so far.
+        std::size_t capacity() const { return m_cap; }
+
+    private:
+        scratch_arena() = default;
+        scratch_arena(const scratch_arena&) = delete;
+        scratch_arena& operator=(const scratch_arena&) = delete;
+
+        bool owns(const void* p) const
+        {
+            return p >= m_data.get() and p < m_data.get() + m_cap;
+        }
+
+        std::unique_ptr<char[]> m_data;
+        std::size_t m_cap    = 0; // size of m_data
+        std::size_t m_offset = 0; // bump pointer
+        std::size_t m_live   = 0; // outstanding allocations
+        std::size_t m_peak   = 0; // bytes requested since the last rewind
+};
+
+//! Allocator drawing from the scratch_arena of the current thread.
+/*! Containers using it must stay on their creating thread and die
+ *  before the query returns; see the file comment.
+ */
+template<class T>
+struct scratch_allocator {
+    typedef T value_type;
+
+    scratch_allocator() = default;
+    template<class U>
+    scratch_allocator(const scratch_allocator<U>&) { }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(scratch_arena::local().allocate(n*sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t)
+    {
+        scratch_arena::local().deallocate(p);
+    }
+};
+
+template<class T, class U>
+bool operator==(const scratch_allocator<T>&, const scratch_allocator<U>&)
+{
+    return true;
+}
+template<class T, class U>
+bool operator!=(const scratch_allocator<T>&, const scratch_allocator<U>&)
+{
+    return false;
+}
+
+//! A std::vector living in the scratch arena of the current thread.
+template<class T>
+using scratch_vector = std::vector<T, scratch_allocator<T>>;
+
+} // end namespace sdsl
+
+#endif // end file
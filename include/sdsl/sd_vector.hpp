@@ -24,6 +24,8 @@
 #define INCLUDED_SDSL_SD_VECTOR
 
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "int_vector.hpp"
 #include "select_support_mcl.hpp"
@@ -48,6 +50,12 @@ template<uint8_t t_b          = 1,
          class t_select_0     = typename t_hi_bit_vector::select_0_type>
 class select_support_sd;  // in sd_vector
 
+// forward declaration needed for friend declaration
+template<class t_hi_bit_vector= bit_vector,
+         class t_select_1     = typename t_hi_bit_vector::select_1_type,
+         class t_select_0     = typename t_hi_bit_vector::select_0_type>
+class pred_support_sd;  // in sd_vector
+
 // forward declaration needed for friend declaration
 template<typename, typename, typename>
 class sd_vector;  // in sd_vector
@@ -81,6 +89,20 @@ class sd_vector_builder
          */
         sd_vector_builder(size_type n, size_type m);
 
+        //! Constructor which fills the builder from sorted shards in parallel.
+        /*! \param n       Vector size.
+         *  \param shards  Sequence of (pointer, length) pairs of sorted position
+         *                 arrays whose concatenation is strictly increasing,
+         *                 e.g. the outputs of sharded posting generators.
+         *  \param threads Number of threads used for the fill; 0 = one thread
+         *                 per hardware core.
+         *  \par The capacity is the total number of shard positions, so the
+         *       builder is full afterwards.
+         */
+        sd_vector_builder(size_type n,
+                          const std::vector<std::pair<const uint64_t*, size_type>>& shards,
+                          uint64_t threads=0);
+
         inline size_type size() const { return m_size; }
         inline size_type capacity() const { return m_capacity; }
         inline size_type tail() const { return m_tail; }
@@ -103,6 +125,14 @@ class sd_vector_builder
             m_tail = i + 1;
         }
 
+        //! Set a block of bits to 1.
+        /*! \param sorted_positions The positions of the bits, strictly increasing.
+         *  \param n                The number of positions.
+         *  \par The first position must be strictly greater than the one of the
+         *       previous call.
+         */
+        void append_block(const uint64_t* sorted_positions, size_type n);
+
         //! Swap method
         void swap(sd_vector_builder& sdb);
 };
@@ -146,6 +176,7 @@ class sd_vector
         typedef rank_support_sd<1, t_hi_bit_vector, select_1_support_type, select_0_support_type> rank_1_type;
         typedef select_support_sd<0, t_hi_bit_vector, select_1_support_type, select_0_support_type> select_0_type;
         typedef select_support_sd<1, t_hi_bit_vector, select_1_support_type, select_0_support_type> select_1_type;
+        typedef pred_support_sd<t_hi_bit_vector, select_1_support_type, select_0_support_type> pred_1_type;
 
         typedef t_hi_bit_vector hi_bit_vector_type;
     private:
@@ -585,6 +616,139 @@ struct select_support_sd_trait<0, t_sd_vec> {
     }
 };
 
+//! Predecessor/successor data structure for sd_vector
+/*! \tparam t_hi_bit_vector Type of the bitvector used for the unary decoded differences of
+ *                          the high part of the positions of the 1s.
+ *  \tparam t_select_1      Type of the select structure which is used to select ones in HI.
+ *  \tparam t_select_0      Type of the select structure which is used to select zeros in HI.
+ *
+ *  The high bits of the sd_vector already act as a bucket directory over
+ *  the universe: the zero-select locates the ones of the query's bucket
+ *  in constant time, and a binary search over the (on average constant
+ *  size) bucket in LOW finds the boundary one. A query thus costs two
+ *  constant time selects plus \f$ \Order{\log(\text{bucket size})} \f$
+ *  comparisons, instead of the \f$ \Order{\log m} \f$ dependent cache
+ *  misses of a binary search over select results. The structure itself
+ *  stores only a pointer, like rank_support_sd.
+ */
+template<class t_hi_bit_vector, class t_select_1, class t_select_0>
+class pred_support_sd
+{
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef sd_vector<t_hi_bit_vector, t_select_1, t_select_0> bit_vector_type;
+    private:
+        const bit_vector_type* m_v;
+
+        //! Ones in the buckets [0..hb-1] and [0..hb] of the high part.
+        void bucket_bounds(size_type hb, size_type& begin, size_type& end) const
+        {
+            end   = m_v->high_0_select(hb + 1) - hb;
+            begin = hb ? m_v->high_0_select(hb) - (hb-1) : 0;
+        }
+
+    public:
+
+        explicit pred_support_sd(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Answers "previous occurence of one" queries for the supported sd_vector.
+        /*! \param i Position \f$ i \in [0..size()-1] \f$.
+         *  \return The maximal position \f$ j \leq i \f$ where the supported sd_vector equals 1.
+         *  \pre There is a one at a position \f$ \leq i \f$.
+         */
+        size_type prev(size_type i) const
+        {
+            assert(m_v != nullptr);
+            assert(i < m_v->size());
+            size_type hb      = i >> m_v->wl;
+            size_type val_low = i & bits::lo_set[ m_v->wl ];
+            size_type begin, end;
+            bucket_bounds(hb, begin, end);
+            if (end > begin and m_v->low[begin] <= val_low) {
+                // largest one of bucket hb with low part <= val_low
+                size_type lb = begin, rb = end;
+                while (rb - lb > 1) { // invariant: low[lb] <= val_low
+                    size_type mid = lb + (rb-lb)/2;
+                    if (m_v->low[mid] <= val_low) {
+                        lb = mid;
+                    } else {
+                        rb = mid;
+                    }
+                }
+                return (hb << m_v->wl) + m_v->low[lb];
+            }
+            // the answer is the last one of the buckets before hb
+            assert(begin > 0);
+            return m_v->low[begin-1] +
+                   ((m_v->high_1_select(begin) + 1 - begin) << m_v->wl);
+        }
+
+        //! Answers "next occurence of one" queries for the supported sd_vector.
+        /*! \param i Position \f$ i \in [0..size()-1] \f$.
+         *  \return The minimal position \f$ j \geq i \f$ where the supported sd_vector equals 1.
+         *  \pre There is a one at a position \f$ \geq i \f$.
+         */
+        size_type next(size_type i) const
+        {
+            assert(m_v != nullptr);
+            assert(i < m_v->size());
+            size_type hb      = i >> m_v->wl;
+            size_type val_low = i & bits::lo_set[ m_v->wl ];
+            size_type begin, end;
+            bucket_bounds(hb, begin, end);
+            if (end > begin and m_v->low[end-1] >= val_low) {
+                // smallest one of bucket hb with low part >= val_low
+                size_type lb = begin, rb = end-1;
+                while (lb < rb) { // invariant: low[rb] >= val_low
+                    size_type mid = lb + (rb-lb)/2;
+                    if (m_v->low[mid] >= val_low) {
+                        rb = mid;
+                    } else {
+                        lb = mid+1;
+                    }
+                }
+                return (hb << m_v->wl) + m_v->low[rb];
+            }
+            // the answer is the first one of the buckets after hb
+            assert(end < m_v->low.size());
+            return m_v->low[end] +
+                   ((m_v->high_1_select(end+1) - end) << m_v->wl);
+        }
+
+        size_type size() const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        pred_support_sd& operator=(const pred_support_sd& ps)
+        {
+            if (this != &ps) {
+                set_vector(ps.m_v);
+            }
+            return *this;
+        }
+
+        void swap(pred_support_sd&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
 //! Select data structure for sd_vector
 /*! \tparam t_b             Bit pattern.
  *  \tparam t_hi_bit_vector Type of the bitvector used for the unary decoded differences of
@@ -835,6 +999,130 @@ class select_0_support_sd
 
 };
 
+//! A cursor for one-sided batch rank/successor scans over an sd_vector.
+/*! The cursor remembers the last decoded one-position together with its
+ *  position in the high-bit vector. A query at a position greater or equal
+ *  to the previous one resumes the unary scan of the high bits from there,
+ *  so a whole pass of non-decreasing rank/successor queries (e.g. merging a
+ *  posting list against an Elias-Fano set) costs
+ *  \f$ \Order{m + n/2^{wl}} \f$ in total instead of one high-bit select per
+ *  query.
+ *
+ *  \tparam t_sd_vector The sd_vector type to iterate over.
+ */
+template<class t_sd_vector=sd_vector<>>
+class sd_vector_cursor
+{
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef t_sd_vector           sd_vector_type;
+
+    private:
+        const sd_vector_type* m_v;    // the supported sd_vector
+        size_type m_ones = 0;         // number of ones in m_v
+        size_type m_k    = 0;         // number of ones before m_cur
+        size_type m_hpos = 0;         // position of the m_k-th one in the high bits
+        size_type m_cur  = 0;         // position of the m_k-th one in the vector
+
+        // decode the position of the m_k-th one; m_hpos must already point
+        // to its high bit
+        void decode()
+        {
+            m_cur = ((m_hpos-m_k) << m_v->wl) | m_v->low[m_k];
+        }
+
+        // move the cursor to the next one
+        void advance()
+        {
+            ++m_k;
+            if (m_k == m_ones) {
+                m_cur = m_v->size();
+                return;
+            }
+            ++m_hpos;
+            while (!m_v->high[m_hpos]) {
+                ++m_hpos;
+            }
+            decode();
+        }
+
+    public:
+        //! Constructor
+        /*! \param v The sd_vector which should be scanned.
+         */
+        explicit sd_vector_cursor(const sd_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Sets the supported sd_vector and resets the cursor.
+        void set_vector(const sd_vector_type* v=nullptr)
+        {
+            m_v = v;
+            m_ones = (m_v != nullptr) ? m_v->low.size() : 0;
+            reset();
+        }
+
+        //! Resets the cursor to the first one.
+        void reset()
+        {
+            m_k = 0;
+            m_hpos = 0;
+            if (m_ones == 0) {
+                m_cur = (m_v != nullptr) ? m_v->size() : 0;
+                return;
+            }
+            while (!m_v->high[m_hpos]) {
+                ++m_hpos;
+            }
+            decode();
+        }
+
+        //! Number of ones in the prefix [0..i-1] of the supported vector.
+        /*! \param i Argument in \f$[0..size()]\f$; must be greater or equal
+         *           to the argument of the previous rank/successor call.
+         */
+        size_type rank(size_type i)
+        {
+            assert(m_v != nullptr);
+            assert(i <= m_v->size());
+            while (m_cur < i) {
+                advance();
+            }
+            return m_k;
+        }
+
+        //! Smallest position \f$\geq i\f$ which carries a one.
+        /*! \param i Argument in \f$[0..size()]\f$; must be greater or equal
+         *           to the argument of the previous rank/successor call.
+         *  \return The position, or size() if no such position exists.
+         */
+        size_type successor(size_type i)
+        {
+            assert(m_v != nullptr);
+            assert(i <= m_v->size());
+            while (m_cur < i) {
+                advance();
+            }
+            return m_cur;
+        }
+
+        //! Position of the next one at or behind the cursor.
+        /*! \return The position, or size() if the ones are exhausted.
+         *  \par Calling next() repeatedly after reset() enumerates all
+         *       one-positions in increasing order.
+         */
+        size_type next()
+        {
+            assert(m_v != nullptr);
+            size_type res = m_cur;
+            if (m_k < m_ones) {
+                advance();
+            }
+            return res;
+        }
+};
+
 
 } // end namespace
 #endif
@@ -0,0 +1,264 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file segmented_int_vector.hpp
+    \brief segmented_int_vector.hpp contains an int_vector variant which
+           stores its data in fixed-size extents instead of one
+           contiguous allocation.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_SEGMENTED_INT_VECTOR
+#define INCLUDED_SDSL_SEGMENTED_INT_VECTOR
+
+#include <vector>
+#include "int_vector.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A segmented variant of int_vector for very large sequences.
+/*! The elements are spread over fixed-size extents (1 GiB by default),
+ *  each of which is a separate int_vector allocation. A resize() only
+ *  adds or drops extents and never moves existing data, so growing the
+ *  vector needs no contiguous headroom and no copy of the old content
+ *  -- in contrast to int_vector, which needs one allocation of the
+ *  full size plus the old one during the copy. The number of elements
+ *  per extent is rounded down to a power of two, so the extent of
+ *  index i is found with one shift; the single-extent case, which
+ *  covers every vector below the extent size, skips the extent table
+ *  lookup entirely.
+ *
+ *  The serialization format is identical to int_vector of the same
+ *  width (extent payloads are multiples of 64 bits), so the files can
+ *  be exchanged freely with int_vector, int_vector_buffer and RAM
+ *  files: a segmented_int_vector can be stored and loaded wherever an
+ *  int_vector of the same width is expected.
+ *
+ *  \tparam t_width        Width of the integers, as in int_vector.
+ *  \tparam t_extent_bytes Extent size in bytes; a power of two >= 4096.
+ */
+template<uint8_t t_width=0, uint64_t t_extent_bytes=1ULL<<30>
+class segmented_int_vector
+{
+    public:
+        typedef int_vector<t_width>                        extent_type;
+        typedef typename extent_type::size_type            size_type;
+        typedef typename extent_type::value_type           value_type;
+        typedef typename extent_type::reference            reference;
+        typedef typename extent_type::const_reference      const_reference;
+        typedef typename extent_type::int_width_type       int_width_type;
+
+        static_assert(t_extent_bytes >= 4096 and 0 == (t_extent_bytes&(t_extent_bytes-1)),
+                      "segmented_int_vector: extent size must be a power of two >= 4096 bytes.");
+    private:
+        size_type                m_size    = 0;       // number of elements
+        uint8_t                  m_width   = t_width ? t_width : 64;
+        uint8_t                  m_log_ext = 0;       // log2 of elements per extent
+        std::vector<extent_type> m_extents;
+
+        //! Elements per extent: the largest power of two whose payload
+        //! fits into t_extent_bytes. The payload of a full extent is a
+        //! multiple of 64 bits, which keeps the concatenation of the
+        //! extents identical to one contiguous int_vector payload.
+        static uint8_t log_extent(uint8_t width)
+        {
+            return bits::hi(t_extent_bytes<<3) - bits::hi(width)
+                   - ((width&(width-1)) != 0);
+        }
+
+        size_type extent_size()const
+        {
+            return (size_type)1 << m_log_ext;
+        }
+
+    public:
+        //! Constructor, analogous to int_vector.
+        /*! \param size          Number of elements.
+         *  \param default_value Initial value of the elements.
+         *  \param int_width     Width of an element; ignored for fixed
+         *                       width vectors.
+         */
+        explicit segmented_int_vector(size_type size=0, value_type default_value=0,
+                                      uint8_t int_width=t_width)
+        {
+            if (0 == t_width) {
+                m_width = int_width ? int_width : 64;
+            }
+            m_log_ext = log_extent(m_width);
+            resize(size);
+            for (auto& e : m_extents) {
+                util::set_to_value(e, default_value);
+            }
+        }
+
+        //! The number of elements in the vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        bool empty()const
+        {
+            return 0 == m_size;
+        }
+
+        //! The number of bits of the vector.
+        size_type bit_size()const
+        {
+            return m_size * m_width;
+        }
+
+        //! The width of the integers.
+        uint8_t width()const
+        {
+            return m_width;
+        }
+
+        //! Sets the width of the integers.
+        /*! In contrast to int_vector the width can only be changed
+         *  while the vector is empty, since the extent geometry
+         *  depends on it.
+         */
+        void width(uint8_t new_width)
+        {
+            assert(empty());
+            if (0 == t_width) {
+                m_width   = new_width;
+                m_log_ext = log_extent(m_width);
+            }
+        }
+
+        //! Resizes the vector to `size` elements.
+        /*! Only whole extents are added or removed; extents which stay
+         *  keep their allocation, so no element is ever moved and no
+         *  contiguous block beyond one extent is requested.
+         */
+        void resize(size_type size)
+        {
+            size_type ext = (size + extent_size() - 1) >> m_log_ext;
+            m_extents.resize(ext);
+            for (size_type e=0; e+1 < ext; ++e) {
+                if (m_extents[e].size() != extent_size()) {
+                    m_extents[e].width(m_width);
+                    m_extents[e].resize(extent_size());
+                }
+            }
+            if (ext > 0) {
+                m_extents[ext-1].width(m_width);
+                m_extents[ext-1].resize(size - ((ext-1) << m_log_ext));
+            }
+            m_size = size;
+        }
+
+        //! Accessing the i-th element.
+        reference operator[](const size_type& i)
+        {
+            assert(i < m_size);
+            if (1 == m_extents.size()) {  // common case: no indirection
+                return m_extents[0][i];
+            }
+            return m_extents[i>>m_log_ext][i & (extent_size()-1)];
+        }
+
+        //! Accessing the i-th element.
+        const_reference operator[](const size_type& i)const
+        {
+            assert(i < m_size);
+            if (1 == m_extents.size()) {
+                return m_extents[0][i];
+            }
+            return m_extents[i>>m_log_ext][i & (extent_size()-1)];
+        }
+
+        //! Get `len` bits starting at bit position `idx`, as in int_vector.
+        uint64_t get_int(size_type idx, const uint8_t len=64)const
+        {
+            size_type ext_bits = extent_size() * m_width;
+            size_type e   = idx / ext_bits;
+            size_type off = idx - e*ext_bits;
+            if (off + len <= ext_bits) {
+                return m_extents[e].get_int(off, len);
+            }
+            uint8_t low = ext_bits - off;  // bits taken from extent e
+            return m_extents[e].get_int(off, low)
+                   | (m_extents[e+1].get_int(0, len-low) << low);
+        }
+
+        //! Set `len` bits starting at bit position `idx`, as in int_vector.
+        void set_int(size_type idx, uint64_t x, const uint8_t len=64)
+        {
+            size_type ext_bits = extent_size() * m_width;
+            size_type e   = idx / ext_bits;
+            size_type off = idx - e*ext_bits;
+            if (off + len <= ext_bits) {
+                m_extents[e].set_int(off, x, len);
+                return;
+            }
+            uint8_t low = ext_bits - off;
+            m_extents[e].set_int(off, x & bits::lo_set[low], low);
+            m_extents[e+1].set_int(0, x >> low, len-low);
+        }
+
+        //! Swap method
+        void swap(segmented_int_vector& v)
+        {
+            if (this != &v) {
+                std::swap(m_size, v.m_size);
+                std::swap(m_width, v.m_width);
+                std::swap(m_log_ext, v.m_log_ext);
+                m_extents.swap(v.m_extents);
+            }
+        }
+
+        //! Serializes the vector in int_vector format.
+        /*! The output is byte-identical to the serialization of an
+         *  int_vector with the same content, so it can be loaded by
+         *  int_vector::load and opened with int_vector_buffer.
+         */
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += extent_type::write_header(bit_size(), m_width, out);
+            for (size_type e=0; e < m_extents.size(); ++e) {
+                size_type payload = ((m_extents[e].bit_size()+63)>>6)<<3;
+                out.write(reinterpret_cast<const char*>(m_extents[e].data()),
+                          static_cast<std::streamsize>(payload));
+                written_bytes += payload;
+            }
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the vector from a stream in int_vector format.
+        void load(std::istream& in)
+        {
+            size_type bit_sz = 0;
+            extent_type::read_header(bit_sz, m_width, in);
+            m_log_ext = log_extent(m_width);
+            resize(bit_sz / m_width);
+            for (size_type e=0; e < m_extents.size(); ++e) {
+                size_type payload = ((m_extents[e].bit_size()+63)>>6)<<3;
+                in.read(reinterpret_cast<char*>(m_extents[e].data()),
+                        static_cast<std::streamsize>(payload));
+            }
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
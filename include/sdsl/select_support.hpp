@@ -405,6 +405,7 @@ struct select_support_trait<11,2> {
 } // end namespace sdsl
 
 #include "select_support_mcl.hpp"
+#include "select_support_da.hpp"
 #include "select_support_scan.hpp"
 
 #endif
@@ -0,0 +1,326 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2008 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file select_support_da.hpp
+    \brief select_support_da.hpp contains a darray-style select support.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_SELECT_SUPPORT_DA
+#define INCLUDED_SDSL_SELECT_SUPPORT_DA
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "select_support.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A select support based on the darray/combined-sampling scheme.
+/*!
+ * \par Space usage
+ *      The position of every 1024th argument is stored with \f$\log n\f$
+ *      bits. For blocks which span less than \f$2^{16}\f$ bits, the relative
+ *      position of every 128th argument inside the block is additionally
+ *      stored with 16 bits; the remaining arguments are found by a popcount
+ *      scan over at most \f$2^{16}\f$ bits, with the final in-word position
+ *      answered by bits::sel (PDEP on BMI2 CPUs). Blocks which span more
+ *      bits store all 1024 argument positions explicitly, so the scan length
+ *      is bounded independently of how adversarially the arguments cluster.
+ *      The worst-case space is about \f$0.16\f$ bits per argument, compared
+ *      to up to \f$0.2n\f$ bits for select_support_mcl.
+ *
+ * \tparam t_b       Bit pattern `0` or `1` which should be selected.
+ * \tparam t_pat_len Length of the bit pattern (must be 1).
+ *
+ * \par Reference
+ *      Daisuke Okanohara, Kunihiko Sadakane:
+ *      Practical Entropy-Compressed Rank/Select Dictionary.
+ *      ALENEX 2007: 60-70
+ *
+ * @ingroup select_support_group
+ */
+template<uint8_t t_b=1, uint8_t t_pat_len=1>
+class select_support_da : public select_support
+{
+    private:
+        static_assert(t_b == 1u or t_b == 0u, "select_support_da: bit pattern must be `0` or `1`");
+        static_assert(t_pat_len == 1u, "select_support_da: bit pattern length must be 1");
+    public:
+        typedef bit_vector bit_vector_type;
+        typedef select_support_trait<t_b, t_pat_len> trait_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = t_pat_len };
+    private:
+        // arguments per sampled block
+        static const size_type t_sb = 1024;
+        // subsampling rate of arguments inside a short block
+        static const size_type t_ss = 128;
+        // a block spanning >= t_max_span bits stores its positions explicitly
+        static const size_type t_max_span = 65536;
+
+        size_type     m_arg_cnt = 0;
+        int_vector<0> m_sample;            // position of each t_sb-th argument
+        int_vector<16> m_sub;              // in-block offsets of t_ss-th arguments
+        int_vector<0>* m_longblock = nullptr; // explicit positions of long blocks
+
+        size_type blocks() const {
+            return (m_arg_cnt+t_sb-1)/t_sb;
+        }
+
+        void copy(const select_support_da<t_b, t_pat_len>& ss);
+        void init(const bit_vector* v=nullptr);
+        // store block b given the positions of its cnt arguments
+        void store_block(size_type b, const size_type* arg_position, size_type cnt);
+    public:
+        explicit select_support_da(const bit_vector* v=nullptr);
+        select_support_da(const select_support_da<t_b,t_pat_len>& ss);
+        select_support_da(select_support_da<t_b,t_pat_len>&& ss);
+        ~select_support_da();
+        //! Select function
+        inline size_type select(size_type i) const;
+        //! Alias for select(i).
+        inline size_type operator()(size_type i)const;
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const;
+        void load(std::istream& in, const bit_vector* v=nullptr);
+        void set_vector(const bit_vector* v=nullptr);
+        select_support_da<t_b, t_pat_len>& operator=(const select_support_da& ss);
+        select_support_da<t_b, t_pat_len>& operator=(select_support_da&&);
+        void swap(select_support_da<t_b, t_pat_len>& ss);
+};
+
+template<uint8_t t_b, uint8_t t_pat_len>
+select_support_da<t_b,t_pat_len>::select_support_da(const bit_vector* f_v):select_support(f_v)
+{
+    init(f_v);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+select_support_da<t_b,t_pat_len>::select_support_da(const select_support_da& ss):select_support(ss.m_v)
+{
+    copy(ss);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+select_support_da<t_b,t_pat_len>::select_support_da(select_support_da&& ss) : select_support(ss.m_v)
+{
+    *this = std::move(ss);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+select_support_da<t_b,t_pat_len>::~select_support_da()
+{
+    delete[] m_longblock;
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+select_support_da<t_b, t_pat_len>& select_support_da<t_b,t_pat_len>::operator=(const select_support_da& ss)
+{
+    if (this != &ss) {
+        copy(ss);
+    }
+    return *this;
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+select_support_da<t_b, t_pat_len>& select_support_da<t_b,t_pat_len>::operator=(select_support_da&& ss)
+{
+    if (this != &ss) {
+        m_arg_cnt = ss.m_arg_cnt;
+        m_sample  = std::move(ss.m_sample);
+        m_sub     = std::move(ss.m_sub);
+        m_v       = ss.m_v;
+        delete [] m_longblock;
+        m_longblock = ss.m_longblock;
+        ss.m_longblock = nullptr;
+    }
+    return *this;
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_da<t_b,t_pat_len>::swap(select_support_da& ss)
+{
+    std::swap(m_arg_cnt, ss.m_arg_cnt);
+    m_sample.swap(ss.m_sample);
+    m_sub.swap(ss.m_sub);
+    std::swap(m_longblock, ss.m_longblock);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_da<t_b,t_pat_len>::copy(const select_support_da<t_b, t_pat_len>& ss)
+{
+    m_arg_cnt = ss.m_arg_cnt;
+    m_sample  = ss.m_sample;
+    m_sub     = ss.m_sub;
+    m_v       = ss.m_v;
+    delete [] m_longblock;
+    m_longblock = nullptr;
+    if (ss.m_longblock != nullptr) {
+        size_type nb = blocks();
+        m_longblock = new int_vector<0>[nb];
+        for (size_type i=0; i < nb; ++i) {
+            m_longblock[i] = ss.m_longblock[i];
+        }
+    }
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_da<t_b,t_pat_len>::store_block(size_type b, const size_type* arg_position, size_type cnt)
+{
+    m_sample[b] = arg_position[0];
+    if (arg_position[cnt-1] - arg_position[0] >= t_max_span) { // long block
+        m_longblock[b] = int_vector<0>(cnt, 0, bits::hi(arg_position[cnt-1])+1);
+        for (size_type j=0; j < cnt; ++j) {
+            m_longblock[b][j] = arg_position[j];
+        }
+    } else { // short block: subsample every t_ss-th argument
+        for (size_type j=0; j < cnt; j+=t_ss) {
+            m_sub[b*(t_sb/t_ss) + j/t_ss] = arg_position[j] - arg_position[0];
+        }
+    }
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_da<t_b,t_pat_len>::init(const bit_vector* v)
+{
+    set_vector(v);
+    m_arg_cnt = 0;
+    m_sample = int_vector<0>();
+    m_sub = int_vector<16>();
+    delete[] m_longblock;
+    m_longblock = nullptr;
+    if (m_v == nullptr or m_v->empty())
+        return;
+    m_arg_cnt = trait_type::arg_cnt(*v);
+    if (m_arg_cnt == 0)
+        return;
+    size_type nb = blocks();
+    m_sample = int_vector<0>(nb, 0, bits::hi(m_v->size())+1);
+    m_sub    = int_vector<16>(nb*(t_sb/t_ss), 0);
+    m_longblock = new int_vector<0>[nb];
+
+    size_type arg_position[t_sb];
+    size_type cnt = 0, b = 0;
+    const uint64_t* data = m_v->data();
+    uint64_t carry = 0;
+    for (size_type word=0; word < (m_v->size()+63)>>6 and cnt < m_arg_cnt; ++word) {
+        size_type args = trait_type::args_in_the_word(data[word], carry);
+        for (size_type j=1; j <= args and cnt < m_arg_cnt; ++j) {
+            arg_position[cnt%t_sb] = (word<<6)
+                                     + trait_type::ith_arg_pos_in_the_word(data[word], j, 0);
+            ++cnt;
+            if (cnt%t_sb == 0 or cnt == m_arg_cnt) {
+                store_block(b++, arg_position, ((cnt-1)%t_sb)+1);
+            }
+        }
+    }
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+inline auto select_support_da<t_b,t_pat_len>::select(size_type i)const -> size_type
+{
+    assert(i > 0 and i <= m_arg_cnt);
+    i = i-1;
+    size_type b = i/t_sb;
+    if (!m_longblock[b].empty()) { // long block: positions are explicit
+        return m_longblock[b][i%t_sb];
+    }
+    size_type pos = m_sample[b] + m_sub[b*(t_sb/t_ss) + (i%t_sb)/t_ss];
+    i = (i%t_sb)%t_ss; // arguments still missing after the subsampled one
+    if (i == 0) {
+        return pos;
+    }
+    // scan for the i-th argument strictly behind position pos
+    ++pos;
+    size_type word_pos = pos>>6;
+    size_type word_off = pos&0x3F;
+    const uint64_t* data = m_v->data() + word_pos;
+    size_type args = trait_type::args_in_the_first_word(*data, word_off, 0);
+    if (args >= i) {
+        return (word_pos<<6)
+               + trait_type::ith_arg_pos_in_the_first_word(*data, i, word_off, 0);
+    }
+    size_type sum_args = args;
+    uint64_t carry = 0;
+    args = trait_type::args_in_the_word(*(++data), carry);
+    word_pos += 1;
+    while (sum_args + args < i) {
+        sum_args += args;
+        assert(data+1 < m_v->data() + (m_v->capacity()>>6));
+        args = trait_type::args_in_the_word(*(++data), carry);
+        word_pos += 1;
+    }
+    return (word_pos<<6) + trait_type::ith_arg_pos_in_the_word(*data, i-sum_args, 0);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+inline auto select_support_da<t_b,t_pat_len>::operator()(size_type i)const -> size_type
+{
+    return select(i);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_da<t_b,t_pat_len>::set_vector(const bit_vector* v)
+{
+    m_v = v;
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+auto select_support_da<t_b,t_pat_len>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const -> size_type
+{
+    structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+    size_type written_bytes = 0;
+    // write the number of arguments in the supported bit_vector
+    out.write((char*) &m_arg_cnt, sizeof(size_type)/sizeof(char));
+    written_bytes = sizeof(size_type)/sizeof(char);
+    if (m_arg_cnt) {
+        written_bytes += m_sample.serialize(out, child, "sample");
+        written_bytes += m_sub.serialize(out, child, "subsample");
+        size_type written_bytes_long = 0;
+        for (size_type i=0; i < blocks(); ++i) {
+            written_bytes_long += m_longblock[i].serialize(out);
+        }
+        structure_tree_node* child_long = structure_tree::add_child(child, "longblock", "long blocks");
+        structure_tree::add_size(child_long, written_bytes_long);
+        written_bytes += written_bytes_long;
+    }
+    structure_tree::add_size(child, written_bytes);
+    return written_bytes;
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_da<t_b,t_pat_len>::load(std::istream& in, const bit_vector* v)
+{
+    set_vector(v);
+    m_sample = int_vector<0>();
+    m_sub = int_vector<16>();
+    delete[] m_longblock;
+    m_longblock = nullptr;
+    in.read((char*) &m_arg_cnt, sizeof(size_type)/sizeof(char));
+    if (m_arg_cnt) {
+        m_sample.load(in);
+        m_sub.load(in);
+        size_type nb = blocks();
+        m_longblock = new int_vector<0>[nb];
+        for (size_type i=0; i < nb; ++i) {
+            m_longblock[i].load(in);
+        }
+    }
+}
+
+}// end namespace sdsl
+
+#endif // end file
@@ -32,26 +32,67 @@ namespace sdsl
 
 //! A class supporting linear time select queries.
 /*! \par Space complexity
- *       Constant.
+ *       Constant for t_skip=false. One 32-bit counter per 4 KiB of the
+ *       supported vector (an overhead of 1/1024) for t_skip=true.
  *  \par Time complexity
- *       Linear in the size of the supported vector.
+ *       Linear in the size of the supported vector. For single-bit
+ *       patterns the scan processes eight words per iteration with
+ *       independent popcounts, and the optional skip directory narrows
+ *       the scan to one 4 KiB block first, so long stretches without
+ *       arguments are skipped with one counter comparison per block.
  *
  *  \tparam t_b       Bit pattern which should be supported. Either `0`,`1`,`10`,`01`.
  *  \tparam t_pat_len Length of the bit pattern.
+ *  \tparam t_skip    If true, keep a 1-level directory with the number
+ *                    of arguments per 4 KiB block. Only available for
+ *                    single-bit patterns.
  * @ingroup select_support_group
  */
-template<uint8_t t_b=1, uint8_t t_pat_len=1>
+template<uint8_t t_b=1, uint8_t t_pat_len=1, bool t_skip=false>
 class select_support_scan : public select_support
 {
     private:
         static_assert(t_b == 1u or t_b == 0u or t_b == 10u , "select_support_scan: bit pattern must be `0`,`1`,`10` or `01`");
         static_assert(t_pat_len == 1u or t_pat_len == 2u , "select_support_scan: bit pattern length must be 1 or 2");
+        static_assert(!t_skip or t_pat_len == 1u, "select_support_scan: the skip directory requires a single-bit pattern");
     public:
         typedef bit_vector bit_vector_type;
         enum { bit_pat = t_b };
+        // 4 KiB of the supported vector per directory entry
+        static const size_type words_per_block = 512;
+    private:
+        int_vector<32> m_skip; // number of arguments per 4 KiB block
+
+        // Number of arguments in word w; only used for t_pat_len == 1.
+        static inline uint64_t word_args(uint64_t w)
+        {
+            return bits::cnt((t_b == 1) ? w : ~w);
+        }
+
+        void build_skip()
+        {
+            m_skip = int_vector<32>();
+            if (!t_skip or nullptr == m_v) {
+                return;
+            }
+            size_type n_words = (m_v->capacity()>>6);
+            m_skip = int_vector<32>((n_words+words_per_block-1)/words_per_block, 0);
+            const uint64_t* data = m_v->data();
+            for (size_type b=0; b < m_skip.size(); ++b) {
+                uint64_t c = 0;
+                size_type end = std::min(n_words, (b+1)*words_per_block);
+                for (size_type k=b*words_per_block; k < end; ++k) {
+                    c += word_args(data[k]);
+                }
+                m_skip[b] = c;
+            }
+        }
     public:
-        explicit select_support_scan(const bit_vector* v=nullptr) : select_support(v) {}
-        select_support_scan(const select_support_scan<t_b,t_pat_len>& ss) : select_support(ss.m_v) {}
+        explicit select_support_scan(const bit_vector* v=nullptr) : select_support(v)
+        {
+            build_skip();
+        }
+        select_support_scan(const select_support_scan& ss) : select_support(ss.m_v), m_skip(ss.m_skip) {}
 
         inline size_type select(size_type i) const;
         inline size_type operator()(size_type i)const
@@ -60,29 +101,80 @@ class select_support_scan : public select_support
         }
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
         {
-            return serialize_empty_object(out, v, name, this);
+            if (!t_skip) {
+                return serialize_empty_object(out, v, name, this);
+            }
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = m_skip.serialize(out, child, "skip");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
         }
-        void load(std::istream&, SDSL_UNUSED const bit_vector* v=nullptr)
+        void load(std::istream& in, SDSL_UNUSED const bit_vector* v=nullptr)
         {
-            set_vector(v);
+            m_v = v;
+            if (t_skip) {
+                m_skip.load(in);
+            }
         }
 
         void set_vector(const bit_vector* v=nullptr)
         {
             m_v = v;
         }
-        select_support_scan<t_b, t_pat_len>& operator=(const select_support_scan& ss)
+        select_support_scan& operator=(const select_support_scan& ss)
         {
-            set_vector(ss.m_v);
+            m_v    = ss.m_v;
+            m_skip = ss.m_skip;
             return *this;
         }
-        void swap(select_support_scan<t_b, t_pat_len>&) {}
+        void swap(select_support_scan& ss)
+        {
+            m_skip.swap(ss.m_skip);
+        }
 };
 
-template<uint8_t t_b, uint8_t t_pat_len>
-inline typename select_support_scan<t_b,t_pat_len>::size_type select_support_scan<t_b,t_pat_len>::select(size_type i)const
+template<uint8_t t_b, uint8_t t_pat_len, bool t_skip>
+inline typename select_support_scan<t_b,t_pat_len,t_skip>::size_type select_support_scan<t_b,t_pat_len,t_skip>::select(size_type i)const
 {
     const uint64_t* data = m_v->data();
+    if (1 == t_pat_len) {
+        size_type n_words  = (m_v->capacity()>>6);
+        size_type word_pos = 0;
+        size_type sum_args = 0;
+        if (t_skip and m_skip.size() > 0) {
+            size_type b = 0;
+            while (b+1 < m_skip.size() and sum_args + m_skip[b] < i) {
+                sum_args += m_skip[b];
+                ++b;
+            }
+            word_pos = b*words_per_block;
+        }
+        // eight independent popcounts per iteration; the compiler is
+        // free to vectorize the accumulation, and a block without the
+        // i-th argument costs one branch instead of eight
+        while (word_pos + 8 <= n_words) {
+            uint64_t args = word_args(data[word_pos])   + word_args(data[word_pos+1])
+                          + word_args(data[word_pos+2]) + word_args(data[word_pos+3])
+                          + word_args(data[word_pos+4]) + word_args(data[word_pos+5])
+                          + word_args(data[word_pos+6]) + word_args(data[word_pos+7]);
+            if (sum_args + args >= i) {
+                break;
+            }
+            sum_args += args;
+            word_pos += 8;
+        }
+        while (word_pos < n_words) {
+            uint64_t w    = (t_b == 1) ? data[word_pos] : ~data[word_pos];
+            uint64_t args = bits::cnt(w);
+            if (sum_args + args >= i) {
+                return (word_pos<<6) + bits::sel(w, i-sum_args);
+            }
+            sum_args += args;
+            ++word_pos;
+        }
+        return m_v->size(); // i-th argument does not exist
+    }
+    // two-bit patterns: the carry makes the words dependent, scan one by one
     size_type word_pos = 0;
     size_type word_off = 0;
     uint64_t carry = select_support_trait<t_b,t_pat_len>::init_carry(data, word_pos);
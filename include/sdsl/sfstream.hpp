@@ -19,6 +19,7 @@ class osfstream : public std::ostream
     private:
         buf_ptr_type m_streambuf = nullptr;
         std::string  m_file      = "";
+        bool         m_async     = false;  // backed by async_filebuf
     public:
         typedef void* voidptr;
         //! Standard constructor.
@@ -49,6 +50,7 @@ class isfstream : public std::istream
     private:
         buf_ptr_type m_streambuf = nullptr;
         std::string  m_file      = "";
+        bool         m_async     = false;  // backed by async_filebuf
     public:
         typedef void* voidptr;
         //! Standard constructor.
@@ -0,0 +1,258 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file sharded_csa.hpp
+    \brief sharded_csa.hpp contains a facade over a partition of CSA
+           shards with parallel query fan-out.
+    \author Simon Gog
+
+    Corpora beyond the practical size of a single index are split into
+    shards, one CSA per document partition. sharded_csa owns the
+    shards, constructs them in parallel (each over its own cache_config
+    id, driven by construct_executor), fans count/locate out over a
+    thread pool and merges the per-shard results: locate positions are
+    translated into global corpus positions via the shard offsets, and
+    shard_of() maps a global position back to its shard — the document
+    partition id. Batched counting reuses backward_search_batch per
+    shard, so the interleaving of the in-library batch search also
+    applies across the patterns of a fan-out.
+*/
+#ifndef INCLUDED_SDSL_SHARDED_CSA
+#define INCLUDED_SDSL_SHARDED_CSA
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "construct.hpp"
+#include "construct_executor.hpp"
+#include "int_vector.hpp"
+#include "suffix_array_algorithm.hpp"
+#include "util.hpp"
+
+namespace sdsl
+{
+
+//! A facade over a partition of CSA shards with parallel query fan-out.
+/*! \tparam t_csa The CSA type of the shards.
+ */
+template<class t_csa>
+class sharded_csa
+{
+    public:
+        typedef t_csa                     csa_type;
+        typedef typename t_csa::size_type size_type;
+    private:
+        std::vector<t_csa> m_shards;
+        int_vector<64>     m_offset; // global start position of each shard
+
+        void init_offsets()
+        {
+            m_offset = int_vector<64>(m_shards.size(), 0);
+            size_type pos = 0;
+            for (size_type s=0; s < m_shards.size(); ++s) {
+                m_offset[s] = pos;
+                pos += m_shards[s].size();
+            }
+        }
+
+        //! Runs f(s) for every shard s on a thread pool.
+        template<class t_fun>
+        void for_each_shard(t_fun f) const
+        {
+            size_type threads = construct_config::num_threads;
+            if (0 == threads) {
+                threads = std::thread::hardware_concurrency();
+            }
+            threads = std::min<size_type>(threads, m_shards.size());
+            if (threads <= 1) {
+                for (size_type s=0; s < m_shards.size(); ++s) {
+                    f(s);
+                }
+                return;
+            }
+            std::vector<std::thread> pool;
+            for (size_type t=0; t < threads; ++t) {
+                pool.emplace_back([&, t]() {
+                    for (size_type s=t; s < m_shards.size(); s += threads) {
+                        f(s);
+                    }
+                });
+            }
+            for (auto& th : pool) {
+                th.join();
+            }
+        }
+    public:
+        sharded_csa() { }
+
+        //! Constructs one shard per file of a document partition.
+        /*! \param files     The files of the partition, one shard each.
+         *  \param config    Cache configuration; each shard works under
+         *                   the id config.id plus a shard suffix.
+         *  \param num_bytes Bytes per input symbol, as in construct().
+         *
+         *  The shards are independent, so they are constructed in
+         *  parallel via construct_executor on
+         *  construct_config::num_threads threads.
+         */
+        sharded_csa(const std::vector<std::string>& files,
+                    const cache_config& config, uint8_t num_bytes=0)
+        {
+            m_shards.resize(files.size());
+            construct_executor exec;
+            for (size_type s=0; s < files.size(); ++s) {
+                exec.add("shard "+util::to_string(s), {}, [this, s, &files, &config, num_bytes]() {
+                    cache_config shard_config(config.delete_files, config.dir,
+                                              config.id+"_shard_"+util::to_string(s));
+                    construct(m_shards[s], files[s], shard_config, num_bytes);
+                });
+            }
+            exec.run();
+            init_offsets();
+        }
+
+        //! Number of shards.
+        size_type shards() const
+        {
+            return m_shards.size();
+        }
+
+        //! The s-th shard.
+        const t_csa& shard(size_type s) const
+        {
+            return m_shards[s];
+        }
+
+        //! Total size over all shards.
+        size_type size() const
+        {
+            return m_shards.empty() ? 0
+                   : m_offset[m_shards.size()-1]+m_shards.back().size();
+        }
+
+        //! Maps a global position to the shard — i.e. partition id — holding it.
+        size_type shard_of(size_type global_pos) const
+        {
+            assert(global_pos < size());
+            size_type s = std::upper_bound(m_offset.begin(), m_offset.end(),
+                                           global_pos) - m_offset.begin();
+            return s-1;
+        }
+
+        //! Counts the occurrences of a pattern over all shards.
+        /*! The per-shard counts run in parallel on the fan-out pool.
+         */
+        template<class t_pat_iter>
+        size_type count(t_pat_iter begin, t_pat_iter end) const
+        {
+            std::vector<size_type> part(m_shards.size(), 0);
+            for_each_shard([&](size_type s) {
+                part[s] = sdsl::count(m_shards[s], begin, end);
+            });
+            return std::accumulate(part.begin(), part.end(), (size_type)0);
+        }
+
+        //! Counts a batch of patterns over all shards.
+        /*! \return occ[p] = total occurrences of pattern p.
+         *
+         *  Every shard matches the whole batch with
+         *  backward_search_batch, so the rank latency hiding of the
+         *  batch search applies per shard and the shards themselves
+         *  run in parallel.
+         */
+        template<class t_pat_iter>
+        std::vector<size_type>
+        count_batch(const std::vector<std::pair<t_pat_iter, t_pat_iter>>& patterns) const
+        {
+            std::vector<std::vector<size_type>> part(m_shards.size());
+            for_each_shard([&](size_type s) {
+                part[s] = sdsl::count_batch(m_shards[s], patterns);
+            });
+            std::vector<size_type> occ(patterns.size(), 0);
+            for (size_type s=0; s < m_shards.size(); ++s) {
+                for (size_type p=0; p < patterns.size(); ++p) {
+                    occ[p] += part[s][p];
+                }
+            }
+            return occ;
+        }
+
+        //! Locates all occurrences of a pattern over all shards.
+        /*! \return The occurrences as global corpus positions, merged in
+         *          shard order; shard_of() recovers the partition id.
+         */
+        template<class t_pat_iter>
+        std::vector<size_type> locate(t_pat_iter begin, t_pat_iter end) const
+        {
+            std::vector<std::vector<size_type>> part(m_shards.size());
+            for_each_shard([&](size_type s) {
+                auto occ = sdsl::locate(m_shards[s], begin, end);
+                part[s].reserve(occ.size());
+                for (size_type i=0; i < occ.size(); ++i) {
+                    part[s].push_back(m_offset[s]+occ[i]);
+                }
+            });
+            std::vector<size_type> merged;
+            for (const auto& p : part) {
+                merged.insert(merged.end(), p.begin(), p.end());
+            }
+            return merged;
+        }
+
+        void swap(sharded_csa& csa)
+        {
+            if (this != &csa) {
+                m_shards.swap(csa.m_shards);
+                m_offset.swap(csa.m_offset);
+            }
+        }
+
+        //! Serialize to a stream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            uint64_t shards = m_shards.size();
+            written_bytes += write_member(shards, out, child, "shards");
+            written_bytes += m_offset.serialize(out, child, "offset");
+            for (size_type s=0; s < m_shards.size(); ++s) {
+                written_bytes += m_shards[s].serialize(out, child,
+                                 "shard_"+util::to_string(s));
+            }
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Load from a stream.
+        void load(std::istream& in)
+        {
+            uint64_t shards = 0;
+            read_member(shards, in);
+            m_offset.load(in);
+            m_shards.resize(shards);
+            for (size_type s=0; s < shards; ++s) {
+                m_shards[s].load(in);
+            }
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
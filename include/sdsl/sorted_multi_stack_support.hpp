@@ -82,6 +82,27 @@ class sorted_multi_stack_support
          */
         bool push(size_type x);
 
+        /*! Push the run of values a, a+1,...,b onto the stack.
+         *  \param a Smallest value of the run.
+         *  \param b Largest value of the run.
+         *  \pre top() <= a, a <= b and b <= n
+         *
+         *  Equivalent to push(a); push(a+1);...; push(b), but the bits of
+         *  the run are set block-at-a-time in the bit-compressed
+         *  representation.
+         */
+        void push_run(size_type a, size_type b);
+
+        /*! Pop all elements which are greater or equal than x.
+         *  \param x The threshold value.
+         *  \return The number of popped elements (duplicates counted).
+         *
+         *  Equivalent to the loop `while(!empty() and top()>=x) pop();`,
+         *  but the bits of the popped elements are cleared
+         *  block-at-a-time in both the value and the duplication stack.
+         */
+        size_type pop_until(size_type x);
+
         /*! Returns the number of element is the stack.
          */
         size_type size()const {
@@ -161,6 +182,102 @@ inline bool sorted_multi_stack_support::pop()
     return false;
 }
 
+inline void sorted_multi_stack_support::push_run(size_type a, size_type b)
+{
+    assert((empty() or top() <= a) and a <= b and b <= m_n);
+    if (!empty() and top() == a) {
+        // the first value duplicates the top; handle it bit-wise
+        push(a);
+        if (a == b)
+            return;
+        a += 1;
+    }
+    size_type x = a+1, y = b+1;
+    size_type bn = block_nr(x);
+    // only the block below the first value of the run can need a
+    // pointer; all later blocks of the run contain bits of the run
+    if (bn > 0 and m_stack[bn-1] == 0) {
+        m_stack[bn-1] = 0x8000000000000000ULL | m_top;
+    }
+    size_type bn_y = block_nr(y);
+    if (bn == bn_y) {
+        m_stack[bn] |= bits::lo_set[block_pos(y)+1] & ~bits::lo_set[block_pos(x)];
+    } else {
+        m_stack[bn] |= (0x7FFFFFFFFFFFFFFFULL << block_pos(x))
+                       & 0x7FFFFFFFFFFFFFFFULL;
+        for (size_type i=bn+1; i < bn_y; ++i) {
+            m_stack[i] = 0x7FFFFFFFFFFFFFFFULL;
+        }
+        m_stack[bn_y] |= bits::lo_set[block_pos(y)+1];
+    }
+    m_top = y;
+    // the zeros for the new entries of the duplication stack are
+    // already in place, as entries above m_cnt are always zero
+    m_cnt += b-a+1;
+}
+
+inline sorted_multi_stack_support::size_type
+sorted_multi_stack_support::pop_until(size_type x)
+{
+    x += 1;
+    // 1. clear all distinct values >= x in the value stack
+    size_type d = 0; // number of cleared distinct values
+    while (m_top >= x) {
+        size_type bn = block_nr(m_top);
+        uint64_t w = m_stack[ bn ];
+        assert((w>>63) == 0);  // top block contains no pointer
+        if (bn == block_nr(x)) {
+            uint64_t keep = w & bits::lo_set[block_pos(x)];
+            d += bits::cnt(w) - bits::cnt(keep);
+            m_stack[ bn ] = keep;
+            if (keep > 0) {
+                m_top = bn*63 + bits::hi(keep);
+                continue; // m_top < x now
+            }
+        } else {
+            d += bits::cnt(w);
+            m_stack[ bn ] = 0;
+        }
+        // block is empty now; continue in the block below
+        assert(bn > 0);
+        w = m_stack[ bn-1 ];
+        if ((w>>63) == 0) { // the block contains no pointer
+            assert(w>0);
+            m_top = (bn-1)*63 + bits::hi(w);
+        } else { // block contains a pointer
+            m_stack[bn-1] = 0;
+            m_top = w&0x7FFFFFFFFFFFFFFFULL;
+        }
+    }
+    if (0 == d) {
+        return 0;
+    }
+    // 2. remove the d topmost zero entries of the duplication stack
+    //    together with the duplication ones above them; the stack is
+    //    sorted, so all duplicates of the remaining top lie below
+    size_type cnt = m_cnt;
+    while (d > 0) {
+        size_type widx   = (cnt-1)>>6;
+        size_type hi_off = ((cnt-1)&0x3F)+1; // valid bits [0..hi_off)
+        uint64_t  w      = m_duplication_stack[widx];
+        size_type zeros  = hi_off - bits::cnt(w & bits::lo_set[hi_off]);
+        if (zeros >= d) {
+            // position of the d-th zero from the top
+            size_type p = bits::sel((~w) & bits::lo_set[hi_off], zeros-d+1);
+            m_duplication_stack[widx] = w & bits::lo_set[p];
+            cnt = (widx<<6) + p;
+            d = 0;
+        } else {
+            d -= zeros;
+            m_duplication_stack[widx] = 0;
+            cnt = widx<<6;
+        }
+    }
+    size_type popped = m_cnt - cnt;
+    m_cnt = cnt;
+    return popped;
+}
+
 inline sorted_multi_stack_support::size_type
 sorted_multi_stack_support::serialize(std::ostream& out,
                                       structure_tree_node* v, std::string name)const
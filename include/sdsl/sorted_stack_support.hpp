@@ -82,6 +82,27 @@ class sorted_stack_support
          */
         void push(size_type x);
 
+        /*! Push the run of indices a, a+1,...,b onto the stack.
+         *  \param a Smallest index of the run.
+         *  \param b Largest index of the run.
+         *  \pre top() < a, a <= b and b <= n
+         *
+         *  Equivalent to push(a); push(a+1);...; push(b), but the bits of
+         *  the run are set block-at-a-time in the bit-compressed
+         *  representation.
+         */
+        void push_run(size_type a, size_type b);
+
+        /*! Pop all indices which are greater or equal than x.
+         *  \param x The threshold index.
+         *  \return The number of popped indices.
+         *
+         *  Equivalent to the loop `while(!empty() and top()>=x) pop();`,
+         *  but the bits of the popped indices are cleared
+         *  block-at-a-time in the bit-compressed representation.
+         */
+        size_type pop_until(size_type x);
+
         /*! Returns the number of element is the stack.
          */
         size_type size()const {
@@ -145,6 +166,66 @@ inline void sorted_stack_support::pop()
     }
 }
 
+inline void sorted_stack_support::push_run(size_type a, size_type b)
+{
+    assert((empty() or top() < a) and a <= b and b <= m_n);
+    size_type x = a+1, y = b+1;
+    size_type bn = block_nr(x);
+    // only the block below the first index of the run can need a
+    // pointer; all later blocks of the run contain bits of the run
+    if (bn > 0 and m_stack[bn-1] == 0) {
+        m_stack[bn-1] = 0x8000000000000000ULL | m_top;
+    }
+    size_type bn_y = block_nr(y);
+    if (bn == bn_y) {
+        m_stack[bn] |= bits::lo_set[block_pos(y)+1] & ~bits::lo_set[block_pos(x)];
+    } else {
+        m_stack[bn] |= (0x7FFFFFFFFFFFFFFFULL << block_pos(x))
+                       & 0x7FFFFFFFFFFFFFFFULL;
+        for (size_type i=bn+1; i < bn_y; ++i) {
+            m_stack[i] = 0x7FFFFFFFFFFFFFFFULL;
+        }
+        m_stack[bn_y] |= bits::lo_set[block_pos(y)+1];
+    }
+    m_top = y;
+    m_cnt += b-a+1;
+}
+
+inline sorted_stack_support::size_type sorted_stack_support::pop_until(size_type x)
+{
+    x += 1;
+    size_type popped = 0;
+    while (m_top >= x) {
+        size_type bn = block_nr(m_top);
+        uint64_t w = m_stack[ bn ];
+        assert((w>>63) == 0);  // top block contains no pointer
+        if (bn == block_nr(x)) {
+            uint64_t keep = w & bits::lo_set[block_pos(x)];
+            popped += bits::cnt(w) - bits::cnt(keep);
+            m_stack[ bn ] = keep;
+            if (keep > 0) {
+                m_top = bn*63 + bits::hi(keep);
+                continue; // m_top < x now
+            }
+        } else {
+            popped += bits::cnt(w);
+            m_stack[ bn ] = 0;
+        }
+        // block is empty now; continue in the block below
+        assert(bn > 0);
+        w = m_stack[ bn-1 ];
+        if ((w>>63) == 0) { // the block contains no pointer
+            assert(w>0);
+            m_top = (bn-1)*63 + bits::hi(w);
+        } else { // block contains a pointer
+            m_stack[bn-1] = 0;
+            m_top = w&0x7FFFFFFFFFFFFFFFULL;
+        }
+    }
+    m_cnt -= popped;
+    return popped;
+}
+
 inline sorted_stack_support::size_type
 sorted_stack_support::serialize(std::ostream& out, structure_tree_node* v,
                                 std::string name)const
@@ -0,0 +1,270 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file sparse_sa.hpp
+    \brief sparse_sa.hpp contains a sparse suffix array index for
+           long-pattern search over a stored byte text.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_SPARSE_SA
+#define INCLUDED_SDSL_SPARSE_SA
+
+#include <algorithm>
+#include <vector>
+#include "int_vector.hpp"
+#include "int_vector_buffer.hpp"
+#include "config.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A sparse suffix array over every t_k-th text position.
+/*! \tparam t_k Sampling rate of the text positions.
+ *
+ *  The index keeps the text verbatim plus the lexicographically sorted
+ *  suffixes starting at positions divisible by t_k — a 1/t_k fraction
+ *  of a full suffix array, built by a single filter pass over a cached
+ *  suffix array (\sa construct_sa). A pattern of length \f$ m \geq t_k \f$
+ *  is located by binary searching its suffix \f$ P[j..m) \f$ for each
+ *  offset \f$ j < t_k \f$ and verifying the \f$ j \f$ skipped
+ *  characters against the text (seed-and-verify), so every occurrence
+ *  is found exactly once. For long-pattern workloads this replaces a
+ *  csa_wt where the FM-index machinery (rank on wavelet trees per
+ *  character) is wasted: queries are plain binary searches over the
+ *  text, and construction is a fraction of a CSA build.
+ *
+ *  Patterns shorter than t_k only report the occurrences starting
+ *  within \f$ [0..m) \f$ of a sampled position; use a CSA when short
+ *  patterns matter.
+ */
+template<uint8_t t_k = 8>
+class sparse_sa
+{
+    public:
+        static_assert(t_k > 0, "sparse_sa: sampling rate t_k must be positive");
+        typedef int_vector<>::size_type size_type;
+        typedef int_vector<8>           text_type;
+
+    private:
+        text_type    m_text; // text including the trailing sentinel
+        int_vector<> m_sa;   // sorted sampled suffix positions
+
+        //! Is the suffix starting at s lexicographically smaller than P[j..m)?
+        template<class t_pat_iter>
+        bool suf_less(size_type s, t_pat_iter begin, size_type j, size_type m) const
+        {
+            size_type i = 0;
+            while (j+i < m and s+i < m_text.size()) {
+                uint8_t c = m_text[s+i];
+                uint8_t p = (uint8_t)*(begin+j+i);
+                if (c != p) {
+                    return c < p;
+                }
+                ++i;
+            }
+            // a suffix which is a proper prefix of the pattern is smaller
+            return j+i < m;
+        }
+
+        //! Is P[j..m) lexicographically smaller than the suffix starting at s?
+        /*! A suffix with P[j..m) as prefix compares equal, so the
+         *  predicate delimits the upper end of the match range.
+         */
+        template<class t_pat_iter>
+        bool pat_less(size_type s, t_pat_iter begin, size_type j, size_type m) const
+        {
+            size_type i = 0;
+            while (j+i < m and s+i < m_text.size()) {
+                uint8_t c = m_text[s+i];
+                uint8_t p = (uint8_t)*(begin+j+i);
+                if (c != p) {
+                    return p < c;
+                }
+                ++i;
+            }
+            return false;
+        }
+
+    public:
+        const text_type& text = m_text;
+
+        //! Default constructor
+        sparse_sa() { }
+
+        sparse_sa(const sparse_sa& idx)
+        {
+            *this = idx;
+        }
+
+        sparse_sa(sparse_sa&& idx)
+        {
+            *this = std::move(idx);
+        }
+
+        sparse_sa& operator=(const sparse_sa& idx)
+        {
+            if (this != &idx) {
+                m_text = idx.m_text;
+                m_sa = idx.m_sa;
+            }
+            return *this;
+        }
+
+        sparse_sa& operator=(sparse_sa&& idx)
+        {
+            if (this != &idx) {
+                m_text = std::move(idx.m_text);
+                m_sa = std::move(idx.m_sa);
+            }
+            return *this;
+        }
+
+        //! Constructor from cached text and suffix array.
+        /*! \param config Cache configuration with the byte text
+         *                (conf::KEY_TEXT) and its suffix array
+         *                (conf::KEY_SA) present, e.g. produced by
+         *                construct_sa<8>.
+         */
+        sparse_sa(cache_config& config)
+        {
+            {
+                int_vector_buffer<8> text_buf(cache_file_name(conf::KEY_TEXT, config));
+                m_text = text_type(text_buf.size());
+                for (size_type i=0; i < m_text.size(); ++i) {
+                    m_text[i] = text_buf[i];
+                }
+            }
+            int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+            size_type n = m_text.size();
+            m_sa = int_vector<>((n + t_k - 1)/t_k, 0, bits::hi(n)+1);
+            size_type cnt = 0;
+            for (size_type i=0; i < sa_buf.size(); ++i) {
+                size_type s = sa_buf[i];
+                if (0 == (s % t_k)) { // filter pass keeps the SA order
+                    m_sa[cnt++] = s;
+                }
+            }
+        }
+
+        //! Length of the indexed text (including the trailing sentinel).
+        size_type size() const
+        {
+            return m_text.size();
+        }
+
+        //! Number of sampled suffixes.
+        size_type samples() const
+        {
+            return m_sa.size();
+        }
+
+        //! Locates all occurrences of the pattern [begin, end) in the text.
+        /*! \return The sorted starting positions of the occurrences.
+         *  \pre end-begin >= t_k for a complete answer.
+         *  \par Time complexity
+         *       \f$ \Order{t_k \cdot m \log(n/t_k) + occ} \f$
+         */
+        template<class t_pat_iter>
+        std::vector<size_type> locate(t_pat_iter begin, t_pat_iter end) const
+        {
+            size_type m = end - begin;
+            std::vector<size_type> res;
+            if (0 == m) {
+                return res;
+            }
+            for (size_type j=0; j < t_k and j < m; ++j) {
+                // match range of P[j..m) among the sampled suffixes
+                size_type lb = 0, rb = m_sa.size();
+                while (lb < rb) {
+                    size_type mid = lb + (rb-lb)/2;
+                    if (suf_less(m_sa[mid], begin, j, m)) {
+                        lb = mid+1;
+                    } else {
+                        rb = mid;
+                    }
+                }
+                size_type ub = lb, rb2 = m_sa.size();
+                while (ub < rb2) {
+                    size_type mid = ub + (rb2-ub)/2;
+                    if (pat_less(m_sa[mid], begin, j, m)) {
+                        rb2 = mid;
+                    } else {
+                        ub = mid+1;
+                    }
+                }
+                for (size_type idx=lb; idx < ub; ++idx) {
+                    size_type s = m_sa[idx];
+                    if (s < j) { // occurrence would start before the text
+                        continue;
+                    }
+                    size_type p = s - j;
+                    size_type i = 0; // verify the j skipped characters
+                    while (i < j and m_text[p+i] == (uint8_t)*(begin+i)) {
+                        ++i;
+                    }
+                    if (i == j) {
+                        res.push_back(p);
+                    }
+                }
+            }
+            std::sort(res.begin(), res.end());
+            return res;
+        }
+
+        //! Counts the occurrences of the pattern [begin, end) in the text.
+        /*! \pre end-begin >= t_k for a complete answer.
+         */
+        template<class t_pat_iter>
+        size_type count(t_pat_iter begin, t_pat_iter end) const
+        {
+            return locate(begin, end).size();
+        }
+
+        //! Swap method
+        void swap(sparse_sa& idx)
+        {
+            if (this != &idx) {
+                m_text.swap(idx.m_text);
+                m_sa.swap(idx.m_sa);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += m_text.serialize(out, child, "text");
+            written_bytes += m_sa.serialize(out, child, "sa");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            m_text.load(in);
+            m_sa.load(in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
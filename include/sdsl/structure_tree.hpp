@@ -11,6 +11,7 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <functional>
 #include "config.hpp"
 
 //! Namespace for the succinct data structure library
@@ -27,8 +28,15 @@ class structure_tree_node
         size_t              size = 0;
         std::string         name;
         std::string         type;
+        // byte range of the node in the serialized stream; only set when an
+        // offset source is installed during capture, see memory_layout()
+        size_t              stream_begin = 0;
+        size_t              stream_end = 0;
     public:
         structure_tree_node(const std::string& n, const std::string& t) : name(n) , type(t) {}
+        bool has_child(const std::string& n, const std::string& t) const {
+            return m_children.find(n+t) != m_children.end();
+        }
         structure_tree_node* add_child(const std::string& n, const std::string& t) {
             auto hash = n+t;
             auto child_itr = m_children.find(hash);
@@ -48,12 +56,33 @@ class structure_tree_node
 class structure_tree
 {
     public:
+        //! Optional source for the current stream position.
+        /*! When set (memory_layout() installs it for the duration of one
+         *  capture), every node additionally records the byte range
+         *  [stream_begin, stream_end) it occupies in the serialized stream.
+         */
+        static std::function<uint64_t()>& offset_source() {
+            static std::function<uint64_t()> source;
+            return source;
+        }
         static structure_tree_node* add_child(structure_tree_node* v, const std::string& name, const std::string& type) {
-            if (v) return v->add_child(name,type);
+            if (v) {
+                bool fresh = !v->has_child(name, type);
+                structure_tree_node* child = v->add_child(name,type);
+                if (fresh and offset_source()) {
+                    child->stream_begin = offset_source()();
+                }
+                return child;
+            }
             return nullptr;
         }
         static void add_size(structure_tree_node* v, uint64_t value) {
-            if (v) v->add_size(value);
+            if (v) {
+                v->add_size(value);
+                if (offset_source()) {
+                    v->stream_end = offset_source()();
+                }
+            }
         }
 };
 
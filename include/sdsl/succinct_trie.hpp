@@ -0,0 +1,379 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file succinct_trie.hpp
+    \brief succinct_trie.hpp contains a succinct path-compressed trie
+           for sorted string dictionaries.
+    \author Simon Gog
+
+    A term dictionary kept as a sorted string array costs a pointer
+    plus the full key per entry. succinct_trie stores the keys in a
+    path-compressed trie: the tree shape as a DFS balanced-parentheses
+    sequence with a bp_support, the edge labels concatenated in
+    preorder in an int_vector<8>, and the terminal nodes in a marked
+    bit vector. Keys get dense ids in lexicographic order, so a prefix
+    maps to one contiguous id interval — the tree is laid out in DFS
+    rather than the level order of louds_tree precisely because LOUDS
+    scatters a subtree's ids.
+*/
+#ifndef INCLUDED_SDSL_SUCCINCT_TRIE
+#define INCLUDED_SDSL_SUCCINCT_TRIE
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bp_support_sada.hpp"
+#include "int_vector.hpp"
+#include "rank_support_v.hpp"
+#include "select_support_mcl.hpp"
+#include "util.hpp"
+
+namespace sdsl
+{
+
+//! A succinct path-compressed trie over a sorted set of strings.
+/*! \tparam t_bp_support Balanced parentheses support for the DFS tree
+ *                       shape.
+ *
+ *  Keys are identified by their lexicographic rank: lookup() maps a
+ *  key to its id, extract() maps an id back to the key, and
+ *  prefix_range() maps a prefix to the half-open id interval of all
+ *  keys starting with it.
+ */
+template<class t_bp_support = bp_support_sada<>>
+class succinct_trie
+{
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef t_bp_support          bp_support_type;
+        static const size_type npos = (size_type)-1;
+
+    private:
+        size_type             m_keys = 0;
+        bit_vector            m_bp;        // DFS: 1 = enter node, 0 = leave
+        bp_support_type       m_bp_support;
+        int_vector<8>         m_labels;    // edge labels, preorder
+        int_vector<>          m_label_ptr; // label end offset per node
+        bit_vector            m_term;      // terminal flag per preorder nr
+        rank_support_v<>      m_term_rank;
+        select_support_mcl<>  m_term_select;
+
+        void copy(const succinct_trie& t)
+        {
+            m_keys       = t.m_keys;
+            m_bp         = t.m_bp;
+            m_bp_support = t.m_bp_support;
+            m_bp_support.set_vector(&m_bp);
+            m_labels     = t.m_labels;
+            m_label_ptr  = t.m_label_ptr;
+            m_term       = t.m_term;
+            m_term_rank  = t.m_term_rank;
+            m_term_rank.set_vector(&m_term);
+            m_term_select= t.m_term_select;
+            m_term_select.set_vector(&m_term);
+        }
+
+        //! Preorder number of the node whose '(' is at position v.
+        size_type nr(size_type v) const
+        {
+            return m_bp_support.rank(v)-1;
+        }
+
+        //! Descends along `s`; used by lookup (whole labels only) and
+        //! prefix_range (may stop inside a label).
+        /*! \return Position of the reached node's '(' or npos.
+         */
+        size_type descend(const std::string& s, bool whole_labels) const
+        {
+            size_type v = 0, d = 0;
+            while (d < s.size()) {
+                size_type child = v+1;
+                bool found = false;
+                while (child < m_bp.size() and m_bp[child]) {
+                    size_type cn = nr(child);
+                    size_type lb = m_label_ptr[cn], le = m_label_ptr[cn+1];
+                    uint8_t c = m_labels[lb];
+                    if (c == (uint8_t)s[d]) {
+                        size_type l = le-lb;
+                        if (whole_labels or s.size()-d >= l) {
+                            if (s.size()-d < l) {
+                                return npos;
+                            }
+                        } else {
+                            l = s.size()-d; // prefix ends inside the label
+                        }
+                        for (size_type k=1; k < l; ++k) {
+                            if (m_labels[lb+k] != (uint8_t)s[d+k]) {
+                                return npos;
+                            }
+                        }
+                        d += l;
+                        found = true;
+                        break;
+                    } else if (c > (uint8_t)s[d]) {
+                        return npos; // children are sorted by first char
+                    }
+                    child = m_bp_support.find_close(child)+1;
+                }
+                if (!found) {
+                    return npos;
+                }
+                v = child;
+            }
+            return v;
+        }
+
+    public:
+        //! Default constructor
+        succinct_trie() { }
+
+        //! Copy constructor
+        succinct_trie(const succinct_trie& t)
+        {
+            copy(t);
+        }
+
+        //! Move constructor
+        succinct_trie(succinct_trie&& t)
+        {
+            *this = std::move(t);
+        }
+
+        //! Constructor from a sorted sequence of distinct keys.
+        /*! \param keys The keys, lexicographically sorted and free of
+         *              duplicates; key i gets id i.
+         */
+        succinct_trie(const std::vector<std::string>& keys)
+        {
+            m_keys = keys.size();
+            std::vector<bool>      bp;
+            std::vector<uint8_t>   labels;
+            std::vector<size_type> label_end;
+            std::vector<bool>      term;
+            // DFS over the path-compressed trie of keys[b,e) which share
+            // a prefix of length d; the node's edge label is keys[b][lb,d)
+            std::function<void(size_type,size_type,size_type,size_type)> build =
+            [&](size_type b, size_type e, size_type d, size_type lb) {
+                bp.push_back(true);
+                for (size_type k=lb; k < d; ++k) {
+                    labels.push_back(keys[b][k]);
+                }
+                label_end.push_back(labels.size());
+                bool t = (keys[b].size() == d);
+                term.push_back(t);
+                size_type gb = b + t;
+                while (gb < e) { // group the rest by the char at depth d
+                    uint8_t c = keys[gb][d];
+                    size_type ge = gb+1;
+                    while (ge < e and (uint8_t)keys[ge][d] == c) {
+                        ++ge;
+                    }
+                    size_type l = d+1; // longest common extension of the group
+                    while (l < keys[gb].size() and l < keys[ge-1].size()
+                           and keys[gb][l] == keys[ge-1][l]) {
+                        ++l;
+                    }
+                    if (l < keys[gb].size() and gb+1 == ge) {
+                        l = keys[gb].size(); // single key: swallow the tail
+                    }
+                    build(gb, ge, l, d);
+                    gb = ge;
+                }
+                bp.push_back(false);
+            };
+            if (m_keys > 0) {
+                build(0, keys.size(), 0, 0);
+            } else {
+                bp = {true, false}; // empty dictionary: root only
+                label_end.push_back(0);
+                term.push_back(false);
+            }
+            m_bp = bit_vector(bp.size());
+            for (size_type i=0; i < bp.size(); ++i) {
+                m_bp[i] = bp[i];
+            }
+            util::init_support(m_bp_support, &m_bp);
+            m_labels = int_vector<8>(labels.size());
+            for (size_type i=0; i < labels.size(); ++i) {
+                m_labels[i] = labels[i];
+            }
+            m_label_ptr = int_vector<>(label_end.size()+1, 0, 64);
+            for (size_type i=0; i < label_end.size(); ++i) {
+                m_label_ptr[i+1] = label_end[i];
+            }
+            util::bit_compress(m_label_ptr);
+            m_term = bit_vector(term.size());
+            for (size_type i=0; i < term.size(); ++i) {
+                m_term[i] = term[i];
+            }
+            util::init_support(m_term_rank, &m_term);
+            util::init_support(m_term_select, &m_term);
+        }
+
+        //! Assignment operator
+        succinct_trie& operator=(const succinct_trie& t)
+        {
+            if (this != &t) {
+                copy(t);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        succinct_trie& operator=(succinct_trie&& t)
+        {
+            if (this != &t) {
+                m_keys       = t.m_keys;
+                m_bp         = std::move(t.m_bp);
+                m_bp_support = std::move(t.m_bp_support);
+                m_bp_support.set_vector(&m_bp);
+                m_labels     = std::move(t.m_labels);
+                m_label_ptr  = std::move(t.m_label_ptr);
+                m_term       = std::move(t.m_term);
+                m_term_rank  = std::move(t.m_term_rank);
+                m_term_rank.set_vector(&m_term);
+                m_term_select= std::move(t.m_term_select);
+                m_term_select.set_vector(&m_term);
+            }
+            return *this;
+        }
+
+        void swap(succinct_trie& t)
+        {
+            if (this != &t) {
+                std::swap(m_keys, t.m_keys);
+                m_bp.swap(t.m_bp);
+                util::swap_support(m_bp_support, t.m_bp_support,
+                                   &m_bp, &t.m_bp);
+                m_labels.swap(t.m_labels);
+                m_label_ptr.swap(t.m_label_ptr);
+                m_term.swap(t.m_term);
+                util::swap_support(m_term_rank, t.m_term_rank,
+                                   &m_term, &t.m_term);
+                util::swap_support(m_term_select, t.m_term_select,
+                                   &m_term, &t.m_term);
+            }
+        }
+
+        //! Number of keys in the dictionary.
+        size_type size() const
+        {
+            return m_keys;
+        }
+
+        //! Number of trie nodes.
+        size_type nodes() const
+        {
+            return m_bp.size()/2;
+        }
+
+        //! Returns the id of `key`, or npos if it is not present.
+        /*! Ids are dense and lexicographic: the i-th smallest key has
+         *  id i.
+         */
+        size_type lookup(const std::string& key) const
+        {
+            if (0 == m_keys) {
+                return npos;
+            }
+            size_type v = descend(key, true);
+            if (npos == v or !m_term[nr(v)]) {
+                return npos;
+            }
+            return m_term_rank(nr(v));
+        }
+
+        //! Half-open id interval [first, second) of keys starting with
+        //! `prefix`; empty interval if there is none.
+        std::pair<size_type,size_type>
+        prefix_range(const std::string& prefix) const
+        {
+            if (0 == m_keys) {
+                return {0, 0};
+            }
+            if (prefix.empty()) {
+                return {0, m_keys};
+            }
+            size_type v = descend(prefix, false);
+            if (npos == v) {
+                return {0, 0};
+            }
+            size_type lo = nr(v);
+            size_type hi = lo + (m_bp_support.find_close(v) - v + 1)/2;
+            return {m_term_rank(lo), m_term_rank(hi)};
+        }
+
+        //! Reconstructs the key with id `i`.
+        /*! \pre \f$ i < size() \f$
+         */
+        std::string extract(size_type i) const
+        {
+            size_type n = m_term_select(i+1);    // preorder nr
+            size_type v = m_bp_support.select(n+1);
+            std::string res;
+            while (v > 0) {
+                size_type cn = nr(v);
+                for (size_type k = m_label_ptr[cn+1]; k-- > m_label_ptr[cn];) {
+                    res.push_back((char)m_labels[k]);
+                }
+                v = m_bp_support.enclose(v);
+            }
+            std::reverse(res.begin(), res.end());
+            return res;
+        }
+
+        //! Serializes the trie to a stream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                            std::string name="") const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name,
+                                         util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_keys, out, child, "keys");
+            written_bytes += m_bp.serialize(out, child, "bp");
+            written_bytes += m_bp_support.serialize(out, child, "bp_support");
+            written_bytes += m_labels.serialize(out, child, "labels");
+            written_bytes += m_label_ptr.serialize(out, child, "label_ptr");
+            written_bytes += m_term.serialize(out, child, "term");
+            written_bytes += m_term_rank.serialize(out, child, "term_rank");
+            written_bytes += m_term_select.serialize(out, child, "term_select");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the trie from a stream.
+        void load(std::istream& in)
+        {
+            read_member(m_keys, in);
+            m_bp.load(in);
+            m_bp_support.load(in, &m_bp);
+            m_labels.load(in);
+            m_label_ptr.load(in);
+            m_term.load(in);
+            m_term_rank.load(in, &m_term);
+            m_term_select.load(in, &m_term);
+        }
+};
+
+template<class t_bp_support>
+const typename succinct_trie<t_bp_support>::size_type
+succinct_trie<t_bp_support>::npos;
+
+} // end namespace sdsl
+
+#endif // end file
@@ -22,7 +22,12 @@
 #define INCLUDED_SDSL_SUFFIX_ARRAY_ALGORITHM
 
 #include <iterator>
+#include <utility>
+#include <vector>
+#include "instrumentation.hpp"
+#include "scratch_pool.hpp"
 #include "suffix_array_helper.hpp"
+#include "type_registry.hpp"
 
 namespace sdsl
 {
@@ -233,11 +238,218 @@ backward_search(
         --it;
         backward_search(csa, l, r, (typename t_csa::char_type)*it, l, r);
     }
+    SDSL_RECORD_SAMPLE("backward_search_steps", std::distance(it, end));
     l_res = l;
     r_res = r;
     return r+1-l;
 }
 
+// prefetches the root-level bit vector word which the next rank_bwt
+// query at position `i` will touch; enabled for CSAs whose wavelet
+// tree exposes its bit vector (e.g. csa_wt over wt_pc shapes)
+template<class t_csa>
+auto _prefetch_rank_bwt(const t_csa& csa, typename t_csa::size_type i, int)
+-> decltype(csa.wavelet_tree.bv.data(), void())
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(csa.wavelet_tree.bv.data() + (i>>6));
+#else
+    (void)csa; (void)i;
+#endif
+}
+
+template<class t_csa>
+void _prefetch_rank_bwt(const t_csa&, typename t_csa::size_type, long) {}
+
+//! Backward search for a batch of patterns, advanced in lockstep.
+/*!
+ * \tparam t_csa      A CSA type.
+ * \tparam t_pat_iter Pattern iterator type.
+ *
+ * \param csa      The CSA object.
+ * \param patterns Vector of (begin, end) iterator pairs, one per pattern.
+ * \param l_res    Vector which is filled with the left interval borders.
+ * \param r_res    Vector which is filled with the right interval borders.
+ * \return Vector with the number of occurrences of each pattern.
+ *
+ * All patterns start on the full interval \f$[0..csa.size()-1]\f$ and are
+ * advanced one character per round. A single backward search is a chain
+ * of dependent rank queries and therefore memory latency bound;
+ * interleaving the independent chains of a batch keeps several cache
+ * misses in flight, and the bit vector words needed by the next round
+ * are software prefetched before the rank queries of the current round
+ * are issued.
+ *
+ * \par Time complexity
+ *       \f$ \Order{ \sum_i len_i \cdot t_{rank\_bwt} } \f$
+ */
+template<class t_csa, class t_pat_iter>
+std::vector<typename t_csa::size_type>
+backward_search_batch(
+    const t_csa& csa,
+    const std::vector<std::pair<t_pat_iter, t_pat_iter>>& patterns,
+    std::vector<typename t_csa::size_type>& l_res,
+    std::vector<typename t_csa::size_type>& r_res,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type k = patterns.size();
+    l_res.assign(k, 0);
+    r_res.assign(k, csa.size()-1);
+    scratch_vector<t_pat_iter> it;
+    scratch_vector<size_type>  active;
+    for (size_type i=0; i < k; ++i) {
+        it.push_back(patterns[i].second);
+        if (patterns[i].first != patterns[i].second) {
+            active.push_back(i);
+        }
+    }
+    while (!active.empty()) {
+        // issue the prefetches of the whole round before the first
+        // rank query, so that the K chains overlap
+        for (size_type j=0; j < active.size(); ++j) {
+            size_type i = active[j];
+            _prefetch_rank_bwt(csa, l_res[i], 0);
+            _prefetch_rank_bwt(csa, r_res[i]+1, 0);
+        }
+        size_type in = 0;
+        for (size_type j=0; j < active.size(); ++j) {
+            size_type i = active[j];
+            --it[i];
+            backward_search(csa, l_res[i], r_res[i],
+                            (typename t_csa::char_type)*it[i],
+                            l_res[i], r_res[i]);
+            if (patterns[i].first != it[i] and r_res[i]+1-l_res[i] > 0) {
+                active[in++] = i;
+            }
+        }
+        active.resize(in);
+    }
+    std::vector<size_type> occ(k);
+    for (size_type i=0; i < k; ++i) {
+        occ[i] = r_res[i]+1-l_res[i];
+    }
+    return occ;
+}
+
+//! Counts the occurrences of a batch of patterns in a CSA.
+/*!
+ * \tparam t_csa      CSA type.
+ * \tparam t_pat_iter Pattern iterator type.
+ *
+ * \param csa      The CSA object.
+ * \param patterns Vector of (begin, end) iterator pairs, one per pattern.
+ * \return Vector with the number of occurrences of each pattern.
+ *
+ * The patterns are matched in lockstep via backward_search_batch, which
+ * hides the rank query latency that makes single-pattern count()
+ * memory bound.
+ */
+template<class t_csa, class t_pat_iter>
+std::vector<typename t_csa::size_type>
+count_batch(
+    const t_csa& csa,
+    const std::vector<std::pair<t_pat_iter, t_pat_iter>>& patterns,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    std::vector<typename t_csa::size_type> l_res, r_res;
+    return backward_search_batch(csa, patterns, l_res, r_res);
+}
+
+// recursive work horse of count_batch_trie: [b..e) are the (sorted)
+// patterns whose last `depth` characters are equal, [l..r] is the
+// interval of that shared suffix
+template<class t_csa, class t_pat>
+void _count_batch_trie(
+    const t_csa& csa,
+    const std::vector<t_pat>& patterns,
+    const std::vector<typename t_csa::size_type>& idx,
+    typename t_csa::size_type b,
+    typename t_csa::size_type e,
+    typename t_csa::size_type depth,
+    typename t_csa::size_type l,
+    typename t_csa::size_type r,
+    std::vector<typename t_csa::size_type>& occ)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type k = b;
+    while (k < e and patterns[idx[k]].size() == depth) {
+        occ[idx[k]] = r+1-l; // pattern fully matched at this trie node
+        ++k;
+    }
+    while (k < e) { // one backward search step per distinct character
+        auto c = patterns[idx[k]][patterns[idx[k]].size()-1-depth];
+        size_type g = k+1;
+        while (g < e and
+               patterns[idx[g]][patterns[idx[g]].size()-1-depth] == c) {
+            ++g;
+        }
+        size_type l2 = 0, r2 = 0;
+        if (backward_search(csa, l, r,
+                            (typename t_csa::char_type)c, l2, r2) > 0) {
+            _count_batch_trie(csa, patterns, idx, k, g, depth+1, l2, r2, occ);
+        } // else: all patterns below this trie node keep occ = 0
+        k = g;
+    }
+}
+
+//! Counts the occurrences of a batch of patterns, sharing suffix work.
+/*!
+ * \tparam t_csa CSA type.
+ * \tparam t_pat Random access pattern type, e.g. std::string.
+ *
+ * \param csa      The CSA object.
+ * \param patterns The patterns.
+ * \return Vector with the number of occurrences of each pattern.
+ *
+ * Backward search consumes a pattern from its end, so patterns with a
+ * common suffix pass through identical LF steps. The batch is sorted
+ * by reversed pattern and matched along the implicit suffix-sharing
+ * trie of the batch: every trie edge costs exactly one backward search
+ * step and the interval at each trie node is shared by all patterns
+ * below it. Subtries whose interval becomes empty are pruned at once.
+ * Complements count_batch, which accelerates batches of unrelated
+ * patterns by overlapping their rank queries.
+ *
+ * \par Time complexity
+ *       One backward search step per distinct pattern suffix in the
+ *       batch, plus \f$ \Order{ \sum_i len_i \log k } \f$ for sorting.
+ */
+template<class t_csa, class t_pat>
+std::vector<typename t_csa::size_type>
+count_batch_trie(
+    const t_csa& csa,
+    const std::vector<t_pat>& patterns,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type k = patterns.size();
+    std::vector<size_type> occ(k, 0);
+    if (0 == csa.size()) {
+        return occ;
+    }
+    std::vector<size_type> idx(k);
+    for (size_type i=0; i < k; ++i) {
+        idx[i] = i;
+    }
+    std::sort(idx.begin(), idx.end(), [&patterns](size_type a, size_type b) {
+        const t_pat& pa = patterns[a];
+        const t_pat& pb = patterns[b];
+        size_type m = std::min(pa.size(), pb.size());
+        for (size_type t=1; t <= m; ++t) { // compare from the back
+            if (pa[pa.size()-t] != pb[pb.size()-t]) {
+                return pa[pa.size()-t] < pb[pb.size()-t];
+            }
+        }
+        return pa.size() < pb.size();
+    });
+    _count_batch_trie(csa, patterns, idx, 0, k, 0, 0, csa.size()-1, occ);
+    return occ;
+}
+
 //! Bidirectional search for a character c on an interval \f$[l_fwd..r_fwd]\f$ of the suffix array.
 /*!
  * \param csa_fwd   The CSA object of the forward text in which the backward_search should be done.
@@ -413,6 +625,376 @@ bidirectional_search_forward(
     return r_fwd+1-l_fwd;
 }
 
+//! Bidirectional search for all characters occurring on an interval.
+/*!
+ * The multi-character version of bidirectional_search: one wavelet tree
+ * descent (interval_symbols) enumerates every character c occurring in
+ * \f$ [l_fwd..r_fwd] \f$ together with its boundary ranks, and the
+ * resulting \f$ c\omega \f$-intervals in both CSAs are derived from
+ * prefix sums over the lexicographically sorted symbol counts. Use this
+ * instead of \f$ \sigma \f$ single-character calls when branching over
+ * all possible continuations, e.g. in approximate search.
+ *
+ * \param csa_fwd   The CSA object in which the prepended character is matched.
+ * \param l_fwd     Left border of the interval \f$ [l_fwd..r_fwd]\f$ in csa_fwd.
+ * \param r_fwd     Right border of the interval \f$ [l_fwd..r_fwd]\f$ in csa_fwd.
+ * \param l_bwd     Left border of the interval \f$ [l_bwd..r_bwd]\f$ in the other CSA.
+ * \param r_bwd     Right border of the interval \f$ [l_bwd..r_bwd]\f$ in the other CSA.
+ * \param cs        Vector for the occurring characters, ascending.
+ * \param l_fwd_res Vector for the resulting left borders in csa_fwd.
+ * \param r_fwd_res Vector for the resulting right borders in csa_fwd.
+ * \param l_bwd_res Vector for the resulting left borders in the other CSA.
+ * \param r_bwd_res Vector for the resulting right borders in the other CSA.
+ * \return The number of distinct characters in the interval.
+ * \pre \f$ 0 \leq l_fwd \leq r_fwd < csa_fwd.size() \f$
+ */
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+typename csa_wt<t_wt>::size_type bidirectional_search_all(
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_fwd,
+    typename csa_wt<>::size_type l_fwd,
+    typename csa_wt<>::size_type r_fwd,
+    typename csa_wt<>::size_type l_bwd,
+    SDSL_UNUSED typename csa_wt<>::size_type r_bwd,
+    std::vector<typename t_wt::value_type>& cs,
+    std::vector<typename csa_wt<>::size_type>& l_fwd_res,
+    std::vector<typename csa_wt<>::size_type>& r_fwd_res,
+    std::vector<typename csa_wt<>::size_type>& l_bwd_res,
+    std::vector<typename csa_wt<>::size_type>& r_bwd_res,
+    SDSL_UNUSED typename std::enable_if< t_wt::lex_ordered, csa_tag>::type x = csa_tag()
+)
+{
+    assert(l_fwd <= r_fwd); assert(r_fwd < csa_fwd.size());
+    typedef typename csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type size_type;
+    size_type quantity = 0;
+    cs.resize(csa_fwd.sigma);
+    std::vector<size_type> rank_c_i(csa_fwd.sigma), rank_c_j(csa_fwd.sigma);
+    csa_fwd.wavelet_tree.interval_symbols(l_fwd, r_fwd+1, quantity,
+                                          cs, rank_c_i, rank_c_j);
+    cs.resize(quantity);
+    l_fwd_res.resize(quantity); r_fwd_res.resize(quantity);
+    l_bwd_res.resize(quantity); r_bwd_res.resize(quantity);
+    size_type prefix = 0; // occurrences of lex smaller characters
+    for (size_type p=0; p < quantity; ++p) {
+        size_type cnt     = rank_c_j[p] - rank_c_i[p];
+        size_type c_begin = csa_fwd.C[csa_fwd.char2comp[cs[p]]];
+        l_fwd_res[p] = c_begin + rank_c_i[p];
+        r_fwd_res[p] = c_begin + rank_c_j[p] - 1;
+        l_bwd_res[p] = l_bwd + prefix;
+        r_bwd_res[p] = l_bwd + prefix + cnt - 1;
+        prefix += cnt;
+    }
+    return quantity;
+}
+
+// recursive work horse of approximate_search; extends the seed interval
+// first to the left over pattern positions [0..lpos], then to the right
+// over [rpos..m-1], branching over the characters present in the interval
+// while the error budget lasts
+template<class t_pat_iter, class t_csa_wt>
+void _approximate_search(
+    const t_csa_wt& csa_fwd,
+    const t_csa_wt& csa_bwd,
+    t_pat_iter begin,
+    typename t_csa_wt::size_type m,
+    typename t_csa_wt::size_type l_fwd,
+    typename t_csa_wt::size_type r_fwd,
+    typename t_csa_wt::size_type l_bwd,
+    typename t_csa_wt::size_type r_bwd,
+    int64_t lpos,
+    typename t_csa_wt::size_type rpos,
+    uint8_t err,
+    uint8_t k,
+    std::vector<std::pair<typename t_csa_wt::size_type,
+    typename t_csa_wt::size_type>>& occ)
+{
+    typedef typename t_csa_wt::size_type size_type;
+    typedef typename t_csa_wt::char_type char_type;
+    if (lpos < 0 and rpos == m) { // pattern consumed
+        occ.emplace_back(l_fwd, r_fwd);
+        return;
+    }
+    bool left = lpos >= 0;
+    char_type pc = (char_type)*(begin + (left ? (size_type)lpos : rpos));
+    if (err == k) { // budget used up: only the exact character continues
+        size_type lf, rf, lb, rb;
+        size_type matched;
+        if (left) {
+            matched = bidirectional_search(csa_fwd, l_fwd, r_fwd, l_bwd, r_bwd,
+                                           pc, lf, rf, lb, rb);
+        } else {
+            matched = bidirectional_search(csa_bwd, l_bwd, r_bwd, l_fwd, r_fwd,
+                                           pc, lb, rb, lf, rf);
+        }
+        if (matched > 0) {
+            _approximate_search(csa_fwd, csa_bwd, begin, m, lf, rf, lb, rb,
+                                left ? lpos-1 : lpos, left ? rpos : rpos+1,
+                                err, k, occ);
+        }
+        return;
+    }
+    std::vector<char_type> cs;
+    std::vector<size_type> lf, rf, lb, rb;
+    size_type quantity;
+    if (left) {
+        quantity = bidirectional_search_all(csa_fwd, l_fwd, r_fwd, l_bwd, r_bwd,
+                                            cs, lf, rf, lb, rb);
+    } else {
+        quantity = bidirectional_search_all(csa_bwd, l_bwd, r_bwd, l_fwd, r_fwd,
+                                            cs, lb, rb, lf, rf);
+    }
+    for (size_type p=0; p < quantity; ++p) {
+        if (0 == cs[p]) { // never match the sentinel
+            continue;
+        }
+        _approximate_search(csa_fwd, csa_bwd, begin, m,
+                            lf[p], rf[p], lb[p], rb[p],
+                            left ? lpos-1 : lpos, left ? rpos : rpos+1,
+                            err + (cs[p] != pc), k, occ);
+    }
+}
+
+//! Approximate search with up to k errors (substitutions).
+/*!
+ * \tparam t_pat_iter Pattern iterator type.
+ *
+ * \param csa_fwd CSA of the forward text (wavelet tree based, lex ordered).
+ * \param csa_bwd CSA of the reversed text.
+ * \param begin   Iterator to the begin of the pattern (inclusive).
+ * \param end     Iterator to the end of the pattern (exclusive).
+ * \param k       Maximal number of mismatches.
+ * \param occ     Deduplicated suffix array intervals in csa_fwd, one per
+ *                distinct matched string; positions follow via csa_fwd[i].
+ * \return The total number of occurrences with Hamming distance \f$\leq k\f$.
+ *
+ * The pattern is split into k+1 pieces; a match with at most k errors
+ * contains at least one piece exactly (pigeonhole), so each piece is
+ * matched exactly and extended bidirectionally over the rest of the
+ * pattern, branching only over the characters actually present in the
+ * current interval — one shared wavelet tree descent per step
+ * (\sa bidirectional_search_all) instead of \f$ \sigma \f$ speculative
+ * backward_search calls. Intervals reachable through several seeds are
+ * deduplicated before reporting.
+ */
+template<class t_pat_iter, class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+typename csa_wt<t_wt>::size_type approximate_search(
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_fwd,
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa_bwd,
+    t_pat_iter begin,
+    t_pat_iter end,
+    uint8_t k,
+    std::vector<std::pair<typename csa_wt<>::size_type,
+    typename csa_wt<>::size_type>>& occ,
+    SDSL_UNUSED typename std::enable_if< t_wt::lex_ordered, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::size_type size_type;
+    occ.clear();
+    size_type m = end - begin;
+    if (0 == m) {
+        return 0;
+    }
+    if (k >= m) { // no piece is guaranteed exact; extend from scratch
+        _approximate_search(csa_fwd, csa_bwd, begin, m,
+                            (size_type)0, csa_fwd.size()-1,
+                            (size_type)0, csa_bwd.size()-1,
+                            (int64_t)-1, (size_type)0, (uint8_t)0, k, occ);
+    }
+    size_type pieces = k >= m ? 0 : (size_type)k+1;
+    for (size_type i=0; i < pieces; ++i) {
+        size_type sb = (i*m)/pieces, se = ((i+1)*m)/pieces;
+        size_type l_fwd = 0, r_fwd = csa_fwd.size()-1;
+        size_type l_bwd = 0, r_bwd = csa_bwd.size()-1;
+        if (0 == bidirectional_search_forward(csa_fwd, csa_bwd,
+                                              l_fwd, r_fwd, l_bwd, r_bwd,
+                                              begin+sb, begin+se,
+                                              l_fwd, r_fwd, l_bwd, r_bwd)) {
+            continue; // the exact piece does not occur
+        }
+        _approximate_search(csa_fwd, csa_bwd, begin, m,
+                            l_fwd, r_fwd, l_bwd, r_bwd,
+                            (int64_t)sb - 1, se, (uint8_t)0, k, occ);
+    }
+    std::sort(occ.begin(), occ.end());
+    occ.erase(std::unique(occ.begin(), occ.end()), occ.end());
+    size_type res = 0;
+    for (const auto& iv : occ) {
+        res += iv.second - iv.first + 1;
+    }
+    return res;
+}
+
+//! Computes the matching statistics of a query against a csa_wt.
+/*!
+ * \tparam t_pat_iter Pattern iterator type.
+ * \tparam t_rac_iter Random access iterator type for the output.
+ *
+ * \param csa   The csa_wt of the text.
+ * \param begin Iterator to the begin of the query (inclusive).
+ * \param end   Iterator to the end of the query (exclusive).
+ * \param out   Random access iterator to the output; out[i] is set to
+ *              the length of the longest prefix of query[i..m-1] which
+ *              occurs in the text.
+ *
+ * LCP-free streaming computation: the query is processed from right to
+ *  left and the current match is extended by prepending characters.
+ *  Instead of a suffix array interval only one row p of the CSA whose
+ *  suffix starts with the current match is maintained. If
+ *  \f$ BWT[p] = c \f$ the match extends by one LF step (one wavelet
+ *  tree descent via inverse_select yields character and rank at once).
+ *  Otherwise the lexicographically nearest rows with \f$ BWT = c \f$
+ *  above and below p take the role of the suffix tree parent shortcut:
+ *  the match shrinks to the longer of the two common prefixes with
+ *  those rows (measured by stepping along \f$ \Psi \f$) and continues
+ *  from there, so no LCP array is needed.
+ *
+ * \par Time complexity
+ *      \f$ \Order{ (m + s) \log\sigma } \f$ where \f$ s \f$ is the
+ *      total length of the comparisons at the mismatches; each
+ *      comparison is bounded by the current matching statistics value.
+ */
+template<class t_pat_iter, class t_rac_iter, class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+void matching_statistics(
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa,
+    t_pat_iter begin,
+    t_pat_iter end,
+    t_rac_iter out
+)
+{
+    typedef csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat> t_csa;
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::char_type char_type;
+    size_type m = end - begin;
+    if (0 == m or 0 == csa.size()) {
+        for (size_type i=0; i < m; ++i) {
+            out[i] = 0;
+        }
+        return;
+    }
+    // length of the common prefix of the suffix in row j and
+    // query[i..i+len-1], determined by stepping along Psi
+    auto match_len = [&](size_type j, size_type i, size_type len) {
+        size_type res = 0;
+        while (res < len and csa.F[j] == (char_type)*(begin+i+res)) {
+            ++res;
+            j = csa.psi[j];
+        }
+        return res;
+    };
+    size_type p   = 0; // row whose suffix starts with the current match
+    size_type len = 0; // length of the current match
+    for (size_type i = m; i-- > 0;) {
+        char_type c = (char_type)*(begin+i);
+        auto rc = csa.wavelet_tree.inverse_select(p);
+        if (rc.second == c) { // extend the match by one LF step
+            p = csa.C[csa.char2comp[c]] + rc.first;
+            ++len;
+        } else {
+            size_type occ_b = csa.wavelet_tree.rank(p, c);
+            size_type occ   = csa.wavelet_tree.rank(csa.size(), c);
+            if (0 == occ) { // c does not occur in the text
+                p = 0; len = 0;
+            } else {
+                size_type best_lcp = 0, best_lf = 0;
+                if (occ_b > 0) { // nearest row above with BWT = c
+                    size_type q = csa.wavelet_tree.select(occ_b, c);
+                    best_lcp = match_len(q, i+1, len);
+                    best_lf  = csa.C[csa.char2comp[c]] + occ_b - 1;
+                }
+                if (occ_b < occ) { // nearest row below with BWT = c
+                    size_type q   = csa.wavelet_tree.select(occ_b+1, c);
+                    size_type lcp = match_len(q, i+1, len);
+                    if (occ_b == 0 or lcp > best_lcp) {
+                        best_lcp = lcp;
+                        best_lf  = csa.C[csa.char2comp[c]] + occ_b;
+                    }
+                }
+                p   = best_lf;
+                len = best_lcp + 1;
+            }
+        }
+        out[i] = len;
+    }
+}
+
+//! Enumerates all distinct q-grams of the text with their counts.
+/*!
+ * \tparam t_report Functor type for the reported q-grams.
+ *
+ * \param csa    The csa_wt of the text.
+ * \param q      The q-gram length.
+ * \param report Functor called as report(gram, cnt) for every distinct
+ *               length-q substring of the text, where gram is a
+ *               std::vector<char_type> of length q spelling the q-gram
+ *               and cnt its number of occurrences. The buffer is reused
+ *               between calls; copy it if it must outlive the callback.
+ * \return The number of distinct q-grams.
+ *
+ * Depth-first interval splitting over the wavelet tree: one
+ * interval_symbols call per enumerated suffix array interval yields
+ * all characters extending the current (suffix of a) q-gram, and the
+ * corresponding sub-intervals are derived from the returned boundary
+ * ranks - no per-gram backward search from scratch. The traversal
+ * state lives in one explicit stack and a fixed set of scratch
+ * vectors, so no allocation happens per visited interval. Because the
+ * splitting prepends characters, the q-grams are enumerated in
+ * lexicographic order of their reversals; the gram buffer itself is
+ * spelled in text order. Intervals containing only the sentinel are
+ * pruned. The work is trivially partitioned by the entries pushed for
+ * the top-level symbols if a caller wants to process subtrees in
+ * parallel.
+ *
+ * \par Time complexity
+ *       \f$ \Order{ z \log\sigma } \f$ where z is the number of
+ *       distinct substrings of length at most q.
+ */
+template<class t_report, class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+typename csa_wt<t_wt>::size_type
+qgram_profile(
+    const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa,
+    typename csa_wt<>::size_type q,
+    t_report&& report
+)
+{
+    typedef csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat> t_csa;
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_wt::value_type char_type;
+    size_type found = 0;
+    if (0 == q or 0 == csa.size()) {
+        return found;
+    }
+    std::vector<char_type> gram(q);
+    struct frame_type { size_type l, r, depth; char_type c; };
+    std::vector<frame_type> stack; // explicit DFS stack
+    std::vector<char_type> cs(csa.sigma); // scratch for interval_symbols
+    std::vector<size_type> rank_c_i(csa.sigma), rank_c_j(csa.sigma);
+    stack.push_back({0, csa.size()-1, 0, 0});
+    while (!stack.empty()) {
+        frame_type f = stack.back();
+        stack.pop_back();
+        if (f.depth > 0) {
+            gram[q-f.depth] = f.c;
+            if (f.depth == q) {
+                report(gram, f.r-f.l+1);
+                ++found;
+                continue;
+            }
+        }
+        size_type quantity = 0;
+        csa.wavelet_tree.interval_symbols(f.l, f.r+1, quantity,
+                                          cs, rank_c_i, rank_c_j);
+        for (size_type p=0; p < quantity; ++p) {
+            if (0 == cs[p]) { // prune the sentinel
+                continue;
+            }
+            size_type c_begin = csa.C[csa.char2comp[cs[p]]];
+            stack.push_back({c_begin + rank_c_i[p],
+                             c_begin + rank_c_j[p] - 1,
+                             f.depth+1, cs[p]});
+        }
+    }
+    return found;
+}
+
 //! Counts the number of occurrences of a pattern in a CSA.
 /*!
  * \tparam t_csa      CSA type.
@@ -434,6 +1016,7 @@ typename t_csa::size_type count(
     csa_tag
 )
 {
+    SDSL_RECORD_TYPE_QUERY(csa);
     if (end - begin > (typename std::iterator_traits<t_pat_iter>::difference_type)csa.size())
         return 0;
     typename t_csa::size_type t=0; // dummy variable for the backward_search call
@@ -499,6 +1082,151 @@ auto lex_interval(
 }
 
 
+//! Reports the suffix array values SA[lb..rb] with interleaved sample walks.
+/*!
+ * \tparam t_csa CSA type.
+ * \tparam t_rac Resizeable random access container.
+ *
+ * \param csa The CSA object.
+ * \param lb  Left border of the SA interval (inclusive).
+ * \param rb  Right border of the SA interval (inclusive).
+ * \param occ Container which is resized and filled with SA[lb..rb].
+ *
+ * Resolving one occurrence walks LF (resp. \f$\Psi\f$) until a sampled
+ * position is hit, which is a chain of dependent queries and therefore
+ * memory latency bound. This bulk variant keeps a window of occurrence
+ * walks in flight and advances them round-robin, so the dependent-miss
+ * chains of different occurrences overlap; for LF based CSAs the words
+ * needed by the next step are software prefetched as soon as its
+ * position is known.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ (rb-lb+1) \cdot s_{SA} \cdot t_{LF} } \f$, where
+ *        \f$s_{SA}\f$ is the SA sampling density.
+ */
+template<class t_csa, class t_rac>
+void locate(
+    const t_csa& csa,
+    typename t_csa::size_type lb,
+    typename t_csa::size_type rb,
+    t_rac& occ,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    SDSL_RECORD_TYPE_QUERY(csa);
+    typename t_csa::extract_category extract_tag;
+    locate(csa, lb, rb, occ, extract_tag);
+}
+
+//! Specialization of the bulk locate for LF-function based CSAs
+template<class t_csa, class t_rac>
+void locate(
+    const t_csa& csa,
+    typename t_csa::size_type lb,
+    typename t_csa::size_type rb,
+    t_rac& occ,
+    lf_tag
+)
+{
+    typedef typename t_csa::size_type size_type;
+    if (lb > rb) {
+        occ.resize(0);
+        return;
+    }
+    size_type z = rb+1-lb;
+    occ.resize(z);
+    const size_type window = 32; // number of walks kept in flight
+    size_type cur[window];  // current position of each walk
+    size_type off[window];  // number of LF steps taken so far
+    size_type slot[window]; // output slot of each walk
+    size_type next   = 0;   // next occurrence to start a walk for
+    size_type active = std::min(z, window);
+    for (size_type k=0; k < active; ++k, ++next) {
+        cur[k]  = lb+next;
+        off[k]  = 0;
+        slot[k] = next;
+    }
+    while (active > 0) {
+        for (size_type k=0; k < active;) {
+            size_type i = cur[k];
+            if (csa.sa_sample.is_sampled(i)) {
+                size_type result = csa.sa_sample[i] + off[k];
+                occ[slot[k]] = result < csa.size() ? result
+                               : result - csa.size();
+                if (next < z) { // refill the window slot
+                    cur[k]  = lb+next;
+                    off[k]  = 0;
+                    slot[k] = next++;
+                } else {
+                    --active;
+                    cur[k]  = cur[active];
+                    off[k]  = off[active];
+                    slot[k] = slot[active];
+                }
+            } else {
+                cur[k] = csa.lf[i];
+                ++off[k];
+                _prefetch_rank_bwt(csa, cur[k], 0);
+                ++k;
+            }
+        }
+    }
+}
+
+//! Specialization of the bulk locate for \f$\Psi\f$-function based CSAs
+template<class t_csa, class t_rac>
+void locate(
+    const t_csa& csa,
+    typename t_csa::size_type lb,
+    typename t_csa::size_type rb,
+    t_rac& occ,
+    psi_tag
+)
+{
+    typedef typename t_csa::size_type size_type;
+    if (lb > rb) {
+        occ.resize(0);
+        return;
+    }
+    size_type z = rb+1-lb;
+    occ.resize(z);
+    const size_type window = 32; // number of walks kept in flight
+    size_type cur[window];  // current position of each walk
+    size_type off[window];  // number of Psi steps taken so far
+    size_type slot[window]; // output slot of each walk
+    size_type next   = 0;   // next occurrence to start a walk for
+    size_type active = std::min(z, window);
+    for (size_type k=0; k < active; ++k, ++next) {
+        cur[k]  = lb+next;
+        off[k]  = 0;
+        slot[k] = next;
+    }
+    while (active > 0) {
+        for (size_type k=0; k < active;) {
+            size_type i = cur[k];
+            if (csa.sa_sample.is_sampled(i)) {
+                size_type result = csa.sa_sample[i];
+                occ[slot[k]] = result < off[k] ? csa.size()-(off[k]-result)
+                               : result - off[k];
+                if (next < z) { // refill the window slot
+                    cur[k]  = lb+next;
+                    off[k]  = 0;
+                    slot[k] = next++;
+                } else {
+                    --active;
+                    cur[k]  = cur[active];
+                    off[k]  = off[active];
+                    slot[k] = slot[active];
+                }
+            } else {
+                cur[k] = csa.psi[i];
+                ++off[k];
+                ++k;
+            }
+        }
+    }
+}
+
 //! Calculates all occurrences of a pattern pat in a CSA.
 /*!
  * \tparam t_csa      CSA type.
@@ -525,8 +1253,8 @@ t_rac locate(
     typename t_csa::size_type occ_begin, occ_end, occs;
     occs = backward_search(csa, 0, csa.size()-1, begin, end, occ_begin, occ_end);
     t_rac occ(occs);
-    for (typename t_csa::size_type i=0; i < occs; ++i) {
-        occ[i] = csa[occ_begin+i];
+    if (occs > 0) {
+        locate(csa, occ_begin, occ_end, occ);
     }
     return occ;
 }
@@ -578,6 +1306,7 @@ typename t_csa::size_type extract(
     SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
 )
 {
+    SDSL_RECORD_TYPE_QUERY(csa);
     typename t_csa::extract_category extract_tag;
     return extract(csa, begin, end, text, extract_tag);
 }
@@ -658,6 +1387,119 @@ typename t_csa::string_type extract(
     return result;
 }
 
+//! Reconstructs several substrings of the original text with interleaved walks.
+/*!
+ * \tparam t_csa CSA type.
+ *
+ * \param csa    The CSA object.
+ * \param ranges Vector of (begin, end) position pairs; both inclusive.
+ * \return A vector holding the extracted substrings, one per range.
+ * \pre For each range \f$begin <= end\f$ and \f$ end < csa.size() \f$
+ *
+ * Reconstructing one snippet is a chain of dependent wavelet tree
+ * queries (one per character) and therefore memory latency bound.
+ * This bulk variant advances the character walks of all snippets
+ * round-robin, so the dependent-miss chains of different snippets
+ * overlap; for LF based CSAs the words needed by the next step are
+ * software prefetched as soon as its position is known.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ \sum_i (end_i-begin_i+1) \cdot t_{\Psi} + t_{SA^{-1}} } \f$
+ */
+template<class t_csa>
+std::vector<typename t_csa::string_type> extract_batch(
+    const t_csa& csa,
+    const std::vector<std::pair<typename t_csa::size_type, typename t_csa::size_type>>& ranges,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typename t_csa::extract_category extract_tag;
+    return extract_batch(csa, ranges, extract_tag);
+}
+
+//! Specialization of the bulk extract for LF-function based CSAs
+template<class t_csa>
+std::vector<typename t_csa::string_type> extract_batch(
+    const t_csa& csa,
+    const std::vector<std::pair<typename t_csa::size_type, typename t_csa::size_type>>& ranges,
+    lf_tag
+)
+{
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::string_type string_type;
+    std::vector<string_type> result(ranges.size());
+    std::vector<size_type> order(ranges.size());
+    std::vector<size_type> steps(ranges.size());
+    std::vector<size_type> active;
+    for (size_type i=0; i < ranges.size(); ++i) {
+        assert(ranges[i].second < csa.size());
+        assert(ranges[i].first <= ranges[i].second);
+        size_type len = ranges[i].second-ranges[i].first+1;
+        result[i] = string_type(len, (typename string_type::value_type)0);
+        order[i]  = csa.isa[ranges[i].second];
+        result[i][len-1] = first_row_symbol(order[i], csa);
+        steps[i] = len-1;  // characters decoded right to left
+        if (steps[i] > 0) {
+            active.push_back(i);
+        }
+    }
+    while (!active.empty()) {
+        for (size_type k=0; k < active.size(); ++k) {
+            _prefetch_rank_bwt(csa, order[active[k]], 0);
+        }
+        size_type in = 0;
+        for (size_type k=0; k < active.size(); ++k) {
+            size_type i  = active[k];
+            auto rc      = csa.wavelet_tree.inverse_select(order[i]);
+            auto c       = rc.second;
+            order[i]     = csa.C[ csa.char2comp[c] ] + rc.first;
+            result[i][--steps[i]] = c;
+            if (steps[i] > 0) {
+                active[in++] = i;
+            }
+        }
+        active.resize(in);
+    }
+    return result;
+}
+
+//! Specialization of the bulk extract for \f$\Psi\f$-function based CSAs
+template<class t_csa>
+std::vector<typename t_csa::string_type> extract_batch(
+    const t_csa& csa,
+    const std::vector<std::pair<typename t_csa::size_type, typename t_csa::size_type>>& ranges,
+    psi_tag
+)
+{
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::string_type string_type;
+    std::vector<string_type> result(ranges.size());
+    std::vector<size_type> order(ranges.size());
+    std::vector<size_type> pos(ranges.size());
+    std::vector<size_type> active;
+    for (size_type i=0; i < ranges.size(); ++i) {
+        assert(ranges[i].second < csa.size());
+        assert(ranges[i].first <= ranges[i].second);
+        size_type len = ranges[i].second-ranges[i].first+1;
+        result[i] = string_type(len, (typename string_type::value_type)0);
+        order[i]  = csa.isa[ranges[i].first];
+        pos[i]    = 0;  // characters decoded left to right
+        active.push_back(i);
+    }
+    while (!active.empty()) {
+        size_type in = 0;
+        for (size_type k=0; k < active.size(); ++k) {
+            size_type i = active[k];
+            result[i][pos[i]] = first_row_symbol(order[i], csa);
+            if (++pos[i] < result[i].size()) {
+                order[i] = csa.psi[order[i]];
+                active[in++] = i;
+            }
+        }
+        active.resize(in);
+    }
+    return result;
+}
 
 } // end namespace
 #endif
@@ -31,6 +31,13 @@
 #include "wavelet_trees.hpp"
 #include "construct.hpp"
 #include "suffix_array_algorithm.hpp"
+#include "query_stepper.hpp"
+#include "sharded_csa.hpp"
+#include "csa_merge.hpp"
+#include "r_index.hpp"
+#include "sparse_sa.hpp"
+#include "lz77_factorize.hpp"
+#include "bidirectional_index.hpp"
 
 namespace sdsl
 {
@@ -155,6 +155,118 @@ t_rac locate(
     return locate(cst.csa, begin, end);
 }
 
+//! Computes the matching statistics of a query against the text of a CST.
+/*!
+ * \tparam t_cst      CST type.
+ * \tparam t_pat_iter Query iterator type.
+ *
+ * \param cst   The CST object.
+ * \param begin Iterator to the begin of the query (inclusive).
+ * \param end   Iterator to the end of the query (exclusive).
+ * \return A vector ms of length of the query, where ms[i] is the length
+ *         of the longest prefix of query[i..] which occurs in the text.
+ *
+ * The query is streamed once: each position is extended via
+ * forward_search as far as possible, then the state is shifted to the
+ * next position with one suffix link operation, so the already matched
+ * suffix is reused instead of being rematched.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ m \cdot (t_{\Psi} + t_{cst.child} + t_{cst.sl} + t_{cst.parent}) } \f$,
+ *        where \f$m\f$ is the length of the query; the total number of
+ *        forward_search, sl and parent steps is amortized \f$\Order{m}\f$.
+ */
+template<class t_cst, class t_pat_iter>
+int_vector<64> matching_statistics(
+    const t_cst& cst,
+    t_pat_iter begin,
+    t_pat_iter end,
+    SDSL_UNUSED typename std::enable_if<std::is_same<cst_tag, typename t_cst::index_category>::value, cst_tag>::type x = cst_tag()
+)
+{
+    typedef typename t_cst::size_type size_type;
+    size_type m = end-begin;
+    int_vector<64> ms(m, 0);
+    auto v = cst.root();       // explicit node at or below the matched state
+    size_type d = 0;           // length of the matched string
+    size_type char_pos = 0;    // CSA position of the last matched character
+    for (size_type i=0; i < m; ++i) {
+        while (i+d < m) {
+            // try the extension on a copy; forward_search clobbers its
+            // arguments if the extension fails
+            auto u = v;
+            size_type cp = char_pos;
+            if (0 == forward_search(cst, u, d,
+                                    (typename t_cst::char_type)*(begin+i+d), cp)) {
+                break;
+            }
+            v = u;
+            char_pos = cp;
+            ++d;
+        }
+        ms[i] = d;
+        if (d > 0) {
+            // drop the first character of the match via the suffix link;
+            // char_pos stays valid since the last matched character is kept
+            v = cst.sl(v);
+            --d;
+            if (0 == d) {
+                v = cst.root();
+                char_pos = 0;
+            } else {
+                // canonicalize: v has to be the highest node below the
+                // matched state, otherwise forward_search would follow
+                // the edge of v instead of branching
+                auto p = cst.parent(v);
+                while (v != cst.root() and cst.depth(p) >= d) {
+                    v = p;
+                    p = cst.parent(v);
+                }
+            }
+        }
+    }
+    return ms;
+}
+
+//! Computes all maximal exact matches of a query in the text of a CST.
+/*!
+ * \tparam t_cst      CST type.
+ * \tparam t_pat_iter Query iterator type.
+ *
+ * \param cst     The CST object.
+ * \param begin   Iterator to the begin of the query (inclusive).
+ * \param end     Iterator to the end of the query (exclusive).
+ * \param min_len Minimal length of a reported match.
+ * \return A vector of (query position, length) pairs, one for each match
+ *         which occurs in the text and can be extended in neither
+ *         direction within the query; ordered by query position.
+ *
+ * \par Time complexity
+ *        Same as matching_statistics.
+ */
+template<class t_cst, class t_pat_iter>
+std::vector<std::pair<typename t_cst::size_type, typename t_cst::size_type>>
+maximal_exact_matches(
+    const t_cst& cst,
+    t_pat_iter begin,
+    t_pat_iter end,
+    typename t_cst::size_type min_len = 1,
+    SDSL_UNUSED typename std::enable_if<std::is_same<cst_tag, typename t_cst::index_category>::value, cst_tag>::type x = cst_tag()
+)
+{
+    typedef typename t_cst::size_type size_type;
+    auto ms = matching_statistics(cst, begin, end);
+    std::vector<std::pair<size_type, size_type>> mems;
+    for (size_type i=0; i < ms.size(); ++i) {
+        // a match is left-maximal iff it is not covered by the match
+        // one position earlier, i.e. iff ms[i-1] < ms[i]+1
+        if (ms[i] >= min_len and (0 == i or ms[i-1] <= ms[i])) {
+            mems.emplace_back(i, ms[i]);
+        }
+    }
+    return mems;
+}
+
 //! Calculate the concatenation of edge labels from the root to the node v of a CST.
 /*!
  * \tparam t_cst       CST type.
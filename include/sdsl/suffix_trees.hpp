@@ -36,5 +36,9 @@
 #include "cst_sct3.hpp"
 #include "cst_sada.hpp"
 #include "cst_fully.hpp"
+#include "cst_child_cache.hpp"
+#include "cst_parallel.hpp"
+#include "lazy_cst.hpp"
+#include "lcp_interval_tree.hpp"
 
 #endif
@@ -0,0 +1,352 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file topk_completion.hpp
+    \brief topk_completion.hpp contains a succinct weighted top-k
+           string completion index.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_TOPK_COMPLETION
+#define INCLUDED_SDSL_TOPK_COMPLETION
+
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "int_vector.hpp"
+#include "bp_support_sada.hpp"
+#include "rank_support_v.hpp"
+#include "select_support_mcl.hpp"
+#include "rmq_support.hpp"
+#include "util.hpp"
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A succinct index for weighted top-k string completion.
+/*! The index stores a set of scored strings and reports, for a query
+ *  prefix, the k highest-scored strings starting with it. The strings
+ *  form a succinct trie (balanced parentheses of the DFS traversal,
+ *  one label per node, one leaf mark per node); since the DFS visits
+ *  the leaves in lexicographic order, the strings with a common
+ *  prefix are a contiguous leaf interval, and the top-k scores of an
+ *  interval are extracted with a range maximum structure over the
+ *  leaf scores - no candidate set is materialized, the interval is
+ *  split around each reported maximum and re-queried lazily.
+ *
+ *  \tparam t_bp_support Support type for the parentheses sequence.
+ *  \tparam t_rmq        Range maximum structure over the scores.
+ *
+ *  \par Time complexity
+ *       \f$ \Order{|p| \cdot \sigma} \f$ to locate the prefix and
+ *       \f$ \Order{\log k} \f$ per reported completion plus its length.
+ */
+template<class t_bp_support = bp_support_sada<>,
+         class t_rmq        = rmq_succinct_sct<false>>
+class topk_completion
+{
+    public:
+        typedef int_vector<>::size_type              size_type;
+        typedef std::pair<std::string, uint64_t>     entry_type;
+        typedef t_bp_support                         bp_support_type;
+        typedef t_rmq                                rmq_type;
+    private:
+        bit_vector            m_bp;          // BP of the trie DFS
+        bp_support_type       m_bp_support;  // support for m_bp
+        int_vector<8>         m_label;       // edge label per node in DFS order
+        bit_vector            m_leaf;        // leaf mark per node in DFS order
+        rank_support_v<1>     m_leaf_rank;   // rank support for m_leaf
+        select_support_mcl<1> m_leaf_select; // select support for m_leaf
+        int_vector<>          m_weight;      // score per string in lex order
+        rmq_type              m_rmq;         // range maximum over m_weight
+
+        void copy(const topk_completion& tc)
+        {
+            m_bp         = tc.m_bp;
+            m_bp_support = tc.m_bp_support;
+            m_bp_support.set_vector(&m_bp);
+            m_label      = tc.m_label;
+            m_leaf       = tc.m_leaf;
+            m_leaf_rank  = tc.m_leaf_rank;
+            m_leaf_rank.set_vector(&m_leaf);
+            m_leaf_select = tc.m_leaf_select;
+            m_leaf_select.set_vector(&m_leaf);
+            m_weight     = tc.m_weight;
+            m_rmq        = tc.m_rmq;
+        }
+
+        //! Returns the open position of the child of node v with label c,
+        //! or m_bp.size() if no such child exists.
+        size_type child(size_type v, uint8_t c)const
+        {
+            size_type w = v+1;
+            while (w < m_bp.size() and m_bp[w]) { // siblings, labels ascending
+                uint8_t lc = m_label[m_bp_support.rank(w)-1];
+                if (lc == c) {
+                    return w;
+                } else if (lc > c) {
+                    break;
+                }
+                w = m_bp_support.find_close(w)+1;
+            }
+            return m_bp.size();
+        }
+
+        //! Reconstructs the string of the leaf with lexicographic index i.
+        std::string string_of_leaf(size_type i)const
+        {
+            std::string res;
+            size_type node = m_leaf_select.select(i+1);
+            size_type v    = m_bp_support.select(node+1);
+            while (v > 0) { // collect the labels up to the root
+                res.push_back((char)m_label[node]);
+                v    = m_bp_support.enclose(v);
+                node = m_bp_support.rank(v)-1;
+            }
+            std::reverse(res.begin(), res.end());
+            return res;
+        }
+
+    public:
+        //! Default constructor
+        topk_completion() = default;
+
+        //! Constructor
+        /*! \param entries The scored strings. Duplicate strings are
+         *                 merged keeping the maximal score.
+         *  \par Time complexity
+         *       \f$ \Order{ n \log n + N } \f$ where \f$ N \f$ is the
+         *       total length of the strings.
+         */
+        explicit topk_completion(std::vector<entry_type> entries)
+        {
+            std::sort(entries.begin(), entries.end());
+            size_type n = 0; // merge duplicates, keep the maximal score
+            for (size_type i=0; i < entries.size(); ++i) {
+                if (n > 0 and entries[n-1].first == entries[i].first) {
+                    entries[n-1].second = std::max(entries[n-1].second,
+                                                   entries[i].second);
+                } else {
+                    entries[n++] = entries[i];
+                }
+            }
+            entries.resize(n);
+            std::vector<bool>    bp;
+            std::vector<uint8_t> label;
+            std::vector<bool>    leaf;
+            // DFS over the implicit trie of the sorted strings; a frame
+            // is the string range of a node together with its depth and
+            // the begin of the yet unprocessed child range
+            struct frame { size_type b, e, depth, cur; };
+            std::vector<frame> stack;
+            if (n > 0) {
+                bp.push_back(1); label.push_back(0);
+                leaf.push_back(entries[0].first.size() == 0);
+                stack.push_back({0, n, 0,
+                                 (size_type)(entries[0].first.empty() ? 1 : 0)});
+            }
+            while (!stack.empty()) {
+                frame& f = stack.back();
+                if (f.cur == f.e) {
+                    bp.push_back(0);
+                    stack.pop_back();
+                    continue;
+                }
+                uint8_t c = entries[f.cur].first[f.depth];
+                size_type r = f.cur+1;
+                while (r < f.e and
+                       (uint8_t)entries[r].first[f.depth] == c) {
+                    ++r;
+                }
+                size_type b = f.cur;
+                f.cur = r; // f invalidated by the push below
+                bool is_leaf = entries[b].first.size() == f.depth+1;
+                bp.push_back(1); label.push_back(c); leaf.push_back(is_leaf);
+                stack.push_back({b, r, stack.back().depth+1,
+                                 is_leaf ? b+1 : b});
+            }
+            m_bp    = bit_vector(bp.size());
+            for (size_type i=0; i < bp.size(); ++i)    m_bp[i] = bp[i];
+            m_label = int_vector<8>(label.size());
+            for (size_type i=0; i < label.size(); ++i) m_label[i] = label[i];
+            m_leaf  = bit_vector(leaf.size());
+            for (size_type i=0; i < leaf.size(); ++i)  m_leaf[i] = leaf[i];
+            m_weight = int_vector<>(n);
+            for (size_type i=0; i < n; ++i) m_weight[i] = entries[i].second;
+            util::bit_compress(m_weight);
+            util::init_support(m_bp_support, &m_bp);
+            util::init_support(m_leaf_rank, &m_leaf);
+            util::init_support(m_leaf_select, &m_leaf);
+            m_rmq = rmq_type(&m_weight);
+        }
+
+        //! Copy constructor
+        topk_completion(const topk_completion& tc)
+        {
+            copy(tc);
+        }
+
+        //! Move constructor
+        topk_completion(topk_completion&& tc)
+        {
+            *this = std::move(tc);
+        }
+
+        //! Assignment operator
+        topk_completion& operator=(const topk_completion& tc)
+        {
+            if (this != &tc) {
+                copy(tc);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        topk_completion& operator=(topk_completion&& tc)
+        {
+            if (this != &tc) {
+                m_bp         = std::move(tc.m_bp);
+                m_bp_support = std::move(tc.m_bp_support);
+                m_bp_support.set_vector(&m_bp);
+                m_label      = std::move(tc.m_label);
+                m_leaf       = std::move(tc.m_leaf);
+                m_leaf_rank  = std::move(tc.m_leaf_rank);
+                m_leaf_rank.set_vector(&m_leaf);
+                m_leaf_select = std::move(tc.m_leaf_select);
+                m_leaf_select.set_vector(&m_leaf);
+                m_weight     = std::move(tc.m_weight);
+                m_rmq        = std::move(tc.m_rmq);
+            }
+            return *this;
+        }
+
+        //! Returns the k highest-scored strings with the given prefix.
+        /*! \param prefix The query prefix.
+         *  \param k      The maximal number of completions to report.
+         *  \return The completions as (string, score) pairs, scores
+         *          non-increasing; less than k pairs if fewer strings
+         *          have the prefix.
+         */
+        std::vector<entry_type>
+        top_k(const std::string& prefix, size_type k)const
+        {
+            std::vector<entry_type> res;
+            if (0 == k or 0 == size()) {
+                return res;
+            }
+            size_type v = 0; // walk down to the prefix node
+            for (size_type i=0; i < prefix.size(); ++i) {
+                v = child(v, (uint8_t)prefix[i]);
+                if (v == m_bp.size()) {
+                    return res;
+                }
+            }
+            // leaf interval [lb..rb) of the subtree of v
+            size_type lb = m_leaf_rank(m_bp_support.rank(v)-1);
+            size_type rb = m_leaf_rank(m_bp_support.rank(
+                                           m_bp_support.find_close(v)));
+            // lazy top-k: report the interval maximum and split around it
+            typedef std::tuple<uint64_t, size_type, size_type, size_type> qe;
+            std::priority_queue<qe> pq; // (score, leaf, begin, end)
+            if (lb < rb) {
+                size_type m = m_rmq(lb, rb-1);
+                pq.emplace(m_weight[m], m, lb, rb);
+            }
+            while (!pq.empty() and res.size() < k) {
+                uint64_t  w = std::get<0>(pq.top());
+                size_type m = std::get<1>(pq.top());
+                size_type b = std::get<2>(pq.top());
+                size_type e = std::get<3>(pq.top());
+                pq.pop();
+                res.emplace_back(string_of_leaf(m), w);
+                if (b < m) {
+                    size_type lm = m_rmq(b, m-1);
+                    pq.emplace(m_weight[lm], lm, b, m);
+                }
+                if (m+1 < e) {
+                    size_type rm = m_rmq(m+1, e-1);
+                    pq.emplace(m_weight[rm], rm, m+1, e);
+                }
+            }
+            return res;
+        }
+
+        //! Returns the number of stored strings.
+        size_type size()const
+        {
+            return m_weight.size();
+        }
+
+        //! Returns whether the index is empty.
+        bool empty()const
+        {
+            return 0 == size();
+        }
+
+        //! Swap method
+        void swap(topk_completion& tc)
+        {
+            if (this != &tc) {
+                m_bp.swap(tc.m_bp);
+                util::swap_support(m_bp_support, tc.m_bp_support,
+                                   &m_bp, &(tc.m_bp));
+                m_label.swap(tc.m_label);
+                m_leaf.swap(tc.m_leaf);
+                util::swap_support(m_leaf_rank, tc.m_leaf_rank,
+                                   &m_leaf, &(tc.m_leaf));
+                util::swap_support(m_leaf_select, tc.m_leaf_select,
+                                   &m_leaf, &(tc.m_leaf));
+                m_weight.swap(tc.m_weight);
+                m_rmq.swap(tc.m_rmq);
+            }
+        }
+
+        //! Serializes the data structure into the given ostream.
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += m_bp.serialize(out, child, "bp");
+            written_bytes += m_bp_support.serialize(out, child, "bp_support");
+            written_bytes += m_label.serialize(out, child, "label");
+            written_bytes += m_leaf.serialize(out, child, "leaf");
+            written_bytes += m_leaf_rank.serialize(out, child, "leaf_rank");
+            written_bytes += m_leaf_select.serialize(out, child, "leaf_select");
+            written_bytes += m_weight.serialize(out, child, "weight");
+            written_bytes += m_rmq.serialize(out, child, "rmq");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            m_bp.load(in);
+            m_bp_support.load(in, &m_bp);
+            m_label.load(in);
+            m_leaf.load(in);
+            m_leaf_rank.load(in, &m_leaf);
+            m_leaf_select.load(in, &m_leaf);
+            m_weight.load(in);
+            m_rmq.load(in);
+        }
+};
+
+} // end namespace sdsl
+
+#endif // end file
@@ -0,0 +1,171 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2025 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file type_registry.hpp
+    \brief type_registry.hpp contains an optional registry of the sdsl
+           template instantiations compiled into a binary and how often
+           each one is queried at runtime.
+    \author Simon Gog
+
+    Compile with -DSDSL_TYPE_REGISTRY to activate the registry. Every
+    instantiated query entry point then registers its index type during
+    static initialization, so the report lists each instantiation that
+    contributes to the binary — including those that are never
+    exercised at runtime (query count 0), which are the candidates for
+    pruning the instantiation set and with it code size and icache
+    footprint. The registration reuses util::demangle2 and
+    util::hashvalue_of_classname, so the reported hashes match the ones
+    used in the cache file names of the construction.
+
+    The collected counts are written with
+    type_registry::write_report(std::cout).
+*/
+#ifndef INCLUDED_SDSL_TYPE_REGISTRY
+#define INCLUDED_SDSL_TYPE_REGISTRY
+
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#include <vector>
+#include "util.hpp"
+
+namespace sdsl
+{
+
+#ifdef SDSL_TYPE_REGISTRY
+
+//! Registry of the instantiated sdsl types and their runtime query counts.
+class type_registry
+{
+    private:
+        std::mutex m_mutex;
+        // full demangled type name -> query counter; the counters live as
+        // long as the process, so call sites keep raw pointers to them
+        std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> m_types;
+
+        static type_registry& the_registry()
+        {
+            static type_registry r;
+            return r;
+        }
+    public:
+        //! Registers `name` and returns its query counter.
+        /*! The reference stays valid for the lifetime of the process.
+         *  Called once per instantiated type during static
+         *  initialization, before any threads exist.
+         */
+        static std::atomic<uint64_t>& add(const std::string& name)
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            auto it = r.m_types.find(name);
+            if (it == r.m_types.end()) {
+                it = r.m_types.emplace(name,
+                        std::unique_ptr<std::atomic<uint64_t>>(
+                            new std::atomic<uint64_t>(0))).first;
+            }
+            return *(it->second);
+        }
+
+        //! One line per instantiated type, most queried first.
+        /*! Types with `queries=0` are compiled into the binary but were
+         *  never exercised; the printed hash is the one
+         *  util::class_to_hash uses in cache file names.
+         */
+        static void write_report(std::ostream& out)
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            typedef std::pair<uint64_t, const std::string*> line_type;
+            std::vector<line_type> lines;
+            for (const auto& t : r.m_types) {
+                lines.emplace_back(
+                    t.second->load(std::memory_order_relaxed), &t.first);
+            }
+            std::sort(lines.begin(), lines.end(),
+            [](const line_type& a, const line_type& b) {
+                return a.first > b.first;
+            });
+            std::hash<std::string> str_hash;
+            for (const auto& l : lines) {
+                out << *l.second
+                    << ": hash=" << str_hash(*l.second)
+                    << " queries=" << l.first << std::endl;
+            }
+        }
+
+        //! Clears all query counts; the registered types stay.
+        static void reset()
+        {
+            auto& r = the_registry();
+            std::lock_guard<std::mutex> lock(r.m_mutex);
+            for (const auto& t : r.m_types) {
+                t.second->store(0, std::memory_order_relaxed);
+            }
+        }
+};
+
+//! Static-initialization hook registering one instantiated type.
+/*! Every translation unit that instantiates a query entry point for
+ *  `t_type` ODR-uses the static `instance`, whose constructor runs
+ *  before main() and registers the type — whether or not the entry
+ *  point is ever called. Counting a query is then one relaxed atomic
+ *  increment on the cached counter.
+ */
+template<class t_type>
+class type_registration
+{
+    private:
+        std::atomic<uint64_t>* m_queries;
+    public:
+        static type_registration instance;
+
+        type_registration()
+        {
+            m_queries = &type_registry::add(
+                            util::demangle2(typeid(t_type).name()));
+        }
+
+        void count()
+        {
+            m_queries->fetch_add(1, std::memory_order_relaxed);
+        }
+};
+
+template<class t_type>
+type_registration<t_type> type_registration<t_type>::instance;
+
+#define SDSL_RECORD_TYPE_QUERY(obj)                                         \
+    do {                                                                    \
+        sdsl::type_registration<typename std::decay<                        \
+            decltype(obj)>::type>::instance.count();                        \
+    } while (0)
+
+#else
+
+#define SDSL_RECORD_TYPE_QUERY(obj) do { } while (0)
+
+#endif // SDSL_TYPE_REGISTRY
+
+} // end namespace sdsl
+
+#endif // end file
@@ -25,7 +25,10 @@
 #include "sfstream.hpp"
 #include "ram_fs.hpp"
 #include "config.hpp"  // for constants
+#include "construct_config.hpp" // for the thread count of parallel fills
 #include <iosfwd>      // forward declaration of ostream
+#include <thread>      // for the parallel fill of _fill_words
+#include <vector>
 #include <stdint.h>    // for uint64_t uint32_t declaration
 #include <cassert>
 #include <ctime>       // for rand initialization
@@ -60,6 +63,10 @@
 #define SDSL_UNUSED
 #endif
 
+#if defined(__SSE2__) && defined(__x86_64__)
+#include <emmintrin.h> // for the non-temporal stores of _fill_words
+#endif
+
 //! Namespace for the succinct data structure library.
 namespace sdsl
 {
@@ -91,6 +98,17 @@ void set_verbose();
  */
 template<class t_int_vec>
 void set_random_bits(t_int_vec& v, int seed=0);
+//! Fills the words data[0..n64) with the repeating pattern pat[0..pat_len).
+/*! Large fills are split over construct_config::num_threads threads; every
+ *  thread writes (and thereby first-touches) one contiguous chunk, which
+ *  places the pages of a freshly allocated construction workspace on the
+ *  NUMA node of the initializing thread. Fills beyond LLC size use
+ *  non-temporal stores, so they run at store bandwidth instead of
+ *  evicting the cache with lines that are written exactly once.
+ */
+inline void _fill_words(uint64_t* data, uint64_t n64,
+                        const uint64_t* pat, uint64_t pat_len);
+
 //! Sets all bits of the int_vector to 0-bits.
 template<class t_int_vec>
 void _set_zero_bits(t_int_vec& v);
@@ -110,6 +128,15 @@ void bit_compress(t_int_vec& v);
 template<class t_int_vec>
 void expand_width(t_int_vec& v, uint8_t new_width);
 
+//! Narrows the integer width to new_width <= v.width()
+/*! The elements are rewritten front-to-back within the existing
+ *  allocation, so no second buffer is needed; afterwards the
+ *  vector is shrunk to the smaller size. All values must fit
+ *  into new_width bits, surplus bits are discarded.
+ */
+template<class t_int_vec>
+void narrow_width(t_int_vec& v, uint8_t new_width);
+
 //! All elements of v modulo m
 template<class t_int_vec>
 void mod(t_int_vec& v, typename t_int_vec::size_type m);
@@ -129,6 +156,30 @@ void set_to_value(t_int_vec& v, uint64_t k);
 template<class t_int_vec>
 void set_to_id(t_int_vec& v);
 
+// calls t.materialize() when the type provides it
+template<class T>
+auto _finalize(const T& t, int) -> decltype(t.materialize(), void())
+{
+    t.materialize();
+}
+template<class T>
+void _finalize(const T&, long) { }
+
+//! Materializes all lazily initialized state of a structure.
+/*! \param t The structure to finalize.
+ *
+ *  Lazily materialized structures (e.g. the tree components of a
+ *  lazy_cst) initialize state on first use behind internal locking;
+ *  finalize() forces that work now, so subsequent queries are
+ *  read-only and pay no initialization latency. A no-op for the
+ *  eagerly initialized structures.
+ */
+template<class T>
+void finalize(const T& t)
+{
+    _finalize(t, 0);
+}
+
 //! Number of set bits in v.
 /*! \param v  int_vector object.
       \return The number of 1-bits in v.
@@ -238,7 +289,8 @@ char* str_from_errno();
 class _id_helper
 {
     private:
-        static uint64_t id;
+        static std::atomic<uint64_t> id; // atomic, so that ids taken by
+        // concurrent construction jobs are still unique
     public:
         static uint64_t getId()
         {
@@ -321,6 +373,43 @@ void init_support(S& s, const X* x)
     s.set_vector(x); // set the support object's  pointer to x
 }
 
+//! Initialise several support structures in parallel.
+/*! \param pairs (pointer to support, pointer to supported structure)
+ *               pairs, e.g. built with std::make_pair.
+ *
+ *  Each support is built by its own thread, as if init_support had been
+ *  called for every pair; the independent full scans of the supported
+ *  structures then overlap instead of running back to back. The
+ *  supported structures are only read, so several supports of the same
+ *  structure can be initialised together. Runs sequentially when
+ *  construct_config::num_threads is 1.
+ *
+ *  Example:
+ *      util::init_supports_parallel(std::make_pair(&rank, &bv),
+ *                                   std::make_pair(&select, &bv));
+ */
+template<class... t_pairs>
+void init_supports_parallel(t_pairs... pairs)
+{
+    uint64_t threads = construct_config::num_threads;
+    if (0 == threads) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads <= 1 or sizeof...(pairs) <= 1) {
+        int seq[] = {(init_support(*pairs.first, pairs.second), 0)...};
+        (void)seq;
+        return;
+    }
+    std::vector<std::thread> pool;
+    int par[] = {(pool.emplace_back([=]() {
+        init_support(*pairs.first, pairs.second);
+    }), 0)...};
+    (void)par;
+    for (auto& th : pool) {
+        th.join();
+    }
+}
+
 class spin_lock
 {
     private:
@@ -409,18 +498,24 @@ void util::bit_compress(t_int_vec& v)
         max = *max_elem;
     }
     uint8_t min_width = static_cast<uint8_t>(bits::hi(max)+1);
+    narrow_width(v, min_width);
+}
+
+template<class t_int_vec>
+void util::narrow_width(t_int_vec& v, uint8_t new_width)
+{
     uint8_t old_width = v.width();
-    if (old_width > min_width) {
+    if (old_width > new_width) {
         const uint64_t* read_data = v.data();
         uint64_t* write_data = v.data();
         uint8_t read_offset = 0;
         uint8_t write_offset = 0;
         for (typename t_int_vec::size_type i=0; i < v.size(); ++i) {
             uint64_t x = bits::read_int_and_move(read_data, read_offset, old_width);
-            bits::write_int_and_move(write_data,  x, write_offset, min_width);
+            bits::write_int_and_move(write_data, x & bits::lo_set[new_width], write_offset, new_width);
         }
-        v.bit_resize(v.size()*min_width);
-        v.width(min_width);
+        v.bit_resize(v.size()*new_width);
+        v.width(new_width);
     }
 }
 
@@ -443,29 +538,74 @@ void util::expand_width(t_int_vec& v, uint8_t new_width)
     }
 }
 
+inline void util::_fill_words(uint64_t* data, uint64_t n64,
+                              const uint64_t* pat, uint64_t pat_len)
+{
+    // below these sizes neither threading nor bypassing the cache pays off
+    const uint64_t parallel_min_words = 1ULL<<21; // 16 MiB
+    const uint64_t stream_min_words   = 1ULL<<22; // 32 MiB, beyond LLC
+    auto fill_chunk = [data, pat, pat_len](uint64_t begin, uint64_t end,
+    bool stream) {
+        uint64_t phase = begin % pat_len;
+#if defined(__SSE2__) && defined(__x86_64__)
+        if (stream) {
+            for (uint64_t i=begin; i < end; ++i) {
+                _mm_stream_si64((long long*)(data+i), (long long)pat[phase]);
+                if (++phase == pat_len) {
+                    phase = 0;
+                }
+            }
+            _mm_sfence();
+            return;
+        }
+#else
+        (void)stream;
+#endif
+        for (uint64_t i=begin; i < end; ++i) {
+            data[i] = pat[phase];
+            if (++phase == pat_len) {
+                phase = 0;
+            }
+        }
+    };
+    bool stream = n64 >= stream_min_words;
+    uint64_t threads = construct_config::num_threads;
+    if (0 == threads) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (n64 < parallel_min_words or threads <= 1) {
+        fill_chunk(0, n64, stream);
+        return;
+    }
+    // chunk borders are multiples of pat_len, so every thread starts
+    // pattern-aligned and first-touches exactly the pages it writes
+    uint64_t chunk = ((n64+threads-1)/threads+pat_len-1)/pat_len*pat_len;
+    std::vector<std::thread> pool;
+    for (uint64_t t=0; t*chunk < n64; ++t) {
+        pool.emplace_back(fill_chunk, t*chunk,
+                          std::min((t+1)*chunk, n64), stream);
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+}
+
 template<class t_int_vec>
 void util::_set_zero_bits(t_int_vec& v)
 {
-    uint64_t* data = v.data();
     if (v.empty())
         return;
-    // TODO: replace by memset() but take care of size_t in the argument!
-    *data = 0ULL;
-    for (typename t_int_vec::size_type i=1; i < (v.capacity()>>6); ++i) {
-        *(++data) = 0ULL;
-    }
+    const uint64_t zero = 0ULL;
+    _fill_words(v.data(), v.capacity()>>6, &zero, 1);
 }
 
 template<class t_int_vec>
 void util::_set_one_bits(t_int_vec& v)
 {
-    uint64_t* data = v.data();
     if (v.empty())
         return;
-    *data = 0xFFFFFFFFFFFFFFFFULL;
-    for (typename t_int_vec::size_type i=1; i < (v.capacity()>>6); ++i) {
-        *(++data) = 0xFFFFFFFFFFFFFFFFULL;
-    }
+    const uint64_t ones = 0xFFFFFFFFFFFFFFFFULL;
+    _fill_words(v.data(), v.capacity()>>6, &ones, 1);
 }
 
 template<class t_int_vec>
@@ -502,12 +642,7 @@ void util::set_to_value(t_int_vec& v, uint64_t k)
         }
     } while (offset != 0);
 
-    typename t_int_vec::size_type n64 = v.capacity()/64;
-    for (typename t_int_vec::size_type i=0; i < n64;) {
-        for (uint64_t ii=0; ii < n and i < n64; ++ii,++i) {
-            *(data++) = vec[ii];
-        }
-    }
+    _fill_words(data, v.capacity()/64, vec, n);
 }
 
 //! Set v[i] = i for i=[0..v.size()-1]
@@ -540,14 +675,11 @@ typename t_int_vec::size_type util::cnt_onezero_bits(const t_int_vec& v)
     const uint64_t* data = v.data();
     if (v.empty())
         return 0;
-    uint64_t carry = 0, oldcarry=0;
-    typename t_int_vec::size_type result = bits::cnt10(*data, carry);
-    for (typename t_int_vec::size_type i=1; i < (v.capacity()>>6); ++i) {
-        oldcarry = carry;
-        result += bits::cnt10(*(++data), carry);
-    }
+    typename t_int_vec::size_type words = v.capacity()>>6;
+    typename t_int_vec::size_type result = bits::cnt10_words(data, words);
     if (v.bit_size()&0x3F) {// if bit_size is not a multiple of 64, subtract the counts of the additional bits
-        result -= bits::cnt(bits::map10(*data, oldcarry) & bits::lo_unset[v.bit_size()&0x3F]);
+        uint64_t oldcarry = (words >= 2) ? (data[words-2]>>63) : 0;
+        result -= bits::cnt(bits::map10(data[words-1], oldcarry) & bits::lo_unset[v.bit_size()&0x3F]);
     }
     return result;
 }
@@ -558,14 +690,11 @@ typename t_int_vec::size_type util::cnt_zeroone_bits(const t_int_vec& v)
     const uint64_t* data = v.data();
     if (v.empty())
         return 0;
-    uint64_t carry = 1, oldcarry = 1;
-    typename t_int_vec::size_type result = bits::cnt01(*data, carry);
-    for (typename t_int_vec::size_type i=1; i < (v.capacity()>>6); ++i) {
-        oldcarry = carry;
-        result += bits::cnt01(*(++data), carry);
-    }
+    typename t_int_vec::size_type words = v.capacity()>>6;
+    typename t_int_vec::size_type result = bits::cnt01_words(data, words);
     if (v.bit_size()&0x3F) {// if bit_size is not a multiple of 64, subtract the counts of the additional bits
-        result -= bits::cnt(bits::map01(*data, oldcarry) & bits::lo_unset[v.bit_size()&0x3F]);
+        uint64_t oldcarry = (words >= 2) ? (data[words-2]>>63) : 1;
+        result -= bits::cnt(bits::map01(data[words-1], oldcarry) & bits::lo_unset[v.bit_size()&0x3F]);
     }
     return result;
 }
@@ -6,5 +6,6 @@
 #include "enc_vector.hpp"
 #include "vlc_vector.hpp"
 #include "dac_vector.hpp"
+#include "segmented_int_vector.hpp"
 
 #endif
@@ -43,17 +43,26 @@ struct vlc_vector_trait<32> {
 //! A generic immutable space-saving vector class for unsigned integers.
 /*! The values of a vlc_vector are immutable after the constructor call. The class
  *   could be parametrized with a self-delimiting code t_coder and the sample density.
- *  \tparam t_coder Type of self-delimiting coder.
- *  \tparam t_dens  Sampling density of pointers into the stream of self-delimiting coded numbers.
- *  \tparam t_width Width of the underlying int_vector for the pointers.
+ *  \tparam t_coder     Type of self-delimiting coder.
+ *  \tparam t_dens      Sampling density of pointers into the stream of self-delimiting coded numbers.
+ *  \tparam t_width     Width of the underlying int_vector for the pointers.
+ *  \tparam t_skip_dens Optional intra-block skip density. If non-zero (a proper
+ *                      divisor of t_dens), the bit offset of every t_skip_dens-th
+ *                      code inside a sample block is stored in addition, so a
+ *                      random access decodes at most t_skip_dens-1 codes instead
+ *                      of t_dens-1. Allows large t_dens for space without the
+ *                      linear decode cost.
  */
 template<class    t_coder = coder::elias_delta,
          uint32_t t_dens  = 128,
-         uint8_t  t_width = 0>
+         uint8_t  t_width = 0,
+         uint32_t t_skip_dens = 0>
 class vlc_vector
 {
     private:
         static_assert(t_dens > 1 , "vlc_vector: Sampling density must be larger than 1");
+        static_assert(t_skip_dens == 0 or (t_skip_dens > 1 and t_skip_dens < t_dens and t_dens % t_skip_dens == 0),
+                      "vlc_vector: Skip density must be 0 (disabled) or a proper divisor of the sampling density");
     public:
         typedef uint64_t                                 value_type;
         typedef random_access_const_iterator<vlc_vector> iterator;
@@ -69,9 +78,12 @@ class vlc_vector
         vlc_vector_trait<t_width>::int_vector_type      int_vector_type;
 
         static  const uint32_t                           sample_dens = t_dens;
+        // skip slots stored per sample block
+        static  const uint32_t                           skip_per_block = t_skip_dens ? t_dens/t_skip_dens - 1 : 0;
         bit_vector      m_z;     // compressed bit stream
     private:
         int_vector_type m_sample_pointer;
+        int_vector<0>   m_skip;  // intra-block bit offsets (empty if t_skip_dens==0)
         size_type       m_size        = 0;    // number of elements
         uint32_t        m_sample_dens = t_dens;
 
@@ -82,6 +94,7 @@ class vlc_vector
             m_z.resize(0);
             m_size = 0;
             m_sample_pointer.resize(0);
+            m_skip.resize(0);
         }
 
     public:
@@ -149,10 +162,38 @@ class vlc_vector
 
         uint32_t get_sample_dens() const;
         void set_sample_dens(const uint32_t sdens);
+
+        //! Decode the n consecutive values v[i],...,v[i+n-1] into buf.
+        /*! Each sample block overlapping the range is decoded exactly once
+         *  with the batch decoder of the coder, in contrast to operator[],
+         *  which restarts the block for every access.
+         *  \param i   Index of the first value. \f$ i+n \leq size() \f$.
+         *  \param n   Number of values to decode.
+         *  \param buf Array of length at least n receiving the values.
+         */
+        void decode_range(size_type i, size_type n, uint64_t* buf)const
+        {
+            assert(i+n <= m_size);
+            const size_type sd = get_sample_dens();
+            std::vector<uint64_t> block(sd);
+            while (n > 0) {
+                size_type idx      = i/sd;       // current sample block
+                size_type off      = i - idx*sd; // offset in the block
+                size_type in_block = sd - off < n ? sd - off : n;
+                size_type avail    = m_size - idx*sd < sd ? m_size - idx*sd : sd;
+                t_coder::template decode_batch<false>(m_z.data(), m_sample_pointer[idx], m_z.size(), avail, block.data());
+                for (size_type k=0; k < in_block; ++k) {
+                    buf[k] = block[off+k] - 1;
+                }
+                buf += in_block;
+                i   += in_block;
+                n   -= in_block;
+            }
+        }
 };
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
-inline uint32_t vlc_vector<t_coder, t_dens, t_width>::get_sample_dens() const
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
+inline uint32_t vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::get_sample_dens() const
 {
     if (t_dens == 0)
         return m_sample_dens;
@@ -160,51 +201,68 @@ inline uint32_t vlc_vector<t_coder, t_dens, t_width>::get_sample_dens() const
         return t_dens;
 }
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
-inline void vlc_vector<t_coder, t_dens, t_width>::set_sample_dens(const uint32_t sdens)
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
+inline void vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::set_sample_dens(const uint32_t sdens)
 {
     m_sample_dens = sdens;
 }
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
-inline typename vlc_vector<t_coder, t_dens,t_width>::value_type vlc_vector<t_coder, t_dens,t_width>::operator[](const size_type i)const
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
+inline typename vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::value_type vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::operator[](const size_type i)const
 {
     assert(i+1 != 0);
     assert(i < m_size);
     size_type idx = i/get_sample_dens();
-    return (t_coder::template decode<false, false, int*>(m_z.data(), m_sample_pointer[idx], i-t_dens*idx+1)) - 1;
+    size_type rem = i - t_dens*idx;
+    size_type ptr = m_sample_pointer[idx];
+    if (t_skip_dens and rem >= t_skip_dens) { // jump to the nearest skip offset
+        size_type s = rem/t_skip_dens;
+        ptr += m_skip[idx*skip_per_block + s - 1];
+        rem -= s*t_skip_dens;
+    }
+    return (t_coder::template decode<false, false, int*>(m_z.data(), ptr, rem+1)) - 1;
 }
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
-void vlc_vector<t_coder, t_dens,t_width>::swap(vlc_vector<t_coder, t_dens,t_width>& v)
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
+void vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::swap(vlc_vector<t_coder, t_dens, t_width, t_skip_dens>& v)
 {
     if (this != &v) { // if v and _this_ are not the same object
         m_z.swap(v.m_z);                    // swap compressed bit streams
         m_sample_pointer.swap(v.m_sample_pointer);
+        m_skip.swap(v.m_skip);
         std::swap(m_size, v.m_size);// swap the number of elements
     }
 }
 
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
 template<class Container>
-vlc_vector<t_coder, t_dens, t_width>::vlc_vector(const Container& c)
+vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::vlc_vector(const Container& c)
 {
     clear(); // clear bit_vectors
 
     if (c.empty())  // if c is empty there is nothing to do...
         return;
-    size_type samples = 0, z_size = 0;
+    size_type samples = 0, z_size = 0, max_block_bits = 0, block_start = 0;
 //  (1) Calculate size of z
     for (size_type i=0; i < c.size(); ++i) {
         if (c[i]+1<1) {
             throw std::logic_error("vlc_vector cannot decode values smaller than 1!");
         }
+        if (t_skip_dens and (i % t_dens) == 0) {
+            block_start = z_size;
+        }
         z_size += t_coder::encoding_length(c[i]+1);
+        if (t_skip_dens and z_size - block_start > max_block_bits) {
+            max_block_bits = z_size - block_start;
+        }
     }
     samples = (c.size()+get_sample_dens()-1)/get_sample_dens();
 //    (2) Write z
     m_sample_pointer = int_vector<>(samples+1, 0, bits::hi(z_size+1)+1);
+    if (t_skip_dens) {
+        m_skip = int_vector<>(samples*skip_per_block, 0, bits::hi(max_block_bits+1)+1);
+    }
 
     m_z.bit_resize(z_size);
     z_size = 0;
@@ -215,6 +273,10 @@ vlc_vector<t_coder, t_dens, t_width>::vlc_vector(const Container& c)
         if (!no_sample) { // add a sample pointer
             no_sample = get_sample_dens();
             m_sample_pointer[sample_cnt++] = z_size;
+            block_start = z_size;
+        } else if (t_skip_dens and ((i % t_dens) % t_skip_dens) == 0) {
+            // bit offset of the code relative to the block start
+            m_skip[(i/t_dens)*skip_per_block + (i%t_dens)/t_skip_dens - 1] = z_size - block_start;
         }
         t_coder::encode(c[i]+1, z_data, offset);
         z_size += t_coder::encoding_length(c[i]+1);
@@ -222,27 +284,36 @@ vlc_vector<t_coder, t_dens, t_width>::vlc_vector(const Container& c)
     m_size = c.size();
 }
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
 template<uint8_t int_width>
-vlc_vector<t_coder, t_dens, t_width>::vlc_vector(int_vector_buffer<int_width>& v_buf)
+vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::vlc_vector(int_vector_buffer<int_width>& v_buf)
 {
     clear(); // clear bit_vectors
     size_type n = v_buf.size();
     if (n == 0)  // if c is empty there is nothing to do...
         return;
-    size_type samples=0, z_size=0;
+    size_type samples=0, z_size=0, max_block_bits=0, block_start=0;
 //  (1) Calculate size of z
     for (size_type i=0; i < n; ++i) {
         size_type x = v_buf[i]+1;
         if (x < 1) {
             throw std::logic_error("vlc_vector cannot decode values smaller than 1!");
         }
+        if (t_skip_dens and (i % t_dens) == 0) {
+            block_start = z_size;
+        }
         z_size += t_coder::encoding_length(x);
+        if (t_skip_dens and z_size - block_start > max_block_bits) {
+            max_block_bits = z_size - block_start;
+        }
     }
     samples = (n+get_sample_dens()-1)/get_sample_dens();
 //    (2) Write z
 
     m_sample_pointer = int_vector<>(samples+1, 0, bits::hi(z_size+1)+1);  // add 1 for last entry
+    if (t_skip_dens) {
+        m_skip = int_vector<>(samples*skip_per_block, 0, bits::hi(max_block_bits+1)+1);
+    }
 
 //     (b) Initilize bit_vector for encoded data
     m_z.bit_resize(z_size);
@@ -256,6 +327,10 @@ vlc_vector<t_coder, t_dens, t_width>::vlc_vector(int_vector_buffer<int_width>& v
         if (!no_sample) { // add a sample pointer
             no_sample = get_sample_dens();
             m_sample_pointer[sample_cnt++] = z_size;
+            block_start = z_size;
+        } else if (t_skip_dens and ((i % t_dens) % t_skip_dens) == 0) {
+            // bit offset of the code relative to the block start
+            m_skip[(i/t_dens)*skip_per_block + (i%t_dens)/t_skip_dens - 1] = z_size - block_start;
         }
         size_type x = v_buf[i]+1;
         t_coder::encode(x, z_data, offset);   // write encoded values
@@ -264,24 +339,30 @@ vlc_vector<t_coder, t_dens, t_width>::vlc_vector(int_vector_buffer<int_width>& v
     m_size = n;
 }
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
-vlc_vector<>::size_type vlc_vector<t_coder, t_dens,t_width>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
+vlc_vector<>::size_type vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::serialize(std::ostream& out, structure_tree_node* v, std::string name)const
 {
     structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
     size_type written_bytes = 0;
     written_bytes += write_member(m_size, out, child, "m_size");
     written_bytes += m_z.serialize(out, child, "m_z");
     written_bytes += m_sample_pointer.serialize(out, child, "m_sample_pointer");
+    if (t_skip_dens) { // keep the format of skip-less vectors unchanged
+        written_bytes += m_skip.serialize(out, child, "m_skip");
+    }
     structure_tree::add_size(child, written_bytes);
     return written_bytes;
 }
 
-template<class t_coder, uint32_t t_dens, uint8_t t_width>
-void vlc_vector<t_coder, t_dens,t_width>::load(std::istream& in)
+template<class t_coder, uint32_t t_dens, uint8_t t_width, uint32_t t_skip_dens>
+void vlc_vector<t_coder, t_dens, t_width, t_skip_dens>::load(std::istream& in)
 {
     read_member(m_size, in);
     m_z.load(in);
     m_sample_pointer.load(in);
+    if (t_skip_dens) {
+        m_skip.load(in);
+    }
 }
 
 } // end namespace sdsl
@@ -35,7 +35,9 @@
 #include "wt_huff.hpp"
 #include "wt_hutu.hpp"
 #include "wt_int.hpp"
+#include "wt_quad_int.hpp"
 #include "wm_int.hpp"
+#include "wm_int_hyb.hpp"
 #include "wt_rlmn.hpp"
 #include "wt_ap.hpp"
 #include "wt_algorithm.hpp"
@@ -66,6 +68,17 @@ using wt_huff_int = wt_pc<huff_shape,
       t_select_zero,
       int_tree<>>;
 
+template<class t_bitvector   = bit_vector,
+         class t_rank        = typename t_bitvector::rank_1_type,
+         class t_select      = typename t_bitvector::select_1_type,
+         class t_select_zero = typename t_bitvector::select_0_type>
+using wt_huff_freq_int = wt_pc<huff_freq_shape,
+      t_bitvector,
+      t_rank,
+      t_select,
+      t_select_zero,
+      int_tree<>>;
+
 template<class t_bitvector   = bit_vector,
          class t_rank        = typename t_bitvector::rank_1_type,
          class t_select_one  = typename t_bitvector::select_1_type,
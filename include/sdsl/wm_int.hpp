@@ -29,6 +29,7 @@
 #include "select_support_mcl.hpp"
 #include "wt_helper.hpp"
 #include "util.hpp"
+#include "construct_config.hpp"
 #include <set> // for calculating the alphabet size
 #include <map> // for mapping a symbol to its lexicographical index
 #include <algorithm> // for std::swap
@@ -36,6 +37,9 @@
 #include <vector>
 #include <queue>
 #include <utility>
+#include <thread>
+#include <atomic>
+#include <type_traits>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -97,6 +101,127 @@ class wm_int
         int_vector<64>         m_zero_cnt;     // m_zero_cnt[i] contains the number of zeros in level i
         int_vector<64>         m_rank_level;   // m_rank_level[i] contains m_tree_rank(i*size())
 
+        // or a word into the tree bit vector; chunk borders may share a
+        // word between threads, therefore the or is atomic
+        static void or_word_atomic(bit_vector& bv, size_type word_idx, uint64_t word)
+        {
+#ifndef MSVC_COMPILER
+            __atomic_fetch_or(bv.data()+word_idx, word, __ATOMIC_RELAXED);
+#else
+            // the parallel construction is disabled for MSVC, so this
+            // is never executed concurrently
+            *(bv.data()+word_idx) |= word;
+#endif
+        }
+
+        // Parallel counterpart of the level-by-level construction loop of
+        // the semi-external constructor. Each level processes one
+        // contiguous chunk of the current sequence per thread: a counting
+        // pass determines the number of zeros in every chunk, prefix sums
+        // then give each chunk its exact write positions in the bit plane
+        // and in the reordered sequence, so the partition pass runs
+        // without locks. The reordered sequence is double-buffered in two
+        // plain 64-bit arrays (instead of the packed in-place vector plus
+        // temporary file of the sequential version), so concurrent writes
+        // never share a word; this trades 16n bytes of memory for the
+        // parallel speedup. Sets m_zero_cnt, m_sigma and m_tree.
+        template<class t_rac>
+        void construct_parallel(const t_rac& rac, uint64_t threads)
+        {
+            size_type bit_size = m_size*m_max_level;
+            bit_vector tree(bit_size, 0);
+            std::vector<uint64_t> cur(m_size), nxt(m_size);
+            for (size_type i=0; i < m_size; ++i) {
+                cur[i] = rac[i];
+            }
+            std::vector<size_type> chunk_begin(threads+1, m_size);
+            size_type chunk = (m_size+threads-1)/threads;
+            for (uint64_t t=0; t*chunk < m_size; ++t) {
+                chunk_begin[t] = t*chunk;
+            }
+            std::vector<size_type> chunk_zeros(threads);
+            for (uint32_t k=0; k<m_max_level; ++k) {
+                const uint64_t mask = 1ULL<<(m_max_level-k-1);
+                {
+                    // (a) count the zeros of each chunk
+                    std::vector<std::thread> pool;
+                    for (uint64_t t=0; t < threads; ++t) {
+                        pool.emplace_back([&,t]() {
+                            size_type zeros = 0;
+                            for (size_type i=chunk_begin[t]; i < chunk_begin[t+1]; ++i) {
+                                zeros += !(cur[i]&mask);
+                            }
+                            chunk_zeros[t] = zeros;
+                        });
+                    }
+                    for (auto& th : pool) th.join();
+                }
+                // (b) prefix sums give each chunk its write positions
+                size_type zeros_total = 0;
+                for (uint64_t t=0; t < threads; ++t) {
+                    zeros_total += chunk_zeros[t];
+                }
+                m_zero_cnt[k] = zeros_total;
+                {
+                    // (c) write the bit plane and partition the sequence
+                    std::vector<std::thread> pool;
+                    size_type zeros_before = 0;
+                    for (uint64_t t=0; t < threads; ++t) {
+                        size_type zero_idx = zeros_before;
+                        size_type one_idx  = zeros_total
+                                             + (chunk_begin[t]-zeros_before);
+                        zeros_before += chunk_zeros[t];
+                        pool.emplace_back([&,t,zero_idx,one_idx]() mutable {
+                            size_type tree_pos = (size_type)k*m_size + chunk_begin[t];
+                            uint64_t  tree_word = 0;
+                            for (size_type i=chunk_begin[t]; i < chunk_begin[t+1]; ++i) {
+                                uint64_t x = cur[i];
+                                if (x&mask) {
+                                    tree_word |= 1ULL<<(tree_pos&0x3FULL);
+                                    nxt[one_idx++] = x;
+                                } else {
+                                    nxt[zero_idx++] = x;
+                                }
+                                ++tree_pos;
+                                if ((tree_pos&0x3FULL) == 0) {
+                                    if (tree_word) {
+                                        or_word_atomic(tree, (tree_pos>>6)-1, tree_word);
+                                    }
+                                    tree_word = 0;
+                                }
+                            }
+                            if (tree_word) {
+                                or_word_atomic(tree, tree_pos>>6, tree_word);
+                            }
+                        });
+                    }
+                    for (auto& th : pool) th.join();
+                }
+                std::swap(cur, nxt);
+            }
+            m_sigma = std::unique(cur.begin(), cur.end()) - cur.begin();
+            m_tree = bit_vector_type(std::move(tree));
+        }
+
+        // Install the rank support: reuse the word counts collected during
+        // the sequential fill if the support is a plain rank_support_v over
+        // a plain bit_vector; scan the finished bit vector otherwise.
+        static void install_rank(rank_support_v<1,1>& rs, const bit_vector* bv,
+                                 rank_support_v<1,1>::builder& b)
+        {
+            if (b.active()) {
+                rs = b.finish(bv);
+            } else {
+                util::init_support(rs, bv);
+            }
+        }
+        template<class t_r, class t_bv>
+        static void install_rank(t_r& rs, const t_bv* bv,
+                                 rank_support_v<1,1>::builder&)
+        {
+            util::init_support(rs, bv);
+        }
+
         void copy(const wm_int& wt)
         {
             m_size          = wt.m_size;
@@ -163,55 +288,83 @@ class wm_int
             }
 
 
-            std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
-            osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary | std::ios::trunc | std::ios::out);   // open buffer for tree
-            size_type bit_size = m_size*m_max_level;
-            tree_out_buf.write((char*) &bit_size, sizeof(bit_size));    // write size of bit_vector
-
-            std::string zero_buf_file_name = tmp_file(buf.filename(), "_zero_buf");
-
-            size_type tree_pos = 0;
-            uint64_t tree_word = 0;
-
             m_zero_cnt = int_vector<64>(m_max_level, 0); // zeros at level i
 
-            for (uint32_t k=0; k<m_max_level; ++k) {
-                uint8_t        width = m_max_level-k-1;
-                const uint64_t mask  = 1ULL<<width;
-                uint64_t       x     = 0;
-                size_type      zeros = 0;
-                int_vector_buffer<> zero_buf(zero_buf_file_name, std::ios::out, 1024*1024, m_max_level);
-                for (size_t i=0; i<m_size; ++i) {
-                    x = rac[i];
-                    if (x&mask) {
-                        tree_word |= (1ULL << (tree_pos&0x3FULL));
-                        zero_buf.push_back(x);
-                    } else {
-                        rac[zeros++ ] = x;
+            uint64_t threads = construct_config::num_threads;
+            if (0 == threads) {
+                threads = std::thread::hardware_concurrency();
+                if (0 == threads)
+                    threads = 1;
+            }
+#ifdef MSVC_COMPILER
+            threads = 1; // parallel fill relies on GCC/Clang atomic builtins
+#endif
+            // count set bits per word while the tree is written, so the rank
+            // support can be assembled without re-scanning the bit vector
+            const bool count_on_the_fly =
+                std::is_same<t_bitvector, bit_vector>::value and
+                std::is_same<t_rank, rank_support_v<1,1>>::value;
+            rank_support_v<1,1>::builder rank_builder;
+
+            if (threads > 1 and m_size >= (threads<<14)) {
+                construct_parallel(rac, threads);
+                rac.resize(0);
+            } else {
+
+                std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
+                osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary | std::ios::trunc | std::ios::out);   // open buffer for tree
+                size_type bit_size = m_size*m_max_level;
+                tree_out_buf.write((char*) &bit_size, sizeof(bit_size));    // write size of bit_vector
+                if (count_on_the_fly)
+                    rank_builder.init(bit_size);
+
+                std::string zero_buf_file_name = tmp_file(buf.filename(), "_zero_buf");
+
+                size_type tree_pos = 0;
+                uint64_t tree_word = 0;
+
+                for (uint32_t k=0; k<m_max_level; ++k) {
+                    uint8_t        width = m_max_level-k-1;
+                    const uint64_t mask  = 1ULL<<width;
+                    uint64_t       x     = 0;
+                    size_type      zeros = 0;
+                    int_vector_buffer<> zero_buf(zero_buf_file_name, std::ios::out, 1024*1024, m_max_level);
+                    for (size_t i=0; i<m_size; ++i) {
+                        x = rac[i];
+                        if (x&mask) {
+                            tree_word |= (1ULL << (tree_pos&0x3FULL));
+                            zero_buf.push_back(x);
+                        } else {
+                            rac[zeros++ ] = x;
+                        }
+                        ++tree_pos;
+                        if ((tree_pos & 0x3FULL) == 0) { // if tree_pos % 64 == 0 write old word
+                            tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+                            if (count_on_the_fly)
+                                rank_builder.add_word(tree_word);
+                            tree_word = 0;
+                        }
                     }
-                    ++tree_pos;
-                    if ((tree_pos & 0x3FULL) == 0) { // if tree_pos % 64 == 0 write old word
-                        tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
-                        tree_word = 0;
+                    m_zero_cnt[k] = zeros;
+                    for (size_t i=zeros; i<m_size; ++i) {
+                        rac[i] = zero_buf[i-zeros];
                     }
                 }
-                m_zero_cnt[k] = zeros;
-                for (size_t i=zeros; i<m_size; ++i) {
-                    rac[i] = zero_buf[i-zeros];
+                if ((tree_pos & 0x3FULL) != 0) { // if tree_pos % 64 > 0 => there are remaining entries we have to write
+                    tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
+                    if (count_on_the_fly)
+                        rank_builder.add_word(tree_word);
                 }
+                sdsl::remove(zero_buf_file_name);
+                tree_out_buf.close();
+                m_sigma = std::unique(rac.begin(), rac.end()) - rac.begin();
+                rac.resize(0);
+                bit_vector tree;
+                load_from_file(tree, tree_out_buf_file_name);
+                sdsl::remove(tree_out_buf_file_name);
+                m_tree = bit_vector_type(std::move(tree));
             }
-            if ((tree_pos & 0x3FULL) != 0) { // if tree_pos % 64 > 0 => there are remaining entries we have to write
-                tree_out_buf.write((char*) &tree_word, sizeof(tree_word));
-            }
-            sdsl::remove(zero_buf_file_name);
-            tree_out_buf.close();
-            m_sigma = std::unique(rac.begin(), rac.end()) - rac.begin();
-            rac.resize(0);
-            bit_vector tree;
-            load_from_file(tree, tree_out_buf_file_name);
-            sdsl::remove(tree_out_buf_file_name);
-            m_tree = bit_vector_type(std::move(tree));
-            util::init_support(m_tree_rank, &m_tree);
+            install_rank(m_tree_rank, &m_tree, rank_builder);
             util::init_support(m_tree_select0, &m_tree);
             util::init_support(m_tree_select1, &m_tree);
             m_rank_level = int_vector<64>(m_max_level, 0);
@@ -455,6 +608,154 @@ class wm_int
             return make_pair(cnt_answers, point_vec);
         }
 
+        // one node visit of the 2d range search: the four distinct rank
+        // queries of a visit are computed once and children nodes, children
+        // ranges and the select offset are all derived from them (expand(v)
+        // plus expand(v,r) plus the offset rank would cost six)
+        void
+        _visit_2d(const node_type& v, const range_type& r,
+                  std::array<node_type, 2>& c_v, std::array<range_type, 2>& c_r,
+                  size_type& rank_off) const
+        {
+            size_type rank_b   = m_tree_rank(v.offset);
+            size_type rank_lb  = m_tree_rank(v.offset + r[0]);
+            size_type rank_rb  = m_tree_rank(v.offset + r[1] + 1);
+            size_type rank_end = m_tree_rank(v.offset + v.size);
+            rank_off = rank_lb;
+            size_type ones   = rank_end - rank_b;           // ones in [b..size)
+            size_type ones_p = rank_b - m_rank_level[v.level]; // ones in [level_b..b)
+
+            c_v[0].offset = (v.level+1)*m_size + (v.offset - v.level*m_size) - ones_p;
+            c_v[0].size   = v.size - ones;
+            c_v[0].level  = v.level + 1;
+            c_v[0].sym    = v.sym<<1;
+            c_v[1].offset = (v.level+1)*m_size + m_zero_cnt[v.level] + ones_p;
+            c_v[1].size   = ones;
+            c_v[1].level  = v.level + 1;
+            c_v[1].sym    = (v.sym<<1)|1;
+
+            size_type right_size = rank_rb - rank_lb;
+            size_type left_size  = (r[1]-r[0]+1) - right_size;
+            size_type right_sp   = rank_lb - rank_b;
+            size_type left_sp    = r[0] - right_sp;
+            c_r[0] = {{left_sp, left_sp + left_size - 1}};
+            c_r[1] = {{right_sp, right_sp + right_size - 1}};
+        }
+
+        //! Parallel version of range_search_2d for large result sets.
+        /*! \param lb     Left bound of index interval (inclusive)
+         *  \param rb     Right bound of index interval (inclusive)
+         *  \param vlb    Left bound of value interval (inclusive)
+         *  \param vrb    Right bound of value interval (inclusive)
+         *  \param report Should the matching points be returned?
+         *  \param num_threads Number of worker threads; 0 selects
+         *                std::thread::hardware_concurrency().
+         *  \return Pair (#of found points, vector of points) as in
+         *          range_search_2d, points in the same order.
+         *
+         *  The search frontier is expanded level by level until it holds
+         *  enough independent subtree tasks, which the workers then pull
+         *  from a shared queue — threads which finish their subtrees early
+         *  steal the remaining ones, so skewed result distributions still
+         *  balance. Each task carries its own ancestor offsets, so the
+         *  workers share no mutable state; small queries fall back to the
+         *  sequential search.
+         */
+        std::pair<size_type, std::vector<std::pair<value_type, size_type>>>
+        range_search_2d_parallel(size_type lb, size_type rb, value_type vlb,
+                                 value_type vrb, bool report=true,
+                                 uint64_t num_threads=0) const
+        {
+            if (0 == num_threads) {
+                num_threads = std::thread::hardware_concurrency();
+            }
+            if (num_threads <= 1 or rb < lb + 4096) { // small query
+                return range_search_2d(lb, rb, vlb, vrb, report);
+            }
+            if (vrb > (1ULL << m_max_level))
+                vrb = (1ULL << m_max_level);
+            if (vlb > vrb or lb > rb)
+                return make_pair(0, point_vec_type());
+
+            // a frontier entry is an independent subtree search with its
+            // own copy of the ancestor offsets
+            struct task_type {
+                node_type v;
+                range_type r;
+                value_type vlb, vrb;
+                size_type ilb;
+                std::vector<size_type> is;
+                std::vector<size_type> rank_off;
+            };
+            std::vector<task_type> frontier;
+            frontier.push_back(task_type {root(), {{lb, rb}}, vlb, vrb, 0,
+                                          std::vector<size_type>(m_max_level+1),
+                                          std::vector<size_type>(m_max_level+1)});
+            bool expandable = true;
+            while (expandable and frontier.size() < 4*num_threads) {
+                expandable = false;
+                std::vector<task_type> next_frontier;
+                next_frontier.reserve(2*frontier.size());
+                for (task_type& t : frontier) {
+                    if (t.v.level == m_max_level) { // leaf; keep as is
+                        next_frontier.push_back(std::move(t));
+                        continue;
+                    }
+                    expandable = true;
+                    t.is[t.v.level] = t.v.offset + t.r[0];
+                    size_type irb = t.ilb + (1ULL << (m_max_level-t.v.level));
+                    size_type mid = (irb + t.ilb)>>1;
+                    std::array<node_type, 2> c_v;
+                    std::array<range_type, 2> c_r;
+                    _visit_2d(t.v, t.r, c_v, c_r, t.rank_off[t.v.level]);
+                    if (!sdsl::empty(c_r[0]) and t.vlb < mid and mid) {
+                        next_frontier.push_back(task_type {c_v[0], c_r[0],
+                                                           t.vlb, std::min(t.vrb, (value_type)(mid-1)),
+                                                           t.ilb, t.is, t.rank_off});
+                    }
+                    if (!sdsl::empty(c_r[1]) and t.vrb >= mid) {
+                        next_frontier.push_back(task_type {c_v[1], c_r[1],
+                                                           std::max((value_type)mid, t.vlb), t.vrb,
+                                                           mid, std::move(t.is), std::move(t.rank_off)});
+                    }
+                }
+                frontier.swap(next_frontier);
+            }
+            if (frontier.empty()) {
+                return make_pair(0, point_vec_type());
+            }
+            // workers pull subtree tasks from a shared queue
+            std::vector<point_vec_type> points(frontier.size());
+            std::vector<size_type> counts(frontier.size(), 0);
+            std::atomic<size_t> next(0);
+            uint64_t workers = std::min<uint64_t>(num_threads, frontier.size());
+            std::vector<std::thread> pool;
+            for (uint64_t w=0; w < workers; ++w) {
+                pool.emplace_back([&]() {
+                    size_t i = 0;
+                    while ((i = next++) < frontier.size()) {
+                        task_type& t = frontier[i];
+                        _range_search_2d(t.v, t.r, t.vlb, t.vrb, t.ilb,
+                                         t.is, t.rank_off, points[i],
+                                         report, counts[i]);
+                    }
+                });
+            }
+            for (auto& w : pool) {
+                w.join();
+            }
+            // frontier tasks are in left-to-right tree order, so
+            // concatenation reproduces the sequential output order
+            size_type cnt_answers = 0;
+            point_vec_type point_vec;
+            for (size_t i=0; i < frontier.size(); ++i) {
+                cnt_answers += counts[i];
+                point_vec.insert(point_vec.end(),
+                                 points[i].begin(), points[i].end());
+            }
+            return make_pair(cnt_answers, point_vec);
+        }
+
         void
         _range_search_2d(node_type v, range_type r, value_type vlb,
                          value_type vrb, size_type ilb, std::vector<size_type>& is,
@@ -485,14 +786,13 @@ class wm_int
                 }
                 cnt_answers += sdsl::size(r);
                 return;
-            } else {
-                rank_off[v.level] = m_tree_rank(is[v.level]);
             }
             size_type irb = ilb + (1ULL << (m_max_level-v.level));
             size_type mid = (irb + ilb)>>1;
 
-            auto c_v = expand(v);
-            auto c_r = expand(v, r);
+            std::array<node_type, 2> c_v;
+            std::array<range_type, 2> c_r;
+            _visit_2d(v, r, c_v, c_r, rank_off[v.level]);
 
             if (!sdsl::empty(get<0>(c_r)) and  vlb < mid and mid) {
                 _range_search_2d(get<0>(c_v),get<0>(c_r), vlb,
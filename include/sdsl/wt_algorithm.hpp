@@ -2,7 +2,11 @@
 #define INCLUDED_SDSL_WT_ALGORITHM
 
 #include <algorithm>
+#include <queue>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+#include "scratch_pool.hpp"
 #include "wt_helper.hpp"
 
 namespace sdsl
@@ -36,7 +40,8 @@ intersect(const t_wt& wt, const std::vector<range_type>& ranges, typename t_wt::
     using value_type     = typename t_wt::value_type;
     using node_type      = typename t_wt::node_type;
     using pnvr_type      = std::pair<node_type, range_vec_type>;
-    typedef std::stack<pnvr_type> stack_type;
+    // the stack is query-local scratch; see scratch_pool.hpp
+    typedef std::stack<pnvr_type, scratch_vector<pnvr_type>> stack_type;
 
     static_assert(has_expand<t_wt, std::array<node_type,2>(const node_type&)>::value,
                   "intersect requires t_wt to have expand(const node_type&)");
@@ -59,7 +64,7 @@ intersect(const t_wt& wt, const std::vector<range_type>& ranges, typename t_wt::
 
     t = (t==0) ? ranges.size() : t;
 
-    std::stack<pnvr_type> stack;
+    stack_type stack;
     stack.emplace(pnvr_type(wt.root(), ranges));
 
     while (!stack.empty()) {
@@ -86,6 +91,82 @@ intersect(const t_wt& wt, const std::vector<range_type>& ranges, typename t_wt::
 }
 
 
+// recursive internal version of intersect_adaptive; a and b are non-empty
+template<class t_wt>
+void
+_intersect_adaptive(const t_wt& wt, const typename t_wt::node_type& v,
+                    range_type a, range_type b,
+                    std::vector<std::pair<typename t_wt::value_type,
+                    typename t_wt::size_type>>& res)
+{
+    using std::get;
+    if (wt.is_leaf(v)) {
+        res.emplace_back(wt.sym(v), size(a) + size(b));
+        return;
+    }
+    // the roles may flip while the ranges shrink at different speeds
+    if (size(a) > size(b)) {
+        std::swap(a, b);
+    }
+    auto child   = wt.expand(v);
+    auto a_child = wt.expand(v, a); // expand the driver first
+    // descend only where the driver survives and the larger range is
+    // non-empty as well; everything else is skipped without being expanded
+    auto b_child = wt.expand(v, b);
+    if (!empty(get<0>(a_child)) and !empty(get<0>(b_child))) {
+        _intersect_adaptive(wt, get<0>(child),
+                            get<0>(a_child), get<0>(b_child), res);
+    }
+    if (!empty(get<1>(a_child)) and !empty(get<1>(b_child))) {
+        _intersect_adaptive(wt, get<1>(child),
+                            get<1>(a_child), get<1>(b_child), res);
+    }
+}
+
+//! Adaptive intersection of the elements in WT[s_0,e_0] and WT[s_1,e_1].
+/*! \param wt     The wavelet tree object.
+ *  \param a      The first range.
+ *  \param b      The second range.
+ *  \param cutoff Skew threshold of the heuristic: the adaptive traversal
+ *                is used when one range is at least `cutoff` times longer
+ *                than the other, otherwise the uniform intersect() does
+ *                the work. Default: 16.
+ *  \return       A vector containing (value, frequency) of the values
+ *                occurring in both ranges; frequency is the accumulated
+ *                frequency in both ranges. The tuples are ordered
+ *                according to value, if t_wt::lex_ordered=1.
+ *
+ *  Equivalent to intersect(wt, {a, b}), but for skewed pairs (a rare term
+ *  against a common one, the dominant case in posting-list ranked-AND) the
+ *  traversal is driven by the smaller range: subtrees are entered only
+ *  where the smaller range survives and the larger range is checked for
+ *  emptiness before any descent, so most of the tree is skipped. The
+ *  recursion works on plain ranges, avoiding the per-node range-vector and
+ *  stack bookkeeping of the general k-range intersect().
+ */
+template<class t_wt>
+std::vector< std::pair<typename t_wt::value_type, typename t_wt::size_type> >
+intersect_adaptive(const t_wt& wt, range_type a, range_type b,
+                   typename t_wt::size_type cutoff=16)
+{
+    using node_type = typename t_wt::node_type;
+    static_assert(has_expand<t_wt, std::array<node_type,2>(const node_type&)>::value,
+                  "intersect_adaptive requires t_wt to have expand(const node_type&)");
+
+    std::vector< std::pair<typename t_wt::value_type, typename t_wt::size_type> > res;
+    if (empty(a) or empty(b)) {
+        return res;
+    }
+    if (size(a) > size(b)) {
+        std::swap(a, b);
+    }
+    if (size(b) < cutoff * size(a)) { // balanced pair: expansion work is
+        return intersect(wt, {a, b}); // symmetric anyway
+    }
+    _intersect_adaptive(wt, wt.root(), a, b, res);
+    return res;
+}
+
 //! Returns the q-th smallest element and its frequency in wt[lb..rb].
 /*! \param wt The wavelet tree.
  *  \param lb Left array bound in T
@@ -124,6 +205,245 @@ quantile_freq(const t_wt& wt, typename t_wt::size_type lb,
     return {wt.sym(v), size(r)};
 }
 
+//! Returns the m most frequent values in wt[lb..rb] with their counts.
+/*! \param wt The wavelet tree.
+ *  \param lb Left array bound in T.
+ *  \param rb Right array bound in T.
+ *  \param m  Maximal number of values to report.
+ *  \return   A vector of (value, frequency) pairs, frequencies
+ *            non-increasing; less than m pairs if the range holds
+ *            fewer distinct values.
+ *
+ *  Output-bounded alternative to interval_symbols for faceting-style
+ *  queries: a priority queue traverses the tree in decreasing
+ *  interval-size order. The interval size of a node bounds the
+ *  frequency of every value below it, so when a leaf reaches the top
+ *  of the queue its count is at least that of everything unexplored
+ *  and it is reported immediately; after m reports all remaining
+ *  nodes are pruned unexpanded. Only nodes whose interval is larger
+ *  than the m-th largest frequency are ever expanded - for the skewed
+ *  distributions of faceting workloads that is \f$ \Order{m
+ *  \log\sigma} \f$ expansions instead of one per distinct value; for
+ *  flat distributions the bound degrades towards interval_symbols.
+ */
+template<class t_wt>
+std::vector< std::pair<typename t_wt::value_type, typename t_wt::size_type> >
+top_m_symbols(const t_wt& wt, typename t_wt::size_type lb,
+              typename t_wt::size_type rb, typename t_wt::size_type m)
+{
+    using std::get;
+    using size_type  = typename t_wt::size_type;
+    using value_type = typename t_wt::value_type;
+    using node_type  = typename t_wt::node_type;
+    static_assert(has_expand<t_wt, std::array<node_type,2>(const node_type&)>::value,
+                  "top_m_symbols requires t_wt to have expand(const node_type&)");
+
+    struct entry {
+        size_type  sz;
+        node_type  v;
+        range_type r;
+        bool operator<(const entry& e)const { return sz < e.sz; }
+    };
+    std::vector<std::pair<value_type, size_type>> res;
+    if (0 == m or lb > rb) {
+        return res;
+    }
+    std::priority_queue<entry, std::vector<entry>> pq;
+    pq.push(entry{rb-lb+1, wt.root(), {{lb, rb}}});
+    while (!pq.empty() and res.size() < m) {
+        entry e = pq.top();
+        pq.pop();
+        if (wt.is_leaf(e.v)) {
+            res.emplace_back(wt.sym(e.v), e.sz);
+            continue;
+        }
+        auto child        = wt.expand(e.v);
+        auto child_ranges = wt.expand(e.v, e.r);
+        if (!empty(get<0>(child_ranges))) {
+            pq.push(entry{size(get<0>(child_ranges)),
+                          get<0>(child), get<0>(child_ranges)});
+        }
+        if (!empty(get<1>(child_ranges))) {
+            pq.push(entry{size(get<1>(child_ranges)),
+                          get<1>(child), get<1>(child_ranges)});
+        }
+    }
+    return res;
+}
+
+//! Incremental quantile engine for overlapping ranges on the same WT.
+/*! Answers quantile queries for a sliding window wt[lb..rb]. Instead of
+ *  descending the wavelet tree with two rank queries per level for every
+ *  (lb, rb, q) triple, the engine maintains the number of window elements
+ *  below each touched tree node in one hash map per level. Moving a window
+ *  bound by one position updates the counts along a single root-to-leaf
+ *  path (one access on the wavelet tree plus \f$\Order{\log|\Sigma|}\f$
+ *  hash updates), and a quantile query walks down the counts with plain
+ *  arithmetic - no rank call at all. For windows which move by \f$d\f$
+ *  positions between queries this replaces a full descent by
+ *  \f$\Order{d\log|\Sigma|}\f$ delta work.
+ *
+ *  \tparam t_wt Wavelet tree over an integer alphabet whose levels consume
+ *               the bits of the value from MSB to LSB, e.g. wt_int or
+ *               wm_int (the engine keys its counts by value prefixes of
+ *               max_level bits).
+ */
+template<class t_wt>
+class quantile_window
+{
+    public:
+        typedef typename t_wt::size_type  size_type;
+        typedef typename t_wt::value_type value_type;
+
+    private:
+        const t_wt* m_wt = nullptr;
+        size_type   m_lb = 0;  // current window [m_lb..m_rb)
+        size_type   m_rb = 0;
+        // counts of window elements per value prefix, one map per level
+        std::vector<std::unordered_map<uint64_t, size_type>> m_cnt;
+
+        void add(size_type i)
+        {
+            uint64_t x = (*m_wt)[i];
+            const uint32_t levels = m_wt->max_level;
+            for (uint32_t l=0; l < levels; ++l) {
+                ++m_cnt[l][x>>(levels-1-l)];
+            }
+        }
+
+        void remove(size_type i)
+        {
+            uint64_t x = (*m_wt)[i];
+            const uint32_t levels = m_wt->max_level;
+            for (uint32_t l=0; l < levels; ++l) {
+                auto it = m_cnt[l].find(x>>(levels-1-l));
+                if (0 == --(it->second)) {
+                    m_cnt[l].erase(it);
+                }
+            }
+        }
+
+    public:
+        //! Constructor
+        /*! \param wt The supported wavelet tree; has to outlive the engine. */
+        quantile_window(const t_wt& wt) : m_wt(&wt), m_cnt(wt.max_level) {}
+
+        //! Returns the size of the current window.
+        size_type size() const
+        {
+            return m_rb - m_lb;
+        }
+
+        //! Moves the window to wt[lb..rb].
+        /*! \param lb Left window bound.
+         *  \param rb Right window bound (inclusive), \f$ rb < wt.size() \f$.
+         *  If the new window overlaps the current one only the entering and
+         *  leaving positions are processed; otherwise the counts are
+         *  rebuilt from scratch.
+         */
+        void set_window(size_type lb, size_type rb)
+        {
+            assert(lb <= rb and rb < m_wt->size());
+            size_type b = lb, e = rb+1;
+            if (e <= m_lb or m_rb <= b) { // no overlap: rebuild
+                for (auto& m : m_cnt) {
+                    m.clear();
+                }
+                m_lb = m_rb = b;
+            }
+            while (m_lb < b)  remove(m_lb++);
+            while (m_lb > b)  add(--m_lb);
+            while (m_rb < e)  add(m_rb++);
+            while (m_rb > e)  remove(--m_rb);
+        }
+
+        //! Returns the q-th smallest element and its frequency in the window.
+        /*! \param q q-th smallest element ('quantile'), 0-based indexed,
+         *           \f$ q < size() \f$.
+         *  \par Time complexity
+         *       \f$ \Order{\log|\Sigma|} \f$ hash lookups, no rank queries.
+         */
+        std::pair<value_type, size_type> quantile(size_type q) const
+        {
+            assert(q < size());
+            const uint32_t levels = m_wt->max_level;
+            uint64_t p = 0;
+            for (uint32_t l=0; l < levels; ++l) {
+                uint64_t left = p<<1;
+                auto it = m_cnt[l].find(left);
+                size_type zeros = (it == m_cnt[l].end()) ? 0 : it->second;
+                if (q < zeros) {
+                    p = left;
+                } else {
+                    q -= zeros;
+                    p = left|1;
+                }
+            }
+            return {p, m_cnt[levels-1].at(p)};
+        }
+};
+
+template<class t_wt>
+void
+_range_majority_rec(const t_wt& wt, const typename t_wt::node_type& v,
+                    range_type r, double threshold,
+                    std::vector<std::pair<typename t_wt::value_type,
+                    typename t_wt::size_type>>& res)
+{
+    using std::get;
+    if (wt.is_leaf(v)) {
+        res.emplace_back(wt.sym(v), size(r));
+        return;
+    }
+    auto child        = wt.expand(v);
+    auto child_ranges = wt.expand(v, r);
+    if (size(get<0>(child_ranges)) > threshold) {
+        _range_majority_rec(wt, get<0>(child), get<0>(child_ranges),
+                            threshold, res);
+    }
+    if (size(get<1>(child_ranges)) > threshold) {
+        _range_majority_rec(wt, get<1>(child), get<1>(child_ranges),
+                            threshold, res);
+    }
+}
+
+//! Returns all symbols occurring more than alpha*(rb-lb+1) times in wt[lb..rb].
+/*! \param wt    The wavelet tree.
+ *  \param lb    Left array bound in T.
+ *  \param rb    Right array bound in T.
+ *  \param alpha Relative frequency threshold, \f$0 < alpha \leq 1\f$.
+ *               Default 0.5, i.e. the classic range majority.
+ *  \return      A vector of (value, frequency) pairs with frequency
+ *               \f$> \alpha\cdot(rb-lb+1)\f$, ordered by value if
+ *               t_wt::lex_ordered=1.
+ *
+ *  An alpha-majority keeps more than \f$\alpha\cdot n\f$ occurrences in
+ *  the mapped range of every node on its root-to-leaf path, so subtrees
+ *  whose range does not exceed the threshold are pruned and at most
+ *  \f$\lfloor 1/\alpha \rfloor\f$ nodes survive per level.
+ */
+template<class t_wt>
+std::vector<std::pair<typename t_wt::value_type, typename t_wt::size_type>>
+range_majority(const t_wt& wt, typename t_wt::size_type lb,
+               typename t_wt::size_type rb, double alpha=0.5)
+{
+    using node_type = typename t_wt::node_type;
+    static_assert(has_expand<t_wt, std::array<node_type,2>(const node_type&)>::value,
+                  "range_majority requires t_wt to have expand(const node_type&)");
+    assert(alpha > 0);
+
+    std::vector<std::pair<typename t_wt::value_type, typename t_wt::size_type>> res;
+    if (lb > rb or rb >= wt.size()) {
+        return res;
+    }
+    double threshold = alpha * (rb-lb+1);
+    range_type r {{lb, rb}};
+    if (size(r) > threshold) {
+        _range_majority_rec(wt, wt.root(), r, threshold, res);
+    }
+    return res;
+}
+
 
 template<class t_wt>
 void
@@ -497,6 +817,151 @@ symbol_gte(const t_wt& wt, typename t_wt::value_type c)
     return _symbols_calls_wt<t_wt, has_own>::call_symbol_gte(wt,c);
 }
 
+//! Returns the smallest value greater or equal x in wt[lb..rb].
+/*! \param wt The wavelet tree.
+ *  \param lb Left array bound in T.
+ *  \param rb Right array bound in T.
+ *  \param x  The threshold value.
+ *  \return A pair. The first element of the pair constitutes if a value
+ *          greater or equal x occurs in wt[lb..rb] (true) or not (false).
+ *          The second element contains the smallest such value.
+ *  \par Time complexity
+ *       \f$ \Order{\log |\Sigma|} \f$
+ */
+template<class t_wt>
+std::pair<bool,typename t_wt::value_type>
+range_successor(const t_wt& wt, typename t_wt::size_type lb,
+                typename t_wt::size_type rb, typename t_wt::value_type x)
+{
+    using std::get;
+    using node_type = typename t_wt::node_type;
+    static_assert(t_wt::lex_ordered,
+                  "range_successor requires a lex_ordered WT");
+    static_assert(has_expand<t_wt, std::array<node_type,2>(const node_type&)>::value,
+                  "range_successor requires t_wt to have expand(const node_type&)");
+
+    if (lb > rb or ((1ULL) << (wt.max_level)) <= x) {
+        // empty range or x is greater than any symbol in wt
+        return {false, 0};
+    }
+    auto node = wt.root();
+    range_type r {{lb, rb}};
+    auto successor_subtree = node;   // deepest passed-over right sibling
+    range_type successor_range {{1, 0}};
+    uint64_t mask = (1ULL) << (wt.max_level - 1);
+    while (!wt.is_leaf(node)) {
+        auto children     = wt.expand(node);
+        auto child_ranges = wt.expand(node, r);
+        if (x & (mask >> node.level)) { // go right
+            if (!empty(get<1>(child_ranges))) {
+                node = get<1>(children);
+                r    = get<1>(child_ranges);
+            } else { // dead end
+                if (empty(successor_range)) {
+                    // no valid successor. x must be bigger than the
+                    // largest value in wt[lb..rb].
+                    return {false, 0};
+                }
+                // continue with the minimum of the passed-over subtree
+                node = successor_subtree;
+                r    = successor_range;
+                successor_range = {{1, 0}};
+                x = 0;
+            }
+        } else { // go left
+            if (!empty(get<0>(child_ranges))) {
+                node = get<0>(children);
+                r    = get<0>(child_ranges);
+                if (!empty(get<1>(child_ranges))) {
+                    // potential successor subtree?
+                    successor_subtree = get<1>(children);
+                    successor_range   = get<1>(child_ranges);
+                }
+            } else { // dead end
+                // right range can't be empty if the left one is
+                node = get<1>(children);
+                r    = get<1>(child_ranges);
+                x = 0;
+            }
+        }
+    }
+    return {true, node.sym};
+}
+
+//! Returns the largest value smaller or equal x in wt[lb..rb].
+/*! \param wt The wavelet tree.
+ *  \param lb Left array bound in T.
+ *  \param rb Right array bound in T.
+ *  \param x  The threshold value.
+ *  \return A pair. The first element of the pair constitutes if a value
+ *          smaller or equal x occurs in wt[lb..rb] (true) or not (false).
+ *          The second element contains the largest such value.
+ *  \par Time complexity
+ *       \f$ \Order{\log |\Sigma|} \f$
+ */
+template<class t_wt>
+std::pair<bool,typename t_wt::value_type>
+range_predecessor(const t_wt& wt, typename t_wt::size_type lb,
+                  typename t_wt::size_type rb, typename t_wt::value_type x)
+{
+    using std::get;
+    using node_type = typename t_wt::node_type;
+    static_assert(t_wt::lex_ordered,
+                  "range_predecessor requires a lex_ordered WT");
+    static_assert(has_expand<t_wt, std::array<node_type,2>(const node_type&)>::value,
+                  "range_predecessor requires t_wt to have expand(const node_type&)");
+
+    if (lb > rb) {
+        return {false, 0};
+    }
+    if (((1ULL) << (wt.max_level)) <= x) {
+        // x is greater than any symbol in wt. search for the largest one!
+        x = sdsl::bits::lo_set[wt.max_level];
+    }
+    auto node = wt.root();
+    range_type r {{lb, rb}};
+    auto predecessor_subtree = node;  // deepest passed-over left sibling
+    range_type predecessor_range {{1, 0}};
+    uint64_t mask = (1ULL) << (wt.max_level - 1);
+    while (!wt.is_leaf(node)) {
+        auto children     = wt.expand(node);
+        auto child_ranges = wt.expand(node, r);
+        if (x & (mask >> node.level)) { // go right
+            if (!empty(get<1>(child_ranges))) {
+                node = get<1>(children);
+                r    = get<1>(child_ranges);
+                if (!empty(get<0>(child_ranges))) {
+                    // potential predecessor subtree?
+                    predecessor_subtree = get<0>(children);
+                    predecessor_range   = get<0>(child_ranges);
+                }
+            } else { // dead end
+                // left range can't be empty if the right one is
+                node = get<0>(children);
+                r    = get<0>(child_ranges);
+                x = sdsl::bits::all_set;
+            }
+        } else { // go left
+            if (!empty(get<0>(child_ranges))) {
+                node = get<0>(children);
+                r    = get<0>(child_ranges);
+            } else { // dead end
+                if (empty(predecessor_range)) {
+                    // no valid predecessor. x must be smaller than the
+                    // smallest value in wt[lb..rb].
+                    return {false, 0};
+                }
+                // continue with the maximum of the passed-over subtree
+                node = predecessor_subtree;
+                r    = predecessor_range;
+                predecessor_range = {{1, 0}};
+                x = sdsl::bits::all_set;
+            }
+        }
+    }
+    return {true, node.sym};
+}
+
 //! Returns for a x range [x_i,x_j] and a value range [y_i,y_j] all unique y
 //! values occuring in [x_i,x_j] in ascending order.
 /*! \param x_i lower bound of the x range
@@ -548,7 +1013,8 @@ restricted_unique_range_values(const t_wt& wt,
         return 0;
     };
 
-    std::stack<std::tuple<typename t_wt::node_type,sdsl::range_type,uint64_t,uint64_t>> stack;
+    typedef std::tuple<typename t_wt::node_type,sdsl::range_type,uint64_t,uint64_t> stack_entry;
+    std::stack<stack_entry, scratch_vector<stack_entry>> stack;
     sdsl::range_type initial_range = {x_i,x_j};
     stack.emplace(wt.root(),initial_range,0,0);
     while (!stack.empty()) {
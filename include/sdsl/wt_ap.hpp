@@ -26,6 +26,8 @@
 #include <sdsl/int_vector.hpp>
 #include <sdsl/int_vector_buffer.hpp>
 #include <sdsl/vectors.hpp>
+#include <atomic>
+#include <thread>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -110,9 +112,13 @@ class wt_ap
         //! Semi-external constructor
         /*! \param buf         File buffer of the int_vector for which the wt_ap should be build.
          *  \param size        Size of the prefix of v, which should be indexed.
+         *  \param num_threads Number of threads used to classify the input
+         *                     and to build the class and per-class wavelet
+         *                     trees. Values <= 1 build sequentially.
          */
         template<uint8_t int_width>
-        wt_ap(int_vector_buffer<int_width>& buf, size_type size) : m_size(size)
+        wt_ap(int_vector_buffer<int_width>& buf, size_type size,
+              uint32_t num_threads = std::thread::hardware_concurrency()) : m_size(size)
         {
             if (buf.size() < m_size) {
                 throw std::logic_error("n="+util::to_string(buf.size())+" < "+util::to_string(m_size)+"=m_size");
@@ -178,6 +184,21 @@ class wt_ap
                 construct_im(m_char2class, m_char2class_buffer);
             }
 
+            // class offset of each character, equal to
+            // m_char2class.rank(ch, class of ch); precomputed so the
+            // classification pass below does two array lookups per symbol
+            // instead of a wavelet tree rank per occurrence
+            int_vector<> char2offset(max_symbol, 0, bits::hi(m_sigma+1)+1);
+            {
+                std::vector<value_type> class_fill(m_class_cnt, 0);
+                for (value_type ch=0; ch < max_symbol; ++ch) {
+                    value_type cl = m_char2class_buffer[ch];
+                    if (cl < m_class_cnt) {
+                        char2offset[ch] = class_fill[cl]++;
+                    }
+                }
+            }
+
             // calculate text-order classes and offsets
             std::string temp_file_class = buf.filename()
                                           + "_wt_ap_class_"
@@ -186,36 +207,101 @@ class wt_ap
             int_vector_buffer<wt_byte_width> class_buffer(temp_file_class, std::ios::out, 1024*1024, bits::hi(m_class_cnt)+1);
             {
                 auto event = memory_monitor::event("write class and offset");
-                for (size_type i=0; i < m_size; ++i) {
-                    value_type ch = buf[i];
-                    value_type cl = m_char2class_buffer[ch];
-                    class_buffer.push_back(cl);
-                    if (cl >= m_singleton_class_cnt) {
-                        value_type offset = m_char2class.rank(ch, cl);
-                        cl -= m_singleton_class_cnt;
-                        temp_file_offset_buffers[cl].second.push_back(offset);
+                const size_type batch_size = 1ULL<<21;
+                if (num_threads > 1 and m_size >= 2*batch_size) {
+                    // read the input in batches; the symbols of a batch are
+                    // classified by all threads in parallel and the
+                    // resulting blocks appended in text order
+                    int_vector<> chunk(batch_size, 0, buf.width());
+                    std::vector<std::vector<uint64_t>> cls(num_threads);
+                    std::vector<std::vector<std::vector<uint64_t>>> offs(num_threads,
+                            std::vector<std::vector<uint64_t>>(m_class_cnt-m_singleton_class_cnt));
+                    for (size_type pos=0; pos < m_size; pos += batch_size) {
+                        size_type len = std::min(batch_size, m_size-pos);
+                        for (size_type j=0; j < len; ++j) {
+                            chunk[j] = buf[pos+j];
+                        }
+                        size_type per_thread = (len+num_threads-1)/num_threads;
+                        std::vector<std::thread> workers;
+                        for (uint32_t t=0; t < num_threads; ++t) {
+                            workers.emplace_back([&,t]() {
+                                size_type a = std::min((size_type)t*per_thread, len);
+                                size_type b = std::min(a+per_thread, len);
+                                for (size_type j=a; j < b; ++j) {
+                                    value_type ch = chunk[j];
+                                    value_type cl = m_char2class_buffer[ch];
+                                    cls[t].push_back(cl);
+                                    if (cl >= m_singleton_class_cnt) {
+                                        offs[t][cl-m_singleton_class_cnt].push_back(char2offset[ch]);
+                                    }
+                                }
+                            });
+                        }
+                        for (auto& w : workers) {
+                            w.join();
+                        }
+                        for (uint32_t t=0; t < num_threads; ++t) {
+                            class_buffer.append(cls[t]);
+                            cls[t].clear();
+                            for (value_type i=0; i < offs[t].size(); ++i) {
+                                temp_file_offset_buffers[i].second.append(offs[t][i]);
+                                offs[t][i].clear();
+                            }
+                        }
+                    }
+                } else {
+                    for (size_type i=0; i < m_size; ++i) {
+                        value_type ch = buf[i];
+                        value_type cl = m_char2class_buffer[ch];
+                        class_buffer.push_back(cl);
+                        if (cl >= m_singleton_class_cnt) {
+                            temp_file_offset_buffers[cl-m_singleton_class_cnt].second.push_back(char2offset[ch]);
+                        }
                     }
                 }
                 class_buffer.close();
             }
 
             {
-                auto event = memory_monitor::event("class WT");
-                int_vector_buffer<wt_byte_width> class_buffer(temp_file_class);
-                m_class = wt_byte_type(class_buffer, class_buffer.size());
-            }
-            sdsl::remove(temp_file_class);
-            {
-                auto event = memory_monitor::event("offset WTs");
-                m_offset.resize(m_class_cnt-m_singleton_class_cnt);
-                for (value_type i=0; i < m_class_cnt-m_singleton_class_cnt; ++i) {
-                    auto& temp_file_offset_buffer = temp_file_offset_buffers[i];
-                    temp_file_offset_buffer.second.close();
-                    {
-                        int_vector_buffer<wt_int_width> offset_buffer(temp_file_offset_buffer.first);
+                auto event = memory_monitor::event("class and offset WTs");
+                value_type offset_cnt = m_class_cnt-m_singleton_class_cnt;
+                m_offset.resize(offset_cnt);
+                for (value_type i=0; i < offset_cnt; ++i) {
+                    temp_file_offset_buffers[i].second.close();
+                }
+                // the class tree and the per-class offset trees are built
+                // from separate temporary files and are independent
+                auto build = [&](value_type i) {
+                    if (i == offset_cnt) {
+                        int_vector_buffer<wt_byte_width> class_buffer(temp_file_class);
+                        m_class = wt_byte_type(class_buffer, class_buffer.size());
+                    } else {
+                        int_vector_buffer<wt_int_width> offset_buffer(temp_file_offset_buffers[i].first);
                         m_offset[i] = wt_int_type(offset_buffer, offset_buffer.size());
                     }
-                    sdsl::remove(temp_file_offset_buffer.first);
+                };
+                if (num_threads > 1 and offset_cnt > 0) {
+                    std::atomic<value_type> task(0);
+                    std::vector<std::thread> workers;
+                    for (uint32_t t=0; t < std::min<uint64_t>(num_threads, offset_cnt+1); ++t) {
+                        workers.emplace_back([&]() {
+                            value_type i;
+                            while ((i = task++) <= offset_cnt) {
+                                build(offset_cnt-i); // class tree (the biggest) first
+                            }
+                        });
+                    }
+                    for (auto& w : workers) {
+                        w.join();
+                    }
+                } else {
+                    for (value_type i=0; i <= offset_cnt; ++i) {
+                        build(i);
+                    }
+                }
+                sdsl::remove(temp_file_class);
+                for (value_type i=0; i < offset_cnt; ++i) {
+                    sdsl::remove(temp_file_offset_buffers[i].first);
                 }
             }
         }
@@ -330,6 +416,57 @@ class wt_ap
                    : m_offset[cl-m_singleton_class_cnt].rank(count, offset);
         };
 
+        //! Calculates rank for many queries at once, grouped by character class.
+        /*!
+         *  \param queries Vector of (i, c) pairs with \f$i\in[0..size()]\f$.
+         *  \returns Vector r with r[k] = rank(queries[k].first, queries[k].second).
+         *
+         *  The class and offset of each distinct symbol is resolved in
+         *  m_char2class only once, and the queries are then evaluated in
+         *  class order, so all queries hitting the same per-class offset
+         *  tree run back-to-back while its upper levels are cached.
+         */
+        std::vector<size_type>
+        rank_batch(const std::vector<std::pair<size_type, value_type>>& queries)const
+        {
+            std::vector<size_type> res(queries.size());
+            if (queries.empty()) {
+                return res;
+            }
+            // resolve class and offset once per distinct symbol
+            std::vector<size_type> order(queries.size());
+            for (size_type k=0; k < order.size(); ++k) order[k] = k;
+            std::sort(order.begin(), order.end(), [&queries](size_type a, size_type b) {
+                return queries[a].second < queries[b].second;
+            });
+            std::vector<std::tuple<bool, value_type, value_type>> resolved(queries.size());
+            for (size_type k=0; k < order.size(); ++k) {
+                if (k > 0 and queries[order[k]].second == queries[order[k-1]].second) {
+                    resolved[order[k]] = resolved[order[k-1]];
+                } else {
+                    resolved[order[k]] = try_get_char_class_offset(queries[order[k]].second);
+                }
+            }
+            // group the queries of each class together
+            std::stable_sort(order.begin(), order.end(), [&resolved](size_type a, size_type b) {
+                return std::get<1>(resolved[a]) < std::get<1>(resolved[b]);
+            });
+            for (size_type k : order) {
+                assert(queries[k].first <= size());
+                if (!std::get<0>(resolved[k])) {
+                    res[k] = 0;
+                    continue;
+                }
+                auto cl = std::get<1>(resolved[k]);
+                auto offset = std::get<2>(resolved[k]);
+                size_type count = m_class.rank(queries[k].first, cl);
+                res[k] = cl < m_singleton_class_cnt
+                         ? count
+                         : m_offset[cl-m_singleton_class_cnt].rank(count, offset);
+            }
+            return res;
+        }
+
         //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
         /*!
          *  \param i The index of the symbol.
@@ -26,6 +26,8 @@
 #include <sdsl/int_vector.hpp>
 #include <sdsl/int_vector_buffer.hpp>
 #include <sdsl/vectors.hpp>
+#include <algorithm>
+#include <vector>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -668,6 +670,38 @@ class wt_gmr
         uint64_t m_chunksize;
         uint64_t m_sigma = 0;
 
+        //! Picks a chunk size from the measured symbol distribution.
+        /*! Candidates are the powers of two starting at the classic choice
+         *  \f$2^{\lceil\log\sigma\rceil}\f$. Larger chunks shrink the two
+         *  indicator bitvectors (whose size grows with max_symbol times the
+         *  number of chunks, painful for sparse large alphabets) but widen
+         *  the permutation entries and lengthen the per-chunk occurrence
+         *  lists searched by rank. A candidate is accepted if it reduces
+         *  the estimated index size and the expected occurrence-list
+         *  length, \f$\sum_c n_c^2 / (n \cdot chunks)\f$ for a random
+         *  occurrence query, stays below the linear-search threshold used
+         *  in rank.
+         */
+        static uint64_t _tune_chunksize(uint64_t n, uint64_t max_symbol, double occ_sq_sum)
+        {
+            uint64_t j0 = bits::hi(max_symbol-1)+1;
+            uint64_t jmax = std::max(j0, n < 2 ? j0 : (uint64_t)bits::hi(n-1)+1);
+            uint64_t best_j = j0;
+            double best_bits = 0;
+            for (uint64_t j=j0; j<=jmax; ++j) {
+                uint64_t chunks = (n+(1ULL<<j)-1)>>j;
+                // two indicator bitvectors + the permutation
+                double est_bits = 2.0*(n+(double)max_symbol*chunks)+(double)n*j;
+                double exp_len = occ_sq_sum/((double)n*chunks);
+                if (j > j0 and exp_len > 50) break;
+                if (j == j0 or est_bits < best_bits) {
+                    best_bits = est_bits;
+                    best_j = j;
+                }
+            }
+            return 1ULL<<best_j;
+        }
+
     public:
 
         const size_type&       sigma = m_sigma;
@@ -678,16 +712,35 @@ class wt_gmr
         //! Semi-external constructor
         /*! \param buf         File buffer of the int_vector for which the wt_gmr should be build.
          *  \param size        Size of the prefix of v, which should be indexed.
+         *  \param chunksize   Size of the chunks the input is split into. If
+         *                     set to 0, the chunk size is tuned automatically
+         *                     from the measured symbol distribution (see
+         *                     _tune_chunksize).
          */
         template<uint8_t int_width>
-        wt_gmr(int_vector_buffer<int_width>& input, size_type size) : m_size(size)
+        wt_gmr(int_vector_buffer<int_width>& input, size_type size, uint64_t chunksize=0) : m_size(size)
         {
             // Determine max. symbol
             for (uint64_t i=0; i<m_size; ++i) {
                 if (m_max_symbol < input[i]) m_max_symbol = input[i];
             }
             ++m_max_symbol;
-            m_chunksize = (1ULL << (bits::hi(m_max_symbol-1)+1)); // In some cases this is better than m_max_smbol
+            if (chunksize > 0) {
+                m_chunksize = chunksize;
+            } else if (0 == m_size) {
+                m_chunksize = (1ULL << (bits::hi(m_max_symbol-1)+1));
+            } else {
+                // measure the symbol distribution and tune the chunk size
+                int_vector<> hist(m_max_symbol, 0, bits::hi(m_size)+1);
+                for (uint64_t i=0; i<m_size; ++i) {
+                    hist[input[i]] = hist[input[i]]+1;
+                }
+                double occ_sq_sum = 0;
+                for (uint64_t c=0; c<m_max_symbol; ++c) {
+                    occ_sq_sum += (double)hist[c]*hist[c];
+                }
+                m_chunksize = _tune_chunksize(m_size, m_max_symbol, occ_sq_sum);
+            }
             m_chunks = (m_size+m_chunksize-1)/m_chunksize;
 
             // calc m_bv_blocks
@@ -732,7 +785,7 @@ class wt_gmr
                 bit_vector x(m_size+m_chunks*m_max_symbol+1, 0);
 
                 // fill perm and m_bv_chunks for every chunk
-                int_vector<> perm(m_size, 0, bits::hi(m_max_symbol-1)+1);
+                int_vector<> perm(m_size, 0, bits::hi(m_chunksize-1)+1);
                 for (uint64_t i=0; i<m_chunks; ++i) {
                     int_vector<> symbols(m_max_symbol, 0, bits::hi(m_max_symbol-1)+2);
 
@@ -924,6 +977,51 @@ class wt_gmr
             return m_perm[pi_pos]+chunk*m_chunksize;
         }
 
+        //! Calculates the positions of many occurrences of the symbol c at once.
+        /*!
+         *  \param c     The symbol c.
+         *  \param ranks Occurrence ranks, each in \f$[1..rank(size(),c)]\f$.
+         *  \returns The position of the ranks[k]-th occurrence of c at
+         *           entry k, i.e. select(ranks[k], c).
+         *
+         *  The ranks are processed in increasing order, so the chunk
+         *  boundary information is computed once per touched chunk instead
+         *  of once per call, and the \f$\pi\f$ entries of occurrences in
+         *  the same chunk are read sequentially.
+         *  \par Time complexity
+         *       \f$ \Order{m + \mbox{touched chunks}} \f$ select queries
+         *       for \f$m\f$ ranks.
+         */
+        std::vector<size_type> select_batch(value_type c, const std::vector<size_type>& ranks)const
+        {
+            std::vector<size_type> res(ranks.size());
+            if (ranks.empty()) {
+                return res;
+            }
+            std::vector<size_type> order(ranks.size());
+            for (size_type k=0; k<order.size(); ++k) order[k] = k;
+            std::sort(order.begin(), order.end(), [&ranks](size_type a, size_type b) {
+                return ranks[a] < ranks[b];
+            });
+
+            uint64_t ones_before_c = m_bv_blocks_select0(c*m_chunks+1)-(c*m_chunks);
+            uint64_t chunk = 0, c_ones_before_chunk = 0, c_ones_in_chunk = 0, pi_base = 0;
+            bool chunk_valid = false;
+            for (size_type k : order) {
+                size_type i = ranks[k];
+                assert(1 <= i and i <= rank(size(), c));
+                if (!chunk_valid or i > c_ones_before_chunk+c_ones_in_chunk) {
+                    chunk = m_bv_blocks_select1(ones_before_c+i)-ones_before_c-(c*m_chunks+1)-i+1;
+                    c_ones_before_chunk = m_bv_blocks_select0(c*m_chunks+chunk+1)-(c*m_chunks+chunk)-ones_before_c;
+                    c_ones_in_chunk = m_bv_blocks_select0(c*m_chunks+chunk+2)-m_bv_blocks_select0(c*m_chunks+chunk+1)-1;
+                    pi_base = m_bv_chunks_select0(chunk*m_max_symbol+c+1)-chunk*m_max_symbol-c-1;
+                    chunk_valid = true;
+                }
+                res[k] = m_perm[pi_base+(i-c_ones_before_chunk)]+chunk*m_chunksize;
+            }
+            return res;
+        }
+
         //! Serializes the data structure into the given ostream
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
         {
@@ -2,6 +2,7 @@
 #define INCLUDED_SDSL_WT_HELPER
 
 #include "int_vector.hpp"
+#include "int_vector_buffer.hpp"
 #include <algorithm>
 #include <limits>
 #include <deque>
@@ -48,6 +49,35 @@ void calculate_character_occurences(t_file_buffer& text, const int_vector_size_t
 }
 
 
+//! Private read access to the input sequence for one construction thread.
+/*! For in-memory containers the generic version simply shares the
+ *  container, as concurrent reads are safe. The specialization for
+ *  int_vector_buffer reopens the underlying file, since a buffer keeps
+ *  a single window into the file and cannot be scanned by several
+ *  threads at once.
+ */
+template<class t_data>
+struct wt_thread_access {
+    const t_data& m_seq;
+    wt_thread_access(const t_data& seq) : m_seq(seq) {}
+    uint64_t operator[](int_vector_size_type i)
+    {
+        return m_seq[i];
+    }
+};
+
+template<uint8_t t_width>
+struct wt_thread_access<int_vector_buffer<t_width>> {
+    int_vector_buffer<t_width> m_seq;
+    wt_thread_access(const int_vector_buffer<t_width>& seq) :
+        m_seq(seq.filename(), std::ios::in, 1024*1024, seq.width(),
+              seq.is_plain(), seq.file_offset()) {}
+    uint64_t operator[](int_vector_size_type i)
+    {
+        return m_seq[i];
+    }
+};
+
 template<class t_rac, class sigma_type>
 void calculate_effective_alphabet_size(const t_rac& C, sigma_type& sigma)
 {
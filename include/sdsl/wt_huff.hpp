@@ -23,13 +23,15 @@
 #define INCLUDED_SDSL_WT_HUFF
 
 #include "wt_pc.hpp"
+#include "bit_vector_il.hpp"
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
 {
 
-// forward declaration
+// forward declarations
 struct huff_shape;
+struct huff_freq_shape;
 
 //! A Huffman-shaped wavelet tree.
 /*!
@@ -77,6 +79,52 @@ using wt_huff = wt_pc<huff_shape,
       t_select_zero,
       t_tree_strat>;
 
+//! A Huffman-shaped wavelet tree with a cache-friendly interleaved layout.
+/*!
+ * Specialization of wt_huff which stores the concatenated level bit vector
+ * as a bit_vector_il, i.e. the bit data is interleaved with cumulative rank
+ * samples every t_bs bits. The rank sample needed by a descent step then
+ * lies in the same memory region as the bits it covers, so each of the
+ * rank calls on the way down the tree touches one contiguous block instead
+ * of the distant sample arrays of a separate rank structure.
+ *
+ * \tparam t_bs Block size of the interleaved bitvector in bits.
+ *              t_bs has to be a power of 2 and t_bs >= 64.
+ *
+ *  @ingroup wt
+ */
+template<uint32_t t_bs = 512>
+using wt_huff_il = wt_pc<huff_shape,
+      bit_vector_il<t_bs>,
+      rank_support_il<1, t_bs>,
+      select_support_il<1, t_bs>,
+      select_support_il<0, t_bs>,
+      byte_tree<> >;
+
+//! A canonical-Huffman-shaped wavelet tree with frequency-clustered codes.
+/*!
+ * Specialization of wt_huff which keeps the Huffman code lengths (and thus
+ * the entropy-optimal depths and the size of the bit vector) but assigns
+ * the codes canonically with the symbols of each length ordered by
+ * decreasing frequency. Consecutive codes share their upper bits, so the
+ * hottest symbols travel through the same shallow leftmost subtree and the
+ * working set of a skewed query mix stays cache-resident, instead of being
+ * scattered over the tree by the merge order of the Huffman construction.
+ *
+ *  @ingroup wt
+ */
+template<class t_bitvector   = bit_vector,
+         class t_rank        = typename t_bitvector::rank_1_type,
+         class t_select      = typename t_bitvector::select_1_type,
+         class t_select_zero = typename t_bitvector::select_0_type,
+         class t_tree_strat  = byte_tree<> >
+using wt_huff_freq = wt_pc<huff_freq_shape,
+      t_bitvector,
+      t_rank,
+      t_select,
+      t_select_zero,
+      t_tree_strat>;
+
 // Huffman shape for wt_pc
 template<class t_wt>
 struct _huff_shape {
@@ -122,6 +170,118 @@ struct huff_shape {
     using type = _huff_shape<t_wt>;
 };
 
+// Canonical Huffman shape with frequency-clustered code assignment
+template<class t_wt>
+struct _huff_freq_shape {
+    typedef typename t_wt::size_type         size_type;
+    typedef std::pair<size_type, size_type>  tPII;    // (freq, nodenr)-pair
+    typedef std::priority_queue
+    <tPII, std::vector<tPII>,
+    std::greater<tPII>>                      tMPQPII; // min priority queue
+    enum { lex_ordered = 0 };
+
+    // one symbol of the canonical code
+    struct code_entry {
+        uint64_t len;  // code length = depth of the leaf
+        uint64_t code; // canonical code, MSB first
+        uint64_t freq;
+        uint64_t sym;
+    };
+
+    template<class t_rac>
+    static void
+    construct_tree(t_rac& C, std::vector<pc_node>& temp_nodes) {
+        // (1) classic Huffman merge, only to obtain the code lengths
+        std::vector<pc_node> huff_nodes;
+        tMPQPII pq;
+        size_type c = 0;
+        std::for_each(std::begin(C), std::end(C), [&](decltype(*std::begin(C)) &freq) {
+            if (freq > 0) {
+                pq.push(tPII(freq, huff_nodes.size()));
+                huff_nodes.emplace_back(pc_node(freq, c));
+            }
+            ++c;
+        });
+        size_type sigma = huff_nodes.size();
+        while (pq.size() > 1) {
+            tPII v1, v2;
+            v1 = pq.top(); pq.pop();
+            v2 = pq.top(); pq.pop();
+            huff_nodes[v1.second].parent = huff_nodes.size();
+            huff_nodes[v2.second].parent = huff_nodes.size();
+            pq.push(tPII(v1.first+v2.first, huff_nodes.size()));
+            huff_nodes.emplace_back(pc_node(v1.first+v2.first, 0,
+                                            pc_node::undef, v1.second, v2.second));
+        }
+        if (0 == sigma) {
+            return;
+        }
+        // (2) sort the symbols by (code length, frequency descending), so
+        //     the most frequent symbols of every length come first
+        std::vector<code_entry> entries(sigma);
+        for (size_type i=0; i < sigma; ++i) {
+            uint64_t len = 0;
+            for (uint64_t v=i; huff_nodes[v].parent != pc_node::undef;
+                 v = huff_nodes[v].parent) {
+                ++len;
+            }
+            entries[i] = {len, 0, huff_nodes[i].freq, huff_nodes[i].sym};
+        }
+        std::sort(entries.begin(), entries.end(),
+        [](const code_entry& a, const code_entry& b) {
+            if (a.len != b.len)
+                return a.len < b.len;
+            if (a.freq != b.freq)
+                return a.freq > b.freq;
+            return a.sym < b.sym;
+        });
+        // (3) assign canonical codes in this order; consecutive symbols get
+        //     numerically adjacent codes, so the hottest symbols share the
+        //     shallow leftmost subtrees
+        uint64_t code = 0, prev_len = entries[0].len;
+        for (size_type i=0; i < sigma; ++i) {
+            code <<= (entries[i].len - prev_len);
+            entries[i].code = code++;
+            prev_len = entries[i].len;
+        }
+        // (4) build the prefix tree of the codes; children are emitted
+        //     before their parent, so the root ends up at the last position
+        //     as the tree strategies expect
+        _build_tree(entries, 0, sigma, 0, pc_node::undef, temp_nodes);
+    }
+
+    // build the code tree for the entries in [lo,hi), which share the
+    // first `depth` code bits; returns the index of the created node
+    static uint64_t
+    _build_tree(std::vector<code_entry>& entries, size_type lo, size_type hi,
+                uint64_t depth, uint64_t parent, std::vector<pc_node>& temp_nodes) {
+        if (hi-lo == 1 and entries[lo].len == depth) { // leaf
+            temp_nodes.emplace_back(pc_node(entries[lo].freq, entries[lo].sym,
+                                            parent));
+            return temp_nodes.size()-1;
+        }
+        size_type mid = lo; // first entry whose code has bit `depth` set
+        while (mid < hi and
+               0 == ((entries[mid].code >> (entries[mid].len-1-depth)) & 1)) {
+            ++mid;
+        }
+        uint64_t left  = _build_tree(entries, lo, mid, depth+1,
+                                     temp_nodes.size(), temp_nodes);
+        uint64_t right = _build_tree(entries, mid, hi, depth+1,
+                                     temp_nodes.size(), temp_nodes);
+        uint64_t freq  = temp_nodes[left].freq + temp_nodes[right].freq;
+        temp_nodes.emplace_back(pc_node(freq, 0, parent, left, right));
+        temp_nodes[left].parent  = temp_nodes.size()-1;
+        temp_nodes[right].parent = temp_nodes.size()-1;
+        return temp_nodes.size()-1;
+    }
+};
+
+struct huff_freq_shape {
+    template<class t_wt>
+    using type = _huff_freq_shape<t_wt>;
+};
+
 
 }// end namespace sdsl
 #endif
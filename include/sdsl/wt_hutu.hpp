@@ -24,6 +24,8 @@
 
 #include "wt_pc.hpp"
 #include <vector>
+#include <deque>
+#include <utility>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -64,6 +66,26 @@ struct _hutu_shape {
         typedef typename t_wt::size_type size_type;
         enum { lex_ordered = 1 };
 
+        //! Arena for the temporary nodes of the Hu-Tucker construction.
+        /*! Nodes are handed out from a deque (which guarantees stable
+         *  addresses while growing) and all freed at once when the arena
+         *  goes out of scope. "Deleting" a node is just unlinking it, so
+         *  the construction does no per-node heap traffic.
+         */
+        template<class t_element>
+        class node_arena
+        {
+            private:
+                std::deque<t_element> m_nodes;
+            public:
+                template<class... t_args>
+                t_element* create(t_args&&... args)
+                {
+                    m_nodes.emplace_back(std::forward<t_args>(args)...);
+                    return &m_nodes.back();
+                }
+        };
+
         //! Node class used by the leftist heap
         template <class t_element>
         struct heap_node {
@@ -109,21 +131,6 @@ struct _hutu_shape {
                     }
                 }
 
-                // helper function to remove the data structure from memory
-                void free_node(heap_node<t_element>* item)
-                {
-                    if (item->left) {
-                        free_node(item->left);
-                        delete item->left;
-                        item->left = nullptr;
-                    }
-                    if (item->right) {
-                        free_node(item->right);
-                        delete item->right;
-                        item->right = nullptr;
-                    }
-                }
-
                 // internal merge function
                 heap_node<t_element>* merge(heap_node<t_element>* h1, heap_node<t_element>* h2)
                 {
@@ -189,12 +196,14 @@ struct _hutu_shape {
                 }
 
                 //! Insert an element into the heap
-                /*! \param  x Element that is inserted into the heap.
+                /*! \param  x     Element that is inserted into the heap.
+                 *  \param  arena Arena the heap node is allocated from.
                  *  \return The new generated heap node.
                  */
-                heap_node<t_element>* insert(t_element* x)
+                heap_node<t_element>* insert(t_element* x,
+                                             node_arena<heap_node<t_element>>& arena)
                 {
-                    heap_node<t_element>* n = new heap_node<t_element>(x);
+                    heap_node<t_element>* n = arena.create(x);
                     l_heap<t_element> lh;
                     lh.m_root = n;
                     merge(&lh);
@@ -204,10 +213,8 @@ struct _hutu_shape {
                 //! Delete the smallest element in the heap
                 void delete_min()
                 {
-                    heap_node<t_element>* old_root = m_root;
                     m_root = merge(m_root->left, m_root->right);
                     if (m_root) m_root->parent = nullptr;
-                    delete old_root;
                 }
 
                 // deletes an arbitrary element from the heap
@@ -229,7 +236,6 @@ struct _hutu_shape {
                             }
                             // fix node information considering rank
                             fix_node(item->parent);
-                            delete item; // remove the item from memory
                         }
                     }
                 }
@@ -240,16 +246,6 @@ struct _hutu_shape {
                     m_root = merge(m_root, rhs->m_root);
                     rhs->m_root = nullptr;
                 }
-
-                // removes the whole data structure from memory
-                void free_memory()
-                {
-                    if (m_root != nullptr) {
-                        free_node(m_root);
-                        delete m_root;
-                        m_root = nullptr;
-                    }
-                }
         };
 
 
@@ -353,6 +349,11 @@ struct _hutu_shape {
             // Priority Queues, containing the Huffman Sequences
             std::vector<l_heap<ht_node>> HPQ(sigma);
             l_heap<m_node>  MPQ;      // Master Priority Queue
+            // arenas holding all temporary nodes; O(sigma) nodes in total
+            node_arena<ht_node>            ht_arena;
+            node_arena<m_node>             m_arena;
+            node_arena<heap_node<ht_node>> ht_heap_arena;
+            node_arena<heap_node<m_node>>  m_heap_arena;
 
             // init T, A, HPQs and MPQ
             T[0] = node_vector[0];
@@ -363,10 +364,10 @@ struct _hutu_shape {
                 T[i] = node_vector[i];
                 A[i] = &T[i];
 
-                T[i - 1].qr = HPQ[i - 1].insert(&T[i - 1]);
-                T[i].ql = HPQ[i - 1].insert(&T[i]);
+                T[i - 1].qr = HPQ[i - 1].insert(&T[i - 1], ht_heap_arena);
+                T[i].ql = HPQ[i - 1].insert(&T[i], ht_heap_arena);
 
-                m_node* m = new m_node();
+                m_node* m = m_arena.create();
                 m->min_sum = T[i - 1].w + T[i].w;
                 m->i = i - 1;
                 m->j = i;
@@ -374,7 +375,7 @@ struct _hutu_shape {
                 m->rt = &T[i];
                 m->myhpq = &HPQ[i - 1];
 
-                m->qel = MPQ.insert(m);
+                m->qel = MPQ.insert(m, m_heap_arena);
 
                 T[i-1].mpqr = m;
                 T[i].mpql = m;
@@ -393,7 +394,7 @@ struct _hutu_shape {
                 ht_node* n_lt = nullptr;
 
                 // create a new master priority queue
-                m_node* n_m = new m_node();
+                m_node* n_m = m_arena.create();
                 // delete old nodes from all hpqs
                 if (l->t) {
                     if (l->mpql) l->mpql->myhpq->delete_element(l->ql);
@@ -431,8 +432,6 @@ struct _hutu_shape {
                         h1 -> merge(h2);
                         MPQ.delete_element(l->mpql->qel);
                         MPQ.delete_element(l->mpqr->qel);
-                        delete l->mpql;
-                        delete l->mpqr;
 
                     } else {
                         h1 = l->mpqr->myhpq;
@@ -440,7 +439,6 @@ struct _hutu_shape {
                         n_lt = nullptr;
 
                         MPQ.delete_element(l->mpqr->qel);
-                        delete l->mpqr;
                     }
                     if (r->mpqr) {
                         n_rt = r->mpqr->rt;
@@ -450,7 +448,6 @@ struct _hutu_shape {
                         h3 = r->mpqr->myhpq;
                         h1->merge(h3);
                         MPQ.delete_element(r->mpqr->qel);
-                        delete r->mpqr;
 
                         n_hpq = h1;
                         if (n_rt) n_rt -> mpql = n_m;
@@ -469,8 +466,6 @@ struct _hutu_shape {
                         n_hpq=l->mpql->myhpq;
                         MPQ.delete_element(l->mpql->qel);
                         MPQ.delete_element(l->mpqr->qel);
-                        delete l->mpql;
-                        delete l->mpqr;
                     } else {
                         n_lt = nullptr;
                         n_rt = l->mpqr->rt;
@@ -478,7 +473,6 @@ struct _hutu_shape {
 
                         n_hpq = l->mpqr->myhpq;
                         MPQ.delete_element(l->mpqr->qel);
-                        delete l->mpqr;
                     }
                 } else if (r->t) { // right node is a leaf
                     if (r->mpqr) {
@@ -491,8 +485,6 @@ struct _hutu_shape {
                         n_hpq=r->mpql->myhpq;
                         MPQ.delete_element(r->mpql->qel);
                         MPQ.delete_element(r->mpqr->qel);
-                        delete r->mpql;
-                        delete r->mpqr;
                     } else {
                         n_lt = r->mpql->lt;
                         if (n_lt) n_lt->mpqr = n_m;
@@ -500,7 +492,6 @@ struct _hutu_shape {
 
                         n_hpq = r->mpql->myhpq;
                         MPQ.delete_element(r->mpql->qel);
-                        delete r->mpql;
                     }
                 } else {
                     // merge of two inner nodes
@@ -513,12 +504,10 @@ struct _hutu_shape {
 
                     if (n_lt) n_lt->mpqr = n_m;
                     if (n_rt) n_rt->mpql = n_m;
-
-                    delete m;
                 }
 
                 // create a new node with the information gained above
-                ht_node* new_node = new ht_node();
+                ht_node* new_node = ht_arena.create();
                 new_node -> c = ' ';
                 new_node -> w = l->w + r->w;
                 new_node -> t = false;
@@ -526,7 +515,7 @@ struct _hutu_shape {
                 new_node -> left = l;
                 new_node -> right = r;
                 // insert node to the correct hpq
-                new_node -> ql = n_hpq->insert(new_node);
+                new_node -> ql = n_hpq->insert(new_node, ht_heap_arena);
 
                 // update working sequence
                 A[lpos] = new_node;
@@ -545,14 +534,10 @@ struct _hutu_shape {
                         n_m->i = tmp_snd -> pos;
                         n_m->j = tmp_min -> pos;
                     }
-                    n_m->qel = MPQ.insert(n_m);
+                    n_m->qel = MPQ.insert(n_m, m_heap_arena);
                     n_m->myhpq = n_hpq;
                     n_m->lt = n_lt;
                     n_m->rt = n_rt;
-                } else {
-                    // free the last remaining hpq
-                    n_hpq->free_memory();
-                    delete n_m;
                 }
             }
 
@@ -573,7 +558,7 @@ struct _hutu_shape {
             while (qpointer < sigma or spointer >= 1LL) {
                 if (spointer >= 1LL and
                     (stack[spointer]->level == stack[spointer-1]->level)) {
-                    ht_node* n_node = new ht_node();
+                    ht_node* n_node = ht_arena.create();
                     max_nodes++;
                     n_node->t = false;
                     n_node->left = stack[spointer-1];
@@ -590,15 +575,11 @@ struct _hutu_shape {
                                                     stack[spointer-1]->pos,
                                                     stack[spointer]->pos));
 
-                    if (!stack[spointer-1]->t) delete stack[spointer-1];
-                    if (!stack[spointer]->t) delete stack[spointer];
-
                     stack[--spointer] = n_node;
                 } else {
                     stack[++spointer] = &T[qpointer++];
                 }
             }
-            delete stack[0];
         }
 
         static void assign_level(ht_node* n, int64_t lvl)
@@ -608,9 +589,6 @@ struct _hutu_shape {
                 assign_level(n->left, lvl + 1);
                 assign_level(n->right, lvl + 1);
 
-                if (!n->t) {
-                    delete n;
-                }
             }
         }
 };
@@ -688,6 +688,70 @@ class wt_int
             }
         }
 
+        //! count_2d counts the points in the index interval [lb..rb] and value interval [vlb..vrb].
+        /*! \param lb     Left bound of index interval (inclusive)
+         *  \param rb     Right bound of index interval (inclusive)
+         *  \param vlb    Left bound of value interval (inclusive)
+         *  \param vrb    Right bound of value interval (inclusive)
+         *  \return Number of points in the ranges.
+         *
+         *  A node whose value interval is fully contained in [vlb..vrb]
+         *  contributes the length of its index interval directly, so only
+         *  the two root-to-leaf paths delimiting the value interval are
+         *  traversed — use this instead of range_search_2d with
+         *  report=false, which still descends into contained subtrees.
+         */
+        size_type
+        count_2d(size_type lb, size_type rb, value_type vlb, value_type vrb) const {
+            if (vrb > (1ULL << m_max_level))
+                vrb = (1ULL << m_max_level);
+            if (vlb > vrb or lb > rb)
+                return 0;
+            return _count_2d(lb, rb, vlb, vrb, 0, 0, 0, m_size);
+        }
+
+        size_type
+        _count_2d(size_type lb, size_type rb, value_type vlb, value_type vrb, size_type level,
+                  size_type ilb, size_type offset, size_type node_size)
+        const {
+            if (lb > rb)
+                return 0;
+            size_type irb = ilb + (1ULL << (m_max_level-level));
+            if (vlb <= ilb and vrb >= irb-1) { // node interval fully contained
+                return rb-lb+1;
+            }
+            if (level == m_max_level) {
+                return rb-lb+1;
+            }
+            size_type mid = (irb + ilb)>>1;
+
+            size_type ones_before_o    = m_tree_rank(offset);
+            size_type ones_before_lb   = m_tree_rank(offset + lb);
+            size_type ones_before_rb   = m_tree_rank(offset + rb + 1);
+            size_type ones_before_end  = m_tree_rank(offset + node_size);
+            size_type zeros_before_o   = offset - ones_before_o;
+            size_type zeros_before_lb  = offset + lb - ones_before_lb;
+            size_type zeros_before_rb  = offset + rb + 1 - ones_before_rb;
+            size_type zeros_before_end = offset + node_size - ones_before_end;
+            size_type res = 0;
+            if (vlb < mid and mid) {
+                size_type nlb = zeros_before_lb - zeros_before_o;
+                size_type nrb = zeros_before_rb - zeros_before_o;
+                if (nrb)
+                    res += _count_2d(nlb, nrb-1, vlb, std::min(vrb,mid-1), level+1, ilb,
+                                     offset + m_size, zeros_before_end - zeros_before_o);
+            }
+            if (vrb >= mid) {
+                size_type nlb = ones_before_lb - ones_before_o;
+                size_type nrb = ones_before_rb - ones_before_o;
+                if (nrb)
+                    res += _count_2d(nlb, nrb-1, std::max(mid, vlb), vrb, level+1, mid,
+                                     offset + m_size + (zeros_before_end - zeros_before_o),
+                                     ones_before_end - ones_before_o);
+            }
+            return res;
+        }
+
         //! Returns a const_iterator to the first element.
         const_iterator begin()const {
             return const_iterator(this, 0);
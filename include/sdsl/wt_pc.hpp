@@ -24,11 +24,16 @@
 
 #include "bit_vectors.hpp"
 #include "rank_support.hpp"
+#include "rank_support_v.hpp"
 #include "select_support.hpp"
 #include "wt_helper.hpp"
+#include "construct_config.hpp"
+#include "instrumentation.hpp"
 #include <vector>
 #include <utility>
 #include <tuple>
+#include <thread>
+#include <type_traits>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -76,6 +81,52 @@ class wt_pc
         enum { lex_ordered=shape_type::lex_ordered };
         using node_type = typename tree_strat_type::node_type;
 
+        //! Caller-owned workspace and result of an interval_symbols call.
+        /*! The vectors are grown to sigma entries on first use and reused
+         *  afterwards, so a hot loop which keeps one object across calls
+         *  performs no allocations.
+         */
+        struct interval_symbols_result {
+            size_type k = 0;                 //!< number of distinct symbols
+            std::vector<value_type> cs;      //!< cs[0..k-1]: the symbols
+            std::vector<size_type> rank_c_i; //!< rank(i, cs[p]) for p < k
+            std::vector<size_type> rank_c_j; //!< rank(j, cs[p]) for p < k
+        };
+
+        //! Reusable tree shape for repeated construction.
+        /*! Holds the code tree computed for a reference distribution.
+         *  Passing the same object to the shape constructor builds many
+         *  wavelet trees with identical codes, skipping the per-input
+         *  shape computation; see compute_code_shape.
+         */
+        struct code_shape {
+            typedef typename wt_pc::size_type size_type;
+            std::vector<pc_node> nodes; //!< code tree in shape order
+
+            //! Serializes the shape, e.g. to share it between shards.
+            size_type serialize(std::ostream& out, structure_tree_node* v=nullptr,
+                                std::string name="") const
+            {
+                structure_tree_node* child =
+                    structure_tree::add_child(v, name, "code_shape");
+                size_type written_bytes = 0;
+                written_bytes += write_member(nodes.size(), out, child, "size");
+                out.write((char*)nodes.data(), nodes.size()*sizeof(pc_node));
+                written_bytes += nodes.size()*sizeof(pc_node);
+                structure_tree::add_size(child, written_bytes);
+                return written_bytes;
+            }
+
+            //! Loads the shape.
+            void load(std::istream& in)
+            {
+                size_type nodes_size = 0;
+                read_member(nodes_size, in);
+                nodes.resize(nodes_size);
+                in.read((char*)nodes.data(), nodes_size*sizeof(pc_node));
+            }
+        };
+
     private:
 
 #ifdef WT_PC_CACHE
@@ -106,9 +157,12 @@ class wt_pc
             m_tree          = wt.m_tree;
         }
 
-        // insert a character into the wavelet tree, see construct method
+        // insert a character into the wavelet tree, see construct method;
+        // if rb is not null, every written 1-run is also recorded there so
+        // the rank support can be assembled without re-scanning the vector
         void insert_char(value_type old_chr, std::vector<uint64_t>& bv_node_pos,
-                         size_type times, bit_vector& bv)
+                         size_type times, bit_vector& bv,
+                         rank_support_v<1,1>::builder* rb=nullptr)
         {
             uint64_t p = m_tree.bit_path(old_chr);
             uint32_t path_len = p>>56;
@@ -116,6 +170,8 @@ class wt_pc
             for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
                 if (p&1) {
                     bv.set_int(bv_node_pos[v], 0xFFFFFFFFFFFFFFFFULL,times);
+                    if (rb)
+                        rb->add_ones(bv_node_pos[v], times);
                 }
                 bv_node_pos[v] += times;
                 v = m_tree.child(v, p&1);
@@ -124,6 +180,130 @@ class wt_pc
 
 
 
+        // set `times` consecutive 1-bits starting at position `pos`; border
+        // words are or-ed atomically, so concurrent writers may share a word
+        static void set_ones_atomic(bit_vector& bv, uint64_t pos, uint32_t times)
+        {
+            uint64_t* data = bv.data();
+            while (times > 0) {
+                uint8_t  offset  = pos&0x3FULL;
+                uint32_t in_word = 64-offset;
+                if (in_word > times)
+                    in_word = times;
+                uint64_t mask = bits::lo_set[in_word]<<offset;
+#ifndef MSVC_COMPILER
+                __atomic_fetch_or(data+(pos>>6), mask, __ATOMIC_RELAXED);
+#else
+                // the parallel construction is disabled for MSVC, so
+                // this is never executed concurrently
+                data[pos>>6] |= mask;
+#endif
+                pos   += in_word;
+                times -= in_word;
+            }
+        }
+
+        // thread-safe version of insert_char; it only ever sets 1-bits in
+        // the zero-initialized bit vector, so atomic or suffices
+        void insert_char_atomic(value_type old_chr,
+                                std::vector<uint64_t>& bv_node_pos,
+                                size_type times, bit_vector& bv) const
+        {
+            uint64_t p = m_tree.bit_path(old_chr);
+            uint32_t path_len = p>>56;
+            node_type v = m_tree.root();
+            for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
+                if (p&1) {
+                    set_ones_atomic(bv, bv_node_pos[v], times);
+                }
+                bv_node_pos[v] += times;
+                v = m_tree.child(v, p&1);
+            }
+        }
+
+        // Parallel version of the bit vector construction in step 4 of the
+        // constructor. The input is split into one contiguous chunk per
+        // thread. A counting pass determines the character occurrences of
+        // each chunk; prefix sums over these counts yield the exact start
+        // position of each chunk inside every wavelet tree node, so the
+        // filling pass runs without synchronization. The threads only set
+        // 1-bits into the zero-initialized bit vector and chunk borders
+        // are written with atomic or, so shared words are safe.
+        template<class t_data>
+        void construct_bv_parallel(const t_data& input_buf, bit_vector& bv,
+                                   const std::vector<uint64_t>& bv_node_pos,
+                                   const std::vector<size_type>& C,
+                                   uint64_t threads)
+        {
+            std::vector<size_type> chunk_begin(threads+1, m_size);
+            size_type chunk = (m_size+threads-1)/threads;
+            for (uint64_t t=0; t*chunk < m_size; ++t) {
+                chunk_begin[t] = t*chunk;
+            }
+            // (a) count the character occurrences of each chunk
+            std::vector<std::vector<size_type>> occ(threads,
+                                  std::vector<size_type>(C.size(), 0));
+            {
+                std::vector<std::thread> pool;
+                for (uint64_t t=0; t < threads; ++t) {
+                    pool.emplace_back([&,t]() {
+                        wt_thread_access<t_data> seq(input_buf);
+                        for (size_type i=chunk_begin[t]; i < chunk_begin[t+1]; ++i) {
+                            ++occ[t][seq[i]];
+                        }
+                    });
+                }
+                for (auto& th : pool) th.join();
+            }
+            // (b) prefix sums give each chunk its node start positions
+            std::vector<std::vector<uint64_t>> chunk_node_pos(threads);
+            std::vector<uint64_t> pos(bv_node_pos);
+            for (uint64_t t=0; t < threads; ++t) {
+                chunk_node_pos[t] = pos;
+                for (size_type c=0; c < C.size(); ++c) {
+                    if (0 == occ[t][c])
+                        continue;
+                    uint64_t p = m_tree.bit_path((value_type)c);
+                    uint32_t path_len = p>>56;
+                    node_type v = m_tree.root();
+                    for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
+                        pos[v] += occ[t][c];
+                        v = m_tree.child(v, p&1);
+                    }
+                }
+            }
+            // (c) fill the bit vector; same run-batching as the
+            //     sequential scan, restricted to the chunk
+            std::vector<std::thread> pool;
+            for (uint64_t t=0; t < threads; ++t) {
+                pool.emplace_back([&,t]() {
+                    if (chunk_begin[t] == chunk_begin[t+1])
+                        return;
+                    wt_thread_access<t_data> seq(input_buf);
+                    value_type old_chr = (value_type)seq[chunk_begin[t]];
+                    uint32_t times = 0;
+                    for (size_type i=chunk_begin[t]; i < chunk_begin[t+1]; ++i) {
+                        value_type chr = (value_type)seq[i];
+                        if (chr != old_chr) {
+                            insert_char_atomic(old_chr, chunk_node_pos[t], times, bv);
+                            times = 1;
+                            old_chr = chr;
+                        } else {
+                            ++times;
+                            if (times == 64) {
+                                insert_char_atomic(old_chr, chunk_node_pos[t], times, bv);
+                                times = 0;
+                            }
+                        }
+                    }
+                    if (times > 0) {
+                        insert_char_atomic(old_chr, chunk_node_pos[t], times, bv);
+                    }
+                });
+            }
+            for (auto& th : pool) th.join();
+        }
+
         // calculates the tree shape returns the size of the WT bit vector
         size_type construct_tree_shape(const std::vector<size_type>& C)
         {
@@ -138,13 +318,104 @@ class wt_pc
             return bv_size;
         }
 
-        void construct_init_rank_select()
+        // Install the rank support: reuse the run counts collected during
+        // the sequential fill if the support is a plain rank_support_v over
+        // a plain bit_vector; scan the finished bit vector otherwise.
+        static void install_rank(rank_support_v<1,1>& rs, const bit_vector* bv,
+                                 rank_support_v<1,1>::builder& b)
+        {
+            if (b.active()) {
+                rs = b.finish(bv);
+            } else {
+                util::init_support(rs, bv);
+            }
+        }
+        template<class t_r, class t_bv>
+        static void install_rank(t_r& rs, const t_bv* bv,
+                                 rank_support_v<1,1>::builder&)
+        {
+            util::init_support(rs, bv);
+        }
+
+        void construct_init_rank_select(rank_support_v<1,1>::builder& rb)
         {
-            util::init_support(m_bv_rank, &m_bv);
+            install_rank(m_bv_rank, &m_bv, rb);
             util::init_support(m_bv_select0, &m_bv);
             util::init_support(m_bv_select1, &m_bv);
         }
 
+        // steps 4-6 of the constructors: fill the wavelet tree bit vector
+        // for the input sequence, guided by the tree in m_tree, and build
+        // the rank/select supports
+        template<class t_data>
+        void construct_bv_and_supports(const t_data& input_buf,
+                                       const std::vector<size_type>& C,
+                                       size_type tree_size)
+        {
+            bit_vector temp_bv(tree_size, 0);
+
+            // Initializing starting position of wavelet tree nodes
+            std::vector<uint64_t> bv_node_pos(m_tree.size(), 0);
+            for (size_type v=0; v < m_tree.size(); ++v) {
+                bv_node_pos[v] = m_tree.bv_pos(v);
+            }
+            if (input_buf.size() < m_size) {
+                throw std::logic_error("Stream size is smaller than size!");
+                return;
+            }
+            uint64_t threads = construct_config::num_threads;
+            if (0 == threads) {
+                threads = std::thread::hardware_concurrency();
+                if (0 == threads)
+                    threads = 1;
+            }
+#ifdef MSVC_COMPILER
+            threads = 1; // parallel fill relies on GCC/Clang atomic builtins
+#endif
+            // the parallel fill needs one occurrence counter per character
+            // and thread, so restrict it to inputs which dominate that cost
+            // count set bits per word while the sequential fill writes its
+            // 1-runs, so the rank support can be assembled without a re-scan
+            const bool count_on_the_fly =
+                std::is_same<bit_vector_type, bit_vector>::value and
+                std::is_same<rank_1_type, rank_support_v<1,1>>::value;
+            rank_support_v<1,1>::builder rank_builder;
+            if (threads > 1 and m_size >= (threads<<14)
+                and C.size() <= m_size/threads) {
+                construct_bv_parallel(input_buf, temp_bv, bv_node_pos, C, threads);
+            } else {
+                rank_support_v<1,1>::builder* rb = nullptr;
+                if (count_on_the_fly) {
+                    rank_builder.init(tree_size);
+                    rb = &rank_builder;
+                }
+                value_type old_chr = input_buf[0];
+                uint32_t times = 0;
+                for (size_type i=0; i < m_size; ++i) {
+                    value_type chr = input_buf[i];
+                    if (chr != old_chr) {
+                        insert_char(old_chr, bv_node_pos, times, temp_bv, rb);
+                        times = 1;
+                        old_chr = chr;
+                    } else { // chr == old_chr
+                        ++times;
+                        if (times == 64) {
+                            insert_char(old_chr, bv_node_pos, times, temp_bv, rb);
+                            times = 0;
+                        }
+                    }
+                }
+                if (times > 0) {
+                    insert_char(old_chr, bv_node_pos, times, temp_bv, rb);
+                }
+            }
+            m_bv = bit_vector_type(std::move(temp_bv));
+            // 5. Initialize rank and select data structures for m_bv
+            construct_init_rank_select(rank_builder);
+            // 6. Finish inner nodes by precalculating the bv_pos_rank values
+            m_tree.init_node_ranks(m_bv_rank);
+        }
+
         // recursive internal version of the method interval_symbols
         void
         _interval_symbols(size_type i, size_type j, size_type& k,
@@ -183,6 +454,71 @@ class wt_pc
             }
         }
 
+        // recursive internal version of the batched interval_symbols;
+        // idx/is/js hold the interval number and the interval mapped to
+        // node v, so each tree node is visited once for the whole batch
+        void
+        _interval_symbols_batch(const std::vector<size_type>& idx,
+                                const std::vector<size_type>& is,
+                                const std::vector<size_type>& js,
+                                std::vector<interval_symbols_result>& results,
+                                node_type v) const
+        {
+            std::vector<size_type> idx_left, is_left, js_left;
+            std::vector<size_type> idx_right, is_right, js_right;
+            idx_left.reserve(idx.size());
+            is_left.reserve(idx.size());
+            js_left.reserve(idx.size());
+            idx_right.reserve(idx.size());
+            is_right.reserve(idx.size());
+            js_right.reserve(idx.size());
+            for (size_type t=0; t < idx.size(); ++t) {
+                // invariant: js[t] > is[t]
+                size_type i_new = (m_bv_rank(m_tree.bv_pos(v) + is[t])
+                                   - m_tree.bv_pos_rank(v));
+                size_type j_new = (m_bv_rank(m_tree.bv_pos(v) + js[t])
+                                   - m_tree.bv_pos_rank(v));
+                if (is[t]-i_new != js[t]-j_new) {
+                    idx_left.push_back(idx[t]);
+                    is_left.push_back(is[t]-i_new);
+                    js_left.push_back(js[t]-j_new);
+                }
+                if (i_new != j_new) {
+                    idx_right.push_back(idx[t]);
+                    is_right.push_back(i_new);
+                    js_right.push_back(j_new);
+                }
+            }
+            if (!idx_left.empty()) {
+                node_type v_new = m_tree.child(v, 0);
+                if (!m_tree.is_leaf(v_new)) {
+                    _interval_symbols_batch(idx_left, is_left, js_left,
+                                            results, v_new);
+                } else {
+                    for (size_type t=0; t < idx_left.size(); ++t) {
+                        interval_symbols_result& res = results[idx_left[t]];
+                        res.rank_c_i[res.k] = is_left[t];
+                        res.rank_c_j[res.k] = js_left[t];
+                        res.cs[res.k++] = m_tree.bv_pos_rank(v_new);
+                    }
+                }
+            }
+            if (!idx_right.empty()) {
+                node_type v_new = m_tree.child(v, 1);
+                if (!m_tree.is_leaf(v_new)) {
+                    _interval_symbols_batch(idx_right, is_right, js_right,
+                                            results, v_new);
+                } else {
+                    for (size_type t=0; t < idx_right.size(); ++t) {
+                        interval_symbols_result& res = results[idx_right[t]];
+                        res.rank_c_i[res.k] = is_right[t];
+                        res.rank_c_j[res.k] = js_right[t];
+                        res.cs[res.k++] = m_tree.bv_pos_rank(v_new);
+                    }
+                }
+            }
+        }
+
     public:
 
         const size_type&       sigma = m_sigma;
@@ -214,47 +550,93 @@ class wt_pc
             calculate_effective_alphabet_size(C, m_sigma);
             // 3. Generate tree shape
             size_type tree_size = construct_tree_shape(C);
-            // 4. Generate wavelet tree bit sequence m_bv
-            bit_vector temp_bv(tree_size, 0);
+            // 4.-6. Generate wavelet tree bit sequence m_bv and supports
+            construct_bv_and_supports(input_buf, C, tree_size);
+        }
 
-            // Initializing starting position of wavelet tree nodes
-            std::vector<uint64_t> bv_node_pos(m_tree.size(), 0);
-            for (size_type v=0; v < m_tree.size(); ++v) {
-                bv_node_pos[v] = m_tree.bv_pos(v);
-            }
-            if (input_buf.size() < size) {
-                throw std::logic_error("Stream size is smaller than size!");
+        //! Construct the wavelet tree against a precomputed code shape
+        /*!
+         * \param input_buf    File buffer of the input.
+         * \param size         The length of the prefix.
+         * \param shape        Code shape obtained from compute_code_shape.
+         *
+         * Skips the per-input shape computation (e.g. the Huffman code
+         * construction): only a counting pass over the input and a
+         * bottom-up summation over the shared tree remain. All trees
+         * built against the same shape assign identical codes. Symbols
+         * of the input without a code in the shape cause a
+         * std::logic_error.
+         * \par Time complexity
+         *      \f$ \Order{n\log|\Sigma|}\f$, where \f$n=size\f$
+         */
+        template<class t_data>
+        wt_pc(const t_data& input_buf, size_type size, const code_shape& shape)
+            : m_size(size)
+        {
+            if (0 == m_size)
                 return;
+            std::vector<size_type> C;
+            // 1. Count occurrences of characters
+            calculate_character_occurences(input_buf, m_size, C);
+            // 2. Calculate effective alphabet size
+            calculate_effective_alphabet_size(C, m_sigma);
+            // 3. Transfer the occurrences onto the shared tree shape
+            std::vector<pc_node> temp_nodes(shape.nodes);
+            size_type assigned = 0;
+            for (auto& v : temp_nodes) {
+                if (pc_node::undef == v.child[0]) { // leaf
+                    v.freq = (v.sym < C.size()) ? C[v.sym] : 0;
+                    assigned += v.freq;
+                } else {
+                    v.freq = 0;
+                }
             }
-            value_type old_chr = input_buf[0];
-            uint32_t times = 0;
-            for (size_type i=0; i < m_size; ++i) {
-                value_type chr = input_buf[i];
-                if (chr != old_chr) {
-                    insert_char(old_chr, bv_node_pos, times, temp_bv);
-                    times = 1;
-                    old_chr = chr;
-                } else { // chr == old_chr
-                    ++times;
-                    if (times == 64) {
-                        insert_char(old_chr, bv_node_pos, times, temp_bv);
-                        times = 0;
+            if (assigned != m_size) {
+                throw std::logic_error("wt_pc: input contains a symbol "
+                                       "without a code in the shape");
+            }
+            // accumulate the leaf frequencies bottom-up along the parent
+            // pointers; the shapes emit the nodes in different orders, so
+            // no pass over the vector in index order would do
+            for (size_type v=0; v < temp_nodes.size(); ++v) {
+                if (pc_node::undef == temp_nodes[v].child[0]) { // leaf
+                    size_type p = temp_nodes[v].parent;
+                    while (pc_node::undef != p) {
+                        temp_nodes[p].freq += temp_nodes[v].freq;
+                        p = temp_nodes[p].parent;
                     }
                 }
             }
-            if (times > 0) {
-                insert_char(old_chr, bv_node_pos, times, temp_bv);
-            }
-            m_bv = bit_vector_type(std::move(temp_bv));
-            // 5. Initialize rank and select data structures for m_bv
-            construct_init_rank_select();
-            // 6. Finish inner nodes by precalculating the bv_pos_rank values
-            m_tree.init_node_ranks(m_bv_rank);
+            size_type tree_size = 0;
+            tree_strat_type temp_tree(temp_nodes, tree_size, this);
+            m_tree.swap(temp_tree);
+            // 4.-6. Generate wavelet tree bit sequence m_bv and supports
+            construct_bv_and_supports(input_buf, C, tree_size);
         }
 
         template<class t_data>
         wt_pc(const t_data& data) : wt_pc(data, data.size()) {}
 
+        //! Compute a reusable code shape for a reference input
+        /*!
+         * \param input_buf    File buffer of the reference input.
+         * \param size         The length of the prefix.
+         * \return Code shape which can be passed to the shape
+         *         constructor; symbols absent from the reference input
+         *         get no code.
+         * \par Time complexity
+         *      \f$ \Order{n + |\Sigma|\log|\Sigma|} \f$, where \f$n=size\f$
+         */
+        template<class t_data>
+        static code_shape compute_code_shape(const t_data& input_buf, size_type size)
+        {
+            std::vector<size_type> C;
+            calculate_character_occurences(input_buf, size, C);
+            code_shape shape;
+            shape_type::construct_tree(C, shape.nodes);
+            return shape;
+        }
+
         //! Copy constructor
         wt_pc(const wt_pc& wt) { copy(wt); }
 
@@ -372,7 +754,8 @@ class wt_pc
             uint32_t path_len = (p>>56);
             size_type result = i;
             node_type v = m_tree.root();
-            for (uint32_t l=0; l<path_len and result; ++l, p >>= 1) {
+            uint32_t l = 0;
+            for (; l<path_len and result; ++l, p >>= 1) {
                 if (p&1) {
                     result  = (m_bv_rank(m_tree.bv_pos(v)+result)
                                -  m_tree.bv_pos_rank(v));
@@ -382,6 +765,7 @@ class wt_pc
                 }
                 v = m_tree.child(v, p&1); // goto child
             }
+            SDSL_RECORD_SAMPLE("wt_pc_rank_depth", l);
             return result;
         };
 
@@ -521,6 +905,84 @@ class wt_pc
             }
         }
 
+        //! interval_symbols into a caller-owned reusable workspace.
+        /*!
+         * \param i   The start index (inclusive) of the interval.
+         * \param j   The end index (exclusive) of the interval.
+         * \param res Workspace and result; res.k and res.cs[0..k-1],
+         *            res.rank_c_i[0..k-1], res.rank_c_j[0..k-1] are set as
+         *            in the vector-based overload.
+         *
+         * The workspace vectors are grown to sigma entries only when they
+         * are too small, so reusing one object across calls makes the loop
+         * allocation-free.
+         *
+         * \par Precondition
+         *      \f$ i \leq j \leq size() \f$
+         */
+        void interval_symbols(size_type i, size_type j,
+                              interval_symbols_result& res) const
+        {
+            if (res.cs.size() < m_sigma) {
+                res.cs.resize(m_sigma);
+                res.rank_c_i.resize(m_sigma);
+                res.rank_c_j.resize(m_sigma);
+            }
+            interval_symbols(i, j, res.k, res.cs, res.rank_c_i, res.rank_c_j);
+        }
+
+        //! interval_symbols for a batch of intervals in one tree traversal.
+        /*!
+         * \param intervals Pairs (i, j) of interval borders, i inclusive
+         *                  and j exclusive, each with
+         *                  \f$ i \leq j \leq size() \f$.
+         * \param results   One result per interval, in input order; the
+         *                  inner vectors are reused across calls.
+         *
+         * All intervals walk the tree together: each wavelet tree node is
+         * visited once per batch instead of once per interval, so the rank
+         * queries of the whole batch hit the node's bit vector region while
+         * it is cache-resident.
+         *
+         * \par Time complexity
+         *      \f$ \Order{\sum_b \min{\sigma, k_b \log \sigma}} \f$, with
+         *      shared node visits across the batch.
+         */
+        void interval_symbols(const std::vector<std::pair<size_type,size_type>>& intervals,
+                              std::vector<interval_symbols_result>& results) const
+        {
+            results.resize(intervals.size());
+            std::vector<size_type> idx, is, js;
+            idx.reserve(intervals.size());
+            is.reserve(intervals.size());
+            js.reserve(intervals.size());
+            for (size_type t=0; t < intervals.size(); ++t) {
+                size_type i = intervals[t].first, j = intervals[t].second;
+                assert(i <= j and j <= size());
+                interval_symbols_result& res = results[t];
+                if (res.cs.size() < m_sigma) {
+                    res.cs.resize(m_sigma);
+                    res.rank_c_i.resize(m_sigma);
+                    res.rank_c_j.resize(m_sigma);
+                }
+                res.k = 0;
+                if (i == j) {
+                    // empty interval; nothing to do
+                } else if (1 == m_sigma or j-i <= 2) {
+                    // delegate to the scalar shortcuts
+                    interval_symbols(i, j, res.k, res.cs,
+                                     res.rank_c_i, res.rank_c_j);
+                } else {
+                    idx.push_back(t);
+                    is.push_back(i);
+                    js.push_back(j);
+                }
+            }
+            if (!idx.empty()) {
+                _interval_symbols_batch(idx, is, js, results, 0);
+            }
+        }
+
 
         //! How many symbols are lexicographic smaller/greater than c in [i..j-1].
         /*!
@@ -0,0 +1,491 @@
+/* sdsl - succinct data structures library
+    Copyright (C) 2009 Simon Gog
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see http://www.gnu.org/licenses/ .
+*/
+/*! \file wt_quad_int.hpp
+    \brief wt_quad_int.hpp contains a 4-ary wavelet tree for integer
+           sequences which consumes two bits of the symbol per level.
+    \author Simon Gog
+*/
+#ifndef INCLUDED_SDSL_WT_QUAD_INT
+#define INCLUDED_SDSL_WT_QUAD_INT
+
+#include "sdsl_concepts.hpp"
+#include "int_vector.hpp"
+#include "int_vector_buffer.hpp"
+#include "util.hpp"
+#include <algorithm> // for std::swap
+#include <stdexcept>
+#include <vector>
+#include <utility>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A 4-ary wavelet tree class for integer sequences.
+/*!
+ *  In contrast to wt_int, which splits the alphabet into two halves per
+ *  level, each node of this tree has four children and a level consumes
+ *  two bits of the symbol. The digit sequence of a level is stored in an
+ *  int_vector<2> and answered by a built-in rank structure which counts
+ *  all four digits in one scan. A descent for access/rank therefore
+ *  performs \f$\lceil\log|\Sigma|/2\rceil\f$ dependent steps instead of
+ *  \f$\lceil\log|\Sigma|\rceil\f$, halving the length of the chain of
+ *  data-dependent cache misses.
+ *
+ *    \par Space complexity
+ *        \f$\Order{n\log|\Sigma|}\f$ bits, where \f$n\f$ is the size of
+ *        the vector the wavelet tree was build for. The rank samples add
+ *        25% on top of the digit sequence.
+ *
+ *   @ingroup wt
+ */
+class wt_quad_int
+{
+    public:
+
+        typedef int_vector<>::size_type              size_type;
+        typedef int_vector<>::value_type             value_type;
+        typedef int_vector<2>::difference_type       difference_type;
+        typedef random_access_const_iterator<wt_quad_int> const_iterator;
+        typedef const_iterator                       iterator;
+        typedef wt_tag                               index_category;
+        typedef int_alphabet_tag                     alphabet_category;
+        enum 	{lex_ordered=1};
+
+    protected:
+
+        // number of symbols per rank superblock; a superblock spans
+        // 2*sample_dist bits = sample_dist/32 words of the digit sequence
+        static const size_type sample_dist = 512;
+
+        size_type      m_size  = 0;
+        size_type      m_sigma = 0;         //<- \f$ |\Sigma| \f$
+        int_vector<2>  m_quads;             // concatenated digit sequences of all levels
+        int_vector<64> m_rank_samples;      // 4 cumulative digit counts per superblock
+        uint32_t       m_max_level = 0;     // number of 2-bit levels
+
+        void copy(const wt_quad_int& wt) {
+            m_size         = wt.m_size;
+            m_sigma        = wt.m_sigma;
+            m_quads        = wt.m_quads;
+            m_rank_samples = wt.m_rank_samples;
+            m_max_level    = wt.m_max_level;
+        }
+
+    private:
+
+        // set r[d] to the number of occurrences of digit d in the
+        // 2-bit fields [0..k-1] of word w
+        static void _word_counts(uint64_t w, size_type k, size_type* r) {
+            uint64_t l  = w & 0x5555555555555555ULL;
+            uint64_t h  = (w>>1) & 0x5555555555555555ULL;
+            uint64_t nl = l ^ 0x5555555555555555ULL;
+            uint64_t nh = h ^ 0x5555555555555555ULL;
+            uint64_t mask = (k < 32) ? (1ULL<<(k<<1))-1 : ~0ULL;
+            r[0] += bits::cnt(nh & nl & mask);
+            r[1] += bits::cnt(nh &  l & mask);
+            r[2] += bits::cnt(h  & nl & mask);
+            r[3] += bits::cnt(h  &  l & mask);
+        }
+
+        // number of occurrences of digit d in the 2-bit fields [0..k-1] of w
+        static size_type _word_count_d(uint64_t w, size_type k, uint8_t d) {
+            uint64_t l = w & 0x5555555555555555ULL;
+            uint64_t h = (w>>1) & 0x5555555555555555ULL;
+            if (!(d&1)) l ^= 0x5555555555555555ULL;
+            if (!(d&2)) h ^= 0x5555555555555555ULL;
+            uint64_t mask = (k < 32) ? (1ULL<<(k<<1))-1 : ~0ULL;
+            return bits::cnt(h & l & mask);
+        }
+
+        // r[d] = number of occurrences of digit d in m_quads[0..i-1]
+        void _rank_all(size_type i, size_type* r)const {
+            size_type sb = i/sample_dist;
+            for (uint8_t d=0; d<4; ++d)
+                r[d] = m_rank_samples[(sb<<2)+d];
+            const uint64_t* data = m_quads.data() + (sb*sample_dist)/32;
+            size_type rest = i - sb*sample_dist;
+            while (rest >= 32) {
+                _word_counts(*(data++), 32, r);
+                rest -= 32;
+            }
+            if (rest)
+                _word_counts(*data, rest, r);
+        }
+
+        // number of occurrences of digit d in m_quads[0..i-1]
+        size_type _rank_d(size_type i, uint8_t d)const {
+            size_type sb = i/sample_dist;
+            size_type r = m_rank_samples[(sb<<2)+d];
+            const uint64_t* data = m_quads.data() + (sb*sample_dist)/32;
+            size_type rest = i - sb*sample_dist;
+            while (rest >= 32) {
+                r += _word_count_d(*(data++), 32, d);
+                rest -= 32;
+            }
+            if (rest)
+                r += _word_count_d(*data, rest, d);
+            return r;
+        }
+
+        void init_rank_samples() {
+            size_type len = m_quads.size();
+            m_rank_samples = int_vector<64>(((len/sample_dist)+1)<<2, 0);
+            size_type r[4] = {0,0,0,0};
+            const uint64_t* data = m_quads.data();
+            for (size_type i=0, sb=0; i < len; i += 32) {
+                if (0 == (i % sample_dist)) {
+                    for (uint8_t d=0; d<4; ++d)
+                        m_rank_samples[(sb<<2)+d] = r[d];
+                    ++sb;
+                }
+                _word_counts(*(data++), std::min<size_type>(32, len-i), r);
+            }
+            if (0 == (len % sample_dist)) {
+                for (uint8_t d=0; d<4; ++d)
+                    m_rank_samples[((len/sample_dist)<<2)+d] = r[d];
+            }
+        }
+
+    public:
+
+        const size_type&       sigma = m_sigma;         //!< Effective alphabet size of the wavelet tree.
+        const uint32_t&        max_level = m_max_level; //!< Maximal level of the wavelet tree.
+
+        //! Default constructor
+        wt_quad_int() {
+        };
+
+        //! Semi-external constructor
+        /*! \param buf         File buffer of the int_vector for which the wt_quad_int should be build.
+         *  \param size        Size of the prefix of v, which should be indexed.
+         *  \param max_level   Maximal level (in 2-bit digits) of the wavelet
+         *                     tree. If set to 0, determined automatically.
+         *    \par Time complexity
+         *        \f$ \Order{n\log|\Sigma|}\f$, where \f$n=size\f$
+         *    \par Space complexity
+         *        \f$ n\log|\Sigma| + O(1)\f$ bits, where \f$n=size\f$.
+         */
+        template<uint8_t int_width>
+        wt_quad_int(int_vector_buffer<int_width>& buf, size_type size,
+                    uint32_t max_level=0) : m_size(size) {
+            if (0 == m_size)
+                return;
+            size_type n = buf.size();  // set n
+            if (n < m_size) {
+                throw std::logic_error("n="+util::to_string(n)+" < "+util::to_string(m_size)+"=m_size");
+            }
+            m_sigma = 0;
+            int_vector<> rac(m_size, 0, buf.width());
+
+            value_type x = 1;  // variable for the biggest value in rac
+            for (size_type i=0; i < m_size; ++i) {
+                if (buf[i] > x)
+                    x = buf[i];
+                rac[i] = buf[i];
+            }
+
+            if (max_level == 0) {
+                m_max_level = (bits::hi(x)+2)/2; // each level consumes 2 bits
+            } else {
+                m_max_level = max_level;
+            }
+
+            m_quads = int_vector<2>(m_size*m_max_level, 0);
+            std::vector<uint64_t> bucket[3]; // buffers for digits 1,2,3
+
+            size_type quad_pos = 0;
+            for (uint32_t k=0; k<m_max_level; ++k) {
+                const uint32_t shift = (m_max_level-k-1)<<1;
+                size_type start = 0;
+                do {
+                    size_type i    = start;
+                    size_type cnt0 = 0;
+                    // a node consists of all values with equal digits above
+                    // the current one; at level 0 this is the whole vector
+                    uint64_t  start_prefix = (0==k) ? 0 : (rac[i]>>(shift+2));
+                    uint64_t  x;
+                    while (i < m_size and
+                           ((0==k) ? 0 : ((x=rac[i])>>(shift+2))) == start_prefix) {
+                        x = rac[i];
+                        uint8_t d = (x>>shift)&3ULL;
+                        m_quads[quad_pos++] = d;
+                        if (0 == d) {
+                            rac[start + cnt0++] = x;
+                        } else {
+                            bucket[d-1].push_back(x);
+                        }
+                        ++i;
+                    }
+                    if (k+1 < m_max_level) { // inner node
+                        size_type pos = start+cnt0;
+                        for (uint8_t d=0; d<3; ++d) {
+                            for (size_type j=0; j<bucket[d].size(); ++j)
+                                rac[pos++] = bucket[d][j];
+                        }
+                    } else { // leaf node
+                        m_sigma += (cnt0>0); // increase sigma for each leaf
+                        for (uint8_t d=0; d<3; ++d)
+                            m_sigma += (bucket[d].size()>0);
+                    }
+                    for (uint8_t d=0; d<3; ++d)
+                        bucket[d].clear();
+                    start = i;
+                } while (start < m_size);
+            }
+            rac.resize(0);
+            init_rank_samples();
+        }
+
+        template<class t_data>
+        wt_quad_int(const t_data& data, uint32_t max_level=0) {
+            std::string tmp_f = ram_file_name(util::to_string(util::pid())
+                                              +"_"+util::to_string(util::id()));
+            store_to_file(data, tmp_f);
+            int_vector_buffer<> buf(tmp_f);
+            *this = wt_quad_int(buf, data.size(), max_level);
+            sdsl::remove(tmp_f);
+        }
+
+        //! Copy constructor
+        wt_quad_int(const wt_quad_int& wt) {
+            copy(wt);
+        }
+
+        //! Move constructor
+        wt_quad_int(wt_quad_int&& wt) {
+            *this = std::move(wt);
+        }
+
+        //! Assignment operator
+        wt_quad_int& operator=(const wt_quad_int& wt) {
+            if (this != &wt) {
+                copy(wt);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        wt_quad_int& operator=(wt_quad_int&& wt) {
+            if (this != &wt) {
+                m_size         = wt.m_size;
+                m_sigma        = wt.m_sigma;
+                m_quads        = std::move(wt.m_quads);
+                m_rank_samples = std::move(wt.m_rank_samples);
+                m_max_level    = std::move(wt.m_max_level);
+            }
+            return *this;
+        }
+
+        //! Swap operator
+        void swap(wt_quad_int& wt) {
+            if (this != &wt) {
+                std::swap(m_size, wt.m_size);
+                std::swap(m_sigma,  wt.m_sigma);
+                m_quads.swap(wt.m_quads);
+                m_rank_samples.swap(wt.m_rank_samples);
+                std::swap(m_max_level,  wt.m_max_level);
+            }
+        }
+
+        //! Returns the size of the original vector.
+        size_type size()const {
+            return m_size;
+        }
+
+        //! Returns whether the wavelet tree contains no data.
+        bool empty()const {
+            return m_size == 0;
+        }
+
+        //! Recovers the i-th symbol of the original vector.
+        /*! \param i The index of the symbol in the original vector.
+         *  \returns The i-th symbol of the original vector.
+         *  \par Time complexity
+         *       \f$ \Order{\log|\Sigma|/2} \f$ dependent steps.
+         *  \par Precondition
+         *       \f$ i < size() \f$
+         */
+        value_type operator[](size_type i)const {
+            assert(i < size());
+            size_type offset = 0;
+            value_type res = 0;
+            size_type node_size = m_size;
+            for (uint32_t k=0; k < m_max_level; ++k) {
+                res <<= 2;
+                size_type r_o[4], r_i[4], r_end[4];
+                _rank_all(offset, r_o);
+                _rank_all(offset+i, r_i);
+                _rank_all(offset+node_size, r_end);
+                uint8_t d = m_quads[offset+i];
+                res |= d;
+                for (uint8_t e=0; e<d; ++e)
+                    offset += r_end[e]-r_o[e];
+                node_size = r_end[d]-r_o[d];
+                i = r_i[d]-r_o[d];
+                offset += m_size;
+            }
+            return res;
+        };
+
+        //! Calculates how many symbols c are in the prefix [0..i-1] of the supported vector.
+        /*!
+         *  \param i The exclusive index of the prefix range [0..i-1], so \f$i\in[0..size()]\f$.
+         *  \param c The symbol to count the occurrences in the prefix.
+         *    \returns The number of occurrences of symbol c in the prefix [0..i-1] of the supported vector.
+         *  \par Time complexity
+         *       \f$ \Order{\log |\Sigma|} \f$
+         *  \par Precondition
+         *       \f$ i \leq size() \f$
+         */
+        size_type rank(size_type i, value_type c)const {
+            assert(i <= size());
+            if ((m_max_level<<1) < 64 and (c>>(m_max_level<<1)) > 0) {
+                return 0; // c is greater than any symbol in wt
+            }
+            size_type offset = 0;
+            size_type node_size = m_size;
+            for (uint32_t k=0; k < m_max_level and i; ++k) {
+                uint8_t d = (c>>((m_max_level-k-1)<<1))&3ULL;
+                size_type r_o[4], r_i[4], r_end[4];
+                _rank_all(offset, r_o);
+                _rank_all(offset+i, r_i);
+                _rank_all(offset+node_size, r_end);
+                for (uint8_t e=0; e<d; ++e)
+                    offset += r_end[e]-r_o[e];
+                node_size = r_end[d]-r_o[d];
+                i = r_i[d]-r_o[d];
+                offset += m_size;
+            }
+            return i;
+        };
+
+        //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
+        /*!
+         *  \param i The index of the symbol.
+         *  \return  Pair (rank(wt[i],i),wt[i])
+         *  \par Precondition
+         *       \f$ i < size() \f$
+         */
+        std::pair<size_type, value_type>
+        inverse_select(size_type i)const {
+            assert(i < size());
+            value_type c = 0;
+            size_type node_size = m_size, offset = 0;
+            for (uint32_t k=0; k < m_max_level; ++k) {
+                size_type r_o[4], r_i[4], r_end[4];
+                _rank_all(offset, r_o);
+                _rank_all(offset+i, r_i);
+                _rank_all(offset+node_size, r_end);
+                uint8_t d = m_quads[offset+i];
+                c = (c<<2)|d;
+                for (uint8_t e=0; e<d; ++e)
+                    offset += r_end[e]-r_o[e];
+                node_size = r_end[d]-r_o[d];
+                i = r_i[d]-r_o[d];
+                offset += m_size;
+            }
+            return std::make_pair(i,c);
+        }
+
+        //! Calculates the i-th occurrence of the symbol c in the supported vector.
+        /*!
+         *  \param i The i-th occurrence.
+         *  \param c The symbol c.
+         *  \par Time complexity
+         *       \f$ \Order{\log |\Sigma| \cdot \log n} \f$, since the
+         *       upward steps locate positions by binary search on rank.
+         *  \par Precondition
+         *       \f$ 1 \leq i \leq rank(size(), c) \f$
+         */
+        size_type select(size_type i, value_type c)const {
+            assert(1 <= i and i <= rank(size(), c));
+            size_type offset = 0;
+            size_type node_size = m_size;
+            std::vector<size_type> path_off(m_max_level+1);
+            std::vector<size_type> path_size(m_max_level+1);
+            path_off[0] = 0;
+            path_size[0] = m_size;
+
+            for (uint32_t k=0; k < m_max_level and node_size; ++k) {
+                uint8_t d = (c>>((m_max_level-k-1)<<1))&3ULL;
+                size_type r_o[4], r_end[4];
+                _rank_all(offset, r_o);
+                _rank_all(offset+node_size, r_end);
+                for (uint8_t e=0; e<d; ++e)
+                    offset += r_end[e]-r_o[e];
+                node_size = r_end[d]-r_o[d];
+                offset += m_size;
+                path_off[k+1] = offset;
+                path_size[k+1] = node_size;
+            }
+            if (0ULL == node_size or node_size < i) {
+                throw std::logic_error("select("+util::to_string(i)+","+util::to_string(c)+"): c does not occur i times in the WT");
+            }
+            for (uint32_t k=m_max_level; k>0; --k) {
+                uint8_t d = (c>>((m_max_level-k)<<1))&3ULL;
+                size_type node_off = path_off[k-1];
+                size_type target = _rank_d(node_off, d) + i;
+                // binary search the smallest p with rank_d(p+1) == target
+                size_type lo = node_off, hi = node_off+path_size[k-1];
+                while (lo < hi) {
+                    size_type mid = lo + (hi-lo)/2;
+                    if (_rank_d(mid+1, d) < target)
+                        lo = mid+1;
+                    else
+                        hi = mid;
+                }
+                i = lo - node_off + 1;
+            }
+            return i-1;
+        };
+
+        //! Returns a const_iterator to the first element.
+        const_iterator begin()const {
+            return const_iterator(this, 0);
+        }
+
+        //! Returns a const_iterator to the element after the last element.
+        const_iterator end()const {
+            return const_iterator(this, size());
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_sigma, out, child, "sigma");
+            written_bytes += m_quads.serialize(out, child, "quads");
+            written_bytes += m_rank_samples.serialize(out, child, "rank_samples");
+            written_bytes += write_member(m_max_level, out, child, "max_level");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in) {
+            read_member(m_size, in);
+            read_member(m_sigma, in);
+            m_quads.load(in);
+            m_rank_samples.load(in);
+            read_member(m_max_level, in);
+        }
+};
+
+}// end namespace sdsl
+#endif
@@ -375,6 +375,84 @@ class wt_rlmn
             }
         }
 
+        //! Cursor caching the boundaries of the run touched by the last query.
+        /*! A run_cursor memorizes the run containing the position of the
+         *  last rank/inverse_select query: its boundaries, its symbol and
+         *  the number of occurrences of the symbol before the run. Queries
+         *  hitting the cached run are answered with simple arithmetic and
+         *  no rank/select call on bl, bf or the inner wavelet tree. Since
+         *  the runs of highly repetitive sequences are long, sequences of
+         *  LF-steps resolve most steps inside the cached run, making them
+         *  \f$\Order{1}\f$ amortized. A cursor is only valid for the
+         *  wavelet tree which filled it.
+         */
+        struct run_cursor {
+            size_type  begin       = 0; // start of the cached run
+            size_type  end         = 0; // exclusive end of the cached run
+            value_type c           = 0; // symbol of the cached run
+            size_type  rank_before = 0; // occurrences of c in [0..begin-1]
+        };
+
+        //! Calculates how many times symbol wt[i] occurs in the prefix [0..i-1].
+        /*!
+         *  \param i   The index of the symbol.
+         *  \param cur Cursor filled by a previous query; updated to the run
+         *             containing i.
+         *  \return  Pair (rank(wt[i],i),wt[i])
+         *    \par Time complexity
+         *        \f$ \Order{1} \f$ if i lies in the cached run,
+         *        \f$ \Order{H_0} \f$ otherwise
+         */
+        std::pair<size_type, value_type>
+        inverse_select(size_type i, run_cursor& cur)const {
+            assert(i < size());
+            if (cur.begin <= i and i < cur.end) {
+                return std::make_pair(cur.rank_before+i-cur.begin, cur.c);
+            }
+            size_type wt_ex_pos = m_bl_rank(i+1);
+            auto rc = m_wt.inverse_select(wt_ex_pos-1);
+            size_type c_runs = rc.first + 1;
+            value_type c     = rc.second;
+            cur.begin       = m_bl_select(wt_ex_pos);
+            cur.end         = (wt_ex_pos < m_wt.size()) ? m_bl_select(wt_ex_pos+1) : m_size;
+            cur.c           = c;
+            cur.rank_before = m_bf_select(m_C_bf_rank[c]+c_runs)-m_C[c];
+            return std::make_pair(cur.rank_before+i-cur.begin, c);
+        }
+
+        //! Calculates how many symbols c are in the prefix [0..i-1].
+        /*!
+         *  \param i   Exclusive right bound of the range (\f$i\in[0..size()]\f$).
+         *  \param c   Symbol c.
+         *  \param cur Cursor filled by a previous query; updated whenever
+         *             position i-1 lies in a run of symbol c.
+         *  \return Number of occurrences of symbol c in the prefix [0..i-1].
+         *  \par Time complexity
+         *        \f$ \Order{1} \f$ if i-1 lies in the cached run and the
+         *        run consists of symbol c, \f$ \Order{H_0} \f$ otherwise
+         */
+        size_type rank(size_type i, value_type c, run_cursor& cur)const {
+            assert(i <= size());
+            if (i == 0)
+                return 0;
+            if (cur.begin < i and i <= cur.end and c == cur.c) {
+                return cur.rank_before+i-cur.begin;
+            }
+            size_type wt_ex_pos = m_bl_rank(i);
+            size_type c_runs = m_wt.rank(wt_ex_pos, c);
+            if (c_runs == 0)
+                return 0;
+            if (m_wt[wt_ex_pos-1] == c) {
+                cur.begin       = m_bl_select(wt_ex_pos);
+                cur.end         = (wt_ex_pos < m_wt.size()) ? m_bl_select(wt_ex_pos+1) : m_size;
+                cur.c           = c;
+                cur.rank_before = m_bf_select(m_C_bf_rank[c]+c_runs)-m_C[c];
+                return cur.rank_before+i-cur.begin;
+            } else {
+                return m_bf_select(m_C_bf_rank[c] + c_runs + 1) - m_C[c];
+            }
+        }
+
         //! Calculates the ith occurrence of the symbol c in the supported vector.
         /*!
          *  \param i The ith occurrence. \f$i\in [1..rank(size(),c)]\f$.
@@ -0,0 +1,805 @@
+#include "sdsl/async_filebuf.hpp"
+#include "sdsl/construct_config.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#ifdef __linux__
+#include <sys/syscall.h>
+#ifdef SYS_io_uring_setup
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#define SDSL_HAVE_IO_URING
+#endif
+#endif
+#endif
+#endif
+#endif // _WIN32
+
+namespace sdsl
+{
+
+#ifndef _WIN32
+
+namespace
+{
+
+// states of the chunk buffers
+const uint8_t BUF_FREE     = 0;  // available for the next request
+const uint8_t BUF_INFLIGHT = 1;  // submitted to the engine
+const uint8_t BUF_READY    = 2;  // completed read, not yet served
+const uint8_t BUF_ACTIVE   = 3;  // holds the current get/put area
+
+// Fallback engine: a worker thread which retires the queued requests
+// with pread/pwrite. Short transfers are retried in the worker, so a
+// completion is either the full request, the end of file, or an error.
+class thread_engine : public async_filebuf::io_engine
+{
+        struct op {
+            uint64_t idx, off, len, buf_off;
+            bool     read;
+        };
+        int                             m_fd   = -1;
+        std::vector<std::vector<char>>* m_bufs = nullptr;
+        std::deque<op>                      m_work;
+        std::deque<async_filebuf::io_result> m_done;
+        std::mutex              m_mutex;
+        std::condition_variable m_cv_work;
+        std::condition_variable m_cv_done;
+        bool                    m_quit = false;
+        std::thread             m_worker;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                while (m_work.empty() and !m_quit)
+                    m_cv_work.wait(lock);
+                if (m_work.empty())
+                    return;
+                op o = m_work.front();
+                m_work.pop_front();
+                lock.unlock();
+                char* buf    = (*m_bufs)[o.idx].data() + o.buf_off;
+                int64_t res  = 0;
+                uint64_t done = 0;
+                while (done < o.len) {
+                    ssize_t r = o.read ?
+                                ::pread(m_fd, buf+done, o.len-done, o.off+done) :
+                                ::pwrite(m_fd, buf+done, o.len-done, o.off+done);
+                    if (r < 0) {
+                        if (errno == EINTR)
+                            continue;
+                        res = -errno;
+                        break;
+                    }
+                    if (r == 0)  // end of file on reads
+                        break;
+                    done += r;
+                }
+                if (res == 0)
+                    res = done;
+                lock.lock();
+                m_done.push_back(async_filebuf::io_result{o.idx, res});
+                m_cv_done.notify_one();
+            }
+        }
+
+    public:
+        bool start(int fd, std::vector<std::vector<char>>& bufs) override
+        {
+            m_fd   = fd;
+            m_bufs = &bufs;
+            m_worker = std::thread(&thread_engine::run, this);
+            return true;
+        }
+
+        void submit(uint64_t idx, uint64_t file_off, uint64_t len,
+                    bool read, uint64_t buf_off) override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_work.push_back(op{idx, file_off, len, buf_off, read});
+            m_cv_work.notify_one();
+        }
+
+        async_filebuf::io_result wait() override
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_done.empty())
+                m_cv_done.wait(lock);
+            async_filebuf::io_result r = m_done.front();
+            m_done.pop_front();
+            return r;
+        }
+
+        ~thread_engine()
+        {
+            if (m_worker.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_quit = true;
+                    m_cv_work.notify_one();
+                }
+                m_worker.join();
+            }
+        }
+};
+
+#ifdef SDSL_HAVE_IO_URING
+
+// io_uring engine issued through raw syscalls, so no liburing dependency
+// is added. The chunk buffers are registered with the kernel when the
+// locked-memory limit permits it (IORING_OP_*_FIXED); otherwise the
+// engine falls back to plain readv/writev requests on the same ring.
+class uring_engine : public async_filebuf::io_engine
+{
+        int       m_fd      = -1;
+        int       m_ring_fd = -1;
+        bool      m_fixed   = false;
+        std::vector<std::vector<char>>* m_bufs = nullptr;
+        std::vector<struct iovec> m_iov;  // persistent iovec per buffer
+        void*     m_sq_ptr  = MAP_FAILED;
+        size_t    m_sq_sz   = 0;
+        void*     m_cq_ptr  = MAP_FAILED;
+        size_t    m_cq_sz   = 0;
+        void*     m_sqes_ptr = MAP_FAILED;
+        size_t    m_sqes_sz = 0;
+        unsigned* m_sq_tail = nullptr;
+        unsigned  m_sq_mask = 0;
+        unsigned* m_sq_array = nullptr;
+        unsigned* m_cq_head = nullptr;
+        unsigned* m_cq_tail = nullptr;
+        unsigned  m_cq_mask = 0;
+        struct io_uring_sqe* m_sqes = nullptr;
+        struct io_uring_cqe* m_cqes = nullptr;
+
+        static int sys_setup(unsigned entries, struct io_uring_params* p)
+        {
+            return (int)syscall(SYS_io_uring_setup, entries, p);
+        }
+        static int sys_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+        {
+            return (int)syscall(SYS_io_uring_enter, fd, to_submit, min_complete,
+                                flags, nullptr, 0);
+        }
+        static int sys_register(int fd, unsigned opcode, void* arg, unsigned nr)
+        {
+            return (int)syscall(SYS_io_uring_register, fd, opcode, arg, nr);
+        }
+
+    public:
+        bool start(int fd, std::vector<std::vector<char>>& bufs) override
+        {
+            m_fd   = fd;
+            m_bufs = &bufs;
+            struct io_uring_params p;
+            std::memset(&p, 0, sizeof(p));
+            m_ring_fd = sys_setup(bufs.size(), &p);
+            if (m_ring_fd < 0)
+                return false;
+            m_sq_sz = p.sq_off.array + p.sq_entries*sizeof(unsigned);
+            m_cq_sz = p.cq_off.cqes + p.cq_entries*sizeof(struct io_uring_cqe);
+            bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+            single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+            if (single_mmap)
+                m_sq_sz = std::max(m_sq_sz, m_cq_sz);
+            m_sq_ptr = mmap(nullptr, m_sq_sz, PROT_READ|PROT_WRITE,
+                            MAP_SHARED|MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+            if (MAP_FAILED == m_sq_ptr)
+                return false;
+            if (single_mmap) {
+                m_cq_ptr = m_sq_ptr;
+                m_cq_sz  = 0;  // unmapped together with the SQ ring
+            } else {
+                m_cq_ptr = mmap(nullptr, m_cq_sz, PROT_READ|PROT_WRITE,
+                                MAP_SHARED|MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING);
+                if (MAP_FAILED == m_cq_ptr)
+                    return false;
+            }
+            m_sqes_sz = p.sq_entries*sizeof(struct io_uring_sqe);
+            m_sqes_ptr = mmap(nullptr, m_sqes_sz, PROT_READ|PROT_WRITE,
+                              MAP_SHARED|MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+            if (MAP_FAILED == m_sqes_ptr)
+                return false;
+            m_sqes     = (struct io_uring_sqe*)m_sqes_ptr;
+            char* sq   = (char*)m_sq_ptr;
+            char* cq   = (char*)m_cq_ptr;
+            m_sq_tail  = (unsigned*)(sq + p.sq_off.tail);
+            m_sq_mask  = *(unsigned*)(sq + p.sq_off.ring_mask);
+            m_sq_array = (unsigned*)(sq + p.sq_off.array);
+            m_cq_head  = (unsigned*)(cq + p.cq_off.head);
+            m_cq_tail  = (unsigned*)(cq + p.cq_off.tail);
+            m_cq_mask  = *(unsigned*)(cq + p.cq_off.ring_mask);
+            m_cqes     = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+            m_iov.resize(bufs.size());
+            for (size_t i=0; i < bufs.size(); ++i) {
+                m_iov[i].iov_base = bufs[i].data();
+                m_iov[i].iov_len  = bufs[i].size();
+            }
+            // registering pins the buffers; failure (e.g. RLIMIT_MEMLOCK)
+            // only disables the fixed-buffer fast path
+            m_fixed = 0 == sys_register(m_ring_fd, IORING_REGISTER_BUFFERS,
+                                        m_iov.data(), m_iov.size());
+            return true;
+        }
+
+        void submit(uint64_t idx, uint64_t file_off, uint64_t len,
+                    bool read, uint64_t buf_off) override
+        {
+            unsigned tail = *m_sq_tail;  // single submitter
+            unsigned slot = tail & m_sq_mask;
+            struct io_uring_sqe* sqe = &m_sqes[slot];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->fd        = m_fd;
+            sqe->off       = file_off;
+            sqe->user_data = idx;
+            if (m_fixed) {
+                sqe->opcode    = read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                sqe->addr      = (uint64_t)(uintptr_t)((*m_bufs)[idx].data() + buf_off);
+                sqe->len       = len;
+                sqe->buf_index = idx;
+            } else {
+                m_iov[idx].iov_base = (*m_bufs)[idx].data() + buf_off;
+                m_iov[idx].iov_len  = len;
+                sqe->opcode = read ? IORING_OP_READV : IORING_OP_WRITEV;
+                sqe->addr   = (uint64_t)(uintptr_t)&m_iov[idx];
+                sqe->len    = 1;
+            }
+            m_sq_array[slot] = slot;
+            __atomic_store_n(m_sq_tail, tail+1, __ATOMIC_RELEASE);
+            int ret;
+            do {
+                ret = sys_enter(m_ring_fd, 1, 0, 0);
+            } while (ret < 0 and (errno == EINTR or errno == EAGAIN));
+        }
+
+        async_filebuf::io_result wait() override
+        {
+            while (true) {
+                unsigned head = *m_cq_head;  // single consumer
+                if (head != __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE)) {
+                    struct io_uring_cqe* cqe = &m_cqes[head & m_cq_mask];
+                    async_filebuf::io_result r{cqe->user_data, cqe->res};
+                    __atomic_store_n(m_cq_head, head+1, __ATOMIC_RELEASE);
+                    return r;
+                }
+                int ret = sys_enter(m_ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+                if (ret < 0 and errno != EINTR and errno != EAGAIN) {
+                    // ring is unusable; report an engine failure
+                    return async_filebuf::io_result{(uint64_t)-1, -errno};
+                }
+            }
+        }
+
+        ~uring_engine()
+        {
+            if (MAP_FAILED != m_sqes_ptr)
+                munmap(m_sqes_ptr, m_sqes_sz);
+            if (MAP_FAILED != m_cq_ptr and m_cq_sz > 0)
+                munmap(m_cq_ptr, m_cq_sz);
+            if (MAP_FAILED != m_sq_ptr)
+                munmap(m_sq_ptr, m_sq_sz);
+            if (m_ring_fd >= 0)
+                ::close(m_ring_fd);
+        }
+};
+
+#endif // SDSL_HAVE_IO_URING
+
+} // end unnamed namespace
+
+async_filebuf::~async_filebuf()
+{
+    close();
+}
+
+std::streambuf*
+async_filebuf::open(const std::string& file, std::ios_base::openmode mode)
+{
+    close();
+    m_error = false;
+    const bool out = 0 != (mode & std::ios_base::out);
+    const bool in  = 0 != (mode & std::ios_base::in);
+    if (in == out)  // exactly one direction is supported
+        return nullptr;
+    if (mode & (std::ios_base::app | std::ios_base::ate))
+        return nullptr;
+    m_write_mode = out;
+    uint64_t depth = construct_config::stream_queue_depth;
+    if (0 == depth)
+        depth = 4;
+    uint64_t chunk = construct_config::stream_buffer_size;
+    if (0 == chunk)
+        chunk = 1ULL<<20;
+    m_chunk = std::max<uint64_t>(chunk, 4096);
+    int flags = out ? (O_WRONLY|O_CREAT|O_TRUNC) : O_RDONLY;
+    m_fd = ::open(file.c_str(), flags, 0666);
+    if (m_fd < 0)
+        return nullptr;
+    m_buf.assign(depth+1, std::vector<char>());
+    for (size_t i=0; i < m_buf.size(); ++i)
+        m_buf[i].resize(m_chunk);
+    m_state.assign(m_buf.size(), BUF_FREE);
+    m_op_off.assign(m_buf.size(), 0);
+    m_op_len.assign(m_buf.size(), 0);
+    m_inflight = 0;
+#ifdef SDSL_HAVE_IO_URING
+    {
+        uring_engine* e = new uring_engine();
+        if (e->start(m_fd, m_buf)) {
+            m_engine = e;
+        } else {
+            delete e;  // e.g. io_uring not supported by the kernel
+        }
+    }
+#endif
+    if (nullptr == m_engine) {
+        thread_engine* e = new thread_engine();
+        if (!e->start(m_fd, m_buf)) {
+            delete e;
+            ::close(m_fd);
+            m_fd = -1;
+            return nullptr;
+        }
+        m_engine = e;
+    }
+    if (m_write_mode) {
+        m_cur = 0;
+        m_pos = 0;
+        m_state[m_cur] = BUF_ACTIVE;
+        setp(m_buf[m_cur].data(), m_buf[m_cur].data()+m_chunk);
+        setg(nullptr, nullptr, nullptr);
+    } else {
+        setp(nullptr, nullptr);
+        reset_get(0);
+        fill_pipeline();
+    }
+    return this;
+}
+
+bool
+async_filebuf::is_open()
+{
+    return m_fd >= 0;
+}
+
+async_filebuf*
+async_filebuf::close()
+{
+    if (m_fd < 0)
+        return nullptr;
+    if (m_write_mode)
+        flush_put();
+    drain();
+    delete m_engine;
+    m_engine = nullptr;
+    bool ok = 0 == ::close(m_fd) and !m_error;
+    m_fd = -1;
+    m_buf.clear();
+    m_state.clear();
+    setp(nullptr, nullptr);
+    setg(nullptr, nullptr, nullptr);
+    return ok ? this : nullptr;
+}
+
+void
+async_filebuf::reap_one()
+{
+    io_result c = m_engine->wait();
+    if (c.idx >= m_buf.size()) {  // engine failure; abandon all requests
+        m_error = true;
+        for (size_t i=0; i < m_state.size(); ++i)
+            if (BUF_INFLIGHT == m_state[i])
+                m_state[i] = BUF_FREE;
+        m_inflight = 0;
+        return;
+    }
+    --m_inflight;
+    if (c.res < 0) {
+        m_error = true;
+        c.res = 0;
+    }
+    if (m_write_mode) {
+        uint64_t want = m_op_len[c.idx];
+        if (!m_error and c.res > 0 and (uint64_t)c.res < want) {
+            // short write; move the rest to the buffer start and resubmit
+            std::memmove(m_buf[c.idx].data(),
+                         m_buf[c.idx].data()+c.res, want-c.res);
+            m_op_off[c.idx] += c.res;
+            m_op_len[c.idx]  = want-c.res;
+            m_state[c.idx]   = BUF_INFLIGHT;
+            m_engine->submit(c.idx, m_op_off[c.idx], m_op_len[c.idx], false, 0);
+            ++m_inflight;
+            return;
+        }
+        if ((uint64_t)c.res != want)
+            m_error = true;
+        m_state[c.idx] = BUF_FREE;
+    } else {
+        m_op_len[c.idx] = c.res;
+        m_state[c.idx]  = BUF_READY;
+        if ((uint64_t)c.res < m_chunk)  // the prefetched offsets behind
+            m_stop_submit = true;       // this chunk no longer line up
+    }
+}
+
+void
+async_filebuf::drain()
+{
+    while (m_inflight > 0)
+        reap_one();
+}
+
+void
+async_filebuf::fill_pipeline()
+{
+    while (!m_stop_submit) {
+        uint64_t idx = m_buf.size();
+        for (size_t i=0; i < m_state.size(); ++i) {
+            if (BUF_FREE == m_state[i]) {
+                idx = i;
+                break;
+            }
+        }
+        if (idx == m_buf.size())
+            return;
+        m_state[idx]  = BUF_INFLIGHT;
+        m_op_off[idx] = m_submit_off;
+        m_op_len[idx] = m_chunk;
+        m_engine->submit(idx, m_submit_off, m_chunk, true, 0);
+        ++m_inflight;
+        m_submit_off += m_chunk;
+    }
+}
+
+uint64_t
+async_filebuf::acquire_free()
+{
+    while (true) {
+        for (size_t i=0; i < m_state.size(); ++i)
+            if (BUF_FREE == m_state[i])
+                return i;
+        reap_one();
+    }
+}
+
+bool
+async_filebuf::flush_put()
+{
+    if (nullptr == pptr())
+        return !m_error;
+    uint64_t len = pptr()-pbase();
+    if (len > 0) {
+        m_op_off[m_cur] = m_pos;
+        m_op_len[m_cur] = len;
+        m_state[m_cur]  = BUF_INFLIGHT;
+        m_engine->submit(m_cur, m_pos, len, false, 0);
+        ++m_inflight;
+        m_pos += len;
+        m_cur = acquire_free();
+        m_state[m_cur] = BUF_ACTIVE;
+        setp(m_buf[m_cur].data(), m_buf[m_cur].data()+m_chunk);
+    }
+    return !m_error;
+}
+
+void
+async_filebuf::reset_get(uint64_t pos)
+{
+    m_next_off    = pos;
+    m_submit_off  = pos;
+    m_stop_submit = false;
+    m_at_eof      = false;
+    m_eof_off     = 0;
+    setg(nullptr, nullptr, nullptr);
+}
+
+uint64_t
+async_filebuf::file_size()
+{
+    struct stat st;
+    if (0 != ::fstat(m_fd, &st)) {
+        m_error = true;
+        return 0;
+    }
+    return st.st_size;
+}
+
+async_filebuf::pos_type
+async_filebuf::seek(off_type off, std::ios_base::seekdir way)
+{
+    if (m_fd < 0)
+        return pos_type(off_type(-1));
+    if (m_write_mode) {
+        uint64_t cur_pos = m_pos + (pptr()-pbase());
+        if (std::ios_base::cur == way and 0 == off)  // tellp
+            return pos_type(cur_pos);
+        flush_put();
+        drain();
+        int64_t target = off;
+        if (std::ios_base::cur == way)
+            target += cur_pos;
+        else if (std::ios_base::end == way)
+            target += file_size();
+        if (target < 0 or m_error)
+            return pos_type(off_type(-1));
+        m_pos = target;  // writes continue at the new offset
+        return pos_type(target);
+    } else {
+        uint64_t area_len = egptr()-eback();
+        uint64_t cur_pos  = m_next_off - (egptr()-gptr());
+        if (std::ios_base::cur == way and 0 == off)  // tellg
+            return pos_type(cur_pos);
+        int64_t target = off;
+        if (std::ios_base::cur == way)
+            target += cur_pos;
+        else if (std::ios_base::end == way)
+            target += file_size();
+        if (target < 0 or m_error)
+            return pos_type(off_type(-1));
+        uint64_t area_begin = m_next_off - area_len;
+        if (eback() != nullptr and (uint64_t)target >= area_begin
+            and (uint64_t)target <= m_next_off) {
+            // target lies in the current get area; keep the pipeline
+            setg(eback(), eback()+(target-area_begin), egptr());
+            return pos_type(target);
+        }
+        drain();
+        for (size_t i=0; i < m_state.size(); ++i)
+            m_state[i] = BUF_FREE;
+        reset_get(target);
+        fill_pipeline();
+        return pos_type(target);
+    }
+}
+
+async_filebuf::pos_type
+async_filebuf::seekpos(pos_type sp, std::ios_base::openmode)
+{
+    return seek(off_type(sp), std::ios_base::beg);
+}
+
+async_filebuf::pos_type
+async_filebuf::seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode)
+{
+    return seek(off, way);
+}
+
+int
+async_filebuf::sync()
+{
+    if (m_fd < 0)
+        return -1;
+    if (m_write_mode) {
+        flush_put();
+        drain();
+    }
+    return m_error ? -1 : 0;
+}
+
+async_filebuf::int_type
+async_filebuf::overflow(int_type c)
+{
+    if (!m_write_mode or m_fd < 0)
+        return traits_type::eof();
+    flush_put();
+    if (m_error)
+        return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+async_filebuf::int_type
+async_filebuf::underflow()
+{
+    if (m_write_mode or m_fd < 0)
+        return traits_type::eof();
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+    if (eback() != nullptr) {  // release the served chunk
+        m_state[m_cur] = BUF_FREE;
+        setg(nullptr, nullptr, nullptr);
+    }
+    while (true) {
+        fill_pipeline();
+        uint64_t idx = m_buf.size();
+        for (size_t i=0; i < m_state.size(); ++i) {
+            if (BUF_READY == m_state[i] and m_op_off[i] == m_next_off) {
+                idx = i;
+                break;
+            }
+        }
+        if (idx < m_buf.size()) {
+            if (0 == m_op_len[idx]) {
+                m_state[idx] = BUF_FREE;
+                m_at_eof  = true;
+                m_eof_off = m_next_off;
+                return traits_type::eof();
+            }
+            m_cur = idx;
+            m_state[idx] = BUF_ACTIVE;
+            char* b = m_buf[idx].data();
+            setg(b, b, b+m_op_len[idx]);
+            m_next_off += m_op_len[idx];
+            return traits_type::to_int_type(*gptr());
+        }
+        if (m_inflight > 0) {
+            reap_one();
+            continue;
+        }
+        // nothing in flight matches m_next_off (a short read broke the
+        // chunk alignment); discard the stale chunks and restart there
+        for (size_t i=0; i < m_state.size(); ++i)
+            if (BUF_READY == m_state[i])
+                m_state[i] = BUF_FREE;
+        if (m_at_eof and m_next_off >= m_eof_off)
+            return traits_type::eof();
+        if (m_error)
+            return traits_type::eof();
+        m_stop_submit = false;
+        m_at_eof      = false;
+        m_submit_off  = m_next_off;
+        fill_pipeline();
+        if (0 == m_inflight)
+            return traits_type::eof();
+    }
+}
+
+std::streamsize
+async_filebuf::xsgetn(char_type* s, std::streamsize n)
+{
+    if (m_write_mode or m_fd < 0 or n <= 0)
+        return 0;
+    std::streamsize got = 0;
+    while (got < n) {
+        std::streamsize avail = egptr()-gptr();
+        if (avail > 0) {
+            std::streamsize take = std::min(avail, n-got);
+            std::memcpy(s+got, gptr(), take);
+            gbump(take);
+            got += take;
+            continue;
+        }
+        if ((uint64_t)(n-got) >= m_chunk) {
+            // bulk remainder: use what the pipeline has already fetched,
+            // then read the rest directly into the destination instead of
+            // copying it through the chunk buffers
+            if (eback() != nullptr) {
+                m_state[m_cur] = BUF_FREE;
+                setg(nullptr, nullptr, nullptr);
+            }
+            uint64_t idx = m_buf.size();
+            for (size_t i=0; i < m_state.size(); ++i) {
+                if (BUF_READY == m_state[i] and m_op_off[i] == m_next_off) {
+                    idx = i;
+                    break;
+                }
+            }
+            if (idx < m_buf.size()) {
+                if (0 == m_op_len[idx]) {  // end of file
+                    m_state[idx] = BUF_FREE;
+                    m_at_eof  = true;
+                    m_eof_off = m_next_off;
+                    break;
+                }
+                m_cur = idx;
+                m_state[idx] = BUF_ACTIVE;
+                char* b = m_buf[idx].data();
+                setg(b, b, b+m_op_len[idx]);
+                m_next_off += m_op_len[idx];
+                continue;  // served by the get-area branch above
+            }
+            if (m_inflight > 0) {  // let the pending prefetches land
+                reap_one();
+                continue;
+            }
+            for (size_t i=0; i < m_state.size(); ++i)
+                m_state[i] = BUF_FREE;  // drop stale chunks
+            uint64_t want = n-got;
+            uint64_t done = 0;
+            while (done < want) {
+                ssize_t r = ::pread(m_fd, s+got+done, want-done, m_next_off+done);
+                if (r < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    m_error = true;
+                    break;
+                }
+                if (0 == r)  // end of file
+                    break;
+                done += r;
+            }
+            got += done;
+            // the pipeline is refilled lazily by the next underflow, so
+            // a following bulk read does not have to discard prefetches
+            reset_get(m_next_off+done);
+            if (done < want)
+                break;
+            continue;
+        }
+        if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+            break;
+    }
+    return got;
+}
+
+#else // _WIN32: the asynchronous backend is not available
+
+async_filebuf::~async_filebuf() {}
+
+std::streambuf*
+async_filebuf::open(const std::string&, std::ios_base::openmode)
+{
+    return nullptr;
+}
+
+bool async_filebuf::is_open() { return false; }
+
+async_filebuf* async_filebuf::close() { return nullptr; }
+
+void async_filebuf::reap_one() {}
+void async_filebuf::drain() {}
+void async_filebuf::fill_pipeline() {}
+uint64_t async_filebuf::acquire_free() { return 0; }
+bool async_filebuf::flush_put() { return false; }
+void async_filebuf::reset_get(uint64_t) {}
+uint64_t async_filebuf::file_size() { return 0; }
+
+async_filebuf::pos_type
+async_filebuf::seek(off_type, std::ios_base::seekdir)
+{
+    return pos_type(off_type(-1));
+}
+
+async_filebuf::pos_type
+async_filebuf::seekpos(pos_type, std::ios_base::openmode)
+{
+    return pos_type(off_type(-1));
+}
+
+async_filebuf::pos_type
+async_filebuf::seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode)
+{
+    return pos_type(off_type(-1));
+}
+
+int async_filebuf::sync() { return -1; }
+
+async_filebuf::int_type
+async_filebuf::overflow(int_type)
+{
+    return traits_type::eof();
+}
+
+async_filebuf::int_type
+async_filebuf::underflow()
+{
+    return traits_type::eof();
+}
+
+std::streamsize
+async_filebuf::xsgetn(char_type*, std::streamsize)
+{
+    return 0;
+}
+
+#endif // _WIN32
+
+}// end namespace sdsl
@@ -16,9 +16,539 @@
 */
 #include "sdsl/bits.hpp"
 
+#include <chrono>
+#include <ostream>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SDSL_CNT_WORDS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
 namespace sdsl
 {
 
+namespace
+{
+
+uint64_t cnt_words_scalar(const uint64_t* word, uint64_t word_num)
+{
+    uint64_t res = 0;
+    for (uint64_t i=0; i < word_num; ++i) {
+        res += bits::cnt(word[i]);
+    }
+    return res;
+}
+
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+
+__attribute__((target("avx2")))
+uint64_t cnt_words_avx2(const uint64_t* word, uint64_t word_num)
+{
+    // in-register popcount based on a nibble lookup table (Mula et al.,
+    // "Faster Population Counts Using AVX2 Instructions")
+    const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                            0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    uint64_t i = 0;
+    for (; i+4 <= word_num; i+=4) {
+        __m256i v  = _mm256_loadu_si256((const __m256i*)(word+i));
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi32(v, 4), low_mask);
+        __m256i pc = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                     _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(pc, _mm256_setzero_si256()));
+    }
+    uint64_t res = static_cast<uint64_t>(_mm256_extract_epi64(acc, 0))
+                   + static_cast<uint64_t>(_mm256_extract_epi64(acc, 1))
+                   + static_cast<uint64_t>(_mm256_extract_epi64(acc, 2))
+                   + static_cast<uint64_t>(_mm256_extract_epi64(acc, 3));
+    return res + cnt_words_scalar(word+i, word_num-i);
+}
+
+#if defined(__GNUC__) && __GNUC__ >= 6 && !defined(__clang__) || defined(__clang__) && __clang_major__ >= 5
+#define SDSL_CNT_WORDS_HAVE_VPOPCNTDQ
+__attribute__((target("avx512vpopcntdq,avx512f")))
+uint64_t cnt_words_avx512(const uint64_t* word, uint64_t word_num)
+{
+    __m512i acc = _mm512_setzero_si512();
+    uint64_t i = 0;
+    for (; i+8 <= word_num; i+=8) {
+        __m512i v = _mm512_loadu_si512((const void*)(word+i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+    }
+    // fold the lanes via a store; _mm512_reduce_add_epi64 (and the
+    // extract intrinsics) raise a -Wuninitialized warning from
+    // avx512fintrin.h on gcc
+    uint64_t lane[8];
+    _mm512_storeu_si512((void*)lane, acc);
+    uint64_t res = lane[0] + lane[1] + lane[2] + lane[3]
+                   + lane[4] + lane[5] + lane[6] + lane[7];
+    return res + cnt_words_scalar(word+i, word_num-i);
+}
+#endif
+
+uint64_t cnt_words_dispatch(const uint64_t* word, uint64_t word_num);
+
+// function pointer to the best kernel for the executing CPU; initialized
+// on the first call
+uint64_t (*cnt_words_impl)(const uint64_t*, uint64_t) = cnt_words_dispatch;
+
+uint64_t cnt_words_dispatch(const uint64_t* word, uint64_t word_num)
+{
+    __builtin_cpu_init();
+#ifdef SDSL_CNT_WORDS_HAVE_VPOPCNTDQ
+    if (__builtin_cpu_supports("avx512vpopcntdq") and __builtin_cpu_supports("avx512f")) {
+        cnt_words_impl = cnt_words_avx512;
+    } else
+#endif
+        if (__builtin_cpu_supports("avx2")) {
+            cnt_words_impl = cnt_words_avx2;
+        } else {
+            cnt_words_impl = cnt_words_scalar;
+        }
+    return cnt_words_impl(word, word_num);
+}
+
+#endif // SDSL_CNT_WORDS_X86_DISPATCH
+
+uint64_t cnt10_words_scalar(const uint64_t* word, uint64_t word_num)
+{
+    uint64_t res = 0, carry = 0;
+    for (uint64_t i=0; i < word_num; ++i) {
+        res += bits::cnt10(word[i], carry);
+    }
+    return res;
+}
+
+uint64_t cnt01_words_scalar(const uint64_t* word, uint64_t word_num)
+{
+    uint64_t res = 0, carry = 1;
+    for (uint64_t i=0; i < word_num; ++i) {
+        res += bits::cnt01(word[i], carry);
+    }
+    return res;
+}
+
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+
+// map a vector of words to the "10" (is_cnt10=true) resp. "01" pattern
+// indicator bits and popcount them; the carry between adjacent words is
+// propagated by shifting in the top bit of the preceding word
+template<bool is_cnt10>
+__attribute__((target("avx2")))
+uint64_t cnt_pattern_words_avx2(const uint64_t* word, uint64_t word_num)
+{
+    uint64_t carry = is_cnt10 ? 0 : 1;
+    uint64_t res = is_cnt10 ? bits::cnt10(word[0], carry)
+                            : bits::cnt01(word[0], carry);
+    const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                            0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    uint64_t i = 1;
+    for (; i+4 <= word_num; i+=4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(word+i));
+        __m256i p = _mm256_loadu_si256((const __m256i*)(word+i-1));
+        __m256i shifted = _mm256_or_si256(_mm256_slli_epi64(v, 1),
+                                          _mm256_srli_epi64(p, 63));
+        __m256i t = _mm256_xor_si256(v, shifted);
+        t = is_cnt10 ? _mm256_andnot_si256(v, t) : _mm256_and_si256(v, t);
+        __m256i lo = _mm256_and_si256(t, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi32(t, 4), low_mask);
+        __m256i pc = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                     _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(pc, _mm256_setzero_si256()));
+    }
+    res += static_cast<uint64_t>(_mm256_extract_epi64(acc, 0))
+           + static_cast<uint64_t>(_mm256_extract_epi64(acc, 1))
+           + static_cast<uint64_t>(_mm256_extract_epi64(acc, 2))
+           + static_cast<uint64_t>(_mm256_extract_epi64(acc, 3));
+    carry = word[i-1] >> 63;
+    for (; i < word_num; ++i) {
+        res += is_cnt10 ? bits::cnt10(word[i], carry)
+                        : bits::cnt01(word[i], carry);
+    }
+    return res;
+}
+
+uint64_t cnt10_words_dispatch(const uint64_t* word, uint64_t word_num);
+uint64_t cnt01_words_dispatch(const uint64_t* word, uint64_t word_num);
+
+uint64_t (*cnt10_words_impl)(const uint64_t*, uint64_t) = cnt10_words_dispatch;
+uint64_t (*cnt01_words_impl)(const uint64_t*, uint64_t) = cnt01_words_dispatch;
+
+uint64_t cnt10_words_dispatch(const uint64_t* word, uint64_t word_num)
+{
+    __builtin_cpu_init();
+    cnt10_words_impl = __builtin_cpu_supports("avx2")
+                       ? cnt_pattern_words_avx2<true> : cnt10_words_scalar;
+    return cnt10_words_impl(word, word_num);
+}
+
+uint64_t cnt01_words_dispatch(const uint64_t* word, uint64_t word_num)
+{
+    __builtin_cpu_init();
+    cnt01_words_impl = __builtin_cpu_supports("avx2")
+                       ? cnt_pattern_words_avx2<false> : cnt01_words_scalar;
+    return cnt01_words_impl(word, word_num);
+}
+
+#endif // SDSL_CNT_WORDS_X86_DISPATCH
+
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+
+__attribute__((target("bmi2")))
+uint32_t sel_pdep(uint64_t x, uint32_t i)
+{
+    // index i is 1-based here, (i-1) changes it to 0-based
+    return static_cast<uint32_t>(__builtin_ctzll(_pdep_u64(1ull << (i-1), x)));
+}
+
+uint32_t sel_dispatch(uint64_t x, uint32_t i)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2")) {
+        bits::sel_impl = sel_pdep;
+    } else {
+        bits::sel_impl = bits::_sel;
+    }
+    return bits::sel_impl(x, i);
+}
+
+#endif // SDSL_X86_DISPATCH_SYMBOLS
+
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+
+uint64_t cnt_broadword(uint64_t x)
+{
+    x = x-((x>>1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (0x0101010101010101ull*x >> 56);
+}
+
+__attribute__((target("popcnt")))
+uint64_t cnt_popcnt(uint64_t x)
+{
+    return static_cast<uint64_t>(__builtin_popcountll(x));
+}
+
+uint64_t cnt_dispatch(uint64_t x)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt")) {
+        bits::cnt_impl = cnt_popcnt;
+    } else {
+        bits::cnt_impl = cnt_broadword;
+    }
+    return bits::cnt_impl(x);
+}
+
+#endif // SDSL_X86_DISPATCH_SYMBOLS
+
+} // end unnamed namespace
+
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+// points at the CPUID probe until the first call replaces it with the
+// kernel for the executing CPU
+uint32_t (*bits::sel_impl)(uint64_t, uint32_t) = sel_dispatch;
+#endif
+
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+// points at the CPUID probe until the first call replaces it with the
+// kernel for the executing CPU
+uint64_t (*bits::cnt_impl)(uint64_t) = cnt_dispatch;
+#endif
+
+uint64_t bits::cnt_words(const uint64_t* word, uint64_t word_num)
+{
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+    if (word_num < 8) { // dispatch overhead does not pay off for short runs
+        return cnt_words_scalar(word, word_num);
+    }
+    return cnt_words_impl(word, word_num);
+#else
+    return cnt_words_scalar(word, word_num);
+#endif
+}
+
+uint64_t bits::cnt10_words(const uint64_t* word, uint64_t word_num)
+{
+    if (word_num == 0)
+        return 0;
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+    if (word_num < 8) { // dispatch overhead does not pay off for short runs
+        return cnt10_words_scalar(word, word_num);
+    }
+    return cnt10_words_impl(word, word_num);
+#else
+    return cnt10_words_scalar(word, word_num);
+#endif
+}
+
+uint64_t bits::cnt01_words(const uint64_t* word, uint64_t word_num)
+{
+    if (word_num == 0)
+        return 0;
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+    if (word_num < 8) { // dispatch overhead does not pay off for short runs
+        return cnt01_words_scalar(word, word_num);
+    }
+    return cnt01_words_impl(word, word_num);
+#else
+    return cnt01_words_scalar(word, word_num);
+#endif
+}
+
+namespace
+{
+
+// xorshift64*; deterministic input data for the autotuner
+uint64_t tune_rng(uint64_t& s)
+{
+    s ^= s >> 12;
+    s ^= s << 25;
+    s ^= s >> 27;
+    return s * 0x2545F4914F6CDD1Dull;
+}
+
+volatile uint64_t tune_sink; // keeps the measured loops from being optimized away
+
+// best-of-three wall clock time of `body` in nanoseconds
+template<class t_body>
+double tune_time(t_body body)
+{
+    using tune_timer = std::chrono::steady_clock;
+    double best = 0;
+    for (int run=0; run < 3; ++run) {
+        auto start = tune_timer::now();
+        body();
+        auto stop = tune_timer::now();
+        double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        stop-start).count();
+        if (0 == run or ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+#if defined(SDSL_X86_DISPATCH_SYMBOLS) \
+    || defined(SDSL_CNT_WORDS_X86_DISPATCH)
+// one dispatch candidate; the three groups differ only in signature
+template<class t_fn>
+struct tune_candidate {
+    const char* name;
+    t_fn        fn;
+    bool        supported;
+};
+#endif
+
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+const char* cnt_kernel_name(uint64_t (*f)(uint64_t))
+{
+    if (f == cnt_popcnt) return "popcnt";
+    if (f == cnt_broadword) return "broadword";
+    return "?";
+}
+#endif
+
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+const char* sel_kernel_name(uint32_t (*f)(uint64_t, uint32_t))
+{
+    if (f == sel_pdep) return "pdep";
+    if (f == bits::_sel) return "broadword";
+    return "?";
+}
+#endif
+
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+const char* words_kernel_name(uint64_t (*f)(const uint64_t*, uint64_t))
+{
+#ifdef SDSL_CNT_WORDS_HAVE_VPOPCNTDQ
+    if (f == cnt_words_avx512) return "avx512vpopcntdq";
+#endif
+    if (f == cnt_words_avx2) return "avx2";
+    if (f == cnt_words_scalar) return "scalar";
+    if (f == cnt_pattern_words_avx2<true>
+        or f == cnt_pattern_words_avx2<false>) return "avx2";
+    if (f == cnt10_words_scalar or f == cnt01_words_scalar) return "scalar";
+    return "?";
+}
+
+// times one block-count kernel over a 4 KiB working set
+double tune_words_kernel(uint64_t (*f)(const uint64_t*, uint64_t),
+                         const uint64_t* data, uint64_t words)
+{
+    return tune_time([&]() {
+        uint64_t acc = 0;
+        for (int r=0; r < 256; ++r) {
+            acc += f(data, words);
+        }
+        tune_sink = acc;
+    });
+}
+#endif
+
+} // end unnamed namespace
+
+void bits::autotune()
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    uint64_t data[512];
+    for (uint64_t& w : data) {
+        w = tune_rng(seed);
+    }
+    (void)data; (void)seed; // unused on builds without any dispatch
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+    {
+        __builtin_cpu_init();
+        const tune_candidate<uint64_t (*)(uint64_t)> candidates[] = {
+            { "broadword", cnt_broadword, true },
+            { "popcnt", cnt_popcnt, (bool)__builtin_cpu_supports("popcnt") },
+        };
+        double best = 0;
+        for (const auto& c : candidates) {
+            if (!c.supported) {
+                continue;
+            }
+            double ns = tune_time([&]() {
+                uint64_t acc = 0;
+                for (uint32_t i=0; i < (1u<<15); ++i) {
+                    acc += c.fn(data[i & 511]);
+                }
+                tune_sink = acc;
+            });
+            if (0 == best or ns < best) {
+                best = ns;
+                cnt_impl = c.fn;
+            }
+        }
+    }
+#endif
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+    {
+        __builtin_cpu_init();
+        uint32_t ranks[512];
+        for (uint32_t i=0; i < 512; ++i) {
+            if (0 == data[i]) {
+                data[i] = 1;
+            }
+            ranks[i] = 1 + (uint32_t)(tune_rng(seed) % cnt(data[i]));
+        }
+        const tune_candidate<uint32_t (*)(uint64_t, uint32_t)> candidates[] = {
+            { "broadword", bits::_sel, true },
+            { "pdep", sel_pdep, (bool)__builtin_cpu_supports("bmi2") },
+        };
+        double best = 0;
+        for (const auto& c : candidates) {
+            if (!c.supported) {
+                continue;
+            }
+            double ns = tune_time([&]() {
+                uint64_t acc = 0;
+                for (uint32_t i=0; i < (1u<<15); ++i) {
+                    acc += c.fn(data[i & 511], ranks[i & 511]);
+                }
+                tune_sink = acc;
+            });
+            if (0 == best or ns < best) {
+                best = ns;
+                sel_impl = c.fn;
+            }
+        }
+    }
+#endif
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+    {
+        __builtin_cpu_init();
+        const bool avx2 = __builtin_cpu_supports("avx2");
+        const tune_candidate<uint64_t (*)(const uint64_t*, uint64_t)>
+        cnt_candidates[] = {
+            { "scalar", cnt_words_scalar, true },
+            { "avx2", cnt_words_avx2, avx2 },
+#ifdef SDSL_CNT_WORDS_HAVE_VPOPCNTDQ
+            {
+                "avx512vpopcntdq", cnt_words_avx512,
+                (bool)(__builtin_cpu_supports("avx512vpopcntdq")
+                       and __builtin_cpu_supports("avx512f"))
+            },
+#endif
+        };
+        const tune_candidate<uint64_t (*)(const uint64_t*, uint64_t)>
+        cnt10_candidates[] = {
+            { "scalar", cnt10_words_scalar, true },
+            { "avx2", cnt_pattern_words_avx2<true>, avx2 },
+        };
+        const tune_candidate<uint64_t (*)(const uint64_t*, uint64_t)>
+        cnt01_candidates[] = {
+            { "scalar", cnt01_words_scalar, true },
+            { "avx2", cnt_pattern_words_avx2<false>, avx2 },
+        };
+        struct {
+            const tune_candidate<uint64_t (*)(const uint64_t*, uint64_t)>* candidates;
+            size_t num;
+            uint64_t (**impl)(const uint64_t*, uint64_t);
+        } groups[] = {
+            { cnt_candidates, sizeof(cnt_candidates)/sizeof(cnt_candidates[0]), &cnt_words_impl },
+            { cnt10_candidates, 2, &cnt10_words_impl },
+            { cnt01_candidates, 2, &cnt01_words_impl },
+        };
+        for (const auto& g : groups) {
+            double best = 0;
+            for (size_t i=0; i < g.num; ++i) {
+                if (!g.candidates[i].supported) {
+                    continue;
+                }
+                double ns = tune_words_kernel(g.candidates[i].fn, data, 512);
+                if (0 == best or ns < best) {
+                    best = ns;
+                    *g.impl = g.candidates[i].fn;
+                }
+            }
+        }
+    }
+#endif
+}
+
+void bits::write_dispatch_report(std::ostream& out)
+{
+    // force the first-use resolution of all dispatch pointers
+    uint64_t probe[16] = {all_set, 1, 2, 3, 4, 5, 6, 7,
+                          8, 9, 10, 11, 12, 13, 14, 15};
+    tune_sink = cnt(probe[0]) + sel(probe[0], 1) + cnt_words(probe, 16)
+                + cnt10_words(probe, 16) + cnt01_words(probe, 16);
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+    out << "cnt: " << cnt_kernel_name(cnt_impl)
+        << " (candidates: broadword popcnt)" << std::endl;
+#else
+    out << "cnt: compile-time" << std::endl;
+#endif
+#ifdef SDSL_X86_DISPATCH_SYMBOLS
+    out << "sel: " << sel_kernel_name(sel_impl)
+        << " (candidates: broadword pdep)" << std::endl;
+#else
+    out << "sel: compile-time" << std::endl;
+#endif
+#ifdef SDSL_CNT_WORDS_X86_DISPATCH
+    out << "cnt_words: " << words_kernel_name(cnt_words_impl)
+        << " (candidates: scalar avx2"
+#ifdef SDSL_CNT_WORDS_HAVE_VPOPCNTDQ
+        << " avx512vpopcntdq"
+#endif
+        << ")" << std::endl;
+    out << "cnt10_words: " << words_kernel_name(cnt10_words_impl)
+        << " (candidates: scalar avx2)" << std::endl;
+    out << "cnt01_words: " << words_kernel_name(cnt01_words_impl)
+        << " (candidates: scalar avx2)" << std::endl;
+#else
+    out << "cnt_words: compile-time" << std::endl;
+    out << "cnt10_words: compile-time" << std::endl;
+    out << "cnt01_words: compile-time" << std::endl;
+#endif
+}
+
 const uint8_t bits::lt_cnt[] = {
     0, 1, 1, 2, 1, 2, 2, 3,
     1, 2, 2, 3, 2, 3, 3, 4,
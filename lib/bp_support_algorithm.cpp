@@ -103,7 +103,17 @@ near_find_close(const bit_vector& bp, const uint64_t i,
         }
     }
     const uint64_t* b = bp.data();
-    for (uint64_t j=l; j<r; j+=8) {
+    for (uint64_t j=l; j<r;) {
+        if (0 == (j&0x3F) and j+64 <= r) {
+            // word skip: excess can only drop to 0 in this word if the
+            // word contains at least excess closing parentheses
+            difference_type cnt = (difference_type)bits::cnt(*(b+(j>>6)));
+            if (excess > 64-cnt) {
+                excess += 2*cnt-64;
+                j += 64;
+                continue;
+            }
+        }
         if (excess <= 8) {
             assert(excess>0);
             uint32_t x = excess::data.min_match_pos_packed[((*(b+(j>>6)))>>(j&0x3F))&0xFF ];
@@ -113,6 +123,7 @@ near_find_close(const bit_vector& bp, const uint64_t i,
             }
         }
         excess += excess::data.word_sum[((*(b+(j>>6)))>>(j&0x3F))&0xFF ];
+        j += 8;
     }
     for (uint64_t j=std::max(l,r); j < end; ++j)	{
         if (bp[j])
@@ -190,7 +201,18 @@ near_fwd_excess(const bit_vector& bp, uint64_t i, bit_vector::difference_type re
     }
     excess += 8;
     const uint64_t* b = bp.data();
-    for (uint64_t j=l; j < r; j+=8) {
+    for (uint64_t j=l; j < r;) {
+        if (0 == (j&0x3F) and j+64 <= r) {
+            // word skip: the relative excess is only reachable in this
+            // word if it lies within [cnt-64, cnt], the range spanned by
+            // the word's closing and opening parentheses
+            difference_type cnt = (difference_type)bits::cnt(*(b+(j>>6)));
+            if (excess-8 > cnt or excess-8 < cnt-64) {
+                excess += 64-2*cnt;
+                j += 64;
+                continue;
+            }
+        }
         if (excess >= 0 and  excess <= 16) {
             uint32_t x = excess::data.near_fwd_pos[(excess<<8) + (((*(b+(j>>6)))>>(j&0x3F))&0xFF) ];
             if (x < 8) {
@@ -198,6 +220,7 @@ near_fwd_excess(const bit_vector& bp, uint64_t i, bit_vector::difference_type re
             }
         }
         excess -= excess::data.word_sum[((*(b+(j>>6)))>>(j&0x3F))&0xFF ];
+        j += 8;
     }
     excess -= 8;
     for (uint64_t j=std::max(l,r); j < end; ++j) {
@@ -4,5 +4,13 @@ namespace sdsl
 {
 
 byte_sa_algo_type construct_config::byte_algo_sa = LIBDIVSUFSORT;
+int_sa_algo_type  construct_config::int_algo_sa  = QSUFSORT;
+uint64_t construct_config::num_threads = 0;
+bool construct_config::pipelined = false;
+bool construct_config::parallel_components = false;
+uint64_t construct_config::io_buffer_size = 0;
+uint64_t construct_config::io_async_streams = 0;
+uint64_t construct_config::stream_queue_depth = 0;
+uint64_t construct_config::stream_buffer_size = 0;
 
 }
@@ -4,11 +4,12 @@
 #include "sdsl/construct_isa.hpp"
 #include "sdsl/int_vector_buffer.hpp"
 #include <string>
+#include <algorithm>
 
 namespace sdsl
 {
 
-void construct_isa(cache_config& config)
+void construct_isa(cache_config& config, uint64_t isa_mem_budget)
 {
     typedef int_vector<>::size_type size_type;
     if (!cache_file_exists(conf::KEY_ISA, config)) {   // if isa is not already on disk => calculate it
@@ -16,11 +17,40 @@ void construct_isa(cache_config& config)
         if (!sa_buf.is_open()) {
             throw std::ios_base::failure("cst_construct: Cannot load SA from file system!");
         }
-        int_vector<> isa(sa_buf.size());
-        for (size_type i=0; i < isa.size(); ++i) {
-            isa[ sa_buf[i] ] = i;
+        size_type n = sa_buf.size();
+        if (0 == isa_mem_budget or isa_mem_budget >= (n<<3)) {
+            // the full ISA fits into the budget => single scatter pass
+            int_vector<> isa(n);
+            for (size_type i=0; i < n; ++i) {
+                isa[ sa_buf[i] ] = i;
+            }
+            store_to_cache(isa, conf::KEY_ISA, config);
+        } else {
+            // blocked construction: only a slice of the ISA is kept in
+            // memory; each pass streams the SA sequentially and collects
+            // the entries which fall into the current slice, so the peak
+            // is the budget instead of n words, at the cost of
+            // ceil(8n/budget) sequential SA scans
+            size_type m = std::max<size_type>(isa_mem_budget>>3, 1);
+            size_type buffer_size = 1000000; // buffer_size is a multiple of 8!
+            int_vector_buffer<> isa_buf(cache_file_name(conf::KEY_ISA, config),
+                                        std::ios::out, buffer_size, 64);
+            int_vector<> slice(std::min(m, n));
+            for (size_type lo=0; lo < n; lo += m) {
+                size_type hi = std::min(n, lo+m);
+                for (size_type i=0; i < n; ++i) {
+                    size_type sa = sa_buf[i];
+                    if (lo <= sa and sa < hi) {
+                        slice[sa-lo] = i;
+                    }
+                }
+                for (size_type j=0; j < hi-lo; ++j) {
+                    isa_buf.push_back(slice[j]);
+                }
+            }
+            isa_buf.close();
+            register_cache_file(conf::KEY_ISA, config);
         }
-        store_to_cache(isa, conf::KEY_ISA, config);
     }
 }
 
@@ -5,17 +5,18 @@
 
 #include "sdsl/construct_lcp.hpp"
 #include "sdsl/construct.hpp"
+#include "sdsl/int_vector_mapper.hpp"
 #include <stdexcept>
 #include <algorithm>
 
 namespace sdsl
 {
 
-void construct_lcp_semi_extern_PHI(cache_config& config)
+template<class t_sa_buf>
+static void _construct_lcp_semi_extern_PHI(cache_config& config, t_sa_buf& sa_buf)
 {
     typedef int_vector<>::size_type size_type;
     size_type buffer_size = 4000000; // buffer_size is a multiple of 8!
-    int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config), std::ios::in, buffer_size);
     size_type n = sa_buf.size();
     if (1==n) {
         int_vector<> lcp(1, 0);
@@ -29,6 +30,9 @@ void construct_lcp_semi_extern_PHI(cache_config& config)
     // n-1 is the maximum entry in SA
     int_vector<64> plcp((n-1+q)>>log_q);
 
+    // progress covers the three scans: PHI, sparse PLCP and the LCP output
+    construct_progress::phase progress("LCP", 2*n + plcp.size());
+
     for (size_type i=0, sai_1=0; i < n; ++i) {   // we can start at i=0. if SA[i]%q==0
         // we set PHI[(SA[i]=n-1)%q]=0, since T[0]!=T[n-1]
         size_type sai = sa_buf[i];
@@ -40,6 +44,9 @@ void construct_lcp_semi_extern_PHI(cache_config& config)
             plcp[sai>>log_q] = sai_1;
         }
         sai_1 = sai;
+        if (0 == (i & 0xFFFFF)) {
+            construct_progress::report(i);
+        }
     }
 
     int_vector<8> text;
@@ -56,6 +63,9 @@ void construct_lcp_semi_extern_PHI(cache_config& config)
         } else {
             l = 0;
         }
+        if (0 == (i & 0xFFFF)) {
+            construct_progress::report(n+i);
+        }
     }
 
     int_vector_buffer<> lcp_out_buf(cache_file_name(conf::KEY_LCP, config), std::ios::out, buffer_size, sa_buf.width());	// open buffer for plcp
@@ -88,12 +98,30 @@ void construct_lcp_semi_extern_PHI(cache_config& config)
         }
 #endif
         sai_1 = sai;
+        if (0 == (i & 0xFFFFF)) {
+            construct_progress::report(n+plcp.size()+i);
+        }
     }
     lcp_out_buf.close();
     register_cache_file(conf::KEY_LCP, config);
     return;
 }
 
+void construct_lcp_semi_extern_PHI(cache_config& config)
+{
+    std::string sa_file = cache_file_name(conf::KEY_SA, config);
+    if (is_ram_file(sa_file)) {
+        // ram files cannot be mapped; stream through the copying buffer
+        int_vector_buffer<> sa_buf(sa_file, std::ios::in, 4000000);
+        _construct_lcp_semi_extern_PHI(config, sa_buf);
+    } else {
+        // both SA passes are sequential; the windowed mapping reads the
+        // file in place instead of copying blocks into a buffer
+        int_vector_window_buffer<> sa_buf(sa_file);
+        _construct_lcp_semi_extern_PHI(config, sa_buf);
+    }
+}
+
 void construct_lcp_go(cache_config& config)
 {
     typedef int_vector<>::size_type size_type;
@@ -123,7 +151,13 @@ void construct_lcp_go(cache_config& config)
     unsigned char alphabet[257] = {0};
     uint8_t sigma = 0;
 
-    tLI m_list[2][256];
+    index_chunk_arena m_arena; // chunk storage shared by all index queues
+    arena_index_queue m_list[2][256];
+    for (size_type x=0; x < 2; ++x) {
+        for (size_type c=0; c < 256; ++c) {
+            m_list[x][c].set_arena(&m_arena);
+        }
+    }
     size_type m_char_count[2] = {0};
     uint8_t m_chars[2][256] = {{0},{0}};
 
@@ -340,7 +374,7 @@ void construct_lcp_go(cache_config& config)
                 std::sort(m_chars[mm1_mod2], m_chars[mm1_mod2]+m_char_count[mm1_mod2]); // TODO: ersetzen?
 
                 for (size_type mc=0; mc<m_char_count[mm1_mod2]; ++mc) { // for every character
-                    tLI& mm1_mc_list = m_list[mm1_mod2][m_chars[mm1_mod2][ m_char_count[mm1_mod2]-1-  mc ]];
+                    arena_index_queue& mm1_mc_list = m_list[mm1_mod2][m_chars[mm1_mod2][ m_char_count[mm1_mod2]-1-  mc ]];
 //						size_type old_i = nn;
                     while (!mm1_mc_list.empty()) {
                         size_type i = mm1_mc_list.front();  // i in [0..n-1]
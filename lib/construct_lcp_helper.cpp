@@ -60,45 +60,90 @@ buffered_char_queue::~buffered_char_queue()
     sdsl::remove(m_file_name);
 }
 
+void buffered_char_queue::flush_write_buf()
+{
+    if (!m_sync) { // if not sync, write block to disk
+        if (!m_stream.is_open()) {
+            m_stream.open(m_file_name, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        }
+        m_stream.seekp(m_buffer_size * (m_wb++), std::ios::beg);
+        m_stream.write((char*) m_write_buf, m_buffer_size);
+        ++m_disk_buffered_blocks;
+    }
+    m_sync = 0;
+    m_widx = 0;
+}
+
+void buffered_char_queue::refill_read_buf()
+{
+    if (m_disk_buffered_blocks > 0) {
+        m_stream.seekg(m_buffer_size * (m_rb++), std::ios::beg);
+        m_stream.read((char*) m_read_buf, m_buffer_size);
+        --m_disk_buffered_blocks;
+    } else { // m_disk_buffered_blocks == 0
+        m_sync = 1;
+        memcpy(m_read_buf, m_write_buf, m_widx);
+    }
+    m_ridx = 0;
+}
+
 void buffered_char_queue::push_back(uint8_t x)
 {
     m_write_buf[m_widx] = x;
     if (m_sync) {
         m_read_buf[m_widx] = x;
     }
-    ++m_widx;
-    if (m_widx == m_buffer_size) {
-        if (!m_sync) { // if not sync, write block to disk
-            if (!m_stream.is_open()) {
-                m_stream.open(m_file_name, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
-            }
-            m_stream.seekp(m_buffer_size * (m_wb++), std::ios::beg);
-            m_stream.write((char*) m_write_buf, m_buffer_size);
-            ++m_disk_buffered_blocks;
+    m_widx = (m_widx+1) & (m_buffer_size-1);
+    if (0 == m_widx) {
+        flush_write_buf();
+    }
+}
+
+void buffered_char_queue::push_back(const uint8_t* buf, size_type len)
+{
+    while (len > 0) {
+        size_type chunk = m_buffer_size - m_widx;
+        if (chunk > len)
+            chunk = len;
+        memcpy(m_write_buf + m_widx, buf, chunk);
+        if (m_sync) {
+            memcpy(m_read_buf + m_widx, buf, chunk);
+        }
+        m_widx += chunk;
+        buf    += chunk;
+        len    -= chunk;
+        if (m_widx == m_buffer_size) {
+            flush_write_buf();
         }
-        m_sync = 0;
-        m_widx = 0;
     }
 }
 
 uint8_t buffered_char_queue::pop_front()
 {
     uint8_t x = m_read_buf[m_ridx];
-    ++m_ridx;
-    if (m_ridx ==  m_buffer_size) {
-        if (m_disk_buffered_blocks > 0) {
-            m_stream.seekg(m_buffer_size * (m_rb++), std::ios::beg);
-            m_stream.read((char*) m_read_buf, m_buffer_size);
-            --m_disk_buffered_blocks;
-        } else { // m_disk_buffered_blocks == 0
-            m_sync = 1;
-            memcpy(m_read_buf, m_write_buf, m_widx+1);
-        }
-        m_ridx = 0;
+    m_ridx = (m_ridx+1) & (m_buffer_size-1);
+    if (0 == m_ridx) {
+        refill_read_buf();
     }
     return x;
 }
 
+void buffered_char_queue::pop_front(uint8_t* buf, size_type len)
+{
+    while (len > 0) {
+        size_type chunk = m_buffer_size - m_ridx;
+        if (chunk > len)
+            chunk = len;
+        memcpy(buf, m_read_buf + m_ridx, chunk);
+        m_ridx += chunk;
+        buf    += chunk;
+        len    -= chunk;
+        if (m_ridx == m_buffer_size) {
+            refill_read_buf();
+        }
+    }
+}
+
 void lcp_info(cache_config& config)
 {
     typedef int_vector<>::size_type size_type;
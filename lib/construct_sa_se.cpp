@@ -5,7 +5,7 @@ namespace sdsl
 
 void _construct_sa_IS(int_vector<> &text, int_vector<> &sa, std::string& filename_sa, size_t n, size_t text_offset, size_t sigma, uint64_t recursion)
 {
-    uint64_t buffersize = 1024*1024/8;
+    uint64_t buffersize = _sa_se_buffersize();
 
     size_t name = 0;
     size_t number_of_lms_strings = 0;
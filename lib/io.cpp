@@ -124,6 +124,58 @@ bool cache_file_exists(const std::string& key, const cache_config& config)
     return false;
 }
 
+uint64_t file_checksum(const std::string& file)
+{
+    isfstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        return 0;
+    }
+    uint64_t h = 0xcbf29ce484222325ULL; // FNV-1a offset basis
+    std::vector<char> buf(1024*1024);
+    while (in) {
+        in.read(buf.data(), buf.size());
+        std::streamsize len = in.gcount();
+        for (std::streamsize i=0; i < len; ++i) {
+            h ^= static_cast<unsigned char>(buf[i]);
+            h *= 0x100000001b3ULL; // FNV-1a prime
+        }
+    }
+    return h;
+}
+
+static std::string checkpoint_file_name(const std::string& key, const cache_config& config)
+{
+    return cache_file_name(key, config) + ".chk";
+}
+
+bool write_checkpoint(const std::string& key, const cache_config& config)
+{
+    std::string file = cache_file_name(key, config);
+    uint64_t checksum = file_checksum(file);
+    uint64_t size = util::file_size(file);
+    osfstream out(checkpoint_file_name(key, config), std::ios::trunc | std::ios::out);
+    if (!out) {
+        return false;
+    }
+    out << checksum << " " << size << "\n";
+    return out.good();
+}
+
+bool is_checkpoint_valid(const std::string& key, const cache_config& config)
+{
+    isfstream in(checkpoint_file_name(key, config));
+    if (!in) {
+        return false;
+    }
+    uint64_t checksum = 0, size = 0;
+    in >> checksum >> size;
+    if (!in) {
+        return false;
+    }
+    std::string file = cache_file_name(key, config);
+    return util::file_size(file) == size and file_checksum(file) == checksum;
+}
+
 std::string tmp_file(const cache_config& config, std::string name_part)
 {
     return config.dir+"/"+ util::to_string(util::pid()) + "_" + util::to_string(util::id()) + name_part + ".sdsl";
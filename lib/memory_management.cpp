@@ -10,6 +10,11 @@ namespace sdsl
 void output_event_json(std::ostream& out,const memory_monitor::mm_event& ev,const memory_monitor& m)
 {
     out << "\t\t" << "\"name\" : " << "\"" << ev.name << "\",\n";
+    if (ev.perf.cycles >= 0) { // hardware counters were sampled
+        out << "\t\t" << "\"cycles\" : " << ev.perf.cycles << ",\n";
+        out << "\t\t" << "\"llc_misses\" : " << ev.perf.llc_misses << ",\n";
+        out << "\t\t" << "\"dtlb_misses\" : " << ev.perf.dtlb_misses << ",\n";
+    }
     out << "\t\t" << "\"usage\" : [" << "\n";
     for (size_t j=0; j<ev.allocations.size(); j++)  {
         out << "\t\t\t[" << duration_cast<milliseconds>(ev.allocations[j].timestamp-m.start_log).count()
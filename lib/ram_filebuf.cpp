@@ -20,23 +20,13 @@ ram_filebuf::ram_filebuf(std::vector<char>& ram_file) : m_ram_file(&ram_file)
 std::streambuf*
 ram_filebuf::open(const std::string name, std::ios_base::openmode mode)
 {
-    // open ram_file
-    if ((mode & std::ios_base::in) and !(mode & std::ios_base::trunc)) {
-        // file must exist, initial position at the start
-        if (!ram_fs::exists(name)) {
-            m_ram_file = nullptr;
-        } else {
-            m_ram_file = &ram_fs::content(name);
-        }
-    } else { // existence of file not required
-        if (!ram_fs::exists(name)) {
-            // create empty file, if it does not yet exist
-            ram_fs::store(name, ram_fs::content_type());// TODO: create method in ram_fs?? or store w 1 arg?
-        }
-        m_ram_file = &ram_fs::content(name);
-        if ((mode & std::ios_base::out) and !(mode & std::ios_base::app)) {
-            m_ram_file->clear();
-        }
+    // open ram_file with a single name lookup; all subsequent operations
+    // go through the returned handle without locking, see ram_fs::open_handle
+    const bool must_exist = (mode & std::ios_base::in) and !(mode & std::ios_base::trunc);
+    m_ram_file = ram_fs::open_handle(name, !must_exist);
+    if (m_ram_file and !must_exist
+        and (mode & std::ios_base::out) and !(mode & std::ios_base::app)) {
+        m_ram_file->clear();
     }
 
     if (m_ram_file and(mode & std::ios_base::trunc)) {
@@ -3,18 +3,22 @@
 #include <cstdio>
 #include <iostream>
 #include <algorithm>
+#include <functional>
 
 static int nifty_counter = 0;
 
-sdsl::ram_fs::mss_type sdsl::ram_fs::m_map;
-std::recursive_mutex sdsl::ram_fs::m_rlock;
+sdsl::ram_fs::mss_type sdsl::ram_fs::m_map[sdsl::ram_fs::m_shards];
+std::recursive_mutex sdsl::ram_fs::m_rlock[sdsl::ram_fs::m_shards];
+const size_t sdsl::ram_fs::m_shards;
 
 
 sdsl::ram_fs_initializer::ram_fs_initializer()
 {
     if (0 == nifty_counter++) {
-        if (!ram_fs::m_map.empty()) {
-            throw std::logic_error("Static preinitialized object is not empty.");
+        for (size_t s=0; s < ram_fs::m_shards; ++s) {
+            if (!ram_fs::m_map[s].empty()) {
+                throw std::logic_error("Static preinitialized object is not empty.");
+            }
         }
     }
 }
@@ -31,38 +35,75 @@ namespace sdsl
 
 ram_fs::ram_fs() {}
 
+size_t
+ram_fs::shard_id(const std::string& name)
+{
+    return std::hash<std::string>()(name) % m_shards;
+}
+
 void
 ram_fs::store(const std::string& name, content_type data)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_rlock);
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
     if (!exists(name)) {
         std::string cname = name;
-        m_map.insert(std::make_pair(std::move(cname), std::move(data)));
+        m_map[s].insert(std::make_pair(std::move(cname), std::move(data)));
     } else {
-        m_map[name] = std::move(data);
+        m_map[s][name] = std::move(data);
     }
 }
 
 bool
 ram_fs::exists(const std::string& name)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_rlock);
-    return m_map.find(name) != m_map.end();
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
+    return m_map[s].find(name) != m_map[s].end();
 }
 
 ram_fs::content_type&
 ram_fs::content(const std::string& name)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_rlock);
-    return m_map[name];
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
+    return m_map[s][name];
+}
+
+ram_fs::content_type*
+ram_fs::open_handle(const std::string& name, bool create)
+{
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
+    auto it = m_map[s].find(name);
+    if (it == m_map[s].end()) {
+        if (!create) {
+            return nullptr;
+        }
+        it = m_map[s].insert(std::make_pair(name, content_type())).first;
+    }
+    return &(it->second);
+}
+
+std::shared_ptr<const ram_fs::content_type>
+ram_fs::snapshot(const std::string& name)
+{
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
+    auto it = m_map[s].find(name);
+    if (it == m_map[s].end()) {
+        return nullptr;
+    }
+    return std::make_shared<content_type>(it->second);
 }
 
 size_t
 ram_fs::file_size(const std::string& name)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_rlock);
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
     if (exists(name)) {
-        return m_map[name].size();
+        return m_map[s][name].size();
     } else {
         return 0;
     }
@@ -71,17 +112,27 @@ ram_fs::file_size(const std::string& name)
 int
 ram_fs::remove(const std::string& name)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_rlock);
-    m_map.erase(name);
+    size_t s = shard_id(name);
+    std::lock_guard<std::recursive_mutex> lock(m_rlock[s]);
+    m_map[s].erase(name);
     return 0;
 }
 
 int
 ram_fs::rename(const std::string old_filename, const std::string new_filename)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_rlock);
-    m_map[new_filename] = std::move(m_map[old_filename]);
-    remove(old_filename);
+    size_t s_old = shard_id(old_filename);
+    size_t s_new = shard_id(new_filename);
+    // lock the shards in a fixed order to avoid deadlocks
+    std::lock_guard<std::recursive_mutex> lock1(m_rlock[std::min(s_old, s_new)]);
+    if (s_old != s_new) {
+        std::lock_guard<std::recursive_mutex> lock2(m_rlock[std::max(s_old, s_new)]);
+        m_map[s_new][new_filename] = std::move(m_map[s_old][old_filename]);
+        m_map[s_old].erase(old_filename);
+        return 0;
+    }
+    m_map[s_new][new_filename] = std::move(m_map[s_old][old_filename]);
+    m_map[s_old].erase(old_filename);
     return 0;
 }
 
@@ -1,10 +1,50 @@
 #include "sdsl/sd_vector.hpp"
+#include <atomic>
 #include <cassert>
+#include <thread>
 
 //! Namespace for the succinct data structure library
 namespace sdsl
 {
 
+namespace
+{
+
+typedef sd_vector_builder::size_type size_type;
+
+size_type shards_item_count(const std::vector<std::pair<const uint64_t*, size_type>>& shards)
+{
+    size_type m = 0;
+    for (const auto& shard : shards) {
+        m += shard.second;
+    }
+    return m;
+}
+
+// or `len` bits of `value` (pre-masked) into the data at bit position
+// `bit_pos`; shard borders may share a word between threads, therefore
+// the or is atomic; as the target bits are zero, or equals assignment
+void or_bits_atomic(uint64_t* data, size_type bit_pos, uint64_t value, uint8_t len)
+{
+    uint64_t* word   = data + (bit_pos>>6);
+    uint8_t   offset = bit_pos&0x3F;
+#ifndef MSVC_COMPILER
+    __atomic_fetch_or(word, value<<offset, __ATOMIC_RELAXED);
+    if (offset+len > 64) {
+        __atomic_fetch_or(word+1, value>>(64-offset), __ATOMIC_RELAXED);
+    }
+#else
+    // the parallel fill is disabled for MSVC, so this is never
+    // executed concurrently
+    *word |= value<<offset;
+    if (offset+len > 64) {
+        *(word+1) |= value>>(64-offset);
+    }
+#endif
+}
+
+} // end unnamed namespace
+
 sd_vector_builder::sd_vector_builder() :
     m_size(0), m_capacity(0),
     m_wl(0),
@@ -36,6 +76,85 @@ sd_vector_builder::sd_vector_builder(size_type n, size_type m) :
     m_high = bit_vector(m_capacity + (1ULL << logm), 0);
 }
 
+sd_vector_builder::sd_vector_builder(size_type n,
+                                     const std::vector<std::pair<const uint64_t*, size_type>>& shards,
+                                     uint64_t threads) :
+    sd_vector_builder(n, shards_item_count(shards))
+{
+    if (0 == m_capacity) {
+        return;
+    }
+    if (0 == threads) {
+        threads = std::thread::hardware_concurrency();
+        if (0 == threads)
+            threads = 1;
+    }
+#ifdef MSVC_COMPILER
+    threads = 1; // parallel fill relies on GCC/Clang atomic builtins
+#endif
+    // start index of each shard in the merged sequence, and a cheap
+    // sequential check of the shard borders; the order inside a shard
+    // is checked during the parallel fill
+    std::vector<size_type> shard_begin(shards.size(), 0);
+    size_type items = 0;
+    size_type last  = 0;
+    for (size_type s=0; s < shards.size(); ++s) {
+        shard_begin[s] = items;
+        if (0 == shards[s].second)
+            continue;
+        if (items > 0 and shards[s].first[0] <= last) {
+            throw std::runtime_error("sd_vector_builder: shards are not strictly increasing.");
+        }
+        items += shards[s].second;
+        last   = shards[s].first[shards[s].second-1];
+    }
+    if (last >= m_size) {
+        throw std::runtime_error("sd_vector_builder: shard position is too large.");
+    }
+    // each thread claims whole shards; an item with merged index j and
+    // position p goes to m_low[j] and to bit (p >> m_wl) + j of m_high,
+    // so all writes are position-independent and need no merge loop
+    std::atomic<size_type>  next_shard(0);
+    std::atomic<bool>       sorted(true);
+    uint64_t*               low_data  = m_low.data();
+    uint64_t*               high_data = m_high.data();
+    const uint8_t           wl        = (uint8_t)m_wl;
+    std::vector<std::thread> pool;
+    for (uint64_t t=0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            size_type s = 0;
+            while ((s = next_shard.fetch_add(1)) < shards.size()) {
+                const uint64_t* data = shards[s].first;
+                size_type j = shard_begin[s];
+                for (size_type i=0; i < shards[s].second; ++i, ++j) {
+                    size_type p = data[i];
+                    if (i > 0 and p <= data[i-1]) {
+                        sorted = false;
+                        return;
+                    }
+                    or_bits_atomic(low_data, j*wl, p & bits::lo_set[wl], wl);
+                    or_bits_atomic(high_data, (p>>wl)+j, 1, 1);
+                }
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    if (!sorted) {
+        throw std::runtime_error("sd_vector_builder: shard is not sorted.");
+    }
+    m_items     = m_capacity;
+    m_tail      = last+1;
+    m_last_high = last>>m_wl;
+    m_highpos   = m_last_high+m_items;
+}
+
+void sd_vector_builder::append_block(const uint64_t* sorted_positions, size_type n)
+{
+    for (size_type i=0; i < n; ++i) {
+        set(sorted_positions[i]);
+    }
+}
+
 void sd_vector_builder::swap(sd_vector_builder& sdb)
 {
     std::swap(m_size, sdb.m_size);
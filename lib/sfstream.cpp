@@ -2,6 +2,8 @@
 #include "sdsl/util.hpp"
 #include "sdsl/ram_fs.hpp"
 #include "sdsl/ram_filebuf.hpp"
+#include "sdsl/async_filebuf.hpp"
+#include "sdsl/construct_config.hpp"
 #include <iostream>
 
 namespace sdsl
@@ -25,14 +27,28 @@ osfstream::open(const std::string& file, std::ios_base::openmode mode)
 {
     delete m_streambuf;
     m_streambuf = nullptr;
+    m_async = false;
     m_file = file;
     std::streambuf* success = nullptr;
     if (is_ram_file(file)) {
         m_streambuf = new ram_filebuf();
         success = ((ram_filebuf*)m_streambuf)->open(m_file, mode);
     } else {
-        m_streambuf = new std::filebuf();
-        success = ((std::filebuf*)m_streambuf)->open(m_file, mode);
+        if (construct_config::stream_queue_depth > 0
+            and !(mode & (std::ios_base::in|std::ios_base::app|std::ios_base::ate))) {
+            async_filebuf* buf = new async_filebuf();
+            success = buf->open(m_file, mode);
+            if (success) {
+                m_streambuf = buf;
+                m_async = true;
+            } else {  // e.g. io_uring and worker thread unavailable
+                delete buf;
+            }
+        }
+        if (nullptr == m_streambuf) {
+            m_streambuf = new std::filebuf();
+            success = ((std::filebuf*)m_streambuf)->open(m_file, mode);
+        }
     }
     if (success) {
         this->clear();
@@ -52,6 +68,8 @@ osfstream::is_open()
         return false;
     if (is_ram_file(m_file)) {
         return ((ram_filebuf*)m_streambuf)->is_open();
+    } else if (m_async) {
+        return ((async_filebuf*)m_streambuf)->is_open();
     } else {
         return ((std::filebuf*)m_streambuf)->is_open();
     }
@@ -66,6 +84,8 @@ osfstream::close()
     } else {
         if (is_ram_file(m_file)) {
             fail = !((ram_filebuf*)m_streambuf)->close();
+        } else if (m_async) {
+            fail = !((async_filebuf*)m_streambuf)->close();
         } else {
             fail = !((std::filebuf*)m_streambuf)->close();
         }
@@ -102,6 +122,8 @@ osfstream::seekp(pos_type pos)
             pos_type p = 0;
             if (is_ram_file(m_file)) {
                 p = ((ram_filebuf*)m_streambuf)->pubseekpos(pos, ios_base::out);
+            } else if (m_async) {
+                p = ((async_filebuf*)m_streambuf)->pubseekpos(pos, ios_base::out);
             } else {
                 p = ((std::filebuf*)m_streambuf)->pubseekpos(pos, ios_base::out);
             }
@@ -128,6 +150,8 @@ osfstream::seekp(off_type off, std::ios_base::seekdir way)
             pos_type p = 0;
             if (is_ram_file(m_file)) {
                 p = ((ram_filebuf*)m_streambuf)->pubseekoff(off, way, ios_base::out);
+            } else if (m_async) {
+                p = ((async_filebuf*)m_streambuf)->pubseekoff(off, way, ios_base::out);
             } else {
                 p = ((std::filebuf*)m_streambuf)->pubseekoff(off, way, ios_base::out);
             }
@@ -144,6 +168,27 @@ osfstream::seekp(off_type off, std::ios_base::seekdir way)
     return *this;
 }
 
+std::streampos
+osfstream::tellp()
+{
+    ios_base::iostate __state = ios_base::goodbit;
+    pos_type p = pos_type(off_type(-1));
+    try {
+        if (!this->fail()) {
+            if (is_ram_file(m_file)) {
+                p = ((ram_filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, ios_base::out);
+            } else if (m_async) {
+                p = ((async_filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, ios_base::out);
+            } else {
+                p = ((std::filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, ios_base::out);
+            }
+        }
+    } catch (...) {
+        M_SETSTATE(ios_base::badbit);
+    }
+    return p;
+}
+
 
 
 //  IMPLEMENTATION OF ISFSTREAM
@@ -164,14 +209,28 @@ isfstream::open(const std::string& file, std::ios_base::openmode mode)
 {
     delete m_streambuf;
     m_streambuf = nullptr;
+    m_async = false;
     m_file = file;
     std::streambuf* success = nullptr;
     if (is_ram_file(file)) {
         m_streambuf = new ram_filebuf();
         success = ((ram_filebuf*)m_streambuf)->open(m_file, mode);
     } else {
-        m_streambuf = new std::filebuf();
-        success = ((std::filebuf*)m_streambuf)->open(m_file, mode);
+        if (construct_config::stream_queue_depth > 0
+            and !(mode & (std::ios_base::out|std::ios_base::app|std::ios_base::ate))) {
+            async_filebuf* buf = new async_filebuf();
+            success = buf->open(m_file, mode);
+            if (success) {
+                m_streambuf = buf;
+                m_async = true;
+            } else {  // e.g. io_uring and worker thread unavailable
+                delete buf;
+            }
+        }
+        if (nullptr == m_streambuf) {
+            m_streambuf = new std::filebuf();
+            success = ((std::filebuf*)m_streambuf)->open(m_file, mode);
+        }
     }
     if (success) {
         this->clear();
@@ -191,6 +250,8 @@ isfstream::is_open()
         return false;
     if (is_ram_file(m_file)) {
         return ((ram_filebuf*)m_streambuf)->is_open();
+    } else if (m_async) {
+        return ((async_filebuf*)m_streambuf)->is_open();
     } else {
         return ((std::filebuf*)m_streambuf)->is_open();
     }
@@ -205,6 +266,8 @@ isfstream::close()
     } else {
         if (is_ram_file(m_file)) {
             fail = !((ram_filebuf*)m_streambuf)->close();
+        } else if (m_async) {
+            fail = !((async_filebuf*)m_streambuf)->close();
         } else {
             fail = !((std::filebuf*)m_streambuf)->close();
         }
@@ -222,6 +285,8 @@ isfstream::seekg(pos_type pos)
             pos_type p = 0;
             if (is_ram_file(m_file)) {
                 p = ((ram_filebuf*)m_streambuf)->pubseekpos(pos, ios_base::in);
+            } else if (m_async) {
+                p = ((async_filebuf*)m_streambuf)->pubseekpos(pos, ios_base::in);
             } else {
                 p = ((std::filebuf*)m_streambuf)->pubseekpos(pos, ios_base::in);
             }
@@ -249,6 +314,8 @@ isfstream::seekg(off_type off, std::ios_base::seekdir way)
             pos_type p = 0;
             if (is_ram_file(m_file)) {
                 p = ((ram_filebuf*)m_streambuf)->pubseekoff(off, way, ios_base::in);
+            } else if (m_async) {
+                p = ((async_filebuf*)m_streambuf)->pubseekoff(off, way, ios_base::in);
             } else {
                 p = ((std::filebuf*)m_streambuf)->pubseekoff(off, way, ios_base::in);
             }
@@ -274,6 +341,8 @@ isfstream::tellg()
         if (!this->fail()) {
             if (is_ram_file(m_file)) {
                 p = ((ram_filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, ios_base::in);
+            } else if (m_async) {
+                p = ((async_filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, ios_base::in);
             } else {
                 p = ((std::filebuf*)m_streambuf)->pubseekoff(0, std::ios_base::cur, ios_base::in);
             }
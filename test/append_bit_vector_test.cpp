@@ -0,0 +1,118 @@
+#include "sdsl/append_bit_vector.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+template<class T>
+class append_bit_vector_test : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<
+append_bit_vector<512>,
+                  append_bit_vector<2048>,
+                  append_bit_vector<1<<16>
+                  > Implementations;
+
+TYPED_TEST_CASE(append_bit_vector_test, Implementations);
+
+template<class t_abv>
+void fill_random(t_abv& abv, vector<bool>& ref, size_t n, uint32_t density,
+                 uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    for (size_t i=0; i < n; ++i) {
+        bool b = (rng() % 1000) < density;
+        abv.push_back(b);
+        ref.push_back(b);
+    }
+}
+
+//! Test access, rank and select against the appended sequence
+TYPED_TEST(append_bit_vector_test, push_back_rank_select)
+{
+    TypeParam abv;
+    vector<bool> ref;
+    fill_random(abv, ref, 10000, 500, 99);
+    ASSERT_EQ(ref.size(), abv.size());
+    uint64_t rank = 0;
+    for (size_t i=0; i < ref.size(); ++i) {
+        ASSERT_EQ(rank, abv.rank(i)) << "i="<<i;
+        ASSERT_EQ((bool)ref[i], (bool)abv[i]) << "i="<<i;
+        if (ref[i]) {
+            ++rank;
+            ASSERT_EQ(i, abv.select(rank)) << "rank="<<rank;
+        }
+    }
+    ASSERT_EQ(rank, abv.rank(abv.size()));
+    ASSERT_EQ(rank, abv.ones());
+}
+
+//! Test a sparse sequence
+TYPED_TEST(append_bit_vector_test, sparse)
+{
+    TypeParam abv;
+    vector<bool> ref;
+    fill_random(abv, ref, 20000, 20, 100);
+    uint64_t rank = 0;
+    for (size_t i=0; i < ref.size(); ++i) {
+        ASSERT_EQ(rank, abv.rank(i)) << "i="<<i;
+        rank += ref[i];
+    }
+}
+
+//! Test the empty sequence and an exactly full tail
+TYPED_TEST(append_bit_vector_test, corner_cases)
+{
+    TypeParam empty;
+    ASSERT_EQ((uint64_t)0, empty.size());
+    ASSERT_EQ((uint64_t)0, empty.ones());
+    ASSERT_EQ((uint64_t)0, empty.rank(0));
+
+    TypeParam abv; // exactly one tail capacity of ones
+    for (size_t i=0; i < 512; ++i) {
+        abv.push_back(1);
+    }
+    ASSERT_EQ((uint64_t)512, abv.size());
+    ASSERT_EQ((uint64_t)512, abv.ones());
+    for (size_t i=0; i <= 512; ++i) {
+        ASSERT_EQ(i, abv.rank(i));
+    }
+    ASSERT_EQ((uint64_t)511, abv.select(512));
+}
+
+//! Test serialize/load in mid-tail state; appending must continue to work
+TYPED_TEST(append_bit_vector_test, serialize_and_load)
+{
+    TypeParam abv;
+    vector<bool> ref;
+    fill_random(abv, ref, 7777, 500, 101);
+    stringstream ss;
+    abv.serialize(ss);
+    TypeParam abv2;
+    abv2.load(ss);
+    ASSERT_EQ(abv.size(), abv2.size());
+    ASSERT_EQ(abv.ones(), abv2.ones());
+    for (size_t i=0; i <= abv.size(); i+=33) {
+        ASSERT_EQ(abv.rank(i), abv2.rank(i));
+    }
+    uint64_t n = abv2.size(), m = abv2.ones();
+    abv2.push_back(1);
+    ASSERT_EQ(m+1, abv2.rank(n+1));
+    ASSERT_EQ(n, abv2.select(m+1));
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
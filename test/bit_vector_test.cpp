@@ -38,6 +38,10 @@ rrr_vector<127>,
 rrr_vector<128>,
 sd_vector<>,
 sd_vector<rrr_vector<63> >,
+gap_vector<>,
+gap_vector<coder::elias_gamma, 64>,
+pef_vector<>,
+pef_vector<256>,
 hyb_vector<>
 > Implementations;
 
@@ -0,0 +1,166 @@
+#include "sdsl/suffix_arrays.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+string temp_dir;
+
+namespace
+{
+
+template<class t_idx>
+bool equal_idx(const t_idx& a, const t_idx& b)
+{
+    stringstream sa, sb;
+    a.serialize(sa);
+    b.serialize(sb);
+    return sa.str() == sb.str();
+}
+
+string random_text(size_t n, uint8_t sigma, std::mt19937_64& rng)
+{
+    string text;
+    for (size_t i=0; i < n; ++i) {
+        text.push_back('a' + rng() % sigma);
+    }
+    return text;
+}
+
+// merged index must equal a fresh build over big sep delta
+void check_merge(const string& big, const string& delta, const string& id)
+{
+    cache_config config(true, temp_dir, "csa_merge_test_"+id);
+    csa_wt<> csa_big, csa_delta, merged, ref;
+    construct_im(csa_big, big, 1);
+    construct_im(csa_delta, delta, 1);
+    merge_csa(csa_big, csa_delta, merged, config);
+    construct_im(ref, big + '\x01' + delta, 1);
+    ASSERT_TRUE(equal_idx(merged, ref)) << id;
+    util::delete_all_files(config.file_map);
+}
+
+// concatenate docs[a..b], each terminated with the delimiter '\x01'
+string cat(const vector<string>& docs, size_t a, size_t b)
+{
+    string t;
+    for (size_t d=a; d <= b; ++d) {
+        t += docs[d];
+        t += '\x01';
+    }
+    return t;
+}
+
+bit_vector borders(const string& text)
+{
+    bit_vector db(text.size(), 0);
+    for (size_t i=0; i < text.size(); ++i) {
+        if (text[i] == '\x01') {
+            db[i] = 1;
+        }
+    }
+    return db;
+}
+
+// carved index must equal a fresh build over docs[a..b]
+void check_carve(const vector<string>& docs, size_t a, size_t b,
+                 const string& id)
+{
+    string text = cat(docs, 0, docs.size()-1);
+    csa_wt<> csa, carved, ref;
+    construct_im(csa, text, 1);
+    carve_csa(csa, borders(text), a, b, carved);
+    construct_im(ref, cat(docs, a, b), 1);
+    ASSERT_TRUE(equal_idx(carved, ref)) << id;
+}
+
+//! Test merge_csa against a fresh build of the joined text
+TEST(csa_merge_test, merge_equals_rebuild)
+{
+    std::mt19937_64 rng(115);
+    check_merge(random_text(3000, 5, rng), random_text(200, 5, rng),
+                "random");
+    check_merge(random_text(1000, 3, rng), random_text(1000, 3, rng),
+                "equal_sizes");
+    check_merge("abracadabra", "cadabra", "tiny");
+    string block = random_text(300, 4, rng);
+    check_merge(block+block+block, block, "repetitive");
+}
+
+//! Test that merge_csa rejects a separator occurring in the texts
+TEST(csa_merge_test, merge_rejects_bad_separator)
+{
+    cache_config config(true, temp_dir, "csa_merge_test_sep");
+    csa_wt<> a, b, merged;
+    construct_im(a, string("ab\x01""ba"), 1);
+    construct_im(b, string("ab"), 1);
+    bool thrown = false;
+    try {
+        merge_csa(a, b, merged, config);
+    } catch (std::logic_error&) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+    util::delete_all_files(config.file_map);
+}
+
+//! Test carve_csa against a fresh build of the document range
+TEST(csa_merge_test, carve_equals_rebuild)
+{
+    std::mt19937_64 rng(116);
+    vector<string> docs;
+    for (int d=0; d < 10; ++d) {
+        docs.push_back(random_text(1 + rng() % 300, 5, rng));
+    }
+    check_carve(docs, 0, docs.size()-1, "all_docs");
+    check_carve(docs, 0, 0, "first_doc");
+    check_carve(docs, docs.size()-1, docs.size()-1, "last_doc");
+    check_carve(docs, 3, 7, "middle_range");
+}
+
+//! Test carve_csa on ranges where plain BWT-row restriction would fail
+TEST(csa_merge_test, carve_crafted)
+{
+    check_carve({"xa", "xa", "z"}, 0, 1, "restriction_counterexample");
+    check_carve({"a", "b", "c"}, 1, 1, "single_char_docs");
+    check_carve({"same", "same", "same"}, 0, 1, "identical_docs");
+}
+
+//! Test that carve_csa rejects invalid document ranges
+TEST(csa_merge_test, carve_rejects_invalid_range)
+{
+    vector<string> docs = {"ab", "cd"};
+    string text = cat(docs, 0, 1);
+    csa_wt<> csa, carved;
+    construct_im(csa, text, 1);
+    bit_vector db = borders(text);
+    for (auto range : vector<pair<size_t,size_t>> {{1,0},{0,2},{2,2}}) {
+        bool thrown = false;
+        try {
+            carve_csa(csa, db, range.first, range.second, carved);
+        } catch (std::logic_error&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown) << "range [" << range.first << ","
+                            << range.second << "]";
+    }
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        // LCOV_EXCL_START
+        cout << "Usage: " << argv[0] << " tmp_dir" << endl;
+        return 1;
+        // LCOV_EXCL_STOP
+    }
+    temp_dir = argv[1];
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,328 @@
+#include "sdsl/suffix_trees.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+string temp_dir;
+
+namespace
+{
+
+string random_text(size_t n, uint8_t sigma, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    string text;
+    for (size_t i=0; i < n; ++i) {
+        text.push_back('a' + rng() % sigma);
+    }
+    return text;
+}
+
+// length of the longest prefix of q[i..] occurring in text
+size_t naive_ms(const string& text, const string& q, size_t i)
+{
+    size_t best = 0;
+    while (i + best < q.size()
+           and text.find(q.substr(i, best + 1)) != string::npos) {
+        ++best;
+    }
+    return best;
+}
+
+template<class t_cst>
+void check_matching_statistics(const string& text)
+{
+    t_cst cst;
+    construct_im(cst, text, 1);
+    std::mt19937_64 rng(31);
+    vector<string> queries;
+    for (size_t i=0; i < 15; ++i) {
+        size_t len = 1 + rng() % 100;
+        if (i % 3 == 0) { // exact substring
+            queries.push_back(text.substr(rng() % (text.size()-len), len));
+        } else { // larger alphabet: includes absent characters
+            string q;
+            for (size_t j=0; j < len; ++j) {
+                q.push_back('a' + rng() % 5);
+            }
+            queries.push_back(q);
+        }
+    }
+    queries.push_back("zzzz"); // fully absent
+    for (auto& q : queries) {
+        auto ms = matching_statistics(cst, q.begin(), q.end());
+        ASSERT_EQ(q.size(), ms.size());
+        for (size_t i=0; i < q.size(); ++i) {
+            ASSERT_EQ(naive_ms(text, q, i), ms[i]) << "i="<<i;
+        }
+        auto mems = maximal_exact_matches(cst, q.begin(), q.end(), 3);
+        vector<pair<uint64_t,uint64_t>> ref;
+        for (size_t i=0; i < q.size(); ++i) {
+            size_t l = naive_ms(text, q, i);
+            if (l >= 3 and (i == 0 or naive_ms(text, q, i-1) <= l)) {
+                ref.emplace_back(i, l);
+            }
+        }
+        ASSERT_TRUE(mems == ref);
+    }
+    string empty;
+    ASSERT_TRUE(matching_statistics(cst, empty.begin(), empty.end()).empty());
+    ASSERT_TRUE(maximal_exact_matches(cst, empty.begin(), empty.end()).empty());
+}
+
+//! Test matching statistics and MEMs against a naive scan
+TEST(cst_extension_test, matching_statistics_and_mems)
+{
+    string text = random_text(1500, 3, 31);
+    check_matching_statistics<cst_sct3<>>(text);
+    check_matching_statistics<cst_sada<>>(text);
+}
+
+template<class t_cst>
+void check_child_cache(const t_cst& cst)
+{
+    cst_child_cache<t_cst> cache(cst, 3);
+    // compare against cst.child on all nodes of the top levels
+    vector<pair<typename t_cst::node_type, size_t>> stack;
+    stack.emplace_back(cst.root(), 0);
+    while (!stack.empty()) {
+        auto v = stack.back().first;
+        auto lvl = stack.back().second;
+        stack.pop_back();
+        if (cst.is_leaf(v) or lvl >= 4) {
+            continue;
+        }
+        for (char c = 'a'; c <= 'f'; ++c) {
+            typename t_cst::size_type cp1 = 0, cp2 = 0;
+            auto w1 = cache.child(v, c, cp1);
+            auto w2 = cst.child(v, c, cp2);
+            ASSERT_TRUE(w1 == w2);
+            // cst_sct3::child may report a different (equally valid)
+            // occurrence for its first/last-child fast paths; the cache
+            // reports the one at the child's left bound
+            if (w1 != cst.root()) {
+                ASSERT_TRUE(cp1 == cp2
+                            or cp1 == get_char_pos(cst.lb(w1), cst.depth(v),
+                                                   cst.csa));
+            }
+        }
+        for (const auto& w : cst.children(v)) {
+            stack.emplace_back(w, lvl + 1);
+        }
+    }
+    // a capped cache keeps working via fallback
+    cst_child_cache<t_cst> tiny(cst, 3, 2);
+    for (char c = 'a'; c <= 'c'; ++c) {
+        typename t_cst::size_type cp1 = 0, cp2 = 0;
+        ASSERT_TRUE(tiny.child(cst.root(), c, cp1)
+                    == cst.child(cst.root(), c, cp2));
+        ASSERT_EQ(cp2, cp1);
+    }
+}
+
+//! Test the child-label cache against plain cst.child
+TEST(cst_extension_test, child_cache)
+{
+    string text = random_text(3000, 4, 19);
+    cst_sct3<> cst1;
+    construct_im(cst1, text, 1);
+    check_child_cache(cst1);
+    cst_sada<> cst2;
+    construct_im(cst2, text, 1);
+    check_child_cache(cst2);
+}
+
+//! Test the lazy CST wrapper on disk and ram-fs paths
+TEST(cst_extension_test, lazy_cst)
+{
+    typedef cst_sct3<> cst_type;
+    string text = random_text(2000, 4, 40);
+    cst_type cst;
+    construct_im(cst, text, 1);
+    for (string file : {temp_dir + "/cst_extension_test_lazy.sdsl",
+                        string("@cst_extension_test_lazy")
+         }) {
+        store_to_file(cst, file);
+        lazy_cst<cst_type> lcst(file);
+        ASSERT_EQ(cst.csa.size(), lcst.csa().size());
+        const cst_type& full = lcst.cst(); // materializes the tree
+        ASSERT_EQ(cst.size(), full.size());
+        ASSERT_EQ(cst.nodes(), full.nodes());
+        sdsl::remove(file);
+    }
+}
+
+//! Test sl_chain and level-ancestor support of cst_fully
+TEST(cst_extension_test, cst_fully_sl_chain_and_levelanc)
+{
+    typedef cst_fully<csa_wt<>, 4> cst_type;
+    typedef cst_type::node_type node_type;
+    string text = random_text(1500, 4, 29);
+    cst_type cst;
+    construct_im(cst, text, 1);
+
+    std::mt19937_64 rng(30);
+    for (size_t t=0; t < 100; ++t) { // sl_chain vs repeated sl()
+        size_t l = rng() % cst.size();
+        size_t r = l + rng() % min<size_t>(50, cst.size()-l);
+        node_type v = (l == r) ? node_type(l, l) : cst.lca(l, r);
+        size_t k = 1 + rng() % 12;
+        auto chain = cst.sl_chain(v, k);
+        ASSERT_FALSE(chain.empty());
+        ASSERT_TRUE(chain[0] == v);
+        node_type w = v;
+        for (size_t j=1; j < chain.size(); ++j) {
+            w = cst.sl(w);
+            ASSERT_TRUE(chain[j] == w);
+        }
+        if (chain.size() < k) { // stopped early => last element is root
+            ASSERT_TRUE(chain.back() == cst.root());
+        }
+    }
+    ASSERT_EQ((size_t)1, cst.sl_chain(cst.root(), 5).size());
+
+    cst_fully_levelanc_support<cst_type> la(cst);
+    auto naive_parent = [&](cst_type::sampled_node_type u) {
+        return u == cst.sampled_root() ? u : cst.s_support.enclose(u);
+    };
+    size_t nodes = cst.sampled_nodes();
+    for (size_t i=0; i < nodes; ++i) {
+        auto u = cst.s_support.select(i+1);
+        ASSERT_TRUE(la.parent(u) == naive_parent(u));
+        for (size_t k : {0, 1, 3, 100}) { // k-th ancestor
+            auto w = u;
+            for (size_t q=0; q < k; ++q) {
+                w = naive_parent(w);
+            }
+            ASSERT_TRUE(la.levelanc(u, k) == w);
+        }
+        for (size_t d : {0, 2, 1000}) { // deepest ancestor with depth <= d
+            auto w = u;
+            while (w != cst.sampled_root() and cst.depth(w) > d) {
+                w = naive_parent(w);
+            }
+            ASSERT_TRUE(la.anc_depth_leq(u, d) == w);
+        }
+    }
+}
+
+struct traversal_stats {
+    uint64_t nodes = 0;
+    uint64_t leaves = 0;
+    uint64_t depth_sum = 0;
+};
+
+template<class t_cst>
+void check_bottom_up_parallel(const string& text)
+{
+    t_cst cst;
+    construct_im(cst, text, 1);
+    traversal_stats ref;
+    for (auto it = cst.begin_bottom_up(); it != cst.end_bottom_up(); ++it) {
+        ++ref.nodes;
+        if (cst.is_leaf(*it)) {
+            ++ref.leaves;
+        }
+        ref.depth_sum += cst.node_depth(*it);
+    }
+    auto visit = [&cst](traversal_stats& s,
+    const typename t_cst::node_type& v) {
+        ++s.nodes;
+        if (cst.is_leaf(v)) {
+            ++s.leaves;
+        }
+        s.depth_sum += cst.node_depth(v);
+    };
+    auto merge = [](traversal_stats& a, const traversal_stats& b) {
+        a.nodes += b.nodes;
+        a.leaves += b.leaves;
+        a.depth_sum += b.depth_sum;
+    };
+    for (uint64_t split_depth : {0, 1, 3}) {
+        for (uint64_t threads : {1, 2, 4}) {
+            traversal_stats got = cst_bottom_up_parallel(cst, visit, merge,
+                                  traversal_stats(),
+                                  split_depth, threads);
+            ASSERT_EQ(ref.nodes, got.nodes);
+            ASSERT_EQ(ref.leaves, got.leaves);
+            ASSERT_EQ(ref.depth_sum, got.depth_sum);
+        }
+    }
+}
+
+//! Test the parallel bottom-up driver against the sequential iterator
+TEST(cst_extension_test, bottom_up_parallel)
+{
+    string text = random_text(10000, 4, 42);
+    check_bottom_up_parallel<cst_sct3<>>(text);
+    check_bottom_up_parallel<cst_sada<>>(text);
+    check_bottom_up_parallel<cst_sct3<>>("a"); // single-leaf tree
+}
+
+template<class t_cst>
+void check_cst_sada_batches(const string& text)
+{
+    t_cst cst;
+    construct_im(cst, text, 1);
+    std::mt19937_64 rng(17);
+    vector<typename t_cst::node_type> nodes;
+    nodes.push_back(cst.root());
+    for (size_t t=0; t < 40; ++t) {
+        auto v = cst.select_leaf(1 + rng() % cst.size(cst.root()));
+        v = cst.parent(v);
+        if (rng() % 2) {
+            v = cst.parent(v);
+        }
+        nodes.push_back(v);
+    }
+    for (auto v : nodes) {
+        auto batch = cst.children_batch(v);
+        size_t d = cst.depth(v);
+        size_t k = 0;
+        if (!cst.is_leaf(v)) {
+            for (auto w : cst.children(v)) {
+                ASSERT_LT(k, batch.size());
+                ASSERT_TRUE(batch[k].second == w);
+                ASSERT_EQ(cst.edge(w, d+1), batch[k].first);
+                ASSERT_TRUE(cst.child(v, batch[k].first) == w);
+                ++k;
+            }
+        }
+        ASSERT_EQ(batch.size(), k);
+        auto sa = cst.subtree_batch(v);
+        size_t lb = cst.lb(v), rb = cst.rb(v);
+        ASSERT_EQ(rb-lb+1, sa.size());
+        for (size_t i=lb; i <= rb; ++i) {
+            ASSERT_EQ(cst.csa[i], sa[i-lb]);
+        }
+    }
+}
+
+//! Test cst_sada children_batch and subtree_batch against plain accesses
+TEST(cst_extension_test, cst_sada_batches)
+{
+    string text = random_text(5000, 8, 19);
+    check_cst_sada_batches<cst_sada<>>(text);
+    check_cst_sada_batches<cst_sada<csa_wt<>>>(text); // fallback paths
+    check_cst_sada_batches<cst_sada<>>("abcab");
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        // LCOV_EXCL_START
+        cout << "Usage: " << argv[0] << " tmp_dir" << endl;
+        return 1;
+        // LCOV_EXCL_STOP
+    }
+    temp_dir = argv[1];
+    return RUN_ALL_TESTS();
+}
@@ -238,6 +238,57 @@ TYPED_TEST(k2_treap_test, count)
 }
 
 
+template<class t_k2treap>
+void sum_max_test(
+    const t_k2treap& k2treap,
+    complex<uint64_t> min_xy,
+    complex<uint64_t> max_xy,
+    const int_vector<>& x,
+    const int_vector<>& y,
+    const int_vector<>& w)
+{
+    uint64_t sum = 0;
+    uint64_t max_w = 0;
+    for (uint64_t i = 0; i < x.size(); ++i) {
+        if (x[i] >= real(min_xy) and x[i] <= real(max_xy)
+            and y[i] >= imag(min_xy) and y[i] <= imag(max_xy)) {
+            sum += w[i];
+            max_w = std::max(max_w, (uint64_t)w[i]);
+        }
+    }
+    ASSERT_EQ(sum, sum_2d(k2treap, {real(min_xy),imag(min_xy)}, {real(max_xy),imag(max_xy)}));
+    ASSERT_EQ(max_w, max_2d(k2treap, {real(min_xy),imag(min_xy)}, {real(max_xy),imag(max_xy)}));
+}
+
+TYPED_TEST(k2_treap_test, sum_and_max)
+{
+    TypeParam k2treap;
+    ASSERT_TRUE(load_from_file(k2treap, temp_file));
+    int_vector<> x,y,w;
+    ASSERT_TRUE(load_from_file(x, test_file+".x"));
+    ASSERT_TRUE(load_from_file(y, test_file+".y"));
+    ASSERT_TRUE(load_from_file(w, test_file+".w"));
+    ASSERT_EQ(x.size(), y.size());
+    ASSERT_EQ(x.size(), w.size());
+    ASSERT_EQ(x.size(), k2treap.size());
+    if (x.size() > 0) {
+        std::mt19937_64 rng;
+        std::uniform_int_distribution<uint64_t> distribution(0, x.size()-1);
+        auto dice = bind(distribution, rng);
+        for (size_t i=0; i<3; ++i) {
+            auto idx1 = dice();
+            auto idx2 = dice();
+            uint64_t x1 = x[idx1];
+            uint64_t y1 = y[idx1];
+            uint64_t x2 = x[idx2];
+            uint64_t y2 = y[idx2];
+            sum_max_test(k2treap, {std::min(x1,x2), std::min(y1,y2)}, {std::max(x1,x2),std::max(y1,y2)}, x, y, w);
+        }
+        // full domain: sum of all weights, global maximum
+        sum_max_test(k2treap, {0, 0}, {~0ULL, ~0ULL}, x, y, w);
+    }
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
@@ -590,6 +590,111 @@ TYPED_TEST(k2_tree_test, serialize_test)
 
 }
 
+template<class T>
+class k2_tree_test_comp : public ::testing::Test { };
+
+typedef Types<
+k2_tree<2, bit_vector, rank_support_v<>, true>,
+        k2_tree<3, bit_vector, rank_support_v<>, true>,
+        k2_tree<4, bit_vector, rank_support_v<>, true>
+        > Compressed_Implementations;
+
+TYPED_TEST_CASE(k2_tree_test_comp, Compressed_Implementations);
+
+//! With compressed leaves the leaf level lives in the vocabulary, so a
+//! height-1 tree (n <= k) has neither k_t nor k_l bits; neigh must
+//! still report the edges adj sees.
+TYPED_TEST(k2_tree_test_comp, neighbors_height_one)
+{
+    vector<vector<int>> mat({{0, 1},
+        {1, 0}
+    });
+    TypeParam tree(mat);
+    ASSERT_TRUE(tree.adj(0, 1));
+    ASSERT_TRUE(tree.adj(1, 0));
+    ASSERT_FALSE(tree.adj(0, 0));
+    auto neigh_0 = tree.neigh(0);
+    ASSERT_EQ(1u, neigh_0.size());
+    ASSERT_EQ(1u, neigh_0[0]);
+    auto neigh_1 = tree.neigh(1);
+    ASSERT_EQ(1u, neigh_1.size());
+    ASSERT_EQ(0u, neigh_1[0]);
+
+    TypeParam empty;
+    ASSERT_EQ(0u, empty.neigh(0).size());
+}
+
+//! Compare adj, neigh and reverse_neigh of the compressed variant
+//! against the matrix
+TYPED_TEST(k2_tree_test_comp, neighbors_vs_matrix)
+{
+    const unsigned n = 9;
+    vector<vector<int>> mat(n, vector<int>(n, 0));
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++)
+            mat[i][j] = ((i*7 + j*3) % 5 == 0);
+    TypeParam tree(mat);
+    for (unsigned i = 0; i < n; i++) {
+        vector<unsigned> expected_neigh, expected_reverse;
+        for (unsigned j = 0; j < n; j++) {
+            ASSERT_EQ((bool)mat[i][j], tree.adj(i, j));
+            if (mat[i][j])
+                expected_neigh.push_back(j);
+            if (mat[j][i])
+                expected_reverse.push_back(j);
+        }
+        auto neigh = tree.neigh(i);
+        ASSERT_EQ(expected_neigh.size(), neigh.size());
+        for (unsigned k = 0; k < neigh.size(); k++)
+            ASSERT_EQ(expected_neigh[k], neigh[k]);
+        auto reverse = tree.reverse_neigh(i);
+        ASSERT_EQ(expected_reverse.size(), reverse.size());
+        for (unsigned k = 0; k < reverse.size(); k++)
+            ASSERT_EQ(expected_reverse[k], reverse[k]);
+    }
+}
+
+TYPED_TEST(k2_tree_test_comp, serialize_test)
+{
+    vector<vector<int>> mat({{1, 0, 0, 0, 1},
+        {0, 0, 0, 0, 0},
+        {0, 0, 1, 1, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 1, 0, 1}
+    });
+    auto tree = TypeParam(mat);
+    k2_tree_test_nm::check_serialize_load(tree);
+}
+
+//! neigh_batch must return exactly one neigh() list per vertex
+TYPED_TEST(k2_tree_test, neigh_batch_test)
+{
+    const unsigned n = 11;
+    vector<vector<int>> mat(n, vector<int>(n, 0));
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++)
+            mat[i][j] = ((i*5 + j*11) % 7 == 0);
+    TypeParam tree(mat);
+    vector<typename TypeParam::idx_type> vertices;
+    for (unsigned i = 0; i < n; i++)
+        vertices.push_back(i);
+    vertices.push_back(3); // duplicates are allowed
+    auto batch = tree.neigh_batch(vertices);
+    ASSERT_EQ(vertices.size(), batch.size());
+    for (unsigned k = 0; k < vertices.size(); k++) {
+        auto expected = tree.neigh(vertices[k]);
+        ASSERT_EQ(expected.size(), batch[k].size());
+        for (unsigned j = 0; j < expected.size(); j++)
+            ASSERT_EQ(expected[j], batch[k][j]);
+    }
+
+    TypeParam empty;
+    auto empty_batch = empty.neigh_batch(vertices);
+    ASSERT_EQ(vertices.size(), empty_batch.size());
+    for (auto& l : empty_batch)
+        ASSERT_EQ(0u, l.size());
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
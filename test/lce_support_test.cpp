@@ -0,0 +1,117 @@
+#include "sdsl/lce_support_fp.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+template<class T>
+class lce_support_test : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<
+lce_support_fp<8>,
+                lce_support_fp<64>,
+                lce_support_fp<256>
+                > Implementations;
+
+TYPED_TEST_CASE(lce_support_test, Implementations);
+
+size_t ref_lce(const int_vector<8>& t, size_t i, size_t j)
+{
+    size_t l = 0;
+    while (i+l < t.size() and j+l < t.size() and t[i+l] == t[j+l]) {
+        ++l;
+    }
+    return l;
+}
+
+template<class t_lce>
+void compare_with_scan(const int_vector<8>& t, size_t queries, uint64_t seed)
+{
+    t_lce lce(&t);
+    ASSERT_EQ(t.size(), lce.size());
+    std::mt19937_64 rng(seed);
+    for (size_t q=0; q < queries; ++q) {
+        size_t i = rng() % (t.size()+1);
+        size_t j = rng() % (t.size()+1);
+        ASSERT_EQ(ref_lce(t, i, j), lce.lce(i, j)) << "i="<<i<<" j="<<j;
+    }
+    ASSERT_EQ(t.size(), lce.lce(0, 0));
+    ASSERT_EQ((size_t)0, lce.lce(t.size(), 0));
+}
+
+//! Test lce against a naive scan on a random text
+TYPED_TEST(lce_support_test, random_text)
+{
+    std::mt19937_64 rng(79);
+    int_vector<8> t(20000);
+    for (size_t i=0; i < t.size(); ++i) {
+        t[i] = 'a' + rng() % 4;
+    }
+    compare_with_scan<TypeParam>(t, 1000, 80);
+}
+
+//! Test long extensions across the copies of a periodic text
+TYPED_TEST(lce_support_test, periodic_text)
+{
+    std::mt19937_64 rng(81);
+    const size_t period = 5000;
+    int_vector<8> t(3*period); // text = S S S
+    for (size_t i=0; i < period; ++i) {
+        uint8_t c = 'a' + rng() % 26;
+        t[i] = c;
+        t[i+period] = c;
+        t[i+2*period] = c;
+    }
+    TypeParam lce(&t);
+    ASSERT_EQ(2*period, lce.lce(0, period));
+    ASSERT_EQ(period-7, lce.lce(7, 2*period+7));
+    compare_with_scan<TypeParam>(t, 300, 82);
+}
+
+//! Test the empty and the one-character text
+TYPED_TEST(lce_support_test, tiny_text)
+{
+    int_vector<8> t;
+    TypeParam lce(&t);
+    ASSERT_EQ((size_t)0, lce.lce(0, 0));
+
+    int_vector<8> t1(1, 'x');
+    TypeParam l1(&t1);
+    ASSERT_EQ((size_t)1, l1.lce(0, 0));
+    ASSERT_EQ((size_t)0, l1.lce(0, 1));
+}
+
+//! Test serialize/load round trip
+TYPED_TEST(lce_support_test, serialize_and_load)
+{
+    std::mt19937_64 rng(83);
+    int_vector<8> t(5000);
+    for (size_t i=0; i < t.size(); ++i) {
+        t[i] = 'a' + rng() % 4;
+    }
+    TypeParam lce(&t);
+    stringstream ss;
+    lce.serialize(ss);
+    TypeParam lce2;
+    lce2.load(ss, &t);
+    for (size_t q=0; q < 200; ++q) {
+        size_t i = rng() % t.size();
+        size_t j = rng() % t.size();
+        ASSERT_EQ(lce.lce(i, j), lce2.lce(i, j));
+    }
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+#include "sdsl/nsv_support_bp.hpp"
+#include "sdsl/suffix_trees.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+template<class t_seq>
+void compare_with_scan(const t_seq& v)
+{
+    nsv_support_bp<t_seq> sup(&v);
+    ASSERT_EQ(v.size(), sup.size());
+    for (size_t i=0; i < v.size(); ++i) {
+        size_t nw = v.size();
+        for (size_t j=i+1; j < v.size(); ++j) {
+            if (v[j] < v[i]) {
+                nw = j;
+                break;
+            }
+        }
+        size_t pw = v.size();
+        for (size_t j=i; j-- > 0;) {
+            if (v[j] < v[i]) {
+                pw = j;
+                break;
+            }
+        }
+        ASSERT_EQ(nw, sup.nsv(i)) << "i="<<i;
+        ASSERT_EQ(pw, sup.psv(i)) << "i="<<i;
+    }
+}
+
+//! Test nsv/psv on handcrafted sequences
+TEST(nsv_support_test, crafted_sequences)
+{
+    int_vector<> v = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    compare_with_scan(v);
+    v = int_vector<>(200, 7); // ties everywhere
+    compare_with_scan(v);
+    v = int_vector<>(100);
+    for (size_t i=0; i < v.size(); ++i) {
+        v[i] = i;
+    }
+    compare_with_scan(v); // increasing
+    for (size_t i=0; i < v.size(); ++i) {
+        v[i] = v.size()-i;
+    }
+    compare_with_scan(v); // decreasing
+}
+
+//! Test nsv/psv on random sequences
+TEST(nsv_support_test, random_sequences)
+{
+    std::mt19937_64 rng(67);
+    int_vector<> v(500);
+    for (size_t i=0; i < v.size(); ++i) {
+        v[i] = rng() % 4; // many ties
+    }
+    compare_with_scan(v);
+    for (size_t i=0; i < v.size(); ++i) {
+        v[i] = rng() % 1000;
+    }
+    compare_with_scan(v);
+}
+
+//! Test the empty and the one-element sequence
+TEST(nsv_support_test, tiny_sequences)
+{
+    int_vector<> v;
+    compare_with_scan(v);
+    v = {42};
+    compare_with_scan(v);
+}
+
+//! Test nsv/psv over a compressed LCP array
+TEST(nsv_support_test, lcp_array)
+{
+    std::mt19937_64 rng(68);
+    string text;
+    for (size_t i=0; i < 5000; ++i) {
+        text.push_back('a' + rng() % 4);
+    }
+    cst_sct3<csa_wt<>, lcp_dac<>> cst;
+    construct_im(cst, text, 1);
+    compare_with_scan(cst.lcp);
+}
+
+//! Test serialize/load round trip
+TEST(nsv_support_test, serialize_and_load)
+{
+    std::mt19937_64 rng(69);
+    int_vector<> v(1000);
+    for (size_t i=0; i < v.size(); ++i) {
+        v[i] = rng() % 100;
+    }
+    nsv_support_bp<int_vector<>> sup(&v);
+    stringstream ss;
+    sup.serialize(ss);
+    nsv_support_bp<int_vector<>> sup2;
+    sup2.load(ss, &v);
+    for (size_t i=0; i < v.size(); ++i) {
+        ASSERT_EQ(sup.nsv(i), sup2.nsv(i));
+        ASSERT_EQ(sup.psv(i), sup2.psv(i));
+    }
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+#include "sdsl/suffix_arrays.hpp"
+#include "sdsl/construct.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+string temp_dir;
+
+namespace
+{
+
+typedef int_vector<>::size_type size_type;
+
+// cache text, SA and BWT as the r_index constructor expects
+cache_config prepare_cache(const string& text, const string& id)
+{
+    cache_config config(true, temp_dir, "r_index_test_"+id);
+    int_vector<8> text_iv(text.size()+1);
+    for (size_type i=0; i < text.size(); ++i) {
+        text_iv[i] = text[i];
+    }
+    text_iv[text.size()] = 0;
+    store_to_cache(text_iv, conf::KEY_TEXT, config);
+    construct_sa<8>(config);
+    construct_bwt<8>(config);
+    return config;
+}
+
+string random_text(size_type n, uint8_t sigma, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    string text;
+    for (size_type i=0; i < n; ++i) {
+        text.push_back('a' + rng() % sigma);
+    }
+    return text;
+}
+
+void compare_with_csa(const string& text, const string& id)
+{
+    cache_config config = prepare_cache(text, id);
+    r_index<> idx(config);
+    ASSERT_EQ(text.size()+1, idx.size());
+
+    csa_wt<> ref;
+    construct_im(ref, text, 1);
+
+    std::mt19937_64 rng(4711);
+    vector<string> pats;
+    for (int q=0; q < 30; ++q) { // substrings: guaranteed hits
+        size_type len = 1 + rng() % min<size_type>(12, text.size()-1);
+        size_type pos = rng() % (text.size()-len+1);
+        pats.push_back(text.substr(pos, len));
+    }
+    pats.push_back("zzzzz"); // miss
+    for (const string& p : pats) {
+        size_type want = sdsl::count(ref, p.begin(), p.end());
+        ASSERT_EQ(want, idx.count(p.begin(), p.end())) << "pattern " << p;
+        auto got = idx.locate(p.begin(), p.end());
+        ASSERT_EQ(want, got.size());
+        auto exp = sdsl::locate(ref, p.begin(), p.end());
+        vector<size_type> e(exp.begin(), exp.end());
+        sort(got.begin(), got.end());
+        sort(e.begin(), e.end());
+        ASSERT_TRUE(equal(got.begin(), got.end(), e.begin()));
+    }
+    util::delete_all_files(config.file_map);
+}
+
+//! Test count and locate against a csa_wt reference on a repetitive text
+TEST(r_index_test, count_and_locate_repetitive)
+{
+    string block = random_text(500, 4, 1);
+    string text;
+    for (int i=0; i < 20; ++i) { // highly repetitive: few BWT runs
+        text += block;
+    }
+    compare_with_csa(text, "repetitive");
+}
+
+//! Test count and locate against a csa_wt reference on a random text
+TEST(r_index_test, count_and_locate_random)
+{
+    compare_with_csa(random_text(5000, 26, 2), "random");
+}
+
+//! Test a tiny text
+TEST(r_index_test, tiny_text)
+{
+    compare_with_csa("abracadabra", "tiny");
+}
+
+//! Test serialize/load round trip
+TEST(r_index_test, serialize_and_load)
+{
+    string text = random_text(2000, 4, 3);
+    cache_config config = prepare_cache(text, "serialize");
+    r_index<> idx(config);
+    stringstream ss;
+    idx.serialize(ss);
+    r_index<> idx2;
+    idx2.load(ss);
+    ASSERT_EQ(idx.size(), idx2.size());
+    ASSERT_EQ(idx.runs(), idx2.runs());
+    string p = text.substr(100, 6);
+    auto a = idx.locate(p.begin(), p.end());
+    auto b = idx2.locate(p.begin(), p.end());
+    ASSERT_TRUE(a == b);
+    util::delete_all_files(config.file_map);
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        // LCOV_EXCL_START
+        cout << "Usage: " << argv[0] << " tmp_dir" << endl;
+        return 1;
+        // LCOV_EXCL_STOP
+    }
+    temp_dir = argv[1];
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include "sdsl/rank_support_int.hpp"
+#include "sdsl/int_vector.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+template<class T>
+class rank_support_int_test : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<
+rank_support_int_v<2>,
+                   rank_support_int_v<4>
+                   > Implementations;
+
+TYPED_TEST_CASE(rank_support_int_test, Implementations);
+
+template<class t_rs>
+void compare_with_counts(const typename t_rs::int_vector_type& v)
+{
+    typedef typename t_rs::size_type size_type;
+    const uint64_t sigma = 1ULL << t_rs::int_vector_type::fixed_int_width;
+    t_rs rs(&v);
+    ASSERT_EQ(v.size(), rs.size());
+    vector<vector<size_type>> cnt(sigma, vector<size_type>(v.size()+1, 0));
+    for (size_type i=0; i < v.size(); ++i) {
+        for (uint64_t c=0; c < sigma; ++c) {
+            cnt[c][i+1] = cnt[c][i] + (v[i] == c);
+        }
+    }
+    for (size_type i=0; i <= v.size(); ++i) {
+        for (uint64_t c=0; c < sigma; ++c) {
+            ASSERT_EQ(cnt[c][i], rs.rank(i, c)) << "i="<<i<<" c="<<c;
+            ASSERT_EQ(cnt[c][i], rs(i, c));
+        }
+    }
+    for (uint64_t c=0; c < sigma; ++c) {
+        size_type k = 0;
+        for (size_type i=0; i < v.size(); ++i) {
+            if (v[i] == c) {
+                ++k;
+                ASSERT_EQ(i, rs.select(k, c)) << "k="<<k<<" c="<<c;
+            }
+        }
+    }
+}
+
+//! Test rank and select against brute-force counts
+TYPED_TEST(rank_support_int_test, rank_and_select)
+{
+    std::mt19937_64 rng(70);
+    const uint64_t sigma = 1ULL << TypeParam::int_vector_type::fixed_int_width;
+    for (uint64_t n : {0, 1, 31, 32, 33, 63, 64, 65, 511, 512, 513, 2000}) {
+        typename TypeParam::int_vector_type v(n);
+        for (uint64_t i=0; i < n; ++i) {
+            v[i] = rng() % sigma;
+        }
+        compare_with_counts<TypeParam>(v);
+    }
+}
+
+//! Test rank on a skewed symbol distribution
+TYPED_TEST(rank_support_int_test, rank_skewed)
+{
+    std::mt19937_64 rng(71);
+    const uint64_t sigma = 1ULL << TypeParam::int_vector_type::fixed_int_width;
+    typename TypeParam::int_vector_type v(3000);
+    for (uint64_t i=0; i < v.size(); ++i) {
+        v[i] = (rng() % 100 < 97) ? 0 : rng() % sigma;
+    }
+    compare_with_counts<TypeParam>(v);
+}
+
+//! Test serialize/load round trip
+TYPED_TEST(rank_support_int_test, serialize_and_load)
+{
+    std::mt19937_64 rng(72);
+    const uint64_t sigma = 1ULL << TypeParam::int_vector_type::fixed_int_width;
+    typename TypeParam::int_vector_type v(1777);
+    for (uint64_t i=0; i < v.size(); ++i) {
+        v[i] = rng() % sigma;
+    }
+    TypeParam rs(&v);
+    stringstream ss;
+    rs.serialize(ss);
+    TypeParam rs2;
+    rs2.load(ss, &v);
+    for (uint64_t i=0; i <= v.size(); ++i) {
+        for (uint64_t c=0; c < sigma; ++c) {
+            ASSERT_EQ(rs.rank(i, c), rs2.rank(i, c));
+        }
+    }
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -54,6 +54,8 @@ typedef Types<rank_support_il<1, 256>,
         rank_support_sd<0>,
         rank_support_hyb<1>,
         rank_support_hyb<0>,
+        rank_support_poppy<1>,
+        rank_support_poppy<0>,
         rank_support_v<10,2>,
         rank_support_v<01,2>,
         rank_support_v<00,2>,
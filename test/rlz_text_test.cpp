@@ -0,0 +1,108 @@
+#include "sdsl/rlz_text.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+template<class T>
+class rlz_text_test : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<
+rlz_text<>,
+          rlz_text<1024, 8>
+          > Implementations;
+
+TYPED_TEST_CASE(rlz_text_test, Implementations);
+
+// versioned-document corpus: many lightly edited copies of one base
+string repetitive_text(uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    string base;
+    for (size_t i=0; i < 10000; ++i) {
+        base.push_back('a' + rng() % 26);
+    }
+    string rep;
+    for (int v=0; v < 10; ++v) {
+        string c = base;
+        for (int m=0; m < 20; ++m) {
+            c[rng() % c.size()] = 'a' + rng() % 26;
+        }
+        rep += c;
+    }
+    return rep;
+}
+
+template<class t_rlz>
+void check_extract(const string& text)
+{
+    t_rlz ct(text.begin(), text.end());
+    ASSERT_EQ(text.size(), ct.size());
+    ASSERT_EQ(text, ct.extract(0, text.size()));
+    std::mt19937_64 rng(2);
+    for (int q=0; q < 200; ++q) {
+        size_t l = 1 + rng() % 200;
+        if (l > text.size()) {
+            l = text.size();
+        }
+        size_t i = rng() % (text.size()-l+1);
+        ASSERT_EQ(text.substr(i, l), ct.extract(i, l)) << "i="<<i<<" l="<<l;
+        size_t p = rng() % text.size();
+        ASSERT_EQ((uint8_t)text[p], ct[p]) << "p="<<p;
+    }
+    string via_it(ct.begin(), ct.end());
+    ASSERT_EQ(text, via_it);
+}
+
+//! Test extract and access on a repetitive text
+TYPED_TEST(rlz_text_test, extract_repetitive)
+{
+    check_extract<TypeParam>(repetitive_text(13));
+}
+
+//! Test extract and access on an incompressible text
+TYPED_TEST(rlz_text_test, extract_random)
+{
+    std::mt19937_64 rng(14);
+    string text;
+    for (size_t i=0; i < 20000; ++i) {
+        text.push_back((char)(1 + rng() % 255));
+    }
+    check_extract<TypeParam>(text);
+}
+
+//! Test a text shorter than one block
+TYPED_TEST(rlz_text_test, tiny_text)
+{
+    check_extract<TypeParam>("hello world");
+}
+
+//! Test serialize/load round trip
+TYPED_TEST(rlz_text_test, serialize_and_load)
+{
+    string text = repetitive_text(15);
+    TypeParam ct(text.begin(), text.end());
+    stringstream ss;
+    ct.serialize(ss);
+    TypeParam ct2;
+    ct2.load(ss);
+    ASSERT_EQ(ct.size(), ct2.size());
+    ASSERT_EQ(text.substr(5, 50), ct2.extract(5, 50));
+    ASSERT_EQ(text, ct2.extract(0, text.size()));
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,7 @@
 #include "sdsl/rmq_support.hpp"
 #include "gtest/gtest.h"
+#include <fstream>
+#include <random>
 #include <vector>
 #include <string>
 #include <stack>
@@ -134,6 +136,66 @@ TYPED_TEST(rmq_test, delete_)
     sdsl::remove(temp_file);
 }
 
+template<class T>
+class rmq_support_test : public ::testing::Test { };
+
+typedef Types<sdsl::rmq_support_hybrid<>,
+        sdsl::rmq_support_hybrid<int_vector<>, true, 16>,
+        sdsl::range_maximum_support_hybrid<>
+        > Support_Implementations;
+
+TYPED_TEST_CASE(rmq_support_test, Support_Implementations);
+
+//! Test the support-style RMQ classes against a naive scan
+/*! Unlike the succinct RMQ classes above, the support classes keep a
+ *  pointer to the container and are reattached with set_vector/load.
+ */
+TYPED_TEST(rmq_support_test, construct_and_query)
+{
+    int_vector<> v;
+    ASSERT_TRUE(load_from_file(v, test_file));
+    TypeParam rmq(&v);
+    ASSERT_EQ(v.size(), rmq.size());
+    std::mt19937_64 rng(144);
+    for (size_t q=0; q < 500 and v.size() > 0; ++q) {
+        uint64_t l = rng() % v.size();
+        uint64_t r = l + rng() % std::min<uint64_t>(300, v.size()-l);
+        uint64_t idx = rmq(l, r);
+        ASSERT_TRUE(idx >= l);
+        ASSERT_TRUE(idx <= r);
+        uint64_t naive = l; // leftmost min/max position in [l..r]
+        for (uint64_t i=l+1; i <= r; ++i) {
+            bool better = std::is_same<TypeParam,
+                 sdsl::range_maximum_support_hybrid<>>::value
+                 ? v[i] > v[naive] : v[i] < v[naive];
+            if (better) {
+                naive = i;
+            }
+        }
+        ASSERT_EQ(naive, idx) << "[" << l << "," << r << "]";
+    }
+}
+
+//! Test serialize/load round trip of the support classes
+TYPED_TEST(rmq_support_test, store_and_load)
+{
+    int_vector<> v;
+    ASSERT_TRUE(load_from_file(v, test_file));
+    TypeParam rmq(&v);
+    ASSERT_TRUE(sdsl::store_to_file(rmq, temp_file));
+    TypeParam rmq2;
+    std::ifstream in(temp_file);
+    ASSERT_TRUE(in.good());
+    rmq2.load(in, &v);
+    std::mt19937_64 rng(145);
+    for (size_t q=0; q < 100 and v.size() > 0; ++q) {
+        uint64_t l = rng() % v.size();
+        uint64_t r = l + rng() % std::min<uint64_t>(300, v.size()-l);
+        ASSERT_EQ(rmq(l, r), rmq2(l, r));
+    }
+    sdsl::remove(temp_file);
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
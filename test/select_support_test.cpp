@@ -17,6 +17,8 @@ class select_support_test : public ::testing::Test { };
 using testing::Types;
 
 typedef Types<select_support_mcl<>,
+        select_support_da<>,
+        select_support_da<0>,
         select_support_rrr<1, 256>,
         select_support_rrr<1, 129>,
         select_support_rrr<1, 192>,
@@ -42,6 +44,8 @@ typedef Types<select_support_mcl<>,
         select_support_il<0, 256>,
         select_support_il<0, 512>,
         select_support_il<0, 1024>,
+        select_support_hyb<1>,
+        select_support_hyb<0>,
         select_support_mcl<01,2>,
         select_support_mcl<10,2>,
         select_support_mcl<00,2>,
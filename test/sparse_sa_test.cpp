@@ -0,0 +1,128 @@
+#include "sdsl/sparse_sa.hpp"
+#include "sdsl/suffix_arrays.hpp"
+#include "sdsl/construct.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+string temp_dir;
+
+namespace
+{
+
+typedef int_vector<>::size_type size_type;
+
+// cache text and SA as the sparse_sa constructor expects
+cache_config prepare_cache(const string& text, const string& id)
+{
+    cache_config config(true, temp_dir, "sparse_sa_test_"+id);
+    int_vector<8> text_iv(text.size()+1);
+    for (size_type i=0; i < text.size(); ++i) {
+        text_iv[i] = text[i];
+    }
+    text_iv[text.size()] = 0;
+    store_to_cache(text_iv, conf::KEY_TEXT, config);
+    construct_sa<8>(config);
+    return config;
+}
+
+template<uint8_t t_k>
+void compare_with_csa(const string& text, const string& id)
+{
+    cache_config config = prepare_cache(text, id);
+    sparse_sa<t_k> idx(config);
+    ASSERT_EQ(text.size()+1, idx.size());
+    ASSERT_EQ((text.size()+1 + t_k-1)/t_k, idx.samples());
+
+    csa_wt<> ref;
+    construct_im(ref, text, 1);
+
+    std::mt19937_64 rng(23);
+    vector<string> pats;
+    for (int q=0; q < 30; ++q) { // substrings of length >= t_k
+        size_type len = t_k + rng() % 20;
+        if (len > text.size()) {
+            len = text.size();
+        }
+        size_type pos = rng() % (text.size()-len+1);
+        pats.push_back(text.substr(pos, len));
+    }
+    pats.push_back(string(t_k+5, 'z')); // miss
+    for (const string& p : pats) {
+        size_type want = sdsl::count(ref, p.begin(), p.end());
+        ASSERT_EQ(want, idx.count(p.begin(), p.end()))
+                << "pattern length " << p.size();
+        auto got = idx.locate(p.begin(), p.end());
+        ASSERT_EQ(want, got.size());
+        auto exp = sdsl::locate(ref, p.begin(), p.end());
+        vector<size_type> e(exp.begin(), exp.end());
+        sort(e.begin(), e.end());
+        ASSERT_TRUE(equal(got.begin(), got.end(), e.begin()));
+    }
+    util::delete_all_files(config.file_map);
+}
+
+string random_text(size_type n, uint8_t sigma, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    string text;
+    for (size_type i=0; i < n; ++i) {
+        text.push_back('a' + rng() % sigma);
+    }
+    return text;
+}
+
+//! Test locate and count against a csa_wt reference
+TEST(sparse_sa_test, locate_and_count)
+{
+    string dna = random_text(10000, 4, 1);
+    compare_with_csa<8>(dna, "dna_k8");
+    compare_with_csa<4>(dna, "dna_k4");
+    string alpha = random_text(5000, 26, 2);
+    compare_with_csa<8>(alpha, "alpha_k8");
+    compare_with_csa<1>(alpha, "full_sa"); // t_k=1 degenerates to a full SA
+}
+
+//! Test a tiny text
+TEST(sparse_sa_test, tiny_text)
+{
+    compare_with_csa<4>("abracadabra", "tiny");
+}
+
+//! Test serialize/load round trip
+TEST(sparse_sa_test, serialize_and_load)
+{
+    string text = random_text(3000, 4, 3);
+    cache_config config = prepare_cache(text, "serialize");
+    sparse_sa<8> idx(config);
+    stringstream ss;
+    idx.serialize(ss);
+    sparse_sa<8> idx2;
+    idx2.load(ss);
+    ASSERT_EQ(idx.size(), idx2.size());
+    ASSERT_EQ(idx.samples(), idx2.samples());
+    string p = text.substr(42, 12);
+    ASSERT_EQ(idx.count(p.begin(), p.end()), idx2.count(p.begin(), p.end()));
+    util::delete_all_files(config.file_map);
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        // LCOV_EXCL_START
+        cout << "Usage: " << argv[0] << " tmp_dir" << endl;
+        return 1;
+        // LCOV_EXCL_STOP
+    }
+    temp_dir = argv[1];
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+#include "sdsl/succinct_trie.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+// sorted keys with heavy shared prefixes, mixed lengths
+vector<string> make_keys(size_t n, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    set<string> key_set;
+    vector<string> stems = {"com/example/", "com/example/a/", "org/test/",
+                            "net/", "com/exam/", "a", "ab", "abc"
+                           };
+    for (size_t i=0; i < n; ++i) {
+        string k = stems[rng() % stems.size()];
+        size_t len = rng() % 12;
+        for (size_t j=0; j < len; ++j) {
+            k.push_back('a' + rng() % 5);
+        }
+        key_set.insert(k);
+    }
+    return vector<string>(key_set.begin(), key_set.end());
+}
+
+//! Test that every key maps to its lexicographic rank and back
+TEST(succinct_trie_test, lookup_and_extract)
+{
+    vector<string> keys = make_keys(2000, 11);
+    succinct_trie<> trie(keys);
+    ASSERT_EQ(keys.size(), trie.size());
+    for (size_t i=0; i < keys.size(); ++i) {
+        ASSERT_EQ(i, trie.lookup(keys[i])) << "key " << keys[i];
+        ASSERT_EQ(keys[i], trie.extract(i));
+    }
+}
+
+//! Test that absent keys are rejected
+TEST(succinct_trie_test, lookup_absent)
+{
+    vector<string> keys = make_keys(2000, 12);
+    set<string> key_set(keys.begin(), keys.end());
+    succinct_trie<> trie(keys);
+    std::mt19937_64 rng(13);
+    for (int q=0; q < 300; ++q) {
+        string k = keys[rng() % keys.size()];
+        k.push_back('z'); // extension of a key
+        if (!key_set.count(k)) {
+            ASSERT_EQ(succinct_trie<>::npos, trie.lookup(k));
+        }
+        if (k.size() > 1) { // proper prefix of a key
+            string k2 = k.substr(0, k.size()-2);
+            if (!key_set.count(k2)) {
+                ASSERT_EQ(succinct_trie<>::npos, trie.lookup(k2));
+            }
+        }
+    }
+}
+
+//! Test prefix_range against a reference binary search
+TEST(succinct_trie_test, prefix_range)
+{
+    vector<string> keys = make_keys(2000, 14);
+    succinct_trie<> trie(keys);
+    std::mt19937_64 rng(15);
+    vector<string> prefixes = {"", "com/", "com/example/", "com/exam",
+                               "org", "a", "ab", "zzz"
+                              };
+    for (int q=0; q < 200; ++q) {
+        string p = keys[rng() % keys.size()];
+        prefixes.push_back(p.substr(0, rng() % (p.size()+1)));
+    }
+    for (const string& p : prefixes) {
+        auto r = trie.prefix_range(p);
+        size_t lo = lower_bound(keys.begin(), keys.end(), p) - keys.begin();
+        size_t hi = lo;
+        while (hi < keys.size()
+               and keys[hi].compare(0, p.size(), p) == 0) {
+            ++hi;
+        }
+        if (lo == hi) { // empty range; representation may differ
+            ASSERT_EQ(r.first, r.second) << "prefix " << p;
+        } else {
+            ASSERT_EQ(lo, r.first) << "prefix " << p;
+            ASSERT_EQ(hi, r.second) << "prefix " << p;
+        }
+    }
+}
+
+//! Test the empty dictionary
+TEST(succinct_trie_test, empty_dictionary)
+{
+    succinct_trie<> trie((vector<string>()));
+    ASSERT_EQ((uint64_t)0, trie.size());
+    ASSERT_EQ(succinct_trie<>::npos, trie.lookup("x"));
+    auto r = trie.prefix_range("x");
+    ASSERT_EQ(r.first, r.second);
+}
+
+//! Test serialize/load round trip
+TEST(succinct_trie_test, serialize_and_load)
+{
+    vector<string> keys = make_keys(1000, 16);
+    succinct_trie<> trie(keys);
+    stringstream ss;
+    trie.serialize(ss);
+    succinct_trie<> trie2;
+    trie2.load(ss);
+    ASSERT_EQ(trie.size(), trie2.size());
+    for (size_t i=0; i < keys.size(); i += 7) {
+        ASSERT_EQ(i, trie2.lookup(keys[i]));
+        ASSERT_EQ(keys[i], trie2.extract(i));
+    }
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+#include "sdsl/topk_completion.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+typedef pair<string,uint64_t> entry;
+
+// all completions of p in es, by decreasing score, cut to k
+vector<entry> ref_top_k(const vector<entry>& es, const string& p, size_t k)
+{
+    vector<entry> cand;
+    for (auto& e : es) {
+        if (e.first.compare(0, p.size(), p) == 0) {
+            cand.push_back(e);
+        }
+    }
+    sort(cand.begin(), cand.end(), [](const entry& a, const entry& b) {
+        return a.second > b.second;
+    });
+    if (cand.size() > k) {
+        cand.resize(k);
+    }
+    return cand;
+}
+
+void check_top_k(const topk_completion<>& tc, const vector<entry>& es,
+                 const string& p, size_t k)
+{
+    auto want = ref_top_k(es, p, k);
+    auto got = tc.top_k(p, k);
+    ASSERT_EQ(want.size(), got.size()) << "prefix '" << p << "' k=" << k;
+    for (size_t i=0; i < got.size(); ++i) {
+        // scores must match rank by rank; ties may come in any order,
+        // but the reported string must carry that score and the prefix
+        ASSERT_EQ(want[i].second, got[i].second) << "prefix '" << p << "'";
+        ASSERT_EQ(0, got[i].first.compare(0, p.size(), p));
+        ASSERT_TRUE(find(es.begin(), es.end(), got[i]) != es.end());
+        for (size_t j=i+1; j < got.size(); ++j) {
+            ASSERT_NE(got[i].first, got[j].first); // no duplicates
+        }
+    }
+}
+
+vector<entry> random_corpus(size_t n, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    vector<entry> es;
+    for (size_t i=0; i < n; ++i) {
+        string s;
+        size_t len = 1 + rng() % 12;
+        for (size_t j=0; j < len; ++j) {
+            s.push_back('a' + rng() % 5);
+        }
+        es.push_back(entry(s, rng() % 1000));
+    }
+    // dedupe with max score for the reference
+    sort(es.begin(), es.end());
+    vector<entry> ded;
+    for (auto& e : es) {
+        if (!ded.empty() and ded.back().first == e.first) {
+            ded.back().second = max(ded.back().second, e.second);
+        } else {
+            ded.push_back(e);
+        }
+    }
+    return ded;
+}
+
+//! Test top_k on a handcrafted dictionary
+TEST(topk_completion_test, basic)
+{
+    vector<entry> es = {
+        {"apple", 50}, {"app", 80}, {"application", 30},
+        {"apply", 80}, {"banana", 90}, {"band", 20},
+        {"", 5}, {"b", 1}
+    };
+    topk_completion<> tc(es);
+    ASSERT_EQ(es.size(), tc.size());
+    for (string p : {"app", "a", "b", "ban", "", "z", "apple", "applez"}) {
+        for (size_t k : {1u, 2u, 3u, 100u}) {
+            check_top_k(tc, es, p, k);
+        }
+    }
+}
+
+//! Test that duplicate strings merge with the maximum score
+TEST(topk_completion_test, duplicates_merge)
+{
+    vector<entry> es = {
+        {"app", 80}, {"apple", 50}, {"app", 10}, {"app", 99}
+    };
+    topk_completion<> tc(es);
+    ASSERT_EQ((uint64_t)2, tc.size());
+    auto r = tc.top_k("app", 1);
+    ASSERT_EQ((size_t)1, r.size());
+    ASSERT_EQ("app", r[0].first);
+    ASSERT_EQ((uint64_t)99, r[0].second);
+}
+
+//! Test top_k against the reference on a random corpus
+TEST(topk_completion_test, random_corpus)
+{
+    vector<entry> es = random_corpus(3000, 71);
+    topk_completion<> tc(es);
+    ASSERT_EQ(es.size(), tc.size());
+    std::mt19937_64 rng(72);
+    for (int q=0; q < 100; ++q) {
+        string p;
+        size_t len = rng() % 5;
+        for (size_t j=0; j < len; ++j) {
+            p.push_back('a' + rng() % 5);
+        }
+        check_top_k(tc, es, p, 1 + rng() % 10);
+    }
+}
+
+//! Test serialize/load round trip
+TEST(topk_completion_test, serialize_and_load)
+{
+    vector<entry> es = random_corpus(1000, 73);
+    topk_completion<> tc(es);
+    stringstream ss;
+    tc.serialize(ss);
+    topk_completion<> tc2;
+    tc2.load(ss);
+    ASSERT_EQ(tc.size(), tc2.size());
+    check_top_k(tc2, es, "ab", 5);
+    check_top_k(tc2, es, "", 10);
+}
+
+}// end namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}